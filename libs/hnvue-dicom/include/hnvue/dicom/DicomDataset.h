@@ -0,0 +1,103 @@
+/**
+ * @file DicomDataset.h
+ * @brief Pre-encoded DICOM dataset fragment
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * A DicomDataset holds elements already encoded as Explicit VR Little
+ * Endian, kept in tag order. Patient and protocol fragments are built once
+ * per study and shared between images; the writer only splices their bytes
+ * into each file instead of re-encoding them.
+ */
+
+#ifndef HNUE_DICOM_DICOM_DATASET_H
+#define HNUE_DICOM_DICOM_DATASET_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom {
+
+/**
+ * @brief Tag-ordered set of encoded elements
+ *
+ * Group 0002 (file meta information, owned by the writer), Pixel Data and
+ * item/delimiter tags are rejected. Setting an existing tag replaces it.
+ *
+ * Thread Safety: Not thread-safe for modification; a const dataset may be
+ * shared by concurrent writers.
+ */
+class DicomDataset {
+public:
+    /**
+     * @brief One encoded element
+     */
+    struct Element {
+        uint32_t tag = 0;
+        std::vector<uint8_t> bytes;   ///< Tag, VR, length and padded value
+    };
+
+    /**
+     * @brief Set a string element
+     * @param tag Element tag
+     * @param vr String VR (AE, AS, CS, DA, DS, DT, IS, LO, LT, PN, SH, ST, TM, UI, UT)
+     * @param value Value; multiple values separated by '\\'. Padded to even
+     *        length with '\\0' (UI) or ' ' (other VRs)
+     * @return DICOM_OK or DICOM_ERR_PARAM (reserved tag, non-string VR,
+     *         value too long for the VR length field)
+     */
+    DicomResult SetString(uint32_t tag, DicomVR vr, const std::string& value);
+
+    /**
+     * @brief Set a US element
+     */
+    DicomResult SetUInt16(uint32_t tag, uint16_t value);
+
+    /**
+     * @brief Set a UL element
+     */
+    DicomResult SetUInt32(uint32_t tag, uint32_t value);
+
+    /**
+     * @brief Set a binary element (OB, OW, UN, or a binary number VR)
+     * @return DICOM_OK or DICOM_ERR_PARAM (reserved tag, string VR, odd length)
+     */
+    DicomResult SetBytes(uint32_t tag, DicomVR vr, const void* data, size_t size);
+
+    /**
+     * @brief Remove an element if present
+     */
+    void Remove(uint32_t tag);
+
+    bool Contains(uint32_t tag) const;
+
+    /// Encoded element, or nullptr if absent
+    const Element* Find(uint32_t tag) const;
+
+    /// Elements in ascending tag order
+    const std::vector<Element>& Elements() const { return elements_; }
+
+    size_t Size() const { return elements_.size(); }
+
+    /// Sum of the encoded element sizes
+    uint64_t EncodedBytes() const { return encoded_bytes_; }
+
+    void Clear();
+
+private:
+    DicomResult Insert(uint32_t tag, DicomVR vr, const void* data, size_t size, uint8_t padding);
+
+    std::vector<Element> elements_;
+    uint64_t encoded_bytes_ = 0;
+};
+
+} // namespace hnvue::dicom
+
+#endif // HNUE_DICOM_DICOM_DATASET_H
@@ -0,0 +1,97 @@
+/**
+ * @file DicomPart10Writer.h
+ * @brief Native DX Part-10 file writer for processed images
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * Writes DX For Presentation / For Processing Part-10 files directly from an
+ * imaging::ImageBuffer so the pixels do not cross the IPC boundary before
+ * C-STORE (NFR-PERF-03). File layout:
+ *
+ *   128-byte preamble, "DICM", file meta group (0002)
+ *   dataset: patient fragment + protocol fragment + instance fragment +
+ *            generated SOP Common / DX Image / Image Pixel elements
+ *   Pixel Data (7FE0,0010)
+ *
+ * Native pixel data is written with one writev from the header buffer and
+ * the frame rows (no intermediate copy). RLE Lossless pixel data is
+ * compressed by row bands on encoder_threads threads and written as one
+ * encapsulated fragment.
+ */
+
+#ifndef HNUE_DICOM_DICOM_PART10_WRITER_H
+#define HNUE_DICOM_DICOM_PART10_WRITER_H
+
+#include "hnvue/dicom/DicomDataset.h"
+#include "hnvue/dicom/DicomTypes.h"
+#include "hnvue/imaging/ImagingTypes.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom {
+
+/**
+ * @brief Per-image write request
+ *
+ * Element precedence on duplicate tags: generated > instance > protocol >
+ * patient. Generated elements are SOP Class/Instance UID, Modality,
+ * Presentation Intent Type, Lossy Image Compression and the Image Pixel
+ * module.
+ */
+struct DicomImageRequest {
+    DicomImageType image_type = DicomImageType::DX_FOR_PRESENTATION;
+    std::string sop_instance_uid;                    ///< Required
+    std::shared_ptr<const DicomDataset> patient;     ///< Patient module (cached per patient)
+    std::shared_ptr<const DicomDataset> protocol;    ///< Study, series, equipment, acquisition (cached per protocol)
+    const DicomDataset* instance = nullptr;          ///< Per-image elements (content time, exposure, ...)
+    uint16_t bits_stored = 16;                       ///< 1..16; High Bit is bits_stored - 1
+};
+
+/**
+ * @brief Encodes processed frames to Part-10 files
+ *
+ * Thread Safety: Not thread-safe (header and compression buffers are reused
+ * between calls); use one writer per storage thread.
+ */
+class DicomPart10Writer {
+public:
+    explicit DicomPart10Writer(const DicomWriterConfig& config = DicomWriterConfig{});
+    ~DicomPart10Writer();
+
+    DicomPart10Writer(const DicomPart10Writer&) = delete;
+    DicomPart10Writer& operator=(const DicomPart10Writer&) = delete;
+
+    /**
+     * @brief Write one image as a Part-10 file
+     * @param path Destination file (created or truncated)
+     * @param image 16-bit frame; stride may exceed width * 2
+     * @param request SOP Instance UID, cached fragments and pixel format
+     * @param[out] stats Optional cost breakdown
+     * @return DICOM_OK, DICOM_ERR_PARAM (empty image, missing UID, bad
+     *         bits_stored), DICOM_ERR_NOT_SUPPORTED (pixel depth other than 16)
+     *         or DICOM_ERR_IO. A partially written file is removed.
+     */
+    DicomResult Write(const std::string& path, const imaging::ImageBuffer& image,
+                      const DicomImageRequest& request, DicomWriteStats* stats = nullptr);
+
+    const DicomWriterConfig& GetConfig() const { return config_; }
+
+private:
+    DicomResult BuildHeader(const imaging::ImageBuffer& image, const DicomImageRequest& request,
+                            uint64_t pixel_value_bytes);
+
+    DicomWriterConfig config_;
+    uint32_t encoder_threads_ = 1;
+    DicomDataset generated_;               ///< Reused per-image generated elements
+    std::vector<uint8_t> header_;          ///< Reused header buffer
+    std::vector<uint8_t> encoded_pixels_;  ///< Reused RLE fragment buffer
+};
+
+} // namespace hnvue::dicom
+
+#endif // HNUE_DICOM_DICOM_PART10_WRITER_H
@@ -0,0 +1,188 @@
+/**
+ * @file DicomStoreScu.h
+ * @brief Pipelined C-STORE SCU with a crash-safe transmission queue
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * Sends Part-10 files from the image store to PACS destinations
+ * (NFR-PERF-03, NFR-REL-06):
+ *   - Each destination keeps up to max_associations associations open and
+ *     reuses them until they have been idle for idle_release_ms.
+ *   - Up to async_window C-STORE requests are outstanding per association
+ *     (Asynchronous Operations Window negotiation, PS3.7 D.3.3.3).
+ *   - Dataset bytes are streamed from the file with sendfile; only PDU
+ *     headers are built in user space.
+ *   - Every job is journaled (fdatasync) before Enqueue returns, so pending
+ *     transmissions survive a crash and resume on the next Start.
+ *   - Transient failures are retried with exponential backoff.
+ */
+
+#ifndef HNUE_DICOM_DICOM_STORE_SCU_H
+#define HNUE_DICOM_DICOM_STORE_SCU_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom {
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Thread role name for C-STORE association threads (infra::ThreadPolicyRegistry)
+constexpr const char* kThreadDicomStore = "dicom.store";
+
+/**
+ * @brief Remote Storage SCP
+ */
+struct DicomDestination {
+    std::string name;                     ///< Unique key, no whitespace (journal field)
+    std::string host;                     ///< Host name or IPv4 address
+    uint16_t port = 104;
+    std::string called_ae;                ///< Remote AE title (1..16 chars)
+    std::string calling_ae = "HNVUE";     ///< Local AE title (1..16 chars)
+    uint32_t max_associations = 1;        ///< Parallel associations to this destination
+    uint32_t async_window = 8;            ///< Outstanding C-STORE requests per association
+};
+
+/**
+ * @brief DicomStoreScu construction parameters
+ */
+struct StoreScuConfig {
+    std::string queue_directory;              ///< Journal location (required)
+    uint32_t max_attempts = 5;                ///< Attempts per job before it fails
+    int64_t initial_backoff_ms = 1000;        ///< Delay after the first failure
+    int64_t max_backoff_ms = 60000;           ///< Backoff ceiling (doubles per attempt)
+    int64_t connect_timeout_ms = 5000;        ///< TCP connect and association negotiation
+    int64_t response_timeout_ms = 30000;      ///< Wait for a C-STORE response
+    int64_t idle_release_ms = 30000;          ///< Release an association idle this long
+    uint32_t max_pdu_bytes = 1u << 20;        ///< Largest P-DATA-TF PDU accepted from peers
+};
+
+// =============================================================================
+// Results and Statistics
+// =============================================================================
+
+/**
+ * @brief Final outcome of one transmission job
+ */
+struct StoreJobResult {
+    uint64_t job_id = 0;
+    std::string destination;
+    std::string path;
+    DicomResult result = DicomResult::DICOM_OK;
+    uint16_t dimse_status = 0;     ///< Last C-STORE status (0 if no response)
+    uint32_t attempts = 0;         ///< Attempts made, including earlier runs
+    int64_t latency_us = 0;        ///< Enqueue (or journal reload) to completion
+};
+
+/**
+ * @brief Completion callback; invoked on an association thread
+ */
+using StoreCallback = std::function<void(const StoreJobResult&)>;
+
+/**
+ * @brief Per-destination counters
+ */
+struct StoreDestinationStats {
+    std::string name;
+    uint64_t images_sent = 0;          ///< Jobs completed successfully
+    uint64_t images_failed = 0;        ///< Jobs failed permanently
+    uint64_t retries = 0;              ///< Failed attempts that were rescheduled
+    uint64_t bytes_sent = 0;           ///< Dataset bytes of successful jobs
+    size_t pending = 0;                ///< Jobs queued or in flight
+    uint32_t open_associations = 0;
+    uint32_t associations_opened = 0;  ///< Associations negotiated since Start
+    double images_per_s = 0.0;         ///< images_sent / time since Start
+    int64_t avg_latency_us = 0;
+    int64_t max_latency_us = 0;
+};
+
+// =============================================================================
+// DicomStoreScu
+// =============================================================================
+
+/**
+ * @brief Storage SCU with per-destination association pools
+ *
+ * Thread Safety: All public methods are thread-safe. Destinations must be
+ * added before Start.
+ */
+class DicomStoreScu {
+public:
+    explicit DicomStoreScu(const StoreScuConfig& config);
+
+    /**
+     * @brief Destructor; calls Stop (pending jobs stay journaled)
+     */
+    ~DicomStoreScu();
+
+    DicomStoreScu(const DicomStoreScu&) = delete;
+    DicomStoreScu& operator=(const DicomStoreScu&) = delete;
+
+    /**
+     * @brief Register a destination
+     * @return DICOM_OK, DICOM_ERR_PARAM (bad name/AE title/limits, duplicate)
+     *         or DICOM_ERR_NOT_SUPPORTED (already started)
+     */
+    DicomResult AddDestination(const DicomDestination& destination);
+
+    /**
+     * @brief Replay the journal and start the association threads
+     * @return DICOM_OK, DICOM_ERR_IO (journal not writable) or
+     *         DICOM_ERR_NOT_SUPPORTED (no socket support on this platform)
+     *
+     * Journaled jobs for destinations that are not registered are kept in
+     * the journal but not sent.
+     */
+    DicomResult Start();
+
+    /**
+     * @brief Stop after outstanding responses arrive; queued jobs stay journaled
+     */
+    void Stop();
+
+    bool IsRunning() const;
+
+    /**
+     * @brief Queue a Part-10 file for transmission
+     * @param destination Registered destination name
+     * @param path Part-10 file; must stay in place until the job completes
+     * @param[out] job_id Optional job identifier (reported in StoreJobResult)
+     * @return DICOM_OK, DICOM_ERR_NOT_RUNNING, DICOM_ERR_PARAM (unknown
+     *         destination, empty path) or DICOM_ERR_IO (journal write failed)
+     */
+    DicomResult Enqueue(const std::string& destination, const std::string& path,
+                        uint64_t* job_id = nullptr);
+
+    /**
+     * @brief Wait until no job is queued or in flight
+     * @return true if idle, false on timeout
+     */
+    bool Flush(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Set the completion callback (before Start)
+     */
+    void SetCallback(StoreCallback callback);
+
+    std::vector<StoreDestinationStats> GetStats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace hnvue::dicom
+
+#endif // HNUE_DICOM_DICOM_STORE_SCU_H
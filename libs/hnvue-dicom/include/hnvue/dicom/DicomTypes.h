@@ -0,0 +1,156 @@
+/**
+ * @file DicomTypes.h
+ * @brief Common types for the native DICOM encoder and storage SCU
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_DICOM_DICOM_TYPES_H
+#define HNUE_DICOM_DICOM_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hnvue::dicom {
+
+// =============================================================================
+// Enumerations
+// =============================================================================
+
+/**
+ * @brief Result codes for DICOM encoding and network operations
+ */
+enum class DicomResult : int32_t {
+    DICOM_OK = 0,
+    DICOM_ERR_PARAM = 1,          ///< Invalid tag, value, image or request
+    DICOM_ERR_IO = 2,             ///< open/write/sync failed
+    DICOM_ERR_NOT_SUPPORTED = 3,  ///< Transfer syntax or image format not supported
+    DICOM_ERR_NETWORK = 4,        ///< Connect, send or receive failed or timed out
+    DICOM_ERR_REJECTED = 5,       ///< Association rejected or C-STORE failure status
+    DICOM_ERR_NOT_RUNNING = 6     ///< Service not started or already stopped
+};
+
+/**
+ * @brief Transfer syntax of the written dataset
+ */
+enum class DicomTransferSyntax : int32_t {
+    TS_EXPLICIT_VR_LITTLE_ENDIAN = 0,  ///< Native pixels, streamed from the frame buffer
+    TS_RLE_LOSSLESS = 1                ///< Encapsulated RLE Lossless (PS3.5 Annex G)
+};
+
+/**
+ * @brief DX IOD variant (Presentation Intent Type)
+ */
+enum class DicomImageType : int32_t {
+    DX_FOR_PRESENTATION = 0,   ///< Processed image for display
+    DX_FOR_PROCESSING = 1      ///< Corrected image for further processing
+};
+
+/// Two-character VR code as stored on disk (first character in the low byte)
+constexpr uint16_t MakeVrCode(char first, char second) {
+    return static_cast<uint16_t>(static_cast<uint8_t>(first) |
+                                 (static_cast<uint8_t>(second) << 8));
+}
+
+/**
+ * @brief Value Representations supported by DicomDataset
+ */
+enum class DicomVR : uint16_t {
+    VR_AE = MakeVrCode('A', 'E'),
+    VR_AS = MakeVrCode('A', 'S'),
+    VR_CS = MakeVrCode('C', 'S'),
+    VR_DA = MakeVrCode('D', 'A'),
+    VR_DS = MakeVrCode('D', 'S'),
+    VR_DT = MakeVrCode('D', 'T'),
+    VR_IS = MakeVrCode('I', 'S'),
+    VR_LO = MakeVrCode('L', 'O'),
+    VR_LT = MakeVrCode('L', 'T'),
+    VR_OB = MakeVrCode('O', 'B'),
+    VR_OW = MakeVrCode('O', 'W'),
+    VR_PN = MakeVrCode('P', 'N'),
+    VR_SH = MakeVrCode('S', 'H'),
+    VR_SL = MakeVrCode('S', 'L'),
+    VR_SS = MakeVrCode('S', 'S'),
+    VR_ST = MakeVrCode('S', 'T'),
+    VR_TM = MakeVrCode('T', 'M'),
+    VR_UI = MakeVrCode('U', 'I'),
+    VR_UL = MakeVrCode('U', 'L'),
+    VR_UN = MakeVrCode('U', 'N'),
+    VR_US = MakeVrCode('U', 'S'),
+    VR_UT = MakeVrCode('U', 'T')
+};
+
+// =============================================================================
+// Tags and UIDs
+// =============================================================================
+
+/// Tag as (group << 16) | element, which orders like the DICOM sort order
+constexpr uint32_t MakeTag(uint16_t group, uint16_t element) {
+    return (static_cast<uint32_t>(group) << 16) | element;
+}
+
+constexpr uint16_t TagGroup(uint32_t tag) { return static_cast<uint16_t>(tag >> 16); }
+constexpr uint16_t TagElement(uint32_t tag) { return static_cast<uint16_t>(tag & 0xFFFFu); }
+
+namespace tags {
+constexpr uint32_t kSopClassUid = MakeTag(0x0008, 0x0016);
+constexpr uint32_t kSopInstanceUid = MakeTag(0x0008, 0x0018);
+constexpr uint32_t kModality = MakeTag(0x0008, 0x0060);
+constexpr uint32_t kPresentationIntentType = MakeTag(0x0008, 0x0068);
+constexpr uint32_t kSamplesPerPixel = MakeTag(0x0028, 0x0002);
+constexpr uint32_t kPhotometricInterpretation = MakeTag(0x0028, 0x0004);
+constexpr uint32_t kRows = MakeTag(0x0028, 0x0010);
+constexpr uint32_t kColumns = MakeTag(0x0028, 0x0011);
+constexpr uint32_t kBitsAllocated = MakeTag(0x0028, 0x0100);
+constexpr uint32_t kBitsStored = MakeTag(0x0028, 0x0101);
+constexpr uint32_t kHighBit = MakeTag(0x0028, 0x0102);
+constexpr uint32_t kPixelRepresentation = MakeTag(0x0028, 0x0103);
+constexpr uint32_t kLossyImageCompression = MakeTag(0x0028, 0x2110);
+constexpr uint32_t kPixelData = MakeTag(0x7FE0, 0x0010);
+} // namespace tags
+
+namespace uids {
+constexpr const char* kDxForPresentation = "1.2.840.10008.5.1.4.1.1.1.1";
+constexpr const char* kDxForProcessing = "1.2.840.10008.5.1.4.1.1.1.1.1";
+constexpr const char* kCrImageStorage = "1.2.840.10008.5.1.4.1.1.1";
+constexpr const char* kImplicitVrLittleEndian = "1.2.840.10008.1.2";
+constexpr const char* kExplicitVrLittleEndian = "1.2.840.10008.1.2.1";
+constexpr const char* kRleLossless = "1.2.840.10008.1.2.5";
+constexpr const char* kApplicationContext = "1.2.840.10008.3.1.1.1";
+/// UUID-derived (2.25) implementation class UID of the HnVue native encoder
+constexpr const char* kImplementationClassUid = "2.25.231048129830547158236810915474372930148";
+} // namespace uids
+
+// =============================================================================
+// Configuration and Statistics
+// =============================================================================
+
+/**
+ * @brief DicomPart10Writer construction parameters
+ */
+struct DicomWriterConfig {
+    DicomTransferSyntax transfer_syntax = DicomTransferSyntax::TS_EXPLICIT_VR_LITTLE_ENDIAN;
+    uint32_t encoder_threads = 0;                      ///< Compression threads (0 = hardware concurrency)
+    std::string implementation_version_name = "HNVUE_010";  ///< (0002,0013), max 16 chars
+    bool sync_on_close = false;                        ///< fdatasync before Write returns
+};
+
+/**
+ * @brief Cost breakdown of one Write call
+ */
+struct DicomWriteStats {
+    uint64_t header_bytes = 0;     ///< Preamble, meta group, dataset and pixel element header
+    uint64_t pixel_bytes = 0;      ///< Pixel data value (native or encapsulated)
+    uint64_t file_bytes = 0;       ///< Total bytes written
+    int64_t encode_us = 0;         ///< Header build and pixel compression
+    int64_t write_us = 0;          ///< File open to close
+    uint32_t write_calls = 0;      ///< writev / fwrite system calls issued
+};
+
+} // namespace hnvue::dicom
+
+#endif // HNUE_DICOM_DICOM_TYPES_H
@@ -0,0 +1,213 @@
+/**
+ * @file DicomAssociation.cpp
+ * @brief Storage SCU association with pipelined C-STORE operations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "DicomAssociation.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <algorithm>
+
+namespace hnvue::dicom::internal {
+
+namespace {
+
+/// Dataset bytes per PDV when the peer does not limit the PDU size
+constexpr uint32_t kDefaultSendBytes = 1u << 20;
+
+} // anonymous namespace
+
+DicomAssociation::~DicomAssociation() {
+    Abort();
+}
+
+DicomResult DicomAssociation::Open(const AssociationParams& params) {
+    Abort();
+    DicomResult result = socket_.Connect(params.host, params.port, params.connect_timeout_ms);
+    if (result != DicomResult::DICOM_OK) {
+        return result;
+    }
+
+    BuildAssociateRq(params.request, pdu_);
+    if (!socket_.Send(pdu_.data(), pdu_.size())) {
+        socket_.Close();
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+
+    PduType type{};
+    result = ReadPdu(socket_, params.connect_timeout_ms, 64 * 1024, type, pdu_);
+    if (result != DicomResult::DICOM_OK) {
+        socket_.Close();
+        return result;
+    }
+    if (type == PduType::PDU_ASSOCIATE_RJ) {
+        socket_.Close();
+        return DicomResult::DICOM_ERR_REJECTED;
+    }
+
+    contexts_ = params.request.contexts;
+    AssociateAccept accept;
+    if (type != PduType::PDU_ASSOCIATE_AC ||
+        !ParseAssociateAc(pdu_.data(), pdu_.size(), contexts_, accept)) {
+        Abort();
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+    if (std::none_of(contexts_.begin(), contexts_.end(),
+                     [](const PresentationContext& c) { return c.accepted; })) {
+        Release(params.connect_timeout_ms);
+        return DicomResult::DICOM_ERR_REJECTED;
+    }
+
+    max_receive_bytes_ = params.request.max_pdu_bytes;
+    // PDV payload must fit the peer's maximum P-DATA-TF length; keep it even
+    uint32_t peer_limit = accept.peer_max_pdu_bytes;
+    max_send_bytes_ = peer_limit == 0 || peer_limit > kDefaultSendBytes + kPdvHeaderBytes
+                          ? kDefaultSendBytes
+                          : (peer_limit - static_cast<uint32_t>(kPdvHeaderBytes)) & ~1u;
+    uint32_t invoked = std::max<uint32_t>(1, params.request.async_invoked);
+    window_ = accept.async_invoked == 0 ? invoked
+                                          : std::min<uint32_t>(invoked, accept.async_invoked);
+    last_activity_us_ = infra::MonotonicClock::NowUs();
+    return DicomResult::DICOM_OK;
+}
+
+uint8_t DicomAssociation::FindContext(const std::string& sop_class,
+                                      const std::string& transfer_syntax) const {
+    for (const PresentationContext& context : contexts_) {
+        if (context.accepted && context.abstract_syntax == sop_class &&
+            context.transfer_syntax == transfer_syntax) {
+            return context.id;
+        }
+    }
+    return 0;
+}
+
+DicomResult DicomAssociation::SendStore(uint8_t context_id, uint16_t message_id,
+                                        const Part10FileInfo& info, int file_fd) {
+    if (max_send_bytes_ < 2) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+    BuildStoreRq(info.sop_class_uid, info.sop_instance_uid, message_id, command_);
+    uint8_t header[kPduHeaderBytes + kPdvHeaderBytes];
+    BuildPDataHeader(header, static_cast<uint32_t>(command_.size()), context_id,
+                     kPdvCommand | kPdvLast);
+    if (!socket_.Send(header, sizeof(header), true) ||
+        !socket_.Send(command_.data(), command_.size(), true)) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+
+    // Dataset: PDU headers from user space, payload straight from the file
+    uint64_t offset = info.dataset_offset;
+    uint64_t remaining = info.file_bytes - info.dataset_offset;
+    do {
+        auto chunk = static_cast<uint32_t>(std::min<uint64_t>(remaining, max_send_bytes_));
+        bool last = chunk == remaining;
+        BuildPDataHeader(header, chunk, context_id, last ? kPdvLast : 0);
+        if (!socket_.Send(header, sizeof(header), chunk > 0) ||
+            (chunk > 0 && !socket_.SendFile(file_fd, offset, chunk))) {
+            return DicomResult::DICOM_ERR_NETWORK;
+        }
+        offset += chunk;
+        remaining -= chunk;
+    } while (remaining > 0);
+
+    last_activity_us_ = infra::MonotonicClock::NowUs();
+    return DicomResult::DICOM_OK;
+}
+
+DicomResult DicomAssociation::ReceiveResponse(int64_t timeout_ms, uint16_t& message_id,
+                                              uint16_t& status) {
+    response_.clear();
+    for (;;) {
+        // PDVs left over from the previous call come first
+        if (received_pos_ >= received_.size()) {
+            PduType type{};
+            received_pos_ = 0;
+            if (ReadPdu(socket_, timeout_ms, max_receive_bytes_, type, received_) !=
+                DicomResult::DICOM_OK) {
+                received_.clear();
+                return DicomResult::DICOM_ERR_NETWORK;
+            }
+            if (type != PduType::PDU_P_DATA_TF) {
+                // A-ABORT, unexpected release or garbage: the association is gone
+                received_.clear();
+                socket_.Close();
+                return DicomResult::DICOM_ERR_NETWORK;
+            }
+        }
+
+        while (received_pos_ < received_.size()) {
+            size_t pos = received_pos_;
+            uint32_t item_length = 0;
+            if (pos + kPdvHeaderBytes <= received_.size()) {
+                item_length = (static_cast<uint32_t>(received_[pos]) << 24) |
+                              (static_cast<uint32_t>(received_[pos + 1]) << 16) |
+                              (static_cast<uint32_t>(received_[pos + 2]) << 8) | received_[pos + 3];
+            }
+            if (item_length < 2 || pos + 4 + item_length > received_.size()) {
+                Abort();
+                return DicomResult::DICOM_ERR_NETWORK;
+            }
+            uint8_t control = received_[pos + 5];
+            const uint8_t* data = received_.data() + pos + kPdvHeaderBytes;
+            size_t data_bytes = item_length - 2;
+            received_pos_ = pos + 4 + item_length;
+
+            if ((control & kPdvCommand) == 0) {
+                continue;   // C-STORE-RSP carries no dataset
+            }
+            response_.insert(response_.end(), data, data + data_bytes);
+            if ((control & kPdvLast) == 0) {
+                continue;
+            }
+
+            CommandFields fields;
+            if (!ParseCommand(response_.data(), response_.size(), fields) ||
+                fields.command_field != kCommandCStoreRsp) {
+                Abort();
+                return DicomResult::DICOM_ERR_NETWORK;
+            }
+            message_id = fields.message_id_responded;
+            status = fields.status;
+            last_activity_us_ = infra::MonotonicClock::NowUs();
+            return DicomResult::DICOM_OK;
+        }
+    }
+}
+
+void DicomAssociation::Release(int64_t timeout_ms) {
+    received_.clear();
+    received_pos_ = 0;
+    if (!socket_.IsOpen()) {
+        return;
+    }
+    BuildReleaseRq(pdu_);
+    if (socket_.Send(pdu_.data(), pdu_.size())) {
+        // Discard late P-DATA until the release response (or timeout)
+        PduType type{};
+        while (ReadPdu(socket_, timeout_ms, max_receive_bytes_, type, pdu_) ==
+                   DicomResult::DICOM_OK &&
+               type == PduType::PDU_P_DATA_TF) {
+        }
+    }
+    socket_.Close();
+}
+
+void DicomAssociation::Abort() {
+    received_.clear();
+    received_pos_ = 0;
+    if (!socket_.IsOpen()) {
+        return;
+    }
+    BuildAbort(pdu_);
+    socket_.Send(pdu_.data(), pdu_.size());
+    socket_.Close();
+}
+
+} // namespace hnvue::dicom::internal
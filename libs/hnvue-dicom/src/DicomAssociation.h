@@ -0,0 +1,111 @@
+/**
+ * @file DicomAssociation.h
+ * @brief Storage SCU association with pipelined C-STORE operations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_DICOM_DICOM_ASSOCIATION_H
+#define HNUE_DICOM_DICOM_ASSOCIATION_H
+
+#include "DicomSocket.h"
+#include "DicomUpperLayer.h"
+#include "Part10File.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+/**
+ * @brief Parameters for opening an association
+ */
+struct AssociationParams {
+    std::string host;
+    uint16_t port = 104;
+    AssociateRequest request;
+    int64_t connect_timeout_ms = 5000;
+};
+
+/**
+ * @brief One association; used by a single thread
+ *
+ * SendStore and ReceiveResponse may be interleaved freely up to Window()
+ * outstanding requests.
+ */
+class DicomAssociation {
+public:
+    DicomAssociation() = default;
+    ~DicomAssociation();
+
+    DicomAssociation(const DicomAssociation&) = delete;
+    DicomAssociation& operator=(const DicomAssociation&) = delete;
+
+    /**
+     * @brief Connect and negotiate
+     * @return DICOM_OK, DICOM_ERR_NETWORK, DICOM_ERR_REJECTED (A-ASSOCIATE-RJ
+     *         or no context accepted) or DICOM_ERR_NOT_SUPPORTED
+     */
+    DicomResult Open(const AssociationParams& params);
+
+    bool IsOpen() const { return socket_.IsOpen(); }
+
+    /// Negotiated number of outstanding requests (>= 1)
+    uint32_t Window() const { return window_; }
+
+    /// Accepted context for the SOP class and transfer syntax, 0 if none
+    uint8_t FindContext(const std::string& sop_class, const std::string& transfer_syntax) const;
+
+    /**
+     * @brief Send a C-STORE-RQ and the file's dataset
+     * @param file_fd Open descriptor of the Part-10 file
+     * @return DICOM_OK or DICOM_ERR_NETWORK (association unusable)
+     */
+    DicomResult SendStore(uint8_t context_id, uint16_t message_id, const Part10FileInfo& info,
+                          int file_fd);
+
+    /**
+     * @brief Wait for the next C-STORE-RSP
+     *
+     * A peer may pack several responses into one P-DATA-TF; the PDVs after
+     * the returned response are kept and parsed by the next call.
+     *
+     * @return DICOM_OK or DICOM_ERR_NETWORK (timeout, abort, protocol error)
+     */
+    DicomResult ReceiveResponse(int64_t timeout_ms, uint16_t& message_id, uint16_t& status);
+
+    /// True when a response (or an abort) is waiting to be read
+    bool ResponsePending(int64_t timeout_ms) {
+        return received_pos_ < received_.size() || socket_.WaitReadable(timeout_ms);
+    }
+
+    /// Orderly release (A-RELEASE-RQ/RP), then close
+    void Release(int64_t timeout_ms);
+
+    /// A-ABORT, then close
+    void Abort();
+
+    /// MonotonicClock time of the last request or response
+    int64_t LastActivityUs() const { return last_activity_us_; }
+
+private:
+    DicomSocket socket_;
+    std::vector<PresentationContext> contexts_;
+    uint32_t max_receive_bytes_ = 0;
+    uint32_t max_send_bytes_ = 0;
+    uint32_t window_ = 1;
+    int64_t last_activity_us_ = 0;
+    std::vector<uint8_t> command_;
+    std::vector<uint8_t> pdu_;
+    std::vector<uint8_t> received_;   ///< Last P-DATA-TF received
+    size_t received_pos_ = 0;         ///< Next unparsed PDV in received_
+    std::vector<uint8_t> response_;
+};
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_DICOM_ASSOCIATION_H
@@ -0,0 +1,106 @@
+/**
+ * @file DicomDataset.cpp
+ * @brief Pre-encoded DICOM dataset fragment
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/dicom/DicomDataset.h"
+
+#include "DicomEncoding.h"
+
+#include <algorithm>
+
+namespace hnvue::dicom {
+
+namespace {
+
+bool IsReservedTag(uint32_t tag) {
+    uint16_t group = TagGroup(tag);
+    return group == 0x0002 || group == 0xFFFE || tag == tags::kPixelData ||
+           TagElement(tag) == 0x0000;   // Group lengths are computed by the writer
+}
+
+} // anonymous namespace
+
+DicomResult DicomDataset::SetString(uint32_t tag, DicomVR vr, const std::string& value) {
+    if (!internal::IsStringVr(vr)) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    uint8_t padding = vr == DicomVR::VR_UI ? '\0' : ' ';
+    return Insert(tag, vr, value.data(), value.size(), padding);
+}
+
+DicomResult DicomDataset::SetUInt16(uint32_t tag, uint16_t value) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    return Insert(tag, DicomVR::VR_US, bytes, sizeof(bytes), 0);
+}
+
+DicomResult DicomDataset::SetUInt32(uint32_t tag, uint32_t value) {
+    uint8_t bytes[4] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                        static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+    return Insert(tag, DicomVR::VR_UL, bytes, sizeof(bytes), 0);
+}
+
+DicomResult DicomDataset::SetBytes(uint32_t tag, DicomVR vr, const void* data, size_t size) {
+    if (internal::IsStringVr(vr) || (size > 0 && data == nullptr)) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    // Only OB and UN may carry a padding byte; word-based VRs must be even
+    if ((size & 1) != 0 && vr != DicomVR::VR_OB && vr != DicomVR::VR_UN) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    return Insert(tag, vr, data, size, 0);
+}
+
+DicomResult DicomDataset::Insert(uint32_t tag, DicomVR vr, const void* data, size_t size,
+                                 uint8_t padding) {
+    if (IsReservedTag(tag) || size + (size & 1) > internal::MaxValueLength(vr)) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+
+    Element element;
+    element.tag = tag;
+    internal::AppendElement(element.bytes, tag, vr, data, size, padding);
+
+    auto it = std::lower_bound(elements_.begin(), elements_.end(), tag,
+                               [](const Element& e, uint32_t t) { return e.tag < t; });
+    if (it != elements_.end() && it->tag == tag) {
+        encoded_bytes_ -= it->bytes.size();
+        encoded_bytes_ += element.bytes.size();
+        *it = std::move(element);
+    } else {
+        encoded_bytes_ += element.bytes.size();
+        elements_.insert(it, std::move(element));
+    }
+    return DicomResult::DICOM_OK;
+}
+
+void DicomDataset::Remove(uint32_t tag) {
+    auto it = std::lower_bound(elements_.begin(), elements_.end(), tag,
+                               [](const Element& e, uint32_t t) { return e.tag < t; });
+    if (it != elements_.end() && it->tag == tag) {
+        encoded_bytes_ -= it->bytes.size();
+        elements_.erase(it);
+    }
+}
+
+bool DicomDataset::Contains(uint32_t tag) const {
+    return Find(tag) != nullptr;
+}
+
+const DicomDataset::Element* DicomDataset::Find(uint32_t tag) const {
+    auto it = std::lower_bound(elements_.begin(), elements_.end(), tag,
+                               [](const Element& e, uint32_t t) { return e.tag < t; });
+    return (it != elements_.end() && it->tag == tag) ? &*it : nullptr;
+}
+
+void DicomDataset::Clear() {
+    elements_.clear();
+    encoded_bytes_ = 0;
+}
+
+} // namespace hnvue::dicom
@@ -0,0 +1,99 @@
+/**
+ * @file DicomEncoding.cpp
+ * @brief Explicit VR Little Endian element encoding helpers
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "DicomEncoding.h"
+
+#include <cstring>
+
+namespace hnvue::dicom::internal {
+
+bool IsLongLengthVr(DicomVR vr) {
+    switch (vr) {
+        case DicomVR::VR_OB:
+        case DicomVR::VR_OW:
+        case DicomVR::VR_UN:
+        case DicomVR::VR_UT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool IsStringVr(DicomVR vr) {
+    switch (vr) {
+        case DicomVR::VR_AE:
+        case DicomVR::VR_AS:
+        case DicomVR::VR_CS:
+        case DicomVR::VR_DA:
+        case DicomVR::VR_DS:
+        case DicomVR::VR_DT:
+        case DicomVR::VR_IS:
+        case DicomVR::VR_LO:
+        case DicomVR::VR_LT:
+        case DicomVR::VR_PN:
+        case DicomVR::VR_SH:
+        case DicomVR::VR_ST:
+        case DicomVR::VR_TM:
+        case DicomVR::VR_UI:
+        case DicomVR::VR_UT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32_t MaxValueLength(DicomVR vr) {
+    // 0xFFFFFFFF is reserved for undefined length
+    return IsLongLengthVr(vr) ? 0xFFFFFFFEu : 0xFFFEu;
+}
+
+void AppendUInt16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void AppendUInt32(std::vector<uint8_t>& out, uint32_t value) {
+    AppendUInt16(out, static_cast<uint16_t>(value));
+    AppendUInt16(out, static_cast<uint16_t>(value >> 16));
+}
+
+void AppendElementHeader(std::vector<uint8_t>& out, uint32_t tag, DicomVR vr, uint32_t length) {
+    AppendUInt16(out, TagGroup(tag));
+    AppendUInt16(out, TagElement(tag));
+    AppendUInt16(out, static_cast<uint16_t>(vr));
+    if (IsLongLengthVr(vr)) {
+        AppendUInt16(out, 0);
+        AppendUInt32(out, length);
+    } else {
+        AppendUInt16(out, static_cast<uint16_t>(length));
+    }
+}
+
+void AppendElement(std::vector<uint8_t>& out, uint32_t tag, DicomVR vr, const void* value,
+                   size_t length, uint8_t padding) {
+    size_t padded = length + (length & 1);
+    AppendElementHeader(out, tag, vr, static_cast<uint32_t>(padded));
+    size_t start = out.size();
+    out.resize(start + padded);
+    if (length > 0) {
+        std::memcpy(out.data() + start, value, length);
+    }
+    if (padded != length) {
+        out.back() = padding;
+    }
+}
+
+void AppendItemHeader(std::vector<uint8_t>& out, uint32_t tag, uint32_t length) {
+    AppendUInt16(out, TagGroup(tag));
+    AppendUInt16(out, TagElement(tag));
+    AppendUInt32(out, length);
+}
+
+} // namespace hnvue::dicom::internal
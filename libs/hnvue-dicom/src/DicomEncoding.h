@@ -0,0 +1,56 @@
+/**
+ * @file DicomEncoding.h
+ * @brief Explicit VR Little Endian element encoding helpers
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_DICOM_DICOM_ENCODING_H
+#define HNUE_DICOM_DICOM_ENCODING_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+constexpr uint32_t kItemTag = MakeTag(0xFFFE, 0xE000);
+constexpr uint32_t kSequenceDelimitationTag = MakeTag(0xFFFE, 0xE0DD);
+constexpr uint32_t kUndefinedLength = 0xFFFFFFFFu;
+
+/// true for VRs with a 2-byte reserved field and 32-bit length (PS3.5 7.1.2)
+bool IsLongLengthVr(DicomVR vr);
+
+/// true for character-string VRs
+bool IsStringVr(DicomVR vr);
+
+/// Largest encodable value length for the VR
+uint32_t MaxValueLength(DicomVR vr);
+
+void AppendUInt16(std::vector<uint8_t>& out, uint16_t value);
+void AppendUInt32(std::vector<uint8_t>& out, uint32_t value);
+
+/**
+ * @brief Append tag, VR and length
+ */
+void AppendElementHeader(std::vector<uint8_t>& out, uint32_t tag, DicomVR vr, uint32_t length);
+
+/**
+ * @brief Append a complete element; an odd-length value gets one padding byte
+ */
+void AppendElement(std::vector<uint8_t>& out, uint32_t tag, DicomVR vr, const void* value,
+                   size_t length, uint8_t padding);
+
+/**
+ * @brief Append an item or delimiter tag with its 32-bit length (no VR)
+ */
+void AppendItemHeader(std::vector<uint8_t>& out, uint32_t tag, uint32_t length);
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_DICOM_ENCODING_H
@@ -0,0 +1,308 @@
+/**
+ * @file DicomPart10Writer.cpp
+ * @brief Native DX Part-10 file writer for processed images
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/dicom/DicomPart10Writer.h"
+
+#include "DicomEncoding.h"
+#include "RleLosslessEncoder.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace hnvue::dicom {
+
+namespace {
+
+constexpr size_t kPreambleBytes = 128;
+constexpr size_t kMaxUidLength = 64;
+
+/// Linux IOV_MAX; larger gathers are split across writev calls
+constexpr size_t kMaxIov = 1024;
+
+/**
+ * @brief Contiguous piece of the output file
+ */
+struct IoSlice {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+#ifdef _WIN32
+
+bool WriteSlices(const std::string& path, const std::vector<IoSlice>& slices, bool sync,
+                 uint32_t& calls) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = true;
+    for (const IoSlice& slice : slices) {
+        ++calls;
+        if (std::fwrite(slice.data, 1, slice.size, file) != slice.size) {
+            ok = false;
+            break;
+        }
+    }
+    if (ok && sync) {
+        ok = std::fflush(file) == 0 && _commit(_fileno(file)) == 0;
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+#else
+
+/**
+ * @brief Gather-write all slices, resuming after partial writes
+ */
+bool WriteSlices(const std::string& path, const std::vector<IoSlice>& slices, bool sync,
+                 uint32_t& calls) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    iovec iov[kMaxIov];
+    size_t index = 0;
+    size_t offset = 0;   // Bytes of slices[index] already written
+    bool ok = true;
+    while (index < slices.size()) {
+        size_t count = 0;
+        for (size_t i = index; i < slices.size() && count < kMaxIov; ++i) {
+            size_t skip = i == index ? offset : 0;
+            iov[count].iov_base = const_cast<uint8_t*>(slices[i].data + skip);
+            iov[count].iov_len = slices[i].size - skip;
+            ++count;
+        }
+
+        ssize_t written = writev(fd, iov, static_cast<int>(count));
+        ++calls;
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = false;
+            break;
+        }
+
+        auto remaining = static_cast<size_t>(written);
+        while (index < slices.size() && remaining >= slices[index].size - offset) {
+            remaining -= slices[index].size - offset;
+            ++index;
+            offset = 0;
+        }
+        offset += remaining;
+    }
+
+    if (ok && sync) {
+        ok = fdatasync(fd) == 0;
+    }
+    if (close(fd) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+#endif
+
+} // anonymous namespace
+
+// =============================================================================
+// DicomPart10Writer
+// =============================================================================
+
+DicomPart10Writer::DicomPart10Writer(const DicomWriterConfig& config)
+    : config_(config) {
+    encoder_threads_ = config_.encoder_threads;
+    if (encoder_threads_ == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        encoder_threads_ = hw == 0 ? 1 : hw;
+    }
+    header_.reserve(16 * 1024);
+}
+
+DicomPart10Writer::~DicomPart10Writer() = default;
+
+DicomResult DicomPart10Writer::BuildHeader(const imaging::ImageBuffer& image,
+                                           const DicomImageRequest& request,
+                                           uint64_t pixel_value_bytes) {
+    const bool rle = config_.transfer_syntax == DicomTransferSyntax::TS_RLE_LOSSLESS;
+    const char* sop_class = request.image_type == DicomImageType::DX_FOR_PROCESSING
+                                ? uids::kDxForProcessing
+                                : uids::kDxForPresentation;
+    const char* transfer_syntax = rle ? uids::kRleLossless : uids::kExplicitVrLittleEndian;
+
+    header_.assign(kPreambleBytes, 0);
+    header_.insert(header_.end(), {'D', 'I', 'C', 'M'});
+
+    // File meta information (always Explicit VR Little Endian)
+    std::vector<uint8_t> meta;
+    const uint8_t version[2] = {0x00, 0x01};
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0001), DicomVR::VR_OB, version, 2, 0);
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0002), DicomVR::VR_UI, sop_class,
+                            std::strlen(sop_class), '\0');
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0003), DicomVR::VR_UI,
+                            request.sop_instance_uid.data(), request.sop_instance_uid.size(), '\0');
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0010), DicomVR::VR_UI, transfer_syntax,
+                            std::strlen(transfer_syntax), '\0');
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0012), DicomVR::VR_UI,
+                            uids::kImplementationClassUid,
+                            std::strlen(uids::kImplementationClassUid), '\0');
+    internal::AppendElement(meta, MakeTag(0x0002, 0x0013), DicomVR::VR_SH,
+                            config_.implementation_version_name.data(),
+                            std::min<size_t>(config_.implementation_version_name.size(), 16), ' ');
+    internal::AppendElementHeader(header_, MakeTag(0x0002, 0x0000), DicomVR::VR_UL, 4);
+    internal::AppendUInt32(header_, static_cast<uint32_t>(meta.size()));
+    header_.insert(header_.end(), meta.begin(), meta.end());
+
+    // Generated SOP Common / DX Image / Image Pixel elements
+    generated_.Clear();
+    generated_.SetString(tags::kSopClassUid, DicomVR::VR_UI, sop_class);
+    if (generated_.SetString(tags::kSopInstanceUid, DicomVR::VR_UI, request.sop_instance_uid) !=
+        DicomResult::DICOM_OK) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    generated_.SetString(tags::kModality, DicomVR::VR_CS, "DX");
+    generated_.SetString(tags::kPresentationIntentType, DicomVR::VR_CS,
+                         request.image_type == DicomImageType::DX_FOR_PROCESSING
+                             ? "FOR PROCESSING"
+                             : "FOR PRESENTATION");
+    generated_.SetUInt16(tags::kSamplesPerPixel, 1);
+    generated_.SetString(tags::kPhotometricInterpretation, DicomVR::VR_CS, "MONOCHROME2");
+    generated_.SetUInt16(tags::kRows, static_cast<uint16_t>(image.height));
+    generated_.SetUInt16(tags::kColumns, static_cast<uint16_t>(image.width));
+    generated_.SetUInt16(tags::kBitsAllocated, 16);
+    generated_.SetUInt16(tags::kBitsStored, request.bits_stored);
+    generated_.SetUInt16(tags::kHighBit, static_cast<uint16_t>(request.bits_stored - 1));
+    generated_.SetUInt16(tags::kPixelRepresentation, 0);
+    generated_.SetString(tags::kLossyImageCompression, DicomVR::VR_CS, "00");
+
+    // Splice the cached fragments: sort by tag, highest precedence first
+    struct Source {
+        const DicomDataset::Element* element;
+        int precedence;
+    };
+    const DicomDataset* datasets[] = {&generated_, request.instance, request.protocol.get(),
+                                      request.patient.get()};
+    std::vector<Source> sources;
+    for (int precedence = 0; precedence < 4; ++precedence) {
+        if (datasets[precedence] == nullptr) {
+            continue;
+        }
+        for (const DicomDataset::Element& element : datasets[precedence]->Elements()) {
+            sources.push_back({&element, precedence});
+        }
+    }
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) {
+        return a.element->tag != b.element->tag ? a.element->tag < b.element->tag
+                                                : a.precedence < b.precedence;
+    });
+    uint32_t previous_tag = 0;
+    for (const Source& source : sources) {
+        if (source.element->tag == previous_tag) {
+            continue;
+        }
+        previous_tag = source.element->tag;
+        header_.insert(header_.end(), source.element->bytes.begin(), source.element->bytes.end());
+    }
+
+    // Pixel Data element header; the value follows from the frame or fragment buffer
+    if (rle) {
+        internal::AppendElementHeader(header_, tags::kPixelData, DicomVR::VR_OB,
+                                      internal::kUndefinedLength);
+        internal::AppendItemHeader(header_, internal::kItemTag, 0);   // Empty basic offset table
+        internal::AppendItemHeader(header_, internal::kItemTag,
+                                   static_cast<uint32_t>(pixel_value_bytes));
+    } else {
+        internal::AppendElementHeader(header_, tags::kPixelData, DicomVR::VR_OW,
+                                      static_cast<uint32_t>(pixel_value_bytes));
+    }
+    return DicomResult::DICOM_OK;
+}
+
+DicomResult DicomPart10Writer::Write(const std::string& path, const imaging::ImageBuffer& image,
+                                     const DicomImageRequest& request, DicomWriteStats* stats) {
+    if (path.empty() || image.data == nullptr || image.width == 0 || image.height == 0 ||
+        image.width > 0xFFFF || image.height > 0xFFFF ||
+        image.stride < static_cast<uint64_t>(image.width) * sizeof(uint16_t) ||
+        request.sop_instance_uid.empty() || request.sop_instance_uid.size() > kMaxUidLength ||
+        request.bits_stored == 0 || request.bits_stored > 16) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    if (image.pixel_depth != 16) {
+        return DicomResult::DICOM_ERR_NOT_SUPPORTED;
+    }
+
+    const int64_t start_us = infra::MonotonicClock::NowUs();
+    const bool rle = config_.transfer_syntax == DicomTransferSyntax::TS_RLE_LOSSLESS;
+    const size_t row_bytes = static_cast<size_t>(image.width) * sizeof(uint16_t);
+    const auto* pixels = reinterpret_cast<const uint8_t*>(image.data);
+
+    uint64_t pixel_value_bytes = static_cast<uint64_t>(row_bytes) * image.height;
+    if (rle) {
+        internal::EncodeRleLossless(pixels, image.stride, image.width, image.height,
+                                    encoder_threads_, encoded_pixels_);
+        pixel_value_bytes = encoded_pixels_.size();
+    }
+    if (pixel_value_bytes > internal::MaxValueLength(DicomVR::VR_OW)) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    DicomResult result = BuildHeader(image, request, pixel_value_bytes);
+    if (result != DicomResult::DICOM_OK) {
+        return result;
+    }
+
+    // Header, then the pixel value straight from the frame (or fragment) buffer
+    static const uint8_t kTrailer[8] = {0xFE, 0xFF, 0xDD, 0xE0, 0, 0, 0, 0};   // Sequence delimiter
+    std::vector<IoSlice> slices;
+    slices.push_back({header_.data(), header_.size()});
+    if (rle) {
+        slices.push_back({encoded_pixels_.data(), encoded_pixels_.size()});
+        slices.push_back({kTrailer, sizeof(kTrailer)});
+    } else if (image.stride == row_bytes) {
+        slices.push_back({pixels, row_bytes * image.height});
+    } else {
+        slices.reserve(1 + image.height);
+        for (uint32_t y = 0; y < image.height; ++y) {
+            slices.push_back({pixels + static_cast<size_t>(y) * image.stride, row_bytes});
+        }
+    }
+
+    const int64_t write_start_us = infra::MonotonicClock::NowUs();
+    uint32_t calls = 0;
+    if (!WriteSlices(path, slices, config_.sync_on_close, calls)) {
+        std::remove(path.c_str());
+        return DicomResult::DICOM_ERR_IO;
+    }
+
+    if (stats != nullptr) {
+        stats->header_bytes = header_.size();
+        stats->pixel_bytes = pixel_value_bytes;
+        stats->file_bytes = header_.size() + pixel_value_bytes + (rle ? sizeof(kTrailer) : 0);
+        stats->encode_us = write_start_us - start_us;
+        stats->write_us = infra::MonotonicClock::NowUs() - write_start_us;
+        stats->write_calls = calls;
+    }
+    return DicomResult::DICOM_OK;
+}
+
+} // namespace hnvue::dicom
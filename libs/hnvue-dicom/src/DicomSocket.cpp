@@ -0,0 +1,212 @@
+/**
+ * @file DicomSocket.cpp
+ * @brief Blocking TCP socket with deadlines for DICOM associations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "DicomSocket.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/sendfile.h>
+    #endif
+#endif
+
+namespace hnvue::dicom::internal {
+
+#ifdef _WIN32
+
+DicomSocket::~DicomSocket() = default;
+
+bool DicomSocket::IsSupported() { return false; }
+
+DicomResult DicomSocket::Connect(const std::string&, uint16_t, int64_t) {
+    return DicomResult::DICOM_ERR_NOT_SUPPORTED;
+}
+
+bool DicomSocket::Send(const void*, size_t, bool) { return false; }
+bool DicomSocket::SendFile(int, uint64_t, size_t) { return false; }
+bool DicomSocket::Receive(void*, size_t, int64_t) { return false; }
+bool DicomSocket::WaitReadable(int64_t) { return false; }
+void DicomSocket::Close() {}
+
+#else
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+/// Wait for readiness until deadline_us; false on timeout or error
+bool PollUntil(int fd, short events, int64_t deadline_us) {
+    for (;;) {
+        int64_t remaining_ms = (deadline_us - infra::MonotonicClock::NowUs() + 999) / 1000;
+        if (remaining_ms <= 0) {
+            return false;
+        }
+        pollfd pfd{fd, events, 0};
+        int ready = poll(&pfd, 1, static_cast<int>(std::min<int64_t>(remaining_ms, 60000)));
+        if (ready > 0) {
+            return true;
+        }
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+}
+
+} // anonymous namespace
+
+DicomSocket::~DicomSocket() {
+    Close();
+}
+
+bool DicomSocket::IsSupported() { return true; }
+
+DicomResult DicomSocket::Connect(const std::string& host, uint16_t port, int64_t timeout_ms) {
+    Close();
+    const int64_t deadline_us = infra::MonotonicClock::NowUs() + timeout_ms * 1000;
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+
+    for (addrinfo* ai = addresses; ai != nullptr && fd_ < 0; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int rc = connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc != 0 && errno == EINPROGRESS && PollUntil(fd, POLLOUT, deadline_us)) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            rc = error == 0 ? 0 : -1;
+        }
+        if (rc != 0) {
+            close(fd);
+            continue;
+        }
+        fcntl(fd, F_SETFL, flags);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fd_ = fd;
+    }
+    freeaddrinfo(addresses);
+    return fd_ >= 0 ? DicomResult::DICOM_OK : DicomResult::DICOM_ERR_NETWORK;
+}
+
+bool DicomSocket::Send(const void* data, size_t size, bool more) {
+    int flags = kSendFlags;
+#ifdef MSG_MORE
+    if (more) {
+        flags |= MSG_MORE;
+    }
+#else
+    (void)more;
+#endif
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0 && fd_ >= 0) {
+        ssize_t sent = send(fd_, bytes, size, flags);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return size == 0;
+}
+
+bool DicomSocket::SendFile(int file_fd, uint64_t offset, size_t size) {
+#ifdef __linux__
+    auto position = static_cast<off_t>(offset);
+    while (size > 0 && fd_ >= 0) {
+        ssize_t sent = sendfile(fd_, file_fd, &position, size);
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size -= static_cast<size_t>(sent);
+    }
+    return size == 0;
+#else
+    std::vector<uint8_t> buffer(std::min<size_t>(size, 256 * 1024));
+    while (size > 0) {
+        size_t chunk = std::min(size, buffer.size());
+        ssize_t got = pread(file_fd, buffer.data(), chunk, static_cast<off_t>(offset));
+        if (got <= 0 || !Send(buffer.data(), static_cast<size_t>(got))) {
+            return false;
+        }
+        offset += static_cast<uint64_t>(got);
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+#endif
+}
+
+bool DicomSocket::Receive(void* data, size_t size, int64_t timeout_ms) {
+    const int64_t deadline_us = infra::MonotonicClock::NowUs() + timeout_ms * 1000;
+    auto* bytes = static_cast<uint8_t*>(data);
+    while (size > 0 && fd_ >= 0) {
+        if (!PollUntil(fd_, POLLIN, deadline_us)) {
+            return false;
+        }
+        ssize_t got = recv(fd_, bytes, size, 0);
+        if (got <= 0) {
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;   // Peer closed or error
+        }
+        bytes += got;
+        size -= static_cast<size_t>(got);
+    }
+    return size == 0;
+}
+
+bool DicomSocket::WaitReadable(int64_t timeout_ms) {
+    return fd_ >= 0 &&
+           PollUntil(fd_, POLLIN, infra::MonotonicClock::NowUs() + timeout_ms * 1000);
+}
+
+void DicomSocket::Close() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+#endif
+
+} // namespace hnvue::dicom::internal
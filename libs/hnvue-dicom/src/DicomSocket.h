@@ -0,0 +1,73 @@
+/**
+ * @file DicomSocket.h
+ * @brief Blocking TCP socket with deadlines for DICOM associations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_DICOM_DICOM_SOCKET_H
+#define HNUE_DICOM_DICOM_SOCKET_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hnvue::dicom::internal {
+
+/**
+ * @brief Owning TCP client socket
+ *
+ * POSIX only; on other platforms Connect returns DICOM_ERR_NOT_SUPPORTED.
+ */
+class DicomSocket {
+public:
+    DicomSocket() = default;
+    ~DicomSocket();
+
+    DicomSocket(const DicomSocket&) = delete;
+    DicomSocket& operator=(const DicomSocket&) = delete;
+
+    /// true if sockets are implemented on this platform
+    static bool IsSupported();
+
+    /**
+     * @brief Connect with a timeout; sets TCP_NODELAY
+     * @return DICOM_OK, DICOM_ERR_NETWORK or DICOM_ERR_NOT_SUPPORTED
+     */
+    DicomResult Connect(const std::string& host, uint16_t port, int64_t timeout_ms);
+
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * @brief Send all bytes
+     * @param more Hint that more data follows immediately (MSG_MORE)
+     */
+    bool Send(const void* data, size_t size, bool more = false);
+
+    /**
+     * @brief Send a file range without copying it through user space
+     */
+    bool SendFile(int file_fd, uint64_t offset, size_t size);
+
+    /**
+     * @brief Receive exactly size bytes before the timeout expires
+     */
+    bool Receive(void* data, size_t size, int64_t timeout_ms);
+
+    /// True when data (or EOF) can be read within timeout_ms
+    bool WaitReadable(int64_t timeout_ms);
+
+    void Close();
+
+private:
+    int fd_ = -1;
+};
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_DICOM_SOCKET_H
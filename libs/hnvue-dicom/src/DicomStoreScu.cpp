@@ -0,0 +1,581 @@
+/**
+ * @file DicomStoreScu.cpp
+ * @brief Pipelined C-STORE SCU with a crash-safe transmission queue
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/dicom/DicomStoreScu.h"
+
+#include "DicomAssociation.h"
+#include "Part10File.h"
+#include "TransmissionJournal.h"
+
+#include "hnvue/infra/Clock.h"
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace hnvue::dicom {
+
+namespace {
+
+constexpr size_t kMaxAeTitle = 16;
+constexpr int64_t kMaxIdleWaitUs = 1000000;
+constexpr int64_t kWindowPollMs = 5;
+
+/// SOP classes and transfer syntaxes proposed on every association
+constexpr const char* kStorageClasses[] = {uids::kDxForPresentation, uids::kDxForProcessing,
+                                           uids::kCrImageStorage};
+constexpr const char* kTransferSyntaxes[] = {uids::kExplicitVrLittleEndian, uids::kRleLossless,
+                                             uids::kImplicitVrLittleEndian};
+
+bool IsValidAeTitle(const std::string& title) {
+    return !title.empty() && title.size() <= kMaxAeTitle &&
+           title.find('\\') == std::string::npos;
+}
+
+/**
+ * @brief C-STORE status classes (PS3.4 B.2.3)
+ */
+bool IsSuccessStatus(uint16_t status) {
+    return status == 0x0000 || status == 0xB000 || status == 0xB006 || status == 0xB007;
+}
+
+/// Out of resources / processing failure: worth retrying later
+bool IsTransientStatus(uint16_t status) {
+    return (status & 0xFF00) == 0xA700 || status == 0x0110 || status == 0x0213;
+}
+
+int OpenReadOnly(const std::string& path) {
+#ifdef _WIN32
+    return -1;
+#else
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void CloseFd(int fd) {
+#ifndef _WIN32
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Implementation State
+// =============================================================================
+
+struct DicomStoreScu::Impl {
+    struct Job {
+        uint64_t id = 0;
+        std::string path;
+        uint32_t attempts = 0;
+        int64_t enqueue_us = 0;
+        int64_t not_before_us = 0;      ///< Backoff: not sent before this time
+        uint64_t bytes = 0;
+        uint16_t last_status = 0;
+    };
+
+    struct Destination {
+        DicomDestination config;
+        std::deque<Job> queue;
+        size_t inflight = 0;
+        StoreDestinationStats stats;
+        int64_t latency_sum_us = 0;
+        std::vector<std::thread> workers;
+    };
+
+    StoreScuConfig config;
+    mutable std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::vector<std::unique_ptr<Destination>> destinations;
+    bool running = false;
+    int64_t start_us = 0;
+    StoreCallback callback;
+    internal::TransmissionJournal journal;
+    std::vector<internal::PresentationContext> contexts;
+
+    explicit Impl(const StoreScuConfig& cfg) : config(cfg) {
+        uint8_t id = 1;
+        for (const char* sop_class : kStorageClasses) {
+            for (const char* syntax : kTransferSyntaxes) {
+                internal::PresentationContext context;
+                context.id = id;
+                context.abstract_syntax = sop_class;
+                context.transfer_syntax = syntax;
+                contexts.push_back(context);
+                id = static_cast<uint8_t>(id + 2);
+            }
+        }
+    }
+
+    Destination* FindDestination(const std::string& name) {
+        for (auto& destination : destinations) {
+            if (destination->config.name == name) {
+                return destination.get();
+            }
+        }
+        return nullptr;
+    }
+
+    /// Pop the first job whose backoff has expired (caller holds mutex)
+    bool TakeReadyJob(Destination& destination, int64_t now_us, Job& job) {
+        for (auto it = destination.queue.begin(); it != destination.queue.end(); ++it) {
+            if (it->not_before_us <= now_us) {
+                job = std::move(*it);
+                destination.queue.erase(it);
+                ++destination.inflight;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Earliest backoff expiry (caller holds mutex)
+    int64_t NextReadyUs(const Destination& destination) const {
+        int64_t next = std::numeric_limits<int64_t>::max();
+        for (const Job& job : destination.queue) {
+            next = std::min(next, job.not_before_us);
+        }
+        return next;
+    }
+
+    /// Put a job back without counting an attempt (never sent)
+    void Requeue(Destination& destination, Job&& job) {
+        std::lock_guard<std::mutex> lock(mutex);
+        --destination.inflight;
+        destination.queue.push_front(std::move(job));
+        work_cv.notify_all();
+    }
+
+    void Finish(Destination& destination, Job& job, DicomResult result) {
+        journal.Complete(job.id);
+
+        StoreJobResult report;
+        report.job_id = job.id;
+        report.destination = destination.config.name;
+        report.path = job.path;
+        report.result = result;
+        report.dimse_status = job.last_status;
+        report.attempts = job.attempts;
+        report.latency_us = infra::MonotonicClock::NowUs() - job.enqueue_us;
+
+        // Callback before the job leaves the in-flight count, so Flush
+        // returns only after every completion has been reported
+        StoreCallback cb;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cb = callback;
+        }
+        if (cb) {
+            cb(report);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        --destination.inflight;
+        StoreDestinationStats& stats = destination.stats;
+        if (result == DicomResult::DICOM_OK) {
+            ++stats.images_sent;
+            stats.bytes_sent += job.bytes;
+            destination.latency_sum_us += report.latency_us;
+            stats.max_latency_us = std::max(stats.max_latency_us, report.latency_us);
+        } else {
+            ++stats.images_failed;
+        }
+        idle_cv.notify_all();
+    }
+
+    /// Failed attempt: reschedule with backoff, or fail once attempts run out
+    void Retry(Destination& destination, Job& job, DicomResult result) {
+        if (job.attempts >= config.max_attempts) {
+            Finish(destination, job, result);
+            return;
+        }
+        journal.RecordAttempt(job.id, job.attempts);
+
+        int64_t backoff_ms = config.initial_backoff_ms;
+        for (uint32_t i = 1; i < job.attempts && backoff_ms < config.max_backoff_ms; ++i) {
+            backoff_ms *= 2;
+        }
+        backoff_ms = std::min(backoff_ms, config.max_backoff_ms);
+        job.not_before_us = infra::MonotonicClock::NowUs() + backoff_ms * 1000;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        --destination.inflight;
+        ++destination.stats.retries;
+        destination.queue.push_back(std::move(job));
+        work_cv.notify_all();
+    }
+
+    void Worker(Destination& destination);
+};
+
+// =============================================================================
+// Association Thread
+// =============================================================================
+
+void DicomStoreScu::Impl::Worker(Destination& destination) {
+    infra::ApplyNamedThreadPolicy(kThreadDicomStore);
+
+    internal::AssociationParams params;
+    params.host = destination.config.host;
+    params.port = destination.config.port;
+    params.connect_timeout_ms = config.connect_timeout_ms;
+    params.request.called_ae = destination.config.called_ae;
+    params.request.calling_ae = destination.config.calling_ae;
+    params.request.contexts = contexts;
+    params.request.max_pdu_bytes = config.max_pdu_bytes;
+    params.request.async_invoked =
+        static_cast<uint16_t>(std::min<uint32_t>(destination.config.async_window, 0xFFFF));
+
+    internal::DicomAssociation association;
+    std::map<uint16_t, Job> outstanding;
+    uint16_t next_message_id = 1;
+
+    auto close_association = [&](bool orderly) {
+        if (!association.IsOpen()) {
+            return;
+        }
+        if (orderly) {
+            association.Release(config.connect_timeout_ms);
+        } else {
+            association.Abort();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        --destination.stats.open_associations;
+    };
+    auto fail_outstanding = [&](DicomResult result) {
+        close_association(false);
+        for (auto& [id, job] : outstanding) {
+            Retry(destination, job, result);
+        }
+        outstanding.clear();
+    };
+
+    for (;;) {
+        std::vector<Job> batch;
+        bool more_ready = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const int64_t now_us = infra::MonotonicClock::NowUs();
+            size_t window = association.IsOpen() ? association.Window()
+                                                 : std::max<uint32_t>(1, destination.config.async_window);
+            Job job;
+            while (running && outstanding.size() + batch.size() < window &&
+                   TakeReadyJob(destination, now_us, job)) {
+                batch.push_back(std::move(job));
+            }
+
+            if (batch.empty() && outstanding.empty()) {
+                if (!running) {
+                    break;
+                }
+                int64_t idle_deadline_us = association.IsOpen()
+                    ? association.LastActivityUs() + config.idle_release_ms * 1000
+                    : std::numeric_limits<int64_t>::max();
+                if (now_us >= idle_deadline_us) {
+                    lock.unlock();
+                    close_association(true);
+                    continue;
+                }
+                int64_t wake_us = std::min({NextReadyUs(destination), idle_deadline_us,
+                                            now_us + kMaxIdleWaitUs});
+                work_cv.wait_for(lock, std::chrono::microseconds(std::max<int64_t>(wake_us - now_us, 1)));
+                continue;
+            }
+            more_ready = running && NextReadyUs(destination) <= now_us;
+        }
+
+        if (!batch.empty() && !association.IsOpen()) {
+            DicomResult result = association.Open(params);
+            if (result != DicomResult::DICOM_OK) {
+                for (Job& job : batch) {
+                    ++job.attempts;
+                    Retry(destination, job, result);
+                }
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ++destination.stats.open_associations;
+            ++destination.stats.associations_opened;
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            Job& job = batch[i];
+            if (!association.IsOpen()) {
+                Requeue(destination, std::move(job));
+                continue;
+            }
+
+            internal::Part10FileInfo info;
+            DicomResult result = internal::ReadPart10Info(job.path, info);
+            uint8_t context = result == DicomResult::DICOM_OK
+                                  ? association.FindContext(info.sop_class_uid,
+                                                            info.transfer_syntax_uid)
+                                  : 0;
+            int fd = result == DicomResult::DICOM_OK ? OpenReadOnly(job.path) : -1;
+            if (result == DicomResult::DICOM_OK && (context == 0 || fd < 0)) {
+                result = context == 0 ? DicomResult::DICOM_ERR_NOT_SUPPORTED
+                                      : DicomResult::DICOM_ERR_IO;
+            }
+            if (result != DicomResult::DICOM_OK) {
+                CloseFd(fd);
+                ++job.attempts;
+                Finish(destination, job, result);   // Not recoverable by retrying
+                continue;
+            }
+
+            uint16_t message_id = next_message_id;
+            next_message_id = static_cast<uint16_t>(next_message_id == 0xFFFF ? 1 : next_message_id + 1);
+            ++job.attempts;
+            job.bytes = info.file_bytes - info.dataset_offset;
+            result = association.SendStore(context, message_id, info, fd);
+            CloseFd(fd);
+            if (result != DicomResult::DICOM_OK) {
+                Retry(destination, job, result);
+                fail_outstanding(result);
+                continue;
+            }
+            outstanding.emplace(message_id, std::move(job));
+        }
+
+        // Keep the window full: while it has room, only wait briefly for a
+        // response before going back for newly queued jobs
+        if (outstanding.empty() ||
+            (running && outstanding.size() < association.Window() &&
+             (more_ready || !association.ResponsePending(kWindowPollMs)))) {
+            continue;
+        }
+        uint16_t message_id = 0;
+        uint16_t status = 0;
+        DicomResult result = association.ReceiveResponse(config.response_timeout_ms, message_id, status);
+        if (result != DicomResult::DICOM_OK) {
+            fail_outstanding(result);
+            continue;
+        }
+        auto it = outstanding.find(message_id);
+        if (it == outstanding.end()) {
+            fail_outstanding(DicomResult::DICOM_ERR_NETWORK);   // Response to nothing we sent
+            continue;
+        }
+        Job job = std::move(it->second);
+        outstanding.erase(it);
+        job.last_status = status;
+        if (IsSuccessStatus(status)) {
+            Finish(destination, job, DicomResult::DICOM_OK);
+        } else if (IsTransientStatus(status)) {
+            Retry(destination, job, DicomResult::DICOM_ERR_REJECTED);
+        } else {
+            Finish(destination, job, DicomResult::DICOM_ERR_REJECTED);
+        }
+    }
+
+    close_association(true);
+}
+
+// =============================================================================
+// DicomStoreScu
+// =============================================================================
+
+DicomStoreScu::DicomStoreScu(const StoreScuConfig& config)
+    : impl_(std::make_unique<Impl>(config)) {
+}
+
+DicomStoreScu::~DicomStoreScu() {
+    Stop();
+}
+
+DicomResult DicomStoreScu::AddDestination(const DicomDestination& destination) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    if (impl_->running) {
+        return DicomResult::DICOM_ERR_NOT_SUPPORTED;
+    }
+    if (destination.name.empty() ||
+        destination.name.find_first_of(" \t\r\n") != std::string::npos ||
+        destination.host.empty() || destination.port == 0 ||
+        !IsValidAeTitle(destination.called_ae) || !IsValidAeTitle(destination.calling_ae) ||
+        destination.max_associations == 0 || destination.async_window == 0 ||
+        impl_->FindDestination(destination.name) != nullptr) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    auto state = std::make_unique<Impl::Destination>();
+    state->config = destination;
+    state->stats.name = destination.name;
+    impl_->destinations.push_back(std::move(state));
+    return DicomResult::DICOM_OK;
+}
+
+DicomResult DicomStoreScu::Start() {
+    if (!internal::DicomSocket::IsSupported()) {
+        return DicomResult::DICOM_ERR_NOT_SUPPORTED;
+    }
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    if (impl_->running) {
+        return DicomResult::DICOM_OK;
+    }
+    if (impl_->config.queue_directory.empty()) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+
+    std::vector<internal::JournalEntry> pending;
+    DicomResult result = impl_->journal.Open(impl_->config.queue_directory, pending);
+    if (result != DicomResult::DICOM_OK) {
+        return result;
+    }
+
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    impl_->start_us = now_us;
+    for (auto& destination : impl_->destinations) {
+        destination->queue.clear();
+        destination->inflight = 0;
+        destination->latency_sum_us = 0;
+        destination->stats = StoreDestinationStats{};
+        destination->stats.name = destination->config.name;
+    }
+    for (internal::JournalEntry& entry : pending) {
+        Impl::Destination* destination = impl_->FindDestination(entry.destination);
+        if (destination == nullptr) {
+            continue;
+        }
+        Impl::Job job;
+        job.id = entry.id;
+        job.path = std::move(entry.path);
+        job.attempts = entry.attempts;
+        job.enqueue_us = now_us;
+        destination->queue.push_back(std::move(job));
+    }
+
+    impl_->running = true;
+    for (auto& destination : impl_->destinations) {
+        Impl::Destination* state = destination.get();
+        for (uint32_t i = 0; i < state->config.max_associations; ++i) {
+            state->workers.emplace_back([this, state]() { impl_->Worker(*state); });
+        }
+    }
+    return DicomResult::DICOM_OK;
+}
+
+void DicomStoreScu::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        if (!impl_->running) {
+            return;
+        }
+        impl_->running = false;
+        impl_->work_cv.notify_all();
+    }
+    for (auto& destination : impl_->destinations) {
+        for (std::thread& worker : destination->workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        destination->workers.clear();
+    }
+    impl_->journal.Close();
+    impl_->idle_cv.notify_all();
+}
+
+bool DicomStoreScu::IsRunning() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->running;
+}
+
+DicomResult DicomStoreScu::Enqueue(const std::string& destination, const std::string& path,
+                                   uint64_t* job_id) {
+    if (path.empty() || path.find('\n') != std::string::npos) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    Impl::Destination* state = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        if (!impl_->running) {
+            return DicomResult::DICOM_ERR_NOT_RUNNING;
+        }
+        state = impl_->FindDestination(destination);
+        if (state == nullptr) {
+            return DicomResult::DICOM_ERR_PARAM;
+        }
+    }
+
+    // Durable before the caller is told the image is queued
+    internal::JournalEntry entry;
+    entry.destination = destination;
+    entry.path = path;
+    DicomResult result = impl_->journal.Append(entry);
+    if (result != DicomResult::DICOM_OK) {
+        return result;
+    }
+
+    Impl::Job job;
+    job.id = entry.id;
+    job.path = path;
+    job.enqueue_us = infra::MonotonicClock::NowUs();
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        state->queue.push_back(std::move(job));
+        impl_->work_cv.notify_all();
+    }
+    if (job_id != nullptr) {
+        *job_id = entry.id;
+    }
+    return DicomResult::DICOM_OK;
+}
+
+bool DicomStoreScu::Flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    return impl_->idle_cv.wait_for(lock, timeout, [this]() {
+        for (const auto& destination : impl_->destinations) {
+            if (!destination->queue.empty() || destination->inflight != 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void DicomStoreScu::SetCallback(StoreCallback callback) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->callback = std::move(callback);
+}
+
+std::vector<StoreDestinationStats> DicomStoreScu::GetStats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    const double elapsed_s =
+        static_cast<double>(infra::MonotonicClock::NowUs() - impl_->start_us) / 1e6;
+    std::vector<StoreDestinationStats> result;
+    for (const auto& destination : impl_->destinations) {
+        StoreDestinationStats stats = destination->stats;
+        stats.pending = destination->queue.size() + destination->inflight;
+        if (stats.images_sent > 0) {
+            stats.avg_latency_us =
+                destination->latency_sum_us / static_cast<int64_t>(stats.images_sent);
+            if (impl_->start_us != 0 && elapsed_s > 0.0) {
+                stats.images_per_s = static_cast<double>(stats.images_sent) / elapsed_s;
+            }
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+} // namespace hnvue::dicom
@@ -0,0 +1,288 @@
+/**
+ * @file DicomUpperLayer.cpp
+ * @brief DICOM upper layer PDUs (PS3.8) and C-STORE command sets (PS3.7)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "DicomUpperLayer.h"
+
+#include "DicomEncoding.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hnvue::dicom::internal {
+
+namespace {
+
+constexpr uint8_t kItemApplicationContext = 0x10;
+constexpr uint8_t kItemPresentationContextRq = 0x20;
+constexpr uint8_t kItemPresentationContextAc = 0x21;
+constexpr uint8_t kItemAbstractSyntax = 0x30;
+constexpr uint8_t kItemTransferSyntax = 0x40;
+constexpr uint8_t kItemUserInformation = 0x50;
+constexpr uint8_t kItemMaxLength = 0x51;
+constexpr uint8_t kItemImplementationClass = 0x52;
+constexpr uint8_t kItemAsyncWindow = 0x53;
+constexpr uint8_t kItemImplementationVersion = 0x55;
+
+constexpr size_t kAeTitleBytes = 16;
+
+void PutBe16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void PutBe32(std::vector<uint8_t>& out, uint32_t value) {
+    PutBe16(out, static_cast<uint16_t>(value >> 16));
+    PutBe16(out, static_cast<uint16_t>(value));
+}
+
+void PatchBe16(std::vector<uint8_t>& out, size_t at, uint16_t value) {
+    out[at] = static_cast<uint8_t>(value >> 8);
+    out[at + 1] = static_cast<uint8_t>(value);
+}
+
+void PatchBe32(std::vector<uint8_t>& out, size_t at, uint32_t value) {
+    PatchBe16(out, at, static_cast<uint16_t>(value >> 16));
+    PatchBe16(out, at + 2, static_cast<uint16_t>(value));
+}
+
+uint16_t GetBe16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t GetBe32(const uint8_t* p) { return (static_cast<uint32_t>(GetBe16(p)) << 16) | GetBe16(p + 2); }
+uint16_t GetLe16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t GetLe32(const uint8_t* p) { return GetLe16(p) | (static_cast<uint32_t>(GetLe16(p + 2)) << 16); }
+
+/// Item with a 16-bit big-endian length
+void PutItem(std::vector<uint8_t>& out, uint8_t type, const std::string& value) {
+    out.push_back(type);
+    out.push_back(0);
+    PutBe16(out, static_cast<uint16_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+void PutAeTitle(std::vector<uint8_t>& out, const std::string& title) {
+    std::string padded = title.substr(0, kAeTitleBytes);
+    padded.resize(kAeTitleBytes, ' ');
+    out.insert(out.end(), padded.begin(), padded.end());
+}
+
+/// Implicit VR Little Endian element of a command set
+void PutCommandElement(std::vector<uint8_t>& out, uint16_t element, const void* value,
+                       size_t length, uint8_t padding) {
+    size_t padded = length + (length & 1);
+    AppendUInt16(out, 0x0000);
+    AppendUInt16(out, element);
+    AppendUInt32(out, static_cast<uint32_t>(padded));
+    const auto* bytes = static_cast<const uint8_t*>(value);
+    out.insert(out.end(), bytes, bytes + length);
+    if (padded != length) {
+        out.push_back(padding);
+    }
+}
+
+void PutCommandUInt16(std::vector<uint8_t>& out, uint16_t element, uint16_t value) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    PutCommandElement(out, element, bytes, 2, 0);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Association Negotiation
+// =============================================================================
+
+void BuildAssociateRq(const AssociateRequest& request, std::vector<uint8_t>& out) {
+    out.clear();
+    out.push_back(static_cast<uint8_t>(PduType::PDU_ASSOCIATE_RQ));
+    out.push_back(0);
+    PutBe32(out, 0);           // Patched below
+    PutBe16(out, 0x0001);      // Protocol version
+    PutBe16(out, 0);
+    PutAeTitle(out, request.called_ae);
+    PutAeTitle(out, request.calling_ae);
+    out.insert(out.end(), 32, 0);
+
+    PutItem(out, kItemApplicationContext, uids::kApplicationContext);
+
+    for (const PresentationContext& context : request.contexts) {
+        size_t start = out.size();
+        out.push_back(kItemPresentationContextRq);
+        out.push_back(0);
+        PutBe16(out, 0);
+        out.push_back(context.id);
+        out.insert(out.end(), 3, 0);
+        PutItem(out, kItemAbstractSyntax, context.abstract_syntax);
+        PutItem(out, kItemTransferSyntax, context.transfer_syntax);
+        PatchBe16(out, start + 2, static_cast<uint16_t>(out.size() - start - 4));
+    }
+
+    size_t user_start = out.size();
+    out.push_back(kItemUserInformation);
+    out.push_back(0);
+    PutBe16(out, 0);
+    out.push_back(kItemMaxLength);
+    out.push_back(0);
+    PutBe16(out, 4);
+    PutBe32(out, request.max_pdu_bytes);
+    PutItem(out, kItemImplementationClass, uids::kImplementationClassUid);
+    out.push_back(kItemAsyncWindow);
+    out.push_back(0);
+    PutBe16(out, 4);
+    PutBe16(out, request.async_invoked);
+    PutBe16(out, 1);           // We perform no operations for the peer
+    PutItem(out, kItemImplementationVersion, "HNVUE_010");
+    PatchBe16(out, user_start + 2, static_cast<uint16_t>(out.size() - user_start - 4));
+
+    PatchBe32(out, 2, static_cast<uint32_t>(out.size() - kPduHeaderBytes));
+}
+
+bool ParseAssociateAc(const uint8_t* body, size_t size, std::vector<PresentationContext>& contexts,
+                      AssociateAccept& accept) {
+    constexpr size_t kFixedBytes = 68;   // Version, reserved, AE titles, reserved
+    if (size < kFixedBytes) {
+        return false;
+    }
+    accept = AssociateAccept{};
+    for (PresentationContext& context : contexts) {
+        context.accepted = false;
+    }
+
+    size_t pos = kFixedBytes;
+    while (pos + 4 <= size) {
+        uint8_t type = body[pos];
+        size_t length = GetBe16(body + pos + 2);
+        const uint8_t* value = body + pos + 4;
+        if (pos + 4 + length > size) {
+            return false;
+        }
+
+        if (type == kItemPresentationContextAc && length >= 4) {
+            uint8_t id = value[0];
+            uint8_t result = value[2];
+            for (PresentationContext& context : contexts) {
+                if (context.id == id) {
+                    context.accepted = result == 0;
+                }
+            }
+        } else if (type == kItemUserInformation) {
+            size_t sub = 0;
+            while (sub + 4 <= length) {
+                uint8_t sub_type = value[sub];
+                size_t sub_length = GetBe16(value + sub + 2);
+                const uint8_t* sub_value = value + sub + 4;
+                if (sub + 4 + sub_length > length) {
+                    return false;
+                }
+                if (sub_type == kItemMaxLength && sub_length == 4) {
+                    accept.peer_max_pdu_bytes = GetBe32(sub_value);
+                } else if (sub_type == kItemAsyncWindow && sub_length == 4) {
+                    accept.async_invoked = GetBe16(sub_value);   // Negotiated window for us (PS3.7 D.3.3.3)
+                }
+                sub += 4 + sub_length;
+            }
+        }
+        pos += 4 + length;
+    }
+    return true;
+}
+
+void BuildReleaseRq(std::vector<uint8_t>& out) {
+    out.assign({static_cast<uint8_t>(PduType::PDU_RELEASE_RQ), 0, 0, 0, 0, 4, 0, 0, 0, 0});
+}
+
+void BuildAbort(std::vector<uint8_t>& out) {
+    out.assign({static_cast<uint8_t>(PduType::PDU_ABORT), 0, 0, 0, 0, 4, 0, 0, 0, 0});
+}
+
+void BuildPDataHeader(uint8_t out[kPduHeaderBytes + kPdvHeaderBytes], uint32_t data_bytes,
+                      uint8_t context_id, uint8_t control) {
+    uint32_t item_length = data_bytes + 2;
+    uint32_t pdu_length = item_length + 4;
+    out[0] = static_cast<uint8_t>(PduType::PDU_P_DATA_TF);
+    out[1] = 0;
+    out[2] = static_cast<uint8_t>(pdu_length >> 24);
+    out[3] = static_cast<uint8_t>(pdu_length >> 16);
+    out[4] = static_cast<uint8_t>(pdu_length >> 8);
+    out[5] = static_cast<uint8_t>(pdu_length);
+    out[6] = static_cast<uint8_t>(item_length >> 24);
+    out[7] = static_cast<uint8_t>(item_length >> 16);
+    out[8] = static_cast<uint8_t>(item_length >> 8);
+    out[9] = static_cast<uint8_t>(item_length);
+    out[10] = context_id;
+    out[11] = control;
+}
+
+DicomResult ReadPdu(DicomSocket& socket, int64_t timeout_ms, uint32_t max_body_bytes,
+                    PduType& type, std::vector<uint8_t>& body) {
+    uint8_t header[kPduHeaderBytes];
+    if (!socket.Receive(header, sizeof(header), timeout_ms)) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+    uint32_t length = GetBe32(header + 2);
+    if (max_body_bytes != 0 && length > max_body_bytes) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+    type = static_cast<PduType>(header[0]);
+    body.resize(length);
+    if (length > 0 && !socket.Receive(body.data(), length, timeout_ms)) {
+        return DicomResult::DICOM_ERR_NETWORK;
+    }
+    return DicomResult::DICOM_OK;
+}
+
+// =============================================================================
+// DIMSE Command Sets
+// =============================================================================
+
+void BuildStoreRq(const std::string& sop_class, const std::string& sop_instance,
+                  uint16_t message_id, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> elements;
+    PutCommandElement(elements, 0x0002, sop_class.data(), sop_class.size(), '\0');
+    PutCommandUInt16(elements, 0x0100, kCommandCStoreRq);
+    PutCommandUInt16(elements, 0x0110, message_id);
+    PutCommandUInt16(elements, 0x0700, 0x0000);   // Priority: medium
+    PutCommandUInt16(elements, 0x0800, 0x0000);   // Data set present
+    PutCommandElement(elements, 0x1000, sop_instance.data(), sop_instance.size(), '\0');
+
+    out.clear();
+    uint32_t group_length = static_cast<uint32_t>(elements.size());
+    uint8_t bytes[4] = {static_cast<uint8_t>(group_length), static_cast<uint8_t>(group_length >> 8),
+                        static_cast<uint8_t>(group_length >> 16),
+                        static_cast<uint8_t>(group_length >> 24)};
+    PutCommandElement(out, 0x0000, bytes, 4, 0);
+    out.insert(out.end(), elements.begin(), elements.end());
+}
+
+bool ParseCommand(const uint8_t* data, size_t size, CommandFields& fields) {
+    fields = CommandFields{};
+    size_t pos = 0;
+    while (pos + 8 <= size) {
+        uint16_t group = GetLe16(data + pos);
+        uint16_t element = GetLe16(data + pos + 2);
+        uint32_t length = GetLe32(data + pos + 4);
+        pos += 8;
+        if (group != 0x0000 || length > size - pos) {
+            return false;
+        }
+        if (length == 2) {
+            uint16_t value = GetLe16(data + pos);
+            switch (element) {
+                case 0x0100: fields.command_field = value; break;
+                case 0x0110: fields.message_id = value; break;
+                case 0x0120: fields.message_id_responded = value; break;
+                case 0x0800: fields.data_set_type = value; break;
+                case 0x0900: fields.status = value; break;
+                default: break;
+            }
+        }
+        pos += length;
+    }
+    return pos == size && fields.command_field != 0;
+}
+
+} // namespace hnvue::dicom::internal
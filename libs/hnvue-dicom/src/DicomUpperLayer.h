@@ -0,0 +1,132 @@
+/**
+ * @file DicomUpperLayer.h
+ * @brief DICOM upper layer PDUs (PS3.8) and C-STORE command sets (PS3.7)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * PDU fields are big-endian; command sets are Implicit VR Little Endian.
+ */
+
+#ifndef HNUE_DICOM_DICOM_UPPER_LAYER_H
+#define HNUE_DICOM_DICOM_UPPER_LAYER_H
+
+#include "DicomSocket.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+// =============================================================================
+// Constants
+// =============================================================================
+
+enum class PduType : uint8_t {
+    PDU_ASSOCIATE_RQ = 0x01,
+    PDU_ASSOCIATE_AC = 0x02,
+    PDU_ASSOCIATE_RJ = 0x03,
+    PDU_P_DATA_TF = 0x04,
+    PDU_RELEASE_RQ = 0x05,
+    PDU_RELEASE_RP = 0x06,
+    PDU_ABORT = 0x07
+};
+
+constexpr size_t kPduHeaderBytes = 6;
+constexpr size_t kPdvHeaderBytes = 6;     ///< Item length (4), context id, control header
+constexpr uint8_t kPdvCommand = 0x01;
+constexpr uint8_t kPdvLast = 0x02;
+
+constexpr uint16_t kCommandCStoreRq = 0x0001;
+constexpr uint16_t kCommandCStoreRsp = 0x8001;
+
+// =============================================================================
+// Association Negotiation
+// =============================================================================
+
+/**
+ * @brief One proposed presentation context (single transfer syntax)
+ */
+struct PresentationContext {
+    uint8_t id = 0;                 ///< Odd, 1..255
+    std::string abstract_syntax;
+    std::string transfer_syntax;
+    bool accepted = false;          ///< Set from the A-ASSOCIATE-AC
+};
+
+/**
+ * @brief A-ASSOCIATE-RQ parameters
+ */
+struct AssociateRequest {
+    std::string called_ae;
+    std::string calling_ae;
+    std::vector<PresentationContext> contexts;
+    uint32_t max_pdu_bytes = 0;     ///< Largest PDU we accept (0 = unlimited)
+    uint16_t async_invoked = 1;     ///< Operations we want outstanding
+};
+
+/**
+ * @brief Negotiated association parameters from the A-ASSOCIATE-AC
+ */
+struct AssociateAccept {
+    uint32_t peer_max_pdu_bytes = 0;   ///< 0 = unlimited
+    uint16_t async_invoked = 1;        ///< Operations we may have outstanding (0 = unlimited)
+};
+
+void BuildAssociateRq(const AssociateRequest& request, std::vector<uint8_t>& out);
+
+/**
+ * @brief Parse an A-ASSOCIATE-AC body (after the 6-byte PDU header)
+ * @param[in,out] contexts Proposed contexts; accepted flags are updated
+ * @return false if malformed
+ */
+bool ParseAssociateAc(const uint8_t* body, size_t size, std::vector<PresentationContext>& contexts,
+                      AssociateAccept& accept);
+
+void BuildReleaseRq(std::vector<uint8_t>& out);
+void BuildAbort(std::vector<uint8_t>& out);
+
+/**
+ * @brief P-DATA-TF PDU header plus a single PDV header
+ * @param data_bytes PDV payload bytes following the header
+ */
+void BuildPDataHeader(uint8_t out[kPduHeaderBytes + kPdvHeaderBytes], uint32_t data_bytes,
+                      uint8_t context_id, uint8_t control);
+
+/**
+ * @brief Read one PDU
+ * @return DICOM_OK, DICOM_ERR_NETWORK (timeout, closed, oversized PDU)
+ */
+DicomResult ReadPdu(DicomSocket& socket, int64_t timeout_ms, uint32_t max_body_bytes,
+                    PduType& type, std::vector<uint8_t>& body);
+
+// =============================================================================
+// DIMSE Command Sets
+// =============================================================================
+
+/**
+ * @brief Encode a C-STORE-RQ command set
+ */
+void BuildStoreRq(const std::string& sop_class, const std::string& sop_instance,
+                  uint16_t message_id, std::vector<uint8_t>& out);
+
+/**
+ * @brief Fields of a received command set
+ */
+struct CommandFields {
+    uint16_t command_field = 0;
+    uint16_t message_id = 0;               ///< (0000,0110)
+    uint16_t message_id_responded = 0;     ///< (0000,0120)
+    uint16_t status = 0;                   ///< (0000,0900)
+    uint16_t data_set_type = 0x0101;       ///< (0000,0800)
+};
+
+bool ParseCommand(const uint8_t* data, size_t size, CommandFields& fields);
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_DICOM_UPPER_LAYER_H
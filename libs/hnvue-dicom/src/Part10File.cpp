@@ -0,0 +1,101 @@
+/**
+ * @file Part10File.cpp
+ * @brief File meta information reader for Part-10 files
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Part10File.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+namespace {
+
+constexpr size_t kPrefixBytes = 132;           // Preamble + "DICM"
+constexpr size_t kGroupLengthBytes = 12;       // (0002,0000) UL element
+constexpr uint32_t kMaxMetaBytes = 64 * 1024;
+
+uint16_t GetLe16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t GetLe32(const uint8_t* p) { return GetLe16(p) | (static_cast<uint32_t>(GetLe16(p + 2)) << 16); }
+
+std::string TrimUid(const uint8_t* data, size_t length) {
+    std::string value(reinterpret_cast<const char*>(data), length);
+    while (!value.empty() && (value.back() == '\0' || value.back() == ' ')) {
+        value.pop_back();
+    }
+    return value;
+}
+
+} // anonymous namespace
+
+DicomResult ReadPart10Info(const std::string& path, Part10FileInfo& info) {
+    info = Part10FileInfo{};
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return DicomResult::DICOM_ERR_IO;
+    }
+
+    DicomResult result = DicomResult::DICOM_ERR_PARAM;
+    uint8_t prefix[kPrefixBytes + kGroupLengthBytes];
+    std::vector<uint8_t> meta;
+    if (std::fread(prefix, 1, sizeof(prefix), file) == sizeof(prefix) &&
+        std::memcmp(prefix + 128, "DICM", 4) == 0 &&
+        GetLe16(prefix + 132) == 0x0002 && GetLe16(prefix + 134) == 0x0000 &&
+        std::memcmp(prefix + 136, "UL", 2) == 0) {
+        uint32_t meta_bytes = GetLe32(prefix + 140);
+        if (meta_bytes <= kMaxMetaBytes) {
+            meta.resize(meta_bytes);
+            if (std::fread(meta.data(), 1, meta.size(), file) == meta.size()) {
+                result = DicomResult::DICOM_OK;
+            }
+        }
+    }
+    if (result == DicomResult::DICOM_OK && std::fseek(file, 0, SEEK_END) == 0) {
+        long end = std::ftell(file);
+        info.file_bytes = end < 0 ? 0 : static_cast<uint64_t>(end);
+    }
+    std::fclose(file);
+    if (result != DicomResult::DICOM_OK) {
+        return result;
+    }
+
+    // Meta elements are always Explicit VR Little Endian
+    size_t pos = 0;
+    while (pos + 8 <= meta.size()) {
+        uint16_t element = GetLe16(&meta[pos + 2]);
+        bool long_length = std::memcmp(&meta[pos + 4], "OB", 2) == 0 ||
+                           std::memcmp(&meta[pos + 4], "UN", 2) == 0;
+        size_t header = long_length ? 12 : 8;
+        if (pos + header > meta.size()) {
+            return DicomResult::DICOM_ERR_PARAM;
+        }
+        uint32_t length = long_length ? GetLe32(&meta[pos + 8]) : GetLe16(&meta[pos + 6]);
+        pos += header;
+        if (length > meta.size() - pos) {
+            return DicomResult::DICOM_ERR_PARAM;
+        }
+        switch (element) {
+            case 0x0002: info.sop_class_uid = TrimUid(&meta[pos], length); break;
+            case 0x0003: info.sop_instance_uid = TrimUid(&meta[pos], length); break;
+            case 0x0010: info.transfer_syntax_uid = TrimUid(&meta[pos], length); break;
+            default: break;
+        }
+        pos += length;
+    }
+
+    info.dataset_offset = kPrefixBytes + kGroupLengthBytes + meta.size();
+    if (info.sop_class_uid.empty() || info.sop_instance_uid.empty() ||
+        info.transfer_syntax_uid.empty() || info.dataset_offset > info.file_bytes) {
+        return DicomResult::DICOM_ERR_PARAM;
+    }
+    return DicomResult::DICOM_OK;
+}
+
+} // namespace hnvue::dicom::internal
@@ -0,0 +1,41 @@
+/**
+ * @file Part10File.h
+ * @brief File meta information reader for Part-10 files
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_DICOM_PART10_FILE_H
+#define HNUE_DICOM_PART10_FILE_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <cstdint>
+#include <string>
+
+namespace hnvue::dicom::internal {
+
+/**
+ * @brief What a C-STORE needs from a Part-10 file
+ */
+struct Part10FileInfo {
+    std::string sop_class_uid;        ///< (0002,0002)
+    std::string sop_instance_uid;     ///< (0002,0003)
+    std::string transfer_syntax_uid;  ///< (0002,0010)
+    uint64_t dataset_offset = 0;      ///< First byte after the meta group
+    uint64_t file_bytes = 0;
+};
+
+/**
+ * @brief Read the preamble and file meta group
+ * @return DICOM_OK, DICOM_ERR_IO (cannot open/read) or DICOM_ERR_PARAM
+ *         (not a Part-10 file or required meta elements missing)
+ */
+DicomResult ReadPart10Info(const std::string& path, Part10FileInfo& info);
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_PART10_FILE_H
@@ -0,0 +1,145 @@
+/**
+ * @file RleLosslessEncoder.cpp
+ * @brief DICOM RLE Lossless encoder for 16-bit grayscale frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "RleLosslessEncoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace hnvue::dicom::internal {
+
+namespace {
+
+constexpr size_t kRleHeaderBytes = 64;
+constexpr uint32_t kSegmentCount = 2;
+constexpr size_t kMaxRun = 128;
+
+/**
+ * @brief Run fn(0..count-1) on up to `threads` threads (caller included)
+ */
+void ParallelFor(size_t count, uint32_t threads, const std::function<void(size_t)>& fn) {
+    size_t workers = std::min<size_t>(threads, count);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto drain = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) {
+        pool.emplace_back(drain);
+    }
+    drain();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief PackBits-encode one row of a byte plane
+ *
+ * Runs of three or more equal bytes become replicate runs; everything else
+ * is emitted as literal runs of up to 128 bytes.
+ */
+void PackBitsRow(const uint8_t* bytes, size_t count, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < count) {
+        size_t run = 1;
+        while (i + run < count && run < kMaxRun && bytes[i + run] == bytes[i]) {
+            ++run;
+        }
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(257 - run));   // -(run - 1)
+            out.push_back(bytes[i]);
+            i += run;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < count && end - i < kMaxRun) {
+            if (end + 2 < count && bytes[end] == bytes[end + 1] && bytes[end] == bytes[end + 2]) {
+                break;
+            }
+            ++end;
+        }
+        out.push_back(static_cast<uint8_t>(end - i - 1));
+        out.insert(out.end(), bytes + i, bytes + end);
+        i = end;
+    }
+}
+
+} // anonymous namespace
+
+void EncodeRleLossless(const uint8_t* pixels, size_t stride_bytes, uint32_t width,
+                       uint32_t height, uint32_t threads, std::vector<uint8_t>& out) {
+    // A few bands per thread balances uneven compressibility across the image
+    size_t band_count = std::min<size_t>(height, static_cast<size_t>(std::max(1u, threads)) * 4);
+    size_t band_rows = (height + band_count - 1) / band_count;
+    band_count = (height + band_rows - 1) / band_rows;
+
+    // Task t codes band (t / 2) of segment (t % 2); segment 0 holds the high bytes
+    std::vector<std::vector<uint8_t>> parts(band_count * kSegmentCount);
+    ParallelFor(parts.size(), threads, [&](size_t task) {
+        size_t band = task / kSegmentCount;
+        size_t byte_offset = (task % kSegmentCount) == 0 ? 1 : 0;
+        size_t first = band * band_rows;
+        size_t last = std::min<size_t>(height, first + band_rows);
+
+        std::vector<uint8_t>& part = parts[task];
+        part.reserve((last - first) * (width + width / kMaxRun + 1));
+        std::vector<uint8_t> plane(width);
+        for (size_t y = first; y < last; ++y) {
+            const uint8_t* row = pixels + y * stride_bytes;
+            for (uint32_t x = 0; x < width; ++x) {
+                plane[x] = row[2 * static_cast<size_t>(x) + byte_offset];
+            }
+            PackBitsRow(plane.data(), width, part);
+        }
+    });
+
+    size_t segment_bytes[kSegmentCount] = {};
+    for (size_t task = 0; task < parts.size(); ++task) {
+        segment_bytes[task % kSegmentCount] += parts[task].size();
+    }
+    for (size_t& bytes : segment_bytes) {
+        bytes += bytes & 1;
+    }
+
+    out.assign(kRleHeaderBytes + segment_bytes[0] + segment_bytes[1], 0);
+    uint32_t header[16] = {};
+    header[0] = kSegmentCount;
+    header[1] = static_cast<uint32_t>(kRleHeaderBytes);
+    header[2] = static_cast<uint32_t>(kRleHeaderBytes + segment_bytes[0]);
+    std::memcpy(out.data(), header, sizeof(header));
+
+    for (uint32_t segment = 0; segment < kSegmentCount; ++segment) {
+        uint8_t* cursor = out.data() + header[1 + segment];
+        for (size_t band = 0; band < band_count; ++band) {
+            const std::vector<uint8_t>& part = parts[band * kSegmentCount + segment];
+            if (!part.empty()) {
+                std::memcpy(cursor, part.data(), part.size());
+                cursor += part.size();
+            }
+        }
+    }
+}
+
+} // namespace hnvue::dicom::internal
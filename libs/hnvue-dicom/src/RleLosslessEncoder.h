@@ -0,0 +1,40 @@
+/**
+ * @file RleLosslessEncoder.h
+ * @brief DICOM RLE Lossless encoder for 16-bit grayscale frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * PS3.5 Annex G: a 16-bit sample is split into two byte segments (most
+ * significant byte first), each PackBits-coded row by row. Because runs
+ * never cross rows, bands of rows are coded independently in parallel and
+ * concatenated.
+ */
+
+#ifndef HNUE_DICOM_RLE_LOSSLESS_ENCODER_H
+#define HNUE_DICOM_RLE_LOSSLESS_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+/**
+ * @brief Encode one frame as an RLE Lossless fragment
+ * @param pixels First row (little-endian 16-bit samples)
+ * @param stride_bytes Row pitch in bytes
+ * @param width Samples per row
+ * @param height Rows
+ * @param threads Encoder threads (>= 1)
+ * @param[out] out Receives the 64-byte RLE header and both segments; each
+ *             segment is padded to even length
+ */
+void EncodeRleLossless(const uint8_t* pixels, size_t stride_bytes, uint32_t width,
+                       uint32_t height, uint32_t threads, std::vector<uint8_t>& out);
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_RLE_LOSSLESS_ENCODER_H
@@ -0,0 +1,171 @@
+/**
+ * @file TransmissionJournal.cpp
+ * @brief Append-only on-disk journal of pending C-STORE jobs
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "TransmissionJournal.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace hnvue::dicom::internal {
+
+namespace {
+
+constexpr const char* kJournalName = "store-queue.journal";
+
+bool SyncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return true;
+#else
+    return fdatasync(fileno(file)) == 0;
+#endif
+}
+
+std::string EnqueueRecord(const JournalEntry& entry) {
+    return "E " + std::to_string(entry.id) + " " + std::to_string(entry.attempts) + " " +
+           entry.destination + " " + entry.path + "\n";
+}
+
+} // anonymous namespace
+
+TransmissionJournal::~TransmissionJournal() {
+    Close();
+}
+
+DicomResult TransmissionJournal::Open(const std::string& directory,
+                                      std::vector<JournalEntry>& pending) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending.clear();
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    fs::path path = fs::path(directory) / kJournalName;
+
+    // Replay
+    std::map<uint64_t, JournalEntry> live;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (in.eof()) {
+            break;   // No trailing newline: torn write
+        }
+        std::istringstream fields(line);
+        char kind = 0;
+        uint64_t id = 0;
+        fields >> kind >> id;
+        if (!fields) {
+            continue;
+        }
+        next_id_ = std::max(next_id_, id + 1);
+        if (kind == 'E') {
+            JournalEntry entry;
+            entry.id = id;
+            fields >> entry.attempts >> entry.destination;
+            fields.get();   // Separator; the path is the rest of the line
+            std::getline(fields, entry.path);
+            if (!entry.destination.empty() && !entry.path.empty()) {
+                live[id] = std::move(entry);
+            }
+        } else if (kind == 'A') {
+            auto it = live.find(id);
+            uint32_t attempts = 0;
+            if (it != live.end() && (fields >> attempts)) {
+                it->second.attempts = attempts;
+            }
+        } else if (kind == 'D') {
+            live.erase(id);
+        }
+    }
+    in.close();
+
+    // Compact: write the live set to a temp file and atomically replace
+    fs::path temp = path;
+    temp += ".tmp";
+    std::FILE* out = std::fopen(temp.string().c_str(), "wb");
+    if (out == nullptr) {
+        return DicomResult::DICOM_ERR_IO;
+    }
+    bool ok = true;
+    for (auto& [id, entry] : live) {
+        std::string record = EnqueueRecord(entry);
+        ok = ok && std::fwrite(record.data(), 1, record.size(), out) == record.size();
+        pending.push_back(entry);
+    }
+    ok = ok && SyncFile(out);
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok) {
+        pending.clear();
+        return DicomResult::DICOM_ERR_IO;
+    }
+    fs::rename(temp, path, ec);
+    if (ec) {
+        pending.clear();
+        return DicomResult::DICOM_ERR_IO;
+    }
+
+    file_ = std::fopen(path.string().c_str(), "ab");
+    if (file_ == nullptr) {
+        pending.clear();
+        return DicomResult::DICOM_ERR_IO;
+    }
+    return DicomResult::DICOM_OK;
+}
+
+void TransmissionJournal::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_ != nullptr) {
+        SyncFile(file_);
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool TransmissionJournal::WriteLine(const std::string& line, bool sync) {
+    if (file_ == nullptr || std::fwrite(line.data(), 1, line.size(), file_) != line.size()) {
+        return false;
+    }
+    return sync ? SyncFile(file_) : std::fflush(file_) == 0;
+}
+
+DicomResult TransmissionJournal::Append(JournalEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry.id = next_id_++;
+    return WriteLine(EnqueueRecord(entry), true) ? DicomResult::DICOM_OK
+                                                 : DicomResult::DICOM_ERR_IO;
+}
+
+DicomResult TransmissionJournal::RecordAttempt(uint64_t id, uint32_t attempts) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return WriteLine("A " + std::to_string(id) + " " + std::to_string(attempts) + "\n", false)
+               ? DicomResult::DICOM_OK
+               : DicomResult::DICOM_ERR_IO;
+}
+
+DicomResult TransmissionJournal::Complete(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return WriteLine("D " + std::to_string(id) + "\n", false) ? DicomResult::DICOM_OK
+                                                               : DicomResult::DICOM_ERR_IO;
+}
+
+} // namespace hnvue::dicom::internal
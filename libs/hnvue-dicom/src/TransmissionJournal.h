@@ -0,0 +1,84 @@
+/**
+ * @file TransmissionJournal.h
+ * @brief Append-only on-disk journal of pending C-STORE jobs
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * Text records, one per line:
+ *   E <id> <attempts> <destination> <path>   job enqueued (synced)
+ *   A <id> <attempts>                        attempt failed, rescheduled
+ *   D <id>                                   job finished (sent or failed)
+ * Open replays the file, keeps jobs without a D record and rewrites the
+ * journal with only those (temp file + rename). A torn last line is ignored.
+ */
+
+#ifndef HNUE_DICOM_TRANSMISSION_JOURNAL_H
+#define HNUE_DICOM_TRANSMISSION_JOURNAL_H
+
+#include "hnvue/dicom/DicomTypes.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hnvue::dicom::internal {
+
+/**
+ * @brief One pending job
+ */
+struct JournalEntry {
+    uint64_t id = 0;
+    uint32_t attempts = 0;
+    std::string destination;
+    std::string path;
+};
+
+/**
+ * @brief Crash-safe job journal
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class TransmissionJournal {
+public:
+    TransmissionJournal() = default;
+    ~TransmissionJournal();
+
+    TransmissionJournal(const TransmissionJournal&) = delete;
+    TransmissionJournal& operator=(const TransmissionJournal&) = delete;
+
+    /**
+     * @brief Replay and compact the journal in directory
+     * @param[out] pending Jobs without a completion record, in enqueue order
+     * @return DICOM_OK or DICOM_ERR_IO
+     */
+    DicomResult Open(const std::string& directory, std::vector<JournalEntry>& pending);
+
+    void Close();
+
+    /**
+     * @brief Record a new job; assigns entry.id and syncs before returning
+     */
+    DicomResult Append(JournalEntry& entry);
+
+    /// Record a failed attempt (not synced; a lost record only costs a retry)
+    DicomResult RecordAttempt(uint64_t id, uint32_t attempts);
+
+    /// Record job completion (not synced; a lost record re-sends the image)
+    DicomResult Complete(uint64_t id);
+
+private:
+    bool WriteLine(const std::string& line, bool sync);
+
+    std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    uint64_t next_id_ = 1;
+};
+
+} // namespace hnvue::dicom::internal
+
+#endif // HNUE_DICOM_TRANSMISSION_JOURNAL_H
@@ -0,0 +1,111 @@
+/**
+ * @file bench_aec_abort_latency.cpp
+ * @brief Termination signal to generator abort latency (AecAbortLine)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ *
+ * Each iteration starts a simulated exposure, raises the termination signal
+ * and measures until GeneratorSimulator::FastAbortExposure has returned on
+ * the abort line's handler thread. Reported time is that signal-to-abort
+ * latency; p50/p99/max are reported as counters (ns).
+ *
+ * Spin figures are only meaningful with the handler thread on an isolated
+ * CPU (hal.aec thread policy); on a loaded or single-CPU host the spinning
+ * handler competes with the signalling thread.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "aec/AecAbortLine.h"
+#include "hnvue/hal/generator/GeneratorSimulator.h"
+
+using namespace hnvue::hal;
+
+namespace {
+
+int64_t Percentile(std::vector<int64_t>& samples, double fraction) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void BM_AecAbortLatency(benchmark::State& state) {
+    spdlog::set_level(spdlog::level::warn);
+
+    SimulatorConfig sim_config;
+    sim_config.response_latency = std::chrono::microseconds(0);
+    GeneratorSimulator generator(sim_config);
+
+    AecAbortLineConfig line_config;
+    line_config.spin_while_armed = state.range(0) != 0;
+    AecAbortLine line(line_config);
+    line.SetHandler(&GeneratorSimulator::AecAbortHandler, &generator);
+    if (!line.Start()) {
+        state.SkipWithError("abort line failed to start");
+        return;
+    }
+
+    ExposureParams params;
+    params.kvp = 80.0f;
+    params.ma = 100.0f;
+    params.ms = 5000.0f;
+
+    AecTerminationEvent event;
+    event.threshold_reached = true;
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(static_cast<size_t>(state.max_iterations));
+
+    for (auto _ : state) {
+        // Exposure setup is not part of the measured path
+        generator.SetExposureParams(params);
+        while (!line.Arm()) {
+            std::this_thread::yield();
+        }
+        if (!generator.StartExposure().success) {
+            state.SkipWithError("exposure did not start");
+            break;
+        }
+        const uint64_t aborts = line.GetStats().aborts;
+
+        line.Signal(event);
+        while (line.GetStats().aborts == aborts) {
+            std::this_thread::yield();   // Latency is timed by the handler thread
+        }
+
+        const int64_t latency_ns = line.GetStats().last_latency_ns;
+        latencies.push_back(latency_ns);
+        state.SetIterationTime(static_cast<double>(latency_ns) / 1e9);
+    }
+
+    line.Stop();
+    state.counters["p50_ns"] = static_cast<double>(Percentile(latencies, 0.50));
+    state.counters["p99_ns"] = static_cast<double>(Percentile(latencies, 0.99));
+    state.counters["max_ns"] = static_cast<double>(line.GetStats().max_latency_ns);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_AecAbortLatency)
+    ->ArgName("spin")
+    ->Arg(1)
+    ->Arg(0)
+    ->Iterations(2000)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
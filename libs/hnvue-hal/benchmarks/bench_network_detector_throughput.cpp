@@ -0,0 +1,95 @@
+/**
+ * @file bench_network_detector_throughput.cpp
+ * @brief Sustained frame throughput of NetworkDetector against a local stand-in
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ *
+ * Each iteration streams a fixed number of 3000 x 3000 x 16-bit frames
+ * (9 MP, 18 MB) from the stand-in detector on localhost and waits until the
+ * acquisition completes. The first argument is the paced frame rate
+ * (0 = as fast as the stand-in can send): at 10 fps the question is
+ * whether every frame is delivered, unpaced it is the adapter's ceiling.
+ * MB/s and the reject/overwrite counters are reported per run.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include "detector/NetworkDetector.h"
+#include "mock/GrpcDetectorStandIn.h"
+
+using namespace hnvue::hal;
+
+namespace {
+
+constexpr int32_t kWidth = 3000;
+constexpr int32_t kHeight = 3000;
+constexpr int32_t kBitDepth = 16;
+constexpr int32_t kFramesPerRun = 30;
+
+void BM_NetworkDetectorThroughput(benchmark::State& state) {
+    spdlog::set_level(spdlog::level::warn);
+
+    test::GrpcDetectorStandIn stand_in(kWidth, kHeight, kBitDepth);
+    if (!stand_in.Start()) {
+        state.SkipWithError("stand-in detector failed to start");
+        return;
+    }
+
+    NetworkDetectorConfig config;
+    config.endpoint = stand_in.Endpoint();
+    NetworkDetector detector(config);
+    if (!detector.Connect()) {
+        state.SkipWithError("connect failed");
+        return;
+    }
+    detector.RegisterFrameCallback([](const RawFrame& frame) {
+        benchmark::DoNotOptimize(frame.pixel_data.data());
+    });
+
+    AcquisitionConfig acquisition;
+    acquisition.mode = AcquisitionMode::MODE_CONTINUOUS;
+    acquisition.num_frames = kFramesPerRun;
+    acquisition.frame_rate = static_cast<float>(state.range(0));
+    acquisition.session_id = "bench";
+
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        if (!detector.StartAcquisition(acquisition)) {
+            state.SkipWithError("start failed");
+            return;
+        }
+        while (detector.GetStatus().is_acquiring) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        state.SetIterationTime(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        detector.StopAcquisition();
+    }
+
+    NetworkDetectorStats stats = detector.GetStats();
+    state.SetBytesProcessed(static_cast<int64_t>(stats.bytes_received));
+    state.SetItemsProcessed(static_cast<int64_t>(stats.frames_received));
+    state.counters["delivered"] = static_cast<double>(stats.frames_delivered);
+    state.counters["rejected"] = static_cast<double>(stats.frames_rejected);
+    state.counters["overwritten"] = static_cast<double>(stats.frames_overwritten);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_NetworkDetectorThroughput)
+    ->ArgName("fps")
+    ->Arg(10)
+    ->Arg(0)
+    ->Iterations(3)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -18,6 +18,10 @@
 #include <functional>
 #include <memory>
 
+namespace hnvue::infra {
+class FramePool;
+} // namespace hnvue::infra
+
 namespace hnvue::hal {
 
 // =============================================================================
@@ -95,7 +99,8 @@ public:
     /**
      * @brief Construct DMA ring buffer with specified parameters
      *
-     * Pre-allocates buffer memory of size (depth * frame_size) bytes.
+     * Pre-allocates buffer memory of size (depth * GetSlotStride()) bytes
+     * from infra::FramePool::Default().
      * No heap allocation occurs during operation after construction.
      *
      * @param depth Number of frames the buffer can hold (must be > 0)
@@ -106,6 +111,23 @@ public:
      */
     DmaRingBuffer(size_t depth, size_t frame_size, OverwritePolicy policy);
 
+    /**
+     * @brief Construct DMA ring buffer with storage from a specific frame pool
+     *
+     * Slot storage is one block of depth * GetSlotStride() bytes acquired
+     * from pool and returned to it on destruction. Use a page-aligned pool
+     * when slots are DMA or O_DIRECT targets.
+     *
+     * @param depth Number of frames the buffer can hold (must be > 0)
+     * @param frame_size Size of each frame in bytes (must be > 0)
+     * @param policy Overwrite policy when buffer is full
+     * @param pool Frame pool providing slot storage (must outlive the buffer)
+     * @throws std::invalid_argument if depth or frame_size is 0
+     * @throws std::bad_alloc if buffer allocation fails
+     */
+    DmaRingBuffer(size_t depth, size_t frame_size, OverwritePolicy policy,
+                  infra::FramePool& pool);
+
     /**
      * @brief Destructor - releases buffer memory
      */
@@ -148,6 +170,39 @@ public:
      */
     bool WriteFrame(const void* data, size_t size, uint64_t& sequence_out);
 
+    /**
+     * @brief Reserve the next slot for in-place writing (producer thread)
+     *
+     * Lets a producer decode or receive frame data directly into ring
+     * memory instead of staging it and copying with WriteFrame(). The slot
+     * is invisible to the consumer until CommitWrite().
+     *
+     * - DROP_OLDEST: if the buffer is full, the oldest frame is dropped now
+     * - BLOCK_PRODUCER: blocks until a slot is free
+     *
+     * @return Slot of GetFrameSize() bytes (GetSlotStride() usable), or
+     *         nullptr if a reserved slot is already open
+     */
+    uint8_t* BeginWrite();
+
+    /**
+     * @brief Publish the slot reserved by BeginWrite()
+     *
+     * Assigns the sequence number and invokes the registered callback,
+     * exactly as WriteFrame() does.
+     *
+     * @param sequence_out Output parameter receiving assigned sequence number
+     * @return false if no slot is reserved
+     */
+    bool CommitWrite(uint64_t& sequence_out);
+
+    /**
+     * @brief Release the slot reserved by BeginWrite() without publishing it
+     *
+     * A frame dropped by BeginWrite() under DROP_OLDEST stays dropped.
+     */
+    void CancelWrite();
+
     // ------------------------------------------------------------------------
     // Consumer Interface (Callback Thread)
     // ------------------------------------------------------------------------
@@ -158,22 +213,23 @@ public:
      * Reads the oldest available frame from the buffer.
      * Non-blocking operation - returns false immediately if buffer empty.
      *
-     * Caller must provide buffer of sufficient size (frame_size bytes).
-     * Frame data is copied from ring buffer to caller's buffer.
+     * Frame data is copied from ring buffer to caller's buffer. A buffer
+     * smaller than frame_size is rejected and the frame stays queued.
      *
      * Thread Safety: Safe to call from single consumer thread concurrently
      * with producer WriteFrame calls.
      *
-     * @param buffer_out Pointer to output buffer (must be valid for frame_size bytes)
+     * @param buffer_out Pointer to output buffer (valid for buffer_size bytes)
+     * @param buffer_size Capacity of buffer_out in bytes
      * @param size_out Output parameter receiving actual frame size (always frame_size)
      * @param sequence_out Output parameter receiving frame sequence number
-     * @return true if frame read successfully, false if buffer empty
+     * @return true if frame read successfully, false if buffer empty or
+     *         buffer_size < frame_size
      *
-     * @pre buffer_out must point to valid memory of at least frame_size bytes
      * @post On success, buffer_out contains frame data, size_out == frame_size
      * @post On success, sequence_out contains frame's sequence number
      */
-    bool ReadFrame(void* buffer_out, size_t& size_out, uint64_t& sequence_out);
+    bool ReadFrame(void* buffer_out, size_t buffer_size, size_t& size_out, uint64_t& sequence_out);
 
     // ------------------------------------------------------------------------
     // State Query
@@ -244,6 +300,15 @@ public:
      */
     size_t GetFrameSize() const;
 
+    /**
+     * @brief Get distance in bytes between consecutive slots
+     *
+     * frame_size rounded up to a cache line; every slot is 64-byte aligned.
+     *
+     * @return Slot stride in bytes
+     */
+    size_t GetSlotStride() const;
+
     /**
      * @brief Get current overwrite policy
      *
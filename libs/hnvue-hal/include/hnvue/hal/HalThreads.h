@@ -0,0 +1,101 @@
+/**
+ * @file HalThreads.h
+ * @brief Named HAL thread roles and real-time policy configuration
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Exposure-path thread scheduling
+ * SPDX-License-Identifier: MIT
+ *
+ * Every HAL-owned thread calls infra::ApplyNamedThreadPolicy() with one of
+ * the role names below when it starts. ConfigureHalThreadPolicies() maps a
+ * deployment RealtimeConfig onto those roles, ranking them so that exposure
+ * termination always preempts frame ingestion, which in turn preempts
+ * status polling.
+ */
+
+#ifndef HNUE_HAL_HAL_THREADS_H
+#define HNUE_HAL_HAL_THREADS_H
+
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::hal {
+
+// =============================================================================
+// Thread Role Names
+// =============================================================================
+
+/// AEC termination / exposure abort path (highest priority)
+constexpr const char* kThreadAec = "hal.aec";
+
+/// Generator exposure timing thread
+constexpr const char* kThreadGeneratorExposure = "hal.gen.expose";
+
+/// Generator serial link I/O (commands, aborts, status frames)
+constexpr const char* kThreadGeneratorIo = "hal.gen.io";
+
+/// Detector frame ingestion (DMA ring producer)
+constexpr const char* kThreadDetectorIngest = "hal.det.ingest";
+
+/// Detector plugin host supervision (crash detection and restart)
+constexpr const char* kThreadDetectorHostMonitor = "hal.det.host";
+
+/// Generator status polling / callback dispatch
+constexpr const char* kThreadGeneratorStatus = "hal.gen.status";
+
+/// Dose monitor sampling
+constexpr const char* kThreadDoseSampler = "hal.dose";
+
+/// Dose rate integration and per-exposure totals publication
+constexpr const char* kThreadDoseIntegrator = "hal.dose.integ";
+
+/// Plugin staging and draining during hot reload; never given a real-time
+/// policy, so vendor initialisation cannot compete with acquisition
+constexpr const char* kThreadPluginStaging = "hal.plug.stage";
+
+// =============================================================================
+// Real-time Configuration
+// =============================================================================
+
+/// Priority offset of detector ingestion below the exposure path
+constexpr int32_t kIngestPriorityOffset = 10;
+
+/// Priority offset of status/dose polling below the exposure path
+constexpr int32_t kStatusPriorityOffset = 20;
+
+/**
+ * @brief Deployment real-time settings (DeviceManager "realtime" section)
+ */
+struct RealtimeConfig {
+    bool lock_memory = false;          ///< mlockall() at startup
+    int32_t rt_priority = 0;           ///< Exposure-path priority (0 = disabled)
+    std::vector<int32_t> rt_cpus;      ///< CPUs for RT threads; empty = isolated CPUs, if any
+    size_t stack_prefault_bytes = 64 * 1024; ///< Stack pre-fault per RT thread
+};
+
+/**
+ * @brief Register thread policies for all HAL roles and optionally lock memory
+ * @param config Real-time settings
+ * @return true if every requested setting was applied; false if any step
+ *         was refused (threads still run at default priority)
+ *
+ * Roles are ranked relative to config.rt_priority:
+ * - kThreadAec, kThreadGeneratorExposure, kThreadGeneratorIo: rt_priority (SCHED_FIFO)
+ * - kThreadDetectorIngest: rt_priority - kIngestPriorityOffset (SCHED_FIFO)
+ * - kThreadGeneratorStatus, kThreadDoseSampler, kThreadDoseIntegrator,
+ *   kThreadDetectorHostMonitor: rt_priority - kStatusPriorityOffset (SCHED_RR)
+ * - kThreadPluginStaging: not registered (OS default)
+ * Priorities are clamped to infra::kMinRealtimePriority.
+ *
+ * Policies take effect when each thread next starts; call before
+ * constructing devices.
+ */
+bool ConfigureHalThreadPolicies(const RealtimeConfig& config);
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_HAL_THREADS_H
@@ -11,6 +11,8 @@
 #ifndef HNUE_HAL_HAL_TYPES_H
 #define HNUE_HAL_HAL_TYPES_H
 
+#include "hnvue/infra/FramePool.h"
+
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -50,7 +52,8 @@ enum class HalError : int32_t {
 enum class AecMode : int32_t {
     AEC_MODE_UNSPECIFIED = 0,
     AEC_MANUAL = 1,
-    AEC_AUTO = 2
+    AEC_AUTO = 2,
+    AEC_DETECTOR = 3   ///< Termination from detector partial-readout ROI signal
 };
 
 /**
@@ -117,7 +120,7 @@ struct HvgStatus {
     float actual_ma = 0.0f;
     GeneratorState state = GeneratorState::GEN_STATE_UNSPECIFIED;
     bool interlock_ok = false;
-    int64_t timestamp_us = 0;  ///< microseconds since epoch
+    int64_t timestamp_us = 0;  ///< microseconds since process epoch (infra::MonotonicClock)
 };
 
 /**
@@ -127,7 +130,7 @@ struct HvgAlarm {
     int32_t alarm_code = 0;
     std::string description;
     AlarmSeverity severity = AlarmSeverity::ALARM_SEVERITY_UNSPECIFIED;
-    int64_t timestamp_us = 0;
+    int64_t timestamp_us = 0;  ///< microseconds since process epoch (infra::MonotonicClock)
 };
 
 /**
@@ -184,14 +187,17 @@ struct AcquisitionConfig {
 
 /**
  * @brief Raw detector frame data
+ *
+ * pixel_data draws from infra::FramePool::Default(): buffers are 64-byte
+ * aligned and released frames are reused by the next frame of the same size.
  */
 struct RawFrame {
     int64_t sequence_number = 0;
-    int64_t timestamp_us = 0;
+    int64_t timestamp_us = 0;  ///< microseconds since process epoch (infra::MonotonicClock)
     int32_t width = 0;
     int32_t height = 0;
     int32_t bit_depth = 0;
-    std::vector<uint8_t> pixel_data;  ///< row-major, native byte order
+    infra::PooledVector<uint8_t> pixel_data;  ///< row-major, native byte order
     std::string session_id;
 };
 
@@ -277,7 +283,7 @@ struct DoseReading {
     float dose_mgy = 0.0f;        ///< Accumulated dose in mGy
     float dose_rate_mgy_s = 0.0f; ///< Dose rate in mGy/s
     float dap_ugy_cm2 = 0.0f;     ///< Dose Area Product in uGy*cm^2
-    int64_t timestamp_us = 0;
+    int64_t timestamp_us = 0;  ///< microseconds since process epoch (infra::MonotonicClock)
 };
 
 // =============================================================================
@@ -314,7 +320,7 @@ struct InterlockStatus {
 
     // Aggregate convenience
     bool all_passed = false;           ///< true only if all above are true
-    uint64_t timestamp_us = 0;         ///< Timestamp of interlock check (microseconds)
+    uint64_t timestamp_us = 0;         ///< Timestamp of interlock check (microseconds since process epoch)
 };
 
 // =============================================================================
@@ -46,11 +46,12 @@ public:
 
     /**
      * @brief Set AEC operating mode
-     * @param mode AEC_MANUAL or AEC_AUTO
+     * @param mode AEC_MANUAL, AEC_AUTO or AEC_DETECTOR
      * @return true if mode change successful
      *
      * AEC_MANUAL: Exposure uses fixed time parameter (ms)
      * AEC_AUTO: Exposure terminates when AEC threshold is reached
+     * AEC_DETECTOR: As AEC_AUTO, threshold evaluated on detector partial readouts
      *
      * Mode change is not permitted during active exposure.
      *
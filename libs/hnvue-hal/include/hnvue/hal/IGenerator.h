@@ -27,7 +27,7 @@ namespace hnvue::hal {
  *
  * This interface mirrors the HvgControl protobuf service semantics
  * for in-process use. Implementations include:
- * - GeneratorRS232Impl: Serial communication
+ * - GeneratorSerial: Serial communication (RS-232)
  * - GeneratorEthernetImpl: TCP/IP communication
  * - GeneratorSimulator: Development/testing simulator
  *
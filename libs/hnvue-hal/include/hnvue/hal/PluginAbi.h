@@ -21,6 +21,10 @@
 
 #include <cstdint>
 
+namespace hnvue::hal {
+class IDetector;  // Forward declaration (actual definition in IDetector.h)
+} // namespace hnvue::hal
+
 // All plugin ABI functions use C linkage to ensure binary compatibility
 extern "C" {
 
@@ -76,8 +80,7 @@ extern "C" {
  * - Caller does NOT own the returned pointer
  * - Plugin must destroy the instance when DestroyDetector() is called
  */
-struct IDetector;  // Forward declaration (actual definition in IDetector.h)
-using CreateDetectorFn = IDetector*(*)(const PluginConfig* config);
+using CreateDetectorFn = hnvue::hal::IDetector*(*)(const hnvue::hal::PluginConfig* config);
 
 /**
  * @brief Destroy detector plugin instance
@@ -95,7 +98,7 @@ using CreateDetectorFn = IDetector*(*)(const PluginConfig* config);
  * - Plugin must release all resources associated with the detector
  * - Caller must not use the detector pointer after this call
  */
-using DestroyDetectorFn = void(*)(IDetector* detector);
+using DestroyDetectorFn = void(*)(hnvue::hal::IDetector* detector);
 
 /**
  * @brief Get plugin manifest
@@ -112,7 +115,7 @@ using DestroyDetectorFn = void(*)(IDetector* detector);
  * Memory Management:
  * - Returns pointer to static storage (do not free)
  */
-using GetPluginManifestFn = const PluginManifest*(*)();
+using GetPluginManifestFn = const hnvue::hal::PluginManifest*(*)();
 
 // =============================================================================
 // Optional Error Reporting
@@ -41,7 +41,7 @@ struct HvgCommand {
     CommandType type;
     std::function<HvgResponse()> execute;  // Command execution handler
     uint32_t retry_count = 0;              // Current retry count
-    int64_t timestamp_us = 0;              // Command creation timestamp
+    int64_t timestamp_us = 0;              // Command creation timestamp (infra::SinceStartUs)
 
     // Priority: abort commands have highest priority
     int priority() const {
@@ -125,6 +125,20 @@ public:
      */
     bool IsExposing() const { return state_.load() == GeneratorState::GEN_EXPOSING; }
 
+    /**
+     * @brief Abort from the AEC fast path (lock-free, no logging)
+     * @return true if an armed or running exposure was stopped
+     *
+     * Only the generator state changes here; status callbacks and logging
+     * follow on the exposure thread.
+     */
+    bool FastAbortExposure() noexcept;
+
+    /**
+     * @brief AecAbortLine handler; context is the GeneratorSimulator
+     */
+    static void AecAbortHandler(void* context, const AecTerminationEvent& event);
+
 private:
     // =========================================================================
     // Internal Methods
@@ -145,8 +159,11 @@ private:
     /**
      * @brief Simulate exposure process
      * @param duration_ms Exposure duration in milliseconds
+     * @param sequence Exposure sequence number (exposure_seq_ at start)
+     *
+     * Ends early when the exposure is aborted.
      */
-    void SimulateExposure(int32_t duration_ms);
+    void SimulateExposure(int32_t duration_ms, uint64_t sequence);
 
     /**
      * @brief Notify all registered status callbacks
@@ -188,6 +205,13 @@ private:
 
     // Parameters flag
     std::atomic<bool> params_set_;
+
+    // Exposure threads (guarded by state_mutex_); the destructor waits for them
+    uint64_t exposure_seq_ = 0;
+    uint32_t active_exposures_ = 0;
+
+    // Set by FastAbortExposure; the exposure thread publishes the status
+    std::atomic<bool> fast_aborted_{false};
 };
 
 } // namespace hnvue::hal
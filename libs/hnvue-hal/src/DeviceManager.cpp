@@ -9,10 +9,14 @@
  */
 
 #include "hnvue/hal/DeviceManager.h"
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
 
 #include "hnvue/hal/aec/AecController.h"
 #include "hnvue/hal/generator/GeneratorSimulator.h"
-#include "hnvue/hal/plugin/DetectorPluginLoader.h"
+#include "generator/GeneratorSerial.h"
+#include "plugin/DetectorPluginLoader.h"
+#include "plugin/HotSwapDetector.h"
 
 #include <fstream>
 #include <regex>
@@ -73,6 +77,18 @@ IDetector* DeviceManager::GetDetector() {
     return detector_.get();
 }
 
+bool DeviceManager::ReloadDetector(const std::string& plugin_path) {
+    if (!detector_) {
+        ReportError(HalError::HAL_ERR_STATE, "No detector plugin loaded");
+        return false;
+    }
+    if (!detector_->StageReload(plugin_path)) {
+        ReportError(HalError::HAL_ERR_STATE, "Detector reload already in progress");
+        return false;
+    }
+    return true;
+}
+
 ICollimator* DeviceManager::GetCollimator() {
     return collimator_.get();
 }
@@ -121,6 +137,7 @@ void DeviceManager::Shutdown() {
 
     // 2. Detector
     detector_.reset();
+    detector_loader_.reset();
 
     // 1. Generator (first initialized)
     generator_.reset();
@@ -166,6 +183,21 @@ bool DeviceManager::LoadConfiguration(const std::string& config_path) {
     // This is a minimal implementation for the GREEN phase
 
     try {
+        // Calibrate the timestamp clock before any device thread stamps data
+        infra::MonotonicClock::Initialize();
+
+        // Real-time thread policies must be registered before any device
+        // starts its threads (optional section, disabled by default)
+        RealtimeConfig realtime;
+        realtime.lock_memory = ExtractJsonBool(content, "\"lock_memory\"", false);
+        realtime.rt_priority = ExtractJsonInt(content, "\"rt_priority\"", 0);
+        realtime.rt_cpus = infra::ParseCpuList(ExtractJsonString(content, "\"rt_cpus\"", ""));
+        if (!ConfigureHalThreadPolicies(realtime)) {
+            // Not fatal: devices run at default priority
+            ReportError(HalError::HAL_ERR_NOT_SUPPORTED,
+                        "Real-time thread policy not fully applied");
+        }
+
         // Initialize generator (required)
         std::string gen_type = ExtractJsonString(content, "\"type\"", "simulator");
         std::string gen_port = ExtractJsonString(content, "\"port\"", "COM1");
@@ -177,7 +209,12 @@ bool DeviceManager::LoadConfiguration(const std::string& config_path) {
 
         // Initialize AEC (required)
         std::string aec_mode_str = ExtractJsonString(content, "\"mode\"", "AEC_MANUAL");
-        AecMode aec_mode = (aec_mode_str == "AEC_AUTO") ? AecMode::AEC_AUTO : AecMode::AEC_MANUAL;
+        AecMode aec_mode = AecMode::AEC_MANUAL;
+        if (aec_mode_str == "AEC_AUTO") {
+            aec_mode = AecMode::AEC_AUTO;
+        } else if (aec_mode_str == "AEC_DETECTOR") {
+            aec_mode = AecMode::AEC_DETECTOR;
+        }
         float aec_threshold = ExtractJsonFloat(content, "\"threshold_percent\"", 50.0f);
 
         if (!InitializeAEC(aec_mode, aec_threshold)) {
@@ -208,7 +245,20 @@ bool DeviceManager::InitializeGenerator(const std::string& type, const std::stri
         return true;
     }
 
-    // Other generator types (RS232, Ethernet) would be implemented here
+    if (type == "serial" || type == "rs232") {
+        SerialGeneratorConfig config;
+        config.serial.port = port;
+        config.serial.baud_rate = baud_rate;
+        auto generator = std::make_unique<GeneratorSerial>(config);
+        if (!generator->Open()) {
+            ReportError(HalError::HAL_ERR_COMM, "Cannot connect to generator on " + port);
+            return false;
+        }
+        generator_ = std::move(generator);
+        return true;
+    }
+
+    // Other generator types (Ethernet) would be implemented here
     ReportError(HalError::HAL_ERR_NOT_SUPPORTED, "Unknown generator type: " + type);
     return false;
 }
@@ -219,8 +269,17 @@ bool DeviceManager::InitializeDetector(const std::string& plugin_path, bool enab
     }
 
     // FR-HAL-01: Load detector plugin
-    // This would use DetectorPluginLoader in production
-    // For GREEN phase, we skip plugin loading
+    detector_loader_ = std::make_unique<DetectorPluginLoader>();
+    std::shared_ptr<PluginHandle> plugin = detector_loader_->LoadPlugin(plugin_path);
+    if (!plugin || !plugin->GetDetector()) {
+        ReportError(HalError::HAL_ERR_PLUGIN,
+                    "Cannot load detector plugin " + plugin_path + ": " +
+                    detector_loader_->GetLastError().message);
+        return false;
+    }
+
+    // Served through HotSwapDetector so the plugin can be reloaded in place
+    detector_ = std::make_unique<HotSwapDetector>(*detector_loader_, std::move(plugin));
     return true;
 }
 
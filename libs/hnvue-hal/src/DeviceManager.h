@@ -39,6 +39,9 @@ namespace hnvue::hal {
  */
 using ErrorHandler = std::function<void(HalError, const std::string&)>;
 
+class DetectorPluginLoader;
+class HotSwapDetector;
+
 /**
  * @brief Device lifecycle manager
  *
@@ -98,9 +101,17 @@ public:
      *   "aec": {
      *     "mode": "AEC_AUTO",
      *     "threshold_percent": 50.0
+     *   },
+     *   "realtime": {
+     *     "lock_memory": true,
+     *     "rt_priority": 80,
+     *     "rt_cpus": "2-3"
      *   }
      * }
      *
+     * The optional "realtime" section is applied first (see
+     * ConfigureHalThreadPolicies()); rt_priority 0 keeps default scheduling.
+     *
      * Initialization order (dependency-respecting):
      * 1. Generator (base device)
      * 2. Detector plugin (if enabled)
@@ -131,9 +142,23 @@ public:
     /**
      * @brief Get detector interface
      * @return IDetector pointer or nullptr if not loaded
+     *
+     * The pointer stays valid across ReloadDetector().
      */
     IDetector* GetDetector();
 
+    /**
+     * @brief Reload the detector plugin without taking the detector offline
+     * @param plugin_path Plugin file (may be the loaded path, replaced on disk)
+     * @return true if the reload was started
+     *
+     * The new plugin is loaded and initialised in the background while the
+     * current instance keeps serving; the instance behind GetDetector() is
+     * switched between acquisitions (see HotSwapDetector). Fails if no
+     * detector is loaded or a reload is already in progress.
+     */
+    bool ReloadDetector(const std::string& plugin_path);
+
     /**
      * @brief Get collimator interface
      * @return ICollimator pointer or nullptr if not initialized
@@ -196,7 +221,8 @@ public:
 private:
     // Device instances (owned pointers)
     std::unique_ptr<IGenerator> generator_;
-    std::unique_ptr<IDetector> detector_;
+    std::unique_ptr<DetectorPluginLoader> detector_loader_;
+    std::unique_ptr<HotSwapDetector> detector_;
     std::unique_ptr<ICollimator> collimator_;
     std::unique_ptr<IPatientTable> patient_table_;
     std::unique_ptr<IAEC> aec_;
@@ -0,0 +1,101 @@
+/**
+ * @file HalThreads.cpp
+ * @brief HAL thread role policy configuration
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Exposure-path thread scheduling
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/hal/HalThreads.h"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+namespace {
+
+infra::ThreadPolicy MakePolicy(infra::SchedulingClass scheduling,
+                               int32_t priority,
+                               const std::vector<int32_t>& cpus,
+                               size_t stack_prefault_bytes) {
+    infra::ThreadPolicy policy;
+    policy.scheduling = scheduling;
+    policy.priority = std::clamp(priority, infra::kMinRealtimePriority,
+                                 infra::kMaxRealtimePriority);
+    policy.cpu_affinity = cpus;
+    policy.stack_prefault_bytes = stack_prefault_bytes;
+    return policy;
+}
+
+} // anonymous namespace
+
+bool ConfigureHalThreadPolicies(const RealtimeConfig& config) {
+    bool all_applied = true;
+
+    if (config.lock_memory) {
+        infra::ThreadPolicyResult result = infra::LockProcessMemory();
+        if (result != infra::ThreadPolicyResult::POLICY_OK) {
+            spdlog::warn("[HalThreads] mlockall failed (result={}), page faults possible on exposure path",
+                         static_cast<int>(result));
+            all_applied = false;
+        } else {
+            spdlog::info("[HalThreads] Process memory locked");
+        }
+    }
+
+    auto& registry = infra::ThreadPolicyRegistry::Instance();
+
+    if (config.rt_priority <= 0) {
+        // Real-time scheduling disabled: drop any previously registered roles
+        for (const char* name : {kThreadAec, kThreadGeneratorExposure, kThreadGeneratorIo,
+                                 kThreadDetectorIngest, kThreadGeneratorStatus, kThreadDoseSampler,
+                                 kThreadDoseIntegrator, kThreadDetectorHostMonitor}) {
+            registry.RemovePolicy(name);
+        }
+        return all_applied;
+    }
+
+    if (config.rt_priority > infra::kMaxRealtimePriority) {
+        spdlog::error("[HalThreads] rt_priority {} out of range [{}, {}]",
+                      config.rt_priority, infra::kMinRealtimePriority,
+                      infra::kMaxRealtimePriority);
+        return false;
+    }
+
+    std::vector<int32_t> cpus = config.rt_cpus;
+    if (cpus.empty()) {
+        cpus = infra::GetIsolatedCpus();
+    }
+
+    const int32_t top = config.rt_priority;
+    const size_t stack = config.stack_prefault_bytes;
+
+    registry.SetPolicy(kThreadAec,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_FIFO, top, cpus, stack));
+    registry.SetPolicy(kThreadGeneratorExposure,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_FIFO, top, cpus, stack));
+    // Aborts reach a serial generator through its I/O thread
+    registry.SetPolicy(kThreadGeneratorIo,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_FIFO, top, cpus, stack));
+    registry.SetPolicy(kThreadDetectorIngest,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_FIFO, top - kIngestPriorityOffset, cpus, stack));
+    // Status and dose polling stay off the isolated CPUs
+    registry.SetPolicy(kThreadGeneratorStatus,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_RR, top - kStatusPriorityOffset, {}, 0));
+    registry.SetPolicy(kThreadDoseSampler,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_RR, top - kStatusPriorityOffset, {}, 0));
+    registry.SetPolicy(kThreadDoseIntegrator,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_RR, top - kStatusPriorityOffset, {}, 0));
+    registry.SetPolicy(kThreadDetectorHostMonitor,
+        MakePolicy(infra::SchedulingClass::SCHED_CLASS_RR, top - kStatusPriorityOffset, {}, 0));
+
+    spdlog::info("[HalThreads] Real-time policies registered: priority={}, cpus={}",
+                 top, cpus.size());
+    return all_applied;
+}
+
+} // namespace hnvue::hal
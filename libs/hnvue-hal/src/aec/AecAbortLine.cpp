@@ -0,0 +1,206 @@
+/**
+ * @file AecAbortLine.cpp
+ * @brief Lock-free AEC termination fast path to the generator abort handler
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "aec/AecAbortLine.h"
+
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
+
+#include <chrono>
+
+#ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <ctime>
+#endif
+
+namespace hnvue::hal {
+
+namespace {
+
+/// Upper bound on one sleep; the loop re-checks running_ and armed_
+constexpr int64_t kSleepSliceNs = 50 * 1000 * 1000;
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+#ifdef __linux__
+    timespec timeout{0, kSleepSliceNs};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected,
+            &timeout, nullptr, 0);
+#else
+    if (word->load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+#endif
+}
+
+void FutexWake(std::atomic<uint32_t>* word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, 1, nullptr,
+            nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Construction / Lifecycle
+// =============================================================================
+
+AecAbortLine::AecAbortLine(const AecAbortLineConfig& config)
+    : config_(config) {
+}
+
+AecAbortLine::~AecAbortLine() {
+    Stop();
+}
+
+bool AecAbortLine::SetHandler(AecAbortFn fn, void* context) {
+    if (fn == nullptr || running_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    handler_ = fn;
+    handler_context_ = context;
+    return true;
+}
+
+bool AecAbortLine::Start() {
+    if (handler_ == nullptr || running_.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    handled_seq_.store(signal_seq_.load(std::memory_order_acquire), std::memory_order_release);
+    thread_ = std::thread([this]() { HandlerLoop(); });
+    return true;
+}
+
+void AecAbortLine::Stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    armed_.store(false, std::memory_order_seq_cst);
+    Wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AecAbortLine::Arm() {
+    if (!running_.load(std::memory_order_acquire) ||
+        handled_seq_.load(std::memory_order_acquire) != signal_seq_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    armed_.store(true, std::memory_order_seq_cst);
+    // Move the handler thread from sleeping to polling
+    if (config_.spin_while_armed && sleeping_.load(std::memory_order_seq_cst)) {
+        Wake();
+    }
+    return true;
+}
+
+void AecAbortLine::Disarm() {
+    armed_.store(false, std::memory_order_seq_cst);
+}
+
+// =============================================================================
+// Signal Path
+// =============================================================================
+
+bool AecAbortLine::Signal(const AecTerminationEvent& event) {
+    // One abort per armed exposure; later signals are redundant
+    bool expected = true;
+    if (!armed_.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
+        return false;
+    }
+    signal_ns_ = infra::MonotonicClock::NowNs();
+    event_ = event;
+    signal_seq_.fetch_add(1, std::memory_order_seq_cst);
+    signals_.fetch_add(1, std::memory_order_relaxed);
+    if (sleeping_.load(std::memory_order_seq_cst)) {
+        Wake();
+    }
+    return true;
+}
+
+void AecAbortLine::Wake() {
+    FutexWake(&signal_seq_);
+}
+
+AecAbortLineStats AecAbortLine::GetStats() const {
+    AecAbortLineStats stats;
+    stats.signals = signals_.load(std::memory_order_relaxed);
+    stats.aborts = aborts_.load(std::memory_order_relaxed);
+    stats.last_latency_ns = last_latency_ns_.load(std::memory_order_relaxed);
+    stats.max_latency_ns = max_latency_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// =============================================================================
+// Handler Thread
+// =============================================================================
+
+void AecAbortLine::WaitForSignal(uint32_t seen) {
+    if (config_.spin_while_armed) {
+        while (armed_.load(std::memory_order_acquire) &&
+               signal_seq_.load(std::memory_order_acquire) == seen) {
+            CpuRelax();
+        }
+        if (signal_seq_.load(std::memory_order_acquire) != seen) {
+            return;
+        }
+    }
+
+    // Announce the sleep, then re-check both wake conditions (pairs with
+    // the seq_cst store/load in Signal and Arm)
+    sleeping_.store(true, std::memory_order_seq_cst);
+    if (running_.load(std::memory_order_seq_cst) &&
+        signal_seq_.load(std::memory_order_seq_cst) == seen &&
+        !(config_.spin_while_armed && armed_.load(std::memory_order_seq_cst))) {
+        FutexWait(&signal_seq_, seen);
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+}
+
+void AecAbortLine::HandlerLoop() {
+    infra::ApplyNamedThreadPolicy(kThreadAec);
+
+    uint32_t seen = handled_seq_.load(std::memory_order_acquire);
+    while (running_.load(std::memory_order_acquire)) {
+        WaitForSignal(seen);
+        uint32_t current = signal_seq_.load(std::memory_order_acquire);
+        if (current == seen) {
+            continue;
+        }
+        seen = current;
+
+        const int64_t signal_ns = signal_ns_;
+        const AecTerminationEvent event = event_;
+        handler_(handler_context_, event);
+
+        const int64_t latency_ns = infra::MonotonicClock::NowNs() - signal_ns;
+        last_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+        if (latency_ns > max_latency_ns_.load(std::memory_order_relaxed)) {
+            max_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+        }
+        aborts_.fetch_add(1, std::memory_order_relaxed);
+        handled_seq_.store(seen, std::memory_order_release);
+    }
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,136 @@
+/**
+ * @file AecAbortLine.h
+ * @brief Lock-free AEC termination fast path to the generator abort handler
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ *
+ * The regular termination path (AecController callbacks, then
+ * IGenerator::AbortExposure through the generator's command handling)
+ * crosses mutex-protected callback lists and general-purpose queues. The
+ * abort line bypasses both:
+ *
+ *   Signal() (detector / chamber interrupt context)
+ *     -> one atomic sequence increment (+ futex wake if the handler sleeps)
+ *   handler thread (kThreadAec)
+ *     -> generator-side abort handler (plain function pointer)
+ *
+ * While armed (exposure in progress) the handler thread busy-polls so the
+ * abort does not pay a scheduler wake-up; disarmed, it sleeps.
+ */
+
+#ifndef HNUE_HAL_AEC_ABORT_LINE_H
+#define HNUE_HAL_AEC_ABORT_LINE_H
+
+#include "hnvue/hal/HalTypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Generator-side abort handler; must not block or allocate
+ */
+using AecAbortFn = void (*)(void* context, const AecTerminationEvent& event);
+
+/**
+ * @brief Abort line configuration
+ */
+struct AecAbortLineConfig {
+    bool spin_while_armed = true;      ///< Busy-poll while armed (needs a dedicated CPU)
+};
+
+/**
+ * @brief Abort line counters
+ */
+struct AecAbortLineStats {
+    uint64_t signals = 0;              ///< Signals accepted (one per armed exposure)
+    uint64_t aborts = 0;               ///< Handler invocations completed
+    int64_t last_latency_ns = 0;       ///< Signal to handler return, last abort
+    int64_t max_latency_ns = 0;
+};
+
+/**
+ * @brief One-shot termination signal per exposure
+ *
+ * Thread Safety:
+ * - Signal() is lock-free and may be called from any thread
+ * - SetHandler, Start and Stop from one control thread, handler set before Start
+ * - Arm/Disarm from the exposure control path
+ */
+class AecAbortLine {
+public:
+    explicit AecAbortLine(const AecAbortLineConfig& config = AecAbortLineConfig{});
+    ~AecAbortLine();
+
+    AecAbortLine(const AecAbortLine&) = delete;
+    AecAbortLine& operator=(const AecAbortLine&) = delete;
+
+    /**
+     * @brief Set the abort handler
+     * @return false if running or fn is null
+     */
+    bool SetHandler(AecAbortFn fn, void* context);
+
+    /**
+     * @brief Start the handler thread
+     * @return false if already running or no handler
+     */
+    bool Start();
+
+    void Stop();
+
+    /**
+     * @brief Accept one termination signal (exposure start)
+     * @return false if not running or the previous abort is still being handled
+     */
+    bool Arm();
+
+    /**
+     * @brief Ignore termination signals (exposure end)
+     */
+    void Disarm();
+
+    bool IsArmed() const { return armed_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Deliver a termination signal to the handler thread
+     * @return true if accepted; false if not armed or already signalled
+     *
+     * Lock-free and allocation-free.
+     */
+    bool Signal(const AecTerminationEvent& event);
+
+    AecAbortLineStats GetStats() const;
+
+private:
+    void HandlerLoop();
+    void WaitForSignal(uint32_t seen);
+    void Wake();
+
+    AecAbortLineConfig config_;
+    AecAbortFn handler_ = nullptr;
+    void* handler_context_ = nullptr;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> armed_{false};
+    std::atomic<uint32_t> signal_seq_{0};     ///< Futex word; bumped per signal
+    std::atomic<uint32_t> handled_seq_{0};
+    std::atomic<bool> sleeping_{false};
+    AecTerminationEvent event_;               ///< Published by signal_seq_ release
+    int64_t signal_ns_ = 0;                   ///< Published by signal_seq_ release
+    std::thread thread_;
+
+    std::atomic<uint64_t> signals_{0};
+    std::atomic<uint64_t> aborts_{0};
+    std::atomic<int64_t> last_latency_ns_{0};
+    std::atomic<int64_t> max_latency_ns_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_AEC_ABORT_LINE_H
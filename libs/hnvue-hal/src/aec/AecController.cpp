@@ -8,7 +8,8 @@
  * SPDX-License-Identifier: MIT
  */
 
-#include "hnvue/hal/aec/AecController.h"
+#include "aec/AecController.h"
+#include "hnvue/infra/Clock.h"
 
 #include <chrono>
 #include <exception>
@@ -39,7 +40,8 @@ AecController::~AecController() {
 
 bool AecController::SetMode(AecMode mode) {
     // Validate mode parameter
-    if (mode != AecMode::AEC_MANUAL && mode != AecMode::AEC_AUTO) {
+    if (mode != AecMode::AEC_MANUAL && mode != AecMode::AEC_AUTO &&
+        mode != AecMode::AEC_DETECTOR) {
         return false;  // Invalid mode
     }
 
@@ -96,18 +98,22 @@ void AecController::SimulateTerminationSignal(const AecTerminationEvent& event)
 
     // FR-HAL-07: Abort sequence must initiate within 5ms
     // We measure timing from signal receipt to callback completion
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    // Invoke all registered callbacks first (fast path)
-    InvokeTerminationCallbacks(event);
-
-    // SAFETY CRITICAL: Trigger generator abort within 5ms
-    if (generator_) {
+    auto start_time = infra::MonotonicClock::now();
+
+    // SAFETY CRITICAL: Abort before any callback runs. The abort line hands
+    // the signal to its real-time thread without locks; otherwise (or if the
+    // line was not armed) abort the generator directly
+    AecAbortLine* line = abort_line_.load(std::memory_order_acquire);
+    bool fast_path = line != nullptr && line->Signal(event);
+    if (!fast_path && generator_) {
         generator_->AbortExposure();
     }
 
+    // Notify observers (display, logging) after the abort was initiated
+    InvokeTerminationCallbacks(event);
+
     // Verify timing requirement met
-    auto end_time = std::chrono::high_resolution_clock::now();
+    auto end_time = infra::MonotonicClock::now();
     auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
         end_time - start_time).count();
 
@@ -118,6 +124,19 @@ void AecController::SimulateTerminationSignal(const AecTerminationEvent& event)
 
 void AecController::SetExposureState(bool exposing) {
     is_exposing_.store(exposing, std::memory_order_release);
+
+    AecAbortLine* line = abort_line_.load(std::memory_order_acquire);
+    if (line != nullptr) {
+        if (exposing) {
+            line->Arm();
+        } else {
+            line->Disarm();
+        }
+    }
+}
+
+void AecController::SetAbortLine(AecAbortLine* line) {
+    abort_line_.store(line, std::memory_order_release);
 }
 
 // =============================================================================
@@ -17,6 +17,7 @@
 #include "hnvue/hal/IAEC.h"
 #include "hnvue/hal/IGenerator.h"
 #include "hnvue/hal/HalTypes.h"
+#include "aec/AecAbortLine.h"
 
 #include <atomic>
 #include <functional>
@@ -67,9 +68,12 @@ public:
 
     /**
      * @brief Set AEC operating mode
-     * @param mode AEC_MANUAL or AEC_AUTO
+     * @param mode AEC_MANUAL, AEC_AUTO or AEC_DETECTOR
      * @return true if mode change successful
      *
+     * In AEC_DETECTOR mode the termination signal comes from DetectorAec
+     * (detector partial readouts) instead of the ionization chamber.
+     *
      * Mode change fails if:
      * - Exposure is currently active (state check)
      * - Invalid mode specified
@@ -138,6 +142,17 @@ public:
      */
     void SetExposureState(bool exposing);
 
+    /**
+     * @brief Route generator abort through a dedicated abort line
+     * @param line Started abort line whose handler aborts the generator;
+     *             nullptr restores IGenerator::AbortExposure
+     *
+     * The line is armed and disarmed with SetExposureState. A termination
+     * signal is delivered to the line before any callback runs; if the line
+     * does not accept it (not armed), the generator is aborted directly.
+     */
+    void SetAbortLine(AecAbortLine* line);
+
 private:
     // Generator interface for abort on termination
     IGenerator* generator_;
@@ -149,6 +164,9 @@ private:
     // Exposure state for mode change validation
     std::atomic<bool> is_exposing_;
 
+    // Optional fast abort path (not owned)
+    std::atomic<AecAbortLine*> abort_line_{nullptr};
+
     // Termination callbacks (mutex-protected for registration)
     std::vector<AecTerminationCallback> termination_callbacks_;
     mutable std::mutex callbacks_mutex_;
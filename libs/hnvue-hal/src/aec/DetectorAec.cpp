@@ -0,0 +1,335 @@
+/**
+ * @file DetectorAec.cpp
+ * @brief Detector-based AEC from partial-readout ROI statistics
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "aec/DetectorAec.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HNVUE_AEC_HAS_SSE2 1
+#else
+    #define HNVUE_AEC_HAS_SSE2 0
+#endif
+
+namespace hnvue::hal {
+
+namespace {
+
+/// Pixels summed per 32-bit lane batch; keeps 16-bit lane sums below 2^32
+constexpr int32_t kSumChunk = 16384;
+
+uint64_t SumRow16(const uint16_t* row, int32_t count) {
+    uint64_t sum = 0;
+    int32_t x = 0;
+#if HNVUE_AEC_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (x + 8 <= count) {
+        const int32_t chunk_end = std::min(count, x + kSumChunk);
+        __m128i acc = zero;
+        for (; x + 8 <= chunk_end; x += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+        }
+        alignas(16) uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        sum += static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+    for (; x < count; ++x) {
+        sum += row[x];
+    }
+    return sum;
+}
+
+uint64_t SumRow8(const uint8_t* row, int32_t count) {
+    uint64_t sum = 0;
+    int32_t x = 0;
+#if HNVUE_AEC_HAS_SSE2
+    // SAD against zero sums 8 bytes into each 64-bit lane
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (; x + 16 <= count; x += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum = lanes[0] + lanes[1];
+#endif
+    for (; x < count; ++x) {
+        sum += row[x];
+    }
+    return sum;
+}
+
+bool IsUsable(const AecRegion& region) {
+    return region.is_active && region.weight > 0.0f;
+}
+
+bool IsValid(const AecRegion& region) {
+    return region.center_x >= 0.0f && region.center_x <= 1.0f &&
+           region.center_y >= 0.0f && region.center_y <= 1.0f &&
+           region.width > 0.0f && region.width <= 1.0f &&
+           region.height > 0.0f && region.height <= 1.0f &&
+           region.weight >= 0.0f;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Construction / Configuration
+// =============================================================================
+
+DetectorAec::DetectorAec(AecController* aec, const DetectorAecConfig& config)
+    : aec_(aec) {
+    if (!Configure(config)) {
+        Configure(DetectorAecConfig{});
+    }
+}
+
+bool DetectorAec::Configure(const DetectorAecConfig& config) {
+    // Early out without the lock, so a rejected call never makes a readout skip
+    if (exposing_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    DetectorAecConfig applied = config;
+    if (applied.regions.empty()) {
+        applied.regions.push_back(AecRegion{});
+    }
+    bool any_usable = false;
+    for (const AecRegion& region : applied.regions) {
+        if (!IsValid(region)) {
+            return false;
+        }
+        any_usable = any_usable || IsUsable(region);
+    }
+    if (!any_usable || applied.dose_mgy_per_percent < 0.0f) {
+        return false;
+    }
+
+    // BeginExposure sets exposing_ under this lock, so a configuration
+    // cannot be swapped in after an exposure has started
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    if (exposing_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    config_ = std::move(applied);
+    rects_.assign(config_.regions.size(), PixelRect{});
+    rect_width_ = 0;
+    rect_height_ = 0;
+    return true;
+}
+
+void DetectorAec::Attach(IDetector* detector) {
+    if (detector == nullptr) {
+        return;
+    }
+    detector->RegisterFrameCallback([this](const RawFrame& frame) { OnPartialFrame(frame); });
+}
+
+// =============================================================================
+// Exposure Control
+// =============================================================================
+
+bool DetectorAec::BeginExposure() {
+    if (aec_ == nullptr || aec_->GetMode() != AecMode::AEC_DETECTOR) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    target_pct_.store(aec_->GetThreshold(), std::memory_order_relaxed);
+    begin_us_.store(infra::MonotonicClock::NowUs(), std::memory_order_relaxed);
+    accumulated_pct_.store(0.0f, std::memory_order_relaxed);
+    exposure_epoch_.fetch_add(1, std::memory_order_release);
+    exposing_.store(true, std::memory_order_release);
+    return true;
+}
+
+void DetectorAec::EndExposure() {
+    exposing_.store(false, std::memory_order_release);
+}
+
+DetectorAecStats DetectorAec::GetStats() const {
+    DetectorAecStats stats;
+    stats.samples = samples_.load(std::memory_order_relaxed);
+    stats.skipped = skipped_.load(std::memory_order_relaxed);
+    stats.budget_overruns = overruns_.load(std::memory_order_relaxed);
+    stats.terminations = terminations_.load(std::memory_order_relaxed);
+    stats.last_sample_ns = last_sample_ns_.load(std::memory_order_relaxed);
+    stats.max_sample_ns = max_sample_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// =============================================================================
+// Acquisition Thread
+// =============================================================================
+
+void DetectorAec::OnPartialFrame(const RawFrame& frame) {
+    const int64_t start_ns = infra::MonotonicClock::NowNs();
+    if (!exposing_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    AecTerminationEvent event;
+    bool terminate = false;
+    int64_t budget_ns = 0;
+    {
+        std::unique_lock<std::mutex> lock(config_mutex_, std::try_to_lock);
+        float signal_pct = 0.0f;
+        if (!lock.owns_lock() || !ComputeSignal(frame, signal_pct)) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        budget_ns = config_.sample_budget_ns;
+        terminate = Accumulate(signal_pct, frame.timestamp_us, event);
+    }
+    Finish(terminate, event, start_ns, budget_ns);
+}
+
+void DetectorAec::OnRegionMeans(const float* means, size_t count, int64_t timestamp_us) {
+    const int64_t start_ns = infra::MonotonicClock::NowNs();
+    if (!exposing_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    AecTerminationEvent event;
+    bool terminate = false;
+    int64_t budget_ns = 0;
+    {
+        std::unique_lock<std::mutex> lock(config_mutex_, std::try_to_lock);
+        if (!lock.owns_lock() || means == nullptr || count != config_.regions.size()) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        double weighted = 0.0;
+        double weight_sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            const AecRegion& region = config_.regions[i];
+            if (IsUsable(region)) {
+                weighted += static_cast<double>(region.weight) * means[i];
+                weight_sum += region.weight;
+            }
+        }
+        auto signal_pct = static_cast<float>(weighted / weight_sum * 100.0);
+        budget_ns = config_.sample_budget_ns;
+        terminate = Accumulate(signal_pct, timestamp_us, event);
+    }
+    Finish(terminate, event, start_ns, budget_ns);
+}
+
+void DetectorAec::UpdateRects(int32_t width, int32_t height) {
+    for (size_t i = 0; i < config_.regions.size(); ++i) {
+        const AecRegion& region = config_.regions[i];
+        auto to_pixel = [](float normalized, int32_t extent) {
+            auto pixel = static_cast<int32_t>(std::lround(normalized * static_cast<float>(extent)));
+            return std::clamp(pixel, 0, extent);
+        };
+        PixelRect& rect = rects_[i];
+        rect.x0 = to_pixel(region.center_x - region.width / 2.0f, width);
+        rect.x1 = to_pixel(region.center_x + region.width / 2.0f, width);
+        rect.y0 = to_pixel(region.center_y - region.height / 2.0f, height);
+        rect.y1 = to_pixel(region.center_y + region.height / 2.0f, height);
+    }
+    rect_width_ = width;
+    rect_height_ = height;
+}
+
+bool DetectorAec::ComputeSignal(const RawFrame& frame, float& signal_pct) {
+    if (frame.width <= 0 || frame.height <= 0 || frame.bit_depth <= 0 || frame.bit_depth > 16) {
+        return false;
+    }
+    const size_t bytes_per_pixel = frame.bit_depth > 8 ? 2 : 1;
+    const size_t expected = static_cast<size_t>(frame.width) * static_cast<size_t>(frame.height) *
+                            bytes_per_pixel;
+    if (frame.pixel_data.size() < expected) {
+        return false;
+    }
+    // Partial readouts may be binned; regions are normalized
+    if (frame.width != rect_width_ || frame.height != rect_height_) {
+        UpdateRects(frame.width, frame.height);
+    }
+
+    double weighted = 0.0;
+    double weight_sum = 0.0;
+    for (size_t i = 0; i < config_.regions.size(); ++i) {
+        const AecRegion& region = config_.regions[i];
+        const PixelRect& rect = rects_[i];
+        const int32_t columns = rect.x1 - rect.x0;
+        if (!IsUsable(region) || columns <= 0 || rect.y1 <= rect.y0) {
+            continue;
+        }
+
+        uint64_t sum = 0;
+        for (int32_t y = rect.y0; y < rect.y1; ++y) {
+            const size_t offset = (static_cast<size_t>(y) * frame.width + rect.x0) * bytes_per_pixel;
+            const uint8_t* row = frame.pixel_data.data() + offset;
+            sum += bytes_per_pixel == 2 ? SumRow16(reinterpret_cast<const uint16_t*>(row), columns)
+                                        : SumRow8(row, columns);
+        }
+        const double pixels = static_cast<double>(columns) * (rect.y1 - rect.y0);
+        weighted += static_cast<double>(region.weight) * (static_cast<double>(sum) / pixels);
+        weight_sum += region.weight;
+    }
+    if (weight_sum <= 0.0) {
+        return false;
+    }
+
+    const double full_scale = static_cast<double>((1u << frame.bit_depth) - 1u);
+    signal_pct = static_cast<float>(weighted / weight_sum / full_scale * 100.0);
+    return true;
+}
+
+bool DetectorAec::Accumulate(float signal_pct, int64_t timestamp_us, AecTerminationEvent& event) {
+    // New exposure since the last readout
+    const uint32_t epoch = exposure_epoch_.load(std::memory_order_acquire);
+    if (epoch != seen_epoch_) {
+        seen_epoch_ = epoch;
+        accumulated_ = 0.0f;
+        fired_ = false;
+    }
+
+    accumulated_ = config_.cumulative_readout ? signal_pct : accumulated_ + signal_pct;
+    accumulated_pct_.store(accumulated_, std::memory_order_relaxed);
+    samples_.fetch_add(1, std::memory_order_relaxed);
+
+    if (fired_ || accumulated_ < target_pct_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    fired_ = true;
+    event.threshold_reached = true;
+    event.actual_dose_mgy = accumulated_ * config_.dose_mgy_per_percent;
+    event.exposure_time_us = timestamp_us - begin_us_.load(std::memory_order_relaxed);
+    return true;
+}
+
+void DetectorAec::Finish(bool terminate, const AecTerminationEvent& event, int64_t start_ns,
+                         int64_t budget_ns) {
+    // Outside the configuration lock: termination callbacks may reconfigure
+    if (terminate) {
+        aec_->SimulateTerminationSignal(event);
+        terminations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int64_t elapsed_ns = infra::MonotonicClock::NowNs() - start_ns;
+    last_sample_ns_.store(elapsed_ns, std::memory_order_relaxed);
+    if (elapsed_ns > max_sample_ns_.load(std::memory_order_relaxed)) {
+        max_sample_ns_.store(elapsed_ns, std::memory_order_relaxed);
+    }
+    if (elapsed_ns > budget_ns) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace hnvue::hal
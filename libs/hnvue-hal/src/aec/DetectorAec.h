@@ -0,0 +1,175 @@
+/**
+ * @file DetectorAec.h
+ * @brief Detector-based AEC from partial-readout ROI statistics
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ *
+ * Panels with fast partial readout deliver frames during the exposure. In
+ * AEC_DETECTOR mode each readout is reduced on the acquisition thread to a
+ * weighted mean over the measuring fields (AecRegionOfInterest in
+ * hnvue_aec.proto), accumulated, and compared with the AecController
+ * threshold (percent of detector full scale). Reaching it raises the
+ * termination signal on the AecController, which aborts the generator.
+ */
+
+#ifndef HNUE_HAL_DETECTOR_AEC_H
+#define HNUE_HAL_DETECTOR_AEC_H
+
+#include "hnvue/hal/HalTypes.h"
+#include "hnvue/hal/IDetector.h"
+#include "aec/AecController.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief AEC measuring field, normalized to the detector area
+ *
+ * Mirrors hnvue.aec.AecRegionOfInterest.
+ */
+struct AecRegion {
+    float center_x = 0.5f;     ///< 0.0 to 1.0
+    float center_y = 0.5f;     ///< 0.0 to 1.0
+    float width = 0.2f;        ///< 0.0 to 1.0
+    float height = 0.2f;       ///< 0.0 to 1.0
+    float weight = 1.0f;       ///< Contribution to the exposure signal
+    bool is_active = true;
+};
+
+/**
+ * @brief Detector AEC configuration
+ */
+struct DetectorAecConfig {
+    std::vector<AecRegion> regions;        ///< Empty: one central field
+    bool cumulative_readout = false;       ///< Readouts are non-destructive (signal since exposure start)
+    float dose_mgy_per_percent = 0.0f;     ///< Calibration for AecTerminationEvent::actual_dose_mgy
+    int64_t sample_budget_ns = 200000;     ///< Per-readout processing budget (acquisition thread)
+};
+
+/**
+ * @brief Detector AEC counters
+ */
+struct DetectorAecStats {
+    uint64_t samples = 0;                  ///< Readouts evaluated during exposures
+    uint64_t skipped = 0;                  ///< Readouts dropped (bad format or reconfiguring)
+    uint64_t budget_overruns = 0;          ///< Readouts exceeding sample_budget_ns
+    uint64_t terminations = 0;
+    int64_t last_sample_ns = 0;
+    int64_t max_sample_ns = 0;
+};
+
+/**
+ * @brief Termination from live detector ROI signal
+ *
+ * Thread Safety:
+ * - OnPartialFrame / OnRegionMeans on the acquisition thread (one producer)
+ * - Configure, BeginExposure and EndExposure from the exposure control path
+ * - The acquisition path never blocks: a readout arriving while the
+ *   configuration is being replaced is skipped
+ */
+class DetectorAec {
+public:
+    explicit DetectorAec(AecController* aec, const DetectorAecConfig& config = DetectorAecConfig{});
+
+    DetectorAec(const DetectorAec&) = delete;
+    DetectorAec& operator=(const DetectorAec&) = delete;
+
+    /**
+     * @brief Replace the measuring fields
+     * @return false during an exposure or if no region is usable
+     */
+    bool Configure(const DetectorAecConfig& config);
+
+    /**
+     * @brief Consume the detector's frames as partial readouts
+     *
+     * The detector must outlive this object's use; frames outside an
+     * exposure are ignored.
+     */
+    void Attach(IDetector* detector);
+
+    /**
+     * @brief Start evaluating readouts against the AecController threshold
+     * @return false if the controller is not in AEC_DETECTOR mode
+     */
+    bool BeginExposure();
+
+    void EndExposure();
+
+    bool IsExposing() const { return exposing_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Evaluate one partial readout (8- or 16-bit pixels)
+     */
+    void OnPartialFrame(const RawFrame& frame);
+
+    /**
+     * @brief Evaluate ROI means computed by the panel
+     * @param means One value per configured region, fraction of full scale (0-1)
+     * @param count Number of values; must equal the region count
+     * @param timestamp_us infra::MonotonicClock time of the readout
+     */
+    void OnRegionMeans(const float* means, size_t count, int64_t timestamp_us);
+
+    /**
+     * @brief Signal accumulated in the current exposure, percent of full scale
+     */
+    float GetAccumulatedPercent() const { return accumulated_pct_.load(std::memory_order_relaxed); }
+
+    DetectorAecStats GetStats() const;
+
+private:
+    /// Region in pixels for the current readout size; empty if x0 == x1
+    struct PixelRect {
+        int32_t x0 = 0;
+        int32_t y0 = 0;
+        int32_t x1 = 0;
+        int32_t y1 = 0;
+    };
+
+    void UpdateRects(int32_t width, int32_t height);
+    bool ComputeSignal(const RawFrame& frame, float& signal_pct);
+    bool Accumulate(float signal_pct, int64_t timestamp_us, AecTerminationEvent& event);
+    void Finish(bool terminate, const AecTerminationEvent& event, int64_t start_ns,
+                int64_t budget_ns);
+
+    AecController* aec_;
+
+    // Configuration (acquisition thread holds it with try_lock only)
+    std::mutex config_mutex_;
+    DetectorAecConfig config_;
+    std::vector<PixelRect> rects_;         ///< Sized in Configure, filled per readout size
+    int32_t rect_width_ = 0;
+    int32_t rect_height_ = 0;
+
+    // Exposure state
+    std::atomic<bool> exposing_{false};
+    std::atomic<uint32_t> exposure_epoch_{0};
+    std::atomic<float> target_pct_{0.0f};
+    std::atomic<int64_t> begin_us_{0};
+    std::atomic<float> accumulated_pct_{0.0f};
+
+    // Acquisition thread only
+    uint32_t seen_epoch_ = 0;
+    float accumulated_ = 0.0f;
+    bool fired_ = false;
+
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> terminations_{0};
+    std::atomic<int64_t> last_sample_ns_{0};
+    std::atomic<int64_t> max_sample_ns_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_DETECTOR_AEC_H
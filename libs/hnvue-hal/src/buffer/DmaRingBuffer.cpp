@@ -12,11 +12,14 @@
  */
 
 #include "hnvue/hal/DmaRingBuffer.h"
+#include "hnvue/infra/FramePool.h"
+#include <new>
 #include <stdexcept>
 #include <mutex>
 #include <condition_variable>
 #include <cstring>
 #include <atomic>
+#include <vector>
 
 namespace hnvue::hal {
 
@@ -29,14 +32,21 @@ namespace hnvue::hal {
  *
  * Uses lock-free SPSC queue for single producer single consumer scenarios.
  * For BLOCK_PRODUCER policy, uses condition variable for blocking behavior.
+ *
+ * Slot storage is a single block borrowed from an infra::FramePool. Each
+ * slot starts on a cache-line boundary (slot stride is frame_size rounded up
+ * to kCacheLineSize), so consumers may use aligned SIMD loads and a
+ * re-created ring of the same geometry reuses the previous ring's memory.
  */
 class DmaRingBufferImpl {
 public:
-    DmaRingBufferImpl(size_t depth, size_t frame_size, OverwritePolicy policy)
+    DmaRingBufferImpl(size_t depth, size_t frame_size, OverwritePolicy policy,
+                      infra::FramePool& pool)
         : depth_(depth)
         , frame_size_(frame_size)
+        , slot_stride_(RoundUpToCacheLine(frame_size))
         , policy_(policy)
-        , buffer_data_(depth * frame_size)
+        , sequence_numbers_(depth, 0)
         , write_index_(0)
         , read_index_(0)
         , sequence_counter_(0)
@@ -48,6 +58,12 @@ public:
         if (frame_size == 0) {
             throw std::invalid_argument("Frame size must be greater than 0");
         }
+
+        storage_ = pool.Acquire(depth_ * slot_stride_);
+        if (!storage_) {
+            throw std::bad_alloc();
+        }
+        buffer_data_ = storage_.Data();
     }
 
     ~DmaRingBufferImpl() = default;
@@ -70,7 +86,7 @@ public:
 
         // Calculate write position
         size_t write_pos = write_index_ % depth_;
-        uint8_t* write_ptr = buffer_data_.data() + (write_pos * frame_size_);
+        uint8_t* write_ptr = buffer_data_ + (write_pos * slot_stride_);
 
         // Copy frame data
         std::memcpy(write_ptr, data, frame_size_);
@@ -103,16 +119,66 @@ public:
         return true;
     }
 
-    bool ReadFrame(void* buffer_out, size_t& size_out, uint64_t& sequence_out) {
+    uint8_t* BeginWrite() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (write_open_) {
+            return nullptr;
+        }
+
+        if (policy_ == OverwritePolicy::BLOCK_PRODUCER) {
+            write_cv_.wait(lock, [this]() { return frame_count_ < depth_; });
+        } else if (frame_count_ == depth_) {
+            // Drop the oldest frame now: its slot is written outside the lock
+            read_index_++;
+            frame_count_--;
+        }
+
+        write_open_ = true;
+        return buffer_data_ + ((write_index_ % depth_) * slot_stride_);
+    }
+
+    bool CommitWrite(uint64_t& sequence_out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!write_open_) {
+            return false;
+        }
+        write_open_ = false;
+
+        size_t write_pos = write_index_ % depth_;
+        uint8_t* write_ptr = buffer_data_ + (write_pos * slot_stride_);
+
+        sequence_out = sequence_counter_++;
+        sequence_numbers_[write_pos] = sequence_out;
+        frame_count_++;
+        write_index_++;
+
+        if (callback_) {
+            lock.unlock();
+            callback_(write_ptr, frame_size_, sequence_out);
+        }
+
+        read_cv_.notify_one();
+        return true;
+    }
+
+    void CancelWrite() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        write_open_ = false;
+    }
+
+    bool ReadFrame(void* buffer_out, size_t buffer_size, size_t& size_out, uint64_t& sequence_out) {
         std::unique_lock<std::mutex> lock(mutex_);
 
         if (frame_count_ == 0) {
             return false;  // Buffer empty
         }
+        if (buffer_size < frame_size_) {
+            return false;  // Caller's buffer too small; frame stays queued
+        }
 
         // Calculate read position
         size_t read_pos = read_index_ % depth_;
-        const uint8_t* read_ptr = buffer_data_.data() + (read_pos * frame_size_);
+        const uint8_t* read_ptr = buffer_data_ + (read_pos * slot_stride_);
 
         // Copy frame data to output buffer
         std::memcpy(buffer_out, read_ptr, frame_size_);
@@ -152,15 +218,22 @@ public:
     }
 
     size_t GetDepth() const { return depth_; }
+    size_t GetSlotStride() const { return slot_stride_; }
     size_t GetFrameSize() const { return frame_size_; }
     OverwritePolicy GetOverwritePolicy() const { return policy_; }
 
 private:
+    static size_t RoundUpToCacheLine(size_t bytes) {
+        return (bytes + infra::kCacheLineSize - 1) / infra::kCacheLineSize * infra::kCacheLineSize;
+    }
+
     const size_t depth_;              ///< Buffer capacity in frames
     const size_t frame_size_;         ///< Size of each frame in bytes
+    const size_t slot_stride_;        ///< Bytes between slot starts (cache-line multiple)
     const OverwritePolicy policy_;    ///< Overwrite policy when full
 
-    std::vector<uint8_t> buffer_data_;  ///< Pre-allocated buffer memory
+    infra::FrameHandle storage_;      ///< Pooled slot storage (depth * slot_stride)
+    uint8_t* buffer_data_ = nullptr;  ///< storage_.Data(), cached
 
     std::vector<uint64_t> sequence_numbers_;  ///< Sequence numbers for each slot
 
@@ -171,6 +244,8 @@ private:
 
     std::atomic<size_t> frame_count_;    ///< Current number of frames in buffer
 
+    bool write_open_ = false;            ///< Slot reserved by BeginWrite()
+
     DmaRingBuffer::FrameCallback callback_;  ///< Frame-available callback
 
     mutable std::mutex mutex_;            ///< Protects shared state
@@ -183,7 +258,12 @@ private:
 // =============================================================================
 
 DmaRingBuffer::DmaRingBuffer(size_t depth, size_t frame_size, OverwritePolicy policy)
-    : impl_(std::make_unique<DmaRingBufferImpl>(depth, frame_size, policy)) {
+    : DmaRingBuffer(depth, frame_size, policy, infra::FramePool::Default()) {
+}
+
+DmaRingBuffer::DmaRingBuffer(size_t depth, size_t frame_size, OverwritePolicy policy,
+                             infra::FramePool& pool)
+    : impl_(std::make_unique<DmaRingBufferImpl>(depth, frame_size, policy, pool)) {
 }
 
 DmaRingBuffer::~DmaRingBuffer() = default;
@@ -203,8 +283,21 @@ bool DmaRingBuffer::WriteFrame(const void* data, size_t size, uint64_t& sequence
     return impl_->WriteFrame(data, size, sequence_out);
 }
 
-bool DmaRingBuffer::ReadFrame(void* buffer_out, size_t& size_out, uint64_t& sequence_out) {
-    return impl_->ReadFrame(buffer_out, size_out, sequence_out);
+uint8_t* DmaRingBuffer::BeginWrite() {
+    return impl_->BeginWrite();
+}
+
+bool DmaRingBuffer::CommitWrite(uint64_t& sequence_out) {
+    return impl_->CommitWrite(sequence_out);
+}
+
+void DmaRingBuffer::CancelWrite() {
+    impl_->CancelWrite();
+}
+
+bool DmaRingBuffer::ReadFrame(void* buffer_out, size_t buffer_size, size_t& size_out,
+                              uint64_t& sequence_out) {
+    return impl_->ReadFrame(buffer_out, buffer_size, size_out, sequence_out);
 }
 
 bool DmaRingBuffer::IsEmpty() const {
@@ -231,6 +324,10 @@ size_t DmaRingBuffer::GetFrameSize() const {
     return impl_->GetFrameSize();
 }
 
+size_t DmaRingBuffer::GetSlotStride() const {
+    return impl_->GetSlotStride();
+}
+
 OverwritePolicy DmaRingBuffer::GetOverwritePolicy() const {
     return impl_->GetOverwritePolicy();
 }
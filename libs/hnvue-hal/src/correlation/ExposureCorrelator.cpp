@@ -0,0 +1,438 @@
+/**
+ * @file ExposureCorrelator.cpp
+ * @brief Streaming join of generator, dose and AEC events onto detector frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Exposure metadata attached to acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "correlation/ExposureCorrelator.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace hnvue::hal {
+
+namespace {
+
+constexpr int64_t kNoEvent = std::numeric_limits<int64_t>::min();
+
+constexpr size_t kNoMatch = std::numeric_limits<size_t>::max();
+
+CorrelatorConfig Sanitize(CorrelatorConfig config) {
+    config.exposure_capacity = std::max<size_t>(config.exposure_capacity, 1);
+    config.frame_capacity = std::max<size_t>(config.frame_capacity, 1);
+    config.status_capacity = std::max<size_t>(config.status_capacity, 1);
+    config.dose_capacity = std::max<size_t>(config.dose_capacity, 1);
+    config.aec_capacity = std::max<size_t>(config.aec_capacity, 1);
+    config.frame_lead_us = std::max<int64_t>(config.frame_lead_us, 0);
+    config.frame_window_us = std::max<int64_t>(config.frame_window_us, 0);
+    config.dose_tail_us = std::max<int64_t>(config.dose_tail_us, 0);
+    config.aec_window_us = std::max<int64_t>(config.aec_window_us, 0);
+    config.max_push_latency_us = std::max<int64_t>(config.max_push_latency_us, 0);
+    config.max_delay_us = std::max<int64_t>(config.max_delay_us, 0);
+    return config;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor
+// =============================================================================
+
+ExposureCorrelator::ExposureCorrelator(const CorrelatorConfig& config)
+    : config_(Sanitize(config))
+    , exposures_(config_.exposure_capacity)
+    , frames_(config_.frame_capacity)
+    , status_(config_.status_capacity)
+    , dose_(config_.dose_capacity)
+    , aec_(config_.aec_capacity)
+    , newest_exposure_us_(kNoEvent)
+    , newest_status_us_(kNoEvent)
+    , newest_dose_us_(kNoEvent)
+    , newest_aec_us_(kNoEvent)
+    , newest_frame_us_(kNoEvent)
+{
+}
+
+bool ExposureCorrelator::RegisterRecordCallback(CorrelatedExposureCallback cb) {
+    if (!cb) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.push_back(std::move(cb));
+    return true;
+}
+
+CorrelatorStats ExposureCorrelator::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// =============================================================================
+// Event Streams
+// =============================================================================
+
+void ExposureCorrelator::PushExposure(const ExposureResult& result, int64_t start_us, int64_t end_us) {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (start_us < newest_exposure_us_) {
+        ++stats_.late_events;
+        return;
+    }
+    newest_exposure_us_ = start_us;
+
+    if (exposures_.Full()) {
+        if (!exposures_.Front().frame_matched) {
+            ++stats_.exposures_unmatched;
+        }
+        ++stats_.overflows;
+        exposures_.PopFront();
+    }
+
+    Exposure exposure;
+    exposure.result = result;
+    exposure.start_us = start_us;
+    exposure.end_us = std::max(start_us, end_us);
+    exposure.index = next_exposure_index_++;
+    exposures_.PushBack(exposure);
+    ++stats_.exposures;
+
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::PushStatus(const HvgStatus& status) {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (status.timestamp_us < newest_status_us_) {
+        ++stats_.late_events;
+        return;
+    }
+    newest_status_us_ = status.timestamp_us;
+
+    Prune(now_us);
+    if (status_.Full()) {
+        ++stats_.overflows;
+        status_.PopFront();
+    }
+    status_.PushBack(status);
+
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::PushDose(const DoseReading& reading) {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (reading.timestamp_us < newest_dose_us_) {
+        ++stats_.late_events;
+        return;
+    }
+    newest_dose_us_ = reading.timestamp_us;
+
+    Prune(now_us);
+    if (dose_.Full()) {
+        ++stats_.overflows;
+        dose_baseline_ = dose_.Front();
+        have_dose_baseline_ = true;
+        dose_.PopFront();
+    }
+    dose_.PushBack(reading);
+
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::PushAecTermination(const AecTerminationEvent& event, int64_t timestamp_us) {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (timestamp_us < newest_aec_us_) {
+        ++stats_.late_events;
+        return;
+    }
+    newest_aec_us_ = timestamp_us;
+
+    Prune(now_us);
+    if (aec_.Full()) {
+        ++stats_.overflows;
+        aec_.PopFront();
+    }
+    aec_.PushBack({timestamp_us, event});
+
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::PushFrame(const RawFrame& frame) {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    newest_frame_us_ = std::max(newest_frame_us_, frame.timestamp_us);
+
+    // A full queue releases its oldest frame with what is known
+    if (frames_.Full()) {
+        Drain(false, now_us);
+        if (frames_.Full()) {
+            EmitFront(true, now_us);
+        }
+    }
+    frames_.PushBack(FrameStamp{frame.sequence_number, frame.timestamp_us});
+
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::Poll() {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Drain(false, now_us);
+}
+
+void ExposureCorrelator::Flush() {
+    const int64_t now_us = infra::MonotonicClock::NowUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Drain(true, now_us);
+
+    // No frame can follow for the remaining exposures
+    while (!exposures_.Empty()) {
+        if (!exposures_.Front().frame_matched) {
+            ++stats_.exposures_unmatched;
+        }
+        exposures_.PopFront();
+    }
+    Prune(now_us);
+}
+
+// =============================================================================
+// Join
+// =============================================================================
+
+int64_t ExposureCorrelator::Watermark(int64_t newest_us, int64_t now_us) const {
+    return std::max(newest_us, now_us - config_.max_push_latency_us);
+}
+
+bool ExposureCorrelator::Covered(const Exposure& exposure, int64_t now_us) const {
+    if (config_.status_stream && Watermark(newest_status_us_, now_us) < exposure.end_us) {
+        return false;
+    }
+    if (config_.dose_stream &&
+        Watermark(newest_dose_us_, now_us) < exposure.end_us + config_.dose_tail_us) {
+        return false;
+    }
+    if (config_.aec_stream &&
+        Watermark(newest_aec_us_, now_us) < exposure.end_us + config_.aec_window_us) {
+        return false;
+    }
+    return true;
+}
+
+void ExposureCorrelator::Drain(bool force, int64_t now_us) {
+    while (!frames_.Empty()) {
+        const bool overdue = now_us - frames_.Front().timestamp_us > config_.max_delay_us;
+        if (!EmitFront(force || overdue, now_us)) {
+            break;
+        }
+    }
+
+    // Exposures no pending or future frame can match
+    int64_t frame_watermark = Watermark(newest_frame_us_, now_us);
+    if (!frames_.Empty()) {
+        frame_watermark = std::min(frame_watermark, frames_.Front().timestamp_us);
+    }
+    while (!exposures_.Empty() &&
+           exposures_.Front().end_us + config_.frame_window_us < frame_watermark) {
+        if (!exposures_.Front().frame_matched) {
+            ++stats_.exposures_unmatched;
+        }
+        exposures_.PopFront();
+    }
+
+    Prune(now_us);
+}
+
+bool ExposureCorrelator::EmitFront(bool forced, int64_t now_us) {
+    const FrameStamp frame = frames_.Front();
+    const int64_t t = frame.timestamp_us;
+
+    // A later exposure could still claim the frame until the exposure stream passes it
+    if (!forced && Watermark(newest_exposure_us_, now_us) < t + config_.frame_lead_us) {
+        return false;
+    }
+
+    // Latest exposure whose window holds the frame
+    size_t match = kNoMatch;
+    for (size_t i = 0; i < exposures_.Size(); ++i) {
+        const Exposure& exposure = exposures_.At(i);
+        if (exposure.start_us - config_.frame_lead_us > t) {
+            break;
+        }
+        if (t <= exposure.end_us + config_.frame_window_us) {
+            match = i;
+        }
+    }
+
+    CorrelatedExposure record;
+    if (match != kNoMatch) {
+        Exposure& exposure = exposures_.At(match);
+        if (!forced && !exposure.aggregated && !Covered(exposure, now_us)) {
+            return false;
+        }
+        AggregateThrough(match, now_us);
+        exposure.frame_matched = true;
+
+        record = exposure.summary;
+        record.matched = true;
+        record.frame_offset_us = t - exposure.end_us;
+        const bool first = stats_.frames == stats_.frames_unmatched;
+        stats_.min_frame_offset_us = first ? record.frame_offset_us
+                                           : std::min(stats_.min_frame_offset_us, record.frame_offset_us);
+        stats_.max_frame_offset_us = first ? record.frame_offset_us
+                                           : std::max(stats_.max_frame_offset_us, record.frame_offset_us);
+    } else {
+        // Unmatched, and certain of it unless forced out early
+        record.complete = !forced;
+        ++stats_.frames_unmatched;
+    }
+    record.frame_sequence = frame.sequence_number;
+    record.frame_timestamp_us = t;
+    if (!record.complete) {
+        ++stats_.frames_incomplete;
+    }
+
+    frames_.PopFront();
+    Emit(record);
+    return true;
+}
+
+void ExposureCorrelator::Prune(int64_t now_us) {
+    // Events before the next exposure to summarise (buffered or still to be
+    // pushed) belong to none
+    int64_t cutoff = Watermark(newest_exposure_us_, now_us);
+    for (size_t i = 0; i < exposures_.Size(); ++i) {
+        if (!exposures_.At(i).aggregated) {
+            cutoff = std::min(cutoff, exposures_.At(i).start_us);
+            break;
+        }
+    }
+
+    while (!status_.Empty() && status_.Front().timestamp_us < cutoff) {
+        status_.PopFront();
+    }
+    while (!dose_.Empty() && dose_.Front().timestamp_us < cutoff) {
+        dose_baseline_ = dose_.Front();
+        have_dose_baseline_ = true;
+        dose_.PopFront();
+    }
+    while (!aec_.Empty() && aec_.Front().first < cutoff) {
+        ++stats_.aec_unmatched;
+        aec_.PopFront();
+    }
+}
+
+void ExposureCorrelator::AggregateThrough(size_t i, int64_t now_us) {
+    for (size_t j = 0; j <= i; ++j) {
+        Exposure& exposure = exposures_.At(j);
+        if (!exposure.aggregated) {
+            Aggregate(exposure, now_us);
+        }
+    }
+}
+
+void ExposureCorrelator::Aggregate(Exposure& exposure, int64_t now_us) {
+    CorrelatedExposure& summary = exposure.summary;
+    summary.complete = Covered(exposure, now_us);
+    summary.exposure_index = exposure.index;
+    summary.exposure_start_us = exposure.start_us;
+    summary.exposure_end_us = exposure.end_us;
+    summary.result = exposure.result;
+
+    // Generator read-back while exposing
+    double kv_sum = 0.0;
+    double ma_sum = 0.0;
+    while (!status_.Empty() && status_.Front().timestamp_us < exposure.start_us) {
+        status_.PopFront();
+    }
+    while (!status_.Empty() && status_.Front().timestamp_us <= exposure.end_us) {
+        const HvgStatus& status = status_.Front();
+        if (status.state == GeneratorState::GEN_EXPOSING) {
+            kv_sum += status.actual_kvp;
+            ma_sum += status.actual_ma;
+            ++summary.status_samples;
+        }
+        status_.PopFront();
+    }
+
+    // Accumulated dose: last reading in the window against the last one before it
+    while (!dose_.Empty() && dose_.Front().timestamp_us < exposure.start_us) {
+        dose_baseline_ = dose_.Front();
+        have_dose_baseline_ = true;
+        dose_.PopFront();
+    }
+    DoseReading first;
+    DoseReading last;
+    while (!dose_.Empty() && dose_.Front().timestamp_us <= exposure.end_us + config_.dose_tail_us) {
+        if (summary.dose_samples == 0) {
+            first = dose_.Front();
+        }
+        last = dose_.Front();
+        ++summary.dose_samples;
+        dose_.PopFront();
+    }
+    if (summary.dose_samples > 0) {
+        const DoseReading& baseline = have_dose_baseline_ ? dose_baseline_ : first;
+        summary.dose_mgy = std::max(0.0f, last.dose_mgy - baseline.dose_mgy);
+        summary.dap_ugy_cm2 = std::max(0.0f, last.dap_ugy_cm2 - baseline.dap_ugy_cm2);
+        dose_baseline_ = last;
+        have_dose_baseline_ = true;
+    }
+
+    // First AEC termination in the window; any further one is unmatched
+    while (!aec_.Empty() && aec_.Front().first < exposure.start_us) {
+        ++stats_.aec_unmatched;
+        aec_.PopFront();
+    }
+    while (!aec_.Empty() && aec_.Front().first <= exposure.end_us + config_.aec_window_us) {
+        if (summary.aec_terminated) {
+            ++stats_.aec_unmatched;
+        } else {
+            const AecTerminationEvent& event = aec_.Front().second;
+            summary.aec_terminated = true;
+            summary.aec_dose_mgy = event.actual_dose_mgy;
+            summary.aec_exposure_time_us = event.exposure_time_us > 0
+                ? event.exposure_time_us
+                : aec_.Front().first - exposure.start_us;
+        }
+        aec_.PopFront();
+    }
+
+    if (summary.status_samples > 0) {
+        summary.kv_actual = static_cast<float>(kv_sum / summary.status_samples);
+        summary.ma_actual = static_cast<float>(ma_sum / summary.status_samples);
+    } else {
+        summary.kv_actual = exposure.result.actual_kvp;
+        summary.ma_actual = exposure.result.actual_ma;
+    }
+    if (summary.aec_terminated) {
+        summary.mas_actual = summary.ma_actual * static_cast<float>(summary.aec_exposure_time_us) / 1.0e6f;
+    } else if (summary.status_samples == 0 && exposure.result.actual_mas > 0.0f) {
+        summary.mas_actual = exposure.result.actual_mas;
+    } else {
+        summary.mas_actual = summary.ma_actual * exposure.result.actual_ms / 1000.0f;
+    }
+
+    exposure.aggregated = true;
+}
+
+void ExposureCorrelator::Emit(const CorrelatedExposure& record) {
+    ++stats_.frames;
+    for (const auto& callback : callbacks_) {
+        try {
+            callback(record);
+        } catch (const std::exception& e) {
+            spdlog::error("[ExposureCorrelator] Record callback exception: {}", e.what());
+        }
+    }
+}
+
+} // namespace hnvue::hal
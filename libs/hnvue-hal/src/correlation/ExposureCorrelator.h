@@ -0,0 +1,252 @@
+/**
+ * @file ExposureCorrelator.h
+ * @brief Streaming join of generator, dose and AEC events onto detector frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Exposure metadata attached to acquired frames
+ * SPDX-License-Identifier: MIT
+ *
+ * Five event streams, each in timestamp order (infra::MonotonicClock):
+ *
+ *   exposures   ExposureResult with start / end (caller-stamped)
+ *   status      HvgStatus (generator status thread)
+ *   dose        DoseReading (dose monitor)
+ *   AEC         AecTerminationEvent (caller-stamped)
+ *   frames      RawFrame (detector ingest)
+ *
+ * Each stream keeps a bounded ring. A stream's watermark is the later of
+ * its newest event and now - max_push_latency_us (producers deliver events
+ * within that bound). A frame is matched to the exposure whose
+ * [start - frame_lead_us, end + frame_window_us] contains it and emitted
+ * once every enabled stream's watermark has passed that exposure, or after
+ * max_delay_us with whatever has arrived. Exposures are aggregated once, in
+ * order, with forward-only cursors over the status, dose and AEC rings, so
+ * each event is visited once and a record costs O(1) amortised.
+ */
+
+#ifndef HNUE_HAL_EXPOSURE_CORRELATOR_H
+#define HNUE_HAL_EXPOSURE_CORRELATOR_H
+
+#include "hnvue/hal/HalTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Correlator windows and buffer sizes
+ *
+ * Capacities below 1 are raised to 1 and negative windows to 0.
+ */
+struct CorrelatorConfig {
+    size_t exposure_capacity = 64;
+    size_t frame_capacity = 64;
+    size_t status_capacity = 1024;
+    size_t dose_capacity = 8192;
+    size_t aec_capacity = 64;
+
+    int64_t frame_lead_us = 0;             ///< Frame may precede its exposure's start by this
+    int64_t frame_window_us = 500000;      ///< Frame may follow its exposure's end by this
+    int64_t dose_tail_us = 20000;          ///< Dose readings after the end still counted
+    int64_t aec_window_us = 5000;          ///< AEC termination reported after the end
+    int64_t max_push_latency_us = 100000;  ///< Event timestamp to Push*() bound (NFR-HAL-01)
+    int64_t max_delay_us = 1000000;        ///< Frame emitted incomplete after this
+
+    bool status_stream = true;             ///< false: no HvgStatus producer
+    bool dose_stream = true;               ///< false: no dose monitor
+    bool aec_stream = true;                ///< false: no AEC termination source
+};
+
+/**
+ * @brief One frame with the exposure it belongs to
+ */
+struct CorrelatedExposure {
+    int64_t frame_sequence = 0;            ///< RawFrame::sequence_number
+    int64_t frame_timestamp_us = 0;
+    bool matched = false;                  ///< false: no exposure in the window (dark frame or timing fault)
+    bool complete = false;                 ///< Every enabled stream covered the exposure
+
+    uint64_t exposure_index = 0;           ///< Exposures pushed before this one
+    int64_t exposure_start_us = 0;
+    int64_t exposure_end_us = 0;
+    int64_t frame_offset_us = 0;           ///< frame_timestamp_us - exposure_end_us
+    ExposureResult result;
+
+    float kv_actual = 0.0f;                ///< Mean over EXPOSING status samples, else result
+    float ma_actual = 0.0f;
+    float mas_actual = 0.0f;               ///< ma_actual x exposure time (AEC-terminated time if any)
+    uint32_t status_samples = 0;
+
+    float dose_mgy = 0.0f;                 ///< Accumulated dose increase over the exposure
+    float dap_ugy_cm2 = 0.0f;
+    uint32_t dose_samples = 0;
+
+    bool aec_terminated = false;
+    float aec_dose_mgy = 0.0f;
+    int64_t aec_exposure_time_us = 0;
+};
+
+/// Record callback; invoked on the thread whose Push*() or Poll() completed the record
+using CorrelatedExposureCallback = std::function<void(const CorrelatedExposure&)>;
+
+/**
+ * @brief Unmatched-event and timing counters
+ */
+struct CorrelatorStats {
+    uint64_t frames = 0;                   ///< Records emitted
+    uint64_t frames_unmatched = 0;
+    uint64_t frames_incomplete = 0;        ///< Emitted after max_delay_us, on overflow or by Flush()
+    uint64_t exposures = 0;
+    uint64_t exposures_unmatched = 0;      ///< Left the window without a frame
+    uint64_t aec_unmatched = 0;            ///< Terminations outside every exposure
+    uint64_t late_events = 0;              ///< Older than their stream's newest event; dropped
+    uint64_t overflows = 0;                ///< Events still needed, dropped from a full ring
+    int64_t min_frame_offset_us = 0;       ///< Over matched frames
+    int64_t max_frame_offset_us = 0;
+};
+
+/**
+ * @brief Generator / detector event correlator
+ *
+ * Thread Safety: all methods are thread-safe. Callbacks run under the
+ * correlator lock and must not call back into it.
+ */
+class ExposureCorrelator {
+public:
+    explicit ExposureCorrelator(const CorrelatorConfig& config = CorrelatorConfig{});
+
+    ExposureCorrelator(const ExposureCorrelator&) = delete;
+    ExposureCorrelator& operator=(const ExposureCorrelator&) = delete;
+
+    /**
+     * @brief Register a record consumer (image metadata, dose report)
+     * @return false if cb is empty
+     */
+    bool RegisterRecordCallback(CorrelatedExposureCallback cb);
+
+    /**
+     * @brief An exposure ran from start_us to end_us
+     */
+    void PushExposure(const ExposureResult& result, int64_t start_us, int64_t end_us);
+
+    void PushStatus(const HvgStatus& status);
+    void PushDose(const DoseReading& reading);
+
+    /**
+     * @brief AEC terminated an exposure at timestamp_us
+     */
+    void PushAecTermination(const AecTerminationEvent& event, int64_t timestamp_us);
+
+    void PushFrame(const RawFrame& frame);
+
+    /**
+     * @brief Emit frames completed by the passage of time (no new events)
+     */
+    void Poll();
+
+    /**
+     * @brief Emit every pending frame with what has arrived (end of study)
+     */
+    void Flush();
+
+    CorrelatorStats GetStats() const;
+
+private:
+    /// Fixed-capacity FIFO; the storage is allocated once
+    template <typename T>
+    class Ring {
+    public:
+        explicit Ring(size_t capacity) : items_(capacity) {}
+        bool Empty() const { return count_ == 0; }
+        bool Full() const { return count_ == items_.size(); }
+        size_t Size() const { return count_; }
+        T& Front() { return items_[head_]; }
+        T& At(size_t i) { return items_[(head_ + i) % items_.size()]; }
+        void PopFront() { head_ = (head_ + 1) % items_.size(); --count_; }
+        void PushBack(const T& item) { items_[(head_ + count_) % items_.size()] = item; ++count_; }
+
+    private:
+        std::vector<T> items_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+    };
+
+    struct Exposure {
+        ExposureResult result;
+        int64_t start_us = 0;
+        int64_t end_us = 0;
+        uint64_t index = 0;
+        bool aggregated = false;
+        bool frame_matched = false;
+        CorrelatedExposure summary;        ///< Exposure fields, filled by Aggregate
+    };
+
+    struct FrameStamp {
+        int64_t sequence_number;
+        int64_t timestamp_us;
+    };
+
+    /// Watermark of a stream with newest event newest_us
+    int64_t Watermark(int64_t newest_us, int64_t now_us) const;
+
+    /// Every enabled stream has passed the exposure's horizon
+    bool Covered(const Exposure& exposure, int64_t now_us) const;
+
+    /**
+     * @brief Emit ready frames, then release events no exposure can use
+     * @param force Emit every pending frame
+     */
+    void Drain(bool force, int64_t now_us);
+
+    /**
+     * @brief Emit the oldest pending frame
+     * @return false if it is not ready and forced is false
+     */
+    bool EmitFront(bool forced, int64_t now_us);
+
+    /**
+     * @brief Drop status, dose and AEC events older than any exposure still to summarise
+     */
+    void Prune(int64_t now_us);
+
+    /**
+     * @brief Summarise exposures_[0 .. i] not yet summarised, in order
+     */
+    void AggregateThrough(size_t i, int64_t now_us);
+    void Aggregate(Exposure& exposure, int64_t now_us);
+
+    void Emit(const CorrelatedExposure& record);
+
+    CorrelatorConfig config_;
+    std::vector<CorrelatedExposureCallback> callbacks_;
+    mutable std::mutex mutex_;
+
+    Ring<Exposure> exposures_;
+    Ring<FrameStamp> frames_;
+    Ring<HvgStatus> status_;
+    Ring<DoseReading> dose_;
+    Ring<std::pair<int64_t, AecTerminationEvent>> aec_;
+
+    // Newest event per stream
+    int64_t newest_exposure_us_;
+    int64_t newest_status_us_;
+    int64_t newest_dose_us_;
+    int64_t newest_aec_us_;
+    int64_t newest_frame_us_;
+
+    uint64_t next_exposure_index_ = 0;
+    bool have_dose_baseline_ = false;
+    DoseReading dose_baseline_;            ///< Last reading before the next exposure
+
+    CorrelatorStats stats_;
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_EXPOSURE_CORRELATOR_H
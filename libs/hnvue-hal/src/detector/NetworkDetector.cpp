@@ -0,0 +1,509 @@
+/**
+ * @file NetworkDetector.cpp
+ * @brief IDetector over a networked detector serving detector_acquisition.proto
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "detector/NetworkDetector.h"
+#include "detector/RawFrameWire.h"
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
+
+#include "detector_acquisition.grpc.pb.h"
+#include "detector_acquisition.pb.h"
+
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/grpcpp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+namespace pb = hnvue::hal::detector;
+
+namespace {
+
+// StreamFrames is read through the generic stub so frames arrive as raw
+// ByteBuffers and are decoded straight into ring slots (RawFrameWire)
+constexpr const char* kMethodStreamFrames = "/hnvue.hal.detector.DetectorAcquisition/StreamFrames";
+
+// TCP read chunk sizes: large frames arrive in few, large slices
+constexpr int kTcpReadChunkBytes = 1024 * 1024;
+constexpr int kTcpMinReadChunkBytes = 256 * 1024;
+constexpr int kTcpMaxReadChunkBytes = 4 * 1024 * 1024;
+
+/**
+ * @brief Set the deadline (and wait-for-ready) of a control RPC
+ */
+void PrepareContext(grpc::ClientContext& context, uint32_t timeout_ms, bool wait_for_ready = false) {
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms));
+    context.set_wait_for_ready(wait_for_ready);
+}
+
+/**
+ * @brief Run one completion-queue operation and wait for it
+ * @return false if the operation failed (stream ended, call cancelled)
+ */
+template <class Start>
+bool Await(grpc::CompletionQueue& cq, Start start) {
+    start(&cq);
+    void* tag = nullptr;
+    bool ok = false;
+    return cq.Next(&tag, &ok) && ok;
+}
+
+pb::AcquisitionConfig ToProto(const AcquisitionConfig& cfg) {
+    pb::AcquisitionConfig out;
+    out.set_mode(static_cast<pb::AcquisitionMode>(cfg.mode));
+    out.set_num_frames(cfg.num_frames);
+    out.set_frame_rate(cfg.frame_rate);
+    out.set_binning(cfg.binning);
+    out.set_session_id(cfg.session_id);
+    return out;
+}
+
+/**
+ * @brief Pixel destination: a reserved ring slot of the expected size
+ */
+class RingSlotSink : public detwire::PixelSink {
+public:
+    RingSlotSink(DmaRingBuffer& ring, size_t frame_bytes)
+        : ring_(ring), frame_bytes_(frame_bytes) {}
+
+    uint8_t* PixelDestination(size_t pixel_bytes) override {
+        if (pixel_bytes != frame_bytes_ || slot != nullptr) {
+            return nullptr;
+        }
+        slot = ring_.BeginWrite();
+        return slot;
+    }
+
+    uint8_t* slot = nullptr;
+
+private:
+    DmaRingBuffer& ring_;
+    size_t frame_bytes_;
+};
+
+} // anonymous namespace
+
+struct NetworkDetector::Stubs {
+    explicit Stubs(std::shared_ptr<grpc::Channel> ch)
+        : channel(std::move(ch)),
+          control(pb::DetectorAcquisition::NewStub(channel)),
+          frames(channel) {}
+
+    std::shared_ptr<grpc::Channel> channel;
+    std::unique_ptr<pb::DetectorAcquisition::Stub> control;  ///< Unary RPCs
+    grpc::GenericStub frames;                                ///< StreamFrames as ByteBuffers
+};
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+NetworkDetector::NetworkDetector(const NetworkDetectorConfig& config)
+    : config_(config) {
+}
+
+NetworkDetector::~NetworkDetector() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    StopThreads();
+}
+
+bool NetworkDetector::Connect() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (ingest_thread_.joinable()) {
+        spdlog::warn("[NetworkDetector] Cannot reconnect during acquisition");
+        return false;
+    }
+
+    int max_message = static_cast<int>(std::min<size_t>(config_.max_message_bytes, INT_MAX));
+    grpc::ChannelArguments args;
+    args.SetMaxReceiveMessageSize(max_message);
+    // Let a whole frame be in flight without waiting for window updates
+    args.SetInt(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES, max_message);
+    args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 1);
+    args.SetInt(GRPC_ARG_TCP_READ_CHUNK_SIZE, kTcpReadChunkBytes);
+    args.SetInt(GRPC_ARG_TCP_MIN_READ_CHUNK_SIZE, kTcpMinReadChunkBytes);
+    args.SetInt(GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE, kTcpMaxReadChunkBytes);
+    stubs_ = std::make_unique<Stubs>(
+        grpc::CreateCustomChannel(config_.endpoint, grpc::InsecureChannelCredentials(), args));
+
+    pb::Empty request;
+    pb::DetectorInfo reply;
+    grpc::ClientContext context;
+    PrepareContext(context, config_.rpc_timeout_ms, true);
+    grpc::Status status = stubs_->control->GetDetectorInfo(&context, request, &reply);
+    if (!status.ok()) {
+        spdlog::error("[NetworkDetector] GetDetectorInfo failed on {}: {}",
+                      config_.endpoint, status.error_message());
+        stubs_.reset();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> info_lock(info_mutex_);
+    info_.vendor = reply.vendor();
+    info_.model = reply.model();
+    info_.serial_number = reply.serial_number();
+    info_.pixel_width = reply.pixel_width();
+    info_.pixel_height = reply.pixel_height();
+    info_.pixel_pitch_um = reply.pixel_pitch_um();
+    info_.max_bit_depth = reply.max_bit_depth();
+    info_.max_frame_rate = reply.max_frame_rate();
+    info_.firmware_version = reply.firmware_version();
+    spdlog::info("[NetworkDetector] Connected: {} {} {}x{} @ {} bit ({})",
+                 info_.vendor, info_.model, info_.pixel_width, info_.pixel_height,
+                 info_.max_bit_depth, config_.endpoint);
+    return true;
+}
+
+NetworkDetectorStats NetworkDetector::GetStats() const {
+    NetworkDetectorStats stats;
+    stats.frames_received = frames_received_.load(std::memory_order_relaxed);
+    stats.frames_delivered = frames_delivered_.load(std::memory_order_relaxed);
+    stats.frames_rejected = frames_rejected_.load(std::memory_order_relaxed);
+    stats.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+    uint64_t committed = frames_committed_.load(std::memory_order_relaxed);
+    uint64_t buffered = 0;
+    {
+        std::lock_guard<std::mutex> lock(info_mutex_);
+        buffered = ring_ ? ring_->GetAvailableFrameCount() : 0;
+    }
+    if (committed > stats.frames_delivered + buffered) {
+        stats.frames_overwritten = committed - stats.frames_delivered - buffered;
+    }
+    return stats;
+}
+
+// =============================================================================
+// IDetector Interface Implementation
+// =============================================================================
+
+DetectorInfo NetworkDetector::GetDetectorInfo() {
+    std::lock_guard<std::mutex> lock(info_mutex_);
+    return info_;
+}
+
+DetectorStatus NetworkDetector::GetStatus() {
+    std::lock_guard<std::mutex> lock(info_mutex_);
+    return status_;
+}
+
+bool NetworkDetector::StartAcquisition(const AcquisitionConfig& cfg) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (!stubs_) {
+        spdlog::warn("[NetworkDetector] Cannot start acquisition: not connected");
+        return false;
+    }
+
+    DetectorInfo info;
+    {
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        if (status_.is_acquiring) {
+            spdlog::warn("[NetworkDetector] Acquisition already active ({})", status_.current_session_id);
+            return false;
+        }
+        info = info_;
+    }
+
+    // Reap the threads of a stream that ended on its own
+    StopThreads();
+
+    int32_t binning = cfg.binning;
+    if (binning != 1 && binning != 2 && binning != 4) {
+        spdlog::warn("[NetworkDetector] Unsupported binning {}", binning);
+        return false;
+    }
+    size_t bytes_per_pixel = static_cast<size_t>((std::max(info.max_bit_depth, 8) + 7) / 8);
+    size_t frame_bytes = static_cast<size_t>(info.pixel_width / binning) *
+                         static_cast<size_t>(info.pixel_height / binning) * bytes_per_pixel;
+    if (frame_bytes == 0 || frame_bytes > config_.max_message_bytes) {
+        spdlog::warn("[NetworkDetector] Frame size {} bytes outside 1..{}", frame_bytes,
+                     config_.max_message_bytes);
+        return false;
+    }
+
+    pb::AcquisitionConfig request = ToProto(cfg);
+    pb::DetectorResponse reply;
+    grpc::ClientContext context;
+    PrepareContext(context, config_.rpc_timeout_ms);
+    grpc::Status status = stubs_->control->StartAcquisition(&context, request, &reply);
+    if (!status.ok() || !reply.success()) {
+        spdlog::error("[NetworkDetector] StartAcquisition failed: {}",
+                      status.ok() ? reply.error_msg() : status.error_message());
+        return false;
+    }
+
+    // Slots hold the pixels followed by the frame's SlotTrailer
+    size_t slot_bytes = frame_bytes + sizeof(SlotTrailer);
+    if (!ring_ || ring_->GetFrameSize() != slot_bytes) {
+        auto ring = std::make_unique<DmaRingBuffer>(config_.ring_depth, slot_bytes, config_.ring_policy);
+        ring->RegisterFrameCallback([this](const void*, size_t, uint64_t) {
+            {
+                std::lock_guard<std::mutex> delivery_lock(delivery_mutex_);
+                frames_ready_ = true;
+            }
+            delivery_cv_.notify_one();
+        });
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        ring_ = std::move(ring);
+    }
+    frame_bytes_ = frame_bytes;
+    delivery_frame_.session_id = cfg.session_id;
+    delivery_frame_.pixel_data.reserve(slot_bytes);
+    {
+        std::lock_guard<std::mutex> delivery_lock(delivery_mutex_);
+        delivery_stop_ = false;
+        ingest_done_ = false;
+        frames_ready_ = false;
+    }
+    {
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        status_.is_acquiring = true;
+        status_.current_session_id = cfg.session_id;
+        status_.frames_acquired = 0;
+    }
+
+    stream_context_ = std::make_shared<grpc::ClientContext>();
+    delivery_thread_ = std::thread(&NetworkDetector::DeliveryLoop, this);
+    ingest_thread_ = std::thread(&NetworkDetector::IngestLoop, this, stream_context_, cfg);
+
+    spdlog::info("[NetworkDetector] Acquisition started: session={}, {} bytes/frame, binning {}",
+                 cfg.session_id, frame_bytes, binning);
+    return true;
+}
+
+bool NetworkDetector::StopAcquisition() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    std::string session_id;
+    {
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        session_id = status_.current_session_id;
+    }
+
+    bool was_running = ingest_thread_.joinable() || delivery_thread_.joinable();
+    StopThreads();
+    {
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        status_.is_acquiring = false;
+    }
+    if (!was_running || !stubs_) {
+        return true;
+    }
+
+    pb::StopRequest request;
+    request.set_session_id(session_id);
+    request.set_reason("host stop");
+    pb::DetectorResponse reply;
+    grpc::ClientContext context;
+    PrepareContext(context, config_.rpc_timeout_ms);
+    grpc::Status status = stubs_->control->StopAcquisition(&context, request, &reply);
+    if (!status.ok() || !reply.success()) {
+        spdlog::warn("[NetworkDetector] StopAcquisition not confirmed: {}",
+                     status.ok() ? reply.error_msg() : status.error_message());
+        return false;
+    }
+    spdlog::info("[NetworkDetector] Acquisition stopped: session={}", session_id);
+    return true;
+}
+
+CalibrationResult NetworkDetector::RunCalibration(CalibType type, int32_t num_frames) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    CalibrationResult result;
+    if (!stubs_) {
+        result.error_msg = "Detector not connected";
+        return result;
+    }
+    {
+        std::lock_guard<std::mutex> info_lock(info_mutex_);
+        if (status_.is_acquiring) {
+            result.error_msg = "Acquisition active";
+            return result;
+        }
+    }
+
+    pb::CalibrationType request;
+    request.set_type(static_cast<pb::CalibType>(type));
+    request.set_num_frames(num_frames);
+    pb::CalibrationResult reply;
+    grpc::ClientContext context;
+    PrepareContext(context, config_.calibration_timeout_ms);
+    grpc::Status status = stubs_->control->RunCalibration(&context, request, &reply);
+    if (!status.ok()) {
+        result.error_msg = status.error_message();
+        return result;
+    }
+    result.success = reply.success();
+    result.output_path = reply.output_path();
+    result.error_msg = reply.error_msg();
+    return result;
+}
+
+void NetworkDetector::RegisterFrameCallback(FrameCallback cb) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    callbacks_.push_back(std::move(cb));
+}
+
+// =============================================================================
+// Ingestion / Delivery
+// =============================================================================
+
+void NetworkDetector::StopThreads() {
+    if (stream_context_) {
+        stream_context_->TryCancel();
+    }
+    if (ingest_thread_.joinable()) {
+        ingest_thread_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(delivery_mutex_);
+        delivery_stop_ = true;
+    }
+    delivery_cv_.notify_one();
+    if (delivery_thread_.joinable()) {
+        delivery_thread_.join();
+    }
+    stream_context_.reset();
+}
+
+void NetworkDetector::IngestLoop(std::shared_ptr<grpc::ClientContext> context, AcquisitionConfig cfg) {
+    infra::ApplyNamedThreadPolicy(kThreadDetectorIngest);
+
+    grpc::Slice request_slice(ToProto(cfg).SerializeAsString());
+    grpc::ByteBuffer request(&request_slice, 1);
+
+    // One operation in flight at a time; this thread waits on each
+    grpc::CompletionQueue cq;
+    std::unique_ptr<grpc::GenericClientAsyncReaderWriter> call =
+        stubs_->frames.PrepareCall(context.get(), kMethodStreamFrames, &cq);
+    bool streaming =
+        Await(cq, [&](void* tag) { call->StartCall(tag); }) &&
+        Await(cq, [&](void* tag) { call->WriteLast(request, grpc::WriteOptions(), tag); });
+
+    // Reused across frames: Dump() takes slice references, no pixel copy
+    grpc::ByteBuffer message;
+    std::vector<grpc::Slice> slices;
+    std::vector<detwire::WireChunk> chunks;
+    detwire::RawFrameHeader header;
+
+    while (streaming && Await(cq, [&](void* tag) { call->Read(&message, tag); })) {
+        frames_received_.fetch_add(1, std::memory_order_relaxed);
+        bytes_received_.fetch_add(message.Length(), std::memory_order_relaxed);
+
+        if (!message.Dump(&slices).ok()) {
+            frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        chunks.clear();
+        for (const grpc::Slice& slice : slices) {
+            chunks.push_back({slice.begin(), slice.size()});
+        }
+
+        RingSlotSink sink(*ring_, frame_bytes_);
+        bool decoded = detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink);
+        if (!decoded || !header.pixels_copied) {
+            if (sink.slot != nullptr) {
+                ring_->CancelWrite();
+            }
+            frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+            spdlog::debug("[NetworkDetector] Frame {} rejected: {} pixel bytes, expected {}",
+                          header.sequence_number, header.pixel_bytes, frame_bytes_);
+            continue;
+        }
+
+        SlotTrailer trailer;
+        trailer.sequence_number = header.sequence_number;
+        trailer.timestamp_us = infra::MonotonicClock::NowUs();
+        trailer.width = header.width;
+        trailer.height = header.height;
+        trailer.bit_depth = header.bit_depth;
+        std::memcpy(sink.slot + frame_bytes_, &trailer, sizeof(trailer));
+
+        uint64_t ring_sequence = 0;
+        ring_->CommitWrite(ring_sequence);
+        frames_committed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    grpc::Status status;
+    Await(cq, [&](void* tag) { call->Finish(&status, tag); });
+    cq.Shutdown();
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq.Next(&tag, &ok)) {
+    }
+    if (!status.ok() && status.error_code() != grpc::StatusCode::CANCELLED) {
+        spdlog::error("[NetworkDetector] Frame stream ended: {}", status.error_message());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(delivery_mutex_);
+        ingest_done_ = true;
+    }
+    delivery_cv_.notify_one();
+}
+
+void NetworkDetector::DeliveryLoop() {
+    size_t slot_bytes = ring_->GetFrameSize();
+    RawFrame& frame = delivery_frame_;
+
+    while (true) {
+        frame.pixel_data.resize(slot_bytes);
+        size_t size = 0;
+        uint64_t ring_sequence = 0;
+        if (ring_->ReadFrame(frame.pixel_data.data(), slot_bytes, size, ring_sequence)) {
+            SlotTrailer trailer;
+            std::memcpy(&trailer, frame.pixel_data.data() + frame_bytes_, sizeof(trailer));
+            frame.pixel_data.resize(frame_bytes_);  // Shrink: keeps capacity
+            frame.sequence_number = trailer.sequence_number;
+            frame.timestamp_us = trailer.timestamp_us;
+            frame.width = trailer.width;
+            frame.height = trailer.height;
+            frame.bit_depth = trailer.bit_depth;
+            Deliver(frame);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(delivery_mutex_);
+        if (delivery_stop_) {
+            break;
+        }
+        if (ingest_done_ && !frames_ready_) {
+            // Stream ended and the ring is drained
+            lock.unlock();
+            std::lock_guard<std::mutex> info_lock(info_mutex_);
+            status_.is_acquiring = false;
+            break;
+        }
+        delivery_cv_.wait(lock, [this]() { return delivery_stop_ || ingest_done_ || frames_ready_; });
+        frames_ready_ = false;
+    }
+}
+
+void NetworkDetector::Deliver(const RawFrame& frame) {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        for (const auto& callback : callbacks_) {
+            try {
+                callback(frame);
+            } catch (const std::exception& e) {
+                spdlog::error("[NetworkDetector] Frame callback threw: {}", e.what());
+            } catch (...) {
+                spdlog::error("[NetworkDetector] Frame callback threw");
+            }
+        }
+    }
+    frames_delivered_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(info_mutex_);
+    ++status_.frames_acquired;
+}
+
+} // namespace hnvue::hal
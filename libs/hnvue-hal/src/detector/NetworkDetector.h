@@ -0,0 +1,159 @@
+/**
+ * @file NetworkDetector.h
+ * @brief IDetector over a networked detector serving detector_acquisition.proto
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_HAL_NETWORK_DETECTOR_H
+#define HNUE_HAL_NETWORK_DETECTOR_H
+
+#include "hnvue/hal/DmaRingBuffer.h"
+#include "hnvue/hal/IDetector.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace grpc {
+class ClientContext;
+} // namespace grpc
+
+namespace hnvue::hal {
+
+/**
+ * @brief Network detector configuration
+ */
+struct NetworkDetectorConfig {
+    std::string endpoint = "localhost:50061";   ///< host:port of the DetectorAcquisition service
+    uint32_t rpc_timeout_ms = 2000;             ///< Deadline of unary RPCs
+    uint32_t calibration_timeout_ms = 60000;    ///< Deadline of RunCalibration
+    size_t ring_depth = 8;                      ///< Frames buffered between ingestion and delivery
+    OverwritePolicy ring_policy = OverwritePolicy::DROP_OLDEST;
+    size_t max_message_bytes = 64 * 1024 * 1024; ///< Largest accepted RawFrame
+};
+
+/**
+ * @brief Frame counters
+ */
+struct NetworkDetectorStats {
+    uint64_t frames_received = 0;    ///< RawFrame messages read from the stream
+    uint64_t frames_delivered = 0;   ///< Frames passed to frame callbacks
+    uint64_t frames_rejected = 0;    ///< Malformed or wrong pixel_data size
+    uint64_t frames_overwritten = 0; ///< Dropped by the ring (DROP_OLDEST, slow callbacks)
+    uint64_t bytes_received = 0;     ///< Serialized RawFrame bytes
+};
+
+/**
+ * @brief Detector reached over gRPC (DetectorAcquisition service)
+ *
+ * StreamFrames is read as raw ByteBuffers on an ingestion thread
+ * (kThreadDetectorIngest). Each message is decoded over its received
+ * slices and pixel_data is copied once, straight into a reserved
+ * DmaRingBuffer slot; no protobuf message or intermediate string is built.
+ * A delivery thread drains the ring into a pooled RawFrame and invokes the
+ * frame callbacks, so slow consumers never stall the network reader.
+ *
+ * The channel is tuned for large messages: the receive limit is raised to
+ * max_message_bytes and the HTTP/2 stream window and TCP read chunks are
+ * sized to a whole frame, so a frame is not throttled by window updates.
+ *
+ * RawFrame::timestamp_us is the local arrival time (infra::MonotonicClock);
+ * sequence_number is the detector's.
+ */
+class NetworkDetector : public IDetector {
+public:
+    explicit NetworkDetector(const NetworkDetectorConfig& config);
+    ~NetworkDetector() override;
+
+    // Non-copyable, non-movable (threads capture this)
+    NetworkDetector(const NetworkDetector&) = delete;
+    NetworkDetector& operator=(const NetworkDetector&) = delete;
+
+    /**
+     * @brief Create the channel and read the detector information
+     * @return false if the detector does not answer GetDetectorInfo or an
+     *         acquisition is active
+     */
+    bool Connect();
+
+    NetworkDetectorStats GetStats() const;
+
+    // =========================================================================
+    // IDetector Interface Implementation
+    // =========================================================================
+
+    DetectorInfo GetDetectorInfo() override;
+    DetectorStatus GetStatus() override;
+    bool StartAcquisition(const AcquisitionConfig& cfg) override;
+    bool StopAcquisition() override;
+    CalibrationResult RunCalibration(CalibType type, int32_t num_frames) override;
+    void RegisterFrameCallback(FrameCallback cb) override;
+
+private:
+    /// Per-frame fields carried in the ring slot after the pixels
+    struct SlotTrailer {
+        int64_t sequence_number;
+        int64_t timestamp_us;
+        int32_t width;
+        int32_t height;
+        int32_t bit_depth;
+    };
+
+    void IngestLoop(std::shared_ptr<grpc::ClientContext> context, AcquisitionConfig cfg);
+    void DeliveryLoop();
+    void Deliver(const RawFrame& frame);
+
+    /// Stop both threads; the caller holds control_mutex_
+    void StopThreads();
+
+    /// Channel with the generated DetectorAcquisition stub (defined in the .cpp)
+    struct Stubs;
+
+    NetworkDetectorConfig config_;
+    std::unique_ptr<Stubs> stubs_;     ///< Set by Connect(); null while disconnected
+
+    // Serializes Start/Stop/RunCalibration
+    std::mutex control_mutex_;
+
+    mutable std::mutex info_mutex_;
+    DetectorInfo info_;
+    DetectorStatus status_;
+
+    // Ring geometry is fixed per acquisition: pixels + SlotTrailer.
+    // Replaced only while no acquisition runs, under info_mutex_.
+    std::unique_ptr<DmaRingBuffer> ring_;
+    size_t frame_bytes_ = 0;
+
+    std::thread ingest_thread_;
+    std::shared_ptr<grpc::ClientContext> stream_context_;
+
+    std::thread delivery_thread_;
+    std::mutex delivery_mutex_;
+    std::condition_variable delivery_cv_;
+    bool delivery_stop_ = false;    ///< Guarded by delivery_mutex_
+    bool ingest_done_ = false;      ///< Guarded by delivery_mutex_
+    bool frames_ready_ = false;     ///< Guarded by delivery_mutex_; set on ring commit
+    RawFrame delivery_frame_;       ///< Delivery thread only; reused
+
+    std::mutex callback_mutex_;
+    std::vector<FrameCallback> callbacks_;
+
+    std::atomic<uint64_t> frames_received_{0};
+    std::atomic<uint64_t> frames_delivered_{0};
+    std::atomic<uint64_t> frames_rejected_{0};
+    std::atomic<uint64_t> frames_committed_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_NETWORK_DETECTOR_H
@@ -0,0 +1,181 @@
+/**
+ * @file RawFrameWire.cpp
+ * @brief Slice-level decoder for detector_acquisition.proto RawFrame messages
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "detector/RawFrameWire.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hnvue::hal::detwire {
+
+namespace {
+
+// RawFrame field numbers (detector_acquisition.proto)
+constexpr uint32_t kFieldSequenceNumber = 1;
+constexpr uint32_t kFieldTimestampUs = 2;
+constexpr uint32_t kFieldWidth = 3;
+constexpr uint32_t kFieldHeight = 4;
+constexpr uint32_t kFieldBitDepth = 5;
+constexpr uint32_t kFieldPixelData = 6;
+constexpr uint32_t kFieldSessionId = 7;
+
+/// Upper bound on session_id, so a corrupt length cannot force a large allocation
+constexpr uint64_t kMaxSessionIdBytes = 1024;
+
+// Wire types
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLength = 2;
+constexpr uint32_t kWireFixed32 = 5;
+
+/**
+ * @brief Forward-only reader over a chunk list
+ */
+class ChunkCursor {
+public:
+    ChunkCursor(const WireChunk* chunks, size_t count)
+        : chunks_(chunks), count_(count) {
+        SkipEmpty();
+    }
+
+    bool AtEnd() const { return index_ >= count_; }
+
+    bool ReadByte(uint8_t& value) {
+        if (AtEnd()) {
+            return false;
+        }
+        value = chunks_[index_].data[offset_];
+        Advance(1);
+        return true;
+    }
+
+    bool ReadVarint(uint64_t& value) {
+        value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!ReadByte(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;  // More than 10 bytes
+    }
+
+    /// Copy length bytes to dest (nullptr: skip them)
+    bool Copy(uint8_t* dest, size_t length) {
+        while (length > 0) {
+            if (AtEnd()) {
+                return false;
+            }
+            const WireChunk& chunk = chunks_[index_];
+            size_t take = std::min(length, chunk.size - offset_);
+            if (dest != nullptr) {
+                std::memcpy(dest, chunk.data + offset_, take);
+                dest += take;
+            }
+            Advance(take);
+            length -= take;
+        }
+        return true;
+    }
+
+private:
+    void Advance(size_t n) {
+        offset_ += n;
+        if (offset_ == chunks_[index_].size) {
+            ++index_;
+            offset_ = 0;
+            SkipEmpty();
+        }
+    }
+
+    void SkipEmpty() {
+        while (index_ < count_ && chunks_[index_].size == 0) {
+            ++index_;
+        }
+    }
+
+    const WireChunk* chunks_;
+    size_t count_;
+    size_t index_ = 0;
+    size_t offset_ = 0;
+};
+
+} // anonymous namespace
+
+bool DecodeRawFrame(const WireChunk* chunks, size_t count, RawFrameHeader& header,
+                    PixelSink& sink) {
+    header = RawFrameHeader();
+    ChunkCursor cursor(chunks, count);
+
+    while (!cursor.AtEnd()) {
+        uint64_t tag = 0;
+        if (!cursor.ReadVarint(tag)) {
+            return false;
+        }
+        uint32_t field = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+
+        if (wire_type == kWireVarint) {
+            uint64_t value = 0;
+            if (!cursor.ReadVarint(value)) {
+                return false;
+            }
+            switch (field) {
+                case kFieldSequenceNumber: header.sequence_number = static_cast<int64_t>(value); break;
+                case kFieldTimestampUs: header.timestamp_us = static_cast<int64_t>(value); break;
+                case kFieldWidth: header.width = static_cast<int32_t>(value); break;
+                case kFieldHeight: header.height = static_cast<int32_t>(value); break;
+                case kFieldBitDepth: header.bit_depth = static_cast<int32_t>(value); break;
+                default: break;
+            }
+        } else if (wire_type == kWireLength) {
+            uint64_t length = 0;
+            if (!cursor.ReadVarint(length)) {
+                return false;
+            }
+            if (field == kFieldPixelData) {
+                header.pixel_bytes = static_cast<size_t>(length);
+                uint8_t* dest = sink.PixelDestination(header.pixel_bytes);
+                if (!cursor.Copy(dest, header.pixel_bytes)) {
+                    return false;
+                }
+                header.pixels_copied = dest != nullptr;
+            } else if (field == kFieldSessionId) {
+                if (length > kMaxSessionIdBytes) {
+                    return false;
+                }
+                header.session_id.resize(static_cast<size_t>(length));
+                if (!cursor.Copy(reinterpret_cast<uint8_t*>(header.session_id.data()),
+                                 header.session_id.size())) {
+                    return false;
+                }
+            } else if (!cursor.Copy(nullptr, static_cast<size_t>(length))) {
+                return false;
+            }
+        } else if (wire_type == kWireFixed64) {
+            if (!cursor.Copy(nullptr, 8)) {
+                return false;
+            }
+        } else if (wire_type == kWireFixed32) {
+            if (!cursor.Copy(nullptr, 4)) {
+                return false;
+            }
+        } else {
+            return false;  // Groups are not used by proto3
+        }
+    }
+    return true;
+}
+
+} // namespace hnvue::hal::detwire
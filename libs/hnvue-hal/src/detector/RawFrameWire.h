@@ -0,0 +1,75 @@
+/**
+ * @file RawFrameWire.h
+ * @brief Slice-level decoder for detector_acquisition.proto RawFrame messages
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ *
+ * A 9 MP 16-bit frame is an 18 MB RawFrame. Parsing it with the generated
+ * message copies pixel_data from the received slices into a std::string and
+ * then again into its destination. DecodeRawFrame() walks the protobuf wire
+ * format directly over the received (non-contiguous) chunks and copies
+ * pixel_data once, into a destination chosen by the caller when the pixel
+ * byte count is known. All other fields are decoded into RawFrameHeader;
+ * unknown fields are skipped.
+ */
+
+#ifndef HNUE_HAL_RAW_FRAME_WIRE_H
+#define HNUE_HAL_RAW_FRAME_WIRE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hnvue::hal::detwire {
+
+/**
+ * @brief One contiguous piece of a received message
+ */
+struct WireChunk {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+/**
+ * @brief RawFrame fields other than pixel_data
+ */
+struct RawFrameHeader {
+    int64_t sequence_number = 0;
+    int64_t timestamp_us = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t bit_depth = 0;
+    std::string session_id;
+    size_t pixel_bytes = 0;      ///< Length of pixel_data
+    bool pixels_copied = false;  ///< pixel_data was copied to the sink's destination
+};
+
+/**
+ * @brief Destination for pixel_data
+ *
+ * Called once, when the pixel_data length is read. Return a buffer of at
+ * least pixel_bytes bytes, or nullptr to skip the pixels.
+ */
+class PixelSink {
+public:
+    virtual ~PixelSink() = default;
+    virtual uint8_t* PixelDestination(size_t pixel_bytes) = 0;
+};
+
+/**
+ * @brief Decode one serialized RawFrame
+ * @param chunks Message bytes in order
+ * @param count Number of chunks
+ * @param header Receives the decoded fields
+ * @param sink Pixel destination provider
+ * @return false if the message is malformed (truncated, bad wire type)
+ */
+bool DecodeRawFrame(const WireChunk* chunks, size_t count, RawFrameHeader& header,
+                    PixelSink& sink);
+
+} // namespace hnvue::hal::detwire
+
+#endif // HNUE_HAL_RAW_FRAME_WIRE_H
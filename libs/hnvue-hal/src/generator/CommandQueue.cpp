@@ -9,6 +9,7 @@
  */
 
 #include "hnvue/hal/generator/CommandQueue.h"
+#include "hnvue/infra/Clock.h"
 
 #include <algorithm>
 
@@ -73,9 +74,7 @@ bool CommandQueue::Push(const HvgCommand& command) {
     }
 
     HvgCommand cmd = command;
-    cmd.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
+    cmd.timestamp_us = infra::SinceStartUs();
 
     // Priority insertion: abort commands go to front
     if (cmd.type == CommandType::CMD_ABORT_EXPOSURE) {
@@ -96,9 +95,7 @@ bool CommandQueue::Push(HvgCommand&& command) {
         return false;  // Queue is full
     }
 
-    command.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
+    command.timestamp_us = infra::SinceStartUs();
 
     // Priority insertion: abort commands go to front
     if (command.type == CommandType::CMD_ABORT_EXPOSURE) {
@@ -0,0 +1,465 @@
+/**
+ * @file ExposureSequencer.cpp
+ * @brief Deterministic multi-exposure sequencing with detector frame pairing
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator exposure timing
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "generator/ExposureSequencer.h"
+
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
+
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+namespace hnvue::hal {
+
+namespace {
+
+/// Generator status poll period while waiting for the end of an exposure
+constexpr int64_t kReadyPollUs = 100;
+
+/// Weight of a new arm latency sample in the running estimate (1/n)
+constexpr int64_t kArmEstimateWeight = 4;
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+bool InRange(float value, float low, float high) {
+    return std::isfinite(value) && value >= low && value <= high;
+}
+
+int64_t ExposureUs(float ms) {
+    return static_cast<int64_t>(std::ceil(static_cast<double>(ms) * 1000.0));
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Frame Log
+// =============================================================================
+
+/**
+ * @brief Frame timestamps recorded while a sequence runs
+ *
+ * Capacity is reserved before the sequence starts; the detector ingest
+ * thread only appends.
+ */
+struct ExposureSequencer::FrameLog {
+    struct Stamp {
+        int64_t sequence_number;
+        int64_t timestamp_us;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool collecting = false;
+    size_t capacity = 0;
+    uint32_t received = 0;
+    std::vector<Stamp> frames;
+};
+
+// =============================================================================
+// Plan Validation
+// =============================================================================
+
+bool ValidateExposurePlan(const ExposurePlan& plan, const HvgCapabilities& capabilities,
+                          const SequencerConfig& config, std::string& error) {
+    if (plan.steps.empty()) {
+        error = "Plan has no steps";
+        return false;
+    }
+    if (plan.steps.size() > config.max_steps) {
+        error = fmt::format("Plan has {} steps, limit {}", plan.steps.size(), config.max_steps);
+        return false;
+    }
+
+    for (size_t i = 0; i < plan.steps.size(); ++i) {
+        const ExposureParams& params = plan.steps[i].params;
+        if (!InRange(params.kvp, capabilities.min_kvp, capabilities.max_kvp)) {
+            error = fmt::format("Step {}: {} kV outside {}-{}", i, params.kvp,
+                                capabilities.min_kvp, capabilities.max_kvp);
+            return false;
+        }
+        if (!InRange(params.ma, capabilities.min_ma, capabilities.max_ma)) {
+            error = fmt::format("Step {}: {} mA outside {}-{}", i, params.ma,
+                                capabilities.min_ma, capabilities.max_ma);
+            return false;
+        }
+        if (!InRange(params.ms, capabilities.min_ms, capabilities.max_ms)) {
+            error = fmt::format("Step {}: {} ms outside {}-{}", i, params.ms,
+                                capabilities.min_ms, capabilities.max_ms);
+            return false;
+        }
+        if (!params.focus.empty() && params.focus != "large" &&
+            !(params.focus == "small" && capabilities.has_dual_focus)) {
+            error = fmt::format("Step {}: focus '{}' not supported", i, params.focus);
+            return false;
+        }
+        if (params.aec_mode == AecMode::AEC_AUTO && !capabilities.has_aec) {
+            error = fmt::format("Step {}: generator has no AEC", i);
+            return false;
+        }
+
+        if (i == 0) {
+            continue;
+        }
+        const int64_t interval_us = plan.steps[i].interval_us;
+        const int64_t shortest_us = ExposureUs(plan.steps[i - 1].params.ms) + config.min_gap_us;
+        if (interval_us < shortest_us) {
+            error = fmt::format("Step {}: interval {} us shorter than {} us (previous exposure + gap)",
+                                i, interval_us, shortest_us);
+            return false;
+        }
+        if (interval_us > config.max_interval_us) {
+            error = fmt::format("Step {}: interval {} us longer than {} us",
+                                i, interval_us, config.max_interval_us);
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Constructor/Destructor
+// =============================================================================
+
+ExposureSequencer::ExposureSequencer(IGenerator& generator, IDetector* detector,
+                                     const SequencerConfig& config)
+    : generator_(generator)
+    , config_(config)
+    , frame_log_(std::make_shared<FrameLog>())
+    , has_detector_(detector != nullptr)
+{
+    if (detector != nullptr) {
+        std::shared_ptr<FrameLog> log = frame_log_;
+        detector->RegisterFrameCallback([log](const RawFrame& frame) {
+            std::lock_guard<std::mutex> lock(log->mutex);
+            if (!log->collecting) {
+                return;
+            }
+            ++log->received;
+            if (log->frames.size() < log->capacity) {
+                log->frames.push_back({frame.sequence_number, frame.timestamp_us});
+            }
+            log->cv.notify_all();
+        });
+    }
+}
+
+ExposureSequencer::~ExposureSequencer() {
+    Abort();
+}
+
+// =============================================================================
+// Sequence Control
+// =============================================================================
+
+SequenceReport ExposureSequencer::Execute(const ExposurePlan& plan) {
+    SequenceReport report;
+
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        report.error_msg = "Sequence already running";
+        return report;
+    }
+    abort_requested_.store(false, std::memory_order_release);
+
+    if (!ValidateExposurePlan(plan, generator_.GetCapabilities(), config_, report.error_msg)) {
+        spdlog::warn("[ExposureSequencer] Plan rejected: {}", report.error_msg);
+        running_.store(false, std::memory_order_release);
+        return report;
+    }
+
+    report.steps.reserve(plan.steps.size());
+    {
+        std::lock_guard<std::mutex> lock(frame_log_->mutex);
+        frame_log_->frames.clear();
+        frame_log_->frames.reserve(config_.max_frames);
+        frame_log_->capacity = config_.max_frames;
+        frame_log_->received = 0;
+        frame_log_->collecting = has_detector_;
+    }
+
+    std::thread worker([this, &plan, &report]() {
+        infra::ThreadPolicyReport policy = infra::ApplyNamedThreadPolicy(kThreadGeneratorExposure);
+        if (!policy.AllApplied()) {
+            spdlog::warn("[ExposureSequencer] Sequence thread policy not fully applied (sched={}, affinity={})",
+                         static_cast<int>(policy.scheduling), static_cast<int>(policy.affinity));
+        }
+        RunSteps(plan, report);
+    });
+    worker.join();
+
+    // Give the last exposure's frame up to frame_window_us to arrive
+    if (has_detector_ && !report.steps.empty() &&
+        report.outcome != SequenceOutcome::SEQUENCE_ABORTED) {
+        const SequenceStepReport& last = report.steps.back();
+        const int64_t wait_until_us = last.end_us + config_.frame_window_us;
+        std::unique_lock<std::mutex> lock(frame_log_->mutex);
+        while (frame_log_->frames.empty() ||
+               frame_log_->frames.back().timestamp_us < last.start_us) {
+            const int64_t remaining_us = wait_until_us - infra::MonotonicClock::NowUs();
+            if (remaining_us <= 0 || frame_log_->frames.size() >= frame_log_->capacity) {
+                break;
+            }
+            frame_log_->cv.wait_for(lock, std::chrono::microseconds(remaining_us));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(frame_log_->mutex);
+        frame_log_->collecting = false;
+    }
+
+    PairFrames(plan, report);
+
+    spdlog::info("[ExposureSequencer] Sequence ended: outcome={}, steps={}/{}, frames={}/{}, "
+                 "max start error={} us, rms={:.1f} us",
+                 static_cast<int>(report.outcome), report.steps.size(), plan.steps.size(),
+                 report.frames_matched, report.frames_received, report.max_start_error_us,
+                 report.rms_start_error_us);
+
+    running_.store(false, std::memory_order_release);
+    return report;
+}
+
+void ExposureSequencer::Abort() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        abort_requested_.store(true, std::memory_order_release);
+    }
+    wait_cv_.notify_all();
+    if (running_.load(std::memory_order_acquire)) {
+        generator_.AbortExposure();
+    }
+}
+
+// =============================================================================
+// Sequence Thread
+// =============================================================================
+
+void ExposureSequencer::RunSteps(const ExposurePlan& plan, SequenceReport& report) {
+    auto end_sequence = [&report](SequenceOutcome outcome, size_t step, std::string error) {
+        report.outcome = outcome;
+        report.failed_step = static_cast<int32_t>(step);
+        report.error_msg = std::move(error);
+        spdlog::warn("[ExposureSequencer] Step {} ended the sequence: {}", step, report.error_msg);
+    };
+
+    // Step 0 is armed before the first deadline is set
+    if (!generator_.SetExposureParams(plan.steps[0].params)) {
+        end_sequence(SequenceOutcome::SEQUENCE_FAILED, 0, "Generator rejected exposure parameters");
+        return;
+    }
+
+    int64_t deadline_us = infra::MonotonicClock::NowUs() + plan.start_delay_us;
+
+    for (size_t i = 0; i < plan.steps.size(); ++i) {
+        if (i > 0) {
+            deadline_us += plan.steps[i].interval_us;
+
+            // Pre-arm in the gap, as soon as the previous exposure has ended
+            std::string error;
+            if (!WaitForIdle(report.steps.back().end_us, error)) {
+                end_sequence(abort_requested_.load(std::memory_order_acquire)
+                                 ? SequenceOutcome::SEQUENCE_ABORTED
+                                 : SequenceOutcome::SEQUENCE_FAILED,
+                             i, error);
+                return;
+            }
+            if (!generator_.SetExposureParams(plan.steps[i].params)) {
+                end_sequence(SequenceOutcome::SEQUENCE_FAILED, i, "Generator rejected exposure parameters");
+                return;
+            }
+        }
+
+        // Fire one predicted arm latency early; refuse if the start would be too late
+        const int64_t lead_us = std::max<int64_t>(arm_estimate_us_, 0);
+        const int64_t fire_us = deadline_us - lead_us;
+        const int64_t lateness_us = infra::MonotonicClock::NowUs() - fire_us;
+        if (lateness_us > static_cast<int64_t>(config_.max_lateness_us)) {
+            end_sequence(SequenceOutcome::SEQUENCE_LATE, i,
+                         fmt::format("Start {} us past its deadline", lateness_us));
+            return;
+        }
+        if (!WaitUntil(fire_us)) {
+            end_sequence(SequenceOutcome::SEQUENCE_ABORTED, i, "Sequence aborted");
+            return;
+        }
+
+        SequenceStepReport step;
+        step.deadline_us = deadline_us;
+        step.arm_lead_us = lead_us;
+        const int64_t call_us = infra::MonotonicClock::NowUs();
+        step.result = generator_.StartExposure();
+        step.start_us = infra::MonotonicClock::NowUs();
+        step.arm_latency_us = step.start_us - call_us;
+        step.start_error_us = step.start_us - deadline_us;
+        step.end_us = step.start_us + ExposureUs(step.result.actual_ms);
+        report.steps.push_back(std::move(step));
+
+        if (!report.steps.back().result.success) {
+            const bool aborted = abort_requested_.load(std::memory_order_acquire);
+            end_sequence(aborted ? SequenceOutcome::SEQUENCE_ABORTED : SequenceOutcome::SEQUENCE_FAILED,
+                         i, report.steps.back().result.error_msg);
+            return;
+        }
+
+        const int64_t latency_us = report.steps.back().arm_latency_us;
+        arm_estimate_us_ = arm_estimate_us_ < 0
+            ? latency_us
+            : arm_estimate_us_ + (latency_us - arm_estimate_us_) / kArmEstimateWeight;
+
+        // An abort that raced StartExposure is repeated on the running exposure
+        if (abort_requested_.load(std::memory_order_acquire)) {
+            generator_.AbortExposure();
+            end_sequence(SequenceOutcome::SEQUENCE_ABORTED, i, "Sequence aborted");
+            return;
+        }
+    }
+
+    // The sequence completes when the generator is idle again
+    std::string error;
+    if (!WaitForIdle(report.steps.back().end_us, error)) {
+        end_sequence(abort_requested_.load(std::memory_order_acquire)
+                         ? SequenceOutcome::SEQUENCE_ABORTED
+                         : SequenceOutcome::SEQUENCE_FAILED,
+                     plan.steps.size() - 1, error);
+        return;
+    }
+    report.outcome = SequenceOutcome::SEQUENCE_COMPLETED;
+}
+
+bool ExposureSequencer::WaitUntil(int64_t deadline_us) {
+    const int64_t sleep_until_us = deadline_us - config_.spin_us;
+    int64_t remaining_us = sleep_until_us - infra::MonotonicClock::NowUs();
+    if (remaining_us > 0) {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        while (remaining_us > 0 && !abort_requested_.load(std::memory_order_acquire)) {
+            wait_cv_.wait_for(lock, std::chrono::microseconds(remaining_us));
+            remaining_us = sleep_until_us - infra::MonotonicClock::NowUs();
+        }
+    }
+
+    while (infra::MonotonicClock::NowUs() < deadline_us) {
+        if (abort_requested_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        CpuRelax();
+    }
+    return !abort_requested_.load(std::memory_order_acquire);
+}
+
+bool ExposureSequencer::WaitForIdle(int64_t not_before_us, std::string& error) {
+    if (!WaitUntil(not_before_us)) {
+        error = "Sequence aborted";
+        return false;
+    }
+
+    const int64_t timeout_us = infra::MonotonicClock::NowUs() +
+                               static_cast<int64_t>(config_.ready_timeout_ms) * 1000;
+    for (;;) {
+        const GeneratorState state = generator_.GetStatus().state;
+        if (state == GeneratorState::GEN_ERROR) {
+            error = "Generator in error state";
+            return false;
+        }
+        if (state != GeneratorState::GEN_ARMED && state != GeneratorState::GEN_EXPOSING) {
+            return true;
+        }
+        if (infra::MonotonicClock::NowUs() > timeout_us) {
+            error = "Generator did not finish the exposure";
+            return false;
+        }
+        if (!WaitUntil(infra::MonotonicClock::NowUs() + kReadyPollUs)) {
+            error = "Sequence aborted";
+            return false;
+        }
+    }
+}
+
+// =============================================================================
+// Frame Pairing
+// =============================================================================
+
+void ExposureSequencer::PairFrames(const ExposurePlan& plan, SequenceReport& report) {
+    std::vector<FrameLog::Stamp> frames;
+    {
+        std::lock_guard<std::mutex> lock(frame_log_->mutex);
+        frames = frame_log_->frames;
+        report.frames_received = frame_log_->received;
+    }
+    std::stable_sort(frames.begin(), frames.end(),
+                     [](const FrameLog::Stamp& a, const FrameLog::Stamp& b) {
+                         return a.timestamp_us < b.timestamp_us;
+                     });
+
+    // Each exposure takes the frame nearest its end within the window; frames
+    // are taken in order, so one late frame cannot be claimed twice
+    const int64_t window_us = config_.frame_window_us;
+    size_t next = 0;
+    for (SequenceStepReport& step : report.steps) {
+        if (!step.result.success) {
+            continue;
+        }
+        int64_t best_offset = window_us + 1;
+        size_t best = frames.size();
+        for (size_t j = next; j < frames.size(); ++j) {
+            const int64_t offset = frames[j].timestamp_us - step.end_us;
+            if (offset > window_us) {
+                break;
+            }
+            if (std::llabs(offset) < best_offset) {
+                best_offset = std::llabs(offset);
+                best = j;
+            }
+        }
+        if (best < frames.size()) {
+            step.frame_matched = true;
+            step.frame_sequence = frames[best].sequence_number;
+            step.frame_timestamp_us = frames[best].timestamp_us;
+            ++report.frames_matched;
+            next = best + 1;
+        }
+    }
+
+    // Timing statistics over the exposures that started
+    double square_sum = 0.0;
+    size_t started = 0;
+    for (size_t i = 0; i < report.steps.size(); ++i) {
+        const SequenceStepReport& step = report.steps[i];
+        if (!step.result.success) {
+            continue;
+        }
+        ++started;
+        square_sum += static_cast<double>(step.start_error_us) * static_cast<double>(step.start_error_us);
+        report.max_start_error_us = std::max<int64_t>(report.max_start_error_us,
+                                                      std::llabs(step.start_error_us));
+        if (i > 0 && report.steps[i - 1].result.success) {
+            const int64_t achieved_us = step.start_us - report.steps[i - 1].start_us;
+            const int64_t interval_error_us = achieved_us - plan.steps[i].interval_us;
+            report.max_interval_error_us = std::max<int64_t>(report.max_interval_error_us,
+                                                             std::llabs(interval_error_us));
+        }
+    }
+    if (started > 0) {
+        report.rms_start_error_us = std::sqrt(square_sum / static_cast<double>(started));
+    }
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,212 @@
+/**
+ * @file ExposureSequencer.h
+ * @brief Deterministic multi-exposure sequencing with detector frame pairing
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator exposure timing
+ * SPDX-License-Identifier: MIT
+ *
+ * Stitching, dual-energy and serial acquisitions need several exposures at
+ * planned instants. ExposureSequencer validates a whole plan against the
+ * generator capabilities before the first exposure, then runs it on a
+ * kThreadGeneratorExposure thread against absolute deadlines:
+ *
+ *   step n:   SetExposureParams (pre-arm, during the previous gap)
+ *             sleep, then spin, until deadline_n - predicted arm latency
+ *             StartExposure
+ *             wait for the generator to return to IDLE / READY
+ *
+ * The arm latency (StartExposure call to return) is learnt from the steps
+ * already taken, so the exposure start lands on the deadline rather than
+ * one arm latency after it. A step that cannot start within max_lateness_us
+ * of its deadline ends the sequence before firing.
+ *
+ * Detector frames arriving during the sequence are paired with the
+ * exposures by timestamp once the sequence ends.
+ */
+
+#ifndef HNUE_HAL_EXPOSURE_SEQUENCER_H
+#define HNUE_HAL_EXPOSURE_SEQUENCER_H
+
+#include "hnvue/hal/IDetector.h"
+#include "hnvue/hal/IGenerator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief One exposure of a plan
+ */
+struct SequenceStep {
+    ExposureParams params;       ///< params.ms is the exposure (or AEC backup) time
+    uint32_t interval_us = 0;    ///< Planned start after the previous step's start (ignored for step 0)
+};
+
+/**
+ * @brief Exposure plan
+ */
+struct ExposurePlan {
+    std::vector<SequenceStep> steps;
+    uint32_t start_delay_us = 2000;   ///< First deadline after step 0 is pre-armed
+};
+
+/**
+ * @brief Sequencer configuration
+ */
+struct SequencerConfig {
+    uint32_t max_steps = 64;
+    uint32_t min_gap_us = 5000;            ///< Least end-to-start gap between exposures
+    uint32_t max_interval_us = 60000000;   ///< Longest start-to-start interval
+    uint32_t max_lateness_us = 5000;       ///< Latest start past a deadline
+    uint32_t spin_us = 200;                ///< Busy-wait before each start
+    uint32_t ready_timeout_ms = 2000;      ///< Generator back to IDLE / READY after an exposure
+    uint32_t frame_window_us = 100000;     ///< Largest |frame timestamp - exposure end|
+    size_t max_frames = 256;               ///< Frames recorded per sequence
+};
+
+/**
+ * @brief Sequence outcome
+ */
+enum class SequenceOutcome : int32_t {
+    SEQUENCE_COMPLETED = 0,
+    SEQUENCE_REJECTED = 1,    ///< Plan invalid or a sequence already running; nothing exposed
+    SEQUENCE_FAILED = 2,      ///< Generator refused parameters, failed to start or did not recover
+    SEQUENCE_LATE = 3,        ///< A step could not start within max_lateness_us
+    SEQUENCE_ABORTED = 4      ///< Abort() called
+};
+
+/**
+ * @brief Timing and pairing of one executed step
+ *
+ * Timestamps are microseconds since process epoch (infra::MonotonicClock).
+ */
+struct SequenceStepReport {
+    ExposureResult result;
+    int64_t deadline_us = 0;         ///< Planned start
+    int64_t start_us = 0;            ///< StartExposure returned (exposure running)
+    int64_t end_us = 0;              ///< start_us + result.actual_ms
+    int64_t start_error_us = 0;      ///< start_us - deadline_us
+    int64_t arm_latency_us = 0;      ///< StartExposure call to return
+    int64_t arm_lead_us = 0;         ///< Predicted arm latency StartExposure was called ahead by
+    bool frame_matched = false;
+    int64_t frame_sequence = -1;     ///< RawFrame::sequence_number
+    int64_t frame_timestamp_us = 0;
+};
+
+/**
+ * @brief Result of one sequence
+ */
+struct SequenceReport {
+    SequenceOutcome outcome = SequenceOutcome::SEQUENCE_REJECTED;
+    std::string error_msg;
+    int32_t failed_step = -1;                 ///< Step that ended the sequence early
+    std::vector<SequenceStepReport> steps;    ///< Executed steps, in plan order
+    uint32_t frames_received = 0;
+    uint32_t frames_matched = 0;
+    int64_t max_start_error_us = 0;           ///< Largest |start_error_us|
+    double rms_start_error_us = 0.0;
+    int64_t max_interval_error_us = 0;        ///< Largest |achieved - planned interval|
+};
+
+/**
+ * @brief Check a plan before anything is exposed
+ * @param error Reason of the first violation
+ * @return false if the plan is empty or longer than max_steps, a step is
+ *         outside the generator capabilities (kV, mA, ms, focus, AEC), or
+ *         an interval is shorter than the previous exposure plus min_gap_us
+ *         or longer than max_interval_us
+ */
+bool ValidateExposurePlan(const ExposurePlan& plan, const HvgCapabilities& capabilities,
+                          const SequencerConfig& config, std::string& error);
+
+/**
+ * @brief Runs exposure plans with bounded inter-exposure timing
+ *
+ * Thread Safety:
+ * - Execute() from one control thread at a time; a concurrent call is rejected
+ * - Abort() from any thread
+ */
+class ExposureSequencer {
+public:
+    /**
+     * @param generator Generator (must outlive the sequencer)
+     * @param detector Detector whose frames are paired, or nullptr;
+     *        acquisition is started by the caller
+     */
+    ExposureSequencer(IGenerator& generator, IDetector* detector,
+                      const SequencerConfig& config = SequencerConfig{});
+    ~ExposureSequencer();
+
+    ExposureSequencer(const ExposureSequencer&) = delete;
+    ExposureSequencer& operator=(const ExposureSequencer&) = delete;
+
+    /**
+     * @brief Validate, pre-arm and run a plan; blocks until it ends
+     *
+     * Frames are paired after the last exposure, waiting at most
+     * frame_window_us past its end for its frame.
+     */
+    SequenceReport Execute(const ExposurePlan& plan);
+
+    /**
+     * @brief Stop a running sequence and abort the current exposure
+     */
+    void Abort();
+
+    bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+    const SequencerConfig& GetConfig() const { return config_; }
+
+private:
+    struct FrameLog;
+
+    /**
+     * @brief Sequence body (kThreadGeneratorExposure thread)
+     */
+    void RunSteps(const ExposurePlan& plan, SequenceReport& report);
+
+    /**
+     * @brief Wait until deadline_us: sleep, then spin the last spin_us
+     * @return false if aborted
+     */
+    bool WaitUntil(int64_t deadline_us);
+
+    /**
+     * @brief Wait for the generator to leave ARMED / EXPOSING
+     * @return false on abort, generator error or timeout (error set)
+     */
+    bool WaitForIdle(int64_t not_before_us, std::string& error);
+
+    /**
+     * @brief Pair recorded frames with the executed steps and fill statistics
+     */
+    void PairFrames(const ExposurePlan& plan, SequenceReport& report);
+
+    IGenerator& generator_;
+    SequencerConfig config_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> abort_requested_{false};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+
+    /// Shared with the detector frame callback, which may outlive the sequencer
+    std::shared_ptr<FrameLog> frame_log_;
+    bool has_detector_ = false;
+
+    /// Predicted StartExposure latency, learnt across steps and sequences
+    /// (-1 until the first exposure)
+    int64_t arm_estimate_us_ = -1;
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_EXPOSURE_SEQUENCER_H
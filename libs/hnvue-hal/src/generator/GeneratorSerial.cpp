@@ -0,0 +1,339 @@
+/**
+ * @file GeneratorSerial.cpp
+ * @brief IGenerator over an RS-232 HVG link (epoll-driven serial transport)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "generator/GeneratorSerial.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <chrono>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+// =============================================================================
+// Constructor/Destructor
+// =============================================================================
+
+GeneratorSerial::GeneratorSerial(const SerialGeneratorConfig& config)
+    : GeneratorBase(config.queue_depth, config.response_timeout_ms, config.max_retries)
+    , config_(config)
+{
+}
+
+GeneratorSerial::~GeneratorSerial() {
+    Close();
+}
+
+bool GeneratorSerial::Open() {
+    bool opened = transport_.Open(
+        config_.serial,
+        [this](const hvg::FrameView& frame) { OnFrame(frame); },
+        [this](std::vector<uint8_t>& batch) { FillWrites(batch); });
+    if (!opened) {
+        return false;
+    }
+
+    hvg::AckResult result;
+    std::vector<uint8_t> response;
+    HvgCapabilities caps;
+    if (!Transact(CommandType::CMD_GET_CAPABILITIES, hvg::MessageId::GET_CAPABILITIES, nullptr, 0,
+                  config_.response_timeout_ms, true, result, &response) ||
+        result != hvg::AckResult::OK ||
+        !hvg::DecodeCapabilities(hvg::FrameView{hvg::MessageId::CAPABILITIES, 0, response.data(),
+                                                response.size()}, caps)) {
+        spdlog::error("[GeneratorSerial] No capabilities from generator on {}", config_.serial.port);
+        Close();
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        capabilities_ = caps;
+    }
+
+    // Initial status; later updates are pushed by the generator
+    if (!Transact(CommandType::CMD_GET_STATUS, hvg::MessageId::GET_STATUS, nullptr, 0,
+                  config_.response_timeout_ms, true, result)) {
+        spdlog::warn("[GeneratorSerial] No initial status from generator");
+    }
+
+    spdlog::info("[GeneratorSerial] Connected: {} {} (fw {})",
+                 caps.vendor_name, caps.model_name, caps.firmware_version);
+    return true;
+}
+
+void GeneratorSerial::Close() {
+    transport_.Close();
+    GetCommandQueue().Clear();
+}
+
+// =============================================================================
+// IGenerator Interface Implementation
+// =============================================================================
+
+HvgStatus GeneratorSerial::GetStatus() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return status_;
+}
+
+HvgCapabilities GeneratorSerial::GetCapabilities() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return capabilities_;
+}
+
+ExposureResult GeneratorSerial::GetLastExposureResult() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return last_result_;
+}
+
+bool GeneratorSerial::SetExposureParams(const ExposureParams& params) {
+    HvgCapabilities caps = GetCapabilities();
+    if (params.kvp < caps.min_kvp || params.kvp > caps.max_kvp ||
+        params.ma < caps.min_ma || params.ma > caps.max_ma ||
+        params.ms < caps.min_ms || params.ms > caps.max_ms) {
+        spdlog::warn("[GeneratorSerial] Parameters out of range: kvp={}, ma={}, ms={}",
+                     params.kvp, params.ma, params.ms);
+        return false;
+    }
+    if ((params.focus == "small" && !caps.has_dual_focus) ||
+        (params.aec_mode != AecMode::AEC_MANUAL && !caps.has_aec)) {
+        spdlog::warn("[GeneratorSerial] Focus or AEC mode not supported by generator");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> exposure_lock(exposure_mutex_);
+    uint8_t payload[hvg::kParamsSize];
+    size_t length = hvg::EncodeParams(params, payload);
+    hvg::AckResult result;
+    if (!Transact(CommandType::CMD_SET_EXPOSURE_PARAMS, hvg::MessageId::SET_PARAMS, payload, length,
+                  config_.response_timeout_ms, true, result)) {
+        spdlog::error("[GeneratorSerial] SET_PARAMS not acknowledged");
+        return false;
+    }
+    if (result != hvg::AckResult::OK) {
+        spdlog::warn("[GeneratorSerial] SET_PARAMS rejected (result={})", static_cast<int>(result));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    params_ = params;
+    params_set_ = true;
+    return true;
+}
+
+ExposureResult GeneratorSerial::StartExposure() {
+    std::lock_guard<std::mutex> exposure_lock(exposure_mutex_);
+    ExposureParams params;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (!params_set_) {
+            spdlog::warn("[GeneratorSerial] Cannot start exposure: parameters not set");
+            return ExposureResult{false, 0, 0, 0, 0, "Parameters not set"};
+        }
+        params = params_;
+    }
+
+    hvg::AckResult result;
+    if (!Transact(CommandType::CMD_START_EXPOSURE, hvg::MessageId::START_EXPOSURE, nullptr, 0,
+                  config_.response_timeout_ms, true, result)) {
+        spdlog::error("[GeneratorSerial] START_EXPOSURE not acknowledged");
+        return ExposureResult{false, 0, 0, 0, 0, "No response from generator"};
+    }
+    if (result != hvg::AckResult::OK) {
+        spdlog::warn("[GeneratorSerial] START_EXPOSURE rejected (result={})", static_cast<int>(result));
+        return ExposureResult{false, 0, 0, 0, 0,
+                              result == hvg::AckResult::INVALID_STATE ? "Invalid state for exposure"
+                                                                      : "Exposure rejected"};
+    }
+
+    spdlog::info("[GeneratorSerial] Exposure started: kvp={}, ma={}, ms={}ms",
+                 params.kvp, params.ma, params.ms);
+    return ExposureResult{true, params.kvp, params.ma, params.ms, params.ma * params.ms / 1000.0f, ""};
+}
+
+void GeneratorSerial::AbortExposure() {
+    // Not serialized with StartExposure: the abort frame jumps the queue
+    hvg::AckResult result;
+    if (!Transact(CommandType::CMD_ABORT_EXPOSURE, hvg::MessageId::ABORT_EXPOSURE, nullptr, 0,
+                  config_.abort_wait_ms, false, result)) {
+        spdlog::error("[GeneratorSerial] ABORT_EXPOSURE not acknowledged within {}ms",
+                      config_.abort_wait_ms);
+        return;
+    }
+    spdlog::info("[GeneratorSerial] Exposure aborted");
+}
+
+// =============================================================================
+// Request/Response
+// =============================================================================
+
+bool GeneratorSerial::AcquireSeq(hvg::MessageId expect, uint8_t& seq) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    for (size_t i = 0; i < pending_.size(); ++i) {
+        uint8_t candidate = next_seq_++;
+        Pending& entry = pending_[candidate];
+        if (!entry.in_use) {
+            entry.in_use = true;
+            entry.answered = false;
+            entry.expect = expect;
+            entry.response.clear();
+            seq = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeneratorSerial::ReleaseSeq(uint8_t seq) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_[seq].in_use = false;
+}
+
+bool GeneratorSerial::Transact(CommandType type, hvg::MessageId id, const uint8_t* payload,
+                               size_t length, uint32_t wait_ms, bool retry, hvg::AckResult& result,
+                               std::vector<uint8_t>* response) {
+    if (!transport_.IsConnected()) {
+        return false;
+    }
+
+    hvg::MessageId expect = hvg::MessageId::ACK;
+    if (id == hvg::MessageId::GET_CAPABILITIES) {
+        expect = hvg::MessageId::CAPABILITIES;
+    } else if (id == hvg::MessageId::GET_STATUS) {
+        expect = hvg::MessageId::STATUS;
+    }
+    uint8_t seq;
+    if (!AcquireSeq(expect, seq)) {
+        return false;
+    }
+
+    // Encoded once; retransmissions reuse the same bytes and SEQ
+    auto frame = std::make_shared<std::vector<uint8_t>>();
+    hvg::AppendFrame(*frame, id, seq, payload, length);
+    HvgCommand command;
+    command.type = type;
+    command.execute = [this, frame]() {
+        write_batch_->insert(write_batch_->end(), frame->begin(), frame->end());
+        return HvgResponse{true, "", 0};
+    };
+    if (!GetCommandQueue().Push(command)) {
+        spdlog::warn("[GeneratorSerial] Command queue full");
+        ReleaseSeq(seq);
+        return false;
+    }
+    transport_.RequestWrite();
+
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    Pending& entry = pending_[seq];
+    while (true) {
+        if (pending_cv_.wait_for(lock, std::chrono::milliseconds(wait_ms),
+                                 [&entry]() { return entry.answered; })) {
+            result = entry.result;
+            if (response != nullptr) {
+                response->swap(entry.response);
+            }
+            entry.in_use = false;
+            return true;
+        }
+        if (!retry || !transport_.IsConnected() || !GetCommandQueue().Retry(command)) {
+            entry.in_use = false;
+            return false;
+        }
+        ++command.retry_count;
+        spdlog::warn("[GeneratorSerial] No answer to command 0x{:02x} (seq={}), retry {}",
+                     static_cast<int>(id), seq, command.retry_count);
+        transport_.RequestWrite();
+    }
+}
+
+// =============================================================================
+// I/O Thread
+// =============================================================================
+
+void GeneratorSerial::FillWrites(std::vector<uint8_t>& batch) {
+    write_batch_ = &batch;
+    HvgCommand command;
+    while (GetCommandQueue().TryPop(command)) {
+        command.execute();
+    }
+    write_batch_ = nullptr;
+}
+
+void GeneratorSerial::Complete(const hvg::FrameView& frame, hvg::AckResult result) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    Pending& entry = pending_[frame.seq];
+    if (!entry.in_use || entry.answered) {
+        return;   // Late or duplicate answer
+    }
+    if (frame.id != hvg::MessageId::ACK && frame.id != entry.expect) {
+        return;
+    }
+    entry.result = result;
+    if (frame.id != hvg::MessageId::ACK) {
+        entry.response.assign(frame.payload, frame.payload + frame.length);
+    }
+    entry.answered = true;
+    pending_cv_.notify_all();
+}
+
+void GeneratorSerial::OnFrame(const hvg::FrameView& frame) {
+    switch (frame.id) {
+        case hvg::MessageId::ACK: {
+            hvg::MessageId acked;
+            hvg::AckResult result;
+            if (hvg::DecodeAck(frame, acked, result)) {
+                Complete(frame, result);
+            }
+            break;
+        }
+        case hvg::MessageId::CAPABILITIES:
+            Complete(frame, hvg::AckResult::OK);
+            break;
+        case hvg::MessageId::STATUS: {
+            HvgStatus status;
+            if (!hvg::DecodeStatus(frame, status)) {
+                break;
+            }
+            status.timestamp_us = infra::SinceStartUs();
+            {
+                std::lock_guard<std::mutex> lock(cache_mutex_);
+                status_ = status;
+            }
+            SetState(status.state);
+            Complete(frame, hvg::AckResult::OK);
+            NotifyStatusCallbacks(status);
+            break;
+        }
+        case hvg::MessageId::ALARM: {
+            HvgAlarm alarm;
+            if (!hvg::DecodeAlarm(frame, alarm)) {
+                break;
+            }
+            alarm.timestamp_us = infra::SinceStartUs();
+            spdlog::warn("[GeneratorSerial] Alarm {}: {}", alarm.alarm_code, alarm.description);
+            NotifyAlarmCallbacks(alarm);
+            break;
+        }
+        case hvg::MessageId::EXPOSURE_DONE: {
+            ExposureResult result;
+            if (hvg::DecodeExposureDone(frame, result)) {
+                std::lock_guard<std::mutex> lock(cache_mutex_);
+                last_result_ = result;
+            }
+            break;
+        }
+        default:
+            spdlog::debug("[GeneratorSerial] Ignoring frame 0x{:02x}", static_cast<int>(frame.id));
+            break;
+    }
+}
+
+} // namespace hnvue::hal
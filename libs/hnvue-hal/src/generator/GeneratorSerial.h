@@ -0,0 +1,133 @@
+/**
+ * @file GeneratorSerial.h
+ * @brief IGenerator over an RS-232 HVG link (epoll-driven serial transport)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_HAL_GENERATOR_SERIAL_H
+#define HNUE_HAL_GENERATOR_SERIAL_H
+
+#include "generator/GeneratorBase.h"
+#include "generator/HvgProtocol.h"
+#include "generator/SerialTransport.h"
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Serial generator configuration
+ */
+struct SerialGeneratorConfig {
+    SerialConfig serial;
+    uint32_t response_timeout_ms = 200;   ///< Per attempt, before retransmitting
+    uint32_t max_retries = 3;
+    size_t queue_depth = 16;
+    uint32_t abort_wait_ms = 10;          ///< AbortExposure() return bound
+};
+
+/**
+ * @brief HVG driven over a serial link
+ *
+ * Callers encode a request, queue it on the CommandQueue and block for the
+ * matching ACK. The transport's I/O thread drains the whole queue into one
+ * write batch per wake-up, so commands issued concurrently leave in a single
+ * write(); abort commands are queued at the front. Status and alarm frames
+ * are dispatched from the I/O thread.
+ *
+ * A request that is not answered in time is re-queued with the same SEQ via
+ * CommandQueue::Retry; the generator re-acknowledges duplicates without
+ * executing them twice.
+ */
+class GeneratorSerial : public GeneratorBase {
+public:
+    explicit GeneratorSerial(const SerialGeneratorConfig& config);
+    ~GeneratorSerial() override;
+
+    /**
+     * @brief Open the port and read the generator capabilities
+     * @return false if the port cannot be opened or the generator does not answer
+     */
+    bool Open();
+
+    void Close();
+
+    bool IsConnected() const { return transport_.IsConnected(); }
+
+    SerialTransportStats GetTransportStats() const { return transport_.GetStats(); }
+
+    /**
+     * @brief Last EXPOSURE_DONE report (success=false until one arrives)
+     */
+    ExposureResult GetLastExposureResult() const;
+
+    // =========================================================================
+    // IGenerator Interface Implementation
+    // =========================================================================
+
+    HvgStatus GetStatus() override;
+    bool SetExposureParams(const ExposureParams& params) override;
+    ExposureResult StartExposure() override;
+    void AbortExposure() override;
+    HvgCapabilities GetCapabilities() override;
+
+private:
+    /// One outstanding request, indexed by SEQ
+    struct Pending {
+        bool in_use = false;
+        bool answered = false;
+        hvg::MessageId expect = hvg::MessageId::ACK;
+        hvg::AckResult result = hvg::AckResult::OK;
+        std::vector<uint8_t> response;
+    };
+
+    /**
+     * @brief Send a request and wait for its ACK or response
+     * @param response Receives the response payload (may be null)
+     * @return false on timeout after all retries
+     */
+    bool Transact(CommandType type, hvg::MessageId id, const uint8_t* payload, size_t length,
+                  uint32_t wait_ms, bool retry, hvg::AckResult& result,
+                  std::vector<uint8_t>* response = nullptr);
+
+    /// @return false if every SEQ is outstanding
+    bool AcquireSeq(hvg::MessageId expect, uint8_t& seq);
+    void ReleaseSeq(uint8_t seq);
+
+    // I/O thread
+    void FillWrites(std::vector<uint8_t>& batch);
+    void OnFrame(const hvg::FrameView& frame);
+    void Complete(const hvg::FrameView& frame, hvg::AckResult result);
+
+    SerialGeneratorConfig config_;
+    SerialTransport transport_;
+
+    // Batch being filled by queued commands (I/O thread only)
+    std::vector<uint8_t>* write_batch_ = nullptr;
+
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+    std::array<Pending, 256> pending_;
+    uint8_t next_seq_ = 0;
+
+    mutable std::mutex cache_mutex_;
+    HvgStatus status_;
+    HvgCapabilities capabilities_;
+    ExposureParams params_;
+    bool params_set_ = false;
+    ExposureResult last_result_;
+
+    // Serializes exposure commands (abort is never blocked by it)
+    std::mutex exposure_mutex_;
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_GENERATOR_SERIAL_H
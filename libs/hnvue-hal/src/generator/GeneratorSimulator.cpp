@@ -9,6 +9,8 @@
  */
 
 #include "hnvue/hal/generator/GeneratorSimulator.h"
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -48,9 +50,7 @@ GeneratorSimulator::GeneratorSimulator(const SimulatorConfig& config)
     current_status_.interlock_ok = true;
     current_status_.actual_kvp = 0.0f;
     current_status_.actual_ma = 0.0f;
-    current_status_.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    current_status_.timestamp_us = infra::SinceStartUs();
 
     // Start status update thread
     running_ = true;
@@ -61,13 +61,22 @@ GeneratorSimulator::GeneratorSimulator(const SimulatorConfig& config)
 }
 
 GeneratorSimulator::~GeneratorSimulator() {
-    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        running_ = false;
+    }
     state_cv_.notify_all();
 
     if (status_thread_.joinable()) {
         status_thread_.join();
     }
 
+    // Exposure threads are detached; wait until none references this
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        state_cv_.wait(lock, [this]() { return active_exposures_ == 0; });
+    }
+
     spdlog::info("[GeneratorSimulator] Destroyed");
 }
 
@@ -78,9 +87,7 @@ GeneratorSimulator::~GeneratorSimulator() {
 HvgStatus GeneratorSimulator::GetStatus() {
     std::lock_guard<std::mutex> lock(state_mutex_);
 
-    current_status_.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    current_status_.timestamp_us = infra::SinceStartUs();
 
     return current_status_;
 }
@@ -129,8 +136,15 @@ ExposureResult GeneratorSimulator::StartExposure() {
     // Simulate arm latency
     std::this_thread::sleep_for(config_.response_latency);
 
-    // Start exposure in background thread
-    state_.store(GeneratorState::GEN_EXPOSING);
+    // Start exposure in background thread (unless aborted while arming)
+    GeneratorState armed = GeneratorState::GEN_ARMED;
+    if (!state_.compare_exchange_strong(armed, GeneratorState::GEN_EXPOSING)) {
+        fast_aborted_.store(false);
+        current_status_.state = state_.load();
+        NotifyStatusCallbacks(current_status_);
+        spdlog::info("[GeneratorSimulator] Exposure aborted while arming");
+        return ExposureResult{false, 0, 0, 0, 0, "Aborted"};
+    }
     current_status_.state = GeneratorState::GEN_EXPOSING;
     current_status_.actual_kvp = current_params_.kvp;
     current_status_.actual_ma = current_params_.ma;
@@ -140,8 +154,11 @@ ExposureResult GeneratorSimulator::StartExposure() {
 
     // Simulate exposure in background
     int32_t duration_ms = static_cast<int32_t>(current_params_.ms);
-    std::thread([this, duration_ms]() {
-        SimulateExposure(duration_ms);
+    uint64_t sequence = ++exposure_seq_;
+    ++active_exposures_;
+    std::thread([this, duration_ms, sequence]() {
+        infra::ApplyNamedThreadPolicy(kThreadGeneratorExposure);
+        SimulateExposure(duration_ms, sequence);
     }).detach();
 
     spdlog::info("[GeneratorSimulator] Exposure started: kvp={}, ma={}, ms={}ms",
@@ -175,6 +192,24 @@ void GeneratorSimulator::AbortExposure() {
     current_status_.actual_ma = 0.0f;
 
     NotifyStatusCallbacks(current_status_);
+    state_cv_.notify_all();
+}
+
+bool GeneratorSimulator::FastAbortExposure() noexcept {
+    GeneratorState expected = GeneratorState::GEN_EXPOSING;
+    if (!state_.compare_exchange_strong(expected, GeneratorState::GEN_IDLE)) {
+        expected = GeneratorState::GEN_ARMED;
+        if (!state_.compare_exchange_strong(expected, GeneratorState::GEN_IDLE)) {
+            return false;
+        }
+    }
+    fast_aborted_.store(true);
+    state_cv_.notify_all();
+    return true;
+}
+
+void GeneratorSimulator::AecAbortHandler(void* context, const AecTerminationEvent& /*event*/) {
+    static_cast<GeneratorSimulator*>(context)->FastAbortExposure();
 }
 
 void GeneratorSimulator::RegisterAlarmCallback(AlarmCallback callback) {
@@ -206,9 +241,7 @@ void GeneratorSimulator::GenerateTestAlarm(
     alarm.alarm_code = alarm_code;
     alarm.description = description;
     alarm.severity = severity;
-    alarm.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    alarm.timestamp_us = infra::SinceStartUs();
 
     spdlog::info("[GeneratorSimulator] Test alarm generated: code={}, desc={}, severity={}",
                  alarm_code, description, static_cast<int>(severity));
@@ -249,6 +282,11 @@ bool GeneratorSimulator::ValidateParams(const ExposureParams& params) {
 }
 
 void GeneratorSimulator::StatusUpdateThread() {
+    infra::ThreadPolicyReport report = infra::ApplyNamedThreadPolicy(kThreadGeneratorStatus);
+    if (!report.AllApplied()) {
+        spdlog::warn("[GeneratorSimulator] Status thread policy not fully applied (sched={}, affinity={})",
+                     static_cast<int>(report.scheduling), static_cast<int>(report.affinity));
+    }
     spdlog::debug("[GeneratorSimulator] Status update thread started");
 
     while (running_.load()) {
@@ -267,9 +305,7 @@ void GeneratorSimulator::StatusUpdateThread() {
 
         // Update status
         lock.lock();
-        current_status_.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
+        current_status_.timestamp_us = infra::SinceStartUs();
 
         NotifyStatusCallbacks(current_status_);
         lock.unlock();
@@ -278,19 +314,33 @@ void GeneratorSimulator::StatusUpdateThread() {
     spdlog::debug("[GeneratorSimulator] Status update thread stopped");
 }
 
-void GeneratorSimulator::SimulateExposure(int32_t duration_ms) {
-    // Simulate exposure for specified duration
-    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
-
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    state_.store(GeneratorState::GEN_IDLE);
-    current_status_.state = GeneratorState::GEN_IDLE;
-    current_status_.actual_kvp = 0.0f;
-    current_status_.actual_ma = 0.0f;
-
-    spdlog::info("[GeneratorSimulator] Exposure completed after {}ms", duration_ms);
+void GeneratorSimulator::SimulateExposure(int32_t duration_ms, uint64_t sequence) {
+    // Simulate exposure for specified duration; an abort ends it early
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    state_cv_.wait_for(lock, std::chrono::milliseconds(duration_ms), [this, sequence]() {
+        return !running_.load() || exposure_seq_ != sequence ||
+               state_.load() != GeneratorState::GEN_EXPOSING;
+    });
+
+    if (exposure_seq_ == sequence) {
+        GeneratorState expected = GeneratorState::GEN_EXPOSING;
+        bool completed = state_.compare_exchange_strong(expected, GeneratorState::GEN_IDLE);
+        bool fast_aborted = fast_aborted_.exchange(false);
+        if (completed || fast_aborted) {
+            current_status_.state = GeneratorState::GEN_IDLE;
+            current_status_.actual_kvp = 0.0f;
+            current_status_.actual_ma = 0.0f;
+            if (completed) {
+                spdlog::info("[GeneratorSimulator] Exposure completed after {}ms", duration_ms);
+            } else {
+                spdlog::info("[GeneratorSimulator] Exposure aborted (AEC abort line)");
+            }
+            NotifyStatusCallbacks(current_status_);
+        }
+    }
 
-    NotifyStatusCallbacks(current_status_);
+    --active_exposures_;
+    state_cv_.notify_all();
 }
 
 void GeneratorSimulator::NotifyStatusCallbacks(const HvgStatus& status) {
@@ -0,0 +1,281 @@
+/**
+ * @file HvgProtocol.cpp
+ * @brief HVG serial link framing, message payloads and incremental parser
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "generator/HvgProtocol.h"
+
+#include <cmath>
+
+namespace hnvue::hal::hvg {
+
+namespace {
+
+void PutU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void PutU32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint16_t GetU16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t GetU32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/// Non-negative quantity to fixed point (negative values clamp to 0)
+uint32_t ToFixed(float value, float scale) {
+    return value <= 0.0f ? 0u : static_cast<uint32_t>(std::lround(value * scale));
+}
+
+float FromFixed(uint32_t value, float scale) {
+    return static_cast<float>(value) / scale;
+}
+
+constexpr float kScale10 = 10.0f;
+constexpr float kScale100 = 100.0f;
+
+/// Copy a name into a NUL-terminated field; @return bytes written or 0
+size_t PutString(const std::string& text, uint8_t* out, size_t capacity) {
+    if (text.size() + 1 > capacity) {
+        return 0;
+    }
+    std::memcpy(out, text.data(), text.size());
+    out[text.size()] = 0;
+    return text.size() + 1;
+}
+
+/// Read a NUL-terminated field; @return bytes consumed or 0
+size_t GetString(const uint8_t* in, size_t size, std::string& text) {
+    const void* nul = std::memchr(in, 0, size);
+    if (nul == nullptr) {
+        return 0;
+    }
+    size_t length = static_cast<size_t>(static_cast<const uint8_t*>(nul) - in);
+    text.assign(reinterpret_cast<const char*>(in), length);
+    return length + 1;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Framing
+// =============================================================================
+
+uint16_t Crc16(const uint8_t* data, size_t size) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t EncodeFrame(MessageId id, uint8_t seq, const uint8_t* payload, size_t length, uint8_t* out) {
+    if (length > kMaxPayload) {
+        return 0;
+    }
+    out[0] = kStx;
+    out[1] = static_cast<uint8_t>(length);
+    out[2] = static_cast<uint8_t>(id);
+    out[3] = seq;
+    if (length > 0) {
+        std::memcpy(out + 4, payload, length);
+    }
+    PutU16(out + 4 + length, Crc16(out + 1, length + 3));
+    out[6 + length] = kEtx;
+    return length + kFrameOverhead;
+}
+
+bool AppendFrame(std::vector<uint8_t>& out, MessageId id, uint8_t seq, const uint8_t* payload,
+                 size_t length) {
+    if (length > kMaxPayload) {
+        return false;
+    }
+    const size_t offset = out.size();
+    out.resize(offset + length + kFrameOverhead);
+    EncodeFrame(id, seq, payload, length, out.data() + offset);
+    return true;
+}
+
+FrameParser::Check FrameParser::Validate(const uint8_t* frame, size_t total) {
+    if (frame[total - 1] != kEtx) {
+        return Check::FRAMING;
+    }
+    const size_t length = total - kFrameOverhead;
+    if (GetU16(frame + 4 + length) != Crc16(frame + 1, length + 3)) {
+        return Check::CRC;
+    }
+    return Check::OK;
+}
+
+// =============================================================================
+// Payloads
+// =============================================================================
+
+size_t EncodeParams(const ExposureParams& params, uint8_t* out) {
+    PutU16(out, static_cast<uint16_t>(ToFixed(params.kvp, kScale10)));
+    PutU32(out + 2, ToFixed(params.ma, kScale10));
+    PutU32(out + 6, ToFixed(params.ms, kScale10));
+    out[10] = static_cast<uint8_t>(params.aec_mode);
+    out[11] = params.focus == "small" ? 1 : 0;
+    return kParamsSize;
+}
+
+bool DecodeParams(const FrameView& frame, ExposureParams& params) {
+    if (frame.length != kParamsSize) {
+        return false;
+    }
+    params.kvp = FromFixed(GetU16(frame.payload), kScale10);
+    params.ma = FromFixed(GetU32(frame.payload + 2), kScale10);
+    params.ms = FromFixed(GetU32(frame.payload + 6), kScale10);
+    params.aec_mode = static_cast<AecMode>(frame.payload[10]);
+    params.focus = frame.payload[11] == 1 ? "small" : "large";
+    return true;
+}
+
+size_t EncodeAck(MessageId acked, AckResult result, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(acked);
+    out[1] = static_cast<uint8_t>(result);
+    return kAckSize;
+}
+
+bool DecodeAck(const FrameView& frame, MessageId& acked, AckResult& result) {
+    if (frame.length != kAckSize) {
+        return false;
+    }
+    acked = static_cast<MessageId>(frame.payload[0]);
+    result = static_cast<AckResult>(frame.payload[1]);
+    return true;
+}
+
+size_t EncodeStatus(const HvgStatus& status, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(status.state);
+    out[1] = status.interlock_ok ? 1 : 0;
+    PutU16(out + 2, static_cast<uint16_t>(ToFixed(status.actual_kvp, kScale10)));
+    PutU32(out + 4, ToFixed(status.actual_ma, kScale10));
+    return kStatusSize;
+}
+
+bool DecodeStatus(const FrameView& frame, HvgStatus& status) {
+    if (frame.length != kStatusSize) {
+        return false;
+    }
+    status.state = static_cast<GeneratorState>(frame.payload[0]);
+    status.interlock_ok = frame.payload[1] != 0;
+    status.actual_kvp = FromFixed(GetU16(frame.payload + 2), kScale10);
+    status.actual_ma = FromFixed(GetU32(frame.payload + 4), kScale10);
+    return true;
+}
+
+size_t EncodeAlarm(const HvgAlarm& alarm, uint8_t* out, size_t capacity) {
+    if (capacity < 7) {
+        return 0;
+    }
+    PutU32(out, static_cast<uint32_t>(alarm.alarm_code));
+    out[4] = static_cast<uint8_t>(alarm.severity);
+    size_t text = PutString(alarm.description, out + 5, std::min(capacity, kMaxPayload) - 5);
+    return text == 0 ? 0 : 5 + text;
+}
+
+bool DecodeAlarm(const FrameView& frame, HvgAlarm& alarm) {
+    if (frame.length < 6) {
+        return false;
+    }
+    alarm.alarm_code = static_cast<int32_t>(GetU32(frame.payload));
+    alarm.severity = static_cast<AlarmSeverity>(frame.payload[4]);
+    return GetString(frame.payload + 5, frame.length - 5, alarm.description) != 0;
+}
+
+size_t EncodeExposureDone(const ExposureResult& result, uint8_t* out) {
+    PutU16(out, static_cast<uint16_t>(ToFixed(result.actual_kvp, kScale10)));
+    PutU32(out + 2, ToFixed(result.actual_ma, kScale10));
+    PutU32(out + 6, ToFixed(result.actual_ms, kScale10));
+    PutU32(out + 10, ToFixed(result.actual_mas, kScale100));
+    return kExposureDoneSize;
+}
+
+bool DecodeExposureDone(const FrameView& frame, ExposureResult& result) {
+    if (frame.length != kExposureDoneSize) {
+        return false;
+    }
+    result.success = true;
+    result.actual_kvp = FromFixed(GetU16(frame.payload), kScale10);
+    result.actual_ma = FromFixed(GetU32(frame.payload + 2), kScale10);
+    result.actual_ms = FromFixed(GetU32(frame.payload + 6), kScale10);
+    result.actual_mas = FromFixed(GetU32(frame.payload + 10), kScale100);
+    return true;
+}
+
+/// Fixed part: kV min/max (2 x u16), mA and ms min/max (4 x u32), flags
+constexpr size_t kCapabilitiesFixed = 21;
+
+size_t EncodeCapabilities(const HvgCapabilities& caps, uint8_t* out, size_t capacity) {
+    capacity = std::min(capacity, kMaxPayload);
+    if (capacity < kCapabilitiesFixed) {
+        return 0;
+    }
+    PutU16(out, static_cast<uint16_t>(ToFixed(caps.min_kvp, kScale10)));
+    PutU16(out + 2, static_cast<uint16_t>(ToFixed(caps.max_kvp, kScale10)));
+    PutU32(out + 4, ToFixed(caps.min_ma, kScale10));
+    PutU32(out + 8, ToFixed(caps.max_ma, kScale10));
+    PutU32(out + 12, ToFixed(caps.min_ms, kScale10));
+    PutU32(out + 16, ToFixed(caps.max_ms, kScale10));
+    out[20] = static_cast<uint8_t>((caps.has_aec ? 1 : 0) | (caps.has_dual_focus ? 2 : 0));
+
+    size_t pos = kCapabilitiesFixed;
+    for (const std::string* text : {&caps.vendor_name, &caps.model_name, &caps.firmware_version}) {
+        size_t written = PutString(*text, out + pos, capacity - pos);
+        if (written == 0) {
+            return 0;
+        }
+        pos += written;
+    }
+    return pos;
+}
+
+bool DecodeCapabilities(const FrameView& frame, HvgCapabilities& caps) {
+    if (frame.length < kCapabilitiesFixed + 3) {
+        return false;
+    }
+    const uint8_t* in = frame.payload;
+    caps.min_kvp = FromFixed(GetU16(in), kScale10);
+    caps.max_kvp = FromFixed(GetU16(in + 2), kScale10);
+    caps.min_ma = FromFixed(GetU32(in + 4), kScale10);
+    caps.max_ma = FromFixed(GetU32(in + 8), kScale10);
+    caps.min_ms = FromFixed(GetU32(in + 12), kScale10);
+    caps.max_ms = FromFixed(GetU32(in + 16), kScale10);
+    caps.has_aec = (in[20] & 1) != 0;
+    caps.has_dual_focus = (in[20] & 2) != 0;
+
+    size_t pos = kCapabilitiesFixed;
+    for (std::string* text : {&caps.vendor_name, &caps.model_name, &caps.firmware_version}) {
+        size_t consumed = GetString(in + pos, frame.length - pos, *text);
+        if (consumed == 0) {
+            return false;
+        }
+        pos += consumed;
+    }
+    return true;
+}
+
+} // namespace hnvue::hal::hvg
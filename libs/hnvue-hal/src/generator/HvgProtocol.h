@@ -0,0 +1,308 @@
+/**
+ * @file HvgProtocol.h
+ * @brief HVG serial link framing, message payloads and incremental parser
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ *
+ * Frame layout (all multi-byte fields little-endian):
+ *
+ *   STX(0x02) LEN CMD SEQ PAYLOAD[LEN] CRC16 ETX(0x03)
+ *
+ * CRC16 is CRC-16/CCITT-FALSE over LEN..PAYLOAD. SEQ matches a request to
+ * its ACK or response; a generator re-acknowledges a repeated SEQ without
+ * executing it again, so requests can be retransmitted safely.
+ *
+ * Physical quantities are fixed point: kV and mA x10, ms x10, mAs x100.
+ */
+
+#ifndef HNUE_HAL_HVG_PROTOCOL_H
+#define HNUE_HAL_HVG_PROTOCOL_H
+
+#include "hnvue/hal/HalTypes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace hnvue::hal::hvg {
+
+// =============================================================================
+// Framing
+// =============================================================================
+
+constexpr uint8_t kStx = 0x02;
+constexpr uint8_t kEtx = 0x03;
+constexpr size_t kMaxPayload = 255;
+
+/// STX + LEN + CMD + SEQ + CRC16 + ETX
+constexpr size_t kFrameOverhead = 7;
+constexpr size_t kMaxFrameSize = kMaxPayload + kFrameOverhead;
+
+/**
+ * @brief Message identifiers
+ */
+enum class MessageId : uint8_t {
+    // Host -> generator
+    SET_PARAMS = 0x10,
+    START_EXPOSURE = 0x11,
+    ABORT_EXPOSURE = 0x12,
+    GET_STATUS = 0x13,
+    GET_CAPABILITIES = 0x14,
+
+    // Generator -> host
+    ACK = 0x80,
+    STATUS = 0x81,
+    ALARM = 0x82,
+    EXPOSURE_DONE = 0x83,
+    CAPABILITIES = 0x84
+};
+
+/**
+ * @brief ACK result codes
+ */
+enum class AckResult : uint8_t {
+    OK = 0,
+    REJECTED = 1,          ///< Parameters out of range
+    INVALID_STATE = 2,     ///< Not allowed in the current generator state
+    UNKNOWN_COMMAND = 3
+};
+
+/**
+ * @brief One received frame; payload points into the receive buffer
+ *
+ * Valid only for the duration of the frame handler.
+ */
+struct FrameView {
+    MessageId id = MessageId::ACK;
+    uint8_t seq = 0;
+    const uint8_t* payload = nullptr;
+    size_t length = 0;
+};
+
+/**
+ * @brief CRC-16/CCITT-FALSE
+ */
+uint16_t Crc16(const uint8_t* data, size_t size);
+
+/**
+ * @brief Encode one frame
+ * @param out Buffer of at least length + kFrameOverhead bytes
+ * @return Frame size, or 0 if the payload exceeds kMaxPayload
+ */
+size_t EncodeFrame(MessageId id, uint8_t seq, const uint8_t* payload, size_t length, uint8_t* out);
+
+/**
+ * @brief Append one encoded frame to a write batch
+ */
+bool AppendFrame(std::vector<uint8_t>& out, MessageId id, uint8_t seq, const uint8_t* payload,
+                 size_t length);
+
+// =============================================================================
+// Payloads
+// =============================================================================
+
+/// SET_PARAMS payload size
+constexpr size_t kParamsSize = 12;
+/// STATUS payload size
+constexpr size_t kStatusSize = 8;
+/// EXPOSURE_DONE payload size
+constexpr size_t kExposureDoneSize = 14;
+/// ACK payload size
+constexpr size_t kAckSize = 2;
+
+size_t EncodeParams(const ExposureParams& params, uint8_t* out);
+bool DecodeParams(const FrameView& frame, ExposureParams& params);
+
+size_t EncodeAck(MessageId acked, AckResult result, uint8_t* out);
+bool DecodeAck(const FrameView& frame, MessageId& acked, AckResult& result);
+
+size_t EncodeStatus(const HvgStatus& status, uint8_t* out);
+bool DecodeStatus(const FrameView& frame, HvgStatus& status);
+
+/// @return 0 if the description does not fit
+size_t EncodeAlarm(const HvgAlarm& alarm, uint8_t* out, size_t capacity);
+bool DecodeAlarm(const FrameView& frame, HvgAlarm& alarm);
+
+size_t EncodeExposureDone(const ExposureResult& result, uint8_t* out);
+bool DecodeExposureDone(const FrameView& frame, ExposureResult& result);
+
+/// @return 0 if the name strings do not fit
+size_t EncodeCapabilities(const HvgCapabilities& caps, uint8_t* out, size_t capacity);
+bool DecodeCapabilities(const FrameView& frame, HvgCapabilities& caps);
+
+// =============================================================================
+// Incremental Parser
+// =============================================================================
+
+/**
+ * @brief Parser counters
+ */
+struct ParserStats {
+    uint64_t frames = 0;
+    uint64_t reassembled = 0;      ///< Frames that straddled two reads (copied)
+    uint64_t crc_errors = 0;
+    uint64_t framing_errors = 0;   ///< Missing ETX
+    uint64_t discarded_bytes = 0;  ///< Bytes outside any frame
+};
+
+/**
+ * @brief Incremental frame parser over arbitrary read chunks
+ *
+ * Frames that lie entirely within one chunk are reported in place (no
+ * copy); only a frame split across reads is assembled in a fixed internal
+ * buffer. A candidate STX followed by an unknown CMD is treated as noise at
+ * once; a corrupt frame is skipped by resynchronizing on the next STX.
+ * Single-threaded (the I/O thread).
+ */
+class FrameParser {
+public:
+    /**
+     * @brief Parse one chunk
+     * @param on_frame Called as on_frame(const FrameView&) for each valid frame
+     */
+    template <typename Handler>
+    void Feed(const uint8_t* data, size_t size, Handler&& on_frame) {
+        size_t pos = 0;
+        while (pos < size) {
+            if (partial_size_ > 0) {
+                pos += CompletePartial(data + pos, size - pos, on_frame);
+            } else {
+                Scan(data + pos, size - pos, on_frame);
+                pos = size;
+            }
+        }
+    }
+
+    void Reset() { partial_size_ = 0; }
+
+    const ParserStats& GetStats() const { return stats_; }
+
+private:
+    enum class Check { OK, CRC, FRAMING };
+
+    static Check Validate(const uint8_t* frame, size_t total);
+
+    /// STX + LEN + CMD, enough to reject a false STX before waiting on LEN
+    static constexpr size_t kHeaderSize = 3;
+
+    static bool IsKnownId(uint8_t id) {
+        return (id >= 0x10 && id <= 0x14) || (id >= 0x80 && id <= 0x84);
+    }
+
+    template <typename Handler>
+    void Emit(const uint8_t* frame, size_t total, Handler& on_frame) {
+        FrameView view;
+        view.id = static_cast<MessageId>(frame[2]);
+        view.seq = frame[3];
+        view.payload = frame + 4;
+        view.length = total - kFrameOverhead;
+        ++stats_.frames;
+        on_frame(view);
+    }
+
+    void Reject(Check check) {
+        if (check == Check::CRC) {
+            ++stats_.crc_errors;
+        } else {
+            ++stats_.framing_errors;
+        }
+    }
+
+    /// Parse frames in place; an incomplete tail is kept in partial_
+    template <typename Handler>
+    void Scan(const uint8_t* data, size_t size, Handler& on_frame) {
+        size_t pos = 0;
+        while (pos < size) {
+            const void* stx = std::memchr(data + pos, kStx, size - pos);
+            if (stx == nullptr) {
+                stats_.discarded_bytes += size - pos;
+                return;
+            }
+            const size_t start = static_cast<size_t>(static_cast<const uint8_t*>(stx) - data);
+            stats_.discarded_bytes += start - pos;
+            pos = start;
+
+            const size_t available = size - pos;
+            if (available >= kHeaderSize && !IsKnownId(data[pos + 2])) {
+                ++stats_.discarded_bytes;   // STX value inside noise or payload
+                ++pos;
+                continue;
+            }
+            if (available < kHeaderSize || available < data[pos + 1] + kFrameOverhead) {
+                std::memcpy(partial_.data(), data + pos, available);
+                partial_size_ = available;
+                return;
+            }
+            const size_t total = data[pos + 1] + kFrameOverhead;
+            Check check = Validate(data + pos, total);
+            if (check == Check::OK) {
+                Emit(data + pos, total, on_frame);
+                pos += total;
+            } else {
+                Reject(check);
+                ++stats_.discarded_bytes;
+                ++pos;   // Resynchronize on the next STX
+            }
+        }
+    }
+
+    /// Extend the split frame; @return bytes consumed from data
+    template <typename Handler>
+    size_t CompletePartial(const uint8_t* data, size_t size, Handler& on_frame) {
+        size_t consumed = 0;
+        while (partial_size_ < kHeaderSize && consumed < size) {
+            partial_[partial_size_++] = data[consumed++];
+        }
+        if (partial_size_ < kHeaderSize) {
+            return consumed;
+        }
+        if (!IsKnownId(partial_[2])) {
+            ++stats_.discarded_bytes;
+            Rescan(partial_size_, on_frame);
+            return consumed;
+        }
+        const size_t total = partial_[1] + kFrameOverhead;
+        const size_t take = std::min(total - partial_size_, size - consumed);
+        std::memcpy(partial_.data() + partial_size_, data + consumed, take);
+        partial_size_ += take;
+        consumed += take;
+        if (partial_size_ < total) {
+            return consumed;
+        }
+
+        partial_size_ = 0;
+        Check check = Validate(partial_.data(), total);
+        if (check == Check::OK) {
+            ++stats_.reassembled;
+            Emit(partial_.data(), total, on_frame);
+        } else {
+            Reject(check);
+            ++stats_.discarded_bytes;
+            Rescan(total, on_frame);
+        }
+        return consumed;
+    }
+
+    /// Drop the bad STX and scan the rest of the held bytes again
+    template <typename Handler>
+    void Rescan(size_t held, Handler& on_frame) {
+        partial_size_ = 0;
+        std::array<uint8_t, kMaxFrameSize> rescan;
+        std::memcpy(rescan.data(), partial_.data() + 1, held - 1);
+        Scan(rescan.data(), held - 1, on_frame);
+    }
+
+    std::array<uint8_t, kMaxFrameSize> partial_{};
+    size_t partial_size_ = 0;
+    ParserStats stats_;
+};
+
+} // namespace hnvue::hal::hvg
+
+#endif // HNUE_HAL_HVG_PROTOCOL_H
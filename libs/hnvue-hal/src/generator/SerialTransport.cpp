@@ -0,0 +1,339 @@
+/**
+ * @file SerialTransport.cpp
+ * @brief Non-blocking serial port transport with an epoll event loop
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "generator/SerialTransport.h"
+
+#include "hnvue/hal/HalThreads.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <termios.h>
+    #include <unistd.h>
+#endif
+
+namespace hnvue::hal {
+
+#ifdef __linux__
+
+namespace {
+
+/// Batches above this size are released after writing
+constexpr size_t kOutputRetainBytes = 64 * 1024;
+
+bool BaudConstant(int32_t baud_rate, speed_t& speed) {
+    switch (baud_rate) {
+        case 9600:   speed = B9600;   return true;
+        case 19200:  speed = B19200;  return true;
+        case 38400:  speed = B38400;  return true;
+        case 57600:  speed = B57600;  return true;
+        case 115200: speed = B115200; return true;
+        case 230400: speed = B230400; return true;
+        case 460800: speed = B460800; return true;
+        case 921600: speed = B921600; return true;
+        default:     return false;
+    }
+}
+
+/// Raw 8N1, no flow control, non-canonical
+bool ConfigureTty(int fd, speed_t speed) {
+    termios tty{};
+    if (tcgetattr(fd, &tty) != 0) {
+        return false;
+    }
+    cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cflag &= ~(CSTOPB | CRTSCTS | PARENB);
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+    if (cfsetispeed(&tty, speed) != 0 || cfsetospeed(&tty, speed) != 0) {
+        return false;
+    }
+    if (tcsetattr(fd, TCSANOW, &tty) != 0) {
+        return false;
+    }
+    tcflush(fd, TCIOFLUSH);
+    return true;
+}
+
+void CloseFd(int& fd) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+} // anonymous namespace
+
+#endif
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+SerialTransport::~SerialTransport() {
+    Close();
+}
+
+bool SerialTransport::Open(const SerialConfig& config, FrameHandler on_frame, BatchSource source) {
+#ifdef __linux__
+    if (IsOpen() || !on_frame || !source) {
+        return false;
+    }
+    speed_t speed;
+    if (!BaudConstant(config.baud_rate, speed)) {
+        spdlog::error("[SerialTransport] Unsupported baud rate {}", config.baud_rate);
+        return false;
+    }
+
+    fd_ = ::open(config.port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        spdlog::error("[SerialTransport] Cannot open {}: {}", config.port, std::strerror(errno));
+        return false;
+    }
+    if (!ConfigureTty(fd_, speed)) {
+        spdlog::error("[SerialTransport] Cannot configure {}: {}", config.port, std::strerror(errno));
+        CloseFd(fd_);
+        return false;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || event_fd_ < 0) {
+        spdlog::error("[SerialTransport] epoll/eventfd setup failed: {}", std::strerror(errno));
+        CloseFd(event_fd_);
+        CloseFd(epoll_fd_);
+        CloseFd(fd_);
+        return false;
+    }
+    epoll_event wake{};
+    wake.events = EPOLLIN;
+    wake.data.fd = event_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &wake);
+    epoll_event tty{};
+    tty.events = EPOLLIN;
+    tty.data.fd = fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd_, &tty);
+
+    on_frame_ = std::move(on_frame);
+    source_ = std::move(source);
+    parser_.Reset();
+    output_.clear();
+    output_offset_ = 0;
+    want_output_ = false;
+
+    connected_.store(true, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this]() { EventLoop(); });
+    spdlog::info("[SerialTransport] Opened {} at {} baud", config.port, config.baud_rate);
+    return true;
+#else
+    (void)config;
+    (void)on_frame;
+    (void)source;
+    spdlog::error("[SerialTransport] Serial transport requires Linux epoll");
+    return false;
+#endif
+}
+
+void SerialTransport::Close() {
+#ifdef __linux__
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    RequestWrite();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    CloseFd(event_fd_);
+    CloseFd(epoll_fd_);
+    CloseFd(fd_);
+    connected_.store(false, std::memory_order_release);
+#endif
+}
+
+void SerialTransport::RequestWrite() {
+#ifdef __linux__
+    uint64_t one = 1;
+    if (event_fd_ >= 0) {
+        ssize_t written = ::write(event_fd_, &one, sizeof(one));
+        (void)written;   // Counter saturation still leaves the fd readable
+    }
+#endif
+}
+
+SerialTransportStats SerialTransport::GetStats() const {
+    SerialTransportStats stats;
+    stats.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    stats.write_calls = write_calls_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.max_batch_bytes = max_batch_bytes_.load(std::memory_order_relaxed);
+    stats.parser.frames = frames_.load(std::memory_order_relaxed);
+    stats.parser.reassembled = reassembled_.load(std::memory_order_relaxed);
+    stats.parser.crc_errors = crc_errors_.load(std::memory_order_relaxed);
+    stats.parser.framing_errors = framing_errors_.load(std::memory_order_relaxed);
+    stats.parser.discarded_bytes = discarded_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// =============================================================================
+// I/O Thread
+// =============================================================================
+
+#ifdef __linux__
+
+void SerialTransport::EventLoop() {
+    infra::ApplyNamedThreadPolicy(kThreadGeneratorIo);
+
+    std::array<epoll_event, 4> events;
+    while (running_.load(std::memory_order_acquire)) {
+        int count = epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            spdlog::error("[SerialTransport] epoll_wait failed: {}", std::strerror(errno));
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            const epoll_event& event = events[i];
+            if (event.data.fd == event_fd_) {
+                uint64_t counter;
+                ssize_t drained = ::read(event_fd_, &counter, sizeof(counter));
+                (void)drained;
+                CollectAndWrite();
+                continue;
+            }
+            if (event.events & EPOLLIN) {
+                ReadInput();
+            }
+            if (event.events & EPOLLOUT) {
+                FlushOutput();
+            }
+            if (event.events & (EPOLLHUP | EPOLLERR)) {
+                Disconnect();
+            }
+        }
+    }
+}
+
+void SerialTransport::CollectAndWrite() {
+    const size_t before = output_.size() - output_offset_;
+    source_(output_);
+    const size_t batch = output_.size() - output_offset_ - before;
+    if (batch == 0) {
+        return;
+    }
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    if (batch > max_batch_bytes_.load(std::memory_order_relaxed)) {
+        max_batch_bytes_.store(batch, std::memory_order_relaxed);
+    }
+    if (!connected_.load(std::memory_order_acquire)) {
+        output_.clear();
+        output_offset_ = 0;
+        return;
+    }
+    FlushOutput();
+}
+
+void SerialTransport::FlushOutput() {
+    while (output_offset_ < output_.size()) {
+        ssize_t written = ::write(fd_, output_.data() + output_offset_, output_.size() - output_offset_);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                spdlog::error("[SerialTransport] write failed: {}", std::strerror(errno));
+                output_offset_ = output_.size();
+            }
+            break;
+        }
+        write_calls_.fetch_add(1, std::memory_order_relaxed);
+        bytes_written_.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+        output_offset_ += static_cast<size_t>(written);
+    }
+
+    if (output_offset_ == output_.size()) {
+        output_.clear();
+        output_offset_ = 0;
+        if (output_.capacity() > kOutputRetainBytes) {
+            output_.shrink_to_fit();
+        }
+    }
+    UpdateInterest();
+}
+
+void SerialTransport::UpdateInterest() {
+    // Poll for writability only while output is pending
+    const bool pending = output_offset_ < output_.size();
+    if (pending == want_output_ || !connected_.load(std::memory_order_acquire)) {
+        return;
+    }
+    epoll_event tty{};
+    tty.events = EPOLLIN | (pending ? EPOLLOUT : 0u);
+    tty.data.fd = fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd_, &tty);
+    want_output_ = pending;
+}
+
+void SerialTransport::Disconnect() {
+    // Device gone; stop polling it so the loop does not spin
+    if (connected_.exchange(false, std::memory_order_acq_rel)) {
+        spdlog::error("[SerialTransport] Port hung up or reported an error");
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd_, nullptr);
+    }
+}
+
+void SerialTransport::ReadInput() {
+    while (true) {
+        ssize_t received = ::read(fd_, input_.data(), input_.size());
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            Disconnect();
+            break;
+        }
+        if (received <= 0) {
+            break;
+        }
+        bytes_read_.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+        parser_.Feed(input_.data(), static_cast<size_t>(received),
+                     [this](const hvg::FrameView& frame) { on_frame_(frame); });
+    }
+
+    const hvg::ParserStats& stats = parser_.GetStats();
+    frames_.store(stats.frames, std::memory_order_relaxed);
+    reassembled_.store(stats.reassembled, std::memory_order_relaxed);
+    crc_errors_.store(stats.crc_errors, std::memory_order_relaxed);
+    framing_errors_.store(stats.framing_errors, std::memory_order_relaxed);
+    discarded_bytes_.store(stats.discarded_bytes, std::memory_order_relaxed);
+}
+
+#else
+
+void SerialTransport::EventLoop() {}
+void SerialTransport::CollectAndWrite() {}
+void SerialTransport::FlushOutput() {}
+void SerialTransport::ReadInput() {}
+void SerialTransport::Disconnect() {}
+void SerialTransport::UpdateInterest() {}
+
+#endif
+
+} // namespace hnvue::hal
@@ -0,0 +1,135 @@
+/**
+ * @file SerialTransport.h
+ * @brief Non-blocking serial port transport with an epoll event loop
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ *
+ * One I/O thread per port multiplexes the tty (raw termios, O_NONBLOCK)
+ * and an eventfd used to request writes. Received bytes are parsed in
+ * place by hvg::FrameParser; outgoing frames are collected from the owner
+ * in one batch per wake-up and written with as few write() calls as the
+ * tty accepts.
+ */
+
+#ifndef HNUE_HAL_SERIAL_TRANSPORT_H
+#define HNUE_HAL_SERIAL_TRANSPORT_H
+
+#include "generator/HvgProtocol.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Serial port settings
+ */
+struct SerialConfig {
+    std::string port;                  ///< e.g. "/dev/ttyS0"
+    int32_t baud_rate = 115200;        ///< 9600 ... 921600
+};
+
+/**
+ * @brief Transport counters
+ */
+struct SerialTransportStats {
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+    uint64_t write_calls = 0;
+    uint64_t batches = 0;              ///< Wake-ups that produced output
+    uint64_t max_batch_bytes = 0;
+    hvg::ParserStats parser;
+};
+
+/**
+ * @brief epoll-driven serial transport
+ *
+ * Thread Safety:
+ * - Open/Close from one control thread
+ * - RequestWrite from any thread
+ * - Frame handler and batch source run on the I/O thread
+ */
+class SerialTransport {
+public:
+    /// Receives each valid frame (view valid during the call)
+    using FrameHandler = std::function<void(const hvg::FrameView&)>;
+
+    /// Appends all pending outgoing frames to the batch
+    using BatchSource = std::function<void(std::vector<uint8_t>& batch)>;
+
+    SerialTransport() = default;
+    ~SerialTransport();
+
+    SerialTransport(const SerialTransport&) = delete;
+    SerialTransport& operator=(const SerialTransport&) = delete;
+
+    /**
+     * @brief Open and configure the port and start the I/O thread
+     * @return false if the port cannot be opened or the baud rate is unsupported
+     */
+    bool Open(const SerialConfig& config, FrameHandler on_frame, BatchSource source);
+
+    void Close();
+
+    bool IsOpen() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief True until the device hangs up or reports an error
+     */
+    bool IsConnected() const { return connected_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Wake the I/O thread to collect and write pending frames
+     */
+    void RequestWrite();
+
+    SerialTransportStats GetStats() const;
+
+private:
+    void EventLoop();
+    void CollectAndWrite();
+    void FlushOutput();
+    void ReadInput();
+    void Disconnect();
+    void UpdateInterest();
+
+    FrameHandler on_frame_;
+    BatchSource source_;
+
+    int fd_ = -1;
+    int epoll_fd_ = -1;
+    int event_fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> connected_{false};
+
+    // I/O thread only
+    hvg::FrameParser parser_;
+    std::array<uint8_t, 4096> input_{};
+    std::vector<uint8_t> output_;
+    size_t output_offset_ = 0;
+    bool want_output_ = false;
+
+    std::atomic<uint64_t> bytes_read_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> write_calls_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> max_batch_bytes_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> reassembled_{0};
+    std::atomic<uint64_t> crc_errors_{0};
+    std::atomic<uint64_t> framing_errors_{0};
+    std::atomic<uint64_t> discarded_bytes_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_SERIAL_TRANSPORT_H
@@ -14,11 +14,23 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <atomic>
 #include <filesystem>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 namespace hal = hnvue::hal;
 
+namespace {
+
+/// Suffix of private plugin copies, unique across loaders in the process
+std::atomic<uint32_t> g_isolated_loads{0};
+
+} // anonymous namespace
+
 // =============================================================================
 // PluginHandle Implementation
 // =============================================================================
@@ -148,8 +160,55 @@ std::shared_ptr<PluginHandle> DetectorPluginLoader::LoadPlugin(
         return nullptr;
     }
 
+    return LoadPluginLocked(plugin_path, plugin_path);
+}
+
+std::shared_ptr<PluginHandle> DetectorPluginLoader::LoadPluginIsolated(
+    const std::string& plugin_path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    spdlog::info("Loading isolated plugin image: {}", plugin_path);
+
+    last_error_ = PluginLoadError{};
+
+    if (!fs::exists(plugin_path)) {
+        SetLastError(PluginLoadResult::ERR_FILE_NOT_FOUND,
+                    "Plugin file not found", plugin_path);
+        return nullptr;
+    }
+
+#ifdef _WIN32
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    std::error_code ec;
+    fs::path copy_path = fs::temp_directory_path(ec) /
+        fmt::format("hnvue-plugin-{}-{}-{}", pid, ++g_isolated_loads,
+                    fs::path(plugin_path).filename().string());
+    if (ec || !fs::copy_file(plugin_path, copy_path,
+                             fs::copy_options::overwrite_existing, ec)) {
+        SetLastError(PluginLoadResult::ERR_FILE_NOT_FOUND,
+                    "Cannot copy plugin for isolated load: " + ec.message(), plugin_path);
+        return nullptr;
+    }
+
+    auto handle = LoadPluginLocked(plugin_path, copy_path.string());
+
+#ifndef _WIN32
+    // The mapping outlives the directory entry
+    fs::remove(copy_path, ec);
+#endif
+
+    return handle;
+}
+
+std::shared_ptr<PluginHandle> DetectorPluginLoader::LoadPluginLocked(
+    const std::string& plugin_path, const std::string& library_path)
+{
     // Load library
-    HLibrary lib = LoadLibrary(plugin_path);
+    HLibrary lib = LoadLibrary(library_path);
     if (lib == nullptr) {
         SetLastError(PluginLoadResult::ERR_FILE_NOT_FOUND,
                     "Failed to load DLL", plugin_path);
@@ -190,6 +190,25 @@ public:
      */
     std::shared_ptr<PluginHandle> LoadPlugin(const std::string& plugin_path);
 
+    /**
+     * @brief Load a private image of a plugin, even if the path is loaded
+     * @param plugin_path Path to plugin DLL file
+     * @return Shared pointer to PluginHandle, or nullptr on failure
+     *
+     * The dynamic linker hands back the already-mapped image when a path is
+     * opened twice, so a plugin replaced on disk would not be picked up by
+     * LoadPlugin() while its old instance is alive. This copies the file to
+     * a uniquely named temporary and loads that, giving the new instance its
+     * own code and statics next to the old one (used by HotSwapDetector).
+     * The copy is removed once mapped (POSIX; on Windows it stays in the
+     * temporary directory). The handle reports and is tracked under
+     * plugin_path, replacing any earlier entry.
+     *
+     * Thread Safety:
+     * - Thread-safe, internally synchronized
+     */
+    std::shared_ptr<PluginHandle> LoadPluginIsolated(const std::string& plugin_path);
+
     /**
      * @brief Unload plugin by handle pointer
      * @param handle Pointer to plugin handle (obtained from LoadPlugin)
@@ -214,6 +233,10 @@ public:
      * @param plugin_path Path to plugin DLL file
      * @return Shared pointer to new PluginHandle, or nullptr on failure
      *
+     * Synchronous: the caller waits for the full vendor initialisation.
+     * Use HotSwapDetector::StageReload() to reload while the current
+     * instance keeps serving.
+     *
      * Process:
      * 1. Find existing handle by plugin path
      * 2. Unload existing plugin if found
@@ -283,6 +306,15 @@ private:
     // Internal Helper Methods
     // =========================================================================
 
+    /**
+     * @brief Load, validate and instantiate a plugin; caller holds mutex_
+     * @param plugin_path Path the plugin is reported and tracked under
+     * @param library_path File actually loaded (plugin_path or a private copy)
+     * @return Shared pointer to PluginHandle, or nullptr on failure
+     */
+    std::shared_ptr<PluginHandle> LoadPluginLocked(const std::string& plugin_path,
+                                                   const std::string& library_path);
+
     /**
      * @brief Load DLL using platform-specific API
      * @param path Path to DLL file
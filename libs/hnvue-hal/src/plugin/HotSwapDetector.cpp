@@ -0,0 +1,224 @@
+/**
+ * @file HotSwapDetector.cpp
+ * @brief IDetector whose vendor plugin can be reloaded while it keeps serving
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin lifecycle
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "plugin/HotSwapDetector.h"
+
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
+
+#include <chrono>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+namespace {
+
+/// Poll interval while in-flight calls still hold the retired instance
+constexpr auto kDrainPoll = std::chrono::milliseconds(1);
+
+/// Longest wait for in-flight calls; the last holder then destroys it
+constexpr auto kDrainLimit = std::chrono::seconds(10);
+
+} // anonymous namespace
+
+// =============================================================================
+// Construction / Lifecycle
+// =============================================================================
+
+HotSwapDetector::HotSwapDetector(DetectorPluginLoader& loader,
+                                 std::shared_ptr<PluginHandle> plugin)
+    : loader_(loader)
+    , current_(std::move(plugin)) {
+    current_->GetDetector()->RegisterFrameCallback(
+        [this](const RawFrame& frame) { Dispatch(frame); });
+}
+
+HotSwapDetector::~HotSwapDetector() {
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        stopping_ = true;
+    }
+    reload_cv_.notify_all();
+    if (stage_thread_.joinable()) {
+        stage_thread_.join();
+    }
+    if (acquiring_) {
+        std::atomic_load(&current_)->GetDetector()->StopAcquisition();
+    }
+    // Before callbacks_ goes: the instance's threads call Dispatch()
+    std::atomic_store(&current_, std::shared_ptr<PluginHandle>());
+}
+
+bool HotSwapDetector::StageReload(const std::string& plugin_path) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (reload_pending_) {
+        spdlog::warn("[HotSwapDetector] Reload already in progress");
+        return false;
+    }
+    if (stage_thread_.joinable()) {
+        // Previous staging thread has finished (reload_pending_ cleared)
+        stage_thread_.join();
+    }
+    reload_pending_ = true;
+    stage_thread_ = std::thread(&HotSwapDetector::StageLoop, this, plugin_path);
+    return true;
+}
+
+bool HotSwapDetector::WaitForReload(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(control_mutex_);
+    return reload_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                               [this] { return !reload_pending_; });
+}
+
+std::shared_ptr<PluginHandle> HotSwapDetector::CurrentPlugin() const {
+    return std::atomic_load(&current_);
+}
+
+HotSwapStats HotSwapDetector::GetStats() const {
+    HotSwapStats stats;
+    stats.reloads_completed = reloads_completed_.load(std::memory_order_relaxed);
+    stats.reloads_failed = reloads_failed_.load(std::memory_order_relaxed);
+    stats.last_stage_us = last_stage_us_.load(std::memory_order_relaxed);
+    stats.last_swap_ns = last_swap_ns_.load(std::memory_order_relaxed);
+    stats.last_drain_us = last_drain_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// =============================================================================
+// Staging, Swap and Drain
+// =============================================================================
+
+void HotSwapDetector::StageLoop(std::string plugin_path) {
+    infra::ApplyNamedThreadPolicy(kThreadPluginStaging);
+
+    const int64_t stage_start_us = infra::MonotonicClock::NowUs();
+    std::shared_ptr<PluginHandle> plugin = loader_.LoadPluginIsolated(plugin_path);
+    if (!plugin || !plugin->GetDetector()) {
+        spdlog::error("[HotSwapDetector] Reload of {} failed, keeping current instance: {}",
+                      plugin_path, loader_.GetLastError().message);
+        reloads_failed_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            reload_pending_ = false;
+        }
+        reload_cv_.notify_all();
+        return;
+    }
+    plugin->GetDetector()->RegisterFrameCallback(
+        [this](const RawFrame& frame) { Dispatch(frame); });
+    last_stage_us_.store(infra::MonotonicClock::NowUs() - stage_start_us,
+                         std::memory_order_relaxed);
+    spdlog::info("[HotSwapDetector] Staged {} in {} us", plugin_path,
+                 last_stage_us_.load(std::memory_order_relaxed));
+
+    std::shared_ptr<PluginHandle> retired;
+    int64_t swapped_at_us = 0;
+    {
+        std::unique_lock<std::mutex> lock(control_mutex_);
+        staged_ = std::move(plugin);
+        if (!acquiring_ && !stopping_) {
+            SwapLocked();
+        }
+        // Otherwise StopAcquisition()/StartAcquisition() swaps
+        reload_cv_.wait(lock, [this] { return retired_ != nullptr || stopping_; });
+        if (!retired_) {
+            // Destroyed before the swap: the staged instance goes with us
+            staged_.reset();
+            reload_pending_ = false;
+            return;
+        }
+        retired = std::move(retired_);
+        swapped_at_us = swapped_at_us_;
+    }
+
+    // Drain: calls that loaded the old instance before the swap finish on it
+    const auto deadline = std::chrono::steady_clock::now() + kDrainLimit;
+    while (retired.use_count() > 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(kDrainPoll);
+    }
+    if (retired.use_count() > 1) {
+        spdlog::warn("[HotSwapDetector] Old instance still in use after {} s; "
+                     "released by its last caller",
+                     std::chrono::duration_cast<std::chrono::seconds>(kDrainLimit).count());
+    }
+    retired.reset();
+    last_drain_us_.store(infra::MonotonicClock::NowUs() - swapped_at_us,
+                         std::memory_order_relaxed);
+    reloads_completed_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        reload_pending_ = false;
+    }
+    reload_cv_.notify_all();
+}
+
+void HotSwapDetector::SwapLocked() {
+    const int64_t start_ns = infra::MonotonicClock::NowNs();
+    std::shared_ptr<PluginHandle> old = std::atomic_exchange(&current_, std::move(staged_));
+    last_swap_ns_.store(infra::MonotonicClock::NowNs() - start_ns, std::memory_order_relaxed);
+
+    retired_ = std::move(old);
+    swapped_at_us_ = infra::MonotonicClock::NowUs();
+    spdlog::info("[HotSwapDetector] Swapped to new {} instance",
+                 std::atomic_load(&current_)->GetInfo().manifest.plugin_name);
+    reload_cv_.notify_all();
+}
+
+// =============================================================================
+// IDetector Interface Implementation
+// =============================================================================
+
+DetectorInfo HotSwapDetector::GetDetectorInfo() {
+    return std::atomic_load(&current_)->GetDetector()->GetDetectorInfo();
+}
+
+DetectorStatus HotSwapDetector::GetStatus() {
+    return std::atomic_load(&current_)->GetDetector()->GetStatus();
+}
+
+bool HotSwapDetector::StartAcquisition(const AcquisitionConfig& cfg) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (staged_) {
+        SwapLocked();
+    }
+    acquiring_ = std::atomic_load(&current_)->GetDetector()->StartAcquisition(cfg);
+    return acquiring_;
+}
+
+bool HotSwapDetector::StopAcquisition() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    bool stopped = std::atomic_load(&current_)->GetDetector()->StopAcquisition();
+    acquiring_ = false;
+    if (staged_) {
+        SwapLocked();
+    }
+    return stopped;
+}
+
+CalibrationResult HotSwapDetector::RunCalibration(CalibType type, int32_t num_frames) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    return std::atomic_load(&current_)->GetDetector()->RunCalibration(type, num_frames);
+}
+
+void HotSwapDetector::RegisterFrameCallback(FrameCallback cb) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    callbacks_.push_back(std::move(cb));
+}
+
+void HotSwapDetector::Dispatch(const RawFrame& frame) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    for (const auto& cb : callbacks_) {
+        cb(frame);
+    }
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,144 @@
+/**
+ * @file HotSwapDetector.h
+ * @brief IDetector whose vendor plugin can be reloaded while it keeps serving
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin lifecycle
+ * SPDX-License-Identifier: MIT
+ *
+ * DetectorPluginLoader::ReloadPlugin() takes the detector away for the whole
+ * vendor initialisation. HotSwapDetector stages the reload instead:
+ *
+ *   StageReload()  staging thread: LoadPluginIsolated() + vendor init
+ *                  (current instance keeps serving)
+ *   swap           between acquisitions: publish the new instance
+ *   drain          staging thread: wait for in-flight calls on the old
+ *                  instance, then destroy it and unload its image
+ *
+ * DeviceManager hands out the HotSwapDetector itself, so the IDetector*
+ * callers hold stays valid across reloads.
+ */
+
+#ifndef HNUE_HAL_HOT_SWAP_DETECTOR_H
+#define HNUE_HAL_HOT_SWAP_DETECTOR_H
+
+#include "hnvue/hal/IDetector.h"
+#include "plugin/DetectorPluginLoader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Reload counters and timings
+ */
+struct HotSwapStats {
+    uint64_t reloads_completed = 0;
+    uint64_t reloads_failed = 0;       ///< New plugin failed to load; old one kept
+    int64_t last_stage_us = 0;         ///< Load + vendor init, off the serving path
+    int64_t last_swap_ns = 0;          ///< Control calls held off while swapping
+    int64_t last_drain_us = 0;         ///< Swap to old instance destroyed
+};
+
+/**
+ * @brief IDetector forwarding to a replaceable plugin instance
+ *
+ * Swap point:
+ * - The staged instance is published as soon as it is ready if no
+ *   acquisition is running; otherwise at the next StopAcquisition() or
+ *   StartAcquisition(), so an acquisition never changes instance midway.
+ * - A reload that fails to load leaves the current instance in place.
+ *
+ * Frame callbacks are registered once on this object and forwarded from
+ * whichever instance is current.
+ *
+ * Thread Safety:
+ * - Status/info queries read the current instance without locking
+ * - Acquisition, calibration and the swap are serialized
+ */
+class HotSwapDetector : public IDetector {
+public:
+    /**
+     * @param loader Loader used for reloads (must outlive this object)
+     * @param plugin Initial plugin instance (non-null)
+     */
+    HotSwapDetector(DetectorPluginLoader& loader, std::shared_ptr<PluginHandle> plugin);
+    ~HotSwapDetector() override;
+
+    HotSwapDetector(const HotSwapDetector&) = delete;
+    HotSwapDetector& operator=(const HotSwapDetector&) = delete;
+
+    /**
+     * @brief Start loading a new plugin instance in the background
+     * @param plugin_path Plugin file (may be the current path, replaced on disk)
+     * @return false if a reload is already staging or awaiting its swap
+     */
+    bool StageReload(const std::string& plugin_path);
+
+    /**
+     * @brief Wait until no reload is staging or awaiting its swap
+     * @param timeout_ms Maximum wait
+     * @return true if no reload is pending
+     */
+    bool WaitForReload(uint32_t timeout_ms);
+
+    /// Plugin currently serving
+    std::shared_ptr<PluginHandle> CurrentPlugin() const;
+
+    HotSwapStats GetStats() const;
+
+    // =========================================================================
+    // IDetector Interface Implementation
+    // =========================================================================
+
+    DetectorInfo GetDetectorInfo() override;
+    DetectorStatus GetStatus() override;
+    bool StartAcquisition(const AcquisitionConfig& cfg) override;
+    bool StopAcquisition() override;
+    CalibrationResult RunCalibration(CalibType type, int32_t num_frames) override;
+    void RegisterFrameCallback(FrameCallback cb) override;
+
+private:
+    void StageLoop(std::string plugin_path);
+
+    /// Publish the staged instance; caller holds control_mutex_
+    void SwapLocked();
+
+    /// Forward a frame from the current instance to registered callbacks
+    void Dispatch(const RawFrame& frame);
+
+    DetectorPluginLoader& loader_;
+    std::shared_ptr<PluginHandle> current_;    ///< Accessed only via std::atomic_load/exchange
+
+    // Acquisition state and reload handoff, guarded by control_mutex_
+    std::mutex control_mutex_;
+    std::condition_variable reload_cv_;
+    bool acquiring_ = false;
+    bool reload_pending_ = false;              ///< Staging or awaiting swap
+    bool stopping_ = false;
+    std::shared_ptr<PluginHandle> staged_;     ///< Ready, awaiting swap
+    std::shared_ptr<PluginHandle> retired_;    ///< Swapped out, awaiting drain
+    int64_t swapped_at_us_ = 0;
+    std::thread stage_thread_;
+
+    std::mutex callback_mutex_;
+    std::vector<FrameCallback> callbacks_;
+
+    std::atomic<uint64_t> reloads_completed_{0};
+    std::atomic<uint64_t> reloads_failed_{0};
+    std::atomic<int64_t> last_stage_us_{0};
+    std::atomic<int64_t> last_swap_ns_{0};
+    std::atomic<int64_t> last_drain_us_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_HOT_SWAP_DETECTOR_H
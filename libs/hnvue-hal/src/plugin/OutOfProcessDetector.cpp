@@ -0,0 +1,476 @@
+/**
+ * @file OutOfProcessDetector.cpp
+ * @brief IDetector proxy for a vendor plugin running in a separate host process
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "plugin/OutOfProcessDetector.h"
+
+#include "hnvue/hal/HalThreads.h"
+#include "hnvue/infra/Clock.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+using hostproto::HostOp;
+using hostproto::HostReply;
+using hostproto::HostRequest;
+
+namespace {
+
+/// Delivery thread wake-up bound when no frames arrive (re-checks running_)
+constexpr std::chrono::milliseconds kDeliveryWaitSlice{50};
+
+/// Time a host gets to exit on its own before SIGKILL
+constexpr auto kHostExitGrace = std::chrono::milliseconds(200);
+
+/// Delay between failed host launches
+constexpr auto kRelaunchBackoff = std::chrono::milliseconds(200);
+
+int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Construction / Lifecycle
+// =============================================================================
+
+OutOfProcessDetector::OutOfProcessDetector(const OutOfProcessDetectorConfig& config)
+    : config_(config) {
+}
+
+OutOfProcessDetector::~OutOfProcessDetector() {
+    Shutdown();
+}
+
+bool OutOfProcessDetector::Launch() {
+    if (running_.load(std::memory_order_acquire)) {
+        spdlog::warn("[OutOfProcessDetector] Already launched");
+        return false;
+    }
+    if (!ring_) {
+        ring_ = ShmFrameRing::Create(config_.ring_slots, config_.max_frame_bytes);
+        if (!ring_) {
+            return false;
+        }
+    }
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wake_fd_ < 0) {
+        spdlog::error("[OutOfProcessDetector] eventfd failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (!SpawnHostLocked()) {
+            close(wake_fd_);
+            wake_fd_ = -1;
+            return false;
+        }
+        spdlog::info("[OutOfProcessDetector] Host {} serving {} ({} {})", host_pid_,
+                     config_.plugin_path, info_.vendor, info_.model);
+    }
+
+    running_.store(true, std::memory_order_release);
+    monitor_thread_ = std::thread(&OutOfProcessDetector::MonitorLoop, this);
+    delivery_thread_ = std::thread(&OutOfProcessDetector::DeliveryLoop, this);
+    return true;
+}
+
+void OutOfProcessDetector::Shutdown() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // Monitor first, so the host exiting below is not taken for a crash
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+        spdlog::warn("[OutOfProcessDetector] eventfd write failed: {}", std::strerror(errno));
+    }
+    if (monitor_thread_.joinable()) {
+        monitor_thread_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        acquiring_ = false;
+        HostRequest request;
+        HostReply reply;
+        CallLocked(HostOp::SHUTDOWN, request, reply, config_.control_timeout_ms);
+        ReapHostLocked();
+    }
+
+    ring_->Wake();
+    if (delivery_thread_.joinable()) {
+        delivery_thread_.join();
+    }
+    close(wake_fd_);
+    wake_fd_ = -1;
+    spdlog::info("[OutOfProcessDetector] Shut down");
+}
+
+pid_t OutOfProcessDetector::HostPid() const {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    return host_pid_;
+}
+
+// =============================================================================
+// Host Process
+// =============================================================================
+
+bool OutOfProcessDetector::SpawnHostLocked() {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) {
+        spdlog::error("[OutOfProcessDetector] socketpair failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    // Everything the child needs is prepared before fork()
+    const int child_control = sockets[1];
+    const int child_ring = ring_->Fd();
+    std::string control_arg = std::to_string(child_control);
+    std::string ring_arg = std::to_string(child_ring);
+    std::vector<char*> argv = {
+        const_cast<char*>(config_.host_executable.c_str()),
+        const_cast<char*>("--plugin"), const_cast<char*>(config_.plugin_path.c_str()),
+        const_cast<char*>("--control-fd"), control_arg.data(),
+        const_cast<char*>("--ring-fd"), ring_arg.data(),
+        nullptr,
+    };
+    const pid_t parent = getpid();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        spdlog::error("[OutOfProcessDetector] fork failed: {}", std::strerror(errno));
+        close(sockets[0]);
+        close(sockets[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // Child: async-signal-safe calls only
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent) {
+            _exit(127);
+        }
+        fcntl(child_control, F_SETFD, 0);
+        fcntl(child_ring, F_SETFD, 0);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    close(sockets[1]);
+    control_fd_ = sockets[0];
+    host_pid_ = pid;
+
+    HostRequest request;
+    HostReply reply;
+    if (!CallLocked(HostOp::HELLO, request, reply, config_.control_timeout_ms)) {
+        spdlog::error("[OutOfProcessDetector] Host {} did not complete the handshake ({})",
+                      pid, config_.plugin_path);
+        ReapHostLocked();
+        return false;
+    }
+    if (reply.protocol_version != hostproto::kProtocolVersion) {
+        spdlog::error("[OutOfProcessDetector] Host protocol {} != {}",
+                      reply.protocol_version, hostproto::kProtocolVersion);
+        ReapHostLocked();
+        return false;
+    }
+    info_ = hostproto::DecodeDetectorInfo(reply);
+    return true;
+}
+
+void OutOfProcessDetector::ReapHostLocked() {
+    if (control_fd_ >= 0) {
+        close(control_fd_);
+        control_fd_ = -1;
+    }
+    if (host_pid_ <= 0) {
+        return;
+    }
+
+    int status = 0;
+    auto deadline = std::chrono::steady_clock::now() + kHostExitGrace;
+    pid_t reaped = waitpid(host_pid_, &status, WNOHANG);
+    while (reaped == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        reaped = waitpid(host_pid_, &status, WNOHANG);
+    }
+    if (reaped == 0) {
+        kill(host_pid_, SIGKILL);
+        reaped = waitpid(host_pid_, &status, 0);
+    }
+
+    if (reaped > 0 && WIFSIGNALED(status)) {
+        spdlog::warn("[OutOfProcessDetector] Host {} terminated by signal {}",
+                     host_pid_, WTERMSIG(status));
+    } else if (reaped > 0 && WEXITSTATUS(status) != 0) {
+        spdlog::warn("[OutOfProcessDetector] Host {} exited with {}",
+                     host_pid_, WEXITSTATUS(status));
+    }
+    host_pid_ = 0;
+}
+
+bool OutOfProcessDetector::CallLocked(HostOp op, HostRequest& request, HostReply& reply,
+                                      uint32_t timeout_ms) {
+    if (control_fd_ < 0) {
+        return false;
+    }
+    request.op = static_cast<uint32_t>(op);
+    request.request_id = next_request_id_++;
+    if (!hostproto::Send(control_fd_, request)) {
+        return false;  // Host gone; the monitor sees the hang-up
+    }
+    if (!hostproto::Receive(control_fd_, reply, static_cast<int>(timeout_ms)) ||
+        reply.request_id != request.request_id) {
+        // Hung or confused host: kill it, the monitor relaunches it
+        spdlog::error("[OutOfProcessDetector] Host {} gave no valid reply to op {} within {} ms",
+                      host_pid_, request.op, timeout_ms);
+        if (host_pid_ > 0) {
+            kill(host_pid_, SIGKILL);
+        }
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Supervision
+// =============================================================================
+
+void OutOfProcessDetector::MonitorLoop() {
+    infra::ApplyNamedThreadPolicy(kThreadDetectorHostMonitor);
+
+    while (running_.load(std::memory_order_acquire)) {
+        int fd;
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            fd = control_fd_;   // Only this thread replaces it while running
+        }
+        // POLLIN is not requested: pending replies belong to the control caller
+        pollfd fds[2] = {{wake_fd_, POLLIN, 0}, {fd, POLLRDHUP, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            spdlog::error("[OutOfProcessDetector] poll failed: {}", std::strerror(errno));
+            break;
+        }
+        if (fds[0].revents != 0) {
+            break;
+        }
+        if ((fds[1].revents & (POLLHUP | POLLRDHUP | POLLERR | POLLNVAL)) == 0) {
+            continue;
+        }
+
+        const int64_t detected_ns = SteadyNowNs();
+        std::unique_lock<std::mutex> lock(control_mutex_);
+        spdlog::error("[OutOfProcessDetector] Host {} lost", host_pid_);
+        ReapHostLocked();
+        if (!config_.restart_on_failure) {
+            continue;   // Control calls now fail; only the wake eventfd is watched
+        }
+
+        while (running_.load(std::memory_order_acquire) && !SpawnHostLocked()) {
+            lock.unlock();
+            std::this_thread::sleep_for(kRelaunchBackoff);
+            lock.lock();
+        }
+        if (control_fd_ < 0) {
+            continue;
+        }
+
+        if (acquiring_ && config_.resume_acquisition) {
+            HostRequest request;
+            HostReply reply;
+            hostproto::EncodeAcquisitionConfig(active_config_, request);
+            if (!CallLocked(HostOp::START_ACQUISITION, request, reply, config_.control_timeout_ms) ||
+                reply.success == 0) {
+                spdlog::error("[OutOfProcessDetector] Acquisition {} not resumed after restart",
+                              active_config_.session_id);
+                acquiring_ = false;
+            }
+        }
+
+        const int64_t restart_us = (SteadyNowNs() - detected_ns) / 1000;
+        last_restart_us_.store(restart_us, std::memory_order_relaxed);
+        host_restarts_.fetch_add(1, std::memory_order_relaxed);
+        spdlog::warn("[OutOfProcessDetector] Host restarted as {} in {} us", host_pid_, restart_us);
+    }
+}
+
+// =============================================================================
+// Frame Delivery
+// =============================================================================
+
+void OutOfProcessDetector::DeliveryLoop() {
+    infra::ApplyNamedThreadPolicy(kThreadDetectorIngest);
+
+    while (running_.load(std::memory_order_acquire)) {
+        if (!ring_->Wait(kDeliveryWaitSlice)) {
+            continue;
+        }
+
+        ShmFrameView view;
+        while (ring_->Peek(view)) {
+            const int64_t latency_ns = SteadyNowNs() - view.header->publish_ns;
+            last_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+            if (latency_ns > max_latency_ns_.load(std::memory_order_relaxed)) {
+                max_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(callback_mutex_);
+                for (const auto& cb : view_callbacks_) {
+                    try {
+                        cb(view);
+                    } catch (const std::exception& e) {
+                        spdlog::error("[OutOfProcessDetector] View callback threw: {}", e.what());
+                    }
+                }
+                if (!frame_callbacks_.empty()) {
+                    const ShmSlotHeader& header = *view.header;
+                    delivery_frame_.sequence_number = header.sequence_number;
+                    delivery_frame_.timestamp_us =
+                        infra::MonotonicClock::FromWallClockUs(header.timestamp_unix_us);
+                    delivery_frame_.width = header.width;
+                    delivery_frame_.height = header.height;
+                    delivery_frame_.bit_depth = header.bit_depth;
+                    delivery_frame_.session_id.assign(
+                        header.session_id, strnlen(header.session_id, kShmSessionIdBytes));
+                    delivery_frame_.pixel_data.assign(view.pixels, view.pixels + view.pixel_bytes);
+                    for (const auto& cb : frame_callbacks_) {
+                        try {
+                            cb(delivery_frame_);
+                        } catch (const std::exception& e) {
+                            spdlog::error("[OutOfProcessDetector] Frame callback threw: {}", e.what());
+                        }
+                    }
+                }
+            }
+
+            ring_->Release();
+            frames_delivered_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void OutOfProcessDetector::RegisterFrameViewCallback(FrameViewCallback cb) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    view_callbacks_.push_back(std::move(cb));
+}
+
+void OutOfProcessDetector::RegisterFrameCallback(FrameCallback cb) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    frame_callbacks_.push_back(std::move(cb));
+}
+
+OutOfProcessDetectorStats OutOfProcessDetector::GetStats() const {
+    OutOfProcessDetectorStats stats;
+    stats.frames_delivered = frames_delivered_.load(std::memory_order_relaxed);
+    stats.frames_dropped = ring_ ? ring_->DroppedFrames() : 0;
+    stats.host_restarts = host_restarts_.load(std::memory_order_relaxed);
+    stats.last_restart_us = last_restart_us_.load(std::memory_order_relaxed);
+    stats.last_latency_ns = last_latency_ns_.load(std::memory_order_relaxed);
+    stats.max_latency_ns = max_latency_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// =============================================================================
+// IDetector Interface Implementation
+// =============================================================================
+
+DetectorInfo OutOfProcessDetector::GetDetectorInfo() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    return info_;
+}
+
+DetectorStatus OutOfProcessDetector::GetStatus() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    HostRequest request;
+    HostReply reply;
+    if (CallLocked(HostOp::GET_STATUS, request, reply, config_.control_timeout_ms) &&
+        reply.success != 0) {
+        return hostproto::DecodeDetectorStatus(reply);
+    }
+
+    // Host unavailable: report what the core asked for
+    DetectorStatus status;
+    status.is_acquiring = acquiring_;
+    status.current_session_id = acquiring_ ? active_config_.session_id : std::string();
+    return status;
+}
+
+bool OutOfProcessDetector::StartAcquisition(const AcquisitionConfig& cfg) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    if (acquiring_) {
+        spdlog::warn("[OutOfProcessDetector] Acquisition already active ({})", active_config_.session_id);
+        return false;
+    }
+    HostRequest request;
+    HostReply reply;
+    hostproto::EncodeAcquisitionConfig(cfg, request);
+    if (!CallLocked(HostOp::START_ACQUISITION, request, reply, config_.control_timeout_ms) ||
+        reply.success == 0) {
+        spdlog::error("[OutOfProcessDetector] StartAcquisition failed: session={}", cfg.session_id);
+        return false;
+    }
+    acquiring_ = true;
+    active_config_ = cfg;
+    spdlog::info("[OutOfProcessDetector] Acquisition started: session={}", cfg.session_id);
+    return true;
+}
+
+bool OutOfProcessDetector::StopAcquisition() {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    // Cleared first: a host restarting now must not resume this acquisition
+    acquiring_ = false;
+    HostRequest request;
+    HostReply reply;
+    if (!CallLocked(HostOp::STOP_ACQUISITION, request, reply, config_.control_timeout_ms)) {
+        return false;
+    }
+    spdlog::info("[OutOfProcessDetector] Acquisition stopped: session={}", active_config_.session_id);
+    return reply.success != 0;
+}
+
+CalibrationResult OutOfProcessDetector::RunCalibration(CalibType type, int32_t num_frames) {
+    std::lock_guard<std::mutex> lock(control_mutex_);
+    CalibrationResult result;
+    if (acquiring_) {
+        result.error_msg = "Acquisition active";
+        return result;
+    }
+    HostRequest request;
+    HostReply reply;
+    request.calib_type = static_cast<int32_t>(type);
+    request.calib_frames = num_frames;
+    if (!CallLocked(HostOp::RUN_CALIBRATION, request, reply, config_.calibration_timeout_ms)) {
+        result.error_msg = "Detector host not responding";
+        return result;
+    }
+    return hostproto::DecodeCalibrationResult(reply);
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,176 @@
+/**
+ * @file OutOfProcessDetector.h
+ * @brief IDetector proxy for a vendor plugin running in a separate host process
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * Alternative to loading a vendor plugin with DetectorPluginLoader in the
+ * core process: the plugin runs in hnvue-detector-host, so a vendor crash,
+ * hang or leak costs a host restart instead of the exposure-control
+ * process.
+ *
+ *   core                                    hnvue-detector-host
+ *   OutOfProcessDetector --HostRequest-->   PluginHost -> vendor IDetector
+ *                        <--HostReply---
+ *   delivery thread      <==ShmFrameRing==  frame callback (one copy)
+ */
+
+#ifndef HNUE_HAL_OUT_OF_PROCESS_DETECTOR_H
+#define HNUE_HAL_OUT_OF_PROCESS_DETECTOR_H
+
+#include "hnvue/hal/IDetector.h"
+#include "plugin/PluginHostProtocol.h"
+#include "plugin/ShmFrameRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace hnvue::hal {
+
+/**
+ * @brief Out-of-process detector configuration
+ */
+struct OutOfProcessDetectorConfig {
+    std::string host_executable = "hnvue-detector-host";
+    std::string plugin_path;                       ///< Vendor plugin loaded by the host
+    uint32_t ring_slots = 8;                       ///< Rounded up to a power of two
+    size_t max_frame_bytes = 3072 * 3072 * 2;      ///< Largest frame the ring carries
+    uint32_t control_timeout_ms = 2000;            ///< Reply deadline; a miss restarts the host
+    uint32_t calibration_timeout_ms = 60000;       ///< Reply deadline of RunCalibration
+    bool restart_on_failure = true;                ///< Relaunch the host when it dies or hangs
+    bool resume_acquisition = true;                ///< Re-issue StartAcquisition after a restart
+};
+
+/**
+ * @brief Counters
+ */
+struct OutOfProcessDetectorStats {
+    uint64_t frames_delivered = 0;
+    uint64_t frames_dropped = 0;       ///< Ring full at the host (consumer too slow)
+    uint64_t host_restarts = 0;
+    int64_t last_restart_us = 0;       ///< Failure detected to host serving again
+    int64_t last_latency_ns = 0;       ///< Slot published to view callbacks entered
+    int64_t max_latency_ns = 0;
+};
+
+/**
+ * @brief IDetector backed by a supervised plugin host process
+ *
+ * Frame delivery:
+ * - View callbacks (RegisterFrameViewCallback) read the shared slot in
+ *   place, without any copy in the core; the view is valid during the call.
+ * - Frame callbacks (IDetector::RegisterFrameCallback) receive a RawFrame
+ *   filled from the slot, since RawFrame owns its pixels; the copy is made
+ *   only if such callbacks are registered, into a reused pooled buffer.
+ *
+ * Supervision:
+ * - A monitor thread sleeps on the control socket (and an eventfd for
+ *   shutdown). A host exit or crash hangs the socket up; a control reply
+ *   missing its deadline gets the host killed. Either way the monitor
+ *   relaunches the host against the same ring, repeats the handshake and,
+ *   if an acquisition was running, starts it again.
+ * - The host is started with PR_SET_PDEATHSIG, so it never outlives the core.
+ *
+ * Thread Safety:
+ * - Control methods are serialized
+ * - Callbacks run on the delivery thread (kThreadDetectorIngest)
+ */
+class OutOfProcessDetector : public IDetector {
+public:
+    /// Zero-copy frame consumer; the view is valid only during the call
+    using FrameViewCallback = std::function<void(const ShmFrameView&)>;
+
+    explicit OutOfProcessDetector(const OutOfProcessDetectorConfig& config);
+    ~OutOfProcessDetector() override;
+
+    OutOfProcessDetector(const OutOfProcessDetector&) = delete;
+    OutOfProcessDetector& operator=(const OutOfProcessDetector&) = delete;
+
+    /**
+     * @brief Create the ring, start the host and complete the handshake
+     * @return false if the host cannot be started or the plugin fails to load
+     */
+    bool Launch();
+
+    /**
+     * @brief Stop acquisition, shut the host down and stop all threads
+     */
+    void Shutdown();
+
+    /// PID of the running host (0 if none)
+    pid_t HostPid() const;
+
+    void RegisterFrameViewCallback(FrameViewCallback cb);
+
+    OutOfProcessDetectorStats GetStats() const;
+
+    // =========================================================================
+    // IDetector Interface Implementation
+    // =========================================================================
+
+    DetectorInfo GetDetectorInfo() override;
+    DetectorStatus GetStatus() override;
+    bool StartAcquisition(const AcquisitionConfig& cfg) override;
+    bool StopAcquisition() override;
+    CalibrationResult RunCalibration(CalibType type, int32_t num_frames) override;
+    void RegisterFrameCallback(FrameCallback cb) override;
+
+private:
+    /// Start a host process and complete the handshake; caller holds control_mutex_
+    bool SpawnHostLocked();
+
+    /// Kill and reap the host, close the control socket; caller holds control_mutex_
+    void ReapHostLocked();
+
+    /// Round trip on the control channel; caller holds control_mutex_
+    bool CallLocked(hostproto::HostOp op, hostproto::HostRequest& request,
+                    hostproto::HostReply& reply, uint32_t timeout_ms);
+
+    void MonitorLoop();
+    void DeliveryLoop();
+
+    OutOfProcessDetectorConfig config_;
+    std::unique_ptr<ShmFrameRing> ring_;
+
+    // Control channel and host process, guarded by control_mutex_
+    mutable std::mutex control_mutex_;
+    int control_fd_ = -1;
+    pid_t host_pid_ = 0;
+    uint32_t next_request_id_ = 1;
+    DetectorInfo info_;
+    bool acquiring_ = false;
+    AcquisitionConfig active_config_;
+
+    // Monitor
+    std::thread monitor_thread_;
+    int wake_fd_ = -1;                 ///< eventfd: stop the monitor
+    std::atomic<bool> running_{false};
+
+    // Delivery
+    std::thread delivery_thread_;
+    std::mutex callback_mutex_;
+    std::vector<FrameCallback> frame_callbacks_;
+    std::vector<FrameViewCallback> view_callbacks_;
+    RawFrame delivery_frame_;          ///< Delivery thread only; reused
+
+    std::atomic<uint64_t> frames_delivered_{0};
+    std::atomic<uint64_t> host_restarts_{0};
+    std::atomic<int64_t> last_restart_us_{0};
+    std::atomic<int64_t> last_latency_ns_{0};
+    std::atomic<int64_t> max_latency_ns_{0};
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_OUT_OF_PROCESS_DETECTOR_H
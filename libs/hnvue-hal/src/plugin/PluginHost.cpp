@@ -0,0 +1,128 @@
+/**
+ * @file PluginHost.cpp
+ * @brief Host-process side of out-of-process detector plugins
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "plugin/PluginHost.h"
+
+#include "hnvue/hal/IDetector.h"
+#include "hnvue/infra/Clock.h"
+
+#include <exception>
+#include <mutex>
+
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+using hostproto::HostOp;
+using hostproto::HostReply;
+using hostproto::HostRequest;
+
+PluginHost::PluginHost(IDetector& detector, int control_fd, std::unique_ptr<ShmFrameRing> ring)
+    : detector_(detector)
+    , control_fd_(control_fd)
+    , ring_(std::move(ring)) {
+}
+
+PluginHost::~PluginHost() {
+    if (control_fd_ >= 0) {
+        close(control_fd_);
+    }
+}
+
+int PluginHost::Run() {
+    // The ring outlives this object if the vendor keeps a callback thread alive
+    std::shared_ptr<ShmFrameRing> ring = ring_;
+    auto publish_mutex = std::make_shared<std::mutex>();
+    detector_.RegisterFrameCallback([ring, publish_mutex](const RawFrame& frame) {
+        ShmFrameMeta meta;
+        meta.sequence_number = frame.sequence_number;
+        meta.timestamp_unix_us = infra::MonotonicClock::ToWallClockUs(frame.timestamp_us);
+        meta.width = frame.width;
+        meta.height = frame.height;
+        meta.bit_depth = frame.bit_depth;
+        meta.session_id = frame.session_id.c_str();
+        std::lock_guard<std::mutex> lock(*publish_mutex);
+        ring->Publish(meta, frame.pixel_data.data(), frame.pixel_data.size());
+    });
+
+    int exit_code = 1;
+    HostRequest request;
+    while (hostproto::Receive(control_fd_, request, -1)) {
+        HostReply reply = Handle(request);
+        if (!hostproto::Send(control_fd_, reply)) {
+            break;
+        }
+        if (request.op == static_cast<uint32_t>(HostOp::SHUTDOWN)) {
+            exit_code = 0;
+            break;
+        }
+    }
+
+    if (exit_code != 0) {
+        spdlog::warn("[PluginHost] Control channel closed, stopping detector");
+        try {
+            detector_.StopAcquisition();
+        } catch (...) {
+        }
+    }
+    return exit_code;
+}
+
+HostReply PluginHost::Handle(const HostRequest& request) {
+    HostReply reply;
+    reply.op = request.op;
+    reply.request_id = request.request_id;
+    reply.protocol_version = hostproto::kProtocolVersion;
+
+    // Vendor exceptions must not take the host down with the request unanswered
+    try {
+        switch (static_cast<HostOp>(request.op)) {
+            case HostOp::HELLO:
+                hostproto::EncodeDetectorInfo(detector_.GetDetectorInfo(), reply);
+                reply.success = 1;
+                break;
+            case HostOp::GET_STATUS:
+                hostproto::EncodeDetectorStatus(detector_.GetStatus(), reply);
+                reply.success = 1;
+                break;
+            case HostOp::START_ACQUISITION:
+                reply.success = detector_.StartAcquisition(
+                    hostproto::DecodeAcquisitionConfig(request)) ? 1 : 0;
+                break;
+            case HostOp::STOP_ACQUISITION:
+                reply.success = detector_.StopAcquisition() ? 1 : 0;
+                break;
+            case HostOp::RUN_CALIBRATION:
+                hostproto::EncodeCalibrationResult(
+                    detector_.RunCalibration(static_cast<CalibType>(request.calib_type),
+                                             request.calib_frames),
+                    reply);
+                break;
+            case HostOp::SHUTDOWN:
+                detector_.StopAcquisition();
+                reply.success = 1;
+                break;
+            default:
+                spdlog::warn("[PluginHost] Unknown op {}", request.op);
+                break;
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("[PluginHost] Detector threw on op {}: {}", request.op, e.what());
+        reply.success = 0;
+    } catch (...) {
+        spdlog::error("[PluginHost] Detector threw on op {}", request.op);
+        reply.success = 0;
+    }
+    return reply;
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,66 @@
+/**
+ * @file PluginHost.h
+ * @brief Host-process side of out-of-process detector plugins
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * Runs inside hnvue-detector-host: serves one vendor IDetector over the
+ * control channel and publishes its frames into the shared ring.
+ */
+
+#ifndef HNUE_HAL_PLUGIN_HOST_H
+#define HNUE_HAL_PLUGIN_HOST_H
+
+#include "plugin/PluginHostProtocol.h"
+#include "plugin/ShmFrameRing.h"
+
+#include <memory>
+
+namespace hnvue::hal {
+
+class IDetector;
+
+/**
+ * @brief Serves an IDetector to the core process
+ *
+ * Frames arrive on the vendor's callback thread and are copied once into
+ * the next ring slot (the vendor owns its frame buffer; the core reads the
+ * slot in place). Publishing is serialized, so vendors delivering from
+ * several threads still present a single producer. Control requests are
+ * handled one at a time on the thread calling Run().
+ */
+class PluginHost {
+public:
+    /**
+     * @param detector Vendor detector (must outlive the host)
+     * @param control_fd SOCK_SEQPACKET control socket; ownership is taken
+     * @param ring Attached frame ring
+     */
+    PluginHost(IDetector& detector, int control_fd, std::unique_ptr<ShmFrameRing> ring);
+    ~PluginHost();
+
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    /**
+     * @brief Serve control requests until SHUTDOWN or the core goes away
+     * @return Process exit code (0 on SHUTDOWN, 1 if the channel failed)
+     *
+     * Any running acquisition is stopped before returning.
+     */
+    int Run();
+
+private:
+    hostproto::HostReply Handle(const hostproto::HostRequest& request);
+
+    IDetector& detector_;
+    int control_fd_;
+    std::shared_ptr<ShmFrameRing> ring_;   ///< Shared with the frame callback
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_PLUGIN_HOST_H
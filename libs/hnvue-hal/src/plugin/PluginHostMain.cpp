@@ -0,0 +1,67 @@
+/**
+ * @file PluginHostMain.cpp
+ * @brief hnvue-detector-host: runs one vendor detector plugin out of process
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * Started by OutOfProcessDetector, never by hand:
+ *
+ *   hnvue-detector-host --plugin <path> --control-fd <n> --ring-fd <n>
+ *
+ * Exit codes: 0 on SHUTDOWN, 1 if the control channel closed, 2 on bad
+ * arguments or a ring that cannot be attached, 3 if the plugin failed to load.
+ */
+
+#include "plugin/DetectorPluginLoader.h"
+#include "plugin/PluginHost.h"
+#include "plugin/ShmFrameRing.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+using namespace hnvue::hal;
+
+int main(int argc, char** argv) {
+    std::string plugin_path;
+    int control_fd = -1;
+    int ring_fd = -1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--plugin") == 0) {
+            plugin_path = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--control-fd") == 0) {
+            control_fd = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--ring-fd") == 0) {
+            ring_fd = std::atoi(argv[i + 1]);
+        }
+    }
+    if (plugin_path.empty() || control_fd < 0 || ring_fd < 0) {
+        spdlog::error("[PluginHost] Usage: {} --plugin <path> --control-fd <n> --ring-fd <n>", argv[0]);
+        return 2;
+    }
+
+    std::unique_ptr<ShmFrameRing> ring = ShmFrameRing::Attach(ring_fd);
+    if (!ring) {
+        return 2;
+    }
+
+    // Declared before the host: the detector is destroyed after the host stops serving
+    DetectorPluginLoader loader;
+    std::shared_ptr<PluginHandle> handle = loader.LoadPlugin(plugin_path);
+    if (!handle || handle->GetDetector() == nullptr) {
+        spdlog::error("[PluginHost] Cannot load plugin {}: {}", plugin_path,
+                      loader.GetLastError().message);
+        return 3;
+    }
+
+    spdlog::info("[PluginHost] Serving {} ({})", plugin_path,
+                 handle->GetInfo().manifest.plugin_name);
+    PluginHost host(*handle->GetDetector(), control_fd, std::move(ring));
+    return host.Run();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file PluginHostProtocol.cpp
+ * @brief Control messages between the core and a detector plugin host process
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "plugin/PluginHostProtocol.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace hnvue::hal::hostproto {
+
+namespace {
+
+template <size_t N>
+void CopyString(char (&dest)[N], const std::string& source) {
+    std::strncpy(dest, source.c_str(), N - 1);
+    dest[N - 1] = '\0';
+}
+
+template <size_t N>
+std::string ReadString(const char (&source)[N]) {
+    return std::string(source, strnlen(source, N));
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Conversion
+// =============================================================================
+
+void EncodeAcquisitionConfig(const AcquisitionConfig& cfg, HostRequest& request) {
+    request.mode = static_cast<int32_t>(cfg.mode);
+    request.num_frames = cfg.num_frames;
+    request.frame_rate = cfg.frame_rate;
+    request.binning = cfg.binning;
+    CopyString(request.session_id, cfg.session_id);
+}
+
+AcquisitionConfig DecodeAcquisitionConfig(const HostRequest& request) {
+    AcquisitionConfig cfg;
+    cfg.mode = static_cast<AcquisitionMode>(request.mode);
+    cfg.num_frames = request.num_frames;
+    cfg.frame_rate = request.frame_rate;
+    cfg.binning = request.binning;
+    cfg.session_id = ReadString(request.session_id);
+    return cfg;
+}
+
+void EncodeDetectorInfo(const DetectorInfo& info, HostReply& reply) {
+    reply.pixel_width = info.pixel_width;
+    reply.pixel_height = info.pixel_height;
+    reply.max_bit_depth = info.max_bit_depth;
+    reply.pixel_pitch_um = info.pixel_pitch_um;
+    reply.max_frame_rate = info.max_frame_rate;
+    CopyString(reply.vendor, info.vendor);
+    CopyString(reply.model, info.model);
+    CopyString(reply.serial_number, info.serial_number);
+    CopyString(reply.firmware_version, info.firmware_version);
+}
+
+DetectorInfo DecodeDetectorInfo(const HostReply& reply) {
+    DetectorInfo info;
+    info.pixel_width = reply.pixel_width;
+    info.pixel_height = reply.pixel_height;
+    info.max_bit_depth = reply.max_bit_depth;
+    info.pixel_pitch_um = reply.pixel_pitch_um;
+    info.max_frame_rate = reply.max_frame_rate;
+    info.vendor = ReadString(reply.vendor);
+    info.model = ReadString(reply.model);
+    info.serial_number = ReadString(reply.serial_number);
+    info.firmware_version = ReadString(reply.firmware_version);
+    return info;
+}
+
+void EncodeDetectorStatus(const DetectorStatus& status, HostReply& reply) {
+    reply.is_acquiring = status.is_acquiring ? 1 : 0;
+    reply.frames_acquired = status.frames_acquired;
+    reply.temperature_c = status.temperature_c;
+    CopyString(reply.text, status.current_session_id);
+}
+
+DetectorStatus DecodeDetectorStatus(const HostReply& reply) {
+    DetectorStatus status;
+    status.is_acquiring = reply.is_acquiring != 0;
+    status.frames_acquired = reply.frames_acquired;
+    status.temperature_c = reply.temperature_c;
+    status.current_session_id = ReadString(reply.text);
+    return status;
+}
+
+void EncodeCalibrationResult(const CalibrationResult& result, HostReply& reply) {
+    reply.success = result.success ? 1 : 0;
+    CopyString(reply.text, result.output_path);
+    CopyString(reply.error_msg, result.error_msg);
+}
+
+CalibrationResult DecodeCalibrationResult(const HostReply& reply) {
+    CalibrationResult result;
+    result.success = reply.success != 0;
+    result.output_path = ReadString(reply.text);
+    result.error_msg = ReadString(reply.error_msg);
+    return result;
+}
+
+// =============================================================================
+// Transport
+// =============================================================================
+
+bool SendRecord(int fd, const void* record, size_t size) {
+    ssize_t sent;
+    do {
+        sent = send(fd, record, size, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(size);
+}
+
+bool ReceiveRecord(int fd, void* record, size_t size, int timeout_ms) {
+    pollfd pfd{fd, POLLIN, 0};
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) {
+        return false;
+    }
+
+    // MSG_TRUNC: the return value is the full packet length, so oversized
+    // packets are detected rather than silently cut
+    ssize_t received;
+    do {
+        received = recv(fd, record, size, MSG_TRUNC);
+    } while (received < 0 && errno == EINTR);
+    return received == static_cast<ssize_t>(size);
+}
+
+} // namespace hnvue::hal::hostproto
@@ -0,0 +1,135 @@
+/**
+ * @file PluginHostProtocol.h
+ * @brief Control messages between the core and a detector plugin host process
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * The control channel is a SOCK_SEQPACKET socketpair: one HostRequest per
+ * call, answered by exactly one HostReply. Both are fixed-size trivially
+ * copyable records, so a message is one send()/recv() and a short or
+ * oversized packet is rejected outright. Strings are truncated to their
+ * field size. Frames never travel on this channel (see ShmFrameRing).
+ */
+
+#ifndef HNUE_HAL_PLUGIN_HOST_PROTOCOL_H
+#define HNUE_HAL_PLUGIN_HOST_PROTOCOL_H
+
+#include "hnvue/hal/HalTypes.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace hnvue::hal::hostproto {
+
+constexpr uint32_t kProtocolVersion = 1;
+
+/**
+ * @brief Proxied IDetector operations
+ */
+enum class HostOp : uint32_t {
+    HELLO = 0,              ///< Handshake: reply carries protocol version and DetectorInfo
+    GET_STATUS = 1,
+    START_ACQUISITION = 2,
+    STOP_ACQUISITION = 3,
+    RUN_CALIBRATION = 4,
+    SHUTDOWN = 5            ///< Stop acquisition and exit
+};
+
+/**
+ * @brief Core to host
+ */
+struct HostRequest {
+    uint32_t op = 0;
+    uint32_t request_id = 0;
+    int32_t mode = 0;
+    int32_t num_frames = 0;
+    float frame_rate = 0.0f;
+    int32_t binning = 1;
+    int32_t calib_type = 0;
+    int32_t calib_frames = 0;
+    char session_id[64] = {};
+};
+
+/**
+ * @brief Host to core
+ */
+struct HostReply {
+    uint32_t op = 0;
+    uint32_t request_id = 0;
+    uint32_t protocol_version = 0;
+    int32_t success = 0;
+
+    // HELLO: DetectorInfo
+    int32_t pixel_width = 0;
+    int32_t pixel_height = 0;
+    int32_t max_bit_depth = 0;
+    float pixel_pitch_um = 0.0f;
+    float max_frame_rate = 0.0f;
+    char vendor[64] = {};
+    char model[64] = {};
+    char serial_number[64] = {};
+    char firmware_version[32] = {};
+
+    // GET_STATUS: DetectorStatus
+    int32_t is_acquiring = 0;
+    int32_t frames_acquired = 0;
+    float temperature_c = 0.0f;
+
+    // GET_STATUS: session id / RUN_CALIBRATION: output path
+    char text[256] = {};
+    char error_msg[256] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<HostRequest>, "HostRequest is sent as raw bytes");
+static_assert(std::is_trivially_copyable_v<HostReply>, "HostReply is sent as raw bytes");
+
+// =============================================================================
+// Conversion
+// =============================================================================
+
+void EncodeAcquisitionConfig(const AcquisitionConfig& cfg, HostRequest& request);
+AcquisitionConfig DecodeAcquisitionConfig(const HostRequest& request);
+
+void EncodeDetectorInfo(const DetectorInfo& info, HostReply& reply);
+DetectorInfo DecodeDetectorInfo(const HostReply& reply);
+
+void EncodeDetectorStatus(const DetectorStatus& status, HostReply& reply);
+DetectorStatus DecodeDetectorStatus(const HostReply& reply);
+
+void EncodeCalibrationResult(const CalibrationResult& result, HostReply& reply);
+CalibrationResult DecodeCalibrationResult(const HostReply& reply);
+
+// =============================================================================
+// Transport
+// =============================================================================
+
+/**
+ * @brief Send one record
+ * @return false if the peer is gone or the packet was not sent whole
+ */
+bool SendRecord(int fd, const void* record, size_t size);
+
+/**
+ * @brief Receive one record of exactly size bytes
+ * @param timeout_ms -1 waits indefinitely
+ * @return false on timeout, peer hang-up or a packet of the wrong size
+ */
+bool ReceiveRecord(int fd, void* record, size_t size, int timeout_ms);
+
+template <typename T>
+bool Send(int fd, const T& record) {
+    return SendRecord(fd, &record, sizeof(T));
+}
+
+template <typename T>
+bool Receive(int fd, T& record, int timeout_ms) {
+    return ReceiveRecord(fd, &record, sizeof(T), timeout_ms);
+}
+
+} // namespace hnvue::hal::hostproto
+
+#endif // HNUE_HAL_PLUGIN_HOST_PROTOCOL_H
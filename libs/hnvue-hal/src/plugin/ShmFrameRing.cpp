@@ -0,0 +1,284 @@
+/**
+ * @file ShmFrameRing.cpp
+ * @brief Single-producer/single-consumer frame ring in shared memory (memfd)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "plugin/ShmFrameRing.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+
+#include <spdlog/spdlog.h>
+
+namespace hnvue::hal {
+
+namespace {
+
+constexpr uint32_t kRingMagic = 0x48565246;  // "HVRF"
+constexpr uint32_t kRingVersion = 1;
+constexpr size_t kCacheLine = 64;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "process-shared ring requires lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "process-shared ring requires lock-free 64-bit atomics");
+
+size_t RoundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t RoundUpPowerOfTwo(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Shared futex (FUTEX_WAIT, not _PRIVATE): waiter and waker are different processes
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected, std::chrono::milliseconds timeout) {
+    timespec ts{static_cast<time_t>(timeout.count() / 1000),
+                static_cast<long>((timeout.count() % 1000) * 1000000)};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Ring control block at the start of the mapping
+ *
+ * Producer and consumer indices sit on separate cache lines.
+ */
+struct ShmFrameRing::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;             ///< Power of two
+    uint32_t reserved;
+    uint64_t slot_stride;            ///< Bytes per slot including ShmSlotHeader
+    uint64_t slot_pixel_bytes;
+
+    // Producer side
+    alignas(kCacheLine) std::atomic<uint32_t> write_seq;   ///< Futex word
+    std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint64_t> published;
+    std::atomic<uint64_t> dropped;
+
+    // Consumer side
+    alignas(kCacheLine) std::atomic<uint32_t> read_seq;
+};
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+std::unique_ptr<ShmFrameRing> ShmFrameRing::Create(uint32_t slot_count, size_t slot_pixel_bytes) {
+    if (slot_count == 0 || slot_count > (1u << 16) || slot_pixel_bytes == 0 ||
+        slot_pixel_bytes > UINT32_MAX) {
+        spdlog::error("[ShmFrameRing] Invalid geometry: {} slots x {} bytes", slot_count, slot_pixel_bytes);
+        return nullptr;
+    }
+    slot_count = RoundUpPowerOfTwo(slot_count);
+    const size_t header_bytes = RoundUp(sizeof(Header), kCacheLine);
+    const size_t stride = RoundUp(sizeof(ShmSlotHeader) + slot_pixel_bytes, kCacheLine);
+    const size_t total = header_bytes + stride * slot_count;
+
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "hnvue-frame-ring", MFD_CLOEXEC));
+    if (fd < 0) {
+        spdlog::error("[ShmFrameRing] memfd_create failed: {}", std::strerror(errno));
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        spdlog::error("[ShmFrameRing] ftruncate({}) failed: {}", total, std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        spdlog::error("[ShmFrameRing] mmap failed: {}", std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    // Fresh memfd pages are zero; construct the control block in place
+    auto* header = new (base) Header();
+    header->magic = kRingMagic;
+    header->version = kRingVersion;
+    header->slot_count = slot_count;
+    header->slot_stride = stride;
+    header->slot_pixel_bytes = slot_pixel_bytes;
+
+    spdlog::info("[ShmFrameRing] Created: {} slots x {} bytes ({} MB)",
+                 slot_count, slot_pixel_bytes, total / (1024 * 1024));
+    return std::unique_ptr<ShmFrameRing>(new ShmFrameRing(fd, base, total));
+}
+
+std::unique_ptr<ShmFrameRing> ShmFrameRing::Attach(int fd) {
+    struct stat st {};
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        spdlog::error("[ShmFrameRing] Attach: fd {} is not a ring", fd);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return nullptr;
+    }
+    const size_t total = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        spdlog::error("[ShmFrameRing] Attach: mmap failed: {}", std::strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    const auto* header = static_cast<const Header*>(base);
+    const size_t header_bytes = RoundUp(sizeof(Header), kCacheLine);
+    bool valid = header->magic == kRingMagic && header->version == kRingVersion &&
+                 header->slot_count != 0 && (header->slot_count & (header->slot_count - 1)) == 0 &&
+                 header->slot_stride >= sizeof(ShmSlotHeader) + header->slot_pixel_bytes &&
+                 header_bytes + header->slot_stride * header->slot_count <= total;
+    if (!valid) {
+        spdlog::error("[ShmFrameRing] Attach: bad ring header");
+        munmap(base, total);
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<ShmFrameRing>(new ShmFrameRing(fd, base, total));
+}
+
+ShmFrameRing::ShmFrameRing(int fd, void* base, size_t mapped_bytes)
+    : fd_(fd)
+    , base_(base)
+    , mapped_bytes_(mapped_bytes)
+    , header_(static_cast<Header*>(base)) {
+}
+
+ShmFrameRing::~ShmFrameRing() {
+    munmap(base_, mapped_bytes_);
+    close(fd_);
+}
+
+uint32_t ShmFrameRing::SlotCount() const {
+    return header_->slot_count;
+}
+
+size_t ShmFrameRing::SlotPixelBytes() const {
+    return static_cast<size_t>(header_->slot_pixel_bytes);
+}
+
+uint8_t* ShmFrameRing::SlotAt(uint32_t sequence) const {
+    const size_t header_bytes = RoundUp(sizeof(Header), kCacheLine);
+    const size_t index = sequence & (header_->slot_count - 1);
+    return static_cast<uint8_t*>(base_) + header_bytes + index * header_->slot_stride;
+}
+
+// =============================================================================
+// Producer
+// =============================================================================
+
+bool ShmFrameRing::Publish(const ShmFrameMeta& meta, const uint8_t* pixels, size_t pixel_bytes) {
+    const uint32_t write = header_->write_seq.load(std::memory_order_relaxed);
+    const uint32_t read = header_->read_seq.load(std::memory_order_acquire);
+    if (write - read >= header_->slot_count || pixel_bytes > header_->slot_pixel_bytes) {
+        header_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint8_t* slot = SlotAt(write);
+    auto* slot_header = reinterpret_cast<ShmSlotHeader*>(slot);
+    slot_header->sequence_number = meta.sequence_number;
+    slot_header->timestamp_unix_us = meta.timestamp_unix_us;
+    slot_header->width = meta.width;
+    slot_header->height = meta.height;
+    slot_header->bit_depth = meta.bit_depth;
+    slot_header->pixel_bytes = static_cast<uint32_t>(pixel_bytes);
+    std::strncpy(slot_header->session_id, meta.session_id != nullptr ? meta.session_id : "",
+                 kShmSessionIdBytes - 1);
+    slot_header->session_id[kShmSessionIdBytes - 1] = '\0';
+    if (pixel_bytes > 0) {
+        std::memcpy(slot + sizeof(ShmSlotHeader), pixels, pixel_bytes);
+    }
+    slot_header->publish_ns = SteadyNowNs();
+
+    // seq_cst pairs with the consumer's store to consumer_waiting in Wait()
+    header_->write_seq.store(write + 1, std::memory_order_seq_cst);
+    header_->published.fetch_add(1, std::memory_order_relaxed);
+    if (header_->consumer_waiting.load(std::memory_order_seq_cst) != 0) {
+        FutexWake(&header_->write_seq);
+    }
+    return true;
+}
+
+// =============================================================================
+// Consumer
+// =============================================================================
+
+bool ShmFrameRing::Wait(std::chrono::milliseconds timeout) {
+    const uint32_t read = header_->read_seq.load(std::memory_order_relaxed);
+    uint32_t write = header_->write_seq.load(std::memory_order_acquire);
+    if (write != read) {
+        return true;
+    }
+    header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+    write = header_->write_seq.load(std::memory_order_seq_cst);
+    if (write == read) {
+        FutexWait(&header_->write_seq, write, timeout);
+    }
+    header_->consumer_waiting.store(0, std::memory_order_relaxed);
+    return header_->write_seq.load(std::memory_order_acquire) != read;
+}
+
+bool ShmFrameRing::Peek(ShmFrameView& view) const {
+    const uint32_t read = header_->read_seq.load(std::memory_order_relaxed);
+    if (header_->write_seq.load(std::memory_order_acquire) == read) {
+        return false;
+    }
+    const uint8_t* slot = SlotAt(read);
+    view.header = reinterpret_cast<const ShmSlotHeader*>(slot);
+    view.pixels = slot + sizeof(ShmSlotHeader);
+    // The producer is another process: never trust its length beyond the slot
+    view.pixel_bytes = std::min<size_t>(view.header->pixel_bytes, header_->slot_pixel_bytes);
+    return true;
+}
+
+void ShmFrameRing::Release() {
+    const uint32_t read = header_->read_seq.load(std::memory_order_relaxed);
+    if (header_->write_seq.load(std::memory_order_acquire) != read) {
+        header_->read_seq.store(read + 1, std::memory_order_release);
+    }
+}
+
+void ShmFrameRing::Wake() {
+    FutexWake(&header_->write_seq);
+}
+
+uint64_t ShmFrameRing::PublishedFrames() const {
+    return header_->published.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmFrameRing::DroppedFrames() const {
+    return header_->dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace hnvue::hal
@@ -0,0 +1,167 @@
+/**
+ * @file ShmFrameRing.h
+ * @brief Single-producer/single-consumer frame ring in shared memory (memfd)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * Carries detector frames from the plugin host process to the core
+ * process. The ring lives in one memfd mapping shared by both sides:
+ *
+ *   [ring header][slot 0: ShmSlotHeader + pixels][slot 1] ...
+ *
+ * The producer (plugin host) copies a frame into the next free slot and
+ * publishes it by advancing write_seq; the consumer (core) reads the slot
+ * in place and advances read_seq when done. write_seq doubles as a
+ * process-shared futex word, so an idle consumer sleeps in the kernel and
+ * is woken by the publishing store. The producer never blocks: a full
+ * ring drops the new frame and counts it.
+ *
+ * All producer state is in the mapping, so a restarted host attaches the
+ * same memfd and continues where the crashed one stopped; a slot that was
+ * being written when the host died is simply never published.
+ */
+
+#ifndef HNUE_HAL_SHM_FRAME_RING_H
+#define HNUE_HAL_SHM_FRAME_RING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hnvue::hal {
+
+/// Bytes of session_id carried per slot (including the terminator)
+constexpr size_t kShmSessionIdBytes = 64;
+
+/**
+ * @brief Per-frame fields stored ahead of the pixels in each slot
+ */
+struct ShmSlotHeader {
+    int64_t sequence_number;
+    int64_t timestamp_unix_us;    ///< Capture time, wall clock (process-independent)
+    int64_t publish_ns;           ///< steady_clock when published (shared across processes)
+    int32_t width;
+    int32_t height;
+    int32_t bit_depth;
+    uint32_t pixel_bytes;
+    char session_id[kShmSessionIdBytes];
+};
+
+/**
+ * @brief Frame metadata passed to Publish()
+ */
+struct ShmFrameMeta {
+    int64_t sequence_number = 0;
+    int64_t timestamp_unix_us = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t bit_depth = 0;
+    const char* session_id = "";
+};
+
+/**
+ * @brief In-place view of a published slot (valid until Release())
+ */
+struct ShmFrameView {
+    const ShmSlotHeader* header = nullptr;
+    const uint8_t* pixels = nullptr;
+    size_t pixel_bytes = 0;       ///< header->pixel_bytes bounded by the slot size
+};
+
+/**
+ * @brief memfd-backed SPSC frame ring
+ *
+ * Thread Safety:
+ * - One producer (Publish) and one consumer (Wait/Peek/Release), possibly
+ *   in different processes
+ * - Wake() may be called from any thread of the consumer process
+ */
+class ShmFrameRing {
+public:
+    /**
+     * @brief Create a new ring in an anonymous memfd
+     * @param slot_count Number of slots, rounded up to a power of two
+     * @param slot_pixel_bytes Largest frame a slot holds
+     * @return nullptr if the memfd cannot be created or mapped
+     */
+    static std::unique_ptr<ShmFrameRing> Create(uint32_t slot_count, size_t slot_pixel_bytes);
+
+    /**
+     * @brief Map an existing ring
+     * @param fd memfd of a ring created by Create(); ownership is taken
+     * @return nullptr if fd is not a valid ring
+     */
+    static std::unique_ptr<ShmFrameRing> Attach(int fd);
+
+    ~ShmFrameRing();
+
+    ShmFrameRing(const ShmFrameRing&) = delete;
+    ShmFrameRing& operator=(const ShmFrameRing&) = delete;
+
+    /// memfd backing the ring (close-on-exec; clear it to hand to a child)
+    int Fd() const { return fd_; }
+
+    uint32_t SlotCount() const;
+    size_t SlotPixelBytes() const;
+
+    // =========================================================================
+    // Producer
+    // =========================================================================
+
+    /**
+     * @brief Copy one frame into the next slot and publish it
+     * @return false if the ring is full or the frame exceeds a slot
+     *         (the frame is dropped and counted)
+     */
+    bool Publish(const ShmFrameMeta& meta, const uint8_t* pixels, size_t pixel_bytes);
+
+    // =========================================================================
+    // Consumer
+    // =========================================================================
+
+    /**
+     * @brief Sleep until a frame is published, Wake() is called or timeout
+     * @return true if a frame is readable
+     */
+    bool Wait(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Oldest unread frame
+     * @return false if the ring is empty
+     */
+    bool Peek(ShmFrameView& view) const;
+
+    /// Return the slot returned by Peek() to the producer
+    void Release();
+
+    /// Interrupt a Wait() in progress
+    void Wake();
+
+    // =========================================================================
+    // Counters (shared by both sides)
+    // =========================================================================
+
+    uint64_t PublishedFrames() const;
+    uint64_t DroppedFrames() const;
+
+private:
+    struct Header;
+
+    ShmFrameRing(int fd, void* base, size_t mapped_bytes);
+
+    uint8_t* SlotAt(uint32_t sequence) const;
+
+    int fd_;
+    void* base_;
+    size_t mapped_bytes_;
+    Header* header_;
+};
+
+} // namespace hnvue::hal
+
+#endif // HNUE_HAL_SHM_FRAME_RING_H
@@ -0,0 +1,337 @@
+/**
+ * @file GrpcDetectorStandIn.h
+ * @brief Stand-in networked detector serving DetectorAcquisition on localhost
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Test double for networked detector acquisition
+ * SPDX-License-Identifier: MIT
+ *
+ * Serves detector_acquisition.proto through the generic callback API, so no
+ * generated service code is needed. StreamFrames sends num_frames RawFrames
+ * (0 = until cancelled) paced at the requested frame_rate. Pixels come from
+ * one pattern buffer that every frame references without copying, like a
+ * detector sending out of its own frame memory; the pattern is
+ * pixel[i] = uint8_t(i * 7 + 3). Faults are injected by sending a wrong
+ * pixel_data size or malformed messages.
+ */
+
+#ifndef HNUE_HAL_TESTS_GRPC_DETECTOR_STAND_IN_H
+#define HNUE_HAL_TESTS_GRPC_DETECTOR_STAND_IN_H
+
+#include "detector_acquisition.pb.h"
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hnvue::hal::test {
+
+class GrpcDetectorStandIn {
+public:
+    GrpcDetectorStandIn(int32_t width, int32_t height, int32_t bit_depth)
+        : width_(width), height_(height), bit_depth_(bit_depth) {
+        pixels_.resize(static_cast<size_t>(width) * static_cast<size_t>(height) *
+                       static_cast<size_t>((bit_depth + 7) / 8));
+        for (size_t i = 0; i < pixels_.size(); ++i) {
+            pixels_[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+        wrong_pixels_.resize(pixels_.size() / 2 + 1);
+    }
+
+    ~GrpcDetectorStandIn() { Stop(); }
+
+    GrpcDetectorStandIn(const GrpcDetectorStandIn&) = delete;
+    GrpcDetectorStandIn& operator=(const GrpcDetectorStandIn&) = delete;
+
+    bool Start() {
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port_);
+        builder.RegisterCallbackGenericService(&service_);
+        server_ = builder.BuildAndStart();
+        return server_ != nullptr && port_ > 0;
+    }
+
+    void Stop() {
+        if (server_) {
+            server_->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            server_->Wait();
+            server_.reset();
+        }
+    }
+
+    std::string Endpoint() const { return "127.0.0.1:" + std::to_string(port_); }
+
+    static uint8_t PatternAt(size_t index) { return static_cast<uint8_t>(index * 7 + 3); }
+
+    // Fault injection
+    void SetWrongSizeEvery(int n) { wrong_size_every_ = n; }
+    void SetMalformedEvery(int n) { malformed_every_ = n; }
+    void FailStart(bool fail) { fail_start_ = fail; }
+
+    int StartCalls() const { return start_calls_; }
+    int StopCalls() const { return stop_calls_; }
+    int Streams() const { return streams_; }
+    int64_t FramesSent() const { return frames_sent_; }
+    int ActiveStreams() const { return active_streams_; }
+
+    detector::AcquisitionConfig LastConfig() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_config_;
+    }
+
+private:
+    static constexpr const char* kPrefix = "/hnvue.hal.detector.DetectorAcquisition/";
+
+    class Reactor : public grpc::ServerGenericBidiReactor {
+    public:
+        Reactor(GrpcDetectorStandIn& owner, grpc::GenericCallbackServerContext* context)
+            : owner_(owner), method_(context->method()) {
+            StartRead(&request_);
+        }
+
+        void OnReadDone(bool ok) override {
+            if (!ok) {
+                Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "no request"));
+                return;
+            }
+            if (method_ == std::string(kPrefix) + "StreamFrames") {
+                detector::AcquisitionConfig config;
+                Parse(request_, &config);
+                {
+                    std::lock_guard<std::mutex> lock(owner_.mutex_);
+                    owner_.last_config_ = config;
+                }
+                ++owner_.streams_;
+                streaming_ = std::thread(&Reactor::Stream, this, config);
+                return;
+            }
+            grpc::Status status = owner_.Unary(method_, request_, &response_);
+            if (status.ok()) {
+                StartWriteAndFinish(&response_, grpc::WriteOptions(), status);
+            } else {
+                Finish(status);
+            }
+        }
+
+        void OnWriteDone(bool ok) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            write_pending_ = false;
+            write_failed_ = !ok;
+            cv_.notify_one();
+        }
+
+        void OnCancel() override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_ = true;
+            cv_.notify_one();
+        }
+
+        void OnDone() override {
+            if (streaming_.joinable()) {
+                streaming_.join();
+            }
+            delete this;
+        }
+
+    private:
+        void Stream(detector::AcquisitionConfig config) {
+            ++owner_.active_streams_;
+            auto period = config.frame_rate() > 0.0f
+                ? std::chrono::microseconds(static_cast<int64_t>(1e6 / config.frame_rate()))
+                : std::chrono::microseconds(0);
+            auto next = std::chrono::steady_clock::now();
+            int64_t sequence = 0;
+            bool cancelled = false;
+
+            while (config.num_frames() == 0 || sequence < config.num_frames()) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (cv_.wait_until(lock, next, [this]() { return cancelled_; })) {
+                        cancelled = true;
+                        break;
+                    }
+                    write_pending_ = true;
+                }
+                frame_ = owner_.BuildFrame(sequence, config.session_id());
+                StartWrite(&frame_);
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return !write_pending_ || cancelled_; });
+                if (cancelled_ || write_failed_) {
+                    cancelled = true;
+                    break;
+                }
+                ++owner_.frames_sent_;
+                ++sequence;
+                next += period;
+            }
+
+            // A cancelled write still completes before OnDone
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return !write_pending_; });
+            }
+            --owner_.active_streams_;
+            Finish(cancelled ? grpc::Status::CANCELLED : grpc::Status::OK);
+        }
+
+        GrpcDetectorStandIn& owner_;
+        std::string method_;
+        grpc::ByteBuffer request_;
+        grpc::ByteBuffer response_;
+        grpc::ByteBuffer frame_;
+        std::thread streaming_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool write_pending_ = false;
+        bool write_failed_ = false;
+        bool cancelled_ = false;
+    };
+
+    class Service : public grpc::CallbackGenericService {
+    public:
+        explicit Service(GrpcDetectorStandIn& owner) : owner_(owner) {}
+
+        grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext* context) override {
+            return new Reactor(owner_, context);
+        }
+
+    private:
+        GrpcDetectorStandIn& owner_;
+    };
+
+    static bool Parse(const grpc::ByteBuffer& buffer, google::protobuf::MessageLite* message) {
+        grpc::ByteBuffer copy(buffer);
+        std::vector<grpc::Slice> slices;
+        if (!copy.Dump(&slices).ok()) {
+            return false;
+        }
+        std::string bytes;
+        for (const auto& slice : slices) {
+            bytes.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+        return message->ParseFromString(bytes);
+    }
+
+    static grpc::ByteBuffer Encode(const google::protobuf::MessageLite& message) {
+        grpc::Slice slice(message.SerializeAsString());
+        return grpc::ByteBuffer(&slice, 1);
+    }
+
+    grpc::Status Unary(const std::string& method, const grpc::ByteBuffer& request,
+                       grpc::ByteBuffer* response) {
+        if (method == std::string(kPrefix) + "GetDetectorInfo") {
+            detector::DetectorInfo info;
+            info.set_vendor("StandIn");
+            info.set_model("NET-DET-1");
+            info.set_serial_number("SN-0001");
+            info.set_pixel_width(width_);
+            info.set_pixel_height(height_);
+            info.set_pixel_pitch_um(140.0f);
+            info.set_max_bit_depth(bit_depth_);
+            info.set_max_frame_rate(30.0f);
+            info.set_firmware_version("1.0.0");
+            *response = Encode(info);
+            return grpc::Status::OK;
+        }
+        if (method == std::string(kPrefix) + "StartAcquisition") {
+            ++start_calls_;
+            detector::DetectorResponse reply;
+            reply.set_success(!fail_start_);
+            if (fail_start_) {
+                reply.set_error_msg("detector busy");
+            }
+            *response = Encode(reply);
+            return grpc::Status::OK;
+        }
+        if (method == std::string(kPrefix) + "StopAcquisition") {
+            ++stop_calls_;
+            detector::DetectorResponse reply;
+            reply.set_success(true);
+            *response = Encode(reply);
+            return grpc::Status::OK;
+        }
+        if (method == std::string(kPrefix) + "RunCalibration") {
+            detector::CalibrationType type;
+            Parse(request, &type);
+            detector::CalibrationResult reply;
+            reply.set_success(type.num_frames() > 0);
+            reply.set_output_path("/cal/" + std::to_string(static_cast<int>(type.type())));
+            *response = Encode(reply);
+            return grpc::Status::OK;
+        }
+        return grpc::Status(grpc::StatusCode::UNIMPLEMENTED, method);
+    }
+
+    /// Header fields, then pixel_data referencing the shared pattern (no copy)
+    grpc::ByteBuffer BuildFrame(int64_t sequence, const std::string& session_id) {
+        int index = static_cast<int>(sequence) + 1;
+        if (malformed_every_ > 0 && index % malformed_every_ == 0) {
+            grpc::Slice garbage(std::string("\x0f\xff\xff", 3));
+            return grpc::ByteBuffer(&garbage, 1);
+        }
+        const std::vector<uint8_t>& pixels =
+            (wrong_size_every_ > 0 && index % wrong_size_every_ == 0) ? wrong_pixels_ : pixels_;
+
+        detector::RawFrame header;
+        header.set_sequence_number(sequence);
+        header.set_timestamp_us(sequence * 1000);
+        header.set_width(width_);
+        header.set_height(height_);
+        header.set_bit_depth(bit_depth_);
+        header.set_session_id(session_id);
+        std::string prefix = header.SerializeAsString();
+
+        // pixel_data: field 6, wire type 2
+        prefix.push_back(static_cast<char>((6 << 3) | 2));
+        uint64_t length = pixels.size();
+        while (length >= 0x80) {
+            prefix.push_back(static_cast<char>((length & 0x7F) | 0x80));
+            length >>= 7;
+        }
+        prefix.push_back(static_cast<char>(length));
+
+        grpc::Slice slices[2] = {
+            grpc::Slice(prefix),
+            grpc::Slice(pixels.data(), pixels.size(), grpc::Slice::STATIC_SLICE),
+        };
+        return grpc::ByteBuffer(slices, 2);
+    }
+
+    int32_t width_;
+    int32_t height_;
+    int32_t bit_depth_;
+    std::vector<uint8_t> pixels_;
+    std::vector<uint8_t> wrong_pixels_;
+
+    Service service_{*this};
+    std::unique_ptr<grpc::Server> server_;
+    int port_ = 0;
+
+    mutable std::mutex mutex_;
+    detector::AcquisitionConfig last_config_;
+
+    std::atomic<int> wrong_size_every_{0};
+    std::atomic<int> malformed_every_{0};
+    std::atomic<bool> fail_start_{false};
+    std::atomic<int> start_calls_{0};
+    std::atomic<int> stop_calls_{0};
+    std::atomic<int> streams_{0};
+    std::atomic<int> active_streams_{0};
+    std::atomic<int64_t> frames_sent_{0};
+};
+
+} // namespace hnvue::hal::test
+
+#endif // HNUE_HAL_TESTS_GRPC_DETECTOR_STAND_IN_H
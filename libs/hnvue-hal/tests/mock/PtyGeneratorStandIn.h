@@ -0,0 +1,357 @@
+/**
+ * @file PtyGeneratorStandIn.h
+ * @brief Stand-in HVG on the master side of a pseudo-terminal pair
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Test double for the serial HVG link
+ * SPDX-License-Identifier: MIT
+ *
+ * GeneratorSerial opens the slave path like a real serial port; a thread on
+ * the master side parses the host's frames and answers as a generator would
+ * (ACK, STATUS, CAPABILITIES, EXPOSURE_DONE), including re-acknowledging a
+ * retransmitted SEQ without executing it again. Faults are injected by
+ * dropping requests or answers and by writing raw bytes.
+ */
+
+#ifndef HNUE_HAL_TESTS_PTY_GENERATOR_STAND_IN_H
+#define HNUE_HAL_TESTS_PTY_GENERATOR_STAND_IN_H
+
+#include "generator/HvgProtocol.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace hnvue::hal::test {
+
+class PtyGeneratorStandIn {
+public:
+    PtyGeneratorStandIn() {
+        caps_.min_kvp = 40.0f;
+        caps_.max_kvp = 150.0f;
+        caps_.min_ma = 0.1f;
+        caps_.max_ma = 1000.0f;
+        caps_.min_ms = 1.0f;
+        caps_.max_ms = 10000.0f;
+        caps_.has_aec = true;
+        caps_.has_dual_focus = true;
+        caps_.vendor_name = "PTY HVG";
+        caps_.model_name = "HVG-PTY-001";
+        caps_.firmware_version = "2.1.0";
+        status_.state = GeneratorState::GEN_IDLE;
+        status_.interlock_ok = true;
+    }
+
+    ~PtyGeneratorStandIn() { Stop(); }
+
+    PtyGeneratorStandIn(const PtyGeneratorStandIn&) = delete;
+    PtyGeneratorStandIn& operator=(const PtyGeneratorStandIn&) = delete;
+
+    /// Create the pty pair and start answering
+    bool Start() {
+        master_ = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master_ < 0 || grantpt(master_) != 0 || unlockpt(master_) != 0) {
+            return false;
+        }
+        char name[128];
+        if (ptsname_r(master_, name, sizeof(name)) != 0) {
+            return false;
+        }
+        slave_path_ = name;
+        fcntl(master_, F_SETFL, fcntl(master_, F_GETFL) | O_NONBLOCK);
+        running_ = true;
+        thread_ = std::thread([this]() { Run(); });
+        return true;
+    }
+
+    /// Stop answering and close the master (the host sees a hang-up)
+    void Stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (master_ >= 0) {
+            ::close(master_);
+            master_ = -1;
+        }
+    }
+
+    const std::string& SlavePath() const { return slave_path_; }
+
+    // =========================================================================
+    // Fault injection
+    // =========================================================================
+
+    /// Ignore every request
+    void SetSilent(bool silent) { silent_ = silent; }
+
+    /// Ignore the next count requests entirely
+    void DropRequests(int count) { std::lock_guard<std::mutex> lock(mutex_); drop_requests_ = count; }
+
+    /// Execute the next count requests but lose their answers
+    void DropAnswers(int count) { std::lock_guard<std::mutex> lock(mutex_); drop_answers_ = count; }
+
+    /// Reject SET_PARAMS with AckResult::REJECTED
+    void RejectParams(bool reject) { std::lock_guard<std::mutex> lock(mutex_); reject_params_ = reject; }
+
+    void SendStatus(const HvgStatus& status) {
+        uint8_t payload[hvg::kStatusSize];
+        hvg::EncodeStatus(status, payload);
+        SendFrame(hvg::MessageId::STATUS, 0, payload, sizeof(payload));
+    }
+
+    void SendAlarm(const HvgAlarm& alarm) {
+        uint8_t payload[hvg::kMaxPayload];
+        size_t length = hvg::EncodeAlarm(alarm, payload, sizeof(payload));
+        SendFrame(hvg::MessageId::ALARM, 0, payload, length);
+    }
+
+    void WriteRaw(const std::vector<uint8_t>& bytes) { WriteAll(bytes.data(), bytes.size()); }
+
+    // =========================================================================
+    // Observation
+    // =========================================================================
+
+    /// Requests seen on the wire (including drops and duplicates)
+    int Received(hvg::MessageId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Count(received_, id);
+    }
+
+    /// Requests executed (duplicates excluded)
+    int Executed(hvg::MessageId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Count(executed_, id);
+    }
+
+    int Duplicates() const { std::lock_guard<std::mutex> lock(mutex_); return duplicates_; }
+
+    /// Request ids in arrival order
+    std::vector<hvg::MessageId> ReceivedOrder() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+
+    /// Largest single read() on the master side
+    size_t MaxReadBytes() const { std::lock_guard<std::mutex> lock(mutex_); return max_read_; }
+
+    GeneratorState State() const { std::lock_guard<std::mutex> lock(mutex_); return status_.state; }
+
+private:
+    struct Answer {
+        bool valid = false;
+        uint8_t seq = 0;
+        std::vector<uint8_t> frame;
+    };
+
+    static int Count(const std::map<hvg::MessageId, int>& counts, hvg::MessageId id) {
+        auto it = counts.find(id);
+        return it == counts.end() ? 0 : it->second;
+    }
+
+    void Run() {
+        hvg::FrameParser parser;
+        std::array<uint8_t, 1024> buffer;
+        while (running_) {
+            pollfd fd{master_, POLLIN, 0};
+            int ready = ::poll(&fd, 1, 5);
+            if (ready > 0 && (fd.revents & POLLIN)) {
+                ssize_t received = ::read(master_, buffer.data(), buffer.size());
+                if (received > 0) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        max_read_ = std::max(max_read_, static_cast<size_t>(received));
+                    }
+                    parser.Feed(buffer.data(), static_cast<size_t>(received),
+                                [this](const hvg::FrameView& frame) { Handle(frame); });
+                }
+            } else if (ready > 0) {
+                // No slave open yet (or it closed)
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            FinishExposure();
+        }
+    }
+
+    void Handle(const hvg::FrameView& frame) {
+        if (silent_) {
+            return;
+        }
+        std::vector<uint8_t> answer;
+        std::vector<uint8_t> follow_up;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++received_[frame.id];
+            order_.push_back(frame.id);
+            if (drop_requests_ > 0) {
+                --drop_requests_;
+                return;
+            }
+            for (const Answer& recent : recent_) {
+                if (recent.valid && recent.seq == frame.seq) {
+                    ++duplicates_;
+                    answer = recent.frame;
+                    break;
+                }
+            }
+            if (answer.empty()) {
+                Execute(frame, answer, follow_up);
+                ++executed_[frame.id];
+                Answer& slot = recent_[recent_next_++ % recent_.size()];
+                slot.valid = true;
+                slot.seq = frame.seq;
+                slot.frame = answer;
+            }
+            if (drop_answers_ > 0) {
+                --drop_answers_;
+                return;
+            }
+        }
+        WriteAll(answer.data(), answer.size());
+        WriteAll(follow_up.data(), follow_up.size());
+    }
+
+    /// Called with mutex_ held
+    void Execute(const hvg::FrameView& frame, std::vector<uint8_t>& answer,
+                 std::vector<uint8_t>& follow_up) {
+        hvg::AckResult result = hvg::AckResult::OK;
+        switch (frame.id) {
+            case hvg::MessageId::GET_CAPABILITIES: {
+                uint8_t payload[hvg::kMaxPayload];
+                size_t length = hvg::EncodeCapabilities(caps_, payload, sizeof(payload));
+                hvg::AppendFrame(answer, hvg::MessageId::CAPABILITIES, frame.seq, payload, length);
+                return;
+            }
+            case hvg::MessageId::GET_STATUS: {
+                uint8_t payload[hvg::kStatusSize];
+                hvg::EncodeStatus(status_, payload);
+                hvg::AppendFrame(answer, hvg::MessageId::STATUS, frame.seq, payload, sizeof(payload));
+                return;
+            }
+            case hvg::MessageId::SET_PARAMS:
+                if (reject_params_ || !hvg::DecodeParams(frame, params_)) {
+                    result = hvg::AckResult::REJECTED;
+                } else if (status_.state == GeneratorState::GEN_EXPOSING) {
+                    result = hvg::AckResult::INVALID_STATE;
+                } else {
+                    status_.state = GeneratorState::GEN_READY;
+                }
+                break;
+            case hvg::MessageId::START_EXPOSURE:
+                if (status_.state != GeneratorState::GEN_READY) {
+                    result = hvg::AckResult::INVALID_STATE;
+                } else {
+                    status_.state = GeneratorState::GEN_EXPOSING;
+                    status_.actual_kvp = params_.kvp;
+                    status_.actual_ma = params_.ma;
+                    exposure_end_ = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(static_cast<int64_t>(params_.ms * 1000.0f));
+                    AppendStatus(follow_up);
+                }
+                break;
+            case hvg::MessageId::ABORT_EXPOSURE:
+                if (status_.state == GeneratorState::GEN_EXPOSING) {
+                    status_.state = GeneratorState::GEN_READY;
+                    status_.actual_kvp = 0.0f;
+                    status_.actual_ma = 0.0f;
+                    AppendStatus(follow_up);
+                }
+                break;
+            default:
+                result = hvg::AckResult::UNKNOWN_COMMAND;
+                break;
+        }
+        uint8_t payload[hvg::kAckSize];
+        hvg::EncodeAck(frame.id, result, payload);
+        hvg::AppendFrame(answer, hvg::MessageId::ACK, frame.seq, payload, sizeof(payload));
+    }
+
+    void AppendStatus(std::vector<uint8_t>& out) {
+        uint8_t payload[hvg::kStatusSize];
+        hvg::EncodeStatus(status_, payload);
+        hvg::AppendFrame(out, hvg::MessageId::STATUS, 0, payload, sizeof(payload));
+    }
+
+    void FinishExposure() {
+        std::vector<uint8_t> out;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (status_.state != GeneratorState::GEN_EXPOSING ||
+                std::chrono::steady_clock::now() < exposure_end_) {
+                return;
+            }
+            ExposureResult result;
+            result.actual_kvp = params_.kvp;
+            result.actual_ma = params_.ma;
+            result.actual_ms = params_.ms;
+            result.actual_mas = params_.ma * params_.ms / 1000.0f;
+            uint8_t payload[hvg::kExposureDoneSize];
+            hvg::EncodeExposureDone(result, payload);
+            hvg::AppendFrame(out, hvg::MessageId::EXPOSURE_DONE, 0, payload, sizeof(payload));
+            status_.state = GeneratorState::GEN_READY;
+            status_.actual_kvp = 0.0f;
+            status_.actual_ma = 0.0f;
+            AppendStatus(out);
+        }
+        WriteAll(out.data(), out.size());
+    }
+
+    void SendFrame(hvg::MessageId id, uint8_t seq, const uint8_t* payload, size_t length) {
+        std::vector<uint8_t> frame;
+        hvg::AppendFrame(frame, id, seq, payload, length);
+        WriteAll(frame.data(), frame.size());
+    }
+
+    void WriteAll(const uint8_t* data, size_t size) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        size_t offset = 0;
+        for (int attempts = 0; offset < size && attempts < 1000; ++attempts) {
+            ssize_t written = ::write(master_, data + offset, size - offset);
+            if (written > 0) {
+                offset += static_cast<size_t>(written);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    int master_ = -1;
+    std::string slave_path_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> silent_{false};
+    std::mutex write_mutex_;
+
+    mutable std::mutex mutex_;
+    HvgCapabilities caps_;
+    HvgStatus status_;
+    ExposureParams params_;
+    std::chrono::steady_clock::time_point exposure_end_;
+    int drop_requests_ = 0;
+    int drop_answers_ = 0;
+    bool reject_params_ = false;
+    std::array<Answer, 8> recent_;
+    size_t recent_next_ = 0;
+    std::map<hvg::MessageId, int> received_;
+    std::map<hvg::MessageId, int> executed_;
+    std::vector<hvg::MessageId> order_;
+    int duplicates_ = 0;
+    size_t max_read_ = 0;
+};
+
+} // namespace hnvue::hal::test
+
+#endif // HNUE_HAL_TESTS_PTY_GENERATOR_STAND_IN_H
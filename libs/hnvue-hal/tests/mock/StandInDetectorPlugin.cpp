@@ -0,0 +1,187 @@
+/**
+ * @file StandInDetectorPlugin.cpp
+ * @brief Stand-in vendor detector plugin for out-of-process host tests
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Test double for vendor detector plugins
+ * SPDX-License-Identifier: MIT
+ *
+ * Built as a loadable module exporting the PluginAbi.h factory functions.
+ * Acquisition produces 512 x 512 x 16-bit frames on a vendor thread at the
+ * requested frame rate (0 = 1000 fps) with pixel[i] = uint8_t(i * 7 + seq),
+ * so the receiver can check every frame's content.
+ *
+ * Environment, read by CreateDetector() (stands in for a new plugin build):
+ * - HNVUE_STANDIN_INIT_DELAY_MS: vendor initialisation time
+ * - HNVUE_STANDIN_FIRMWARE: reported firmware_version (default "2.1.0")
+ *
+ * Misbehaviour on request, to exercise the host supervision:
+ * - RunCalibration(CALIB_DEFECT_MAP, n) never returns (hung vendor SDK)
+ * - RunCalibration(any, n < 0) aborts the process (crashing vendor SDK)
+ */
+
+#include "hnvue/hal/IDetector.h"
+#include "hnvue/hal/PluginAbi.h"
+#include "hnvue/infra/Clock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace hnvue::hal;
+
+constexpr int32_t kWidth = 512;
+constexpr int32_t kHeight = 512;
+constexpr int32_t kBitDepth = 16;
+
+class StandInDetector : public IDetector {
+public:
+    explicit StandInDetector(std::string firmware) : firmware_(std::move(firmware)) {}
+    ~StandInDetector() override { StopAcquisition(); }
+
+    DetectorInfo GetDetectorInfo() override {
+        DetectorInfo info;
+        info.vendor = "StandIn";
+        info.model = "PLUGIN-DET-1";
+        info.serial_number = "SN-4242";
+        info.pixel_width = kWidth;
+        info.pixel_height = kHeight;
+        info.pixel_pitch_um = 150.0f;
+        info.max_bit_depth = kBitDepth;
+        info.max_frame_rate = 30.0f;
+        info.firmware_version = firmware_;
+        return info;
+    }
+
+    DetectorStatus GetStatus() override {
+        DetectorStatus status;
+        status.is_acquiring = running_.load();
+        status.frames_acquired = frames_.load();
+        status.temperature_c = 31.5f;
+        std::lock_guard<std::mutex> lock(mutex_);
+        status.current_session_id = session_id_;
+        return status;
+    }
+
+    bool StartAcquisition(const AcquisitionConfig& cfg) override {
+        if (running_.exchange(true)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            session_id_ = cfg.session_id;
+        }
+        frames_ = 0;
+        worker_ = std::thread(&StandInDetector::Produce, this, cfg);
+        return true;
+    }
+
+    bool StopAcquisition() override {
+        running_ = false;
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        return true;
+    }
+
+    CalibrationResult RunCalibration(CalibType type, int32_t num_frames) override {
+        if (num_frames < 0) {
+            std::abort();
+        }
+        if (type == CalibType::CALIB_DEFECT_MAP) {
+            std::this_thread::sleep_for(std::chrono::hours(1));
+        }
+        CalibrationResult result;
+        result.success = num_frames > 0;
+        result.output_path = "/cal/standin/" + std::to_string(static_cast<int>(type));
+        return result;
+    }
+
+    void RegisterFrameCallback(FrameCallback cb) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks_.push_back(std::move(cb));
+    }
+
+private:
+    void Produce(AcquisitionConfig cfg) {
+        auto period = std::chrono::microseconds(
+            cfg.frame_rate > 0.0f ? static_cast<int64_t>(1e6 / cfg.frame_rate) : 1000);
+        auto next = std::chrono::steady_clock::now();
+        RawFrame frame;
+        frame.width = kWidth;
+        frame.height = kHeight;
+        frame.bit_depth = kBitDepth;
+        frame.session_id = cfg.session_id;
+        frame.pixel_data.resize(static_cast<size_t>(kWidth) * kHeight * 2);
+
+        for (int64_t seq = 0; running_ && (cfg.num_frames == 0 || seq < cfg.num_frames); ++seq) {
+            std::this_thread::sleep_until(next);
+            next += period;
+            for (size_t i = 0; i < frame.pixel_data.size(); ++i) {
+                frame.pixel_data[i] = static_cast<uint8_t>(i * 7 + static_cast<size_t>(seq));
+            }
+            frame.sequence_number = seq;
+            frame.timestamp_us = hnvue::infra::MonotonicClock::NowUs();
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& cb : callbacks_) {
+                cb(frame);
+            }
+            ++frames_;
+        }
+        running_ = false;
+    }
+
+    const std::string firmware_;
+    std::mutex mutex_;
+    std::vector<FrameCallback> callbacks_;
+    std::string session_id_;
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    std::atomic<int32_t> frames_{0};
+};
+
+PluginManifest MakeManifest() {
+    PluginManifest manifest;
+    manifest.api_version = HNUE_HAL_API_VERSION;
+    manifest.plugin_version = 0x01000000;
+    manifest.plugin_name = "StandInDetectorPlugin";
+    manifest.vendor_name = "StandIn";
+    manifest.model_name = "PLUGIN-DET-1";
+    manifest.max_frame_width = kWidth;
+    manifest.max_frame_height = kHeight;
+    manifest.max_frame_rate = 30.0f;
+    return manifest;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+__attribute__((visibility("default")))
+IDetector* CreateDetector(const PluginConfig* /*config*/) {
+    if (const char* delay = std::getenv("HNVUE_STANDIN_INIT_DELAY_MS")) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::atoi(delay)));
+    }
+    const char* firmware = std::getenv("HNVUE_STANDIN_FIRMWARE");
+    return new StandInDetector(firmware ? firmware : "2.1.0");
+}
+
+__attribute__((visibility("default")))
+void DestroyDetector(IDetector* detector) {
+    delete detector;
+}
+
+__attribute__((visibility("default")))
+const PluginManifest* GetPluginManifest() {
+    static const PluginManifest manifest = MakeManifest();
+    return &manifest;
+}
+
+} // extern "C"
@@ -0,0 +1,209 @@
+/**
+ * @file test_aec_abort_line.cpp
+ * @brief GTest unit tests for the AEC abort fast path (AecAbortLine)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   SetHandler/Start:  null handler / while running / no handler
+ *   Signal:            not armed / armed (handler invoked once) / repeated signal
+ *   Arm:               not running / rearm after abort / spinning and sleeping waits
+ *   AecController:     armed line bypasses IGenerator::AbortExposure /
+ *                      disarmed line falls back to IGenerator::AbortExposure
+ *   GeneratorSimulator: fast abort ends the exposure early, status published
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "aec/AecAbortLine.h"
+#include "aec/AecController.h"
+#include "hnvue/hal/generator/GeneratorSimulator.h"
+
+#include "mock/MockGenerator.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+using namespace testing;
+
+namespace {
+
+struct HandlerProbe {
+    std::atomic<int> calls{0};
+    std::atomic<float> dose{0.0f};
+
+    static void Handle(void* context, const AecTerminationEvent& event) {
+        auto* probe = static_cast<HandlerProbe*>(context);
+        probe->dose.store(event.actual_dose_mgy);
+        probe->calls.fetch_add(1);
+    }
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, int timeout_ms = 1000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return predicate();
+}
+
+AecTerminationEvent MakeEvent(float dose) {
+    AecTerminationEvent event;
+    event.threshold_reached = true;
+    event.actual_dose_mgy = dose;
+    return event;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+TEST(AecAbortLineTest, StartRequiresHandler) {
+    AecAbortLine line;
+    HandlerProbe probe;
+    EXPECT_FALSE(line.Start());
+    EXPECT_FALSE(line.SetHandler(nullptr, &probe));
+    EXPECT_FALSE(line.Arm());   // Not running
+
+    ASSERT_TRUE(line.SetHandler(&HandlerProbe::Handle, &probe));
+    ASSERT_TRUE(line.Start());
+    EXPECT_FALSE(line.Start());
+    EXPECT_FALSE(line.SetHandler(&HandlerProbe::Handle, &probe));
+    line.Stop();
+    line.Stop();
+}
+
+// =============================================================================
+// Signal Delivery
+// =============================================================================
+
+class AecAbortLineSignalTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(AecAbortLineSignalTest, DeliversOneAbortPerArmedExposure) {
+    AecAbortLineConfig config;
+    config.spin_while_armed = GetParam();
+    AecAbortLine line(config);
+    HandlerProbe probe;
+    ASSERT_TRUE(line.SetHandler(&HandlerProbe::Handle, &probe));
+    ASSERT_TRUE(line.Start());
+
+    EXPECT_FALSE(line.Signal(MakeEvent(1.0f)));   // Not armed
+
+    for (int exposure = 1; exposure <= 3; ++exposure) {
+        ASSERT_TRUE(WaitFor([&]() { return line.Arm(); }));
+        EXPECT_TRUE(line.IsArmed());
+        ASSERT_TRUE(line.Signal(MakeEvent(static_cast<float>(exposure))));
+        EXPECT_FALSE(line.Signal(MakeEvent(99.0f)));   // Already signalled
+        EXPECT_FALSE(line.IsArmed());
+        ASSERT_TRUE(WaitFor([&]() { return probe.calls.load() == exposure; }));
+        EXPECT_FLOAT_EQ(probe.dose.load(), static_cast<float>(exposure));
+    }
+
+    AecAbortLineStats stats = line.GetStats();
+    EXPECT_EQ(stats.signals, 3u);
+    EXPECT_EQ(stats.aborts, 3u);
+    EXPECT_GT(stats.max_latency_ns, 0);
+    EXPECT_GE(stats.max_latency_ns, stats.last_latency_ns);
+
+    line.Disarm();
+    EXPECT_FALSE(line.Signal(MakeEvent(1.0f)));
+    line.Stop();
+    EXPECT_EQ(probe.calls.load(), 3);
+}
+
+INSTANTIATE_TEST_SUITE_P(WaitModes, AecAbortLineSignalTest, Values(true, false),
+                         [](const TestParamInfo<bool>& info) {
+                             return info.param ? "Spin" : "Sleep";
+                         });
+
+// =============================================================================
+// AecController Integration
+// =============================================================================
+
+TEST(AecAbortLineControllerTest, ArmedLineBypassesGeneratorAbort) {
+    NiceMock<MockGenerator> generator;
+    AecController aec(&generator);
+    ASSERT_TRUE(aec.SetMode(AecMode::AEC_AUTO));
+
+    AecAbortLine line;
+    HandlerProbe probe;
+    ASSERT_TRUE(line.SetHandler(&HandlerProbe::Handle, &probe));
+    ASSERT_TRUE(line.Start());
+    aec.SetAbortLine(&line);
+
+    std::atomic<bool> callback_ran{false};
+    aec.RegisterTerminationCallback([&](const AecTerminationEvent&) { callback_ran = true; });
+
+    EXPECT_CALL(generator, AbortExposure()).Times(0);
+    aec.SetExposureState(true);
+    EXPECT_TRUE(line.IsArmed());
+    aec.SimulateTerminationSignal(MakeEvent(2.5f));
+    EXPECT_TRUE(callback_ran.load());
+    ASSERT_TRUE(WaitFor([&]() { return probe.calls.load() == 1; }));
+    Mock::VerifyAndClearExpectations(&generator);
+
+    // Exposure over: line disarmed, a late signal takes the regular path
+    aec.SetExposureState(false);
+    EXPECT_FALSE(line.IsArmed());
+    EXPECT_CALL(generator, AbortExposure()).Times(1);
+    aec.SimulateTerminationSignal(MakeEvent(2.5f));
+    EXPECT_EQ(probe.calls.load(), 1);
+
+    aec.SetAbortLine(nullptr);
+    line.Stop();
+}
+
+// =============================================================================
+// GeneratorSimulator Integration
+// =============================================================================
+
+TEST(AecAbortLineSimulatorTest, FastAbortEndsExposureEarly) {
+    SimulatorConfig config;
+    config.response_latency = std::chrono::microseconds(0);
+    GeneratorSimulator generator(config);
+
+    std::atomic<int> idle_updates{0};
+    generator.RegisterStatusCallback([&](const HvgStatus& status) {
+        if (status.state == GeneratorState::GEN_IDLE) {
+            idle_updates.fetch_add(1);
+        }
+    });
+
+    AecAbortLine line;
+    ASSERT_TRUE(line.SetHandler(&GeneratorSimulator::AecAbortHandler, &generator));
+    ASSERT_TRUE(line.Start());
+
+    ExposureParams params;
+    params.kvp = 80.0f;
+    params.ma = 100.0f;
+    params.ms = 5000.0f;
+    ASSERT_TRUE(generator.SetExposureParams(params));
+    ASSERT_TRUE(line.Arm());
+    ASSERT_TRUE(generator.StartExposure().success);
+    ASSERT_TRUE(generator.IsExposing());
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(line.Signal(MakeEvent(1.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return !generator.IsExposing(); }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    // Status published by the exposure thread, not the abort path
+    ASSERT_TRUE(WaitFor([&]() { return idle_updates.load() > 0; }));
+    EXPECT_EQ(generator.GetStatus().state, GeneratorState::GEN_IDLE);
+    EXPECT_FALSE(generator.FastAbortExposure());   // Nothing left to abort
+    line.Stop();
+}
+
+} // anonymous namespace
@@ -0,0 +1,308 @@
+/**
+ * @file test_detector_aec.cpp
+ * @brief GTest unit tests for DetectorAec (detector-based AEC, FR-HAL-07)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: AEC signal handling
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Configure:      default field / invalid region / no usable region / during exposure
+ *   BeginExposure:  AEC_DETECTOR mode / other modes rejected
+ *   ROI signal:     16-bit and 8-bit readouts, odd widths (SIMD tail) /
+ *                   weighted regions / inactive regions / malformed frame skipped
+ *   Accumulation:   destructive readouts summed / cumulative readouts latest /
+ *                   one termination per exposure / reset per exposure
+ *   Panel means:    OnRegionMeans with matching and mismatching count
+ *   Simulator:      partial readouts during a GeneratorSimulator exposure
+ *                   terminate at the threshold, within the per-sample budget
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "aec/AecController.h"
+#include "aec/DetectorAec.h"
+#include "hnvue/hal/generator/GeneratorSimulator.h"
+#include "hnvue/infra/Clock.h"
+
+#include "mock/MockDetector.h"
+#include "mock/MockGenerator.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+using namespace testing;
+
+namespace {
+
+/// Frame with a uniform background and one uniform rectangle
+RawFrame MakeFrame(int32_t width, int32_t height, int32_t bit_depth, uint16_t background,
+                   uint16_t value = 0, int32_t x0 = 0, int32_t y0 = 0, int32_t x1 = 0,
+                   int32_t y1 = 0) {
+    RawFrame frame;
+    frame.width = width;
+    frame.height = height;
+    frame.bit_depth = bit_depth;
+    const size_t bytes_per_pixel = bit_depth > 8 ? 2 : 1;
+    frame.pixel_data.resize(static_cast<size_t>(width) * height * bytes_per_pixel);
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = 0; x < width; ++x) {
+            uint16_t pixel = (x >= x0 && x < x1 && y >= y0 && y < y1) ? value : background;
+            size_t index = static_cast<size_t>(y) * width + x;
+            if (bytes_per_pixel == 2) {
+                std::memcpy(frame.pixel_data.data() + index * 2, &pixel, 2);
+            } else {
+                frame.pixel_data[index] = static_cast<uint8_t>(pixel);
+            }
+        }
+    }
+    return frame;
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class DetectorAecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(aec_.SetMode(AecMode::AEC_DETECTOR));
+        ASSERT_TRUE(aec_.SetThreshold(50.0f));
+        aec_.RegisterTerminationCallback([this](const AecTerminationEvent& event) {
+            last_event_ = event;
+            terminations_.fetch_add(1);
+        });
+    }
+
+    NiceMock<MockGenerator> generator_;
+    AecController aec_{&generator_};
+    AecTerminationEvent last_event_;
+    std::atomic<int> terminations_{0};
+};
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+TEST_F(DetectorAecTest, Configure_ValidatesRegions) {
+    DetectorAec detector_aec(&aec_);
+
+    DetectorAecConfig config;
+    EXPECT_TRUE(detector_aec.Configure(config));   // Default central field
+
+    config.regions = {AecRegion{0.5f, 0.5f, 0.0f, 0.2f, 1.0f, true}};
+    EXPECT_FALSE(detector_aec.Configure(config));  // Zero width
+    config.regions = {AecRegion{1.5f, 0.5f, 0.2f, 0.2f, 1.0f, true}};
+    EXPECT_FALSE(detector_aec.Configure(config));  // Center outside
+    config.regions = {AecRegion{0.5f, 0.5f, 0.2f, 0.2f, 1.0f, false}};
+    EXPECT_FALSE(detector_aec.Configure(config));  // Nothing active
+
+    ASSERT_TRUE(detector_aec.BeginExposure());
+    EXPECT_FALSE(detector_aec.Configure(DetectorAecConfig{}));
+    detector_aec.EndExposure();
+    EXPECT_TRUE(detector_aec.Configure(DetectorAecConfig{}));
+}
+
+TEST_F(DetectorAecTest, BeginExposure_RequiresDetectorMode) {
+    DetectorAec detector_aec(&aec_);
+    ASSERT_TRUE(aec_.SetMode(AecMode::AEC_AUTO));
+    EXPECT_FALSE(detector_aec.BeginExposure());
+    ASSERT_TRUE(aec_.SetMode(AecMode::AEC_DETECTOR));
+    EXPECT_TRUE(detector_aec.BeginExposure());
+    EXPECT_TRUE(detector_aec.IsExposing());
+
+    DetectorAec unbound(nullptr);
+    EXPECT_FALSE(unbound.BeginExposure());
+}
+
+// =============================================================================
+// ROI Signal
+// =============================================================================
+
+TEST_F(DetectorAecTest, RoiMean_16Bit_OnlyFieldPixelsCount) {
+    ASSERT_TRUE(aec_.SetThreshold(100.0f));
+    DetectorAec detector_aec(&aec_);   // Central 20% field
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    // 103 x 50: field spans x [41, 62), y [20, 30); 21 columns exercise the SIMD tail
+    RawFrame frame = MakeFrame(103, 50, 16, 65535, 6553, 41, 20, 62, 30);
+    detector_aec.OnPartialFrame(frame);
+    EXPECT_NEAR(detector_aec.GetAccumulatedPercent(), 6553.0f / 65535.0f * 100.0f, 1e-3f);
+    EXPECT_EQ(detector_aec.GetStats().samples, 1u);
+}
+
+TEST_F(DetectorAecTest, RoiMean_8Bit) {
+    ASSERT_TRUE(aec_.SetThreshold(100.0f));
+    DetectorAec detector_aec(&aec_);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    RawFrame frame = MakeFrame(200, 100, 8, 51);   // 20% of 255 everywhere
+    detector_aec.OnPartialFrame(frame);
+    EXPECT_NEAR(detector_aec.GetAccumulatedPercent(), 20.0f, 1e-3f);
+}
+
+TEST_F(DetectorAecTest, WeightedRegions_InactiveIgnored) {
+    ASSERT_TRUE(aec_.SetThreshold(100.0f));
+    DetectorAecConfig config;
+    config.regions = {
+        AecRegion{0.25f, 0.5f, 0.2f, 0.2f, 3.0f, true},    // Left: 40%
+        AecRegion{0.75f, 0.5f, 0.2f, 0.2f, 1.0f, true},    // Right: 0%
+        AecRegion{0.5f, 0.5f, 0.1f, 0.1f, 5.0f, false},    // Inactive
+    };
+    DetectorAec detector_aec(&aec_, config);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    // Left half 40% of 12-bit full scale, right half zero
+    RawFrame frame = MakeFrame(160, 160, 12, 0, 1638, 0, 0, 80, 160);
+    detector_aec.OnPartialFrame(frame);
+    EXPECT_NEAR(detector_aec.GetAccumulatedPercent(), 0.75f * 1638.0f / 4095.0f * 100.0f, 1e-3f);
+}
+
+TEST_F(DetectorAecTest, MalformedFrame_Skipped) {
+    DetectorAec detector_aec(&aec_);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    RawFrame frame = MakeFrame(64, 64, 16, 1000);
+    frame.pixel_data.resize(100);
+    detector_aec.OnPartialFrame(frame);
+    frame = MakeFrame(64, 64, 16, 1000);
+    frame.bit_depth = 0;
+    detector_aec.OnPartialFrame(frame);
+
+    EXPECT_EQ(detector_aec.GetStats().skipped, 2u);
+    EXPECT_EQ(detector_aec.GetStats().samples, 0u);
+}
+
+// =============================================================================
+// Accumulation and Termination
+// =============================================================================
+
+TEST_F(DetectorAecTest, DestructiveReadouts_SumToThreshold_OneTermination) {
+    EXPECT_CALL(generator_, AbortExposure()).Times(1);
+    DetectorAecConfig config;
+    config.dose_mgy_per_percent = 0.01f;
+    DetectorAec detector_aec(&aec_, config);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    RawFrame frame = MakeFrame(64, 64, 16, 13107);   // 20% per readout
+    frame.timestamp_us = hnvue::infra::MonotonicClock::NowUs();
+    detector_aec.OnPartialFrame(frame);
+    detector_aec.OnPartialFrame(frame);
+    EXPECT_EQ(terminations_.load(), 0);
+    detector_aec.OnPartialFrame(frame);               // 60% >= 50%
+    EXPECT_EQ(terminations_.load(), 1);
+    EXPECT_TRUE(last_event_.threshold_reached);
+    EXPECT_NEAR(last_event_.actual_dose_mgy, 0.6f, 1e-4f);
+    EXPECT_GE(last_event_.exposure_time_us, 0);
+
+    detector_aec.OnPartialFrame(frame);               // Already terminated
+    EXPECT_EQ(terminations_.load(), 1);
+    EXPECT_EQ(detector_aec.GetStats().terminations, 1u);
+
+    // Next exposure starts from zero
+    detector_aec.EndExposure();
+    ASSERT_TRUE(detector_aec.BeginExposure());
+    detector_aec.OnPartialFrame(frame);
+    EXPECT_NEAR(detector_aec.GetAccumulatedPercent(), 20.0f, 1e-3f);
+}
+
+TEST_F(DetectorAecTest, CumulativeReadouts_UseLatestValue) {
+    DetectorAecConfig config;
+    config.cumulative_readout = true;
+    DetectorAec detector_aec(&aec_, config);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    detector_aec.OnPartialFrame(MakeFrame(64, 64, 16, 13107));   // 20%
+    detector_aec.OnPartialFrame(MakeFrame(64, 64, 16, 19661));   // 30%
+    EXPECT_NEAR(detector_aec.GetAccumulatedPercent(), 30.0f, 1e-3f);
+    EXPECT_EQ(terminations_.load(), 0);
+    detector_aec.OnPartialFrame(MakeFrame(64, 64, 16, 32768));   // 50%
+    EXPECT_EQ(terminations_.load(), 1);
+}
+
+TEST_F(DetectorAecTest, FramesOutsideExposure_Ignored) {
+    DetectorAec detector_aec(&aec_);
+    detector_aec.OnPartialFrame(MakeFrame(64, 64, 16, 65535));
+    EXPECT_EQ(detector_aec.GetStats().samples, 0u);
+    EXPECT_EQ(terminations_.load(), 0);
+}
+
+TEST_F(DetectorAecTest, RegionMeans_FromPanel) {
+    DetectorAecConfig config;
+    config.regions = {AecRegion{0.3f, 0.5f, 0.2f, 0.2f, 1.0f, true},
+                      AecRegion{0.7f, 0.5f, 0.2f, 0.2f, 1.0f, true}};
+    DetectorAec detector_aec(&aec_, config);
+    ASSERT_TRUE(detector_aec.BeginExposure());
+
+    const float one[] = {0.5f};
+    detector_aec.OnRegionMeans(one, 1, 0);           // Count mismatch
+    EXPECT_EQ(detector_aec.GetStats().skipped, 1u);
+
+    const float means[] = {0.3f, 0.1f};              // 20% weighted
+    detector_aec.OnRegionMeans(means, 2, 0);
+    detector_aec.OnRegionMeans(means, 2, 0);
+    EXPECT_EQ(terminations_.load(), 0);
+    detector_aec.OnRegionMeans(means, 2, 0);
+    EXPECT_EQ(terminations_.load(), 1);
+}
+
+// =============================================================================
+// Simulator-Driven Exposure
+// =============================================================================
+
+TEST(DetectorAecSimulatorTest, PartialReadouts_TerminateExposureWithinBudget) {
+    SimulatorConfig sim_config;
+    sim_config.response_latency = std::chrono::microseconds(0);
+    GeneratorSimulator generator(sim_config);
+
+    AecController aec(&generator);
+    ASSERT_TRUE(aec.SetMode(AecMode::AEC_DETECTOR));
+    ASSERT_TRUE(aec.SetThreshold(50.0f));
+
+    NiceMock<MockDetector> detector;
+    FrameCallback deliver;
+    EXPECT_CALL(detector, RegisterFrameCallback(_)).WillOnce(SaveArg<0>(&deliver));
+    DetectorAec detector_aec(&aec);
+    detector_aec.Attach(&detector);
+    ASSERT_TRUE(deliver);
+
+    ExposureParams params;
+    params.kvp = 80.0f;
+    params.ma = 100.0f;
+    params.ms = 5000.0f;
+    ASSERT_TRUE(generator.SetExposureParams(params));
+    ASSERT_TRUE(detector_aec.BeginExposure());
+    aec.SetExposureState(true);
+    ASSERT_TRUE(generator.StartExposure().success);
+
+    // Panel: 2x2-binned 512x512 readouts every 2 ms, 6% of full scale each
+    RawFrame readout = MakeFrame(512, 512, 16, 3932);
+    int readouts = 0;
+    while (generator.IsExposing() && readouts < 100) {
+        readout.timestamp_us = hnvue::infra::MonotonicClock::NowUs();
+        deliver(readout);
+        ++readouts;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    aec.SetExposureState(false);
+    detector_aec.EndExposure();
+
+    // 9 x 6% is the first accumulation at or above 50%
+    EXPECT_EQ(readouts, 9);
+    EXPECT_FALSE(generator.IsExposing());
+
+    DetectorAecStats stats = detector_aec.GetStats();
+    EXPECT_EQ(stats.samples, 9u);
+    EXPECT_EQ(stats.terminations, 1u);
+    EXPECT_GT(stats.max_sample_ns, 0);
+    EXPECT_LT(stats.max_sample_ns, 5000000);   // FR-HAL-07: signal to abort < 5 ms
+}
+
+} // anonymous namespace
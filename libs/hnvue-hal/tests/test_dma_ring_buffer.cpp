@@ -18,6 +18,7 @@
 #include <atomic>
 #include <cstring>
 #include "hnvue/hal/DmaRingBuffer.h"
+#include "hnvue/infra/FramePool.h"
 
 using namespace hnvue::hal;
 
@@ -103,6 +104,7 @@ TEST_F(DmaRingBufferTest, WriteAndReadSingleFrame) {
 
     bool read_success = buffer->ReadFrame(
         read_buffer.data(),
+        read_buffer.size(),
         size_out,
         read_sequence
     );
@@ -130,7 +132,7 @@ TEST_F(DmaRingBufferTest, MonotonicallyIncreasingSequenceNumbers) {
         size_t size_out = 0;
         uint64_t sequence = 0;
 
-        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), size_out, sequence));
+        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
         EXPECT_EQ(sequence, i);
         EXPECT_TRUE(VerifyFramePattern(read_buffer.data(), i));
     }
@@ -155,7 +157,7 @@ TEST_F(DmaRingBufferTest, BufferEmptiesAfterReadingAllFrames) {
         std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
         size_t size_out = 0;
         uint64_t sequence = 0;
-        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), size_out, sequence));
+        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
     }
 
     EXPECT_FALSE(buffer->IsFull());
@@ -177,6 +179,42 @@ TEST_F(DmaRingBufferTest, AvailableFrameCountAccuracy) {
     }
 }
 
+/**
+ * TEST: Slots are cache-line aligned and storage comes from the frame pool
+ * FR-HAL-09: Pre-allocated buffer, no heap allocation during operation
+ */
+TEST_F(DmaRingBufferTest, PooledSlotStorageIsAligned) {
+    hnvue::infra::FramePool pool;
+    constexpr size_t kOddFrameSize = 1000;  // not a cache-line multiple
+
+    {
+        DmaRingBuffer pooled(TEST_BUFFER_DEPTH, kOddFrameSize,
+                             OverwritePolicy::DROP_OLDEST, pool);
+        EXPECT_EQ(pooled.GetSlotStride() % hnvue::infra::kCacheLineSize, 0u);
+        EXPECT_GE(pooled.GetSlotStride(), kOddFrameSize);
+        EXPECT_EQ(pool.GetStats().blocks_in_use, 1u);
+
+        std::vector<uintptr_t> slot_addresses;
+        pooled.RegisterFrameCallback([&](const void* data, size_t, uint64_t) {
+            slot_addresses.push_back(reinterpret_cast<uintptr_t>(data));
+        });
+
+        std::vector<uint8_t> frame(kOddFrameSize, 0x5A);
+        for (size_t i = 0; i < TEST_BUFFER_DEPTH; ++i) {
+            uint64_t sequence = 0;
+            ASSERT_TRUE(pooled.WriteFrame(frame.data(), frame.size(), sequence));
+        }
+        for (uintptr_t address : slot_addresses) {
+            EXPECT_EQ(address % hnvue::infra::kCacheLineSize, 0u);
+        }
+    }
+
+    // Re-creating a ring of the same geometry reuses the returned block
+    EXPECT_EQ(pool.GetStats().blocks_in_use, 0u);
+    DmaRingBuffer again(TEST_BUFFER_DEPTH, kOddFrameSize, OverwritePolicy::DROP_OLDEST, pool);
+    EXPECT_EQ(pool.GetStats().system_allocations, 1u);
+}
+
 // =============================================================================
 // Overwrite Policy Tests (FR-HAL-09)
 // =============================================================================
@@ -210,7 +248,7 @@ TEST_F(DmaRingBufferTest, DropOldestPolicyOverwritesWhenFull) {
         std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
         size_t size_out = 0;
         uint64_t sequence = 0;
-        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), size_out, sequence));
+        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
 
         if (i < TEST_BUFFER_DEPTH) {
             EXPECT_EQ(sequence, i);
@@ -224,6 +262,64 @@ TEST_F(DmaRingBufferTest, DropOldestPolicyOverwritesWhenFull) {
     EXPECT_TRUE(buffer->IsEmpty());
 }
 
+/**
+ * TEST: In-place write publishes the slot with the next sequence number
+ * FR-HAL-09: Producer may fill ring memory directly (no staging copy)
+ */
+TEST_F(DmaRingBufferTest, InPlaceWriteCommitsSlot) {
+    uint64_t callback_sequence = 0;
+    buffer->RegisterFrameCallback([&](const void*, size_t, uint64_t sequence) {
+        callback_sequence = sequence;
+    });
+
+    uint64_t sequence = 0;
+    auto frame = CreateTestFrame(0x10);
+    ASSERT_TRUE(buffer->WriteFrame(frame.data(), frame.size(), sequence));
+
+    uint8_t* slot = buffer->BeginWrite();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(buffer->BeginWrite(), nullptr);  // One reservation at a time
+    EXPECT_EQ(buffer->GetAvailableFrameCount(), 1u);  // Not visible yet
+
+    auto pattern = CreateTestFrame(0x20);
+    std::memcpy(slot, pattern.data(), pattern.size());
+    ASSERT_TRUE(buffer->CommitWrite(sequence));
+    EXPECT_EQ(sequence, 1u);
+    EXPECT_EQ(callback_sequence, 1u);
+    EXPECT_FALSE(buffer->CommitWrite(sequence));
+
+    std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
+    size_t size_out = 0;
+    ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
+    ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
+    EXPECT_EQ(sequence, 1u);
+    EXPECT_TRUE(VerifyFramePattern(read_buffer.data(), 0x20));
+}
+
+/**
+ * TEST: In-place write on a full DROP_OLDEST ring drops the oldest frame at reservation
+ */
+TEST_F(DmaRingBufferTest, InPlaceWriteDropsOldestWhenFull) {
+    for (size_t i = 0; i < TEST_BUFFER_DEPTH; ++i) {
+        auto frame = CreateTestFrame(static_cast<uint8_t>(i));
+        uint64_t sequence = 0;
+        ASSERT_TRUE(buffer->WriteFrame(frame.data(), frame.size(), sequence));
+    }
+
+    ASSERT_NE(buffer->BeginWrite(), nullptr);
+    EXPECT_EQ(buffer->GetAvailableFrameCount(), TEST_BUFFER_DEPTH - 1);
+
+    // Cancelled: nothing published, frame 0 stays dropped
+    buffer->CancelWrite();
+    EXPECT_EQ(buffer->GetAvailableFrameCount(), TEST_BUFFER_DEPTH - 1);
+
+    std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
+    size_t size_out = 0;
+    uint64_t sequence = 0;
+    ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
+    EXPECT_EQ(sequence, 1u);
+}
+
 /**
  * TEST: BLOCK_PRODUCER policy blocks when buffer full
  * FR-HAL-09: BLOCK_PRODUCER blocks write until space available
@@ -268,7 +364,7 @@ TEST_F(DmaRingBufferTest, BlockProducerPolicyBlocksWhenFull) {
     std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
     size_t size_out = 0;
     uint64_t sequence = 0;
-    ASSERT_TRUE(block_buffer->ReadFrame(read_buffer.data(), size_out, sequence));
+    ASSERT_TRUE(block_buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
 
     // Now write should complete
     write_thread.join();
@@ -290,6 +386,14 @@ TEST_F(DmaRingBufferTest, ConcurrentProducerConsumerStressTest) {
     std::atomic<int> consumer_count{0};
     std::atomic<bool> producer_done{false};
 
+    // Every frame must arrive, so the producer has to wait for the consumer
+    // (the fixture's DROP_OLDEST buffer would legitimately discard frames)
+    buffer = std::make_unique<DmaRingBuffer>(
+        TEST_BUFFER_DEPTH,
+        TEST_FRAME_SIZE,
+        OverwritePolicy::BLOCK_PRODUCER
+    );
+
     // Producer thread
     auto producer = std::thread([&]() {
         for (int i = 0; i < NUM_FRAMES; ++i) {
@@ -309,7 +413,7 @@ TEST_F(DmaRingBufferTest, ConcurrentProducerConsumerStressTest) {
         while (consumer_count < NUM_FRAMES) {
             size_t size_out = 0;
             uint64_t sequence = 0;
-            if (buffer->ReadFrame(read_buffer.data(), size_out, sequence)) {
+            if (buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence)) {
                 consumer_count++;
             } else if (!producer_done) {
                 std::this_thread::yield();
@@ -350,7 +454,7 @@ TEST_F(DmaRingBufferTest, DISABLED_Latency_WriteToCallback) {
         std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
         size_t size_out = 0;
         uint64_t read_sequence = 0;
-        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), size_out, read_sequence));
+        ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, read_sequence));
 
         auto write_end = std::chrono::high_resolution_clock::now();
 
@@ -388,7 +492,7 @@ TEST_F(DmaRingBufferTest, ReadFromEmptyBufferFails) {
     size_t size_out = 0;
     uint64_t sequence = 0;
 
-    bool result = buffer->ReadFrame(read_buffer.data(), size_out, sequence);
+    bool result = buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence);
     EXPECT_FALSE(result);
 }
 
@@ -422,8 +526,14 @@ TEST_F(DmaRingBufferTest, ReadWithInsufficientBuffer) {
     std::vector<uint8_t> small_buffer(TEST_FRAME_SIZE / 2);
     size_t size_out = 0;
 
-    bool result = buffer->ReadFrame(small_buffer.data(), size_out, sequence);
+    bool result = buffer->ReadFrame(small_buffer.data(), small_buffer.size(), size_out, sequence);
     EXPECT_FALSE(result);
+
+    // The frame stays queued for a large enough buffer
+    EXPECT_EQ(buffer->GetAvailableFrameCount(), 1u);
+    std::vector<uint8_t> read_buffer(TEST_FRAME_SIZE);
+    ASSERT_TRUE(buffer->ReadFrame(read_buffer.data(), read_buffer.size(), size_out, sequence));
+    EXPECT_EQ(read_buffer, frame);
 }
 
 // =============================================================================
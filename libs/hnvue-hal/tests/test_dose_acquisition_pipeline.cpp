@@ -0,0 +1,257 @@
+/**
+ * @file test_dose_acquisition_pipeline.cpp
+ * @brief GTest unit tests for DoseAcquisitionPipeline (IL-08, NFR-PERF-05)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Dose accumulation (IL-08)
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Start:          valid / null monitor / bad rate / ring not power of two / running
+ *   Integration:    constant rate -> dose = rate x duration, DAP = dose x area
+ *   Exposures:      running totals then one complete record per exposure /
+ *                   samples outside an exposure only count towards cumulative
+ *   IL-08:          cumulative limit exceeded / ResetCumulative restores
+ *   Stop:           open exposure completed on Stop
+ *   Latency:        sample-to-integration delay below 200 ms, no drops
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dose/DoseAcquisitionPipeline.h"
+
+#include "mock/MockCollimator.h"
+#include "mock/MockDoseMonitor.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+using namespace testing;
+
+namespace {
+
+constexpr float kRateMgyPerS = 10.0f;
+
+// 100 mm x 80 mm field = 80 cm^2
+const CollimatorPosition kField{50.0f, 50.0f, 40.0f, 40.0f};
+constexpr double kFieldAreaCm2 = 80.0;
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class DoseAcquisitionPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ON_CALL(monitor_, GetCurrentDose()).WillByDefault(Invoke([this]() {
+            DoseReading reading;
+            reading.dose_rate_mgy_s = rate_.load();
+            return reading;
+        }));
+        ON_CALL(collimator_, GetPosition()).WillByDefault(Return(kField));
+    }
+
+    std::unique_ptr<DoseAcquisitionPipeline> MakePipeline(const DosePipelineConfig& config) {
+        auto pipeline = std::make_unique<DoseAcquisitionPipeline>(&monitor_, &collimator_, config);
+        pipeline->RegisterTotalsCallback([this](const ExposureDoseTotals& totals) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            (totals.complete ? complete_ : running_).push_back(totals);
+        });
+        return pipeline;
+    }
+
+    std::vector<ExposureDoseTotals> Complete() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return complete_;
+    }
+
+    std::vector<ExposureDoseTotals> Running() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return running_;
+    }
+
+    /// Wait until n complete records arrived
+    bool WaitForComplete(size_t n) {
+        for (int i = 0; i < 200; ++i) {
+            if (Complete().size() >= n) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    NiceMock<MockDoseMonitor> monitor_;
+    NiceMock<MockCollimator> collimator_;
+    std::atomic<float> rate_{kRateMgyPerS};
+    std::mutex mutex_;
+    std::vector<ExposureDoseTotals> complete_;
+    std::vector<ExposureDoseTotals> running_;
+};
+
+// =============================================================================
+// Start Validation
+// =============================================================================
+
+TEST_F(DoseAcquisitionPipelineTest, Start_RejectsInvalidConfiguration) {
+    DosePipelineConfig config;
+    DoseAcquisitionPipeline no_monitor(nullptr, &collimator_, config);
+    EXPECT_FALSE(no_monitor.Start());
+
+    config.sample_rate_hz = 0;
+    EXPECT_FALSE(MakePipeline(config)->Start());
+
+    config = DosePipelineConfig{};
+    config.ring_capacity = 1000;
+    EXPECT_FALSE(MakePipeline(config)->Start());
+
+    auto pipeline = MakePipeline(DosePipelineConfig{});
+    ASSERT_TRUE(pipeline->Start());
+    EXPECT_FALSE(pipeline->Start());
+    EXPECT_FALSE(pipeline->RegisterTotalsCallback([](const ExposureDoseTotals&) {}));
+    pipeline->Stop();
+    EXPECT_FALSE(pipeline->IsRunning());
+}
+
+// =============================================================================
+// Integration
+// =============================================================================
+
+TEST_F(DoseAcquisitionPipelineTest, ConstantRate_IntegratesDoseAndDap) {
+    auto pipeline = MakePipeline(DosePipelineConfig{});
+    ASSERT_TRUE(pipeline->Start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    pipeline->BeginExposure(7);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    pipeline->EndExposure();
+    ASSERT_TRUE(WaitForComplete(1));
+    pipeline->Stop();
+
+    std::vector<ExposureDoseTotals> complete = Complete();
+    ASSERT_EQ(complete.size(), 1u);
+    const ExposureDoseTotals& totals = complete[0];
+    EXPECT_EQ(totals.exposure_id, 7u);
+    EXPECT_GT(totals.samples, 0u);
+
+    // Constant rate: trapezoids sum exactly to rate x elapsed time
+    double duration_s = static_cast<double>(totals.end_us - totals.start_us) / 1e6;
+    EXPECT_GT(duration_s, 0.09);
+    EXPECT_NEAR(totals.dose_mgy, kRateMgyPerS * duration_s, 1e-6);
+    EXPECT_NEAR(totals.dap_ugy_cm2, totals.dose_mgy * 1000.0 * kFieldAreaCm2, 1e-3);
+    EXPECT_FLOAT_EQ(totals.field_area_cm2, static_cast<float>(kFieldAreaCm2));
+    EXPECT_FLOAT_EQ(totals.peak_dose_rate_mgy_s, kRateMgyPerS);
+
+    // Dose before and after the exposure is cumulative only
+    EXPECT_GT(pipeline->GetCumulativeDose(), totals.dose_mgy);
+    EXPECT_GE(totals.cumulative_dose_mgy, totals.dose_mgy);
+    EXPECT_TRUE(totals.dose_within_limits);
+
+    // Running totals published during the exposure, for the same exposure
+    std::vector<ExposureDoseTotals> running = Running();
+    ASSERT_FALSE(running.empty());
+    for (const ExposureDoseTotals& update : running) {
+        EXPECT_EQ(update.exposure_id, 7u);
+        EXPECT_LE(update.dose_mgy, totals.dose_mgy);
+    }
+}
+
+TEST_F(DoseAcquisitionPipelineTest, ConsecutiveExposures_EachCompletedOnce) {
+    auto pipeline = MakePipeline(DosePipelineConfig{});
+    ASSERT_TRUE(pipeline->Start());
+    for (uint64_t id = 1; id <= 3; ++id) {
+        pipeline->BeginExposure(id);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        pipeline->EndExposure();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(WaitForComplete(3));
+    pipeline->Stop();
+
+    std::vector<ExposureDoseTotals> complete = Complete();
+    ASSERT_EQ(complete.size(), 3u);
+    for (size_t i = 0; i < complete.size(); ++i) {
+        EXPECT_EQ(complete[i].exposure_id, i + 1);
+        EXPECT_GT(complete[i].dose_mgy, 0.0);
+    }
+}
+
+// =============================================================================
+// IL-08 Cumulative Limit
+// =============================================================================
+
+TEST_F(DoseAcquisitionPipelineTest, CumulativeLimit_ReportedAndReset) {
+    DosePipelineConfig config;
+    config.dose_limit_mgy = 0.5;
+    rate_ = 100.0f;   // Limit reached after ~5 ms
+    auto pipeline = MakePipeline(config);
+    ASSERT_TRUE(pipeline->Start());
+
+    pipeline->BeginExposure(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pipeline->EndExposure();
+    ASSERT_TRUE(WaitForComplete(1));
+    EXPECT_FALSE(Complete()[0].dose_within_limits);
+    EXPECT_FALSE(pipeline->IsDoseWithinLimits());
+
+    rate_ = 0.0f;
+    pipeline->ResetCumulative();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(pipeline->IsDoseWithinLimits());
+    EXPECT_LT(pipeline->GetCumulativeDose(), config.dose_limit_mgy);
+    pipeline->Stop();
+}
+
+// =============================================================================
+// Stop
+// =============================================================================
+
+TEST_F(DoseAcquisitionPipelineTest, Stop_CompletesOpenExposure) {
+    auto pipeline = MakePipeline(DosePipelineConfig{});
+    ASSERT_TRUE(pipeline->Start());
+    pipeline->BeginExposure(42);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pipeline->Stop();
+
+    std::vector<ExposureDoseTotals> complete = Complete();
+    ASSERT_EQ(complete.size(), 1u);
+    EXPECT_EQ(complete[0].exposure_id, 42u);
+    EXPECT_GT(complete[0].dose_mgy, 0.0);
+}
+
+// =============================================================================
+// Latency (NFR-PERF-05)
+// =============================================================================
+
+TEST_F(DoseAcquisitionPipelineTest, Latency_WellBelowDapRequirement) {
+    DosePipelineConfig config;
+    config.sample_rate_hz = 2000;
+    auto pipeline = MakePipeline(config);
+    ASSERT_TRUE(pipeline->Start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    pipeline->Stop();
+
+    DosePipelineStats stats = pipeline->GetStats();
+    EXPECT_GT(stats.samples, 100u);
+    EXPECT_EQ(stats.dropped_samples, 0u);
+    EXPECT_LT(stats.max_latency_us, 200000);
+}
+
+TEST_F(DoseAcquisitionPipelineTest, NoCollimator_ZeroDap) {
+    DoseAcquisitionPipeline pipeline(&monitor_, nullptr, DosePipelineConfig{});
+    ASSERT_TRUE(pipeline.Start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pipeline.Stop();
+    EXPECT_GT(pipeline.GetCumulativeDose(), 0.0);
+    EXPECT_DOUBLE_EQ(pipeline.GetCumulativeDap(), 0.0);
+}
+
+} // anonymous namespace
@@ -0,0 +1,357 @@
+/**
+ * @file test_exposure_correlator.cpp
+ * @brief GTest unit tests for ExposureCorrelator (frame / exposure join)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Exposure metadata attached to acquired frames
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Join:           frame matched to the exposure before it; kV / mA from
+ *                   EXPOSING status samples, dose increase from readings
+ *   Watermarks:     record held until the exposure stream passes the frame /
+ *                   emitted once wall time passes max_push_latency_us /
+ *                   forced out incomplete after max_delay_us
+ *   AEC:            termination shortens mAs / outside any exposure counted
+ *   Unmatched:      dark frame / exposure without frame / late events
+ *   Bounds:         full frame queue releases its oldest frame
+ *   Throughput:     per-event cost over a long run
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "correlation/ExposureCorrelator.h"
+#include "hnvue/infra/Clock.h"
+
+using namespace hnvue::hal;
+
+namespace {
+
+constexpr float kMa = 200.0f;
+
+ExposureResult Result(float kvp, float ms) {
+    return ExposureResult{true, kvp, kMa, ms, kMa * ms / 1000.0f, ""};
+}
+
+HvgStatus Status(int64_t t, GeneratorState state, float kvp) {
+    HvgStatus status;
+    status.state = state;
+    status.actual_kvp = state == GeneratorState::GEN_EXPOSING ? kvp : 0.0f;
+    status.actual_ma = state == GeneratorState::GEN_EXPOSING ? kMa : 0.0f;
+    status.timestamp_us = t;
+    return status;
+}
+
+RawFrame Frame(int64_t sequence, int64_t t) {
+    RawFrame frame;
+    frame.sequence_number = sequence;
+    frame.timestamp_us = t;
+    return frame;
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+/**
+ * @brief Timestamps well in the future, so only event time moves watermarks
+ */
+class ExposureCorrelatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base_ = hnvue::infra::MonotonicClock::NowUs() + 60LL * 1000 * 1000;
+    }
+
+    void Attach(ExposureCorrelator& correlator) {
+        correlator.RegisterRecordCallback([this](const CorrelatedExposure& record) {
+            records_.push_back(record);
+        });
+    }
+
+    /**
+     * @brief One exposure at base_ + start_ms with 1 ms status and dose
+     *        samples from start_ms to end_ms (dose rate 1 mGy/s while exposing)
+     */
+    void Expose(ExposureCorrelator& correlator, int64_t start_ms, int64_t ms, float kvp,
+                int64_t end_ms) {
+        const int64_t start = base_ + start_ms * 1000;
+        correlator.PushExposure(Result(kvp, static_cast<float>(ms)), start, start + ms * 1000);
+        for (int64_t t = start_ms; t < end_ms; ++t) {
+            const int64_t ts = base_ + t * 1000;
+            const bool exposing = t >= start_ms && t < start_ms + ms;
+            correlator.PushStatus(Status(ts, exposing ? GeneratorState::GEN_EXPOSING
+                                                      : GeneratorState::GEN_IDLE, kvp));
+            DoseReading reading;
+            reading.dose_mgy = dose_mgy_;
+            reading.dap_ugy_cm2 = dose_mgy_ * 80.0f;
+            reading.timestamp_us = ts;
+            correlator.PushDose(reading);
+            if (exposing) {
+                dose_mgy_ += 0.001f;
+            }
+        }
+    }
+
+    int64_t base_ = 0;
+    float dose_mgy_ = 0.0f;
+    std::vector<CorrelatedExposure> records_;
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// Join
+// =============================================================================
+
+TEST_F(ExposureCorrelatorTest, FramesCarryExposureReadback) {
+    CorrelatorConfig config;
+    config.aec_stream = false;
+    ExposureCorrelator correlator(config);
+    Attach(correlator);
+
+    // Exposures at 0, 100 and 200 ms; each frame read out 30 ms after its exposure
+    Expose(correlator, 0, 10, 120.0f, 40);
+    correlator.PushFrame(Frame(7, base_ + 40 * 1000));
+    Expose(correlator, 100, 20, 70.0f, 140);
+    correlator.PushFrame(Frame(8, base_ + 150 * 1000));
+    Expose(correlator, 200, 10, 120.0f, 260);
+    correlator.PushFrame(Frame(9, base_ + 240 * 1000));
+
+    // The last frame waits: a later exposure could still claim it
+    ASSERT_EQ(records_.size(), 2u);
+    correlator.Flush();
+    ASSERT_EQ(records_.size(), 3u);
+
+    const float kv[] = {120.0f, 70.0f, 120.0f};
+    const float ms[] = {10.0f, 20.0f, 10.0f};
+    for (size_t i = 0; i < 3; ++i) {
+        const CorrelatedExposure& record = records_[i];
+        EXPECT_EQ(record.frame_sequence, 7 + static_cast<int64_t>(i));
+        EXPECT_TRUE(record.matched);
+        EXPECT_TRUE(record.complete);
+        EXPECT_EQ(record.exposure_index, i);
+        EXPECT_EQ(record.frame_offset_us, 30000);
+        EXPECT_FLOAT_EQ(record.kv_actual, kv[i]);
+        EXPECT_FLOAT_EQ(record.ma_actual, kMa);
+        EXPECT_FLOAT_EQ(record.mas_actual, kMa * ms[i] / 1000.0f);
+        EXPECT_EQ(record.status_samples, static_cast<uint32_t>(ms[i]));
+        EXPECT_NEAR(record.dose_mgy, ms[i] * 0.001f, 1e-5f);
+        EXPECT_NEAR(record.dap_ugy_cm2, ms[i] * 0.08f, 1e-3f);
+    }
+
+    CorrelatorStats stats = correlator.GetStats();
+    EXPECT_EQ(stats.frames, 3u);
+    EXPECT_EQ(stats.frames_unmatched, 0u);
+    EXPECT_EQ(stats.exposures_unmatched, 0u);
+    EXPECT_EQ(stats.late_events, 0u);
+    EXPECT_EQ(stats.overflows, 0u);
+    EXPECT_EQ(stats.min_frame_offset_us, 30000);
+    EXPECT_EQ(stats.max_frame_offset_us, 30000);
+}
+
+TEST_F(ExposureCorrelatorTest, RecordWaitsForStatusAndDose) {
+    CorrelatorConfig config;
+    config.aec_stream = false;
+    ExposureCorrelator correlator(config);
+    Attach(correlator);
+
+    correlator.PushExposure(Result(90.0f, 10.0f), base_, base_ + 10000);
+    correlator.PushExposure(Result(90.0f, 10.0f), base_ + 100000, base_ + 110000);
+    correlator.PushFrame(Frame(1, base_ + 50000));
+    EXPECT_TRUE(records_.empty());
+
+    // Status passes the exposure end; dose still needs its tail
+    correlator.PushStatus(Status(base_ + 11000, GeneratorState::GEN_IDLE, 0.0f));
+    EXPECT_TRUE(records_.empty());
+
+    DoseReading reading;
+    reading.timestamp_us = base_ + 10000 + config.dose_tail_us;
+    correlator.PushDose(reading);
+    ASSERT_EQ(records_.size(), 1u);
+    EXPECT_TRUE(records_[0].complete);
+    // No read-back: values from the ExposureResult
+    EXPECT_FLOAT_EQ(records_[0].kv_actual, 90.0f);
+    EXPECT_FLOAT_EQ(records_[0].mas_actual, 2.0f);
+}
+
+// =============================================================================
+// Time-driven Watermarks
+// =============================================================================
+
+TEST(ExposureCorrelatorTimeTest, WallTimeAdvancesWatermarks) {
+    CorrelatorConfig config;
+    config.max_push_latency_us = 20000;
+    config.max_delay_us = 1000000;
+    ExposureCorrelator correlator(config);
+    std::vector<CorrelatedExposure> records;
+    correlator.RegisterRecordCallback([&records](const CorrelatedExposure& r) { records.push_back(r); });
+
+    // Everything is older than max_push_latency_us: no stream can still deliver before it
+    const int64_t now = hnvue::infra::MonotonicClock::NowUs();
+    correlator.PushExposure(Result(80.0f, 10.0f), now - 400000, now - 390000);
+    correlator.PushFrame(Frame(1, now - 300000));
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_TRUE(records[0].matched);
+    EXPECT_TRUE(records[0].complete);
+    EXPECT_EQ(records[0].status_samples, 0u);
+
+    // A frame beyond max_delay_us is released at once, marked incomplete if forced
+    config.max_push_latency_us = 10LL * 1000 * 1000;
+    ExposureCorrelator stalled(config);
+    records.clear();
+    stalled.RegisterRecordCallback([&records](const CorrelatedExposure& r) { records.push_back(r); });
+    stalled.PushExposure(Result(80.0f, 10.0f), now - 3000000, now - 2990000);
+    stalled.PushFrame(Frame(2, now - 2900000));
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_TRUE(records[0].matched);
+    EXPECT_FALSE(records[0].complete);
+    EXPECT_EQ(stalled.GetStats().frames_incomplete, 1u);
+}
+
+TEST(ExposureCorrelatorTimeTest, PollReleasesFramesWithoutNewEvents) {
+    CorrelatorConfig config;
+    config.max_push_latency_us = 5000;
+    config.status_stream = false;
+    config.dose_stream = false;
+    config.aec_stream = false;
+    ExposureCorrelator correlator(config);
+    std::vector<CorrelatedExposure> records;
+    correlator.RegisterRecordCallback([&records](const CorrelatedExposure& r) { records.push_back(r); });
+
+    const int64_t now = hnvue::infra::MonotonicClock::NowUs();
+    correlator.PushExposure(Result(80.0f, 10.0f), now - 1000, now + 9000);
+    correlator.PushFrame(Frame(1, now + 20000));
+    EXPECT_TRUE(records.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    correlator.Poll();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_TRUE(records[0].matched);
+    EXPECT_TRUE(records[0].complete);
+}
+
+// =============================================================================
+// AEC and Unmatched Events
+// =============================================================================
+
+TEST_F(ExposureCorrelatorTest, AecTerminationShortensMas) {
+    CorrelatorConfig config;
+    config.status_stream = false;
+    config.dose_stream = false;
+    ExposureCorrelator correlator(config);
+    Attach(correlator);
+
+    // Stray termination before any exposure
+    correlator.PushAecTermination(AecTerminationEvent{true, 0.1f, 0}, base_ - 50000);
+
+    // 100 ms backup time, terminated after 40 ms
+    correlator.PushExposure(Result(100.0f, 100.0f), base_, base_ + 100000);
+    correlator.PushAecTermination(AecTerminationEvent{true, 0.5f, 40000}, base_ + 40000);
+    correlator.PushFrame(Frame(3, base_ + 150000));
+    correlator.PushExposure(Result(100.0f, 100.0f), base_ + 500000, base_ + 600000);
+    correlator.PushAecTermination(AecTerminationEvent{}, base_ + 700000);
+
+    ASSERT_EQ(records_.size(), 1u);
+    EXPECT_TRUE(records_[0].aec_terminated);
+    EXPECT_FLOAT_EQ(records_[0].aec_dose_mgy, 0.5f);
+    EXPECT_EQ(records_[0].aec_exposure_time_us, 40000);
+    EXPECT_FLOAT_EQ(records_[0].mas_actual, kMa * 0.04f);
+    EXPECT_EQ(correlator.GetStats().aec_unmatched, 1u);
+}
+
+TEST_F(ExposureCorrelatorTest, UnmatchedEventsAreCounted) {
+    CorrelatorConfig config;
+    config.status_stream = false;
+    config.dose_stream = false;
+    config.aec_stream = false;
+    config.frame_window_us = 100000;
+    ExposureCorrelator correlator(config);
+    Attach(correlator);
+
+    // Dark frame, then an exposure whose frame never comes, then a matched pair
+    correlator.PushFrame(Frame(1, base_));
+    correlator.PushExposure(Result(80.0f, 10.0f), base_ + 50000, base_ + 60000);
+    correlator.PushExposure(Result(80.0f, 10.0f), base_ + 500000, base_ + 510000);
+    correlator.PushFrame(Frame(2, base_ + 540000));
+    correlator.PushExposure(Result(80.0f, 10.0f), base_ + 900000, base_ + 910000);
+
+    // Out-of-order events are dropped
+    correlator.PushExposure(Result(80.0f, 10.0f), base_ + 800000, base_ + 810000);
+    correlator.PushStatus(Status(base_ + 10, GeneratorState::GEN_IDLE, 0.0f));
+    correlator.PushStatus(Status(base_, GeneratorState::GEN_IDLE, 0.0f));
+
+    ASSERT_EQ(records_.size(), 2u);
+    EXPECT_FALSE(records_[0].matched);
+    EXPECT_TRUE(records_[0].complete);
+    EXPECT_TRUE(records_[1].matched);
+    EXPECT_EQ(records_[1].exposure_index, 1u);
+
+    correlator.Flush();
+    CorrelatorStats stats = correlator.GetStats();
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_EQ(stats.frames_unmatched, 1u);
+    EXPECT_EQ(stats.exposures, 3u);
+    EXPECT_EQ(stats.exposures_unmatched, 2u);
+    EXPECT_EQ(stats.late_events, 2u);
+}
+
+// =============================================================================
+// Bounds and Throughput
+// =============================================================================
+
+TEST_F(ExposureCorrelatorTest, FullFrameQueueReleasesOldest) {
+    CorrelatorConfig config;
+    config.frame_capacity = 2;
+    ExposureCorrelator correlator(config);
+    Attach(correlator);
+
+    correlator.PushExposure(Result(80.0f, 10.0f), base_, base_ + 10000);
+    correlator.PushFrame(Frame(1, base_ + 20000));
+    correlator.PushFrame(Frame(2, base_ + 30000));
+    EXPECT_TRUE(records_.empty());
+
+    correlator.PushFrame(Frame(3, base_ + 40000));
+    ASSERT_EQ(records_.size(), 1u);
+    EXPECT_EQ(records_[0].frame_sequence, 1);
+    EXPECT_TRUE(records_[0].matched);
+    EXPECT_FALSE(records_[0].complete);
+}
+
+TEST_F(ExposureCorrelatorTest, LongRunCostPerEvent) {
+    CorrelatorConfig config;
+    config.aec_stream = false;
+    ExposureCorrelator correlator(config);
+    size_t emitted = 0;
+    size_t matched = 0;
+    correlator.RegisterRecordCallback([&](const CorrelatedExposure& record) {
+        ++emitted;
+        matched += record.matched ? 1 : 0;
+    });
+
+    // 2000 exposures of 5 ms every 50 ms, 1 kHz status and dose, one frame each
+    constexpr int kExposures = 2000;
+    size_t events = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kExposures; ++i) {
+        const int64_t start_ms = static_cast<int64_t>(i) * 50;
+        Expose(correlator, start_ms, 5, 100.0f, start_ms + 50);
+        correlator.PushFrame(Frame(i, base_ + (start_ms + 20) * 1000));
+        events += 1 + 2 * 50 + 1;
+    }
+    correlator.Flush();
+    const double elapsed_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    EXPECT_EQ(emitted, static_cast<size_t>(kExposures));
+    EXPECT_EQ(matched, static_cast<size_t>(kExposures));
+    CorrelatorStats stats = correlator.GetStats();
+    EXPECT_EQ(stats.overflows, 0u);
+    EXPECT_EQ(stats.exposures_unmatched, 0u);
+
+    RecordProperty("ns_per_event", std::to_string(elapsed_ns / static_cast<double>(events)));
+}
@@ -0,0 +1,311 @@
+/**
+ * @file test_exposure_sequencer.cpp
+ * @brief GTest unit tests for ExposureSequencer (multi-exposure timing)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator exposure timing
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Validation:     empty / too many steps / kV out of range / small focus
+ *                   without dual focus / interval shorter than exposure + gap
+ *   Timing:         absolute deadlines; StartExposure not called before
+ *                   deadline - learnt arm latency (start errors reported only)
+ *   Pairing:        one frame per exposure, matched in order by timestamp
+ *   Failure:        StartExposure failure / late step not fired
+ *   Abort:          Abort() between steps / concurrent Execute rejected
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "generator/ExposureSequencer.h"
+#include "hnvue/hal/generator/GeneratorSimulator.h"
+#include "hnvue/infra/Clock.h"
+
+#include "mock/MockDetector.h"
+#include "mock/MockGenerator.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+using namespace testing;
+
+namespace {
+
+constexpr auto kArmLatency = std::chrono::microseconds(2000);
+
+ExposureParams Params(float kvp, float ms) {
+    ExposureParams params;
+    params.kvp = kvp;
+    params.ma = 100.0f;
+    params.ms = ms;
+    params.focus = "large";
+    return params;
+}
+
+/// Preemption on a loaded machine must not end a sequence whose timing is only reported
+SequencerConfig TolerantConfig() {
+    SequencerConfig config;
+    config.max_lateness_us = 1000000;
+    return config;
+}
+
+/// n exposures of ms milliseconds, interval_us apart
+ExposurePlan MakePlan(size_t n, float ms, uint32_t interval_us) {
+    ExposurePlan plan;
+    for (size_t i = 0; i < n; ++i) {
+        plan.steps.push_back(SequenceStep{Params(i % 2 == 0 ? 120.0f : 70.0f, ms), interval_us});
+    }
+    return plan;
+}
+
+HvgCapabilities MockCapabilities() {
+    HvgCapabilities caps;
+    caps.min_kvp = 40.0f;
+    caps.max_kvp = 150.0f;
+    caps.min_ma = 0.1f;
+    caps.max_ma = 1000.0f;
+    caps.min_ms = 1.0f;
+    caps.max_ms = 10000.0f;
+    return caps;
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+/**
+ * @brief Simulated generator; the detector delivers a frame at each exposure end
+ */
+class ExposureSequencerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SimulatorConfig config;
+        config.response_latency = kArmLatency;
+        generator_ = std::make_unique<GeneratorSimulator>(config);
+
+        ON_CALL(detector_, RegisterFrameCallback(_))
+            .WillByDefault(Invoke([this](FrameCallback cb) {
+                std::lock_guard<std::mutex> lock(frame_mutex_);
+                frame_callback_ = std::move(cb);
+            }));
+
+        generator_->RegisterStatusCallback([this](const HvgStatus& status) {
+            GeneratorState previous = last_state_.exchange(status.state);
+            if (previous == GeneratorState::GEN_EXPOSING && status.state == GeneratorState::GEN_IDLE) {
+                DeliverFrame();
+            }
+        });
+    }
+
+    void DeliverFrame() {
+        std::lock_guard<std::mutex> lock(frame_mutex_);
+        if (frame_callback_) {
+            RawFrame frame;
+            frame.sequence_number = next_frame_++;
+            frame.timestamp_us = hnvue::infra::MonotonicClock::NowUs();
+            frame_callback_(frame);
+        }
+    }
+
+    NiceMock<MockDetector> detector_;
+    std::unique_ptr<GeneratorSimulator> generator_;
+    std::atomic<GeneratorState> last_state_{GeneratorState::GEN_IDLE};
+    std::mutex frame_mutex_;
+    FrameCallback frame_callback_;
+    int64_t next_frame_ = 100;
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST(ExposurePlanValidationTest, RejectsInvalidPlans) {
+    HvgCapabilities caps = MockCapabilities();
+    SequencerConfig config;
+    std::string error;
+
+    EXPECT_TRUE(ValidateExposurePlan(MakePlan(3, 10.0f, 20000), caps, config, error)) << error;
+
+    EXPECT_FALSE(ValidateExposurePlan(ExposurePlan{}, caps, config, error));
+
+    config.max_steps = 2;
+    EXPECT_FALSE(ValidateExposurePlan(MakePlan(3, 10.0f, 20000), caps, config, error));
+    config = SequencerConfig{};
+
+    ExposurePlan plan = MakePlan(2, 10.0f, 20000);
+    plan.steps[1].params.kvp = 160.0f;
+    EXPECT_FALSE(ValidateExposurePlan(plan, caps, config, error));
+    EXPECT_THAT(error, HasSubstr("Step 1"));
+
+    plan = MakePlan(2, 10.0f, 20000);
+    plan.steps[0].params.focus = "small";
+    EXPECT_FALSE(ValidateExposurePlan(plan, caps, config, error));
+    caps.has_dual_focus = true;
+    EXPECT_TRUE(ValidateExposurePlan(plan, caps, config, error)) << error;
+
+    // 10 ms exposure + 5 ms minimum gap
+    EXPECT_FALSE(ValidateExposurePlan(MakePlan(2, 10.0f, 14999), caps, config, error));
+    EXPECT_TRUE(ValidateExposurePlan(MakePlan(2, 10.0f, 15000), caps, config, error)) << error;
+}
+
+TEST_F(ExposureSequencerTest, InvalidPlanIsNotExposed) {
+    ExposureSequencer sequencer(*generator_, &detector_);
+
+    ExposurePlan plan = MakePlan(2, 10.0f, 12000);
+    SequenceReport report = sequencer.Execute(plan);
+
+    EXPECT_EQ(report.outcome, SequenceOutcome::SEQUENCE_REJECTED);
+    EXPECT_TRUE(report.steps.empty());
+    EXPECT_FALSE(report.error_msg.empty());
+    EXPECT_EQ(generator_->GetStatus().state, GeneratorState::GEN_IDLE);
+}
+
+// =============================================================================
+// Timing and Pairing
+// =============================================================================
+
+TEST_F(ExposureSequencerTest, StartsOnDeadlinesAndPairsFrames) {
+    ExposureSequencer sequencer(*generator_, &detector_, TolerantConfig());
+    const uint32_t interval_us = 40000;
+    ExposurePlan plan = MakePlan(4, 10.0f, interval_us);
+
+    SequenceReport report = sequencer.Execute(plan);
+
+    ASSERT_EQ(report.outcome, SequenceOutcome::SEQUENCE_COMPLETED) << report.error_msg;
+    ASSERT_EQ(report.steps.size(), 4u);
+
+    // Only what holds by construction is asserted; wall-clock start errors
+    // depend on the scheduler and are reported as properties
+    int64_t max_call_error_us = 0;
+    for (size_t i = 0; i < report.steps.size(); ++i) {
+        const SequenceStepReport& step = report.steps[i];
+        EXPECT_TRUE(step.result.success);
+        EXPECT_GE(step.arm_latency_us, kArmLatency.count());
+        EXPECT_EQ(step.end_us - step.start_us, 10000);
+        // StartExposure is never called before deadline - arm_lead_us
+        const int64_t call_error_us = step.start_error_us - (step.arm_latency_us - step.arm_lead_us);
+        EXPECT_GE(call_error_us, 0) << "step " << i;
+        max_call_error_us = std::max(max_call_error_us, call_error_us);
+        if (i > 0) {
+            // Deadlines are absolute; later starts are fired one learnt arm latency early
+            EXPECT_EQ(step.deadline_us - report.steps[i - 1].deadline_us, interval_us);
+            EXPECT_GE(step.arm_lead_us, kArmLatency.count());
+        }
+    }
+
+    // Each exposure is paired with the frame read out at its end
+    EXPECT_EQ(report.frames_received, 4u);
+    EXPECT_EQ(report.frames_matched, 4u);
+    for (size_t i = 0; i < report.steps.size(); ++i) {
+        EXPECT_TRUE(report.steps[i].frame_matched);
+        EXPECT_EQ(report.steps[i].frame_sequence, 100 + static_cast<int64_t>(i));
+        EXPECT_GT(report.steps[i].frame_timestamp_us, report.steps[i].deadline_us);
+    }
+
+    RecordProperty("max_call_error_us", std::to_string(max_call_error_us));
+    RecordProperty("max_start_error_us", std::to_string(report.max_start_error_us));
+    RecordProperty("rms_start_error_us", std::to_string(report.rms_start_error_us));
+    RecordProperty("max_interval_error_us", std::to_string(report.max_interval_error_us));
+}
+
+TEST_F(ExposureSequencerTest, ArmLatencyIsLearntAcrossSequences) {
+    ExposureSequencer sequencer(*generator_, nullptr, TolerantConfig());
+
+    SequenceReport first = sequencer.Execute(MakePlan(2, 5.0f, 20000));
+    ASSERT_EQ(first.outcome, SequenceOutcome::SEQUENCE_COMPLETED) << first.error_msg;
+    // Nothing learnt yet: the first start is one arm latency late
+    EXPECT_GE(first.steps[0].start_error_us, kArmLatency.count());
+
+    SequenceReport second = sequencer.Execute(MakePlan(2, 5.0f, 20000));
+    ASSERT_EQ(second.outcome, SequenceOutcome::SEQUENCE_COMPLETED) << second.error_msg;
+    EXPECT_EQ(first.steps[0].arm_lead_us, 0);
+    EXPECT_GE(second.steps[0].arm_lead_us, kArmLatency.count());
+    // Moving average over the arm latencies seen so far (weight 1/4)
+    EXPECT_EQ(second.steps[0].arm_lead_us, first.steps.back().arm_lead_us +
+              (first.steps.back().arm_latency_us - first.steps.back().arm_lead_us) / 4);
+    EXPECT_EQ(second.frames_received, 0u);
+    EXPECT_FALSE(second.steps[0].frame_matched);
+}
+
+// =============================================================================
+// Failures
+// =============================================================================
+
+TEST(ExposureSequencerMockTest, StartFailureEndsSequence) {
+    NiceMock<MockGenerator> generator;
+    ON_CALL(generator, GetCapabilities()).WillByDefault(Return(MockCapabilities()));
+    EXPECT_CALL(generator, StartExposure())
+        .WillOnce(Return(ExposureResult{true, 120.0f, 100.0f, 5.0f, 0.5f, ""}))
+        .WillOnce(Return(ExposureResult{false, 0, 0, 0, 0, "Interlock open"}));
+
+    ExposureSequencer sequencer(generator, nullptr);
+    SequenceReport report = sequencer.Execute(MakePlan(3, 5.0f, 15000));
+
+    EXPECT_EQ(report.outcome, SequenceOutcome::SEQUENCE_FAILED);
+    EXPECT_EQ(report.failed_step, 1);
+    EXPECT_EQ(report.error_msg, "Interlock open");
+    ASSERT_EQ(report.steps.size(), 2u);
+    EXPECT_TRUE(report.steps[0].result.success);
+    EXPECT_FALSE(report.steps[1].result.success);
+}
+
+TEST(ExposureSequencerMockTest, LateStepIsNotFired) {
+    NiceMock<MockGenerator> generator;
+    ON_CALL(generator, GetCapabilities()).WillByDefault(Return(MockCapabilities()));
+    ON_CALL(generator, StartExposure())
+        .WillByDefault(Return(ExposureResult{true, 120.0f, 100.0f, 5.0f, 0.5f, ""}));
+    // The second parameter set takes 30 ms to load; its deadline is 10 ms after the exposure
+    EXPECT_CALL(generator, SetExposureParams(_))
+        .WillOnce(Return(true))
+        .WillOnce(Invoke([](const ExposureParams&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            return true;
+        }));
+    EXPECT_CALL(generator, StartExposure()).Times(1);
+
+    SequencerConfig config;
+    config.max_lateness_us = 2000;
+    ExposureSequencer sequencer(generator, nullptr, config);
+    SequenceReport report = sequencer.Execute(MakePlan(2, 5.0f, 15000));
+
+    EXPECT_EQ(report.outcome, SequenceOutcome::SEQUENCE_LATE);
+    EXPECT_EQ(report.failed_step, 1);
+    EXPECT_EQ(report.steps.size(), 1u);
+}
+
+// =============================================================================
+// Abort
+// =============================================================================
+
+TEST_F(ExposureSequencerTest, AbortStopsBetweenSteps) {
+    ExposureSequencer sequencer(*generator_, &detector_);
+
+    auto running = std::async(std::launch::async, [&sequencer]() {
+        return sequencer.Execute(MakePlan(3, 10.0f, 300000));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+
+    // A second plan is refused while the first runs
+    SequenceReport concurrent = sequencer.Execute(MakePlan(1, 10.0f, 0));
+    EXPECT_EQ(concurrent.outcome, SequenceOutcome::SEQUENCE_REJECTED);
+
+    sequencer.Abort();
+    SequenceReport report = running.get();
+
+    EXPECT_EQ(report.outcome, SequenceOutcome::SEQUENCE_ABORTED);
+    EXPECT_EQ(report.failed_step, 1);
+    EXPECT_EQ(report.steps.size(), 1u);
+    EXPECT_FALSE(sequencer.IsRunning());
+}
@@ -0,0 +1,527 @@
+/**
+ * @file test_generator_serial.cpp
+ * @brief GTest unit tests for the serial HVG driver (HvgProtocol, GeneratorSerial)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class C - SAFETY CRITICAL: Generator control
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   FrameParser:     whole frames in place / byte-by-byte split / garbage
+ *                    between frames / CRC error and missing ETX resync /
+ *                    corrupt split frame hiding a valid frame
+ *   Payloads:        params, status, alarm, capabilities round trip /
+ *                    oversized payload rejected
+ *   Open:            capabilities read / unsupported baud / missing port /
+ *                    silent generator
+ *   Exposure:        params validated against capabilities / rejected by
+ *                    generator / start without params / start, EXPOSING
+ *                    status, EXPOSURE_DONE / abort ends exposure
+ *   Link faults:     lost request retransmitted / lost ACK re-acknowledged
+ *                    without re-execution / noise on the line / hang-up
+ *   Batching:        commands queued while the I/O thread is busy leave in
+ *                    one write, abort first
+ *   Alarms:          alarm frame delivered to callbacks
+ *
+ * Runs against a stand-in generator on a pseudo-terminal pair (Linux only).
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "generator/GeneratorSerial.h"
+#include "generator/HvgProtocol.h"
+
+#include "mock/PtyGeneratorStandIn.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+using namespace testing;
+
+namespace {
+
+std::vector<uint8_t> Frame(hvg::MessageId id, uint8_t seq, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> out;
+    hvg::AppendFrame(out, id, seq, payload.data(), payload.size());
+    return out;
+}
+
+/// Collects every frame reported by a parser
+struct Collector {
+    struct Seen {
+        hvg::MessageId id;
+        uint8_t seq;
+        std::vector<uint8_t> payload;
+    };
+    std::vector<Seen> frames;
+
+    void operator()(const hvg::FrameView& frame) {
+        frames.push_back({frame.id, frame.seq,
+                          std::vector<uint8_t>(frame.payload, frame.payload + frame.length)});
+    }
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, int timeout_ms = 2000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return predicate();
+}
+
+ExposureParams ValidParams(float ms = 20.0f) {
+    ExposureParams params;
+    params.kvp = 80.0f;
+    params.ma = 100.0f;
+    params.ms = ms;
+    params.aec_mode = AecMode::AEC_MANUAL;
+    params.focus = "large";
+    return params;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Frame Parser
+// =============================================================================
+
+TEST(HvgFrameParserTest, WholeFramesParsedInPlace) {
+    std::vector<uint8_t> stream = Frame(hvg::MessageId::ACK, 1, {0x10, 0x00});
+    std::vector<uint8_t> second = Frame(hvg::MessageId::STATUS, 2, {1, 2, 3, 4, 5, 6, 7, 8});
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    hvg::FrameParser parser;
+    std::vector<const uint8_t*> payloads;
+    parser.Feed(stream.data(), stream.size(), [&](const hvg::FrameView& frame) {
+        payloads.push_back(frame.payload);
+    });
+
+    ASSERT_EQ(payloads.size(), 2u);
+    // Zero-copy: views point into the caller's buffer
+    EXPECT_EQ(payloads[0], stream.data() + 4);
+    EXPECT_EQ(payloads[1], stream.data() + 9 + 4);
+    EXPECT_EQ(parser.GetStats().frames, 2u);
+    EXPECT_EQ(parser.GetStats().reassembled, 0u);
+}
+
+TEST(HvgFrameParserTest, ByteByByteFeedReassembles) {
+    std::vector<uint8_t> stream = Frame(hvg::MessageId::ALARM, 7, {9, 0, 0, 0, 3, 'x', 0});
+    std::vector<uint8_t> empty = Frame(hvg::MessageId::GET_STATUS, 8, {});
+    stream.insert(stream.end(), empty.begin(), empty.end());
+
+    hvg::FrameParser parser;
+    Collector collector;
+    for (uint8_t byte : stream) {
+        parser.Feed(&byte, 1, collector);
+    }
+
+    ASSERT_EQ(collector.frames.size(), 2u);
+    EXPECT_EQ(collector.frames[0].id, hvg::MessageId::ALARM);
+    EXPECT_EQ(collector.frames[0].seq, 7);
+    EXPECT_EQ(collector.frames[0].payload.size(), 7u);
+    EXPECT_EQ(collector.frames[1].id, hvg::MessageId::GET_STATUS);
+    EXPECT_TRUE(collector.frames[1].payload.empty());
+    EXPECT_EQ(parser.GetStats().reassembled, 2u);
+}
+
+TEST(HvgFrameParserTest, GarbageBetweenFramesDiscarded) {
+    std::vector<uint8_t> stream = {0xFF, 0x00, 0x55};
+    std::vector<uint8_t> frame = Frame(hvg::MessageId::ACK, 3, {0x11, 0x00});
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    stream.push_back(0xAA);
+
+    hvg::FrameParser parser;
+    Collector collector;
+    parser.Feed(stream.data(), stream.size(), collector);
+
+    ASSERT_EQ(collector.frames.size(), 1u);
+    EXPECT_EQ(collector.frames[0].seq, 3);
+    EXPECT_EQ(parser.GetStats().discarded_bytes, 4u);
+}
+
+TEST(HvgFrameParserTest, CorruptFramesResynchronize) {
+    std::vector<uint8_t> bad_crc = Frame(hvg::MessageId::ACK, 1, {0x10, 0x00});
+    bad_crc[5] ^= 0x01;
+    std::vector<uint8_t> bad_etx = Frame(hvg::MessageId::ACK, 2, {0x10, 0x00});
+    bad_etx.back() = 0x00;
+    std::vector<uint8_t> good = Frame(hvg::MessageId::ACK, 3, {0x10, 0x00});
+
+    std::vector<uint8_t> stream = bad_crc;
+    stream.insert(stream.end(), bad_etx.begin(), bad_etx.end());
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    hvg::FrameParser parser;
+    Collector collector;
+    parser.Feed(stream.data(), stream.size(), collector);
+
+    ASSERT_EQ(collector.frames.size(), 1u);
+    EXPECT_EQ(collector.frames[0].seq, 3);
+    EXPECT_EQ(parser.GetStats().crc_errors, 1u);
+    EXPECT_EQ(parser.GetStats().framing_errors, 1u);
+}
+
+TEST(HvgFrameParserTest, CorruptSplitFrameRescansForHiddenFrame) {
+    // A stray STX with a large LEN swallows the real frame that follows it
+    std::vector<uint8_t> good = Frame(hvg::MessageId::ACK, 5, {0x12, 0x00});
+    std::vector<uint8_t> stream = {hvg::kStx, static_cast<uint8_t>(good.size() - hvg::kFrameOverhead + 4),
+                                   static_cast<uint8_t>(hvg::MessageId::ACK)};
+    stream.insert(stream.end(), good.begin(), good.end());
+    stream.insert(stream.end(), {0x00, 0x00, 0x00});
+
+    hvg::FrameParser parser;
+    Collector collector;
+    size_t half = stream.size() / 2;
+    parser.Feed(stream.data(), half, collector);
+    parser.Feed(stream.data() + half, stream.size() - half, collector);
+
+    ASSERT_EQ(collector.frames.size(), 1u);
+    EXPECT_EQ(collector.frames[0].seq, 5);
+    EXPECT_EQ(parser.GetStats().framing_errors + parser.GetStats().crc_errors, 1u);
+}
+
+// =============================================================================
+// Payloads
+// =============================================================================
+
+TEST(HvgPayloadTest, ParamsRoundTrip) {
+    ExposureParams params = ValidParams(12.5f);
+    params.focus = "small";
+    params.aec_mode = AecMode::AEC_AUTO;
+    uint8_t payload[hvg::kParamsSize];
+    size_t length = hvg::EncodeParams(params, payload);
+
+    ExposureParams decoded;
+    ASSERT_TRUE(hvg::DecodeParams(hvg::FrameView{hvg::MessageId::SET_PARAMS, 0, payload, length},
+                                  decoded));
+    EXPECT_FLOAT_EQ(decoded.kvp, 80.0f);
+    EXPECT_FLOAT_EQ(decoded.ma, 100.0f);
+    EXPECT_FLOAT_EQ(decoded.ms, 12.5f);
+    EXPECT_EQ(decoded.aec_mode, AecMode::AEC_AUTO);
+    EXPECT_EQ(decoded.focus, "small");
+}
+
+TEST(HvgPayloadTest, StatusAndAlarmRoundTrip) {
+    HvgStatus status;
+    status.state = GeneratorState::GEN_EXPOSING;
+    status.interlock_ok = true;
+    status.actual_kvp = 120.5f;
+    status.actual_ma = 320.0f;
+    uint8_t payload[hvg::kMaxPayload];
+    size_t length = hvg::EncodeStatus(status, payload);
+    HvgStatus decoded;
+    ASSERT_TRUE(hvg::DecodeStatus(hvg::FrameView{hvg::MessageId::STATUS, 0, payload, length}, decoded));
+    EXPECT_EQ(decoded.state, GeneratorState::GEN_EXPOSING);
+    EXPECT_TRUE(decoded.interlock_ok);
+    EXPECT_FLOAT_EQ(decoded.actual_kvp, 120.5f);
+    EXPECT_FLOAT_EQ(decoded.actual_ma, 320.0f);
+
+    HvgAlarm alarm{1042, "Tube overheat", AlarmSeverity::ALARM_CRITICAL, 0};
+    length = hvg::EncodeAlarm(alarm, payload, sizeof(payload));
+    HvgAlarm decoded_alarm;
+    ASSERT_TRUE(hvg::DecodeAlarm(hvg::FrameView{hvg::MessageId::ALARM, 0, payload, length},
+                                 decoded_alarm));
+    EXPECT_EQ(decoded_alarm.alarm_code, 1042);
+    EXPECT_EQ(decoded_alarm.description, "Tube overheat");
+    EXPECT_EQ(decoded_alarm.severity, AlarmSeverity::ALARM_CRITICAL);
+}
+
+TEST(HvgPayloadTest, CapabilitiesRoundTripAndOversizeRejected) {
+    HvgCapabilities caps;
+    caps.min_kvp = 40.0f;
+    caps.max_kvp = 150.0f;
+    caps.min_ma = 0.5f;
+    caps.max_ma = 800.0f;
+    caps.min_ms = 1.0f;
+    caps.max_ms = 6300.0f;
+    caps.has_aec = true;
+    caps.vendor_name = "Vendor";
+    caps.model_name = "Model";
+    caps.firmware_version = "3.4.5";
+    uint8_t payload[hvg::kMaxPayload];
+    size_t length = hvg::EncodeCapabilities(caps, payload, sizeof(payload));
+    ASSERT_GT(length, 0u);
+
+    HvgCapabilities decoded;
+    ASSERT_TRUE(hvg::DecodeCapabilities(
+        hvg::FrameView{hvg::MessageId::CAPABILITIES, 0, payload, length}, decoded));
+    EXPECT_FLOAT_EQ(decoded.min_ma, 0.5f);
+    EXPECT_FLOAT_EQ(decoded.max_ms, 6300.0f);
+    EXPECT_TRUE(decoded.has_aec);
+    EXPECT_FALSE(decoded.has_dual_focus);
+    EXPECT_EQ(decoded.model_name, "Model");
+    EXPECT_EQ(decoded.firmware_version, "3.4.5");
+
+    caps.vendor_name.assign(300, 'v');
+    EXPECT_EQ(hvg::EncodeCapabilities(caps, payload, sizeof(payload)), 0u);
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> big(hvg::kMaxPayload + 1, 0);
+    EXPECT_FALSE(hvg::AppendFrame(out, hvg::MessageId::ALARM, 0, big.data(), big.size()));
+}
+
+// =============================================================================
+// GeneratorSerial against the pty stand-in
+// =============================================================================
+
+class GeneratorSerialTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(stand_in_.Start());
+        config_.serial.port = stand_in_.SlavePath();
+        config_.serial.baud_rate = 115200;
+        config_.response_timeout_ms = 100;
+        config_.abort_wait_ms = 200;
+    }
+
+    void TearDown() override {
+        // Generator first: its I/O thread runs callbacks that capture test locals
+        generator_.reset();
+        stand_in_.Stop();
+    }
+
+    GeneratorSerial& OpenGenerator() {
+        generator_ = std::make_unique<GeneratorSerial>(config_);
+        EXPECT_TRUE(generator_->Open());
+        return *generator_;
+    }
+
+    PtyGeneratorStandIn stand_in_;
+    SerialGeneratorConfig config_;
+    std::unique_ptr<GeneratorSerial> generator_;
+};
+
+TEST_F(GeneratorSerialTest, OpenReadsCapabilities) {
+    GeneratorSerial& generator = OpenGenerator();
+
+    HvgCapabilities caps = generator.GetCapabilities();
+    EXPECT_EQ(caps.model_name, "HVG-PTY-001");
+    EXPECT_FLOAT_EQ(caps.max_kvp, 150.0f);
+    EXPECT_TRUE(caps.has_dual_focus);
+    EXPECT_EQ(generator.GetStatus().state, GeneratorState::GEN_IDLE);
+    EXPECT_TRUE(generator.GetStatus().interlock_ok);
+    EXPECT_TRUE(generator.IsConnected());
+}
+
+TEST_F(GeneratorSerialTest, OpenFailsOnBadConfiguration) {
+    SerialGeneratorConfig bad_baud = config_;
+    bad_baud.serial.baud_rate = 12345;
+    GeneratorSerial unsupported(bad_baud);
+    EXPECT_FALSE(unsupported.Open());
+
+    SerialGeneratorConfig missing = config_;
+    missing.serial.port = "/dev/nonexistent-hvg";
+    GeneratorSerial absent(missing);
+    EXPECT_FALSE(absent.Open());
+}
+
+TEST_F(GeneratorSerialTest, OpenFailsWhenGeneratorSilent) {
+    stand_in_.SetSilent(true);
+    config_.response_timeout_ms = 20;
+    config_.max_retries = 1;
+    GeneratorSerial generator(config_);
+
+    EXPECT_FALSE(generator.Open());
+    EXPECT_FALSE(generator.IsConnected());
+}
+
+TEST_F(GeneratorSerialTest, ParamsValidatedAgainstCapabilities) {
+    GeneratorSerial& generator = OpenGenerator();
+
+    ExposureParams too_high = ValidParams();
+    too_high.kvp = 151.0f;
+    EXPECT_FALSE(generator.SetExposureParams(too_high));
+    EXPECT_EQ(stand_in_.Received(hvg::MessageId::SET_PARAMS), 0);
+
+    EXPECT_TRUE(generator.SetExposureParams(ValidParams()));
+    EXPECT_EQ(stand_in_.Executed(hvg::MessageId::SET_PARAMS), 1);
+    EXPECT_EQ(stand_in_.State(), GeneratorState::GEN_READY);
+}
+
+TEST_F(GeneratorSerialTest, ParamsRejectedByGenerator) {
+    GeneratorSerial& generator = OpenGenerator();
+    stand_in_.RejectParams(true);
+
+    EXPECT_FALSE(generator.SetExposureParams(ValidParams()));
+    ExposureResult result = generator.StartExposure();
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error_msg, "Parameters not set");
+}
+
+TEST_F(GeneratorSerialTest, ExposureRunsToCompletion) {
+    GeneratorSerial& generator = OpenGenerator();
+    std::atomic<bool> saw_exposing{false};
+    generator.RegisterStatusCallback([&saw_exposing](const HvgStatus& status) {
+        if (status.state == GeneratorState::GEN_EXPOSING) {
+            saw_exposing = true;
+        }
+    });
+
+    ASSERT_TRUE(generator.SetExposureParams(ValidParams(20.0f)));
+    ExposureResult started = generator.StartExposure();
+    ASSERT_TRUE(started.success);
+    EXPECT_FLOAT_EQ(started.actual_mas, 2.0f);
+
+    ASSERT_TRUE(WaitFor([&]() { return generator.GetLastExposureResult().success; }));
+    ExposureResult done = generator.GetLastExposureResult();
+    EXPECT_FLOAT_EQ(done.actual_kvp, 80.0f);
+    EXPECT_FLOAT_EQ(done.actual_ms, 20.0f);
+    EXPECT_FLOAT_EQ(done.actual_mas, 2.0f);
+    EXPECT_TRUE(saw_exposing);
+    EXPECT_TRUE(WaitFor([&]() { return generator.GetStatus().state == GeneratorState::GEN_READY; }));
+}
+
+TEST_F(GeneratorSerialTest, StartRejectedInWrongState) {
+    GeneratorSerial& generator = OpenGenerator();
+    ASSERT_TRUE(generator.SetExposureParams(ValidParams(5000.0f)));
+    ASSERT_TRUE(generator.StartExposure().success);
+
+    ExposureResult second = generator.StartExposure();
+    EXPECT_FALSE(second.success);
+    EXPECT_EQ(second.error_msg, "Invalid state for exposure");
+}
+
+TEST_F(GeneratorSerialTest, AbortEndsExposure) {
+    GeneratorSerial& generator = OpenGenerator();
+    ASSERT_TRUE(generator.SetExposureParams(ValidParams(5000.0f)));
+    ASSERT_TRUE(generator.StartExposure().success);
+    ASSERT_TRUE(WaitFor([&]() { return generator.GetStatus().state == GeneratorState::GEN_EXPOSING; }));
+
+    generator.AbortExposure();
+
+    EXPECT_EQ(stand_in_.Executed(hvg::MessageId::ABORT_EXPOSURE), 1);
+    EXPECT_TRUE(WaitFor([&]() { return generator.GetStatus().state == GeneratorState::GEN_READY; }));
+    EXPECT_FALSE(generator.GetLastExposureResult().success);
+}
+
+TEST_F(GeneratorSerialTest, LostRequestIsRetransmitted) {
+    GeneratorSerial& generator = OpenGenerator();
+    stand_in_.DropRequests(2);
+
+    EXPECT_TRUE(generator.SetExposureParams(ValidParams()));
+    EXPECT_EQ(stand_in_.Received(hvg::MessageId::SET_PARAMS), 3);
+    EXPECT_EQ(stand_in_.Executed(hvg::MessageId::SET_PARAMS), 1);
+}
+
+TEST_F(GeneratorSerialTest, LostAckIsNotExecutedTwice) {
+    GeneratorSerial& generator = OpenGenerator();
+    ASSERT_TRUE(generator.SetExposureParams(ValidParams(5000.0f)));
+    stand_in_.DropAnswers(1);
+
+    // The START executes once; the retransmission is only re-acknowledged
+    EXPECT_TRUE(generator.StartExposure().success);
+    EXPECT_EQ(stand_in_.Received(hvg::MessageId::START_EXPOSURE), 2);
+    EXPECT_EQ(stand_in_.Executed(hvg::MessageId::START_EXPOSURE), 1);
+    EXPECT_EQ(stand_in_.Duplicates(), 1);
+}
+
+TEST_F(GeneratorSerialTest, RetriesExhausted) {
+    GeneratorSerial& generator = OpenGenerator();
+    stand_in_.DropRequests(10);
+
+    EXPECT_FALSE(generator.SetExposureParams(ValidParams()));
+    EXPECT_EQ(stand_in_.Received(hvg::MessageId::SET_PARAMS), 1 + static_cast<int>(config_.max_retries));
+}
+
+TEST_F(GeneratorSerialTest, NoiseOnLineIsSkipped) {
+    GeneratorSerial& generator = OpenGenerator();
+    std::atomic<int> updates{0};
+    generator.RegisterStatusCallback([&updates](const HvgStatus&) { ++updates; });
+
+    HvgStatus status;
+    status.state = GeneratorState::GEN_READY;
+    status.interlock_ok = false;
+    uint8_t payload[hvg::kStatusSize];
+    hvg::EncodeStatus(status, payload);
+    std::vector<uint8_t> good = Frame(hvg::MessageId::STATUS, 0,
+                                      std::vector<uint8_t>(payload, payload + sizeof(payload)));
+    std::vector<uint8_t> corrupt = good;
+    corrupt[6] ^= 0xFF;
+
+    std::vector<uint8_t> noise = {0x55, 0x02, 0x01};
+    noise.insert(noise.end(), corrupt.begin(), corrupt.end());
+    noise.insert(noise.end(), good.begin(), good.begin() + 5);
+    stand_in_.WriteRaw(noise);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stand_in_.WriteRaw(std::vector<uint8_t>(good.begin() + 5, good.end()));
+
+    ASSERT_TRUE(WaitFor([&]() { return updates.load() == 1; }));
+    EXPECT_FALSE(generator.GetStatus().interlock_ok);
+    SerialTransportStats stats = generator.GetTransportStats();
+    EXPECT_GE(stats.parser.crc_errors + stats.parser.framing_errors, 1u);
+    EXPECT_GT(stats.parser.discarded_bytes, 0u);
+}
+
+TEST_F(GeneratorSerialTest, AlarmDeliveredToCallbacks) {
+    GeneratorSerial& generator = OpenGenerator();
+    std::promise<HvgAlarm> received;
+    generator.RegisterAlarmCallback([&received](const HvgAlarm& alarm) { received.set_value(alarm); });
+
+    stand_in_.SendAlarm(HvgAlarm{2001, "Anode stall", AlarmSeverity::ALARM_ERROR, 0});
+
+    auto future = received.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    HvgAlarm alarm = future.get();
+    EXPECT_EQ(alarm.alarm_code, 2001);
+    EXPECT_EQ(alarm.description, "Anode stall");
+    EXPECT_EQ(alarm.severity, AlarmSeverity::ALARM_ERROR);
+    EXPECT_GT(alarm.timestamp_us, 0);
+}
+
+TEST_F(GeneratorSerialTest, QueuedCommandsLeaveInOneBatchAbortFirst) {
+    GeneratorSerial& generator = OpenGenerator();
+    ASSERT_TRUE(generator.SetExposureParams(ValidParams()));
+
+    // Hold the I/O thread inside a status callback while commands queue up
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> blocked{false};
+    generator.RegisterStatusCallback([&blocked, released](const HvgStatus& status) {
+        if (status.actual_kvp == 99.0f) {
+            blocked = true;
+            released.wait();
+        }
+    });
+    HvgStatus marker;
+    marker.state = GeneratorState::GEN_READY;
+    marker.actual_kvp = 99.0f;
+    stand_in_.SendStatus(marker);
+    ASSERT_TRUE(WaitFor([&]() { return blocked.load(); }));
+
+    size_t batches_before = generator.GetTransportStats().batches;
+    std::thread params([&]() { EXPECT_TRUE(generator.SetExposureParams(ValidParams(30.0f))); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread abort([&]() { generator.AbortExposure(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release.set_value();
+    params.join();
+    abort.join();
+
+    SerialTransportStats stats = generator.GetTransportStats();
+    EXPECT_EQ(stats.batches, batches_before + 1);
+    EXPECT_GE(stats.max_batch_bytes, 2 * hvg::kFrameOverhead + hvg::kParamsSize);
+
+    std::vector<hvg::MessageId> order = stand_in_.ReceivedOrder();
+    ASSERT_GE(order.size(), 2u);
+    EXPECT_EQ(order[order.size() - 2], hvg::MessageId::ABORT_EXPOSURE);
+    EXPECT_EQ(order.back(), hvg::MessageId::SET_PARAMS);
+}
+
+TEST_F(GeneratorSerialTest, HangUpDisconnects) {
+    GeneratorSerial& generator = OpenGenerator();
+    stand_in_.Stop();
+
+    EXPECT_TRUE(WaitFor([&]() { return !generator.IsConnected(); }));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(generator.SetExposureParams(ValidParams()));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
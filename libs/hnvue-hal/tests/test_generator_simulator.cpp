@@ -23,6 +23,7 @@
 
 #include "hnvue/hal/generator/GeneratorSimulator.h"
 #include "hnvue/hal/HalTypes.h"
+#include "hnvue/infra/Clock.h"
 
 using namespace hnvue::hal;
 
@@ -144,12 +145,11 @@ TEST_F(GeneratorSimulatorTest, InitialStateIsIdle) {
  */
 TEST_F(GeneratorSimulatorTest, StatusIncludesTimestamp) {
     auto status = simulator_->GetStatus();
-    EXPECT_GT(status.timestamp_us, 0);
+    EXPECT_GE(status.timestamp_us, 0);
 
-    // Check timestamp is recent (within 1 second)
-    auto now_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    // Timestamps share the process epoch; check it is recent (within 1 second)
+    int64_t now_us = hnvue::infra::SinceStartUs();
+    EXPECT_LE(status.timestamp_us, now_us);
     EXPECT_NEAR(status.timestamp_us, now_us, 1000000);
 }
 
@@ -0,0 +1,198 @@
+/**
+ * @file test_hot_swap_detector.cpp
+ * @brief GTest unit tests for staged detector plugin reload (HotSwapDetector)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin lifecycle
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Loader:   an isolated load maps its own image next to a loaded one
+ *   Staging:  the current instance keeps answering while the new one
+ *             initialises / the swap holds callers off for well under a
+ *             millisecond / the old instance is drained and destroyed
+ *   Swap:     deferred while acquiring and done at StopAcquisition /
+ *             frame callbacks follow the swap
+ *   Failure:  a plugin that fails to load leaves the current instance /
+ *             a second reload is refused while one is pending
+ *
+ * Uses the stand-in plugin (mock/StandInDetectorPlugin.cpp); its init delay
+ * and firmware string come from the environment at CreateDetector().
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "plugin/DetectorPluginLoader.h"
+#include "plugin/HotSwapDetector.h"
+
+using namespace hnvue::hal;
+
+namespace {
+
+constexpr const char* kPluginPath = HNVUE_TEST_DETECTOR_PLUGIN;
+
+bool WaitFor(const std::function<bool()>& condition, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return condition();
+}
+
+class HotSwapDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        unsetenv("HNVUE_STANDIN_INIT_DELAY_MS");
+        unsetenv("HNVUE_STANDIN_FIRMWARE");
+        auto plugin = loader_.LoadPlugin(kPluginPath);
+        ASSERT_NE(plugin, nullptr);
+        detector_ = std::make_unique<HotSwapDetector>(loader_, std::move(plugin));
+    }
+
+    void TearDown() override {
+        detector_.reset();
+        unsetenv("HNVUE_STANDIN_INIT_DELAY_MS");
+        unsetenv("HNVUE_STANDIN_FIRMWARE");
+    }
+
+    /// Next CreateDetector() reports firmware and takes delay_ms to initialise
+    static void NextBuild(const char* firmware, int delay_ms) {
+        setenv("HNVUE_STANDIN_FIRMWARE", firmware, 1);
+        setenv("HNVUE_STANDIN_INIT_DELAY_MS", std::to_string(delay_ms).c_str(), 1);
+    }
+
+    static AcquisitionConfig Acquisition() {
+        AcquisitionConfig cfg;
+        cfg.session_id = "HS-1";
+        cfg.frame_rate = 200.0f;
+        return cfg;
+    }
+
+    DetectorPluginLoader loader_;
+    std::unique_ptr<HotSwapDetector> detector_;
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// Loader
+// =============================================================================
+
+TEST_F(HotSwapDetectorTest, IsolatedLoadMapsSeparateImage) {
+    auto isolated = loader_.LoadPluginIsolated(kPluginPath);
+    ASSERT_NE(isolated, nullptr);
+    EXPECT_NE(isolated->GetLibraryHandle(), detector_->CurrentPlugin()->GetLibraryHandle());
+    EXPECT_EQ(isolated->GetInfo().plugin_path, kPluginPath);
+}
+
+// =============================================================================
+// Staging
+// =============================================================================
+
+TEST_F(HotSwapDetectorTest, CurrentInstanceServesWhileNewOneInitialises) {
+    NextBuild("3.0.0", 300);
+    auto old_plugin = detector_->CurrentPlugin();
+    std::weak_ptr<PluginHandle> old_weak = old_plugin;
+    old_plugin.reset();
+
+    ASSERT_TRUE(detector_->StageReload(kPluginPath));
+
+    // Detector answers throughout the vendor initialisation
+    int64_t worst_call_us = 0;
+    int calls = 0;
+    auto staging_until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < staging_until) {
+        auto t0 = std::chrono::steady_clock::now();
+        DetectorInfo info = detector_->GetDetectorInfo();
+        worst_call_us = std::max<int64_t>(worst_call_us,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count());
+        EXPECT_EQ(info.firmware_version, "2.1.0");
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GT(calls, 10);
+    EXPECT_LT(worst_call_us, 50000);
+
+    ASSERT_TRUE(detector_->WaitForReload(5000));
+    EXPECT_EQ(detector_->GetDetectorInfo().firmware_version, "3.0.0");
+    EXPECT_TRUE(old_weak.expired());
+
+    HotSwapStats stats = detector_->GetStats();
+    EXPECT_EQ(stats.reloads_completed, 1u);
+    EXPECT_GE(stats.last_stage_us, 300000);
+    EXPECT_LT(stats.last_swap_ns, 1000000);
+    RecordProperty("stage_us", std::to_string(stats.last_stage_us));
+    RecordProperty("swap_ns", std::to_string(stats.last_swap_ns));
+    RecordProperty("drain_us", std::to_string(stats.last_drain_us));
+}
+
+// =============================================================================
+// Swap
+// =============================================================================
+
+TEST_F(HotSwapDetectorTest, SwapDeferredUntilAcquisitionStops) {
+    std::atomic<int> frames{0};
+    detector_->RegisterFrameCallback([&](const RawFrame&) { ++frames; });
+    ASSERT_TRUE(detector_->StartAcquisition(Acquisition()));
+    ASSERT_TRUE(WaitFor([&]() { return frames >= 5; }, 5000));
+
+    NextBuild("3.1.0", 50);
+    ASSERT_TRUE(detector_->StageReload(kPluginPath));
+    ASSERT_TRUE(WaitFor([&]() { return detector_->GetStats().last_stage_us > 0; }, 5000));
+
+    // Staged but not swapped: the running acquisition keeps its instance
+    int before = frames;
+    ASSERT_TRUE(WaitFor([&]() { return frames >= before + 5; }, 5000));
+    EXPECT_EQ(detector_->GetDetectorInfo().firmware_version, "2.1.0");
+    EXPECT_FALSE(detector_->WaitForReload(20));
+
+    EXPECT_TRUE(detector_->StopAcquisition());
+    ASSERT_TRUE(detector_->WaitForReload(5000));
+    EXPECT_EQ(detector_->GetDetectorInfo().firmware_version, "3.1.0");
+
+    // Callbacks registered before the swap receive the new instance's frames
+    before = frames;
+    ASSERT_TRUE(detector_->StartAcquisition(Acquisition()));
+    ASSERT_TRUE(WaitFor([&]() { return frames >= before + 5; }, 5000));
+    EXPECT_TRUE(detector_->GetStatus().is_acquiring);
+    EXPECT_TRUE(detector_->StopAcquisition());
+}
+
+// =============================================================================
+// Failure
+// =============================================================================
+
+TEST_F(HotSwapDetectorTest, FailedReloadKeepsCurrentInstance) {
+    auto before = detector_->CurrentPlugin();
+    ASSERT_TRUE(detector_->StageReload("/nonexistent/detector_plugin.so"));
+    ASSERT_TRUE(detector_->WaitForReload(5000));
+
+    EXPECT_EQ(detector_->CurrentPlugin(), before);
+    EXPECT_EQ(detector_->GetStats().reloads_failed, 1u);
+    EXPECT_EQ(detector_->GetStats().reloads_completed, 0u);
+    EXPECT_EQ(detector_->GetDetectorInfo().model, "PLUGIN-DET-1");
+}
+
+TEST_F(HotSwapDetectorTest, SecondReloadRefusedWhilePending) {
+    NextBuild("3.2.0", 200);
+    ASSERT_TRUE(detector_->StageReload(kPluginPath));
+    EXPECT_FALSE(detector_->StageReload(kPluginPath));
+    ASSERT_TRUE(detector_->WaitForReload(5000));
+    EXPECT_TRUE(detector_->StageReload(kPluginPath));
+    ASSERT_TRUE(detector_->WaitForReload(5000));
+    EXPECT_EQ(detector_->GetStats().reloads_completed, 2u);
+}
@@ -0,0 +1,440 @@
+/**
+ * @file test_network_detector.cpp
+ * @brief GTest unit tests for the network detector adapter (RawFrameWire, NetworkDetector)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector acquisition
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   RawFrameWire:   fields decoded across arbitrary chunk splits / pixels
+ *                   copied once into the sink's buffer / unknown fields
+ *                   skipped / wrong pixel size left to the caller /
+ *                   truncated and malformed messages rejected
+ *   Connect:        detector info read / nothing listening
+ *   Acquisition:    frames delivered in order with geometry and pixels /
+ *                   binning sizes the frame / start refused by detector /
+ *                   double start / stop mid-stream cancels the stream /
+ *                   slow consumer drops oldest, never stalls the reader
+ *   Faults:         wrong pixel_data size and malformed frames rejected
+ *                   without disturbing the rest of the stream
+ *   Large frames:   frames above gRPC's 4 MB default limit
+ *   Throughput:     9 MP 16-bit frames at 10 fps delivered without loss
+ *
+ * Runs against a stand-in detector server on localhost.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "detector/NetworkDetector.h"
+#include "detector/RawFrameWire.h"
+#include "mock/GrpcDetectorStandIn.h"
+
+using namespace hnvue::hal;
+using namespace hnvue::hal::test;
+
+namespace {
+
+// =============================================================================
+// RawFrameWire
+// =============================================================================
+
+class BufferSink : public detwire::PixelSink {
+public:
+    explicit BufferSink(size_t expected) : expected_(expected) {}
+
+    uint8_t* PixelDestination(size_t pixel_bytes) override {
+        ++calls;
+        if (pixel_bytes != expected_) {
+            return nullptr;
+        }
+        buffer.resize(pixel_bytes);
+        return buffer.data();
+    }
+
+    std::vector<uint8_t> buffer;
+    int calls = 0;
+
+private:
+    size_t expected_;
+};
+
+std::string SerializedFrame(size_t pixel_bytes) {
+    detector::RawFrame frame;
+    frame.set_sequence_number(42);
+    frame.set_timestamp_us(123456789);
+    frame.set_width(64);
+    frame.set_height(32);
+    frame.set_bit_depth(14);
+    frame.set_session_id("session-a");
+    std::string pixels(pixel_bytes, '\0');
+    for (size_t i = 0; i < pixel_bytes; ++i) {
+        pixels[i] = static_cast<char>(GrpcDetectorStandIn::PatternAt(i));
+    }
+    frame.set_pixel_data(pixels);
+    return frame.SerializeAsString();
+}
+
+std::vector<detwire::WireChunk> Split(const std::string& bytes, size_t chunk_size) {
+    std::vector<detwire::WireChunk> chunks;
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+        chunks.push_back({data + offset, std::min(chunk_size, bytes.size() - offset)});
+        chunks.push_back({data, 0});  // Empty chunks are tolerated
+    }
+    return chunks;
+}
+
+TEST(RawFrameWireTest, DecodesAcrossAnyChunkSplit) {
+    std::string bytes = SerializedFrame(4096);
+    for (size_t chunk_size : {size_t{1}, size_t{3}, size_t{7}, size_t{1000}, bytes.size()}) {
+        auto chunks = Split(bytes, chunk_size);
+        BufferSink sink(4096);
+        detwire::RawFrameHeader header;
+
+        ASSERT_TRUE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink))
+            << "chunk size " << chunk_size;
+        EXPECT_EQ(header.sequence_number, 42);
+        EXPECT_EQ(header.timestamp_us, 123456789);
+        EXPECT_EQ(header.width, 64);
+        EXPECT_EQ(header.height, 32);
+        EXPECT_EQ(header.bit_depth, 14);
+        EXPECT_EQ(header.session_id, "session-a");
+        EXPECT_EQ(header.pixel_bytes, 4096u);
+        EXPECT_TRUE(header.pixels_copied);
+        EXPECT_EQ(sink.calls, 1);
+        for (size_t i = 0; i < sink.buffer.size(); i += 97) {
+            ASSERT_EQ(sink.buffer[i], GrpcDetectorStandIn::PatternAt(i));
+        }
+    }
+}
+
+TEST(RawFrameWireTest, UnknownFieldsAreSkipped) {
+    std::string bytes = SerializedFrame(16);
+    // Field 15 varint, field 16 fixed64, field 17 length-delimited, field 18 fixed32
+    bytes += std::string("\x78\x05", 2);
+    bytes += std::string("\x81\x01\x01\x02\x03\x04\x05\x06\x07\x08", 10);
+    bytes += std::string("\x8a\x01\x03xyz", 6);
+    bytes += std::string("\x95\x01\x01\x02\x03\x04", 6);
+
+    auto chunks = Split(bytes, 5);
+    BufferSink sink(16);
+    detwire::RawFrameHeader header;
+    ASSERT_TRUE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+    EXPECT_EQ(header.sequence_number, 42);
+    EXPECT_TRUE(header.pixels_copied);
+}
+
+TEST(RawFrameWireTest, WrongPixelSizeIsNotCopied) {
+    std::string bytes = SerializedFrame(100);
+    auto chunks = Split(bytes, 64);
+    BufferSink sink(4096);
+    detwire::RawFrameHeader header;
+
+    ASSERT_TRUE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+    EXPECT_EQ(header.pixel_bytes, 100u);
+    EXPECT_FALSE(header.pixels_copied);
+    EXPECT_EQ(header.session_id, "session-a");  // Decoding continued past the pixels
+}
+
+TEST(RawFrameWireTest, TruncatedAndMalformedMessagesAreRejected) {
+    std::string bytes = SerializedFrame(256);
+    detwire::RawFrameHeader header;
+
+    // Cut inside the pixel data
+    std::string truncated = bytes.substr(0, bytes.size() - 40);
+    auto chunks = Split(truncated, 32);
+    BufferSink sink(256);
+    EXPECT_FALSE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+
+    // Group wire type (proto2 only)
+    std::string group("\x0b", 1);
+    chunks = Split(group, 1);
+    EXPECT_FALSE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+
+    // Oversized session_id length
+    std::string session("\x3a\xff\xff\x03", 4);
+    chunks = Split(session, 4);
+    EXPECT_FALSE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+
+    // Unterminated varint
+    std::string varint("\x08\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff", 12);
+    chunks = Split(varint, 12);
+    EXPECT_FALSE(detwire::DecodeRawFrame(chunks.data(), chunks.size(), header, sink));
+}
+
+// =============================================================================
+// NetworkDetector
+// =============================================================================
+
+/**
+ * @brief Collects delivered frames (metadata and pixel spot checks)
+ */
+struct FrameLog {
+    struct Entry {
+        int64_t sequence_number;
+        int32_t width;
+        int32_t height;
+        int32_t bit_depth;
+        size_t bytes;
+        bool pattern_ok;
+        std::string session_id;
+    };
+
+    void Record(const RawFrame& frame) {
+        bool pattern_ok = true;
+        size_t step = std::max<size_t>(frame.pixel_data.size() / 64, 1);
+        for (size_t i = 0; i < frame.pixel_data.size(); i += step) {
+            pattern_ok = pattern_ok && frame.pixel_data[i] == GrpcDetectorStandIn::PatternAt(i);
+        }
+        if (!frame.pixel_data.empty()) {
+            size_t last = frame.pixel_data.size() - 1;
+            pattern_ok = pattern_ok && frame.pixel_data[last] == GrpcDetectorStandIn::PatternAt(last);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back({frame.sequence_number, frame.width, frame.height, frame.bit_depth,
+                           frame.pixel_data.size(), pattern_ok, frame.session_id});
+    }
+
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+};
+
+bool WaitFor(const std::function<bool()>& condition, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+class NetworkDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+    }
+
+    void Open(int32_t width, int32_t height, int32_t bit_depth) {
+        stand_in_ = std::make_unique<GrpcDetectorStandIn>(width, height, bit_depth);
+        ASSERT_TRUE(stand_in_->Start());
+
+        NetworkDetectorConfig config;
+        config.endpoint = stand_in_->Endpoint();
+        detector_ = std::make_unique<NetworkDetector>(config);
+        ASSERT_TRUE(detector_->Connect());
+        detector_->RegisterFrameCallback([this](const RawFrame& frame) { log_.Record(frame); });
+    }
+
+    void TearDown() override {
+        detector_.reset();
+        stand_in_.reset();
+    }
+
+    static AcquisitionConfig Config(int32_t num_frames, float frame_rate, int32_t binning = 1) {
+        AcquisitionConfig cfg;
+        cfg.mode = AcquisitionMode::MODE_CONTINUOUS;
+        cfg.num_frames = num_frames;
+        cfg.frame_rate = frame_rate;
+        cfg.binning = binning;
+        cfg.session_id = "S-1";
+        return cfg;
+    }
+
+    std::unique_ptr<GrpcDetectorStandIn> stand_in_;
+    std::unique_ptr<NetworkDetector> detector_;
+    FrameLog log_;
+};
+
+TEST_F(NetworkDetectorTest, ConnectReadsDetectorInfo) {
+    Open(128, 96, 16);
+    DetectorInfo info = detector_->GetDetectorInfo();
+    EXPECT_EQ(info.vendor, "StandIn");
+    EXPECT_EQ(info.model, "NET-DET-1");
+    EXPECT_EQ(info.pixel_width, 128);
+    EXPECT_EQ(info.pixel_height, 96);
+    EXPECT_EQ(info.max_bit_depth, 16);
+    EXPECT_FALSE(detector_->GetStatus().is_acquiring);
+}
+
+TEST_F(NetworkDetectorTest, ConnectFailsWithoutServer) {
+    NetworkDetectorConfig config;
+    config.endpoint = "127.0.0.1:1";
+    config.rpc_timeout_ms = 200;
+    NetworkDetector detector(config);
+    EXPECT_FALSE(detector.Connect());
+    EXPECT_FALSE(detector.StartAcquisition(Config(1, 0.0f)));
+}
+
+TEST_F(NetworkDetectorTest, FramesDeliveredInOrderWithPixels) {
+    Open(128, 96, 16);
+    ASSERT_TRUE(detector_->StartAcquisition(Config(20, 200.0f)));
+
+    ASSERT_TRUE(WaitFor([&]() { return log_.Count() == 20; }, 5000)) << log_.Count();
+    ASSERT_TRUE(WaitFor([&]() { return !detector_->GetStatus().is_acquiring; }, 2000));
+
+    for (size_t i = 0; i < log_.entries.size(); ++i) {
+        const auto& entry = log_.entries[i];
+        EXPECT_EQ(entry.sequence_number, static_cast<int64_t>(i));
+        EXPECT_EQ(entry.width, 128);
+        EXPECT_EQ(entry.height, 96);
+        EXPECT_EQ(entry.bit_depth, 16);
+        EXPECT_EQ(entry.bytes, 128u * 96u * 2u);
+        EXPECT_TRUE(entry.pattern_ok) << "frame " << i;
+        EXPECT_EQ(entry.session_id, "S-1");
+    }
+
+    auto stats = detector_->GetStats();
+    EXPECT_EQ(stats.frames_received, 20u);
+    EXPECT_EQ(stats.frames_delivered, 20u);
+    EXPECT_EQ(stats.frames_rejected, 0u);
+    EXPECT_EQ(detector_->GetStatus().frames_acquired, 20);
+    EXPECT_EQ(stand_in_->StartCalls(), 1);
+    EXPECT_EQ(stand_in_->LastConfig().session_id(), "S-1");
+    EXPECT_TRUE(detector_->StopAcquisition());
+}
+
+TEST_F(NetworkDetectorTest, BinningSizesTheFrame) {
+    Open(128, 96, 16);
+    // The stand-in always sends full-resolution frames: binned size mismatches
+    ASSERT_TRUE(detector_->StartAcquisition(Config(3, 0.0f, 2)));
+    ASSERT_TRUE(WaitFor([&]() { return detector_->GetStats().frames_rejected == 3; }, 5000));
+    EXPECT_EQ(log_.Count(), 0u);
+    EXPECT_EQ(stand_in_->LastConfig().binning(), 2);
+
+    EXPECT_TRUE(detector_->StopAcquisition());
+    EXPECT_FALSE(detector_->StartAcquisition(Config(3, 0.0f, 3)));
+}
+
+TEST_F(NetworkDetectorTest, StartRefusedByDetector) {
+    Open(64, 64, 16);
+    stand_in_->FailStart(true);
+    EXPECT_FALSE(detector_->StartAcquisition(Config(1, 0.0f)));
+    EXPECT_FALSE(detector_->GetStatus().is_acquiring);
+    EXPECT_EQ(stand_in_->Streams(), 0);
+}
+
+TEST_F(NetworkDetectorTest, SecondStartWhileAcquiringIsRefused) {
+    Open(64, 64, 16);
+    ASSERT_TRUE(detector_->StartAcquisition(Config(0, 50.0f)));
+    EXPECT_FALSE(detector_->StartAcquisition(Config(0, 50.0f)));
+    EXPECT_FALSE(detector_->RunCalibration(CalibType::CALIB_DARK_FIELD, 4).success);
+    EXPECT_TRUE(detector_->StopAcquisition());
+
+    CalibrationResult calibration = detector_->RunCalibration(CalibType::CALIB_DARK_FIELD, 4);
+    EXPECT_TRUE(calibration.success);
+    EXPECT_EQ(calibration.output_path, "/cal/1");
+}
+
+TEST_F(NetworkDetectorTest, StopCancelsContinuousStream) {
+    Open(64, 64, 16);
+    ASSERT_TRUE(detector_->StartAcquisition(Config(0, 100.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return log_.Count() >= 5; }, 5000));
+
+    EXPECT_TRUE(detector_->StopAcquisition());
+    EXPECT_FALSE(detector_->GetStatus().is_acquiring);
+    EXPECT_EQ(stand_in_->StopCalls(), 1);
+    ASSERT_TRUE(WaitFor([&]() { return stand_in_->ActiveStreams() == 0; }, 2000));
+
+    // No delivery after stop
+    size_t delivered = log_.Count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(log_.Count(), delivered);
+
+    // The detector can be restarted
+    ASSERT_TRUE(detector_->StartAcquisition(Config(2, 100.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return log_.Count() == delivered + 2; }, 5000));
+    EXPECT_TRUE(detector_->StopAcquisition());
+}
+
+TEST_F(NetworkDetectorTest, FaultyFramesRejectedWithoutBreakingStream) {
+    Open(64, 64, 16);
+    stand_in_->SetWrongSizeEvery(4);
+    stand_in_->SetMalformedEvery(5);
+    ASSERT_TRUE(detector_->StartAcquisition(Config(20, 200.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return !detector_->GetStatus().is_acquiring; }, 5000));
+
+    // Frames 4, 8, 12, 16, 20 wrong size; 5, 10, 15 malformed (20 counted once)
+    auto stats = detector_->GetStats();
+    EXPECT_EQ(stats.frames_received, 20u);
+    EXPECT_EQ(stats.frames_rejected, 8u);
+    EXPECT_EQ(stats.frames_delivered, 12u);
+    for (const auto& entry : log_.entries) {
+        EXPECT_TRUE(entry.pattern_ok);
+    }
+}
+
+TEST_F(NetworkDetectorTest, SlowConsumerDropsOldestWithoutStallingStream) {
+    Open(64, 64, 16);
+    detector_->RegisterFrameCallback([](const RawFrame&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    ASSERT_TRUE(detector_->StartAcquisition(Config(40, 0.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return !detector_->GetStatus().is_acquiring; }, 10000));
+
+    auto stats = detector_->GetStats();
+    EXPECT_EQ(stats.frames_received, 40u);
+    EXPECT_GT(stats.frames_overwritten, 0u);
+    EXPECT_EQ(stats.frames_delivered + stats.frames_overwritten, 40u);
+
+    // Survivors are still in order
+    for (size_t i = 1; i < log_.entries.size(); ++i) {
+        EXPECT_GT(log_.entries[i].sequence_number, log_.entries[i - 1].sequence_number);
+    }
+}
+
+TEST_F(NetworkDetectorTest, FramesAboveDefaultMessageLimit) {
+    // 2048 x 2048 x 16 bit = 8 MB per message (gRPC default limit is 4 MB)
+    Open(2048, 2048, 16);
+    ASSERT_TRUE(detector_->StartAcquisition(Config(3, 20.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return log_.Count() == 3; }, 10000));
+    EXPECT_EQ(log_.entries[2].bytes, 2048u * 2048u * 2u);
+    EXPECT_TRUE(log_.entries[2].pattern_ok);
+    EXPECT_EQ(detector_->GetStats().frames_rejected, 0u);
+}
+
+TEST_F(NetworkDetectorTest, SustainedNineMegapixelAtTenFps) {
+    // 3000 x 3000 x 16 bit = 18 MB per frame, 180 MB/s at 10 fps
+    constexpr int kFrames = 30;
+    Open(3000, 3000, 16);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(detector_->StartAcquisition(Config(kFrames, 10.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return !detector_->GetStatus().is_acquiring; }, 20000));
+    double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto stats = detector_->GetStats();
+    EXPECT_EQ(stats.frames_delivered, static_cast<uint64_t>(kFrames));
+    EXPECT_EQ(stats.frames_rejected, 0u);
+    EXPECT_EQ(stats.frames_overwritten, 0u);
+    for (const auto& entry : log_.entries) {
+        EXPECT_TRUE(entry.pattern_ok);
+    }
+
+    double fps = kFrames / elapsed_s;
+    double mb_per_s = static_cast<double>(stats.bytes_received) / elapsed_s / 1e6;
+    RecordProperty("elapsed_s", std::to_string(elapsed_s));
+    RecordProperty("fps", std::to_string(fps));
+    RecordProperty("mb_per_s", std::to_string(mb_per_s));
+    // Paced at 10 fps: 30 frames take ~2.9 s when the adapter keeps up
+    EXPECT_GT(fps, 9.0);
+}
+
+} // anonymous namespace
@@ -0,0 +1,505 @@
+/**
+ * @file test_out_of_process_detector.cpp
+ * @brief GTest unit tests for out-of-process detector plugins (ShmFrameRing, OutOfProcessDetector)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Detector plugin isolation
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   ShmFrameRing:   frames read in place through a second mapping / full
+ *                   ring drops the new frame (producer never blocks) /
+ *                   oversized frames dropped / Wait times out and is
+ *                   interruptible / foreign memfd rejected / producer in
+ *                   another process wakes the consumer via the shared futex
+ *   Protocol:       records of the wrong size rejected / strings truncated
+ *   Host:           handshake proxies DetectorInfo / missing plugin fails
+ *                   Launch / frames delivered zero-copy and as RawFrame /
+ *                   status and calibration proxied / SIGKILLed host
+ *                   restarted well under a second and acquisition resumed /
+ *                   vendor abort() restarts the host / hung vendor call
+ *                   times out and the host is replaced / restart disabled /
+ *                   shutdown leaves no host process
+ *
+ * Host tests run hnvue-detector-host with the stand-in plugin
+ * (mock/StandInDetectorPlugin.cpp); the build passes both paths in.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "plugin/OutOfProcessDetector.h"
+#include "plugin/PluginHostProtocol.h"
+#include "plugin/ShmFrameRing.h"
+
+using namespace hnvue::hal;
+
+namespace {
+
+bool WaitFor(const std::function<bool()>& condition, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return condition();
+}
+
+ShmFrameMeta Meta(int64_t sequence) {
+    ShmFrameMeta meta;
+    meta.sequence_number = sequence;
+    meta.timestamp_unix_us = 1700000000000000 + sequence;
+    meta.width = 4;
+    meta.height = 2;
+    meta.bit_depth = 16;
+    meta.session_id = "S-9";
+    return meta;
+}
+
+// =============================================================================
+// ShmFrameRing
+// =============================================================================
+
+TEST(ShmFrameRingTest, FramesReadInPlaceThroughSecondMapping) {
+    auto producer = ShmFrameRing::Create(3, 64);
+    ASSERT_NE(producer, nullptr);
+    EXPECT_EQ(producer->SlotCount(), 4u);   // Rounded to a power of two
+    auto consumer = ShmFrameRing::Attach(dup(producer->Fd()));
+    ASSERT_NE(consumer, nullptr);
+
+    std::vector<uint8_t> pixels(16);
+    for (int64_t seq = 0; seq < 10; ++seq) {
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint8_t>(i + seq);
+        }
+        ASSERT_TRUE(producer->Publish(Meta(seq), pixels.data(), pixels.size()));
+
+        ShmFrameView view;
+        ASSERT_TRUE(consumer->Peek(view));
+        EXPECT_EQ(view.header->sequence_number, seq);
+        EXPECT_EQ(view.header->timestamp_unix_us, 1700000000000000 + seq);
+        EXPECT_EQ(view.header->width, 4);
+        EXPECT_EQ(view.header->height, 2);
+        EXPECT_STREQ(view.header->session_id, "S-9");
+        ASSERT_EQ(view.pixel_bytes, 16u);
+        EXPECT_EQ(std::memcmp(view.pixels, pixels.data(), pixels.size()), 0);
+        consumer->Release();
+        EXPECT_FALSE(consumer->Peek(view));
+    }
+    EXPECT_EQ(consumer->PublishedFrames(), 10u);
+    EXPECT_EQ(consumer->DroppedFrames(), 0u);
+}
+
+TEST(ShmFrameRingTest, FullRingDropsNewFrames) {
+    auto ring = ShmFrameRing::Create(4, 64);
+    ASSERT_NE(ring, nullptr);
+    uint8_t pixels[8] = {};
+    for (int64_t seq = 0; seq < 4; ++seq) {
+        ASSERT_TRUE(ring->Publish(Meta(seq), pixels, sizeof(pixels)));
+    }
+    EXPECT_FALSE(ring->Publish(Meta(4), pixels, sizeof(pixels)));
+    EXPECT_EQ(ring->DroppedFrames(), 1u);
+
+    // The oldest frames survive; space frees up as they are released
+    ShmFrameView view;
+    ASSERT_TRUE(ring->Peek(view));
+    EXPECT_EQ(view.header->sequence_number, 0);
+    ring->Release();
+    EXPECT_TRUE(ring->Publish(Meta(5), pixels, sizeof(pixels)));
+}
+
+TEST(ShmFrameRingTest, OversizedFrameDropped) {
+    auto ring = ShmFrameRing::Create(2, 64);
+    ASSERT_NE(ring, nullptr);
+    std::vector<uint8_t> pixels(65);
+    EXPECT_FALSE(ring->Publish(Meta(0), pixels.data(), pixels.size()));
+    EXPECT_EQ(ring->DroppedFrames(), 1u);
+    ShmFrameView view;
+    EXPECT_FALSE(ring->Peek(view));
+}
+
+TEST(ShmFrameRingTest, WaitTimesOutAndIsInterruptible) {
+    auto ring = ShmFrameRing::Create(2, 64);
+    ASSERT_NE(ring, nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring->Wait(std::chrono::milliseconds(30)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(25));
+
+    std::thread waker([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ring->Wake();
+    });
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring->Wait(std::chrono::seconds(5)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    waker.join();
+}
+
+TEST(ShmFrameRingTest, ForeignMemfdRejected) {
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "not-a-ring", MFD_CLOEXEC));
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 4096), 0);
+    EXPECT_EQ(ShmFrameRing::Attach(fd), nullptr);   // fd closed by Attach
+    EXPECT_EQ(ShmFrameRing::Attach(-1), nullptr);
+}
+
+TEST(ShmFrameRingTest, ProducerInAnotherProcessWakesConsumer) {
+    constexpr int kFrames = 200;
+    auto ring = ShmFrameRing::Create(8, 4096);
+    ASSERT_NE(ring, nullptr);
+    int child_fd = dup(ring->Fd());
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        auto producer = ShmFrameRing::Attach(child_fd);
+        if (!producer) {
+            _exit(2);
+        }
+        std::vector<uint8_t> pixels(4096);
+        for (int seq = 0; seq < kFrames; ++seq) {
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                pixels[i] = static_cast<uint8_t>(i * 3 + seq);
+            }
+            while (!producer->Publish(Meta(seq), pixels.data(), pixels.size())) {
+                usleep(100);   // Test producer retries; the real host drops
+            }
+            if (seq % 16 == 0) {
+                usleep(1000);  // Let the consumer go to sleep in the futex
+            }
+        }
+        _exit(0);
+    }
+    close(child_fd);
+
+    int received = 0;
+    bool content_ok = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received < kFrames && std::chrono::steady_clock::now() < deadline) {
+        if (!ring->Wait(std::chrono::milliseconds(100))) {
+            continue;
+        }
+        ShmFrameView view;
+        while (ring->Peek(view)) {
+            content_ok = content_ok && view.header->sequence_number == received &&
+                         view.pixels[100] == static_cast<uint8_t>(300 + received) &&
+                         view.pixels[4095] == static_cast<uint8_t>(4095 * 3 + received);
+            ring->Release();
+            ++received;
+        }
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_EQ(received, kFrames);
+    EXPECT_TRUE(content_ok);
+}
+
+// =============================================================================
+// Protocol
+// =============================================================================
+
+TEST(PluginHostProtocolTest, WrongSizeRecordsRejected) {
+    int sockets[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets), 0);
+
+    hostproto::HostReply reply;
+    char shorter[16] = {};
+    ASSERT_TRUE(hostproto::SendRecord(sockets[0], shorter, sizeof(shorter)));
+    EXPECT_FALSE(hostproto::Receive(sockets[1], reply, 100));
+
+    std::vector<char> longer(sizeof(hostproto::HostReply) + 8);
+    ASSERT_TRUE(hostproto::SendRecord(sockets[0], longer.data(), longer.size()));
+    EXPECT_FALSE(hostproto::Receive(sockets[1], reply, 100));
+
+    EXPECT_FALSE(hostproto::Receive(sockets[1], reply, 20));   // Timeout
+
+    close(sockets[0]);
+    EXPECT_FALSE(hostproto::Receive(sockets[1], reply, 100));  // Hang-up
+    close(sockets[1]);
+}
+
+TEST(PluginHostProtocolTest, StringsRoundTripAndTruncate) {
+    AcquisitionConfig cfg;
+    cfg.mode = AcquisitionMode::MODE_CONTINUOUS;
+    cfg.num_frames = 7;
+    cfg.frame_rate = 12.5f;
+    cfg.binning = 2;
+    cfg.session_id = std::string(100, 'x');
+
+    hostproto::HostRequest request;
+    hostproto::EncodeAcquisitionConfig(cfg, request);
+    AcquisitionConfig decoded = hostproto::DecodeAcquisitionConfig(request);
+    EXPECT_EQ(decoded.mode, AcquisitionMode::MODE_CONTINUOUS);
+    EXPECT_EQ(decoded.num_frames, 7);
+    EXPECT_FLOAT_EQ(decoded.frame_rate, 12.5f);
+    EXPECT_EQ(decoded.binning, 2);
+    EXPECT_EQ(decoded.session_id, std::string(63, 'x'));
+
+    DetectorInfo info;
+    info.vendor = "V";
+    info.model = "M";
+    info.pixel_width = 3072;
+    hostproto::HostReply reply;
+    hostproto::EncodeDetectorInfo(info, reply);
+    DetectorInfo info_out = hostproto::DecodeDetectorInfo(reply);
+    EXPECT_EQ(info_out.vendor, "V");
+    EXPECT_EQ(info_out.model, "M");
+    EXPECT_EQ(info_out.pixel_width, 3072);
+}
+
+// =============================================================================
+// OutOfProcessDetector
+// =============================================================================
+
+class OutOfProcessDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+        config_.host_executable = HNVUE_TEST_DETECTOR_HOST;
+        config_.plugin_path = HNVUE_TEST_DETECTOR_PLUGIN;
+        config_.ring_slots = 8;
+        config_.max_frame_bytes = 512 * 512 * 2;
+    }
+
+    std::unique_ptr<OutOfProcessDetector> Launch() {
+        auto detector = std::make_unique<OutOfProcessDetector>(config_);
+        if (!detector->Launch()) {
+            return nullptr;
+        }
+        return detector;
+    }
+
+    static AcquisitionConfig Acquisition(int32_t num_frames, float frame_rate) {
+        AcquisitionConfig cfg;
+        cfg.mode = AcquisitionMode::MODE_CONTINUOUS;
+        cfg.num_frames = num_frames;
+        cfg.frame_rate = frame_rate;
+        cfg.session_id = "OOP-1";
+        return cfg;
+    }
+
+    static bool PatternOk(const uint8_t* pixels, size_t bytes, int64_t sequence) {
+        for (size_t i = 0; i < bytes; i += 1021) {
+            if (pixels[i] != static_cast<uint8_t>(i * 7 + static_cast<size_t>(sequence))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool ProcessGone(pid_t pid) {
+        return kill(pid, 0) != 0 && errno == ESRCH;
+    }
+
+    OutOfProcessDetectorConfig config_;
+};
+
+TEST_F(OutOfProcessDetectorTest, HandshakeProxiesDetectorInfo) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    EXPECT_GT(detector->HostPid(), 0);
+    EXPECT_NE(detector->HostPid(), getpid());
+
+    DetectorInfo info = detector->GetDetectorInfo();
+    EXPECT_EQ(info.vendor, "StandIn");
+    EXPECT_EQ(info.model, "PLUGIN-DET-1");
+    EXPECT_EQ(info.serial_number, "SN-4242");
+    EXPECT_EQ(info.pixel_width, 512);
+    EXPECT_EQ(info.max_bit_depth, 16);
+    EXPECT_EQ(info.firmware_version, "2.1.0");
+}
+
+TEST_F(OutOfProcessDetectorTest, MissingPluginFailsLaunch) {
+    config_.plugin_path = "/nonexistent/libvendor.so";
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Launch(), nullptr);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+    config_.plugin_path = HNVUE_TEST_DETECTOR_PLUGIN;
+    config_.host_executable = "/nonexistent/hnvue-detector-host";
+    EXPECT_EQ(Launch(), nullptr);
+}
+
+TEST_F(OutOfProcessDetectorTest, FramesDeliveredZeroCopyAndAsRawFrame) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+
+    std::mutex mutex;
+    std::vector<int64_t> view_sequences;
+    std::vector<int64_t> frame_sequences;
+    std::vector<int64_t> latencies_ns;
+    std::atomic<bool> content_ok{true};
+
+    detector->RegisterFrameViewCallback([&](const ShmFrameView& view) {
+        if (!PatternOk(view.pixels, view.pixel_bytes, view.header->sequence_number)) {
+            content_ok = false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        view_sequences.push_back(view.header->sequence_number);
+        latencies_ns.push_back(detector->GetStats().last_latency_ns);
+    });
+    detector->RegisterFrameCallback([&](const RawFrame& frame) {
+        if (frame.width != 512 || frame.height != 512 || frame.bit_depth != 16 ||
+            frame.pixel_data.size() != 512u * 512u * 2u || frame.session_id != "OOP-1" ||
+            !PatternOk(frame.pixel_data.data(), frame.pixel_data.size(), frame.sequence_number)) {
+            content_ok = false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        frame_sequences.push_back(frame.sequence_number);
+    });
+
+    ASSERT_TRUE(detector->StartAcquisition(Acquisition(50, 200.0f)));
+    ASSERT_TRUE(WaitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return frame_sequences.size() == 50;
+    }, 10000));
+    EXPECT_TRUE(detector->StopAcquisition());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int64_t i = 0; i < 50; ++i) {
+        EXPECT_EQ(view_sequences[i], i);
+        EXPECT_EQ(frame_sequences[i], i);
+    }
+    EXPECT_TRUE(content_ok);
+
+    auto stats = detector->GetStats();
+    EXPECT_EQ(stats.frames_delivered, 50u);
+    EXPECT_EQ(stats.frames_dropped, 0u);
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    RecordProperty("latency_p50_ns", static_cast<int>(latencies_ns[latencies_ns.size() / 2]));
+    RecordProperty("latency_max_ns", static_cast<int>(stats.max_latency_ns));
+}
+
+TEST_F(OutOfProcessDetectorTest, StatusAndCalibrationProxied) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+
+    CalibrationResult calibration = detector->RunCalibration(CalibType::CALIB_FLAT_FIELD, 4);
+    EXPECT_TRUE(calibration.success);
+    EXPECT_EQ(calibration.output_path, "/cal/standin/2");
+
+    ASSERT_TRUE(detector->StartAcquisition(Acquisition(0, 100.0f)));
+    EXPECT_FALSE(detector->StartAcquisition(Acquisition(0, 100.0f)));
+    EXPECT_FALSE(detector->RunCalibration(CalibType::CALIB_DARK_FIELD, 4).success);
+
+    ASSERT_TRUE(WaitFor([&]() { return detector->GetStatus().frames_acquired >= 3; }, 5000));
+    DetectorStatus status = detector->GetStatus();
+    EXPECT_TRUE(status.is_acquiring);
+    EXPECT_EQ(status.current_session_id, "OOP-1");
+    EXPECT_FLOAT_EQ(status.temperature_c, 31.5f);
+
+    EXPECT_TRUE(detector->StopAcquisition());
+    EXPECT_FALSE(detector->GetStatus().is_acquiring);
+}
+
+TEST_F(OutOfProcessDetectorTest, KilledHostRestartedAndAcquisitionResumed) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    std::atomic<int> frames{0};
+    detector->RegisterFrameViewCallback([&](const ShmFrameView&) { ++frames; });
+
+    ASSERT_TRUE(detector->StartAcquisition(Acquisition(0, 100.0f)));
+    ASSERT_TRUE(WaitFor([&]() { return frames >= 5; }, 5000));
+
+    pid_t first = detector->HostPid();
+    ASSERT_EQ(kill(first, SIGKILL), 0);
+    ASSERT_TRUE(WaitFor([&]() { return detector->GetStats().host_restarts == 1; }, 5000));
+
+    pid_t second = detector->HostPid();
+    EXPECT_GT(second, 0);
+    EXPECT_NE(second, first);
+    EXPECT_TRUE(ProcessGone(first));   // Reaped, not a zombie
+    auto stats = detector->GetStats();
+    EXPECT_LT(stats.last_restart_us, 1000000);
+    RecordProperty("restart_us", static_cast<int>(stats.last_restart_us));
+
+    // Acquisition resumed by the new host
+    int before = frames;
+    ASSERT_TRUE(WaitFor([&]() { return frames >= before + 5; }, 5000));
+    EXPECT_TRUE(detector->GetStatus().is_acquiring);
+    EXPECT_EQ(detector->GetDetectorInfo().vendor, "StandIn");
+    EXPECT_TRUE(detector->StopAcquisition());
+}
+
+TEST_F(OutOfProcessDetectorTest, VendorAbortRestartsHost) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    pid_t first = detector->HostPid();
+
+    CalibrationResult result = detector->RunCalibration(CalibType::CALIB_DARK_FIELD, -1);
+    EXPECT_FALSE(result.success);
+    ASSERT_TRUE(WaitFor([&]() { return detector->GetStats().host_restarts == 1; }, 5000));
+    EXPECT_NE(detector->HostPid(), first);
+
+    // Not acquiring before the crash: nothing resumed, host usable
+    EXPECT_FALSE(detector->GetStatus().is_acquiring);
+    EXPECT_TRUE(detector->RunCalibration(CalibType::CALIB_DARK_FIELD, 2).success);
+}
+
+TEST_F(OutOfProcessDetectorTest, HungVendorCallTimesOutAndHostReplaced) {
+    config_.calibration_timeout_ms = 300;
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    pid_t first = detector->HostPid();
+
+    auto start = std::chrono::steady_clock::now();
+    CalibrationResult result = detector->RunCalibration(CalibType::CALIB_DEFECT_MAP, 4);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error_msg, "Detector host not responding");
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+    ASSERT_TRUE(WaitFor([&]() { return detector->GetStats().host_restarts == 1; }, 5000));
+    EXPECT_NE(detector->HostPid(), first);
+    EXPECT_TRUE(ProcessGone(first));
+    EXPECT_TRUE(detector->RunCalibration(CalibType::CALIB_FLAT_FIELD, 2).success);
+}
+
+TEST_F(OutOfProcessDetectorTest, RestartDisabledLeavesDetectorUnavailable) {
+    config_.restart_on_failure = false;
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    pid_t first = detector->HostPid();
+
+    ASSERT_EQ(kill(first, SIGKILL), 0);
+    ASSERT_TRUE(WaitFor([&]() { return detector->HostPid() == 0; }, 5000));
+    EXPECT_EQ(detector->GetStats().host_restarts, 0u);
+    EXPECT_FALSE(detector->StartAcquisition(Acquisition(1, 10.0f)));
+    EXPECT_TRUE(ProcessGone(first));
+}
+
+TEST_F(OutOfProcessDetectorTest, ShutdownLeavesNoHostProcess) {
+    auto detector = Launch();
+    ASSERT_NE(detector, nullptr);
+    pid_t pid = detector->HostPid();
+    ASSERT_TRUE(detector->StartAcquisition(Acquisition(0, 100.0f)));
+
+    detector->Shutdown();
+    EXPECT_EQ(detector->HostPid(), 0);
+    EXPECT_TRUE(ProcessGone(pid));
+    detector->Shutdown();   // Idempotent
+}
+
+} // anonymous namespace
@@ -0,0 +1,176 @@
+/**
+ * @file BatchProcessor.h
+ * @brief Parallel re-processing of stored raw frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Batch image re-processing
+ * SPDX-License-Identifier: MIT
+ *
+ * Protocol tuning and QC re-run dozens of stored frames against one or more
+ * ProcessingConfigs. An engine instance processes one frame at a time, so
+ * BatchProcessor keeps one engine per worker thread and spreads the
+ * frame x config jobs over all of them. Each worker loads (I/O + decode) and
+ * processes its own jobs, so loading on one core overlaps processing on the
+ * others; a frame used by several configs is loaded once and copied per
+ * config. Calibration handles in the configs are shared by every worker.
+ */
+
+#ifndef HNUE_IMAGING_BATCH_PROCESSOR_H
+#define HNUE_IMAGING_BATCH_PROCESSOR_H
+
+#include "IImageProcessingEngine.h"
+#include "PooledImageBuffer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Thread role name of batch workers (infra::ThreadPolicyRegistry)
+constexpr const char* kThreadBatchWorker = "img.batch";
+
+/**
+ * @brief Loads stored frame frame_index into a pooled buffer
+ *
+ * Typically wraps RawFrameArchiveReader::ReadFrame(), which may be called
+ * concurrently: acquire out with AcquirePooledImageBuffer() for the frame's
+ * dimensions and decode into out.view.data with stride out.view.stride / 2.
+ * Called from worker threads, concurrently for different frames.
+ *
+ * @return false if the frame could not be read
+ */
+using BatchFrameLoader = std::function<bool(size_t frame_index, PooledImageBuffer& out)>;
+
+/**
+ * @brief One processed frame x config job
+ */
+struct BatchResult {
+    size_t frame_index = 0;
+    size_t config_index = 0;
+    bool success = false;
+    EngineError error;              ///< Engine error, or IMAGING_ERR_PARAM if the load failed
+    StageTiming timing;             ///< Engine stage timing of this job
+    int64_t load_us = 0;            ///< Load + decode time of the frame (shared by its configs)
+    int64_t process_us = 0;         ///< ProcessFrame() wall time
+    PooledImageBuffer frame;        ///< Processed frame (empty on failure)
+};
+
+/**
+ * @brief Receives results as jobs complete
+ *
+ * Calls are serialized but come from worker threads in completion order.
+ * The sink may keep result.frame; a slow sink stalls the workers.
+ */
+using BatchResultSink = std::function<void(BatchResult&& result)>;
+
+/**
+ * @brief Totals of one ProcessBatch() call
+ */
+struct BatchStats {
+    uint64_t jobs_total = 0;         ///< frame_count * configs.size()
+    uint64_t jobs_succeeded = 0;
+    uint64_t jobs_failed = 0;
+    uint64_t jobs_cancelled = 0;     ///< Not started because Cancel() was called
+    uint64_t frames_loaded = 0;
+    int64_t wall_us = 0;
+    int64_t load_us = 0;             ///< Sum over workers
+    int64_t process_us = 0;          ///< Sum over workers
+    uint32_t workers = 0;
+
+    /**
+     * @brief Completed jobs per second of wall time
+     */
+    inline double ImagesPerSecond() const {
+        return wall_us > 0
+            ? static_cast<double>(jobs_succeeded + jobs_failed) * 1e6 / static_cast<double>(wall_us)
+            : 0.0;
+    }
+};
+
+/**
+ * @brief Pool of worker threads, each with its own processing engine
+ *
+ * Engines are created and initialised once in Initialize() and reused for
+ * every batch, so a batch pays neither plugin loading nor calibration
+ * binding per job (a worker rebinds only when the handle changes).
+ * Each engine is initialised with num_threads = 1: the batch parallelises
+ * across frames, and nested engine threading would oversubscribe the cores.
+ *
+ * Thread Safety:
+ * - Initialize(), Shutdown() and ProcessBatch() from one controlling thread
+ * - Cancel() from any thread
+ */
+class BatchProcessor {
+public:
+    /// Creates one engine per worker; nullptr on failure
+    using EngineCreator = std::function<std::shared_ptr<IImageProcessingEngine>()>;
+
+    /**
+     * @param creator Engine factory (e.g. EngineFactory::CreateDefault)
+     */
+    explicit BatchProcessor(EngineCreator creator);
+    ~BatchProcessor();
+
+    BatchProcessor(const BatchProcessor&) = delete;
+    BatchProcessor& operator=(const BatchProcessor&) = delete;
+
+    /**
+     * @brief Create and initialise the worker engines
+     * @param config Engine configuration (num_threads is overridden with 1)
+     * @param workers Worker count (0 = hardware concurrency)
+     * @return false if already initialised or any engine failed to create
+     *         or initialise
+     */
+    bool Initialize(const EngineConfig& config, uint32_t workers = 0);
+
+    /**
+     * @brief Shut down and release the worker engines
+     */
+    void Shutdown();
+
+    /**
+     * @brief Process every stored frame with every config
+     * @param frame_count Number of stored frames (indices 0 .. frame_count-1)
+     * @param loader Frame loader
+     * @param configs Processing configurations; job (f, c) processes frame f
+     *        with configs[c]
+     * @param sink Result consumer
+     * @return Totals; jobs_total is 0 if not initialised or arguments are empty
+     *
+     * Blocks until every job has completed or been cancelled. Jobs are
+     * started frame by frame, so at most about one frame per worker is held
+     * in memory beyond what the sink keeps.
+     */
+    BatchStats ProcessBatch(size_t frame_count, const BatchFrameLoader& loader,
+                            const std::vector<ProcessingConfig>& configs,
+                            const BatchResultSink& sink);
+
+    /**
+     * @brief Stop starting new jobs of the running batch
+     *
+     * Jobs already running complete and are delivered.
+     */
+    void Cancel();
+
+    bool IsInitialized() const { return !engines_.empty(); }
+
+    uint32_t WorkerCount() const { return static_cast<uint32_t>(engines_.size()); }
+
+private:
+    struct Batch;
+
+    void WorkerLoop(Batch& batch, IImageProcessingEngine& engine);
+
+    EngineCreator creator_;
+    std::vector<std::shared_ptr<IImageProcessingEngine>> engines_;
+    std::atomic<bool> cancel_{false};
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_BATCH_PROCESSOR_H
@@ -9,17 +9,21 @@
  *
  * Manages calibration data lifecycle including loading from disk,
  * integrity validation, caching, and hot-reload support.
+ *
+ * Loaded calibration is held as immutable handles (CalibrationSet.h); the
+ * CalibrationData/DefectMap returned by the legacy accessors are views into
+ * the current handles.
  */
 
 #ifndef HNUE_IMAGING_CALIBRATION_MANAGER_H
 #define HNUE_IMAGING_CALIBRATION_MANAGER_H
 
+#include "CalibrationSet.h"
 #include "ImagingTypes.h"
 
 #include <string>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 namespace hnvue::imaging {
 
@@ -66,6 +70,10 @@ struct CalibrationStatus {
  *
  * Provides thread-safe loading, validation, and caching of calibration data.
  * Supports hot-reload for updating calibration during operation.
+ *
+ * Each successful load replaces the active CalibrationSet with a new one
+ * sharing the unchanged handles. Pipelines take GetCalibrationSet() once
+ * per acquisition (or per frame) and are unaffected by later reloads.
  */
 class CalibrationManager {
 public:
@@ -94,6 +102,9 @@ public:
      * @brief Load dark frame calibration from file
      * @param path Path to calibration file
      * @return CalibrationData structure, with valid=false on error
+     *
+     * data_f32 is owned by the manager and valid until the dark frame is
+     * reloaded; hold GetCalibrationSet() to keep it longer.
      */
     CalibrationData LoadDarkFrame(const std::string& path);
 
@@ -101,13 +112,17 @@ public:
      * @brief Load gain map calibration from file
      * @param path Path to calibration file
      * @return CalibrationData structure, with valid=false on error
+     *
+     * data_f32 is owned by the manager, as for LoadDarkFrame().
      */
     CalibrationData LoadGainMap(const std::string& path);
 
     /**
      * @brief Load defect pixel map from file
      * @param path Path to calibration file
-     * @return DefectMap structure, with valid=false on error
+     * @return Compiled DefectMap (see DefectPlan), with valid=false on error
+     *
+     * pixels is owned by the manager, as for LoadDarkFrame().
      */
     DefectMap LoadDefectMap(const std::string& path);
 
@@ -134,12 +149,22 @@ public:
      */
     bool HotReload(CalibrationDataType type, const std::string& path);
 
+    /**
+     * @brief Get the active calibration handles
+     * @return Current set (never null; members are null until loaded)
+     *
+     * Thread-safe. The set and everything it references stay valid for as
+     * long as the caller holds it, across any number of reloads.
+     */
+    CalibrationSetHandle GetCalibrationSet() const;
+
     /**
      * @brief Get pointer to cached calibration data
      * @param type Type of calibration
      * @return Const pointer to cached data, or nullptr if not loaded
      *
-     * Thread-safe. Returns pointer to cached calibration data.
+     * Thread-safe. Valid until that calibration is reloaded; frames that
+     * may outlive a reload use GetCalibrationSet() instead.
      */
     const CalibrationData* GetCalibration(CalibrationDataType type) const;
 
@@ -197,6 +222,15 @@ private:
      */
     bool LoadHeader(const std::string& path, CalibrationFileHeader& header);
 
+    /**
+     * @brief Load and verify a dark frame or gain map into a handle
+     * @param path File path
+     * @param type DARK_FRAME or GAIN_MAP
+     * @return Handle, or nullptr on any error
+     */
+    std::shared_ptr<const CalibrationMap> LoadMap(const std::string& path,
+                                                  CalibrationDataType type);
+
     /**
      * @brief Validate calibration header
      * @param header Header to validate
@@ -235,9 +269,8 @@ private:
     uint32_t expected_width_ = 0;
     uint32_t expected_height_ = 0;
 
-    // Cached calibration data
-    std::unordered_map<CalibrationDataType, CalibrationData> calibration_cache_;
-    DefectMap defect_map_;
+    // Active calibration; replaced (never modified) on reload
+    CalibrationSetHandle active_set_;
     ScatterParams scatter_params_;
 };
 
@@ -0,0 +1,218 @@
+/**
+ * @file CalibrationSet.h
+ * @brief Immutable, ref-counted calibration handles
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Calibration data handles
+ * SPDX-License-Identifier: MIT
+ *
+ * CalibrationData and DefectMap are views over caller-owned arrays, so every
+ * stage has to re-check them on every frame and nothing stops the arrays
+ * from being freed or rewritten while a frame is being corrected. The
+ * handles below own their data, are never modified after creation, and
+ * carry everything derived from it (binned variants, the compiled defect
+ * plan). A frame that holds a CalibrationSet keeps exactly that calibration
+ * alive until it is done, whatever is reloaded meanwhile.
+ */
+
+#ifndef HNUE_IMAGING_CALIBRATION_SET_H
+#define HNUE_IMAGING_CALIBRATION_SET_H
+
+#include "ImagingTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Detector binning factors prepared at handle creation
+constexpr std::array<uint32_t, 3> kCalibrationBinnings = {1, 2, 4};
+
+/**
+ * @brief Immutable dark frame or gain map
+ *
+ * Binned variants (2x2, 4x4) are the block means of the full-resolution
+ * coefficients, matching detectors that average binned pixels. A binned
+ * frame is W/b x H/b (integer division), as sized by the HAL.
+ */
+class CalibrationMap {
+public:
+    /**
+     * @brief Create a handle owning coefficients
+     * @param type DARK_FRAME or GAIN_MAP
+     * @param width Full-resolution width in pixels
+     * @param height Full-resolution height in pixels
+     * @param coefficients width * height row-major coefficients (moved in)
+     * @param checksum Checksum of the source data
+     * @param acquisition_time_us Calibration acquisition timestamp
+     * @return Handle, or nullptr if type or size is invalid
+     */
+    static std::shared_ptr<const CalibrationMap> Create(
+        CalibrationDataType type, uint32_t width, uint32_t height,
+        std::vector<float> coefficients, uint64_t checksum = 0,
+        uint64_t acquisition_time_us = 0);
+
+    CalibrationMap(const CalibrationMap&) = delete;
+    CalibrationMap& operator=(const CalibrationMap&) = delete;
+
+    CalibrationDataType Type() const { return type_; }
+    uint32_t Width() const { return levels_[0].view.width; }
+    uint32_t Height() const { return levels_[0].view.height; }
+    uint64_t Checksum() const { return levels_[0].view.checksum; }
+    uint64_t AcquisitionTimeUs() const { return levels_[0].view.acquisition_time_us; }
+
+    /**
+     * @brief Full-resolution view
+     *
+     * data_f32 points into this handle and stays valid for its lifetime.
+     */
+    const CalibrationData& Data() const { return levels_[0].view; }
+
+    /**
+     * @brief View whose geometry matches a frame
+     * @return Full or binned view, or nullptr if no variant matches
+     */
+    const CalibrationData* ForGeometry(uint32_t width, uint32_t height) const;
+
+private:
+    struct Level {
+        std::vector<float> coefficients;
+        CalibrationData view;
+    };
+
+    CalibrationMap(CalibrationDataType type, uint32_t width, uint32_t height,
+                   std::vector<float> coefficients, uint64_t checksum,
+                   uint64_t acquisition_time_us);
+
+    CalibrationDataType type_;
+    std::array<Level, kCalibrationBinnings.size()> levels_;
+};
+
+/**
+ * @brief Immutable defect map compiled for correction
+ *
+ * Compilation drops entries outside the detector, resolves unspecified
+ * interpolation to BILINEAR (the engine default) and sorts entries
+ * row-major without duplicates, so correction walks memory in order.
+ * A binned pixel is defective if any pixel it covers is.
+ */
+class DefectPlan {
+public:
+    /**
+     * @brief Create a compiled plan
+     * @param width Full-resolution detector width
+     * @param height Full-resolution detector height
+     * @param pixels Defect entries in any order (moved in)
+     * @param checksum Checksum of the source data
+     * @return Plan, or nullptr if the geometry is empty
+     */
+    static std::shared_ptr<const DefectPlan> Create(
+        uint32_t width, uint32_t height, std::vector<DefectPixelEntry> pixels,
+        uint64_t checksum = 0);
+
+    /**
+     * @brief Create a plan with additional entries
+     * @param base Compiled plan (unchanged)
+     * @param additions New entries in any order (moved in)
+     * @return Plan with the geometry and checksum of base, or nullptr if
+     *         base is nullptr
+     *
+     * Only the additions are compiled; each variant is then a linear merge
+     * with the already sorted base entries. Where both name a pixel the
+     * base entry is kept. Used to fold newly detected defects into a plan
+     * without recompiling it.
+     */
+    static std::shared_ptr<const DefectPlan> Merge(
+        const std::shared_ptr<const DefectPlan>& base,
+        std::vector<DefectPixelEntry> additions);
+
+    DefectPlan(const DefectPlan&) = delete;
+    DefectPlan& operator=(const DefectPlan&) = delete;
+
+    uint32_t Width() const { return levels_[0].width; }
+    uint32_t Height() const { return levels_[0].height; }
+
+    /**
+     * @brief Full-resolution view
+     *
+     * pixels points into this handle and stays valid for its lifetime.
+     */
+    const DefectMap& Map() const { return levels_[0].view; }
+
+    /**
+     * @brief View whose geometry matches a frame
+     * @return Full or binned view, or nullptr if no variant matches
+     */
+    const DefectMap* ForGeometry(uint32_t width, uint32_t height) const;
+
+private:
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<DefectPixelEntry> pixels;
+        DefectMap view;
+    };
+
+    DefectPlan(uint32_t width, uint32_t height,
+               std::vector<DefectPixelEntry> pixels, uint64_t checksum);
+    DefectPlan(const DefectPlan& base, std::vector<DefectPixelEntry> additions);
+
+    static void BuildView(Level& level, uint64_t checksum);
+
+    std::array<Level, kCalibrationBinnings.size()> levels_;
+};
+
+/**
+ * @brief Calibration views resolved for one frame geometry
+ */
+struct CalibrationBinding {
+    const CalibrationData* dark = nullptr;
+    const CalibrationData* gain = nullptr;
+    const DefectMap* defect_map = nullptr;  ///< nullptr if the set has no defect plan
+};
+
+/**
+ * @brief Dark frame, gain map and defect plan used together
+ *
+ * Replacing one calibration makes a new set sharing the other handles;
+ * sets already handed out are not affected.
+ */
+class CalibrationSet {
+public:
+    CalibrationSet() = default;
+    CalibrationSet(std::shared_ptr<const CalibrationMap> dark,
+                   std::shared_ptr<const CalibrationMap> gain,
+                   std::shared_ptr<const DefectPlan> defects);
+
+    const std::shared_ptr<const CalibrationMap>& Dark() const { return dark_; }
+    const std::shared_ptr<const CalibrationMap>& Gain() const { return gain_; }
+    const std::shared_ptr<const DefectPlan>& Defects() const { return defects_; }
+
+    /**
+     * @brief Resolve and validate the views for a frame geometry
+     * @param width Frame width
+     * @param height Frame height
+     * @param binding Output views
+     * @return false if dark or gain is missing or of the wrong type, the
+     *         parts differ in full-resolution geometry, or none of their
+     *         variants matches width x height
+     *
+     * Everything the engine would otherwise check per stage and per frame;
+     * the result holds for as long as the set is alive.
+     */
+    bool Bind(uint32_t width, uint32_t height, CalibrationBinding& binding) const;
+
+private:
+    std::shared_ptr<const CalibrationMap> dark_;
+    std::shared_ptr<const CalibrationMap> gain_;
+    std::shared_ptr<const DefectPlan> defects_;
+};
+
+using CalibrationSetHandle = std::shared_ptr<const CalibrationSet>;
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_CALIBRATION_SET_H
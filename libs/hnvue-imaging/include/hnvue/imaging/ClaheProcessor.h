@@ -0,0 +1,124 @@
+/**
+ * @file ClaheProcessor.h
+ * @brief Tile-parallel CLAHE for 16-bit frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Local contrast equalisation
+ * SPDX-License-Identifier: MIT
+ *
+ * OpenCV's CLAHE runs single-threaded per call and is not exposed by the
+ * engine. ClaheProcessor runs the three CLAHE passes on a small persistent
+ * worker pool: tile histograms (one task per tile), clipped-CDF lookup
+ * tables (one task per tile) and the bilinear LUT blend (one task per band
+ * of rows). The blend can map its result through a second 65536-entry LUT,
+ * so Window/Level is applied in the same pass instead of another full-frame
+ * read and write.
+ */
+
+#ifndef HNUE_IMAGING_CLAHE_PROCESSOR_H
+#define HNUE_IMAGING_CLAHE_PROCESSOR_H
+
+#include "ImagingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Thread role name of CLAHE workers (infra::ThreadPolicyRegistry)
+constexpr const char* kThreadClaheWorker = "img.clahe";
+
+/// Largest tile count per axis
+constexpr uint32_t kClaheMaxTiles = 64;
+
+/// Rows per blend task
+constexpr uint32_t kClaheRowBlock = 16;
+
+/**
+ * @brief Check a CLAHE configuration against a frame geometry
+ * @return false if a tile count is 0, above kClaheMaxTiles or above the
+ *         frame size, histogram_bits is outside 8..16, or clip_limit is
+ *         not finite
+ */
+bool ValidateClaheConfig(const ClaheConfig& config, uint32_t width, uint32_t height);
+
+/**
+ * @brief CLAHE on 16-bit frames with a persistent worker pool
+ *
+ * Tile histograms are built from the top histogram_bits of each pixel.
+ * The output covers the frame's input range [min, max], so a Window/Level
+ * tuned on the unequalised frame still applies afterwards. Results do not
+ * depend on the thread count.
+ *
+ * Scratch buffers are kept between calls; a frame of the same geometry and
+ * configuration allocates nothing.
+ *
+ * Thread Safety: Apply() from one thread at a time (the processing thread).
+ */
+class ClaheProcessor {
+public:
+    /**
+     * @param threads Worker count including the calling thread
+     *        (0 = hardware concurrency)
+     */
+    explicit ClaheProcessor(uint32_t threads = 0);
+    ~ClaheProcessor();
+
+    ClaheProcessor(const ClaheProcessor&) = delete;
+    ClaheProcessor& operator=(const ClaheProcessor&) = delete;
+
+    /**
+     * @brief Equalise a frame in place
+     * @param data First pixel
+     * @param width Frame width
+     * @param height Frame height
+     * @param stride Row pitch in bytes (>= width * 2)
+     * @param config CLAHE parameters (enabled is not checked)
+     * @param post_lut Optional 65536-entry LUT applied to every result
+     * @return false if the frame or configuration is invalid
+     */
+    bool Apply(uint16_t* data, uint32_t width, uint32_t height, size_t stride,
+               const ClaheConfig& config, const uint16_t* post_lut = nullptr);
+
+    /**
+     * @brief Worker count including the calling thread
+     */
+    uint32_t ThreadCount() const;
+
+private:
+    struct Pool;
+
+    /// Column range sharing the same pair of tile columns
+    struct Segment {
+        uint32_t x_begin = 0;
+        uint32_t x_end = 0;
+        uint32_t tile0 = 0;
+        uint32_t tile1 = 0;
+    };
+
+    /**
+     * @brief Run task(index, worker) for index 0 .. count-1 on the pool
+     *
+     * The calling thread is worker 0. Returns when every task is done.
+     */
+    void Run(size_t count, const std::function<void(size_t, uint32_t)>& task);
+
+    std::unique_ptr<Pool> pool_;
+
+    // Scratch, reused between calls
+    std::vector<uint32_t> histograms_;      ///< Per tile, clipped in place
+    std::vector<uint32_t> sub_histograms_;  ///< Per worker
+    std::vector<uint16_t> tile_min_;
+    std::vector<uint16_t> tile_max_;
+    std::vector<float> luts_;               ///< Per tile, output values
+    std::vector<float> column_weight_;      ///< Weight of the right tile, per column
+    std::vector<Segment> segments_;
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_CLAHE_PROCESSOR_H
@@ -10,12 +10,29 @@
  * This is the reference implementation of the image processing pipeline.
  * It uses OpenCV for image operations and FFTW for frequency-domain scatter
  * correction.
+ *
+ * ProcessFrame() runs either on the 16-bit frame, converting to float and
+ * back inside every stage (WorkingPrecision::UINT16_STAGES), or on an
+ * engine-owned f32 working plane that is filled once by offset correction
+ * and quantised once by Window/Level (WorkingPrecision::FLOAT32_PLANE).
+ * A configured output transform is applied by that same Window/Level pass.
+ * CLAHE runs after flattening on the u16 frame; without an output transform
+ * its final pass also applies Window/Level.
+ *
+ * With ProcessingConfig::defect_detection enabled, raw frames also feed a
+ * DefectDetector; pixels it promotes are corrected after the calibrated
+ * defect map from then on.
  */
 
 #ifndef HNUE_IMAGING_DEFAULT_IMAGE_PROCESSING_ENGINE_H
 #define HNUE_IMAGING_DEFAULT_IMAGE_PROCESSING_ENGINE_H
 
+#include "CalibrationSet.h"
+#include "ClaheProcessor.h"
+#include "DefectDetector.h"
 #include "IImageProcessingEngine.h"
+#include "OutputWriter.h"
+#include "hnvue/infra/FramePool.h"
 
 #include <mutex>
 #include <memory>
@@ -33,7 +50,6 @@ namespace hnvue::imaging {
 namespace internal {
     class OpenCVHelper;
     class FFTWHelper;
-    class CalibrationCache;
 } // namespace internal
 
 /**
@@ -96,6 +112,37 @@ public:
     EngineError GetLastError() const override;
     StageTiming GetLastTiming() const override;
 
+    // =========================================================================
+    // Dynamic Defect Detection
+    // =========================================================================
+
+    /**
+     * @brief Feed a raw dark frame to defect detection
+     * @param frame Unexposed raw frame (not modified)
+     * @param config Detection parameters in config.defect_detection; the
+     *        calibrated defects of config.calibration or config.defect_map
+     *        are excluded
+     * @return false if the engine is not initialized, the frame is invalid,
+     *         or detection is disabled or misconfigured
+     */
+    bool ObserveDarkFrame(const ImageBuffer& frame, const ProcessingConfig& config);
+
+    /**
+     * @brief Defects promoted since the last reset, at the observed geometry
+     * @return Plan, or nullptr if none were promoted
+     *
+     * The plan is immutable; promotions replace it with a merged copy. It
+     * is dropped when frames of another geometry are observed.
+     */
+    std::shared_ptr<const DefectPlan> DynamicDefects() const { return dynamic_defects_; }
+
+    /**
+     * @brief Forget promoted defects and detection statistics
+     *
+     * For use once a new defect calibration includes the promoted pixels.
+     */
+    void ClearDynamicDefects();
+
 private:
     // =========================================================================
     // Internal Helper Methods
@@ -131,6 +178,108 @@ private:
     bool ValidateCalibration(const CalibrationData& calib,
                              const ImageBuffer& frame);
 
+    /**
+     * @brief Bind a calibration set to the frame geometry
+     * @param calibration Set from ProcessingConfig
+     * @param frame Frame about to be processed
+     * @return true if bound_ holds validated views for this set and geometry
+     *
+     * Validates only when the set or the geometry changes, i.e. once per
+     * acquisition; every other frame is a pointer and two size compares.
+     */
+    bool BindCalibration(const CalibrationSetHandle& calibration,
+                         const ImageBuffer& frame);
+
+    /**
+     * @brief Resolve the calibration of a ProcessingConfig for a frame
+     * @param config Handle or raw pointers
+     * @param frame Frame about to be processed
+     * @param binding Output views (defect_map may be null in PREVIEW)
+     * @return true if present, valid and matching the frame
+     */
+    bool ResolveCalibration(const ProcessingConfig& config, const ImageBuffer& frame,
+                            CalibrationBinding& binding);
+
+    /**
+     * @brief Correction kernels without validation (callers validate)
+     */
+    void RunOffsetCorrection(ImageBuffer& frame, const CalibrationData& dark);
+    void RunGainCorrection(ImageBuffer& frame, const CalibrationData& gain);
+    void RunDefectPixelMap(ImageBuffer& frame, const DefectMap& map);
+
+    /**
+     * @brief Update defect detection with a validated raw frame
+     * @param frame Raw frame
+     * @param known Calibrated defects to exclude (may be null)
+     * @param dark_frame true for an unexposed frame
+     * @param config Detection parameters (validated)
+     * @param timing Receives defect_detection_us and defect_detection_bytes
+     *
+     * Promoted pixels are merged into dynamic_defects_.
+     */
+    void ObserveDefects(const ImageBuffer& frame, const DefectMap* known, bool dark_frame,
+                        const DefectDetectionConfig& config, StageTiming& timing);
+
+    /**
+     * @brief Promoted defects to correct in a frame
+     * @return View for the frame geometry, or nullptr if there is none
+     */
+    const DefectMap* DynamicDefectMap(uint32_t width, uint32_t height) const;
+
+    /**
+     * @brief Full or preview pipeline on the f32 working plane
+     * @param frame Frame (validated, engine initialized); receives W/L output
+     * @param config Processing configuration
+     * @return true on success
+     */
+    bool ProcessFramePlane(ImageBuffer& frame, const ProcessingConfig& config);
+
+    /**
+     * @brief Get the working plane for a frame geometry
+     * @return f32 Mat over working_plane_ (rows cache-line aligned), or an
+     *         empty Mat if the plane could not be allocated
+     *
+     * Grows the plane when a frame is larger than any seen so far.
+     */
+    cv::Mat WorkingPlane(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Window/Level fused with config.output into the frame buffer
+     * @param frame Destination; also the source when plane is empty
+     * @param config Window, level and a validated output transform
+     * @param plane f32 working plane (FLOAT32_PLANE) or an empty Mat
+     * @param[out] bytes Modelled memory traffic of the pass
+     * @return false if the window is not positive or scratch allocation failed
+     *
+     * On success frame.width, height and stride describe the output.
+     * From a u16 frame, flips and rotations read from a copy of the crop.
+     */
+    bool WriteOutputFrame(ImageBuffer& frame, const ProcessingConfig& config,
+                          const cv::Mat& plane, uint64_t& bytes);
+
+    /**
+     * @brief Window/Level as a 65536-entry LUT (ApplyWindowLevel() mapping)
+     *
+     * Rebuilt only when window or level change. window must be positive.
+     */
+    const uint16_t* WindowLevelLut(float window, float level);
+
+    /**
+     * @brief CLAHE on the u16 frame, optionally folding in Window/Level
+     * @param frame Frame (u16, unwindowed)
+     * @param config CLAHE parameters (validated), window and level
+     * @param fold_window_level Apply Window/Level in the same pass
+     * @param timing Receives clahe_us and clahe_bytes
+     * @return false if the window is not positive
+     */
+    bool RunClahe(ImageBuffer& frame, const ProcessingConfig& config,
+                  bool fold_window_level, StageTiming& timing);
+
+    /**
+     * @brief Interpolate every defect of a map in a u16 or f32 Mat
+     */
+    void CorrectDefects(cv::Mat& mat, const DefectMap& map);
+
     /**
      * @brief Apply window/level LUT mapping
      * @param pixel Input pixel value
@@ -179,10 +328,32 @@ private:
     mutable std::mutex timing_mutex_;
     StageTiming last_timing_;
 
+    // Calibration validated by BindCalibration() (processing thread only)
+    CalibrationSetHandle bound_set_;
+    uint32_t bound_width_ = 0;
+    uint32_t bound_height_ = 0;
+    CalibrationBinding bound_;
+
+    // f32 working plane (FLOAT32_PLANE), allocated on first use
+    infra::FrameHandle working_plane_;
+
+    // Output transform state (processing thread only)
+    OutputWriter output_writer_;
+    infra::FrameHandle output_source_;     ///< u16 crop copy for flips/rotations
+    std::vector<uint16_t> wl_lut_;         ///< u16 Window/Level LUT
+    float wl_lut_window_ = 0.0f;
+    float wl_lut_level_ = 0.0f;
+
+    // CLAHE workers, created on first use with config_.num_threads
+    std::unique_ptr<ClaheProcessor> clahe_;
+
+    // Dynamic defect detection (processing thread only)
+    DefectDetector defect_detector_;
+    std::shared_ptr<const DefectPlan> dynamic_defects_;
+
     // Internal helpers (PIMPL for ABI stability)
     std::unique_ptr<internal::OpenCVHelper> cv_helper_;
     std::unique_ptr<internal::FFTWHelper> fftw_helper_;
-    std::unique_ptr<internal::CalibrationCache> calib_cache_;
 };
 
 } // namespace hnvue::imaging
@@ -0,0 +1,130 @@
+/**
+ * @file DefectDetector.h
+ * @brief Online detection of defective pixels between calibrations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Dynamic defect pixel detection
+ * SPDX-License-Identifier: MIT
+ *
+ * Pixels that fail after the last defect calibration stay uncorrected until
+ * the next one. DefectDetector keeps one saturating score byte per pixel and
+ * updates it from every observed frame with a streaming outlier test against
+ * the pixel's direct neighbours (see DefectDetectionConfig). A pixel that is
+ * an outlier on most frames reaches the promotion score within a few dozen
+ * frames; noise spikes and edges decay back to zero. Promoted pixels are
+ * handed out as DefectPixelEntry values for DefectPlan::Merge().
+ *
+ * The update is branch-free and processes eight pixels per SSE2 step; only
+ * lanes that reach the promotion score leave the vector path.
+ */
+
+#ifndef HNUE_IMAGING_DEFECT_DETECTOR_H
+#define HNUE_IMAGING_DEFECT_DETECTOR_H
+
+#include "ImagingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Score of promoted and excluded pixels; they are no longer observed
+constexpr uint8_t kDefectScoreLocked = 255;
+
+/// Largest DefectDetectionConfig::promote_score
+constexpr uint8_t kDefectMaxPromoteScore = 250;
+
+/**
+ * @brief Check a defect detection configuration
+ * @return false if a threshold is outside [0, 1) or not finite,
+ *         promote_score is outside 2..kDefectMaxPromoteScore, or
+ *         row_interleave is 0
+ */
+bool ValidateDefectDetectionConfig(const DefectDetectionConfig& config);
+
+/**
+ * @brief Per-pixel streaming outlier statistics for one detector geometry
+ *
+ * Clinical frames update every row_interleave-th row, starting one row
+ * further down on each call, so each row is observed once per
+ * row_interleave frames. Dark frames carry no anatomy: every row is
+ * observed and every neighbourhood counts as flat. The outermost rows and
+ * columns have no complete neighbourhood and are not observed.
+ *
+ * Promoted pixels are classified HOT_PIXEL or DEAD_PIXEL by the sign of
+ * their deviation on the promoting frame and use MEDIAN_3X3 interpolation,
+ * which stays correct when a neighbour fails later.
+ *
+ * Thread Safety: one thread at a time (the processing thread).
+ */
+class DefectDetector {
+public:
+    /**
+     * @brief Update the statistics with a frame
+     * @param data First pixel
+     * @param width Frame width
+     * @param height Frame height
+     * @param stride Row pitch in bytes (>= width * 2)
+     * @param dark_frame true for a dark (unexposed) frame
+     * @param config Detection parameters (enabled is not checked)
+     * @return Number of pixels promoted by this frame
+     *
+     * A frame of a different geometry discards the statistics and pending
+     * promotions first. Invalid frames or configurations are ignored.
+     */
+    uint32_t Observe(const uint16_t* data, uint32_t width, uint32_t height, size_t stride,
+                     bool dark_frame, const DefectDetectionConfig& config);
+
+    /**
+     * @brief Stop observing pixels that are already corrected
+     * @param known Defect map of a width x height frame
+     * @param width Frame width
+     * @param height Frame height
+     *
+     * A different geometry discards the statistics first, as in Observe().
+     */
+    void Exclude(const DefectMap& known, uint32_t width, uint32_t height);
+
+    /**
+     * @brief Move out the pixels promoted since the last call
+     */
+    std::vector<DefectPixelEntry> TakePromoted();
+
+    /**
+     * @brief Discard all statistics
+     */
+    void Reset();
+
+    uint32_t Width() const { return width_; }
+    uint32_t Height() const { return height_; }
+
+    /// Frames observed since the last reset or geometry change
+    uint64_t FramesObserved() const { return frames_; }
+
+    /// Current score of a pixel (0 outside the frame)
+    uint8_t Score(uint32_t x, uint32_t y) const;
+
+private:
+    struct Thresholds;
+
+    void Resize(uint32_t width, uint32_t height);
+    void ObserveRow(const uint16_t* up, const uint16_t* row, const uint16_t* down,
+                    uint32_t y, const Thresholds& t);
+    void UpdatePixel(const uint16_t* up, const uint16_t* row, const uint16_t* down,
+                     uint32_t x, uint32_t y, const Thresholds& t);
+    void Promote(uint32_t x, uint32_t y, uint16_t value, uint16_t median);
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t phase_ = 0;                      ///< First observed row of the next frame
+    uint64_t frames_ = 0;
+    uint32_t promoted_now_ = 0;
+    std::vector<uint8_t> scores_;             ///< Per pixel, row-major
+    std::vector<DefectPixelEntry> promoted_;  ///< Not yet taken
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_DEFECT_DETECTOR_H
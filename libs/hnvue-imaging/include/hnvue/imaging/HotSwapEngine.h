@@ -0,0 +1,153 @@
+/**
+ * @file HotSwapEngine.h
+ * @brief Image processing engine that can be reloaded between frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Engine plugin lifecycle
+ * SPDX-License-Identifier: MIT
+ *
+ * Replacing the engine behind the pipeline's unique_ptr means shutting the
+ * old engine down and initialising the new one with frames waiting.
+ * HotSwapEngine is handed to the pipeline instead; a reload creates and
+ * initialises the new engine on a staging thread, the processing thread
+ * switches to it at the start of its next ProcessFrame(), and the old engine
+ * is shut down and destroyed back on the staging thread.
+ */
+
+#ifndef HNUE_IMAGING_HOT_SWAP_ENGINE_H
+#define HNUE_IMAGING_HOT_SWAP_ENGINE_H
+
+#include "IImageProcessingEngine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace hnvue::imaging {
+
+/**
+ * @brief Reload counters and timings
+ */
+struct EngineSwapStats {
+    uint64_t reloads_completed = 0;
+    uint64_t reloads_failed = 0;     ///< Create/Initialize failed; old engine kept
+    int64_t last_stage_us = 0;       ///< Create + Initialize, off the processing thread
+    int64_t last_swap_ns = 0;        ///< Added to the first frame on the new engine
+    int64_t last_drain_us = 0;       ///< Old engine Shutdown() + destruction
+};
+
+/**
+ * @brief IImageProcessingEngine forwarding to a replaceable engine
+ *
+ * Swap point:
+ * - ProcessFrame() switches to a staged engine before processing, so one
+ *   frame never mixes engines.
+ * - Hosts that drive the individual Apply*() stages call CommitReload()
+ *   between frames instead.
+ *
+ * The staged engine is initialised with the configuration of the last
+ * Initialize() call on this object.
+ *
+ * Thread Safety:
+ * - Same contract as IImageProcessingEngine: processing calls serialized
+ *   by the host
+ * - StageReload(), WaitForReload() and GetSwapStats() from any thread
+ */
+class HotSwapEngine : public IImageProcessingEngine {
+public:
+    /// Creates an engine for staging; nullptr on failure
+    using EngineCreator = std::function<std::shared_ptr<IImageProcessingEngine>()>;
+
+    /**
+     * @param engine Initial engine (non-null)
+     */
+    explicit HotSwapEngine(std::shared_ptr<IImageProcessingEngine> engine);
+    ~HotSwapEngine() override;
+
+    HotSwapEngine(const HotSwapEngine&) = delete;
+    HotSwapEngine& operator=(const HotSwapEngine&) = delete;
+
+    /**
+     * @brief Load an engine plugin and initialise it in the background
+     * @param plugin_path Engine plugin (may be the current path, replaced on disk)
+     * @return false if not initialized or a reload is already pending
+     */
+    bool StageReload(const std::string& plugin_path);
+
+    /**
+     * @brief Create an engine with creator and initialise it in the background
+     * @return false if not initialized or a reload is already pending
+     */
+    bool StageReload(EngineCreator creator);
+
+    /**
+     * @brief Switch to a staged engine now, if one is ready
+     * @return true if the engine was switched
+     *
+     * Processing thread only, between frames.
+     */
+    bool CommitReload();
+
+    /**
+     * @brief Wait until no reload is staging or awaiting its swap
+     * @param timeout_ms Maximum wait
+     * @return true if no reload is pending
+     */
+    bool WaitForReload(uint32_t timeout_ms);
+
+    EngineSwapStats GetSwapStats() const;
+
+    // =========================================================================
+    // IImageProcessingEngine Implementation
+    // =========================================================================
+
+    bool Initialize(const EngineConfig& config) override;
+    void Shutdown() override;
+
+    bool ApplyOffsetCorrection(ImageBuffer& frame, const CalibrationData& dark) override;
+    bool ApplyGainCorrection(ImageBuffer& frame, const CalibrationData& gain) override;
+    bool ApplyDefectPixelMap(ImageBuffer& frame, const DefectMap& map) override;
+    bool ApplyScatterCorrection(ImageBuffer& frame, const ScatterParams& params) override;
+    bool ApplyWindowLevel(ImageBuffer& frame, float window, float level) override;
+    bool ApplyNoiseReduction(ImageBuffer& frame, const NoiseReductionConfig& config) override;
+    bool ApplyFlattening(ImageBuffer& frame, const FlatteningConfig& config) override;
+    bool ProcessFrame(ImageBuffer& frame, const ProcessingConfig& config) override;
+
+    EngineInfo GetEngineInfo() const override;
+    EngineError GetLastError() const override;
+    StageTiming GetLastTiming() const override;
+
+private:
+    void StageLoop(EngineCreator creator, EngineConfig config);
+
+    std::shared_ptr<IImageProcessingEngine> engine_;    ///< Processing thread only
+
+    // Reload handoff, guarded by mutex_
+    mutable std::mutex mutex_;
+    std::condition_variable reload_cv_;
+    bool initialized_ = false;
+    EngineConfig config_;
+    bool reload_pending_ = false;                       ///< Staging or awaiting swap
+    bool stopping_ = false;
+    std::shared_ptr<IImageProcessingEngine> staged_;    ///< Ready, awaiting swap
+    std::shared_ptr<IImageProcessingEngine> retired_;   ///< Swapped out, awaiting drain
+    std::thread stage_thread_;
+
+    std::atomic<bool> staged_ready_{false};             ///< Cheap per-frame check
+
+    std::atomic<uint64_t> reloads_completed_{0};
+    std::atomic<uint64_t> reloads_failed_{0};
+    std::atomic<int64_t> last_stage_us_{0};
+    std::atomic<int64_t> last_swap_ns_{0};
+    std::atomic<int64_t> last_drain_us_{0};
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_HOT_SWAP_ENGINE_H
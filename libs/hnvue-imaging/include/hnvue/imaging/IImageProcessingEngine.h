@@ -261,10 +261,28 @@ public:
      *
      * Loads the DLL and calls the exported CreateImageProcessingEngine function.
      * Returns nullptr if the DLL cannot be loaded or the factory fails.
+     *
+     * The unique_ptr cannot keep the DLL alive, so the DLL stays loaded for
+     * the life of the process; use CreateSharedFromPlugin() for engines that
+     * are replaced at run time.
      */
     static std::unique_ptr<IImageProcessingEngine> CreateFromPlugin(
         const std::string& plugin_path);
 
+    /**
+     * @brief Create an engine from a private image of a plugin DLL
+     * @param plugin_path Path to the engine plugin DLL
+     * @return shared_ptr to the engine, or nullptr on failure
+     *
+     * The DLL is copied to a uniquely named temporary and loaded from there,
+     * so a plugin replaced on disk is picked up even while an engine from
+     * the same path is alive (the loader would otherwise return the mapped
+     * image). The engine is released with DestroyImageProcessingEngine (if
+     * exported), after which the DLL is unloaded. Used by HotSwapEngine.
+     */
+    static std::shared_ptr<IImageProcessingEngine> CreateSharedFromPlugin(
+        const std::string& plugin_path);
+
     /**
      * @brief Create the built-in default engine
      * @return unique_ptr to the default engine
@@ -0,0 +1,174 @@
+/**
+ * @file ImageStitcher.h
+ * @brief Long-length (full-spine, long-leg) stitching of overlapping frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Long-length image composition
+ * SPDX-License-Identifier: MIT
+ *
+ * A long-length exam acquires several frames while the table steps along
+ * the patient. ImageStitcher places each processed frame from the table
+ * and collimator geometry recorded with it, corrects the placement by
+ * phase correlation of the overlaps and writes the composite with
+ * feathered seams.
+ *
+ * Registration is coarse to fine: phase correlation of box-downsampled
+ * overlap strips, then of a full-resolution patch at the predicted shift.
+ * Each adjacent pair is registered independently of the others, so the
+ * pairs run in parallel. The composite is produced row by row from the
+ * source frames; no full-size intermediate image is created.
+ */
+
+#ifndef HNUE_IMAGING_IMAGE_STITCHER_H
+#define HNUE_IMAGING_IMAGE_STITCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Thread role name of stitching workers (infra::ThreadPolicyRegistry)
+constexpr const char* kThreadStitchWorker = "img.stitch";
+
+/// Largest StitchConfig::downsample
+constexpr uint32_t kStitchMaxDownsample = 16;
+
+/**
+ * @brief One processed frame of a long-length acquisition
+ *
+ * Geometry uses the fields of hal::TablePosition and hal::CollimatorPosition
+ * (millimetres); the acquisition layer copies them when the frame is taken.
+ * Frame rows run along the table's longitudinal axis. A larger longitudinal
+ * position places the frame further down the composite.
+ */
+struct StitchFrame {
+    const uint16_t* data = nullptr;  ///< First pixel (display-ready, 16-bit)
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t stride = 0;               ///< Row pitch in bytes (>= width * 2)
+
+    float table_longitudinal_mm = 0.0f;  ///< TablePosition::longitudinal
+    float table_lateral_mm = 0.0f;       ///< TablePosition::lateral
+
+    // CollimatorPosition: field edges in mm from the frame centre.
+    // A non-positive value means the frame edge on that side.
+    float collimator_left_mm = 0.0f;
+    float collimator_right_mm = 0.0f;
+    float collimator_top_mm = 0.0f;
+    float collimator_bottom_mm = 0.0f;
+};
+
+/**
+ * @brief Stitching parameters
+ */
+struct StitchConfig {
+    float pixel_pitch_mm = 0.14f;   ///< Detector pixel pitch at the table plane
+    uint32_t downsample = 4;        ///< Coarse registration decimation (1..16)
+    uint32_t search_radius = 64;    ///< Largest placement correction (pixels)
+    uint32_t feather = 64;          ///< Seam blend length (rows, 0 = hard seam)
+    float min_peak = 0.05f;         ///< Least phase correlation peak (1 = identical)
+    uint32_t threads = 0;           ///< Worker count (0 = hardware concurrency)
+};
+
+/**
+ * @brief Placement of a frame in the composite
+ */
+struct StitchPlacement {
+    int32_t x = 0;                ///< Composite column of frame column 0
+    int32_t y = 0;                ///< Composite row of frame row 0
+    uint32_t first_row = 0;       ///< Collimated rows [first_row, end_row)
+    uint32_t end_row = 0;
+    uint32_t first_column = 0;    ///< Collimated columns [first_column, end_column)
+    uint32_t end_column = 0;
+    int32_t correction_x = 0;     ///< Registration change against the previous frame
+    int32_t correction_y = 0;
+    float peak = 0.0f;            ///< Phase correlation peak with the previous frame
+    bool registered = false;      ///< false: placed from geometry alone
+};
+
+/**
+ * @brief Registers and composes long-length acquisitions
+ *
+ * Plan() keeps pointers to the frame data; the frames must stay alive and
+ * unchanged until the last Compose() call.
+ *
+ * Thread Safety: one thread at a time; Plan() and Compose() use their own
+ * short-lived workers.
+ */
+class ImageStitcher {
+public:
+    /// Receives composite row y (Width() pixels); the row is reused afterwards
+    using RowSink = std::function<void(uint32_t y, const uint16_t* row)>;
+
+    /**
+     * @brief Place and register frames
+     * @param frames Frames in table order (increasing longitudinal position)
+     * @param config Stitching parameters
+     * @return false if a frame is invalid or empty after collimation, the
+     *         frames are not in table order, or the configuration is invalid
+     *
+     * A pair whose overlap is too small or whose correlation peak is below
+     * min_peak keeps its geometric placement.
+     */
+    bool Plan(const std::vector<StitchFrame>& frames, const StitchConfig& config);
+
+    uint32_t Width() const { return width_; }
+    uint32_t Height() const { return height_; }
+    const std::vector<StitchPlacement>& Placements() const { return placements_; }
+
+    /**
+     * @brief Write the composite into a buffer, bands of rows in parallel
+     * @param dst First composite pixel (Width() x Height())
+     * @param stride Row pitch in bytes (>= Width() * 2)
+     * @return false without a plan or for an invalid buffer
+     *
+     * Pixels covered by no frame are 0.
+     */
+    bool Compose(uint16_t* dst, size_t stride) const;
+
+    /**
+     * @brief Stream the composite row by row, top to bottom
+     * @return false without a plan
+     */
+    bool Compose(const RowSink& sink) const;
+
+private:
+    /**
+     * @brief Register frame index + 1 against frame index (nominal placements)
+     */
+    void RegisterPair(size_t index, int32_t& dx, int32_t& dy, float& peak) const;
+
+    /**
+     * @brief Compose one composite row
+     * @param sum Scratch, Width() floats
+     * @param weight Scratch, Width() floats
+     */
+    void ComposeRow(uint32_t y, uint16_t* row, std::vector<float>& sum,
+                    std::vector<float>& weight) const;
+
+    /**
+     * @brief Blend weight of a frame in composite row y (0 outside its rows)
+     */
+    float RowWeight(size_t index, int64_t y) const;
+
+    /**
+     * @brief Run task(index) for index 0 .. count-1 on up to threads_ workers
+     */
+    void Run(size_t count, const std::function<void(size_t)>& task) const;
+
+    std::vector<StitchFrame> frames_;
+    std::vector<StitchPlacement> placements_;
+    std::vector<int64_t> seams_;        ///< Seam row between frame i and i + 1
+    std::vector<int64_t> seam_length_;  ///< Blend rows at that seam
+    StitchConfig config_;
+    uint32_t threads_ = 1;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_IMAGE_STITCHER_H
@@ -17,11 +17,14 @@
 #define HNUE_IMAGING_IMAGING_TYPES_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace hnvue::imaging {
 
+class CalibrationSet;  // CalibrationSet.h
+
 // =============================================================================
 // Error Codes
 // =============================================================================
@@ -33,7 +36,7 @@ enum class ImagingError : int32_t {
     IMAGING_OK = 0,              ///< Success
     IMAGING_ERR_INIT = 1,        ///< Initialization failed
     IMAGING_ERR_PARAM = 2,       ///< Invalid parameter
-    IMAGING_ERR Calibration = 3, ///< Calibration data invalid or missing
+    IMAGING_ERR_CALIBRATION = 3, ///< Calibration data invalid or missing
     IMAGING_ERR_ENGINE = 4,      ///< Engine load or execution error
     IMAGING_ERR_TIMEOUT = 5,     ///< Operation timeout
     IMAGING_ERR_MEMORY = 6,      ///< Memory allocation failure
@@ -119,6 +122,38 @@ enum class ProcessingMode : int32_t {
     PREVIEW = 2         ///< Reduced pipeline for real-time preview
 };
 
+/**
+ * @brief Pixel format carried between pipeline stages
+ */
+enum class WorkingPrecision : int32_t {
+    PRECISION_UNSPECIFIED = 0,
+    UINT16_STAGES = 1,  ///< Every stage reads and writes the 16-bit frame
+    FLOAT32_PLANE = 2   ///< 32-bit float plane from offset to Window/Level output
+};
+
+// =============================================================================
+// Output Transform Types
+// =============================================================================
+
+/**
+ * @brief Clockwise rotation of the display frame
+ */
+enum class OutputRotation : int32_t {
+    ROTATE_0 = 0,
+    ROTATE_90 = 1,    ///< 90 degrees clockwise
+    ROTATE_180 = 2,
+    ROTATE_270 = 3    ///< 90 degrees counter-clockwise
+};
+
+/**
+ * @brief Display shutter shape
+ */
+enum class ShutterShape : int32_t {
+    SHUTTER_NONE = 0,
+    RECTANGULAR = 1,
+    CIRCULAR = 2
+};
+
 // =============================================================================
 // Core Data Structures
 // =============================================================================
@@ -140,7 +175,7 @@ struct ImageBuffer {
     uint8_t pixel_depth = 16;  ///< Fixed at 16-bit grayscale
     uint32_t stride = 0;       ///< Row stride in bytes (>= width * 2)
     uint16_t* data = nullptr;  ///< Pointer to pixel data (row-major)
-    uint64_t timestamp_us = 0; ///< Acquisition timestamp (microseconds since epoch)
+    uint64_t timestamp_us = 0; ///< Acquisition timestamp (microseconds since process epoch, infra::MonotonicClock)
     uint64_t frame_id = 0;     ///< Monotonically increasing sequence number
 };
 
@@ -251,21 +286,122 @@ struct FlatteningConfig {
     FlatteningConfig() = default;
 };
 
+/**
+ * @brief Online detection of pixels failing between calibrations
+ *
+ * Each observed pixel is compared with the median of its four direct
+ * neighbours. It is an outlier if it deviates by more than
+ * relative_threshold * median + absolute_threshold. On clinical frames only
+ * flat neighbourhoods count (the two middle neighbours within
+ * flat_threshold * median + absolute_threshold / 2), so anatomy edges are
+ * not evidence. An outlier adds 2 to the pixel's score and a flat inlier
+ * subtracts 1. At promote_score the pixel becomes a dynamic defect.
+ */
+struct DefectDetectionConfig {
+    bool enabled = false;              ///< If false, no statistics are kept
+    float relative_threshold = 0.25f;  ///< Outlier deviation / neighbour median (0..1)
+    uint16_t absolute_threshold = 200; ///< Outlier deviation floor (counts)
+    float flat_threshold = 0.05f;      ///< Flat neighbourhood spread / median (0..1)
+    uint8_t promote_score = 24;        ///< Score promoting a pixel (2..250)
+    uint32_t row_interleave = 4;       ///< Clinical frames observe 1 row in row_interleave
+
+    /**
+     * @brief Default constructor - detection disabled
+     */
+    DefectDetectionConfig() = default;
+};
+
+/**
+ * @brief Contrast-limited adaptive histogram equalisation (CLAHE)
+ *
+ * Local contrast equalisation for protocols such as extremities and spine.
+ * The frame is split into tiles_x x tiles_y tiles. Each tile histogram is
+ * clipped at clip_limit times its mean bin count, the excess is spread
+ * evenly, and the resulting CDF maps the tile onto the frame's value range.
+ * Mean and spread cover the bins between the tile's minimum and maximum,
+ * since detector data occupies only part of the 16-bit range.
+ * Every pixel blends the mappings of the four nearest tile centres
+ * bilinearly, so tile borders do not show.
+ */
+struct ClaheConfig {
+    bool enabled = false;              ///< If false, CLAHE is skipped
+    uint32_t tiles_x = 8;              ///< Tile columns (1..64, <= frame width)
+    uint32_t tiles_y = 8;              ///< Tile rows (1..64, <= frame height)
+    float clip_limit = 2.0f;           ///< Bin limit / mean bin count (<= 0: unclipped)
+    uint32_t histogram_bits = 12;      ///< 2^bits histogram bins (8..16)
+
+    /**
+     * @brief Default constructor - CLAHE disabled
+     */
+    ClaheConfig() = default;
+};
+
+/**
+ * @brief Geometric transform applied while writing the display frame
+ *
+ * Coordinates are detector pixels of the frame passed to ProcessFrame().
+ * The frame is cropped, then flipped, then rotated; pixels whose centre
+ * lies outside the shutter are written as shutter_value. Unless
+ * IsIdentity(), ProcessFrame() leaves the output tightly packed at the
+ * start of the frame buffer and sets width, height and stride to the
+ * output geometry.
+ */
+struct OutputTransform {
+    uint32_t crop_x = 0;              ///< First column kept
+    uint32_t crop_y = 0;              ///< First row kept
+    uint32_t crop_width = 0;          ///< Columns kept (0 = to the right edge)
+    uint32_t crop_height = 0;         ///< Rows kept (0 = to the bottom edge)
+    bool flip_horizontal = false;     ///< Mirror left-right (before rotation)
+    bool flip_vertical = false;       ///< Mirror top-bottom (before rotation)
+    OutputRotation rotation = OutputRotation::ROTATE_0;
+
+    ShutterShape shutter = ShutterShape::SHUTTER_NONE;
+    uint32_t shutter_left = 0;        ///< RECTANGULAR: first column inside
+    uint32_t shutter_top = 0;         ///< RECTANGULAR: first row inside
+    uint32_t shutter_right = 0;       ///< RECTANGULAR: first column outside
+    uint32_t shutter_bottom = 0;      ///< RECTANGULAR: first row outside
+    float shutter_center_x = 0.0f;    ///< CIRCULAR: centre (pixel edges at integers)
+    float shutter_center_y = 0.0f;
+    float shutter_radius = 0.0f;      ///< CIRCULAR: radius in pixels
+    uint16_t shutter_value = 0;       ///< Output value outside the shutter
+
+    /**
+     * @brief Check whether the transform leaves the frame unchanged
+     */
+    inline bool IsIdentity() const {
+        return crop_x == 0 && crop_y == 0 && crop_width == 0 && crop_height == 0 &&
+               !flip_horizontal && !flip_vertical &&
+               rotation == OutputRotation::ROTATE_0 &&
+               shutter == ShutterShape::SHUTTER_NONE;
+    }
+};
+
 /**
  * @brief Complete processing configuration
  *
  * Aggregates all parameters needed for a full pipeline ProcessFrame call.
+ *
+ * Calibration is given either as a CalibrationSet handle or as the three
+ * raw pointers. With a handle the engine validates it against the frame
+ * geometry once and reuses the result for every frame with the same handle
+ * and geometry; the handle also keeps the calibration alive while the
+ * frame is in flight. The raw pointers are ignored when a handle is set.
  */
 struct ProcessingConfig {
-    const CalibrationData* calibration_dark = nullptr;  ///< Dark frame (required)
-    const CalibrationData* calibration_gain = nullptr;  ///< Gain map (required)
-    const DefectMap* defect_map = nullptr;              ///< Defect map (required)
+    std::shared_ptr<const CalibrationSet> calibration;  ///< Dark, gain and defects (preferred)
+    const CalibrationData* calibration_dark = nullptr;  ///< Dark frame (required without handle)
+    const CalibrationData* calibration_gain = nullptr;  ///< Gain map (required without handle)
+    const DefectMap* defect_map = nullptr;              ///< Defect map (required without handle)
     ScatterParams scatter;                              ///< Scatter correction
     float window = 4000.0f;                             ///< Window width for display LUT
     float level = 2000.0f;                              ///< Window center for display LUT
     NoiseReductionConfig noise_reduction;               ///< Noise reduction
     FlatteningConfig flattening;                        ///< Image flattening
+    ClaheConfig clahe;                                  ///< Local contrast equalisation
+    DefectDetectionConfig defect_detection;             ///< Dynamic defect detection
     ProcessingMode mode = ProcessingMode::FULL_PIPELINE; ///< Processing mode
+    WorkingPrecision precision = WorkingPrecision::UINT16_STAGES; ///< Inter-stage format
+    OutputTransform output;                             ///< Written with Window/Level
     bool preserve_raw = true;                           ///< Must be true (FR-IMG-11)
 
     /**
@@ -288,7 +424,11 @@ enum EngineCapabilityFlags : uint64_t {
     CAP_FLATTENING = 0x0040,           ///< Background normalization
     CAP_PREVIEW_MODE = 0x0080,         ///< Fast preview pipeline
     CAP_GPU_ACCELERATION = 0x0100,     ///< GPU acceleration available
-    CAP_PARALLEL_FRAMES = 0x0200       ///< Parallel frame processing
+    CAP_PARALLEL_FRAMES = 0x0200,      ///< Parallel frame processing
+    CAP_FLOAT_WORKING_PLANE = 0x0400,  ///< WorkingPrecision::FLOAT32_PLANE
+    CAP_OUTPUT_TRANSFORM = 0x0800,     ///< ProcessingConfig::output
+    CAP_CLAHE = 0x1000,                ///< ProcessingConfig::clahe
+    CAP_DYNAMIC_DEFECTS = 0x2000       ///< ProcessingConfig::defect_detection
 };
 
 /**
@@ -354,6 +494,9 @@ enum PipelineStageFlags : uint64_t {
     STAGE_NOISE_REDUCTION = 0x0010,
     STAGE_FLATTENING = 0x0020,
     STAGE_WINDOW_LEVEL = 0x0040,
+    STAGE_OUTPUT_TRANSFORM = 0x0080,
+    STAGE_CLAHE = 0x0100,
+    STAGE_DEFECT_DETECTION = 0x0200,
     STAGE_ALL = 0xFFFF
 };
 
@@ -410,24 +553,53 @@ struct EngineConfig {
  *
  * Provides detailed timing breakdown for each pipeline stage.
  * Used for performance profiling and bottleneck identification.
+ *
+ * The *_bytes fields estimate the memory traffic of each stage: bytes read
+ * plus bytes written by its full-frame passes, including the u16/f32
+ * conversions. Zero for a stage that did not run. The output transform is
+ * part of the Window/Level pass and counted there; with CLAHE and no output
+ * transform, Window/Level is folded into the CLAHE pass and counted there.
  */
 struct StageTiming {
     uint64_t offset_correction_us = 0;
     uint64_t gain_correction_us = 0;
     uint64_t defect_pixel_map_us = 0;
+    uint64_t defect_detection_us = 0;
     uint64_t scatter_correction_us = 0;
     uint64_t noise_reduction_us = 0;
     uint64_t flattening_us = 0;
+    uint64_t clahe_us = 0;
     uint64_t window_level_us = 0;
 
+    uint64_t offset_correction_bytes = 0;
+    uint64_t gain_correction_bytes = 0;
+    uint64_t defect_pixel_map_bytes = 0;
+    uint64_t defect_detection_bytes = 0;
+    uint64_t scatter_correction_bytes = 0;
+    uint64_t noise_reduction_bytes = 0;
+    uint64_t flattening_bytes = 0;
+    uint64_t clahe_bytes = 0;
+    uint64_t window_level_bytes = 0;
+
     /**
      * @brief Get total processing time
      * @return Sum of all stage times
      */
     inline uint64_t Total() const {
         return offset_correction_us + gain_correction_us +
-               defect_pixel_map_us + scatter_correction_us +
-               noise_reduction_us + flattening_us + window_level_us;
+               defect_pixel_map_us + defect_detection_us + scatter_correction_us +
+               noise_reduction_us + flattening_us + clahe_us + window_level_us;
+    }
+
+    /**
+     * @brief Get total memory traffic
+     * @return Sum of all stage byte counts
+     */
+    inline uint64_t TotalBytes() const {
+        return offset_correction_bytes + gain_correction_bytes +
+               defect_pixel_map_bytes + defect_detection_bytes + scatter_correction_bytes +
+               noise_reduction_bytes + flattening_bytes + clahe_bytes +
+               window_level_bytes;
     }
 };
 
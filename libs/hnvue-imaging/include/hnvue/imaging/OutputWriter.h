@@ -0,0 +1,126 @@
+/**
+ * @file OutputWriter.h
+ * @brief Window/Level pass fused with the display output transform
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Display frame output
+ * SPDX-License-Identifier: MIT
+ *
+ * Orientation, cropping to the collimated field and shutter masking used to
+ * be a separate full-frame pass in the GUI, after the whole uncropped frame
+ * had been transferred. OutputWriter applies them while Window/Level writes
+ * the display frame: every output pixel is read once from its source
+ * position, mapped and written once, and pixels outside the crop are never
+ * touched.
+ */
+
+#ifndef HNUE_IMAGING_OUTPUT_WRITER_H
+#define HNUE_IMAGING_OUTPUT_WRITER_H
+
+#include "ImagingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::imaging {
+
+/// Output tile edge (pixels) for rotations that transpose the frame
+constexpr uint32_t kOutputTile = 64;
+
+/**
+ * @brief Compute the output geometry of a transform
+ * @param transform Output transform
+ * @param width Source frame width
+ * @param height Source frame height
+ * @param[out] out_width Output width
+ * @param[out] out_height Output height
+ * @return false if the crop is empty or exceeds the frame, or the shutter
+ *         is malformed (right < left, bottom < top, negative radius)
+ */
+bool ComputeOutputGeometry(const OutputTransform& transform,
+                           uint32_t width, uint32_t height,
+                           uint32_t& out_width, uint32_t& out_height);
+
+/**
+ * @brief Writes a transformed, Window/Level-mapped display frame
+ *
+ * Prepare() resolves the transform for a frame geometry into a source walk
+ * (origin plus one step per output column and per output row) and the
+ * in-shutter span of every output row. Rotations by 90/270 degrees walk the
+ * source down columns; they are written in kOutputTile x kOutputTile tiles
+ * so the source rows of a tile stay cached while its output rows are filled.
+ *
+ * Sources point at the crop origin, i.e. the pixel (crop_x, crop_y).
+ */
+class OutputWriter {
+public:
+    /**
+     * @brief Resolve a transform for a source geometry
+     * @return false if ComputeOutputGeometry() rejects it
+     */
+    bool Prepare(const OutputTransform& transform, uint32_t width, uint32_t height);
+
+    uint32_t OutputWidth() const { return out_width_; }
+    uint32_t OutputHeight() const { return out_height_; }
+    uint32_t CropWidth() const { return transposed_ ? out_height_ : out_width_; }
+    uint32_t CropHeight() const { return transposed_ ? out_width_ : out_height_; }
+
+    /**
+     * @brief Check whether a u16 source may also be the destination
+     *
+     * True without flips and rotation: output rows are then written at or
+     * below the address they are read from.
+     */
+    bool CanWriteInPlace() const { return du_dx_ == 1 && dv_dy_ == 1; }
+
+    /**
+     * @brief Map a 16-bit source through a 65536-entry LUT
+     * @param src Crop origin of the source
+     * @param src_stride Source row pitch in bytes
+     * @param lut Window/Level lookup table
+     * @param dst Destination (OutputWidth() x OutputHeight())
+     * @param dst_stride Destination row pitch in bytes
+     */
+    void WriteU16(const uint16_t* src, size_t src_stride, const uint16_t* lut,
+                  uint16_t* dst, size_t dst_stride) const;
+
+    /**
+     * @brief Map a float source linearly (saturating, round to nearest)
+     * @param src Crop origin of the source
+     * @param src_stride Source row pitch in bytes
+     * @param scale Output = value * scale + offset
+     * @param offset Output offset
+     * @param dst Destination (OutputWidth() x OutputHeight())
+     * @param dst_stride Destination row pitch in bytes
+     */
+    void WriteF32(const float* src, size_t src_stride, float scale, float offset,
+                  uint16_t* dst, size_t dst_stride) const;
+
+private:
+    template <typename T, typename Map>
+    void Write(const T* src, size_t src_stride, uint16_t* dst, size_t dst_stride,
+               Map map) const;
+
+    uint32_t out_width_ = 0;
+    uint32_t out_height_ = 0;
+    bool transposed_ = false;
+
+    // Crop-relative source position (u, v) of output pixel (ox, oy):
+    //   u = origin_u_ + du_dx_ * ox + du_dy_ * oy
+    //   v = origin_v_ + dv_dx_ * ox + dv_dy_ * oy
+    int64_t origin_u_ = 0;
+    int64_t origin_v_ = 0;
+    int32_t du_dx_ = 1;
+    int32_t dv_dx_ = 0;
+    int32_t du_dy_ = 0;
+    int32_t dv_dy_ = 1;
+
+    uint16_t fill_ = 0;
+    std::vector<uint32_t> spans_;    ///< [first, end) inside the shutter, per output row
+};
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_OUTPUT_WRITER_H
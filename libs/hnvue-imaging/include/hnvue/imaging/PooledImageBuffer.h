@@ -0,0 +1,68 @@
+/**
+ * @file PooledImageBuffer.h
+ * @brief ImageBuffer backed by the shared infra frame pool
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Image processing frame memory
+ * SPDX-License-Identifier: MIT
+ *
+ * ImageBuffer is a non-owning view (caller owns data). PooledImageBuffer is
+ * the owning caller: it holds a ref-counted infra::FrameHandle and exposes an
+ * ImageBuffer view over it, so pipeline stages borrow aligned frames from the
+ * same pool as the HAL and IPC layers instead of allocating per frame.
+ */
+
+#ifndef HNUE_IMAGING_POOLED_IMAGE_BUFFER_H
+#define HNUE_IMAGING_POOLED_IMAGE_BUFFER_H
+
+#include "hnvue/imaging/ImagingTypes.h"
+#include "hnvue/infra/FramePool.h"
+
+#include <cstdint>
+
+namespace hnvue::imaging {
+
+/**
+ * @brief Owning 16-bit frame from the frame pool
+ *
+ * Copies share the pixel storage (FrameHandle reference count). The view's
+ * data pointer stays valid as long as any copy is alive.
+ */
+struct PooledImageBuffer {
+    infra::FrameHandle storage;  ///< Pixel storage
+    ImageBuffer view;            ///< View passed to the processing engine
+
+    /// true if storage is allocated
+    explicit operator bool() const { return static_cast<bool>(storage); }
+};
+
+/**
+ * @brief Acquire a pooled 16-bit frame
+ * @param width Frame width in pixels (> 0)
+ * @param height Frame height in pixels (> 0)
+ * @param[out] out Receives storage and view; view.stride is width * 2
+ *             rounded up to infra::kCacheLineSize so every row is aligned
+ * @param pool Frame pool to borrow from
+ * @return true on success, false if dimensions are zero or allocation failed
+ *
+ * Pixel contents are uninitialized.
+ */
+bool AcquirePooledImageBuffer(uint32_t width, uint32_t height,
+                              PooledImageBuffer& out,
+                              infra::FramePool& pool = infra::FramePool::Default());
+
+/**
+ * @brief Acquire a pooled frame and copy pixels from an existing buffer
+ * @param source Frame to copy (stride may differ)
+ * @param[out] out Receives the copy; timestamp and frame_id are preserved
+ * @param pool Frame pool to borrow from
+ * @return true on success, false if source is empty or allocation failed
+ */
+bool ClonePooledImageBuffer(const ImageBuffer& source,
+                            PooledImageBuffer& out,
+                            infra::FramePool& pool = infra::FramePool::Default());
+
+} // namespace hnvue::imaging
+
+#endif // HNUE_IMAGING_POOLED_IMAGE_BUFFER_H
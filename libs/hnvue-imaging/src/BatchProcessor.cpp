@@ -0,0 +1,243 @@
+/**
+ * @file BatchProcessor.cpp
+ * @brief Parallel re-processing of stored raw frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Batch image re-processing
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/BatchProcessor.h"
+#include "hnvue/infra/Clock.h"
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hnvue::imaging {
+
+// =============================================================================
+// Batch State
+// =============================================================================
+
+/**
+ * @brief Shared state of one ProcessBatch() call
+ *
+ * Job j processes frame j / configs.size() with config j % configs.size().
+ * Jobs are claimed in order, so the config-0 job of a frame (which loads it)
+ * is always claimed before the other jobs of that frame that wait for it.
+ */
+struct BatchProcessor::Batch {
+    struct LoadedFrame {
+        bool ok = false;
+        PooledImageBuffer raw;
+        int64_t load_us = 0;
+    };
+
+    struct FrameSlot {
+        bool ready = false;
+        size_t remaining = 0;                   ///< Jobs still to take a copy
+        std::shared_ptr<LoadedFrame> loaded;    ///< Released by the last job
+    };
+
+    Batch(const BatchFrameLoader& l, const std::vector<ProcessingConfig>& c,
+          const BatchResultSink& s, size_t frame_count)
+        : loader(l), configs(c), sink(s), frames(frame_count),
+          jobs_total(frame_count * c.size()) {
+        for (FrameSlot& slot : frames) {
+            slot.remaining = configs.size();
+        }
+    }
+
+    const BatchFrameLoader& loader;
+    const std::vector<ProcessingConfig>& configs;
+    const BatchResultSink& sink;
+
+    // Frame handoff between the loading job and the other jobs of a frame
+    std::mutex frames_mutex;
+    std::condition_variable frames_cv;
+    std::vector<FrameSlot> frames;
+
+    const size_t jobs_total;
+    std::atomic<size_t> next_job{0};
+
+    // Result delivery and totals, guarded by sink_mutex
+    std::mutex sink_mutex;
+    BatchStats stats;
+};
+
+// =============================================================================
+// Construction / Lifecycle
+// =============================================================================
+
+BatchProcessor::BatchProcessor(EngineCreator creator)
+    : creator_(std::move(creator)) {
+}
+
+BatchProcessor::~BatchProcessor() {
+    Shutdown();
+}
+
+bool BatchProcessor::Initialize(const EngineConfig& config, uint32_t workers) {
+    if (!engines_.empty() || !creator_) {
+        return false;
+    }
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    EngineConfig engine_config = config;
+    engine_config.num_threads = 1;
+
+    for (uint32_t i = 0; i < workers; ++i) {
+        std::shared_ptr<IImageProcessingEngine> engine = creator_();
+        if (!engine || !engine->Initialize(engine_config)) {
+            Shutdown();
+            return false;
+        }
+        engines_.push_back(std::move(engine));
+    }
+    return true;
+}
+
+void BatchProcessor::Shutdown() {
+    for (const auto& engine : engines_) {
+        engine->Shutdown();
+    }
+    engines_.clear();
+}
+
+void BatchProcessor::Cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+}
+
+// =============================================================================
+// Batch Execution
+// =============================================================================
+
+BatchStats BatchProcessor::ProcessBatch(size_t frame_count, const BatchFrameLoader& loader,
+                                        const std::vector<ProcessingConfig>& configs,
+                                        const BatchResultSink& sink) {
+    if (engines_.empty() || frame_count == 0 || configs.empty() || !loader || !sink) {
+        return BatchStats{};
+    }
+
+    cancel_.store(false, std::memory_order_relaxed);
+    Batch batch(loader, configs, sink, frame_count);
+    batch.stats.jobs_total = batch.jobs_total;
+
+    const size_t workers = std::min(engines_.size(), batch.jobs_total);
+    batch.stats.workers = static_cast<uint32_t>(workers);
+
+    const int64_t start_us = infra::MonotonicClock::NowUs();
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back([this, &batch, engine = engines_[i].get()]() {
+            infra::ApplyNamedThreadPolicy(kThreadBatchWorker);
+            WorkerLoop(batch, *engine);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    batch.stats.wall_us = infra::MonotonicClock::NowUs() - start_us;
+    batch.stats.jobs_cancelled =
+        batch.jobs_total - std::min(batch.next_job.load(), batch.jobs_total);
+    return batch.stats;
+}
+
+void BatchProcessor::WorkerLoop(Batch& batch, IImageProcessingEngine& engine) {
+    const size_t config_count = batch.configs.size();
+
+    while (!cancel_.load(std::memory_order_relaxed)) {
+        const size_t job = batch.next_job.fetch_add(1);
+        if (job >= batch.jobs_total) {
+            break;
+        }
+
+        BatchResult result;
+        result.frame_index = job / config_count;
+        result.config_index = job % config_count;
+        Batch::FrameSlot& slot = batch.frames[result.frame_index];
+
+        // Load on the first job of the frame, wait for it on the others
+        if (result.config_index == 0) {
+            auto loaded = std::make_shared<Batch::LoadedFrame>();
+            const int64_t load_start_us = infra::MonotonicClock::NowUs();
+            loaded->ok = batch.loader(result.frame_index, loaded->raw) && loaded->raw;
+            loaded->load_us = infra::MonotonicClock::NowUs() - load_start_us;
+            {
+                std::lock_guard<std::mutex> lock(batch.frames_mutex);
+                slot.loaded = std::move(loaded);
+                slot.ready = true;
+            }
+            batch.frames_cv.notify_all();
+        }
+
+        std::shared_ptr<Batch::LoadedFrame> loaded;
+        bool last = false;
+        {
+            std::unique_lock<std::mutex> lock(batch.frames_mutex);
+            batch.frames_cv.wait(lock, [&slot]() { return slot.ready; });
+            loaded = slot.loaded;
+            last = --slot.remaining == 0;
+            if (last) {
+                slot.loaded.reset();
+            }
+        }
+        result.load_us = loaded->load_us;
+
+        // Each config processes its own copy; the last user takes the
+        // loaded buffer itself once no other job still copies from it
+        bool ok = loaded->ok;
+        if (ok) {
+            if (last && loaded.use_count() == 1) {
+                result.frame = std::move(loaded->raw);
+            } else {
+                ok = ClonePooledImageBuffer(loaded->raw.view, result.frame);
+            }
+        }
+        const bool counted_load = result.config_index == 0 && loaded->ok;
+        loaded.reset();
+
+        if (!ok) {
+            result.error.error_code = ImagingError::IMAGING_ERR_PARAM;
+            result.error.error_message = "Stored frame could not be loaded";
+            result.error.failed_stage = "BatchLoad";
+            result.frame = PooledImageBuffer{};
+        } else {
+            const int64_t process_start_us = infra::MonotonicClock::NowUs();
+            result.success = engine.ProcessFrame(result.frame.view,
+                                                 batch.configs[result.config_index]);
+            result.process_us = infra::MonotonicClock::NowUs() - process_start_us;
+            result.timing = engine.GetLastTiming();
+            if (!result.success) {
+                result.error = engine.GetLastError();
+                result.frame = PooledImageBuffer{};
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(batch.sink_mutex);
+        BatchStats& stats = batch.stats;
+        if (result.config_index == 0) {
+            stats.load_us += result.load_us;
+        }
+        if (counted_load) {
+            ++stats.frames_loaded;
+        }
+        stats.process_us += result.process_us;
+        if (result.success) {
+            ++stats.jobs_succeeded;
+        } else {
+            ++stats.jobs_failed;
+        }
+        batch.sink(std::move(result));
+    }
+}
+
+} // namespace hnvue::imaging
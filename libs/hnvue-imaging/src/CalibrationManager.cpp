@@ -39,125 +39,38 @@ void ComputeSHA256(const uint8_t* data, size_t length, uint8_t* hash) {
 namespace hnvue::imaging {
 
 CalibrationManager::CalibrationManager(uint32_t max_age_days)
-    : max_age_days_(max_age_days) {
+    : max_age_days_(max_age_days),
+      active_set_(std::make_shared<const CalibrationSet>()) {
 }
 
 CalibrationManager::~CalibrationManager() = default;
 
 CalibrationData CalibrationManager::LoadDarkFrame(const std::string& path) {
-    CalibrationData result;
-    result.type = CalibrationDataType::DARK_FRAME;
-
-    CalibrationFileHeader header;
-    if (!LoadHeader(path, header)) {
-        return result;
-    }
-
-    if (!ValidateHeader(header, CalibrationDataType::DARK_FRAME)) {
-        return result;
-    }
-
-    // Load payload
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
-        return result;
-    }
-
-    // Skip header
-    file.seekg(sizeof(CalibrationFileHeader));
-
-    // Allocate and read data
-    result.width = header.width;
-    result.height = header.height;
-    result.acquisition_time_us = header.acquisition_time;
-
-    size_t data_size = header.width * header.height * sizeof(float);
-    result.data_f32 = new float[data_size / sizeof(float)];
-
-    std::vector<uint8_t> payload(data_size);
-    file.read(reinterpret_cast<char*>(payload.data()), data_size);
-
-    if (!file) {
-        delete[] result.data_f32;
-        result.data_f32 = nullptr;
-        return result;
-    }
-
-    // Verify checksum
-    if (!VerifyChecksum(payload.data(), data_size, header.checksum)) {
-        delete[] result.data_f32;
-        result.data_f32 = nullptr;
+    auto dark = LoadMap(path, CalibrationDataType::DARK_FRAME);
+    if (!dark) {
+        CalibrationData result;
+        result.type = CalibrationDataType::DARK_FRAME;
         return result;
     }
 
-    // Copy data to output buffer
-    std::memcpy(result.data_f32, payload.data(), data_size);
-
-    result.checksum = header.checksum[0];  // Store first byte as simple checksum
-    result.valid = true;
-
-    // Cache the data
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        calibration_cache_[CalibrationDataType::DARK_FRAME] = result;
-    }
-
-    return result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_set_ = std::make_shared<const CalibrationSet>(
+        dark, active_set_->Gain(), active_set_->Defects());
+    return dark->Data();
 }
 
 CalibrationData CalibrationManager::LoadGainMap(const std::string& path) {
-    CalibrationData result;
-    result.type = CalibrationDataType::GAIN_MAP;
-
-    CalibrationFileHeader header;
-    if (!LoadHeader(path, header)) {
-        return result;
-    }
-
-    if (!ValidateHeader(header, CalibrationDataType::GAIN_MAP)) {
-        return result;
-    }
-
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
-        return result;
-    }
-
-    file.seekg(sizeof(CalibrationFileHeader));
-
-    result.width = header.width;
-    result.height = header.height;
-    result.acquisition_time_us = header.acquisition_time;
-
-    size_t data_size = header.width * header.height * sizeof(float);
-    result.data_f32 = new float[data_size / sizeof(float)];
-
-    std::vector<uint8_t> payload(data_size);
-    file.read(reinterpret_cast<char*>(payload.data()), data_size);
-
-    if (!file) {
-        delete[] result.data_f32;
-        result.data_f32 = nullptr;
-        return result;
-    }
-
-    if (!VerifyChecksum(payload.data(), data_size, header.checksum)) {
-        delete[] result.data_f32;
-        result.data_f32 = nullptr;
+    auto gain = LoadMap(path, CalibrationDataType::GAIN_MAP);
+    if (!gain) {
+        CalibrationData result;
+        result.type = CalibrationDataType::GAIN_MAP;
         return result;
     }
 
-    std::memcpy(result.data_f32, payload.data(), data_size);
-
-    result.checksum = header.checksum[0];
-    result.valid = true;
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        calibration_cache_[CalibrationDataType::GAIN_MAP] = result;
-    }
-
-    return result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_set_ = std::make_shared<const CalibrationSet>(
+        active_set_->Dark(), gain, active_set_->Defects());
+    return gain->Data();
 }
 
 DefectMap CalibrationManager::LoadDefectMap(const std::string& path) {
@@ -186,28 +99,24 @@ DefectMap CalibrationManager::LoadDefectMap(const std::string& path) {
         return result;
     }
 
-    result.count = count;
-    result.pixels = new DefectPixelEntry[count];
-
     // Read defect entries
-    file.read(reinterpret_cast<char*>(result.pixels),
+    std::vector<DefectPixelEntry> pixels(count);
+    file.read(reinterpret_cast<char*>(pixels.data()),
               count * sizeof(DefectPixelEntry));
 
     if (!file) {
-        delete[] result.pixels;
-        result.pixels = nullptr;
-        result.count = 0;
         return result;
     }
 
-    result.valid = true;
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        defect_map_ = result;
+    auto plan = DefectPlan::Create(header.width, header.height, std::move(pixels));
+    if (!plan) {
+        return result;
     }
 
-    return result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_set_ = std::make_shared<const CalibrationSet>(
+        active_set_->Dark(), active_set_->Gain(), plan);
+    return plan->Map();
 }
 
 ScatterParams CalibrationManager::LoadScatterParams(const std::string& path) {
@@ -272,20 +181,28 @@ bool CalibrationManager::HotReload(CalibrationDataType type,
     }
 }
 
+CalibrationSetHandle CalibrationManager::GetCalibrationSet() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_set_;
+}
+
 const CalibrationData* CalibrationManager::GetCalibration(
     CalibrationDataType type) const {
 
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = calibration_cache_.find(type);
-    if (it != calibration_cache_.end()) {
-        return &it->second;
+    switch (type) {
+        case CalibrationDataType::DARK_FRAME:
+            return active_set_->Dark() ? &active_set_->Dark()->Data() : nullptr;
+        case CalibrationDataType::GAIN_MAP:
+            return active_set_->Gain() ? &active_set_->Gain()->Data() : nullptr;
+        default:
+            return nullptr;
     }
-    return nullptr;
 }
 
 const DefectMap* CalibrationManager::GetDefectMap() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return defect_map_.valid ? &defect_map_ : nullptr;
+    return active_set_->Defects() ? &active_set_->Defects()->Map() : nullptr;
 }
 
 const ScatterParams* CalibrationManager::GetScatterParams() const {
@@ -298,22 +215,20 @@ CalibrationStatus CalibrationManager::GetCalibrationStatus() const {
 
     CalibrationStatus status;
 
-    auto dark_it = calibration_cache_.find(CalibrationDataType::DARK_FRAME);
-    if (dark_it != calibration_cache_.end()) {
+    if (const auto& dark = active_set_->Dark()) {
         status.dark_frame_loaded = true;
-        status.dark_frame_valid = dark_it->second.valid;
-        status.dark_frame_timestamp = dark_it->second.acquisition_time_us;
+        status.dark_frame_valid = dark->Data().valid;
+        status.dark_frame_timestamp = dark->AcquisitionTimeUs();
     }
 
-    auto gain_it = calibration_cache_.find(CalibrationDataType::GAIN_MAP);
-    if (gain_it != calibration_cache_.end()) {
+    if (const auto& gain = active_set_->Gain()) {
         status.gain_map_loaded = true;
-        status.gain_map_valid = gain_it->second.valid;
-        status.gain_map_timestamp = gain_it->second.acquisition_time_us;
+        status.gain_map_valid = gain->Data().valid;
+        status.gain_map_timestamp = gain->AcquisitionTimeUs();
     }
 
-    status.defect_map_loaded = defect_map_.valid;
-    status.defect_map_valid = defect_map_.valid;
+    status.defect_map_loaded = active_set_->Defects() != nullptr;
+    status.defect_map_valid = status.defect_map_loaded;
     status.defect_map_timestamp = 0;  // Not stored in DefectMap
 
     status.scatter_params_loaded = true;
@@ -342,6 +257,45 @@ bool CalibrationManager::LoadHeader(const std::string& path,
     return file.good();
 }
 
+std::shared_ptr<const CalibrationMap> CalibrationManager::LoadMap(
+    const std::string& path, CalibrationDataType type) {
+
+    CalibrationFileHeader header;
+    if (!LoadHeader(path, header)) {
+        return nullptr;
+    }
+
+    if (!ValidateHeader(header, type)) {
+        return nullptr;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return nullptr;
+    }
+
+    // Skip header
+    file.seekg(sizeof(CalibrationFileHeader));
+
+    size_t count = static_cast<size_t>(header.width) * header.height;
+    std::vector<float> coefficients(count);
+    file.read(reinterpret_cast<char*>(coefficients.data()), count * sizeof(float));
+    if (!file) {
+        return nullptr;
+    }
+
+    // Verify checksum
+    if (!VerifyChecksum(reinterpret_cast<const uint8_t*>(coefficients.data()),
+                        count * sizeof(float), header.checksum)) {
+        return nullptr;
+    }
+
+    // Store first byte as simple checksum
+    return CalibrationMap::Create(type, header.width, header.height,
+                                  std::move(coefficients), header.checksum[0],
+                                  header.acquisition_time);
+}
+
 bool CalibrationManager::ValidateHeader(
     const CalibrationFileHeader& header,
     CalibrationDataType expected_type) {
@@ -0,0 +1,254 @@
+/**
+ * @file CalibrationSet.cpp
+ * @brief Implementation of immutable calibration handles
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Calibration data handles implementation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/CalibrationSet.h"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace hnvue::imaging {
+
+namespace {
+
+bool Before(const DefectPixelEntry& a, const DefectPixelEntry& b) {
+    return std::tie(a.y, a.x) < std::tie(b.y, b.x);
+}
+
+bool SamePixel(const DefectPixelEntry& a, const DefectPixelEntry& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+/**
+ * @brief Drop out-of-bounds entries, default interpolation, sort and dedupe
+ */
+void CompileDefects(std::vector<DefectPixelEntry>& pixels,
+                    uint32_t width, uint32_t height) {
+    pixels.erase(std::remove_if(pixels.begin(), pixels.end(),
+                                [&](const DefectPixelEntry& p) {
+                                    return p.x >= width || p.y >= height;
+                                }),
+                 pixels.end());
+    for (DefectPixelEntry& p : pixels) {
+        if (p.interpolation == InterpolationMethod::INTERP_UNSPECIFIED) {
+            p.interpolation = InterpolationMethod::BILINEAR;
+        }
+    }
+    std::stable_sort(pixels.begin(), pixels.end(), Before);
+    pixels.erase(std::unique(pixels.begin(), pixels.end(), SamePixel), pixels.end());
+    pixels.shrink_to_fit();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// CalibrationMap
+// =============================================================================
+
+std::shared_ptr<const CalibrationMap> CalibrationMap::Create(
+    CalibrationDataType type, uint32_t width, uint32_t height,
+    std::vector<float> coefficients, uint64_t checksum,
+    uint64_t acquisition_time_us) {
+
+    if (type != CalibrationDataType::DARK_FRAME &&
+        type != CalibrationDataType::GAIN_MAP) {
+        return nullptr;
+    }
+    if (width == 0 || height == 0 ||
+        coefficients.size() != static_cast<size_t>(width) * height) {
+        return nullptr;
+    }
+    return std::shared_ptr<const CalibrationMap>(new CalibrationMap(
+        type, width, height, std::move(coefficients), checksum, acquisition_time_us));
+}
+
+CalibrationMap::CalibrationMap(CalibrationDataType type, uint32_t width, uint32_t height,
+                               std::vector<float> coefficients, uint64_t checksum,
+                               uint64_t acquisition_time_us)
+    : type_(type) {
+    levels_[0].coefficients = std::move(coefficients);
+
+    for (size_t i = 1; i < levels_.size(); ++i) {
+        const uint32_t b = kCalibrationBinnings[i];
+        const uint32_t bw = width / b;
+        const uint32_t bh = height / b;
+        if (bw == 0 || bh == 0) {
+            continue;
+        }
+        const std::vector<float>& full = levels_[0].coefficients;
+        std::vector<float>& binned = levels_[i].coefficients;
+        binned.assign(static_cast<size_t>(bw) * bh, 0.0f);
+        const float scale = 1.0f / static_cast<float>(b * b);
+        for (uint32_t y = 0; y < bh * b; ++y) {
+            const float* src = full.data() + static_cast<size_t>(y) * width;
+            float* dst = binned.data() + static_cast<size_t>(y / b) * bw;
+            for (uint32_t x = 0; x < bw * b; ++x) {
+                dst[x / b] += src[x] * scale;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        Level& level = levels_[i];
+        const uint32_t b = kCalibrationBinnings[i];
+        level.view.type = type;
+        level.view.width = width / b;
+        level.view.height = height / b;
+        level.view.data_f32 = level.coefficients.empty() ? nullptr : level.coefficients.data();
+        level.view.checksum = checksum;
+        level.view.acquisition_time_us = acquisition_time_us;
+        level.view.valid = level.view.data_f32 != nullptr;
+    }
+}
+
+const CalibrationData* CalibrationMap::ForGeometry(uint32_t width, uint32_t height) const {
+    for (const Level& level : levels_) {
+        if (level.view.valid && level.view.width == width && level.view.height == height) {
+            return &level.view;
+        }
+    }
+    return nullptr;
+}
+
+// =============================================================================
+// DefectPlan
+// =============================================================================
+
+std::shared_ptr<const DefectPlan> DefectPlan::Create(
+    uint32_t width, uint32_t height, std::vector<DefectPixelEntry> pixels,
+    uint64_t checksum) {
+
+    if (width == 0 || height == 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<const DefectPlan>(
+        new DefectPlan(width, height, std::move(pixels), checksum));
+}
+
+DefectPlan::DefectPlan(uint32_t width, uint32_t height,
+                       std::vector<DefectPixelEntry> pixels, uint64_t checksum) {
+    CompileDefects(pixels, width, height);
+    levels_[0].pixels = std::move(pixels);
+
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        Level& level = levels_[i];
+        const uint32_t b = kCalibrationBinnings[i];
+        level.width = width / b;
+        level.height = height / b;
+        if (i > 0) {
+            level.pixels.reserve(levels_[0].pixels.size());
+            for (DefectPixelEntry p : levels_[0].pixels) {
+                p.x /= b;
+                p.y /= b;
+                level.pixels.push_back(p);
+            }
+            // Row-major order survives the division; only duplicates remain
+            CompileDefects(level.pixels, level.width, level.height);
+        }
+        BuildView(level, checksum);
+    }
+}
+
+std::shared_ptr<const DefectPlan> DefectPlan::Merge(
+    const std::shared_ptr<const DefectPlan>& base,
+    std::vector<DefectPixelEntry> additions) {
+
+    if (!base) {
+        return nullptr;
+    }
+    return std::shared_ptr<const DefectPlan>(new DefectPlan(*base, std::move(additions)));
+}
+
+DefectPlan::DefectPlan(const DefectPlan& base, std::vector<DefectPixelEntry> additions) {
+    CompileDefects(additions, base.Width(), base.Height());
+
+    std::vector<DefectPixelEntry> scaled;
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        Level& level = levels_[i];
+        const Level& from = base.levels_[i];
+        const uint32_t b = kCalibrationBinnings[i];
+        level.width = from.width;
+        level.height = from.height;
+
+        scaled.clear();
+        for (DefectPixelEntry p : additions) {
+            p.x /= b;
+            p.y /= b;
+            scaled.push_back(p);
+        }
+        CompileDefects(scaled, level.width, level.height);
+
+        // Both ranges are sorted; std::merge puts base entries first on ties
+        level.pixels.reserve(from.pixels.size() + scaled.size());
+        std::merge(from.pixels.begin(), from.pixels.end(), scaled.begin(), scaled.end(),
+                   std::back_inserter(level.pixels), Before);
+        level.pixels.erase(std::unique(level.pixels.begin(), level.pixels.end(), SamePixel),
+                           level.pixels.end());
+        BuildView(level, from.view.checksum);
+    }
+}
+
+void DefectPlan::BuildView(Level& level, uint64_t checksum) {
+    level.view.count = static_cast<uint32_t>(level.pixels.size());
+    level.view.pixels = level.pixels.empty() ? nullptr : level.pixels.data();
+    level.view.checksum = checksum;
+    level.view.valid = level.width > 0 && level.height > 0;
+}
+
+const DefectMap* DefectPlan::ForGeometry(uint32_t width, uint32_t height) const {
+    for (const Level& level : levels_) {
+        if (level.view.valid && level.width == width && level.height == height) {
+            return &level.view;
+        }
+    }
+    return nullptr;
+}
+
+// =============================================================================
+// CalibrationSet
+// =============================================================================
+
+CalibrationSet::CalibrationSet(std::shared_ptr<const CalibrationMap> dark,
+                               std::shared_ptr<const CalibrationMap> gain,
+                               std::shared_ptr<const DefectPlan> defects)
+    : dark_(std::move(dark)), gain_(std::move(gain)), defects_(std::move(defects)) {
+}
+
+bool CalibrationSet::Bind(uint32_t width, uint32_t height,
+                          CalibrationBinding& binding) const {
+    CalibrationBinding result;
+
+    if (!dark_ || dark_->Type() != CalibrationDataType::DARK_FRAME ||
+        !gain_ || gain_->Type() != CalibrationDataType::GAIN_MAP) {
+        return false;
+    }
+    // All parts must come from the same detector geometry
+    if (gain_->Width() != dark_->Width() || gain_->Height() != dark_->Height() ||
+        (defects_ && (defects_->Width() != dark_->Width() ||
+                      defects_->Height() != dark_->Height()))) {
+        return false;
+    }
+    result.dark = dark_->ForGeometry(width, height);
+    result.gain = gain_->ForGeometry(width, height);
+    if (result.dark == nullptr || result.gain == nullptr) {
+        return false;
+    }
+    if (defects_) {
+        result.defect_map = defects_->ForGeometry(width, height);
+        if (result.defect_map == nullptr) {
+            return false;
+        }
+    }
+
+    binding = result;
+    return true;
+}
+
+} // namespace hnvue::imaging
@@ -0,0 +1,423 @@
+/**
+ * @file ClaheProcessor.cpp
+ * @brief Tile-parallel CLAHE for 16-bit frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Local contrast equalisation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/ClaheProcessor.h"
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HNVUE_CLAHE_HAS_SSE2 1
+#else
+    #define HNVUE_CLAHE_HAS_SSE2 0
+#endif
+
+namespace hnvue::imaging {
+
+namespace {
+
+/// Interleaved sub-histograms per tile; consecutive equal pixels then hit
+/// different counters instead of stalling on one store
+constexpr uint32_t kSubHistograms = 4;
+
+/// Largest bin count that uses sub-histograms (4 x 16 KiB stays in L2)
+constexpr uint32_t kSubHistogramMaxBins = 4096;
+
+constexpr uint32_t kMinHistogramBits = 8;
+constexpr uint32_t kMaxHistogramBits = 16;
+
+/**
+ * @brief First pixel of tile index along an axis of size length
+ */
+inline uint32_t TileStart(uint32_t index, uint32_t tiles, uint32_t length) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(index) * length / tiles);
+}
+
+/**
+ * @brief Tile centres along an axis, in pixel-edge coordinates
+ */
+void TileCentres(uint32_t tiles, uint32_t length, std::vector<float>& centres) {
+    centres.resize(tiles);
+    for (uint32_t i = 0; i < tiles; ++i) {
+        centres[i] = 0.5f * static_cast<float>(TileStart(i, tiles, length) +
+                                               TileStart(i + 1, tiles, length));
+    }
+}
+
+/**
+ * @brief Neighbouring tiles of pixel centre position and weight of the second
+ *
+ * Before the first and after the last centre both tiles are the same.
+ */
+void Neighbours(const std::vector<float>& centres, float position,
+                uint32_t& tile0, uint32_t& tile1, float& weight) {
+    const uint32_t last = static_cast<uint32_t>(centres.size()) - 1;
+    if (position <= centres[0]) {
+        tile0 = tile1 = 0;
+        weight = 0.0f;
+        return;
+    }
+    if (position >= centres[last]) {
+        tile0 = tile1 = last;
+        weight = 0.0f;
+        return;
+    }
+    uint32_t i = static_cast<uint32_t>(
+        std::upper_bound(centres.begin(), centres.end(), position) - centres.begin()) - 1;
+    tile0 = i;
+    tile1 = i + 1;
+    weight = (position - centres[i]) / (centres[i + 1] - centres[i]);
+}
+
+inline uint16_t Quantise(float value, const uint16_t* post_lut) {
+    const uint16_t out = static_cast<uint16_t>(value + 0.5f);
+    return post_lut != nullptr ? post_lut[out] : out;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+bool ValidateClaheConfig(const ClaheConfig& config, uint32_t width, uint32_t height) {
+    return width > 0 && height > 0 &&
+           config.tiles_x > 0 && config.tiles_x <= kClaheMaxTiles && config.tiles_x <= width &&
+           config.tiles_y > 0 && config.tiles_y <= kClaheMaxTiles && config.tiles_y <= height &&
+           config.histogram_bits >= kMinHistogramBits &&
+           config.histogram_bits <= kMaxHistogramBits &&
+           std::isfinite(config.clip_limit);
+}
+
+// =============================================================================
+// Worker Pool
+// =============================================================================
+
+/**
+ * @brief Persistent workers; the thread calling Run() takes part as worker 0
+ */
+struct ClaheProcessor::Pool {
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    bool stop = false;
+    uint32_t running = 0;                   ///< Workers still in the current job
+
+    const std::function<void(size_t, uint32_t)>* task = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+
+    std::vector<std::thread> threads;
+
+    void Drain(const std::function<void(size_t, uint32_t)>& job, size_t job_count,
+               uint32_t worker) {
+        for (size_t index = next.fetch_add(1); index < job_count; index = next.fetch_add(1)) {
+            job(index, worker);
+        }
+    }
+
+    void WorkerLoop(uint32_t worker) {
+        infra::ApplyNamedThreadPolicy(kThreadClaheWorker);
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t, uint32_t)>* job = nullptr;
+            size_t job_count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_cv.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+                job = task;
+                job_count = count;
+            }
+            Drain(*job, job_count, worker);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+};
+
+ClaheProcessor::ClaheProcessor(uint32_t threads)
+    : pool_(std::make_unique<Pool>()) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (uint32_t worker = 1; worker < threads; ++worker) {
+        pool_->threads.emplace_back(&Pool::WorkerLoop, pool_.get(), worker);
+    }
+}
+
+ClaheProcessor::~ClaheProcessor() {
+    {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        pool_->stop = true;
+    }
+    pool_->start_cv.notify_all();
+    for (std::thread& thread : pool_->threads) {
+        thread.join();
+    }
+}
+
+uint32_t ClaheProcessor::ThreadCount() const {
+    return static_cast<uint32_t>(pool_->threads.size()) + 1;
+}
+
+void ClaheProcessor::Run(size_t count, const std::function<void(size_t, uint32_t)>& task) {
+    Pool& pool = *pool_;
+    if (pool.threads.empty() || count <= 1) {
+        for (size_t index = 0; index < count; ++index) {
+            task(index, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.task = &task;
+        pool.count = count;
+        pool.next.store(0);
+        pool.running = static_cast<uint32_t>(pool.threads.size());
+        ++pool.generation;
+    }
+    pool.start_cv.notify_all();
+    pool.Drain(task, count, 0);
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.done_cv.wait(lock, [&pool]() { return pool.running == 0; });
+    pool.task = nullptr;
+}
+
+// =============================================================================
+// CLAHE
+// =============================================================================
+
+bool ClaheProcessor::Apply(uint16_t* data, uint32_t width, uint32_t height, size_t stride,
+                           const ClaheConfig& config, const uint16_t* post_lut) {
+    if (data == nullptr || stride < static_cast<size_t>(width) * sizeof(uint16_t) ||
+        !ValidateClaheConfig(config, width, height)) {
+        return false;
+    }
+
+    const uint32_t tiles_x = config.tiles_x;
+    const uint32_t tiles_y = config.tiles_y;
+    const uint32_t tiles = tiles_x * tiles_y;
+    const uint32_t bins = 1u << config.histogram_bits;
+    const uint32_t shift = 16 - config.histogram_bits;
+    const uint32_t sub_count = bins <= kSubHistogramMaxBins ? kSubHistograms : 1;
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(data);
+
+    histograms_.resize(static_cast<size_t>(tiles) * bins);
+    sub_histograms_.resize(static_cast<size_t>(ThreadCount()) * sub_count * bins);
+    tile_min_.resize(tiles);
+    tile_max_.resize(tiles);
+    luts_.resize(static_cast<size_t>(tiles) * bins);
+
+    // Pass 1: tile histograms and value range
+    Run(tiles, [&](size_t tile, uint32_t worker) {
+        const uint32_t tx = static_cast<uint32_t>(tile % tiles_x);
+        const uint32_t ty = static_cast<uint32_t>(tile / tiles_x);
+        const uint32_t x0 = TileStart(tx, tiles_x, width);
+        const uint32_t x1 = TileStart(tx + 1, tiles_x, width);
+        const uint32_t y0 = TileStart(ty, tiles_y, height);
+        const uint32_t y1 = TileStart(ty + 1, tiles_y, height);
+
+        uint32_t* sub = sub_histograms_.data() + static_cast<size_t>(worker) * sub_count * bins;
+        std::fill(sub, sub + static_cast<size_t>(sub_count) * bins, 0u);
+        uint16_t lo = 0xFFFF;
+        uint16_t hi = 0;
+
+        for (uint32_t y = y0; y < y1; ++y) {
+            const uint16_t* row = reinterpret_cast<const uint16_t*>(base + y * stride);
+            uint32_t x = x0;
+#if HNVUE_CLAHE_HAS_SSE2
+            // Biased signed min/max (SSE2 has no unsigned 16-bit min/max)
+            const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+            __m128i vmin = _mm_set1_epi16(0x7FFF);
+            __m128i vmax = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+            const __m128i bin_shift = _mm_cvtsi32_si128(static_cast<int>(shift));
+            alignas(16) uint16_t index[8];
+            for (; x + 8 <= x1; x += 8) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+                const __m128i biased = _mm_xor_si128(v, bias);
+                vmin = _mm_min_epi16(vmin, biased);
+                vmax = _mm_max_epi16(vmax, biased);
+                _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_srl_epi16(v, bin_shift));
+                for (uint32_t i = 0; i < 8; ++i) {
+                    ++sub[(i % sub_count) * bins + index[i]];
+                }
+            }
+            alignas(16) uint16_t lanes_min[8];
+            alignas(16) uint16_t lanes_max[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes_min), _mm_xor_si128(vmin, bias));
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes_max), _mm_xor_si128(vmax, bias));
+            if (x > x0) {
+                lo = std::min(lo, *std::min_element(lanes_min, lanes_min + 8));
+                hi = std::max(hi, *std::max_element(lanes_max, lanes_max + 8));
+            }
+#endif
+            for (; x < x1; ++x) {
+                const uint16_t v = row[x];
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+                ++sub[(x % sub_count) * bins + (v >> shift)];
+            }
+        }
+
+        uint32_t* histogram = histograms_.data() + tile * bins;
+        std::copy(sub, sub + bins, histogram);
+        for (uint32_t s = 1; s < sub_count; ++s) {
+            const uint32_t* other = sub + static_cast<size_t>(s) * bins;
+            for (uint32_t b = 0; b < bins; ++b) {
+                histogram[b] += other[b];
+            }
+        }
+        tile_min_[tile] = lo;
+        tile_max_[tile] = hi;
+    });
+
+    const float out_min = *std::min_element(tile_min_.begin(), tile_min_.end());
+    const float out_max = *std::max_element(tile_max_.begin(), tile_max_.end());
+
+    // Pass 2: clip each histogram, spread the excess, CDF -> output LUT
+    Run(tiles, [&](size_t tile, uint32_t) {
+        const uint32_t tx = static_cast<uint32_t>(tile % tiles_x);
+        const uint32_t ty = static_cast<uint32_t>(tile / tiles_x);
+        const uint64_t pixels =
+            static_cast<uint64_t>(TileStart(tx + 1, tiles_x, width) - TileStart(tx, tiles_x, width)) *
+            (TileStart(ty + 1, tiles_y, height) - TileStart(ty, tiles_y, height));
+        uint32_t* histogram = histograms_.data() + tile * bins;
+
+        // Detector data fills a small part of the 16-bit range: the mean bin
+        // count and the redistribution cover the tile's occupied bins only
+        const uint32_t first_bin = tile_min_[tile] >> shift;
+        const uint32_t end_bin = (tile_max_[tile] >> shift) + 1;
+        const uint32_t used_bins = end_bin - first_bin;
+
+        if (config.clip_limit > 0.0f) {
+            const uint32_t limit = std::max<uint32_t>(
+                1, static_cast<uint32_t>(config.clip_limit * static_cast<float>(pixels) / used_bins));
+            uint64_t excess = 0;
+            for (uint32_t b = first_bin; b < end_bin; ++b) {
+                if (histogram[b] > limit) {
+                    excess += histogram[b] - limit;
+                    histogram[b] = limit;
+                }
+            }
+            const uint32_t spread = static_cast<uint32_t>(excess / used_bins);
+            uint32_t residual = static_cast<uint32_t>(excess % used_bins);
+            for (uint32_t b = first_bin; b < end_bin; ++b) {
+                histogram[b] += spread;
+            }
+            if (residual > 0) {
+                const uint32_t step = std::max(1u, used_bins / residual);
+                for (uint32_t b = first_bin; b < end_bin && residual > 0; b += step, --residual) {
+                    ++histogram[b];
+                }
+            }
+        }
+
+        float* lut = luts_.data() + tile * bins;
+        const float scale = (out_max - out_min) / static_cast<float>(pixels);
+        uint64_t cdf = 0;
+        for (uint32_t b = 0; b < bins; ++b) {
+            cdf += histogram[b];
+            lut[b] = out_min + static_cast<float>(cdf) * scale;
+        }
+    });
+
+    // Column -> tile pair and weight, grouped into runs of equal tile pairs
+    std::vector<float> centres_x;
+    std::vector<float> centres_y;
+    TileCentres(tiles_x, width, centres_x);
+    TileCentres(tiles_y, height, centres_y);
+    column_weight_.resize(width);
+    segments_.clear();
+    for (uint32_t x = 0; x < width; ++x) {
+        uint32_t tile0 = 0;
+        uint32_t tile1 = 0;
+        Neighbours(centres_x, static_cast<float>(x) + 0.5f, tile0, tile1, column_weight_[x]);
+        if (segments_.empty() || segments_.back().tile0 != tile0 ||
+            segments_.back().tile1 != tile1) {
+            segments_.push_back(Segment{x, x, tile0, tile1});
+        }
+        segments_.back().x_end = x + 1;
+    }
+
+    // Pass 3: blend the four nearest tile LUTs per pixel, in place
+    const uint32_t blocks = (height + kClaheRowBlock - 1) / kClaheRowBlock;
+    Run(blocks, [&](size_t block, uint32_t) {
+        const uint32_t y_begin = static_cast<uint32_t>(block) * kClaheRowBlock;
+        const uint32_t y_end = std::min(height, y_begin + kClaheRowBlock);
+        for (uint32_t y = y_begin; y < y_end; ++y) {
+            uint32_t ty0 = 0;
+            uint32_t ty1 = 0;
+            float wy = 0.0f;
+            Neighbours(centres_y, static_cast<float>(y) + 0.5f, ty0, ty1, wy);
+            uint16_t* row = reinterpret_cast<uint16_t*>(
+                reinterpret_cast<uint8_t*>(data) + y * stride);
+
+            for (const Segment& segment : segments_) {
+                const float* a = luts_.data() + (static_cast<size_t>(ty0) * tiles_x + segment.tile0) * bins;
+                const float* b = luts_.data() + (static_cast<size_t>(ty0) * tiles_x + segment.tile1) * bins;
+                const float* c = luts_.data() + (static_cast<size_t>(ty1) * tiles_x + segment.tile0) * bins;
+                const float* d = luts_.data() + (static_cast<size_t>(ty1) * tiles_x + segment.tile1) * bins;
+                uint32_t x = segment.x_begin;
+#if HNVUE_CLAHE_HAS_SSE2
+                const __m128 vwy = _mm_set1_ps(wy);
+                const __m128 half = _mm_set1_ps(0.5f);
+                alignas(16) int32_t out[4];
+                for (; x + 4 <= segment.x_end; x += 4) {
+                    const uint32_t i0 = row[x] >> shift;
+                    const uint32_t i1 = row[x + 1] >> shift;
+                    const uint32_t i2 = row[x + 2] >> shift;
+                    const uint32_t i3 = row[x + 3] >> shift;
+                    const __m128 va = _mm_setr_ps(a[i0], a[i1], a[i2], a[i3]);
+                    const __m128 vb = _mm_setr_ps(b[i0], b[i1], b[i2], b[i3]);
+                    const __m128 vc = _mm_setr_ps(c[i0], c[i1], c[i2], c[i3]);
+                    const __m128 vd = _mm_setr_ps(d[i0], d[i1], d[i2], d[i3]);
+                    const __m128 wx = _mm_loadu_ps(column_weight_.data() + x);
+                    const __m128 top = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), wx));
+                    const __m128 bottom = _mm_add_ps(vc, _mm_mul_ps(_mm_sub_ps(vd, vc), wx));
+                    const __m128 value = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), vwy));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(out),
+                                    _mm_cvttps_epi32(_mm_add_ps(value, half)));
+                    for (uint32_t i = 0; i < 4; ++i) {
+                        const uint16_t v = static_cast<uint16_t>(out[i]);
+                        row[x + i] = post_lut != nullptr ? post_lut[v] : v;
+                    }
+                }
+#endif
+                for (; x < segment.x_end; ++x) {
+                    const uint32_t i = row[x] >> shift;
+                    const float wx = column_weight_[x];
+                    const float top = a[i] + (b[i] - a[i]) * wx;
+                    const float bottom = c[i] + (d[i] - c[i]) * wx;
+                    row[x] = Quantise(top + (bottom - top) * wy, post_lut);
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
+} // namespace hnvue::imaging
@@ -9,6 +9,7 @@
  */
 
 #include "hnvue/imaging/DefaultImageProcessingEngine.h"
+#include "hnvue/infra/Clock.h"
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
@@ -16,6 +17,7 @@
 #include <chrono>
 #include <cstring>
 #include <algorithm>
+#include <type_traits>
 
 namespace hnvue::imaging {
 
@@ -25,6 +27,130 @@ namespace hnvue::imaging {
 
 namespace internal {
 
+// Estimated bytes read + written per pixel by each stage's full-frame
+// passes (u16 = 2, f32 = 4 per access), reported in StageTiming::*_bytes.
+//
+// UINT16_STAGES: each stage converts u16 -> f32, computes, clamps and
+// converts back.
+constexpr uint64_t kU16OffsetBytes = 32;      // cvt 2+4, sub 12, max 8, cvt 4+2
+constexpr uint64_t kU16GainBytes = 40;        // cvt 6, mul 12, max 8, min 8, cvt 6
+constexpr uint64_t kU16ScatterBytes = 56;     // cvt 6, blur 8, scale 8, sub 12, max 8, min 8, cvt 6
+constexpr uint64_t kU16NoiseBytes = 4;        // filter 2+2
+constexpr uint64_t kU16BilateralBytes = 20;   // cvt 2+4, filter 4+4, cvt 4+2
+constexpr uint64_t kU16FlatteningBytes = 72;  // open 8, cvt 6+6, mask 5, setTo 5, scale 8, div 12,
+                                              // max 8, min 8, cvt 6
+constexpr uint64_t kU16WindowLevelBytes = 4;  // in place 2+2
+// FLOAT32_PLANE: converted once in offset, quantised once in Window/Level
+constexpr uint64_t kPlaneOffsetBytes = 18;       // cvt 2+4, sub 12
+constexpr uint64_t kPlaneGainBytes = 12;         // mul 12
+constexpr uint64_t kPlaneScatterBytes = 20;      // blur 8, scaleAdd 12
+constexpr uint64_t kPlaneNoiseBytes = 8;         // filter 4+4
+constexpr uint64_t kPlaneNoiseCopyBytes = 8;     // bilateral output copy
+constexpr uint64_t kPlaneFlatteningBytes = 38;   // open 16, mask 5, setTo 5, div 12
+constexpr uint64_t kPlaneWindowLevelBytes = 6;   // cvt 4+2
+// Window/Level fused with the output transform, per output (or copied) pixel
+constexpr uint64_t kOutputU16Bytes = 4;          // LUT 2+2
+constexpr uint64_t kOutputCopyBytes = 4;         // crop copy 2+2
+constexpr uint64_t kOutputPlaneBytes = 6;        // 4+2
+// CLAHE: histogram read 2, LUT blend 2+2 (Window/Level folded in for free)
+constexpr uint64_t kClaheBytes = 6;
+constexpr uint64_t kPlaneQuantiseBytes = 6;      // plane -> u16 for CLAHE, cvt 4+2
+// Defect correction touches 9 pixels per defect
+constexpr uint64_t kDefectNeighbourhood = 9;
+// Defect detection per observed pixel: rows above, at and below 6, score 1+1
+constexpr uint64_t kDefectDetectionBytes = 8;
+
+/**
+ * @brief Frame pixel count as a 64-bit byte multiplier
+ */
+inline uint64_t Pixels(uint32_t width, uint32_t height) {
+    return static_cast<uint64_t>(width) * height;
+}
+
+/**
+ * @brief Elapsed microseconds, rounded up
+ *
+ * Correcting a few defects takes well under a microsecond; rounding up
+ * keeps a stage that ran distinguishable from a skipped one (0 us).
+ */
+inline uint64_t ElapsedUsCeil(infra::MonotonicClock::time_point start,
+                              infra::MonotonicClock::time_point end) {
+    return static_cast<uint64_t>(
+        std::chrono::ceil<std::chrono::microseconds>(end - start).count());
+}
+
+/**
+ * @brief Defect interpolation on a single-channel Mat of pixel type T
+ */
+template <typename T>
+void NearestNeighbor(cv::Mat& mat, uint32_t x, uint32_t y) {
+    // Find nearest valid pixel
+    const int search_radius = 2;
+    T neighbor_value = 0;
+    bool found = false;
+
+    for (int dy = -search_radius; dy <= search_radius && !found; ++dy) {
+        for (int dx = -search_radius; dx <= search_radius && !found; ++dx) {
+            int nx = static_cast<int>(x) + dx;
+            int ny = static_cast<int>(y) + dy;
+            if (nx >= 0 && nx < mat.cols && ny >= 0 && ny < mat.rows) {
+                if (dx != 0 || dy != 0) {  // Not the defective pixel itself
+                    neighbor_value = mat.at<T>(ny, nx);
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (found) {
+        mat.at<T>(y, x) = neighbor_value;
+    }
+}
+
+template <typename T>
+void Bilinear(cv::Mat& mat, uint32_t x, uint32_t y) {
+    // Simple bilinear interpolation from 4 neighbors
+    int x0 = std::max(0, static_cast<int>(x) - 1);
+    int x1 = std::min(mat.cols - 1, static_cast<int>(x) + 1);
+    int y0 = std::max(0, static_cast<int>(y) - 1);
+    int y1 = std::min(mat.rows - 1, static_cast<int>(y) + 1);
+
+    // Avoid using the defective pixel itself
+    T tl = mat.at<T>(y0, x0);
+    T tr = mat.at<T>(y0, x1);
+    T bl = mat.at<T>(y1, x0);
+    T br = mat.at<T>(y1, x1);
+
+    // Average of neighbors (integer division for u16, exact for f32)
+    using Sum = std::conditional_t<std::is_floating_point_v<T>, T, uint32_t>;
+    Sum sum = static_cast<Sum>(tl) + tr + bl + br;
+    mat.at<T>(y, x) = static_cast<T>(sum / 4);
+}
+
+template <typename T>
+void Median3x3(cv::Mat& mat, uint32_t x, uint32_t y) {
+    // Collect 3x3 neighborhood values
+    T values[8];
+    size_t n = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int nx = static_cast<int>(x) + dx;
+            int ny = static_cast<int>(y) + dy;
+            if (nx >= 0 && nx < mat.cols && ny >= 0 && ny < mat.rows) {
+                if (dx != 0 || dy != 0) {  // Exclude the defective pixel
+                    values[n++] = mat.at<T>(ny, nx);
+                }
+            }
+        }
+    }
+
+    if (n > 0) {
+        std::nth_element(values, values + n / 2, values + n);
+        mat.at<T>(y, x) = values[n / 2];
+    }
+}
+
 /**
  * @brief OpenCV helper wrapper
  *
@@ -136,50 +262,25 @@ public:
 
         return true;
     }
-};
-
-/**
- * @brief Calibration data cache
- *
- * Manages cached calibration data and validation.
- */
-class CalibrationCache {
-public:
-    CalibrationCache() = default;
-    ~CalibrationCache() = default;
-
-    /**
-     * @brief Store calibration data in cache
-     */
-    void Store(const std::string& key, const CalibrationData& data) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_[key] = data;
-    }
 
     /**
-     * @brief Retrieve calibration data from cache
+     * @brief Same filter on an f32 plane, in place and without clipping
+     * @param plane CV_32FC1 working plane (modified in-place)
+     * @param cutoff_frequency Normalized cutoff frequency (0.0-1.0)
+     * @param suppression_ratio Scatter suppression ratio
      */
-    bool Retrieve(const std::string& key, CalibrationData& data) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            data = it->second;
-            return true;
-        }
-        return false;
-    }
+    void ApplyScatterCorrection(cv::Mat& plane,
+                                float cutoff_frequency,
+                                float suppression_ratio) {
+        int kernel_size = static_cast<int>(
+            std::min(plane.cols, plane.rows) * (1.0f - cutoff_frequency) * 2.0f + 1.0f);
+        if (kernel_size < 3) kernel_size = 3;
+        if (kernel_size % 2 == 0) kernel_size += 1;
 
-    /**
-     * @brief Clear all cached data
-     */
-    void Clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.clear();
+        cv::Mat background;
+        cv::GaussianBlur(plane, background, cv::Size(kernel_size, kernel_size), 0);
+        cv::scaleAdd(background, -suppression_ratio, plane, plane);
     }
-
-private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, CalibrationData> cache_;
 };
 
 } // namespace internal
@@ -190,8 +291,7 @@ private:
 
 DefaultImageProcessingEngine::DefaultImageProcessingEngine()
     : cv_helper_(std::make_unique<internal::OpenCVHelper>()),
-      fftw_helper_(std::make_unique<internal::FFTWHelper>()),
-      calib_cache_(std::make_unique<internal::CalibrationCache>()) {
+      fftw_helper_(std::make_unique<internal::FFTWHelper>()) {
 }
 
 DefaultImageProcessingEngine::~DefaultImageProcessingEngine() {
@@ -227,10 +327,13 @@ void DefaultImageProcessingEngine::Shutdown() {
         return;
     }
 
-    // Clear cached calibration data
-    if (calib_cache_) {
-        calib_cache_->Clear();
-    }
+    // Release the bound calibration and the working buffers
+    bound_set_.reset();
+    bound_ = CalibrationBinding{};
+    working_plane_.Reset();
+    output_source_.Reset();
+    clahe_.reset();
+    ClearDynamicDefects();
 
     initialized_ = false;
 }
@@ -238,8 +341,6 @@ void DefaultImageProcessingEngine::Shutdown() {
 bool DefaultImageProcessingEngine::ApplyOffsetCorrection(
     ImageBuffer& frame, const CalibrationData& dark) {
 
-    auto start = std::chrono::high_resolution_clock::now();
-
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
                  "Engine not initialized", "OffsetCorrection");
@@ -264,6 +365,16 @@ bool DefaultImageProcessingEngine::ApplyOffsetCorrection(
         return false;
     }
 
+    RunOffsetCorrection(frame, dark);
+    ClearError();
+    return true;
+}
+
+void DefaultImageProcessingEngine::RunOffsetCorrection(
+    ImageBuffer& frame, const CalibrationData& dark) {
+
+    auto start = infra::MonotonicClock::now();
+
     cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
     cv::Mat dark_mat(frame.height, frame.width, CV_32FC1,
                      dark.data_f32, cv::Mat::AUTO_STEP);
@@ -278,20 +389,17 @@ bool DefaultImageProcessingEngine::ApplyOffsetCorrection(
     cv::max(float_mat, 0.0f, float_mat);
     float_mat.convertTo(mat, CV_16U);
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.offset_correction_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-
-    ClearError();
-    return true;
+    last_timing_.offset_correction_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kU16OffsetBytes;
 }
 
 bool DefaultImageProcessingEngine::ApplyGainCorrection(
     ImageBuffer& frame, const CalibrationData& gain) {
 
-    auto start = std::chrono::high_resolution_clock::now();
-
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
                  "Engine not initialized", "GainCorrection");
@@ -316,6 +424,16 @@ bool DefaultImageProcessingEngine::ApplyGainCorrection(
         return false;
     }
 
+    RunGainCorrection(frame, gain);
+    ClearError();
+    return true;
+}
+
+void DefaultImageProcessingEngine::RunGainCorrection(
+    ImageBuffer& frame, const CalibrationData& gain) {
+
+    auto start = infra::MonotonicClock::now();
+
     cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
     cv::Mat gain_mat(frame.height, frame.width, CV_32FC1,
                      gain.data_f32, cv::Mat::AUTO_STEP);
@@ -330,20 +448,17 @@ bool DefaultImageProcessingEngine::ApplyGainCorrection(
     cv::min(float_mat, 65535.0f, float_mat);
     float_mat.convertTo(mat, CV_16U);
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.gain_correction_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-
-    ClearError();
-    return true;
+    last_timing_.gain_correction_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kU16GainBytes;
 }
 
 bool DefaultImageProcessingEngine::ApplyDefectPixelMap(
     ImageBuffer& frame, const DefectMap& map) {
 
-    auto start = std::chrono::high_resolution_clock::now();
-
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
                  "Engine not initialized", "DefectPixelMap");
@@ -362,13 +477,35 @@ bool DefaultImageProcessingEngine::ApplyDefectPixelMap(
         return true;
     }
 
+    RunDefectPixelMap(frame, map);
+    ClearError();
+    return true;
+}
+
+void DefaultImageProcessingEngine::RunDefectPixelMap(
+    ImageBuffer& frame, const DefectMap& map) {
+
+    auto start = infra::MonotonicClock::now();
+
     cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
+    CorrectDefects(mat, map);
+
+    auto end = infra::MonotonicClock::now();
+    std::lock_guard<std::mutex> lock(timing_mutex_);
+    last_timing_.defect_pixel_map_us = internal::ElapsedUsCeil(start, end);
+    last_timing_.defect_pixel_map_bytes =
+        static_cast<uint64_t>(map.count) * internal::kDefectNeighbourhood * sizeof(uint16_t);
+}
+
+void DefaultImageProcessingEngine::CorrectDefects(cv::Mat& mat, const DefectMap& map) {
+    const uint32_t width = static_cast<uint32_t>(mat.cols);
+    const uint32_t height = static_cast<uint32_t>(mat.rows);
 
     // Correct each defective pixel
     for (uint32_t i = 0; i < map.count; ++i) {
         const DefectPixelEntry& defect = map.pixels[i];
 
-        if (defect.x >= frame.width || defect.y >= frame.height) {
+        if (defect.x >= width || defect.y >= height) {
             continue;  // Skip out-of-bounds pixels
         }
 
@@ -389,20 +526,12 @@ bool DefaultImageProcessingEngine::ApplyDefectPixelMap(
                 break;
         }
     }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    std::lock_guard<std::mutex> lock(timing_mutex_);
-    last_timing_.defect_pixel_map_us =
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-
-    ClearError();
-    return true;
 }
 
 bool DefaultImageProcessingEngine::ApplyScatterCorrection(
     ImageBuffer& frame, const ScatterParams& params) {
 
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = infra::MonotonicClock::now();
 
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
@@ -414,6 +543,7 @@ bool DefaultImageProcessingEngine::ApplyScatterCorrection(
     if (!params.enabled) {
         std::lock_guard<std::mutex> lock(timing_mutex_);
         last_timing_.scatter_correction_us = 0;
+        last_timing_.scatter_correction_bytes = 0;
         ClearError();
         return true;
     }
@@ -432,10 +562,12 @@ bool DefaultImageProcessingEngine::ApplyScatterCorrection(
         return false;
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.scatter_correction_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    last_timing_.scatter_correction_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kU16ScatterBytes;
 
     ClearError();
     return true;
@@ -444,7 +576,7 @@ bool DefaultImageProcessingEngine::ApplyScatterCorrection(
 bool DefaultImageProcessingEngine::ApplyWindowLevel(
     ImageBuffer& frame, float window, float level) {
 
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = infra::MonotonicClock::now();
 
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
@@ -481,10 +613,12 @@ bool DefaultImageProcessingEngine::ApplyWindowLevel(
         }
     );
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.window_level_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    last_timing_.window_level_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kU16WindowLevelBytes;
 
     ClearError();
     return true;
@@ -493,7 +627,7 @@ bool DefaultImageProcessingEngine::ApplyWindowLevel(
 bool DefaultImageProcessingEngine::ApplyNoiseReduction(
     ImageBuffer& frame, const NoiseReductionConfig& config) {
 
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = infra::MonotonicClock::now();
 
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
@@ -505,6 +639,7 @@ bool DefaultImageProcessingEngine::ApplyNoiseReduction(
     if (!config.enabled) {
         std::lock_guard<std::mutex> lock(timing_mutex_);
         last_timing_.noise_reduction_us = 0;
+        last_timing_.noise_reduction_bytes = 0;
         ClearError();
         return true;
     }
@@ -517,6 +652,7 @@ bool DefaultImageProcessingEngine::ApplyNoiseReduction(
 
     cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
     int kernel_size = static_cast<int>(config.kernel_size);
+    uint64_t bytes_per_pixel = internal::kU16NoiseBytes;
 
     // Ensure kernel size is odd and at least 3
     if (kernel_size < 3) kernel_size = 3;
@@ -532,10 +668,17 @@ bool DefaultImageProcessingEngine::ApplyNoiseReduction(
             cv::medianBlur(mat, mat, kernel_size);
             break;
 
-        case NoiseFilterType::BILATERAL:
-            cv::bilateralFilter(mat, mat, kernel_size,
+        case NoiseFilterType::BILATERAL: {
+            // OpenCV filters only 8-bit and float images bilaterally, and
+            // not in place
+            cv::Mat float_mat, filtered;
+            mat.convertTo(float_mat, CV_32F);
+            cv::bilateralFilter(float_mat, filtered, kernel_size,
                                 config.sigma, config.sigma);
+            filtered.convertTo(mat, CV_16U);
+            bytes_per_pixel = internal::kU16BilateralBytes;
             break;
+        }
 
         default:
             SetError(ImagingError::IMAGING_ERR_PARAM,
@@ -543,10 +686,12 @@ bool DefaultImageProcessingEngine::ApplyNoiseReduction(
             return false;
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.noise_reduction_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    last_timing_.noise_reduction_bytes =
+        internal::Pixels(frame.width, frame.height) * bytes_per_pixel;
 
     ClearError();
     return true;
@@ -555,7 +700,7 @@ bool DefaultImageProcessingEngine::ApplyNoiseReduction(
 bool DefaultImageProcessingEngine::ApplyFlattening(
     ImageBuffer& frame, const FlatteningConfig& config) {
 
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = infra::MonotonicClock::now();
 
     if (!initialized_) {
         SetError(ImagingError::IMAGING_ERR_INIT,
@@ -567,6 +712,7 @@ bool DefaultImageProcessingEngine::ApplyFlattening(
     if (!config.enabled) {
         std::lock_guard<std::mutex> lock(timing_mutex_);
         last_timing_.flattening_us = 0;
+        last_timing_.flattening_bytes = 0;
         ClearError();
         return true;
     }
@@ -604,10 +750,12 @@ bool DefaultImageProcessingEngine::ApplyFlattening(
     cv::min(result, 65535.0f, result);
     result.convertTo(mat, CV_16U);
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = infra::MonotonicClock::now();
     std::lock_guard<std::mutex> lock(timing_mutex_);
     last_timing_.flattening_us =
         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    last_timing_.flattening_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kU16FlatteningBytes;
 
     ClearError();
     return true;
@@ -628,53 +776,110 @@ bool DefaultImageProcessingEngine::ProcessFrame(
         last_timing_ = StageTiming{};
     }
 
-    bool success = true;
-    uint64_t stages = 0;
+    // Reject a bad output transform before the frame is modified
+    uint32_t out_width = 0;
+    uint32_t out_height = 0;
+    if (!config.output.IsIdentity() &&
+        !ComputeOutputGeometry(config.output, frame.width, frame.height,
+                               out_width, out_height)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid output transform", "OutputTransform");
+        return false;
+    }
+    const bool clahe = config.mode != ProcessingMode::PREVIEW && config.clahe.enabled;
+    if (clahe && !ValidateClaheConfig(config.clahe, frame.width, frame.height)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid CLAHE configuration", "CLAHE");
+        return false;
+    }
+    const bool detect = config.mode != ProcessingMode::PREVIEW &&
+                        config.defect_detection.enabled;
+    if (detect && !ValidateDefectDetectionConfig(config.defect_detection)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid defect detection configuration", "DefectDetection");
+        return false;
+    }
 
-    // Apply pipeline based on mode
-    if (config.mode == ProcessingMode::PREVIEW) {
-        // Preview mode: Offset -> Gain -> Window/Level
-        if (!ApplyOffsetCorrection(frame, *config.calibration_dark)) {
-            return false;
-        }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_OFFSET_CORRECTION);
+    if (config.precision == WorkingPrecision::FLOAT32_PLANE) {
+        return ProcessFramePlane(frame, config);
+    }
 
-        if (!ApplyGainCorrection(frame, *config.calibration_gain)) {
+    uint64_t stages = 0;
+
+    // Calibration handle: validated once per set and geometry, then the
+    // calibration stages run without per-frame checks
+    const bool bound = config.calibration != nullptr;
+    if (bound) {
+        if (!ValidateFrame(frame)) {
+            SetError(ImagingError::IMAGING_ERR_PARAM,
+                     "Invalid frame buffer", "ProcessFrame");
             return false;
         }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_GAIN_CORRECTION);
-
-        if (!ApplyWindowLevel(frame, config.window, config.level)) {
+        if (!BindCalibration(config.calibration, frame)) {
             return false;
         }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_WINDOW_LEVEL);
+    } else if (config.calibration_dark == nullptr ||
+               config.calibration_gain == nullptr ||
+               (config.mode != ProcessingMode::PREVIEW && config.defect_map == nullptr)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Required calibration data is null", "ProcessFrame");
+        return false;
+    }
 
-    } else {
-        // Full pipeline mode
-        if (config.calibration_dark == nullptr ||
-            config.calibration_gain == nullptr ||
-            config.defect_map == nullptr) {
+    // Defect detection sees the raw frame, as in the plane pipeline
+    if (detect) {
+        if (!ValidateFrame(frame)) {
             SetError(ImagingError::IMAGING_ERR_PARAM,
-                     "Required calibration data is null", "ProcessFrame");
+                     "Invalid frame buffer", "ProcessFrame");
             return false;
         }
+        StageTiming detection_timing;
+        ObserveDefects(frame, bound ? bound_.defect_map : config.defect_map, false,
+                       config.defect_detection, detection_timing);
+        std::lock_guard<std::mutex> lock(timing_mutex_);
+        last_timing_.defect_detection_us = detection_timing.defect_detection_us;
+        last_timing_.defect_detection_bytes = detection_timing.defect_detection_bytes;
+        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_DEFECT_DETECTION);
+    }
 
-        // Stage 1: Offset Correction
-        if (!ApplyOffsetCorrection(frame, *config.calibration_dark)) {
-            return false;
-        }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_OFFSET_CORRECTION);
+    // Stage 1: Offset Correction
+    if (bound) {
+        RunOffsetCorrection(frame, *bound_.dark);
+    } else if (!ApplyOffsetCorrection(frame, *config.calibration_dark)) {
+        return false;
+    }
+    stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_OFFSET_CORRECTION);
 
-        // Stage 2: Gain Correction
-        if (!ApplyGainCorrection(frame, *config.calibration_gain)) {
-            return false;
-        }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_GAIN_CORRECTION);
+    // Stage 2: Gain Correction
+    if (bound) {
+        RunGainCorrection(frame, *bound_.gain);
+    } else if (!ApplyGainCorrection(frame, *config.calibration_gain)) {
+        return false;
+    }
+    stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_GAIN_CORRECTION);
 
+    // Apply pipeline based on mode
+    if (config.mode != ProcessingMode::PREVIEW) {
         // Stage 3: Defect Pixel Mapping
-        if (!ApplyDefectPixelMap(frame, *config.defect_map)) {
+        if (bound) {
+            if (bound_.defect_map != nullptr && bound_.defect_map->count > 0) {
+                RunDefectPixelMap(frame, *bound_.defect_map);
+            }
+        } else if (!ApplyDefectPixelMap(frame, *config.defect_map)) {
             return false;
         }
+        // Promoted defects after the calibrated ones
+        if (const DefectMap* dynamic = DynamicDefectMap(frame.width, frame.height)) {
+            auto start = infra::MonotonicClock::now();
+            cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
+            CorrectDefects(mat, *dynamic);
+            auto end = infra::MonotonicClock::now();
+            std::lock_guard<std::mutex> lock(timing_mutex_);
+            last_timing_.defect_pixel_map_us += internal::ElapsedUsCeil(start, end);
+            last_timing_.defect_pixel_map_bytes += static_cast<uint64_t>(dynamic->count) *
+                                                   internal::kDefectNeighbourhood *
+                                                   sizeof(uint16_t);
+        }
         stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_DEFECT_PIXEL_MAP);
 
         // Stage 4: Scatter Correction (conditional)
@@ -701,11 +906,223 @@ bool DefaultImageProcessingEngine::ProcessFrame(
             stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_FLATTENING);
         }
 
-        // Stage 7: Window/Level
+        // Stage 6b: CLAHE (conditional); without an output transform its
+        // last pass also applies Window/Level
+        if (clahe) {
+            StageTiming clahe_timing;
+            if (!RunClahe(frame, config, config.output.IsIdentity(), clahe_timing)) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(timing_mutex_);
+            last_timing_.clahe_us = clahe_timing.clahe_us;
+            last_timing_.clahe_bytes = clahe_timing.clahe_bytes;
+            stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_CLAHE);
+        }
+    }
+
+    // Stage 7: Window/Level (preview: Offset -> Gain -> Window/Level),
+    // writing the output transform in the same pass
+    if (clahe && config.output.IsIdentity()) {
+        // Applied by the CLAHE pass
+    } else if (config.output.IsIdentity()) {
         if (!ApplyWindowLevel(frame, config.window, config.level)) {
             return false;
         }
-        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_WINDOW_LEVEL);
+    } else {
+        auto start = infra::MonotonicClock::now();
+        uint64_t bytes = 0;
+        if (!WriteOutputFrame(frame, config, cv::Mat(), bytes)) {
+            return false;
+        }
+        auto end = infra::MonotonicClock::now();
+        std::lock_guard<std::mutex> lock(timing_mutex_);
+        last_timing_.window_level_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        last_timing_.window_level_bytes = bytes;
+        stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_OUTPUT_TRANSFORM);
+    }
+    stages |= static_cast<uint64_t>(PipelineStageFlags::STAGE_WINDOW_LEVEL);
+
+    ClearError();
+    return true;
+}
+
+bool DefaultImageProcessingEngine::ProcessFramePlane(
+    ImageBuffer& frame, const ProcessingConfig& config) {
+
+    if (!ValidateFrame(frame)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid frame buffer", "ProcessFrame");
+        return false;
+    }
+
+    CalibrationBinding calibration;
+    if (!ResolveCalibration(config, frame, calibration)) {
+        return false;
+    }
+
+    if (config.window <= 0.0f) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Window width must be positive", "WindowLevel");
+        return false;
+    }
+
+    cv::Mat plane = WorkingPlane(frame.width, frame.height);
+    if (plane.empty()) {
+        SetError(ImagingError::IMAGING_ERR_MEMORY,
+                 "Working plane allocation failed", "ProcessFrame");
+        return false;
+    }
+
+    cv::Mat mat = internal::OpenCVHelper::WrapBuffer(frame);
+    const uint64_t pixels = internal::Pixels(frame.width, frame.height);
+    StageTiming timing;
+    const bool clahe = config.mode != ProcessingMode::PREVIEW && config.clahe.enabled;
+
+    // Defect detection works on integer pixels: observe the raw frame
+    if (config.mode != ProcessingMode::PREVIEW && config.defect_detection.enabled) {
+        ObserveDefects(frame, calibration.defect_map, false, config.defect_detection, timing);
+    }
+
+    auto elapsed_us = [](const auto& start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            infra::MonotonicClock::now() - start).count());
+    };
+
+    // Stage 1: Offset Correction (the only u16 -> f32 conversion)
+    auto start = infra::MonotonicClock::now();
+    cv::Mat dark_mat(frame.height, frame.width, CV_32FC1,
+                     calibration.dark->data_f32, cv::Mat::AUTO_STEP);
+    mat.convertTo(plane, CV_32F);
+    cv::subtract(plane, dark_mat, plane);
+    timing.offset_correction_us = elapsed_us(start);
+    timing.offset_correction_bytes = pixels * internal::kPlaneOffsetBytes;
+
+    // Stage 2: Gain Correction
+    start = infra::MonotonicClock::now();
+    cv::Mat gain_mat(frame.height, frame.width, CV_32FC1,
+                     calibration.gain->data_f32, cv::Mat::AUTO_STEP);
+    cv::multiply(plane, gain_mat, plane);
+    timing.gain_correction_us = elapsed_us(start);
+    timing.gain_correction_bytes = pixels * internal::kPlaneGainBytes;
+
+    // Intermediate values are neither clamped nor rounded: negative offsets
+    // and gain overshoot survive until Window/Level maps them
+    if (config.mode != ProcessingMode::PREVIEW) {
+        // Stage 3: Defect Pixel Mapping (calibrated defects, then promoted ones)
+        for (const DefectMap* defects :
+             {calibration.defect_map, DynamicDefectMap(frame.width, frame.height)}) {
+            if (defects != nullptr && defects->valid &&
+                defects->pixels != nullptr && defects->count > 0) {
+                start = infra::MonotonicClock::now();
+                CorrectDefects(plane, *defects);
+                timing.defect_pixel_map_us +=
+                    internal::ElapsedUsCeil(start, infra::MonotonicClock::now());
+                timing.defect_pixel_map_bytes += static_cast<uint64_t>(defects->count) *
+                                                 internal::kDefectNeighbourhood * sizeof(float);
+            }
+        }
+
+        // Stage 4: Scatter Correction (conditional)
+        if (config.scatter.enabled) {
+            start = infra::MonotonicClock::now();
+            fftw_helper_->ApplyScatterCorrection(plane, config.scatter.cutoff_frequency,
+                                                 config.scatter.suppression_ratio);
+            timing.scatter_correction_us = elapsed_us(start);
+            timing.scatter_correction_bytes = pixels * internal::kPlaneScatterBytes;
+        }
+
+        // Stage 5: Noise Reduction (conditional)
+        if (config.noise_reduction.enabled) {
+            start = infra::MonotonicClock::now();
+            int kernel_size = static_cast<int>(config.noise_reduction.kernel_size);
+            if (kernel_size < 3) kernel_size = 3;
+            if (kernel_size % 2 == 0) kernel_size += 1;
+            const double sigma = config.noise_reduction.sigma;
+            uint64_t bytes_per_pixel = internal::kPlaneNoiseBytes;
+
+            switch (config.noise_reduction.filter_type) {
+                case NoiseFilterType::GAUSSIAN:
+                    cv::GaussianBlur(plane, plane, cv::Size(kernel_size, kernel_size), sigma);
+                    break;
+
+                case NoiseFilterType::MEDIAN:
+                    cv::medianBlur(plane, plane, kernel_size);
+                    break;
+
+                case NoiseFilterType::BILATERAL: {
+                    // Bilateral filtering cannot run in place
+                    cv::Mat filtered;
+                    cv::bilateralFilter(plane, filtered, kernel_size, sigma, sigma);
+                    filtered.copyTo(plane);
+                    bytes_per_pixel += internal::kPlaneNoiseCopyBytes;
+                    break;
+                }
+
+                default:
+                    SetError(ImagingError::IMAGING_ERR_PARAM,
+                             "Unknown noise filter type", "NoiseReduction");
+                    return false;
+            }
+            timing.noise_reduction_us = elapsed_us(start);
+            timing.noise_reduction_bytes = pixels * bytes_per_pixel;
+        }
+
+        // Stage 6: Flattening (conditional)
+        if (config.flattening.enabled) {
+            start = infra::MonotonicClock::now();
+            int kernel_size = static_cast<int>(config.flattening.sigma_background);
+            if (kernel_size < 3) kernel_size = 3;
+            if (kernel_size % 2 == 0) kernel_size += 1;
+
+            cv::Mat background;
+            cv::morphologyEx(plane, background, cv::MORPH_OPEN,
+                             cv::getStructuringElement(cv::MORPH_ELLIPSE,
+                                                       cv::Size(kernel_size, kernel_size)));
+
+            // Avoid division by zero
+            cv::Mat mask = (background > 1.0f);
+            background.setTo(1.0f, ~mask);
+            cv::divide(plane, background, plane, 65535.0);
+            timing.flattening_us = elapsed_us(start);
+            timing.flattening_bytes = pixels * internal::kPlaneFlatteningBytes;
+        }
+
+        // Stage 6b: CLAHE (conditional) bins integer values: the plane is
+        // quantised into the frame unwindowed (negatives saturate to 0) and
+        // CLAHE and Window/Level run on the u16 frame
+        if (clahe) {
+            start = infra::MonotonicClock::now();
+            plane.convertTo(mat, CV_16U);
+            if (!RunClahe(frame, config, config.output.IsIdentity(), timing)) {
+                return false;
+            }
+            timing.clahe_us = elapsed_us(start);
+            timing.clahe_bytes += pixels * internal::kPlaneQuantiseBytes;
+        }
+    }
+
+    // Stage 7: Window/Level, quantising the plane back into the frame once
+    // (saturating, round to nearest) and applying the output transform
+    start = infra::MonotonicClock::now();
+    if (clahe) {
+        if (!config.output.IsIdentity() &&
+            !WriteOutputFrame(frame, config, cv::Mat(), timing.window_level_bytes)) {
+            return false;
+        }
+    } else if (config.output.IsIdentity()) {
+        const double win_min = config.level - config.window / 2.0;
+        const double scale = 65535.0 / config.window;
+        plane.convertTo(mat, CV_16U, scale, -win_min * scale);
+        timing.window_level_bytes = pixels * internal::kPlaneWindowLevelBytes;
+    } else if (!WriteOutputFrame(frame, config, plane, timing.window_level_bytes)) {
+        return false;
+    }
+    timing.window_level_us = elapsed_us(start);
+
+    {
+        std::lock_guard<std::mutex> lock(timing_mutex_);
+        last_timing_ = timing;
     }
 
     ClearError();
@@ -725,7 +1142,11 @@ EngineInfo DefaultImageProcessingEngine::GetEngineInfo() const {
         static_cast<uint64_t>(EngineCapabilityFlags::CAP_WINDOW_LEVEL) |
         static_cast<uint64_t>(EngineCapabilityFlags::CAP_NOISE_REDUCTION) |
         static_cast<uint64_t>(EngineCapabilityFlags::CAP_FLATTENING) |
-        static_cast<uint64_t>(EngineCapabilityFlags::CAP_PREVIEW_MODE);
+        static_cast<uint64_t>(EngineCapabilityFlags::CAP_PREVIEW_MODE) |
+        static_cast<uint64_t>(EngineCapabilityFlags::CAP_FLOAT_WORKING_PLANE) |
+        static_cast<uint64_t>(EngineCapabilityFlags::CAP_OUTPUT_TRANSFORM) |
+        static_cast<uint64_t>(EngineCapabilityFlags::CAP_CLAHE) |
+        static_cast<uint64_t>(EngineCapabilityFlags::CAP_DYNAMIC_DEFECTS);
     info.api_version = 0x01000000;  // v1.0.0
     return info;
 }
@@ -777,74 +1198,327 @@ bool DefaultImageProcessingEngine::ValidateCalibration(
            calib.height == frame.height;
 }
 
-void DefaultImageProcessingEngine::ApplyNearestNeighbor(
-    cv::Mat& mat, uint32_t x, uint32_t y) {
+bool DefaultImageProcessingEngine::BindCalibration(
+    const CalibrationSetHandle& calibration, const ImageBuffer& frame) {
 
-    // Find nearest valid pixel
-    const int search_radius = 2;
-    uint16_t neighbor_value = 0;
-    bool found = false;
+    if (calibration == bound_set_ &&
+        frame.width == bound_width_ && frame.height == bound_height_) {
+        return true;
+    }
 
-    for (int dy = -search_radius; dy <= search_radius && !found; ++dy) {
-        for (int dx = -search_radius; dx <= search_radius && !found; ++dx) {
-            int nx = static_cast<int>(x) + dx;
-            int ny = static_cast<int>(y) + dy;
-            if (nx >= 0 && nx < mat.cols && ny >= 0 && ny < mat.rows) {
-                if (dx != 0 || dy != 0) {  // Not the defective pixel itself
-                    neighbor_value = mat.at<uint16_t>(ny, nx);
-                    found = true;
+    CalibrationBinding binding;
+    if (!calibration->Bind(frame.width, frame.height, binding)) {
+        SetError(ImagingError::IMAGING_ERR_CALIBRATION,
+                 "Calibration set does not match frame geometry", "ProcessFrame");
+        return false;
+    }
+
+    // Holding the set keeps the bound views alive
+    bound_set_ = calibration;
+    bound_width_ = frame.width;
+    bound_height_ = frame.height;
+    bound_ = binding;
+    return true;
+}
+
+bool DefaultImageProcessingEngine::ResolveCalibration(
+    const ProcessingConfig& config, const ImageBuffer& frame,
+    CalibrationBinding& binding) {
+
+    if (config.calibration != nullptr) {
+        if (!BindCalibration(config.calibration, frame)) {
+            return false;
+        }
+        binding = bound_;
+        return true;
+    }
+
+    if (config.calibration_dark == nullptr ||
+        config.calibration_gain == nullptr ||
+        (config.mode != ProcessingMode::PREVIEW && config.defect_map == nullptr)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Required calibration data is null", "ProcessFrame");
+        return false;
+    }
+
+    const CalibrationData& dark = *config.calibration_dark;
+    if (!ValidateCalibration(dark, frame)) {
+        SetError(ImagingError::IMAGING_ERR_CALIBRATION,
+                 "Invalid dark calibration data", "OffsetCorrection");
+        return false;
+    }
+    if (dark.type != CalibrationDataType::DARK_FRAME) {
+        SetError(ImagingError::IMAGING_ERR_CALIBRATION,
+                 "Calibration data is not a dark frame", "OffsetCorrection");
+        return false;
+    }
+
+    const CalibrationData& gain = *config.calibration_gain;
+    if (!ValidateCalibration(gain, frame)) {
+        SetError(ImagingError::IMAGING_ERR_CALIBRATION,
+                 "Invalid gain calibration data", "GainCorrection");
+        return false;
+    }
+    if (gain.type != CalibrationDataType::GAIN_MAP) {
+        SetError(ImagingError::IMAGING_ERR_CALIBRATION,
+                 "Calibration data is not a gain map", "GainCorrection");
+        return false;
+    }
+
+    binding.dark = &dark;
+    binding.gain = &gain;
+    binding.defect_map = config.defect_map;
+    return true;
+}
+
+bool DefaultImageProcessingEngine::WriteOutputFrame(
+    ImageBuffer& frame, const ProcessingConfig& config,
+    const cv::Mat& plane, uint64_t& bytes) {
+
+    if (config.window <= 0.0f) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Window width must be positive", "WindowLevel");
+        return false;
+    }
+    if (!output_writer_.Prepare(config.output, frame.width, frame.height)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid output transform", "OutputTransform");
+        return false;
+    }
+
+    const OutputTransform& output = config.output;
+    const uint32_t out_width = output_writer_.OutputWidth();
+    const uint32_t out_height = output_writer_.OutputHeight();
+    const uint64_t out_pixels = internal::Pixels(out_width, out_height);
+    const size_t out_stride = static_cast<size_t>(out_width) * sizeof(uint16_t);
+    const float win_min = config.level - config.window / 2.0f;
+    const float scale = 65535.0f / config.window;
+
+    if (!plane.empty()) {
+        // The plane is separate from the frame: write straight into it
+        const float* src = reinterpret_cast<const float*>(
+            plane.data + output.crop_y * plane.step) + output.crop_x;
+        output_writer_.WriteF32(src, plane.step, scale, -win_min * scale,
+                                frame.data, out_stride);
+        bytes = out_pixels * internal::kOutputPlaneBytes;
+    } else {
+        const uint16_t* lut = WindowLevelLut(config.window, config.level);
+        const uint16_t* src = reinterpret_cast<const uint16_t*>(
+            reinterpret_cast<const uint8_t*>(frame.data) + output.crop_y * frame.stride) +
+            output.crop_x;
+        size_t src_stride = frame.stride;
+        bytes = out_pixels * internal::kOutputU16Bytes;
+
+        if (!output_writer_.CanWriteInPlace()) {
+            // Flipped or rotated output would overwrite pixels still to be read
+            const uint32_t crop_width = output_writer_.CropWidth();
+            const uint32_t crop_height = output_writer_.CropHeight();
+            const size_t copy_stride = static_cast<size_t>(crop_width) * sizeof(uint16_t);
+            const size_t copy_bytes = copy_stride * crop_height;
+            if (output_source_.Capacity() < copy_bytes) {
+                output_source_.Reset();
+                output_source_ = infra::FramePool::Default().Acquire(copy_bytes);
+                if (!output_source_) {
+                    SetError(ImagingError::IMAGING_ERR_MEMORY,
+                             "Output transform buffer allocation failed", "OutputTransform");
+                    return false;
                 }
             }
+            for (uint32_t y = 0; y < crop_height; ++y) {
+                std::memcpy(output_source_.Data() + y * copy_stride,
+                            reinterpret_cast<const uint8_t*>(src) + y * src_stride,
+                            copy_stride);
+            }
+            src = reinterpret_cast<const uint16_t*>(output_source_.Data());
+            src_stride = copy_stride;
+            bytes += internal::Pixels(crop_width, crop_height) * internal::kOutputCopyBytes;
         }
+
+        output_writer_.WriteU16(src, src_stride, lut, frame.data, out_stride);
     }
 
-    if (found) {
-        mat.at<uint16_t>(y, x) = neighbor_value;
+    frame.width = out_width;
+    frame.height = out_height;
+    frame.stride = static_cast<uint32_t>(out_stride);
+    return true;
+}
+
+const uint16_t* DefaultImageProcessingEngine::WindowLevelLut(float window, float level) {
+    // Same mapping as ApplyWindowLevel(), one lookup per pixel
+    if (wl_lut_.empty() || wl_lut_window_ != window || wl_lut_level_ != level) {
+        const float win_min = level - window / 2.0f;
+        const float scale = 65535.0f / window;
+        wl_lut_.resize(65536);
+        for (uint32_t v = 0; v < wl_lut_.size(); ++v) {
+            float value = (static_cast<float>(v) - win_min) * scale;
+            wl_lut_[v] = static_cast<uint16_t>(std::max(0.0f, std::min(65535.0f, value)));
+        }
+        wl_lut_window_ = window;
+        wl_lut_level_ = level;
     }
+    return wl_lut_.data();
 }
 
-void DefaultImageProcessingEngine::ApplyBilinear(
-    cv::Mat& mat, uint32_t x, uint32_t y) {
+bool DefaultImageProcessingEngine::RunClahe(
+    ImageBuffer& frame, const ProcessingConfig& config,
+    bool fold_window_level, StageTiming& timing) {
 
-    // Simple bilinear interpolation from 4 neighbors
-    int x0 = std::max(0, static_cast<int>(x) - 1);
-    int x1 = std::min(mat.cols - 1, static_cast<int>(x) + 1);
-    int y0 = std::max(0, static_cast<int>(y) - 1);
-    int y1 = std::min(mat.rows - 1, static_cast<int>(y) + 1);
+    const uint16_t* post_lut = nullptr;
+    if (fold_window_level) {
+        if (config.window <= 0.0f) {
+            SetError(ImagingError::IMAGING_ERR_PARAM,
+                     "Window width must be positive", "WindowLevel");
+            return false;
+        }
+        post_lut = WindowLevelLut(config.window, config.level);
+    }
+    if (!clahe_) {
+        clahe_ = std::make_unique<ClaheProcessor>(config_.num_threads);
+    }
 
-    // Avoid using the defective pixel itself
-    uint16_t tl = mat.at<uint16_t>(y0, x0);
-    uint16_t tr = mat.at<uint16_t>(y0, x1);
-    uint16_t bl = mat.at<uint16_t>(y1, x0);
-    uint16_t br = mat.at<uint16_t>(y1, x1);
+    auto start = infra::MonotonicClock::now();
+    if (!clahe_->Apply(frame.data, frame.width, frame.height, frame.stride,
+                       config.clahe, post_lut)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid CLAHE configuration", "CLAHE");
+        return false;
+    }
+    auto end = infra::MonotonicClock::now();
+    timing.clahe_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    timing.clahe_bytes =
+        internal::Pixels(frame.width, frame.height) * internal::kClaheBytes;
+    return true;
+}
+
+bool DefaultImageProcessingEngine::ObserveDarkFrame(
+    const ImageBuffer& frame, const ProcessingConfig& config) {
+
+    if (!initialized_) {
+        SetError(ImagingError::IMAGING_ERR_INIT,
+                 "Engine not initialized", "DefectDetection");
+        return false;
+    }
+    if (!ValidateFrame(frame)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid frame buffer", "DefectDetection");
+        return false;
+    }
+    if (!config.defect_detection.enabled ||
+        !ValidateDefectDetectionConfig(config.defect_detection)) {
+        SetError(ImagingError::IMAGING_ERR_PARAM,
+                 "Invalid defect detection configuration", "DefectDetection");
+        return false;
+    }
+
+    const DefectMap* known = config.defect_map;
+    if (config.calibration != nullptr) {
+        if (!BindCalibration(config.calibration, frame)) {
+            return false;
+        }
+        known = bound_.defect_map;
+    }
 
-    // Average of neighbors
-    uint32_t sum = static_cast<uint32_t>(tl) + tr + bl + br;
-    mat.at<uint16_t>(y, x) = static_cast<uint16_t>(sum / 4);
+    StageTiming timing;
+    ObserveDefects(frame, known, true, config.defect_detection, timing);
+    ClearError();
+    return true;
 }
 
-void DefaultImageProcessingEngine::ApplyMedian3x3(
-    cv::Mat& mat, uint32_t x, uint32_t y) {
+void DefaultImageProcessingEngine::ClearDynamicDefects() {
+    defect_detector_.Reset();
+    dynamic_defects_.reset();
+}
 
-    // Collect 3x3 neighborhood values
-    std::vector<uint16_t> values;
-    values.reserve(9);
+void DefaultImageProcessingEngine::ObserveDefects(
+    const ImageBuffer& frame, const DefectMap* known, bool dark_frame,
+    const DefectDetectionConfig& config, StageTiming& timing) {
 
-    for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-            int nx = static_cast<int>(x) + dx;
-            int ny = static_cast<int>(y) + dy;
-            if (nx >= 0 && nx < mat.cols && ny >= 0 && ny < mat.rows) {
-                if (dx != 0 || dy != 0) {  // Exclude the defective pixel
-                    values.push_back(mat.at<uint16_t>(ny, nx));
-                }
-            }
+    auto start = infra::MonotonicClock::now();
+
+    // Statistics and promotions belong to one geometry
+    if (dynamic_defects_ &&
+        (dynamic_defects_->Width() != frame.width || dynamic_defects_->Height() != frame.height)) {
+        dynamic_defects_.reset();
+    }
+
+    // Re-marking the calibrated defects is O(count) and follows calibration
+    // changes without tracking them
+    if (known != nullptr && known->valid) {
+        defect_detector_.Exclude(*known, frame.width, frame.height);
+    }
+
+    if (defect_detector_.Observe(frame.data, frame.width, frame.height, frame.stride,
+                                 dark_frame, config) > 0) {
+        std::vector<DefectPixelEntry> promoted = defect_detector_.TakePromoted();
+        dynamic_defects_ = dynamic_defects_
+            ? DefectPlan::Merge(dynamic_defects_, std::move(promoted))
+            : DefectPlan::Create(frame.width, frame.height, std::move(promoted));
+    }
+
+    auto end = infra::MonotonicClock::now();
+    timing.defect_detection_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    const uint32_t rows_per_observed = dark_frame ? 1 : config.row_interleave;
+    timing.defect_detection_bytes = internal::Pixels(frame.width, frame.height) *
+                                    internal::kDefectDetectionBytes / rows_per_observed;
+}
+
+const DefectMap* DefaultImageProcessingEngine::DynamicDefectMap(
+    uint32_t width, uint32_t height) const {
+
+    if (!dynamic_defects_) {
+        return nullptr;
+    }
+    const DefectMap* map = dynamic_defects_->ForGeometry(width, height);
+    return map != nullptr && map->count > 0 ? map : nullptr;
+}
+
+cv::Mat DefaultImageProcessingEngine::WorkingPlane(uint32_t width, uint32_t height) {
+    // Pad rows to whole cache lines so no row shares a line with the next
+    const size_t row_bytes = static_cast<size_t>(width) * sizeof(float);
+    const size_t step = (row_bytes + infra::kCacheLineSize - 1) /
+                        infra::kCacheLineSize * infra::kCacheLineSize;
+    const size_t bytes = step * height;
+
+    if (working_plane_.Capacity() < bytes) {
+        working_plane_.Reset();
+        working_plane_ = infra::FramePool::Default().Acquire(bytes);
+        if (!working_plane_) {
+            return cv::Mat();
         }
     }
+    return cv::Mat(static_cast<int>(height), static_cast<int>(width), CV_32FC1,
+                   working_plane_.Data(), step);
+}
+
+void DefaultImageProcessingEngine::ApplyNearestNeighbor(
+    cv::Mat& mat, uint32_t x, uint32_t y) {
+
+    if (mat.depth() == CV_32F) {
+        internal::NearestNeighbor<float>(mat, x, y);
+    } else {
+        internal::NearestNeighbor<uint16_t>(mat, x, y);
+    }
+}
 
-    if (!values.empty()) {
-        std::sort(values.begin(), values.end());
-        mat.at<uint16_t>(y, x) = values[values.size() / 2];
+void DefaultImageProcessingEngine::ApplyBilinear(
+    cv::Mat& mat, uint32_t x, uint32_t y) {
+
+    if (mat.depth() == CV_32F) {
+        internal::Bilinear<float>(mat, x, y);
+    } else {
+        internal::Bilinear<uint16_t>(mat, x, y);
+    }
+}
+
+void DefaultImageProcessingEngine::ApplyMedian3x3(
+    cv::Mat& mat, uint32_t x, uint32_t y) {
+
+    if (mat.depth() == CV_32F) {
+        internal::Median3x3<float>(mat, x, y);
+    } else {
+        internal::Median3x3<uint16_t>(mat, x, y);
     }
 }
 
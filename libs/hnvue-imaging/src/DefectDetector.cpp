@@ -0,0 +1,298 @@
+/**
+ * @file DefectDetector.cpp
+ * @brief Online detection of defective pixels between calibrations
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Dynamic defect pixel detection
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/DefectDetector.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HNVUE_DEFECT_HAS_SSE2 1
+#else
+    #define HNVUE_DEFECT_HAS_SSE2 0
+#endif
+
+namespace hnvue::imaging {
+
+namespace {
+
+/// Score added by an outlier; a flat inlier subtracts 1
+constexpr uint8_t kOutlierStep = 2;
+
+bool ValidFraction(float value) {
+    return std::isfinite(value) && value >= 0.0f && value < 1.0f;
+}
+
+/**
+ * @brief Fraction as a 0.16 fixed-point multiplier
+ */
+uint16_t ToQ16(float value) {
+    return static_cast<uint16_t>(std::min(65535.0f, std::round(value * 65536.0f)));
+}
+
+inline uint16_t Saturate16(uint32_t value) {
+    return static_cast<uint16_t>(std::min<uint32_t>(value, 65535u));
+}
+
+inline uint16_t AbsDiff(uint16_t a, uint16_t b) {
+    return static_cast<uint16_t>(a > b ? a - b : b - a);
+}
+
+/**
+ * @brief Middle two of the four direct neighbours, in either order
+ */
+inline void MiddlePair(uint16_t l, uint16_t r, uint16_t u, uint16_t d,
+                       uint16_t& a, uint16_t& b) {
+    a = std::max(std::min(l, r), std::min(u, d));
+    b = std::min(std::max(l, r), std::max(u, d));
+}
+
+} // anonymous namespace
+
+bool ValidateDefectDetectionConfig(const DefectDetectionConfig& config) {
+    return ValidFraction(config.relative_threshold) &&
+           ValidFraction(config.flat_threshold) &&
+           config.promote_score >= 2 && config.promote_score <= kDefectMaxPromoteScore &&
+           config.row_interleave > 0;
+}
+
+/**
+ * @brief Thresholds of one frame in the form the kernels use
+ */
+struct DefectDetector::Thresholds {
+    uint16_t relative_q16 = 0;
+    uint16_t flat_q16 = 0;
+    uint16_t absolute = 0;
+    uint16_t flat_absolute = 0;
+    uint8_t promote = 0;
+    bool dark = false;
+};
+
+// =============================================================================
+// Observation
+// =============================================================================
+
+uint32_t DefectDetector::Observe(const uint16_t* data, uint32_t width, uint32_t height,
+                                 size_t stride, bool dark_frame,
+                                 const DefectDetectionConfig& config) {
+    if (data == nullptr || width == 0 || height == 0 ||
+        stride < static_cast<size_t>(width) * sizeof(uint16_t) ||
+        !ValidateDefectDetectionConfig(config)) {
+        return 0;
+    }
+    Resize(width, height);
+
+    Thresholds t;
+    t.relative_q16 = ToQ16(config.relative_threshold);
+    t.flat_q16 = ToQ16(config.flat_threshold);
+    t.absolute = config.absolute_threshold;
+    t.flat_absolute = static_cast<uint16_t>(config.absolute_threshold / 2);
+    t.promote = config.promote_score;
+    t.dark = dark_frame;
+
+    // Dark frames observe every row and leave the clinical rotation alone
+    const uint32_t step = dark_frame ? 1 : config.row_interleave;
+    const uint32_t first = dark_frame ? 0 : phase_ % step;
+    promoted_now_ = 0;
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    auto row_at = [&](uint32_t y) {
+        return reinterpret_cast<const uint16_t*>(bytes + static_cast<size_t>(y) * stride);
+    };
+    if (width >= 3) {
+        for (uint32_t y = 1 + first; y + 1 < height; y += step) {
+            ObserveRow(row_at(y - 1), row_at(y), row_at(y + 1), y, t);
+        }
+    }
+
+    if (!dark_frame) {
+        phase_ = (first + 1) % step;
+    }
+    ++frames_;
+    return promoted_now_;
+}
+
+void DefectDetector::ObserveRow(const uint16_t* up, const uint16_t* row, const uint16_t* down,
+                                uint32_t y, const Thresholds& t) {
+    uint32_t x = 1;
+#if HNVUE_DEFECT_HAS_SSE2
+    uint8_t* scores = scores_.data() + static_cast<size_t>(y) * width_;
+
+    // Biased signed min/max (SSE2 has no unsigned 16-bit min/max)
+    const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(-1);
+    const __m128i relative = _mm_set1_epi16(static_cast<int16_t>(t.relative_q16));
+    const __m128i flat = _mm_set1_epi16(static_cast<int16_t>(t.flat_q16));
+    const __m128i absolute = _mm_set1_epi16(static_cast<int16_t>(t.absolute));
+    const __m128i flat_absolute = _mm_set1_epi16(static_cast<int16_t>(t.flat_absolute));
+    const __m128i locked = _mm_set1_epi8(static_cast<char>(kDefectScoreLocked));
+    const __m128i step = _mm_set1_epi8(static_cast<char>(kOutlierStep));
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i promote = _mm_set1_epi8(static_cast<char>(t.promote));
+    const __m128i all_flat = t.dark ? ones : zero;
+
+    for (; x + 9 <= width_; x += 8) {
+        auto load = [&](const uint16_t* p) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        };
+        const __m128i c = load(row + x);
+        const __m128i l = _mm_xor_si128(load(row + x - 1), bias);
+        const __m128i r = _mm_xor_si128(load(row + x + 1), bias);
+        const __m128i u = _mm_xor_si128(load(up + x), bias);
+        const __m128i d = _mm_xor_si128(load(down + x), bias);
+        const __m128i a = _mm_xor_si128(
+            _mm_max_epi16(_mm_min_epi16(l, r), _mm_min_epi16(u, d)), bias);
+        const __m128i b = _mm_xor_si128(
+            _mm_min_epi16(_mm_max_epi16(l, r), _mm_max_epi16(u, d)), bias);
+
+        const __m128i median = _mm_avg_epu16(a, b);
+        const __m128i spread = _mm_or_si128(_mm_subs_epu16(a, b), _mm_subs_epu16(b, a));
+        const __m128i deviation = _mm_or_si128(_mm_subs_epu16(c, median),
+                                               _mm_subs_epu16(median, c));
+        const __m128i tolerance = _mm_adds_epu16(_mm_mulhi_epu16(median, relative), absolute);
+        const __m128i flat_tolerance =
+            _mm_adds_epu16(_mm_mulhi_epu16(median, flat), flat_absolute);
+
+        // x > y  <=>  saturating x - y != 0
+        const __m128i outlier16 = _mm_xor_si128(
+            _mm_cmpeq_epi16(_mm_subs_epu16(deviation, tolerance), zero), ones);
+        const __m128i flat16 = _mm_or_si128(
+            _mm_cmpeq_epi16(_mm_subs_epu16(spread, flat_tolerance), zero), all_flat);
+        const __m128i outlier8 = _mm_packs_epi16(outlier16, outlier16);
+        const __m128i flat8 = _mm_packs_epi16(flat16, flat16);
+
+        const __m128i score = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(scores + x));
+        const __m128i is_locked = _mm_cmpeq_epi8(score, locked);
+        const __m128i updated = _mm_or_si128(
+            _mm_and_si128(outlier8, _mm_adds_epu8(score, step)),
+            _mm_andnot_si128(outlier8, _mm_subs_epu8(score, one)));
+        const __m128i keep = _mm_or_si128(is_locked, _mm_andnot_si128(flat8, ones));
+        const __m128i next = _mm_or_si128(_mm_and_si128(keep, score),
+                                          _mm_andnot_si128(keep, updated));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(scores + x), next);
+
+        // next >= promote on lanes that were not locked already
+        const __m128i reached = _mm_andnot_si128(
+            is_locked, _mm_cmpeq_epi8(_mm_max_epu8(next, promote), next));
+        const int lanes = _mm_movemask_epi8(reached) & 0xFF;
+        if (lanes != 0) {
+            for (uint32_t i = 0; i < 8; ++i) {
+                if (lanes & (1 << i)) {
+                    const uint32_t px = x + i;
+                    uint16_t pa = 0;
+                    uint16_t pb = 0;
+                    MiddlePair(row[px - 1], row[px + 1], up[px], down[px], pa, pb);
+                    Promote(px, y, row[px], static_cast<uint16_t>((pa + pb + 1u) >> 1));
+                }
+            }
+        }
+    }
+#endif
+    for (; x + 1 < width_; ++x) {
+        UpdatePixel(up, row, down, x, y, t);
+    }
+}
+
+void DefectDetector::UpdatePixel(const uint16_t* up, const uint16_t* row, const uint16_t* down,
+                                 uint32_t x, uint32_t y, const Thresholds& t) {
+    uint8_t& score = scores_[static_cast<size_t>(y) * width_ + x];
+    if (score == kDefectScoreLocked) {
+        return;
+    }
+
+    uint16_t a = 0;
+    uint16_t b = 0;
+    MiddlePair(row[x - 1], row[x + 1], up[x], down[x], a, b);
+    const uint16_t median = static_cast<uint16_t>((a + b + 1u) >> 1);
+    const uint16_t tolerance =
+        Saturate16(((static_cast<uint32_t>(median) * t.relative_q16) >> 16) + t.absolute);
+    const uint16_t flat_tolerance =
+        Saturate16(((static_cast<uint32_t>(median) * t.flat_q16) >> 16) + t.flat_absolute);
+
+    if (!t.dark && AbsDiff(a, b) > flat_tolerance) {
+        return;
+    }
+    if (AbsDiff(row[x], median) > tolerance) {
+        score = static_cast<uint8_t>(std::min(255, score + kOutlierStep));
+    } else if (score > 0) {
+        --score;
+    }
+    if (score >= t.promote) {
+        Promote(x, y, row[x], median);
+    }
+}
+
+void DefectDetector::Promote(uint32_t x, uint32_t y, uint16_t value, uint16_t median) {
+    scores_[static_cast<size_t>(y) * width_ + x] = kDefectScoreLocked;
+
+    DefectPixelEntry entry;
+    entry.x = x;
+    entry.y = y;
+    entry.type = value > median ? DefectPixelType::HOT_PIXEL : DefectPixelType::DEAD_PIXEL;
+    entry.interpolation = InterpolationMethod::MEDIAN_3X3;
+    promoted_.push_back(entry);
+    ++promoted_now_;
+}
+
+// =============================================================================
+// State
+// =============================================================================
+
+void DefectDetector::Exclude(const DefectMap& known, uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+    Resize(width, height);
+    if (known.pixels == nullptr) {
+        return;
+    }
+    for (uint32_t i = 0; i < known.count; ++i) {
+        const DefectPixelEntry& p = known.pixels[i];
+        if (p.x < width_ && p.y < height_) {
+            scores_[static_cast<size_t>(p.y) * width_ + p.x] = kDefectScoreLocked;
+        }
+    }
+}
+
+std::vector<DefectPixelEntry> DefectDetector::TakePromoted() {
+    std::vector<DefectPixelEntry> taken;
+    taken.swap(promoted_);
+    return taken;
+}
+
+void DefectDetector::Reset() {
+    width_ = 0;
+    height_ = 0;
+    phase_ = 0;
+    frames_ = 0;
+    scores_.clear();
+    promoted_.clear();
+}
+
+uint8_t DefectDetector::Score(uint32_t x, uint32_t y) const {
+    if (x >= width_ || y >= height_) {
+        return 0;
+    }
+    return scores_[static_cast<size_t>(y) * width_ + x];
+}
+
+void DefectDetector::Resize(uint32_t width, uint32_t height) {
+    if (width == width_ && height == height_) {
+        return;
+    }
+    Reset();
+    width_ = width;
+    height_ = height;
+    scores_.assign(static_cast<size_t>(width) * height, 0);
+}
+
+} // namespace hnvue::imaging
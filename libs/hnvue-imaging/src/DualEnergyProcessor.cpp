@@ -0,0 +1,897 @@
+/**
+ * @file DualEnergyProcessor.cpp
+ * @brief Dual-energy subtraction of paired high/low-kVp exposures
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Dual-energy soft-tissue / bone separation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/DualEnergyProcessor.h"
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HNVUE_DUAL_ENERGY_HAS_SSE2 1
+#else
+    #define HNVUE_DUAL_ENERGY_HAS_SSE2 0
+#endif
+
+namespace hnvue::imaging {
+
+namespace {
+
+/// Pixels per subtraction kernel call (sample run length)
+constexpr uint32_t kSampleRun = 64;
+
+/// Pyramid rows per build task
+constexpr uint32_t kPyramidRowBlock = 32;
+
+/// Least variance (counts^2 per pixel) of a matchable window
+constexpr double kMinVariance = 0.25;
+
+constexpr float kLn2 = 0.69314718f;
+
+/// log2(1 + t) ~ t * (c1 + t * (c2 + ...)), t in [0, 1), |error| < 2.1e-6
+constexpr float kLog2C1 = 1.4425531980609634f;
+constexpr float kLog2C2 = -0.7182829207284116f;
+constexpr float kLog2C3 = 0.4582765043172999f;
+constexpr float kLog2C4 = -0.2795516877710433f;
+constexpr float kLog2C5 = 0.12346570562372215f;
+constexpr float kLog2C6 = -0.026462890453907484f;
+
+/**
+ * @brief First pixel of block index along an axis of size length
+ */
+inline uint32_t BlockStart(uint32_t index, uint32_t blocks, uint32_t length) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(index) * length / blocks);
+}
+
+/**
+ * @brief Neighbouring block centres of a position and weight of the second
+ *
+ * Before the first and after the last centre both blocks are the same.
+ */
+void Neighbours(const std::vector<float>& centres, float position,
+                uint32_t& block0, uint32_t& block1, float& weight) {
+    const uint32_t last = static_cast<uint32_t>(centres.size()) - 1;
+    if (position <= centres[0]) {
+        block0 = block1 = 0;
+        weight = 0.0f;
+        return;
+    }
+    if (position >= centres[last]) {
+        block0 = block1 = last;
+        weight = 0.0f;
+        return;
+    }
+    block0 = static_cast<uint32_t>(
+        std::upper_bound(centres.begin(), centres.end(), position) - centres.begin()) - 1;
+    block1 = block0 + 1;
+    weight = (position - centres[block0]) / (centres[block1] - centres[block0]);
+}
+
+/**
+ * @brief Scalar log2 with the same approximation as the SIMD kernel (v >= 1)
+ */
+inline float Log2(float v) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float m = 0.0f;
+    std::memcpy(&m, &bits, sizeof(m));
+    const float t = m - 1.0f;
+    float p = kLog2C6;
+    p = p * t + kLog2C5;
+    p = p * t + kLog2C4;
+    p = p * t + kLog2C3;
+    p = p * t + kLog2C2;
+    p = p * t + kLog2C1;
+    return exponent + p * t;
+}
+
+#if HNVUE_DUAL_ENERGY_HAS_SSE2
+/**
+ * @brief log2 of four values >= 1: exponent bits plus a mantissa polynomial
+ */
+inline __m128 Log2(__m128 v) {
+    const __m128i bits = _mm_castps_si128(v);
+    const __m128 exponent = _mm_cvtepi32_ps(
+        _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    const __m128 m = _mm_castsi128_ps(_mm_or_si128(
+        _mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+    const __m128 t = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+    __m128 p = _mm_set1_ps(kLog2C6);
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kLog2C5));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kLog2C4));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kLog2C3));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kLog2C2));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kLog2C1));
+    return _mm_add_ps(exponent, _mm_mul_ps(p, t));
+}
+#endif
+
+/**
+ * @brief out = offset + high * log2(H) - low * log2(L), per output image
+ */
+struct Subtraction {
+    float high = 0.0f;
+    float low = 0.0f;
+    float offset = 0.0f;
+
+    /**
+     * @param weight Low-energy weight
+     * @param gain Output counts per unit of ln
+     * @param out_offset Output value at value = 0
+     */
+    Subtraction(float weight, float gain, float out_offset) {
+        // ln(H / 65535) - w ln(L / 65535) = ln2 (log2 H - w log2 L - (1 - w) log2 65535)
+        const float scale = gain * kLn2;
+        high = scale;
+        low = scale * weight;
+        offset = out_offset - scale * (1.0f - weight) * std::log2(65535.0f);
+    }
+
+    uint16_t operator()(float log_high, float log_low) const {
+        const float v = offset + high * log_high - low * log_low;
+        return static_cast<uint16_t>(std::max(0.0f, std::min(65535.0f, v)) + 0.5f);
+    }
+};
+
+/**
+ * @brief Both subtractions of a run of samples (values >= 1)
+ */
+void SubtractRun(const float* high, const float* low, uint32_t count,
+                 const Subtraction& soft, const Subtraction& bone,
+                 uint16_t* soft_out, uint16_t* bone_out) {
+    uint32_t x = 0;
+#if HNVUE_DUAL_ENERGY_HAS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 full = _mm_set1_ps(65535.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    // Rounded, then biased into int16 range for the signed pack
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i unbias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    auto quantise = [&](__m128 v) {
+        v = _mm_min_ps(full, _mm_max_ps(zero, v));
+        return _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(v, half)), bias);
+    };
+    auto combine = [](const Subtraction& s, __m128 lh, __m128 ll) {
+        return _mm_sub_ps(_mm_add_ps(_mm_set1_ps(s.offset), _mm_mul_ps(_mm_set1_ps(s.high), lh)),
+                          _mm_mul_ps(_mm_set1_ps(s.low), ll));
+    };
+    for (; x + 8 <= count; x += 8) {
+        const __m128 lh0 = Log2(_mm_loadu_ps(high + x));
+        const __m128 lh1 = Log2(_mm_loadu_ps(high + x + 4));
+        const __m128 ll0 = Log2(_mm_loadu_ps(low + x));
+        const __m128 ll1 = Log2(_mm_loadu_ps(low + x + 4));
+        const __m128i s = _mm_xor_si128(_mm_packs_epi32(quantise(combine(soft, lh0, ll0)),
+                                                        quantise(combine(soft, lh1, ll1))),
+                                        unbias);
+        const __m128i b = _mm_xor_si128(_mm_packs_epi32(quantise(combine(bone, lh0, ll0)),
+                                                        quantise(combine(bone, lh1, ll1))),
+                                        unbias);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(soft_out + x), s);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bone_out + x), b);
+    }
+#endif
+    for (; x < count; ++x) {
+        const float lh = Log2(high[x]);
+        const float ll = Log2(low[x]);
+        soft_out[x] = soft(lh, ll);
+        bone_out[x] = bone(lh, ll);
+    }
+}
+
+template <typename T>
+inline const T* RowOf(const ImageBuffer& frame, uint32_t y) {
+    return reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(frame.data) +
+                                      static_cast<size_t>(y) * frame.stride);
+}
+
+inline uint16_t* RowOf(ImageBuffer& frame, uint32_t y) {
+    return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(frame.data) +
+                                       static_cast<size_t>(y) * frame.stride);
+}
+
+bool ValidBuffer(const ImageBuffer& frame, uint32_t width, uint32_t height) {
+    return frame.data != nullptr && frame.width == width && frame.height == height &&
+           frame.stride >= static_cast<size_t>(width) * sizeof(uint16_t);
+}
+
+/**
+ * @brief Median of count values (mean of the middle two for an even count)
+ */
+float Median(float* values, uint32_t count) {
+    const uint32_t half = count / 2;
+    std::nth_element(values, values + half, values + count);
+    const float upper = values[half];
+    if (count % 2 != 0) {
+        return upper;
+    }
+    return 0.5f * (upper + *std::max_element(values, values + half));
+}
+
+} // anonymous namespace
+
+bool ValidateDualEnergyConfig(const DualEnergyConfig& config, uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0 ||
+        !std::isfinite(config.soft_tissue_weight) || !std::isfinite(config.bone_weight) ||
+        !std::isfinite(config.gain) || !std::isfinite(config.soft_tissue_offset) ||
+        !std::isfinite(config.bone_offset)) {
+        return false;
+    }
+    if (!config.motion_compensation) {
+        return true;
+    }
+    return config.pyramid_levels >= 1 && config.pyramid_levels <= kDualEnergyMaxLevels &&
+           (config.block_size >> config.pyramid_levels) >= kDualEnergyMinBlock &&
+           config.search_radius <= kDualEnergyMaxSearch &&
+           std::isfinite(config.min_correlation) &&
+           width >= config.block_size && height >= config.block_size;
+}
+
+// =============================================================================
+// Worker Pool
+// =============================================================================
+
+/**
+ * @brief Persistent workers; the thread calling Run() takes part as worker 0
+ */
+struct DualEnergyProcessor::Pool {
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    bool stop = false;
+    uint32_t running = 0;                   ///< Workers still in the current job
+
+    const std::function<void(size_t, uint32_t)>* task = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+
+    std::vector<std::thread> threads;
+
+    void Drain(const std::function<void(size_t, uint32_t)>& job, size_t job_count,
+               uint32_t worker) {
+        for (size_t index = next.fetch_add(1); index < job_count; index = next.fetch_add(1)) {
+            job(index, worker);
+        }
+    }
+
+    void WorkerLoop(uint32_t worker) {
+        infra::ApplyNamedThreadPolicy(kThreadDualEnergyWorker);
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t, uint32_t)>* job = nullptr;
+            size_t job_count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_cv.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+                job = task;
+                job_count = count;
+            }
+            Drain(*job, job_count, worker);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+};
+
+DualEnergyProcessor::DualEnergyProcessor(uint32_t threads)
+    : pool_(std::make_unique<Pool>()) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (uint32_t worker = 1; worker < threads; ++worker) {
+        pool_->threads.emplace_back(&Pool::WorkerLoop, pool_.get(), worker);
+    }
+}
+
+DualEnergyProcessor::~DualEnergyProcessor() {
+    {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        pool_->stop = true;
+    }
+    pool_->start_cv.notify_all();
+    for (std::thread& thread : pool_->threads) {
+        thread.join();
+    }
+}
+
+uint32_t DualEnergyProcessor::ThreadCount() const {
+    return static_cast<uint32_t>(pool_->threads.size()) + 1;
+}
+
+void DualEnergyProcessor::Run(size_t count, const std::function<void(size_t, uint32_t)>& task) {
+    Pool& pool = *pool_;
+    if (pool.threads.empty() || count <= 1) {
+        for (size_t index = 0; index < count; ++index) {
+            task(index, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.task = &task;
+        pool.count = count;
+        pool.next.store(0);
+        pool.running = static_cast<uint32_t>(pool.threads.size());
+        ++pool.generation;
+    }
+    pool.start_cv.notify_all();
+    pool.Drain(task, count, 0);
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.done_cv.wait(lock, [&pool]() { return pool.running == 0; });
+    pool.task = nullptr;
+}
+
+// =============================================================================
+// Processing
+// =============================================================================
+
+bool DualEnergyProcessor::Process(const ImageBuffer& high, const ImageBuffer& low,
+                                  const DualEnergyConfig& config, ImageBuffer& soft_tissue,
+                                  ImageBuffer& bone) {
+    const uint32_t width = high.width;
+    const uint32_t height = high.height;
+    if (!ValidBuffer(high, width, height) || !ValidBuffer(low, width, height) ||
+        !ValidBuffer(soft_tissue, width, height) || !ValidBuffer(bone, width, height) ||
+        !ValidateDualEnergyConfig(config, width, height)) {
+        return false;
+    }
+    frame_width_ = width;
+    frame_height_ = height;
+
+    bool compensate = false;
+    if (config.motion_compensation) {
+        BuildPyramid(high, config.pyramid_levels, high_levels_);
+        BuildPyramid(low, config.pyramid_levels, low_levels_);
+        EstimateMotion(width, height, config);
+        for (const DualEnergyMotion& m : motion_) {
+            compensate |= m.dx != 0.0f || m.dy != 0.0f;
+        }
+    } else {
+        motion_.clear();
+        blocks_x_ = 0;
+        blocks_y_ = 0;
+    }
+
+    if (compensate) {
+        // Column -> neighbouring block centres and weight
+        column_block_.resize(width);
+        column_weight_.resize(width);
+        for (uint32_t x = 0; x < width; ++x) {
+            uint32_t block1 = 0;
+            Neighbours(block_centre_x_, static_cast<float>(x) + 0.5f,
+                       column_block_[x], block1, column_weight_[x]);
+        }
+        row_motion_.resize(static_cast<size_t>(ThreadCount()) * blocks_x_ * 2);
+    }
+    samples_.resize(static_cast<size_t>(ThreadCount()) * kSampleRun * 2);
+
+    const uint32_t bands = (height + kDualEnergyRowBlock - 1) / kDualEnergyRowBlock;
+    Run(bands, [&](size_t band, uint32_t worker) {
+        const uint32_t first = static_cast<uint32_t>(band) * kDualEnergyRowBlock;
+        const uint32_t end = std::min(height, first + kDualEnergyRowBlock);
+        if (compensate) {
+            SubtractRows(first, end, worker, high, low, config, soft_tissue, bone);
+        } else {
+            const Subtraction soft(config.soft_tissue_weight, config.gain,
+                                   config.soft_tissue_offset);
+            const Subtraction hard(config.bone_weight, config.gain, config.bone_offset);
+            float* h = samples_.data() + static_cast<size_t>(worker) * kSampleRun * 2;
+            float* l = h + kSampleRun;
+            for (uint32_t y = first; y < end; ++y) {
+                const uint16_t* hr = RowOf<uint16_t>(high, y);
+                const uint16_t* lr = RowOf<uint16_t>(low, y);
+                uint16_t* sr = RowOf(soft_tissue, y);
+                uint16_t* br = RowOf(bone, y);
+                for (uint32_t x = 0; x < width; x += kSampleRun) {
+                    const uint32_t n = std::min(kSampleRun, width - x);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        h[i] = static_cast<float>(std::max<uint16_t>(hr[x + i], 1));
+                        l[i] = static_cast<float>(std::max<uint16_t>(lr[x + i], 1));
+                    }
+                    SubtractRun(h, l, n, soft, hard, sr + x, br + x);
+                }
+            }
+        }
+    });
+
+    soft_tissue.timestamp_us = high.timestamp_us;
+    soft_tissue.frame_id = high.frame_id;
+    bone.timestamp_us = high.timestamp_us;
+    bone.frame_id = high.frame_id;
+    return true;
+}
+
+void DualEnergyProcessor::SubtractRows(uint32_t first, uint32_t end, uint32_t worker,
+                                       const ImageBuffer& high, const ImageBuffer& low,
+                                       const DualEnergyConfig& config,
+                                       ImageBuffer& soft_tissue, ImageBuffer& bone) {
+    const Subtraction soft(config.soft_tissue_weight, config.gain, config.soft_tissue_offset);
+    const Subtraction hard(config.bone_weight, config.gain, config.bone_offset);
+    const uint32_t width = frame_width_;
+    const uint32_t height = frame_height_;
+    const uint32_t last_block = blocks_x_ - 1;
+    const float max_x = static_cast<float>(width - 1);
+    const float max_y = static_cast<float>(height - 1);
+
+    float* h = samples_.data() + static_cast<size_t>(worker) * kSampleRun * 2;
+    float* l = h + kSampleRun;
+    float* row_motion = row_motion_.data() + static_cast<size_t>(worker) * blocks_x_ * 2;
+
+    for (uint32_t y = first; y < end; ++y) {
+        // Motion of each block column at this row
+        uint32_t by0 = 0;
+        uint32_t by1 = 0;
+        float wy = 0.0f;
+        Neighbours(block_centre_y_, static_cast<float>(y) + 0.5f, by0, by1, wy);
+        for (uint32_t bx = 0; bx < blocks_x_; ++bx) {
+            const DualEnergyMotion& a = motion_[static_cast<size_t>(by0) * blocks_x_ + bx];
+            const DualEnergyMotion& b = motion_[static_cast<size_t>(by1) * blocks_x_ + bx];
+            row_motion[bx * 2] = a.dx + (b.dx - a.dx) * wy;
+            row_motion[bx * 2 + 1] = a.dy + (b.dy - a.dy) * wy;
+        }
+
+        const uint16_t* hr = RowOf<uint16_t>(high, y);
+        uint16_t* sr = RowOf(soft_tissue, y);
+        uint16_t* br = RowOf(bone, y);
+        const float row_y = static_cast<float>(y);
+
+        // Bilinear low-frame sample at column x, clamped to the frame
+        auto sample = [&](uint32_t x) {
+            const uint32_t b0 = column_block_[x];
+            const uint32_t b1 = std::min(b0 + 1, last_block);
+            const float wx = column_weight_[x];
+            const float dx = row_motion[b0 * 2] + (row_motion[b1 * 2] - row_motion[b0 * 2]) * wx;
+            const float dy =
+                row_motion[b0 * 2 + 1] + (row_motion[b1 * 2 + 1] - row_motion[b0 * 2 + 1]) * wx;
+            const float sx = std::max(0.0f, std::min(max_x, static_cast<float>(x) + dx));
+            const float sy = std::max(0.0f, std::min(max_y, row_y + dy));
+            const uint32_t ix0 = std::min(static_cast<uint32_t>(sx), width - 2);
+            const uint32_t iy0 = std::min(static_cast<uint32_t>(sy), height - 2);
+            const float fx = sx - static_cast<float>(ix0);
+            const float fy = sy - static_cast<float>(iy0);
+            const uint16_t* l0 = RowOf<uint16_t>(low, iy0) + ix0;
+            const uint16_t* l1 = RowOf<uint16_t>(low, iy0 + 1) + ix0;
+            const float top = l0[0] + (static_cast<float>(l0[1]) - l0[0]) * fx;
+            const float bottom = l1[0] + (static_cast<float>(l1[1]) - l1[0]) * fx;
+            return std::max(1.0f, top + (bottom - top) * fy);
+        };
+
+        for (uint32_t x0 = 0; x0 < width; x0 += kSampleRun) {
+            const uint32_t n = std::min(kSampleRun, width - x0);
+            for (uint32_t i = 0; i < n; ++i) {
+                h[i] = static_cast<float>(std::max<uint16_t>(hr[x0 + i], 1));
+            }
+            uint32_t i = 0;
+#if HNVUE_DUAL_ENERGY_HAS_SSE2
+            // Four columns between the same pair of block centres at a time;
+            // the corner loads stay scalar (SSE2 has no gather)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 vmax_x = _mm_set1_ps(max_x);
+            const __m128 vmax_y = _mm_set1_ps(max_y);
+            const __m128 last_x = _mm_set1_ps(static_cast<float>(width - 2));
+            const __m128 last_y = _mm_set1_ps(static_cast<float>(height - 2));
+            alignas(16) int32_t ix[4];
+            alignas(16) int32_t iy[4];
+            for (; i + 4 <= n; i += 4) {
+                const uint32_t x = x0 + i;
+                const uint32_t b0 = column_block_[x];
+                if (column_block_[x + 3] != b0) {
+                    for (uint32_t k = 0; k < 4; ++k) {
+                        l[i + k] = sample(x + k);
+                    }
+                    continue;
+                }
+                const uint32_t b1 = std::min(b0 + 1, last_block);
+                const __m128 wx = _mm_loadu_ps(column_weight_.data() + x);
+                const __m128 dx0 = _mm_set1_ps(row_motion[b0 * 2]);
+                const __m128 dy0 = _mm_set1_ps(row_motion[b0 * 2 + 1]);
+                const __m128 dx = _mm_add_ps(
+                    dx0, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(row_motion[b1 * 2]), dx0), wx));
+                const __m128 dy = _mm_add_ps(
+                    dy0, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(row_motion[b1 * 2 + 1]), dy0), wx));
+
+                const __m128 sx = _mm_max_ps(zero, _mm_min_ps(vmax_x, _mm_add_ps(
+                    _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lanes), dx)));
+                const __m128 sy = _mm_max_ps(zero, _mm_min_ps(vmax_y, _mm_add_ps(
+                    _mm_set1_ps(row_y), dy)));
+                const __m128 fx_floor = _mm_min_ps(last_x, _mm_cvtepi32_ps(_mm_cvttps_epi32(sx)));
+                const __m128 fy_floor = _mm_min_ps(last_y, _mm_cvtepi32_ps(_mm_cvttps_epi32(sy)));
+                const __m128 fx = _mm_sub_ps(sx, fx_floor);
+                const __m128 fy = _mm_sub_ps(sy, fy_floor);
+                _mm_store_si128(reinterpret_cast<__m128i*>(ix), _mm_cvttps_epi32(fx_floor));
+                _mm_store_si128(reinterpret_cast<__m128i*>(iy), _mm_cvttps_epi32(fy_floor));
+
+                alignas(16) int32_t corner[4][4];
+                for (uint32_t k = 0; k < 4; ++k) {
+                    const uint16_t* l0 = RowOf<uint16_t>(low, static_cast<uint32_t>(iy[k])) + ix[k];
+                    const uint16_t* l1 = RowOf<uint16_t>(low, static_cast<uint32_t>(iy[k]) + 1) + ix[k];
+                    corner[0][k] = l0[0];
+                    corner[1][k] = l0[1];
+                    corner[2][k] = l1[0];
+                    corner[3][k] = l1[1];
+                }
+                auto load = [](const int32_t* v) {
+                    return _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(v)));
+                };
+                const __m128 p00 = load(corner[0]);
+                const __m128 p01 = load(corner[1]);
+                const __m128 p10 = load(corner[2]);
+                const __m128 p11 = load(corner[3]);
+                const __m128 top = _mm_add_ps(p00, _mm_mul_ps(_mm_sub_ps(p01, p00), fx));
+                const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(_mm_sub_ps(p11, p10), fx));
+                _mm_storeu_ps(l + i, _mm_max_ps(one, _mm_add_ps(
+                    top, _mm_mul_ps(_mm_sub_ps(bottom, top), fy))));
+            }
+#endif
+            for (; i < n; ++i) {
+                l[i] = sample(x0 + i);
+            }
+            SubtractRun(h, l, n, soft, hard, sr + x0, br + x0);
+        }
+    }
+}
+
+// =============================================================================
+// Motion Estimation
+// =============================================================================
+
+void DualEnergyProcessor::BuildPyramid(const ImageBuffer& frame, uint32_t count,
+                                       std::vector<Level>& levels) {
+    levels.resize(count);
+    uint32_t width = frame.width;
+    uint32_t height = frame.height;
+    for (uint32_t n = 0; n < count; ++n) {
+        Level& level = levels[n];
+        level.width = width / 2;
+        level.height = height / 2;
+        level.pixels.resize(static_cast<size_t>(level.width) * level.height);
+
+        const Level* finer = n > 0 ? &levels[n - 1] : nullptr;
+        const uint32_t bands = (level.height + kPyramidRowBlock - 1) / kPyramidRowBlock;
+        Run(bands, [&](size_t band, uint32_t) {
+            const uint32_t first = static_cast<uint32_t>(band) * kPyramidRowBlock;
+            const uint32_t end = std::min(level.height, first + kPyramidRowBlock);
+            for (uint32_t y = first; y < end; ++y) {
+                float* dst = level.pixels.data() + static_cast<size_t>(y) * level.width;
+                if (finer == nullptr) {
+                    const uint16_t* r0 = RowOf<uint16_t>(frame, 2 * y);
+                    const uint16_t* r1 = RowOf<uint16_t>(frame, 2 * y + 1);
+                    for (uint32_t x = 0; x < level.width; ++x) {
+                        dst[x] = 0.25f * static_cast<float>(r0[2 * x] + r0[2 * x + 1] +
+                                                            r1[2 * x] + r1[2 * x + 1]);
+                    }
+                } else {
+                    const float* r0 = finer->pixels.data() + static_cast<size_t>(2 * y) * finer->width;
+                    const float* r1 = r0 + finer->width;
+                    for (uint32_t x = 0; x < level.width; ++x) {
+                        dst[x] = 0.25f * (r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1]);
+                    }
+                }
+            }
+        });
+        width = level.width;
+        height = level.height;
+    }
+}
+
+void DualEnergyProcessor::EstimateMotion(uint32_t width, uint32_t height,
+                                         const DualEnergyConfig& config) {
+    blocks_x_ = std::max(1u, width / config.block_size);
+    blocks_y_ = std::max(1u, height / config.block_size);
+    const size_t blocks = static_cast<size_t>(blocks_x_) * blocks_y_;
+    matched_.resize(blocks);
+    motion_.resize(blocks);
+
+    block_centre_x_.resize(blocks_x_);
+    block_centre_y_.resize(blocks_y_);
+    for (uint32_t i = 0; i < blocks_x_; ++i) {
+        block_centre_x_[i] = 0.5f * static_cast<float>(BlockStart(i, blocks_x_, width) +
+                                                       BlockStart(i + 1, blocks_x_, width));
+    }
+    for (uint32_t i = 0; i < blocks_y_; ++i) {
+        block_centre_y_[i] = 0.5f * static_cast<float>(BlockStart(i, blocks_y_, height) +
+                                                       BlockStart(i + 1, blocks_y_, height));
+    }
+
+    // Coarse to fine: full search at the top level, a neighbour climb below
+    // it, sub-pixel at level 1. Level 0 is not matched; its vectors are
+    // twice level 1's.
+    const uint32_t top = config.pyramid_levels;
+    const int32_t top_radius = static_cast<int32_t>(
+        std::max(1u, (config.search_radius + (1u << top) - 1) >> top));
+    Run(blocks, [&](size_t index, uint32_t) {
+        const uint32_t bx = static_cast<uint32_t>(index % blocks_x_);
+        const uint32_t by = static_cast<uint32_t>(index / blocks_x_);
+        float vx = 0.0f;
+        float vy = 0.0f;
+        float score = MatchBlock(top, bx, by, top_radius, top == 1, vx, vy);
+        for (uint32_t level = top - 1; level >= 1; --level) {
+            vx *= 2.0f;
+            vy *= 2.0f;
+            score = MatchBlock(level, bx, by, 1, level == 1, vx, vy);
+        }
+        DualEnergyMotion& m = matched_[index];
+        m.dx = 2.0f * vx;
+        m.dy = 2.0f * vy;
+        m.correlation = std::max(0.0f, score);
+        m.matched = score >= config.min_correlation;
+    });
+
+    // Vector median of the matched blocks in each 3x3 neighbourhood: removes
+    // isolated mismatches and fills featureless blocks. Blocks with no
+    // matched neighbour take the median of the whole field (0 without any).
+    float global_dx = 0.0f;
+    float global_dy = 0.0f;
+    {
+        std::vector<float> xs;
+        std::vector<float> ys;
+        for (const DualEnergyMotion& m : matched_) {
+            if (m.matched) {
+                xs.push_back(m.dx);
+                ys.push_back(m.dy);
+            }
+        }
+        if (!xs.empty()) {
+            global_dx = Median(xs.data(), static_cast<uint32_t>(xs.size()));
+            global_dy = Median(ys.data(), static_cast<uint32_t>(ys.size()));
+        }
+    }
+    for (uint32_t by = 0; by < blocks_y_; ++by) {
+        for (uint32_t bx = 0; bx < blocks_x_; ++bx) {
+            float xs[9];
+            float ys[9];
+            uint32_t count = 0;
+            for (uint32_t ny = by > 0 ? by - 1 : 0; ny <= std::min(by + 1, blocks_y_ - 1); ++ny) {
+                for (uint32_t nx = bx > 0 ? bx - 1 : 0; nx <= std::min(bx + 1, blocks_x_ - 1); ++nx) {
+                    const DualEnergyMotion& m = matched_[static_cast<size_t>(ny) * blocks_x_ + nx];
+                    if (m.matched) {
+                        xs[count] = m.dx;
+                        ys[count] = m.dy;
+                        ++count;
+                    }
+                }
+            }
+            const size_t index = static_cast<size_t>(by) * blocks_x_ + bx;
+            DualEnergyMotion& m = motion_[index];
+            m = matched_[index];
+            m.dx = count > 0 ? Median(xs, count) : global_dx;
+            m.dy = count > 0 ? Median(ys, count) : global_dy;
+        }
+    }
+}
+
+float DualEnergyProcessor::MatchBlock(uint32_t level, uint32_t bx, uint32_t by, int32_t radius,
+                                      bool refine, float& vx, float& vy) const {
+    const Level& a = high_levels_[level - 1];
+    const Level& b = low_levels_[level - 1];
+    const int32_t x0 = static_cast<int32_t>(BlockStart(bx, blocks_x_, frame_width_) >> level);
+    const int32_t x1 = static_cast<int32_t>(
+        std::min(BlockStart(bx + 1, blocks_x_, frame_width_) >> level, a.width));
+    const int32_t y0 = static_cast<int32_t>(BlockStart(by, blocks_y_, frame_height_) >> level);
+    const int32_t y1 = static_cast<int32_t>(
+        std::min(BlockStart(by + 1, blocks_y_, frame_height_) >> level, a.height));
+    const int32_t cx = static_cast<int32_t>(std::lround(vx));
+    const int32_t cy = static_cast<int32_t>(std::lround(vy));
+    if (x1 <= x0 || y1 <= y0) {
+        return 0.0f;
+    }
+
+    // Reference means keep the float sums small (texture, not brightness)
+    double mean_a = 0.0;
+    double mean_b = 0.0;
+    {
+        const int32_t bx0 = std::max(x0, -cx);
+        const int32_t bx1 = std::min(x1, static_cast<int32_t>(b.width) - cx);
+        const int32_t by0 = std::max(y0, -cy);
+        const int32_t by1 = std::min(y1, static_cast<int32_t>(b.height) - cy);
+        for (int32_t y = y0; y < y1; ++y) {
+            const float* row = a.pixels.data() + static_cast<size_t>(y) * a.width;
+            for (int32_t x = x0; x < x1; ++x) {
+                mean_a += row[x];
+            }
+        }
+        mean_a /= static_cast<double>(x1 - x0) * (y1 - y0);
+        if (bx1 > bx0 && by1 > by0) {
+            for (int32_t y = by0; y < by1; ++y) {
+                const float* row = b.pixels.data() + static_cast<size_t>(y + cy) * b.width + cx;
+                for (int32_t x = bx0; x < bx1; ++x) {
+                    mean_b += row[x];
+                }
+            }
+            mean_b /= static_cast<double>(bx1 - bx0) * (by1 - by0);
+        }
+    }
+    const float ma = static_cast<float>(mean_a);
+    const float mb = static_cast<float>(mean_b);
+    const int64_t min_overlap = static_cast<int64_t>(x1 - x0) * (y1 - y0) / 2;
+
+    // Sum and sum of squares of the mean-free block over a window
+    auto block_sums = [&](int32_t ox0, int32_t ox1, int32_t oy0, int32_t oy1,
+                          double& sa, double& saa) {
+        sa = 0.0;
+        saa = 0.0;
+        for (int32_t y = oy0; y < oy1; ++y) {
+            const float* ra = a.pixels.data() + static_cast<size_t>(y) * a.width;
+            float row_a = 0.0f;
+            float row_aa = 0.0f;
+            for (int32_t x = ox0; x < ox1; ++x) {
+                const float pa = ra[x] - ma;
+                row_a += pa;
+                row_aa += pa * pa;
+            }
+            sa += row_a;
+            saa += row_aa;
+        }
+    };
+    double full_sa = 0.0;
+    double full_saa = 0.0;
+    block_sums(x0, x1, y0, y1, full_sa, full_saa);
+
+    // NCC of the block against the low level shifted by (sx, sy); -1 if
+    // less than half the block overlaps the level
+    auto ncc = [&](int32_t sx, int32_t sy) -> float {
+        const int32_t ox0 = std::max(x0, -sx);
+        const int32_t ox1 = std::min(x1, static_cast<int32_t>(b.width) - sx);
+        const int32_t oy0 = std::max(y0, -sy);
+        const int32_t oy1 = std::min(y1, static_cast<int32_t>(b.height) - sy);
+        if (ox1 <= ox0 || oy1 <= oy0 ||
+            static_cast<int64_t>(ox1 - ox0) * (oy1 - oy0) < min_overlap) {
+            return -1.0f;
+        }
+        double sa = full_sa;
+        double saa = full_saa;
+        if (ox0 != x0 || ox1 != x1 || oy0 != y0 || oy1 != y1) {
+            block_sums(ox0, ox1, oy0, oy1, sa, saa);
+        }
+
+        double sb = 0.0;
+        double sbb = 0.0;
+        double sab = 0.0;
+        for (int32_t y = oy0; y < oy1; ++y) {
+            const float* ra = a.pixels.data() + static_cast<size_t>(y) * a.width;
+            const float* rb = b.pixels.data() + static_cast<size_t>(y + sy) * b.width + sx;
+            int32_t x = ox0;
+            float row_b = 0.0f;
+            float row_bb = 0.0f;
+            float row_ab = 0.0f;
+#if HNVUE_DUAL_ENERGY_HAS_SSE2
+            const __m128 vma = _mm_set1_ps(ma);
+            const __m128 vmb = _mm_set1_ps(mb);
+            __m128 vb = _mm_setzero_ps();
+            __m128 vbb = _mm_setzero_ps();
+            __m128 vab = _mm_setzero_ps();
+            for (; x + 4 <= ox1; x += 4) {
+                const __m128 pa = _mm_sub_ps(_mm_loadu_ps(ra + x), vma);
+                const __m128 pb = _mm_sub_ps(_mm_loadu_ps(rb + x), vmb);
+                vb = _mm_add_ps(vb, pb);
+                vbb = _mm_add_ps(vbb, _mm_mul_ps(pb, pb));
+                vab = _mm_add_ps(vab, _mm_mul_ps(pa, pb));
+            }
+            alignas(16) float lanes[3][4];
+            _mm_store_ps(lanes[0], vb);
+            _mm_store_ps(lanes[1], vbb);
+            _mm_store_ps(lanes[2], vab);
+            row_b = (lanes[0][0] + lanes[0][1]) + (lanes[0][2] + lanes[0][3]);
+            row_bb = (lanes[1][0] + lanes[1][1]) + (lanes[1][2] + lanes[1][3]);
+            row_ab = (lanes[2][0] + lanes[2][1]) + (lanes[2][2] + lanes[2][3]);
+#endif
+            for (; x < ox1; ++x) {
+                const float pa = ra[x] - ma;
+                const float pb = rb[x] - mb;
+                row_b += pb;
+                row_bb += pb * pb;
+                row_ab += pa * pb;
+            }
+            sb += row_b;
+            sbb += row_bb;
+            sab += row_ab;
+        }
+        const double n = static_cast<double>(ox1 - ox0) * (oy1 - oy0);
+        const double var_a = saa - sa * sa / n;
+        const double var_b = sbb - sb * sb / n;
+        if (var_a <= kMinVariance * n || var_b <= kMinVariance * n) {
+            return 0.0f;
+        }
+        return static_cast<float>((sab - sa * sb / n) / std::sqrt(var_a * var_b));
+    };
+
+    // Scores within +-2 of the prediction are kept for the hill climb and
+    // the sub-pixel fit
+    float cache[5][5];
+    for (auto& row : cache) {
+        std::fill(row, row + 5, -3.0f);
+    }
+    auto score_at = [&](int32_t sx, int32_t sy) {
+        if (std::abs(sx - cx) <= 2 && std::abs(sy - cy) <= 2) {
+            float& cached = cache[sy - cy + 2][sx - cx + 2];
+            if (cached < -2.5f) {
+                cached = ncc(sx, sy);
+            }
+            return cached;
+        }
+        return ncc(sx, sy);
+    };
+
+    int32_t best_x = cx;
+    int32_t best_y = cy;
+    float best = score_at(cx, cy);
+    if (radius > 1) {
+        // Exhaustive search of the window
+        for (int32_t sy = cy - radius; sy <= cy + radius; ++sy) {
+            for (int32_t sx = cx - radius; sx <= cx + radius; ++sx) {
+                const float score = score_at(sx, sy);
+                if (score > best) {
+                    best = score;
+                    best_x = sx;
+                    best_y = sy;
+                }
+            }
+        }
+    } else {
+        // Refinement: climb over the four direct neighbours, two steps at most
+        static constexpr int32_t kSteps[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        for (int32_t step = 0; step < 2; ++step) {
+            int32_t next_x = best_x;
+            int32_t next_y = best_y;
+            for (const auto& d : kSteps) {
+                const float score = score_at(best_x + d[0], best_y + d[1]);
+                if (score > best) {
+                    best = score;
+                    next_x = best_x + d[0];
+                    next_y = best_y + d[1];
+                }
+            }
+            if (next_x == best_x && next_y == best_y) {
+                break;
+            }
+            best_x = next_x;
+            best_y = next_y;
+        }
+    }
+    vx = static_cast<float>(best_x);
+    vy = static_cast<float>(best_y);
+    if (!refine || best <= 0.0f) {
+        return best;
+    }
+
+    // Parabola through the peak and its neighbours
+    auto offset = [best](float left, float right) {
+        if (left < -0.5f || right < -0.5f) {
+            return 0.0f;
+        }
+        const float denominator = left - 2.0f * best + right;
+        return std::fabs(denominator) > 1e-12f
+                   ? std::max(-0.5f, std::min(0.5f, 0.5f * (left - right) / denominator))
+                   : 0.0f;
+    };
+    vx += offset(score_at(best_x - 1, best_y), score_at(best_x + 1, best_y));
+    vy += offset(score_at(best_x, best_y - 1), score_at(best_x, best_y + 1));
+    return best;
+}
+
+} // namespace hnvue::imaging
@@ -11,6 +11,8 @@
 #include "hnvue/imaging/IImageProcessingEngine.h"
 #include "hnvue/imaging/DefaultImageProcessingEngine.h"
 
+#include <atomic>
+#include <filesystem>
 #include <stdexcept>
 
 #ifdef _WIN32
@@ -21,6 +23,7 @@ using LibraryHandle = HMODULE;
 constexpr const char* LIBRARY_EXTENSION = ".dll";
 #else
 #include <dlfcn.h>
+#include <unistd.h>
 using LibraryHandle = void*;
 constexpr const char* LIBRARY_EXTENSION = ".so";
 #endif
@@ -52,8 +55,14 @@ public:
         }
     }
 
+    LibraryWrapper(const LibraryWrapper&) = delete;
+    LibraryWrapper& operator=(const LibraryWrapper&) = delete;
+
     bool IsLoaded() const { return handle_ != nullptr; }
 
+    /// Keep the library loaded for the rest of the process
+    void Release() { handle_ = nullptr; }
+
     template<typename FuncType>
     FuncType GetSymbol(const char* name) const {
 #ifdef _WIN32
@@ -87,6 +96,30 @@ private:
     LibraryHandle handle_;
 };
 
+/// Suffix of private plugin copies, unique within the process
+std::atomic<uint32_t> g_isolated_loads{0};
+
+/**
+ * @brief Copy a plugin to a uniquely named temporary file
+ * @return Path of the copy, or empty on failure
+ */
+std::filesystem::path CopyPluginForIsolatedLoad(const std::string& plugin_path) {
+    namespace fs = std::filesystem;
+#ifdef _WIN32
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    std::error_code ec;
+    fs::path copy_path = fs::temp_directory_path(ec) /
+        ("hnvue-engine-" + std::to_string(pid) + "-" + std::to_string(++g_isolated_loads) +
+         "-" + fs::path(plugin_path).filename().string());
+    if (ec || !fs::copy_file(plugin_path, copy_path, fs::copy_options::overwrite_existing, ec)) {
+        return {};
+    }
+    return copy_path;
+}
+
 } // anonymous namespace
 
 std::unique_ptr<IImageProcessingEngine> EngineFactory::CreateFromPlugin(
@@ -116,9 +149,51 @@ std::unique_ptr<IImageProcessingEngine> EngineFactory::CreateFromPlugin(
         return nullptr;
     }
 
+    // The engine's code lives in the library
+    lib.Release();
     return std::unique_ptr<IImageProcessingEngine>(engine);
 }
 
+std::shared_ptr<IImageProcessingEngine> EngineFactory::CreateSharedFromPlugin(
+    const std::string& plugin_path) {
+
+    std::filesystem::path copy_path = CopyPluginForIsolatedLoad(plugin_path);
+    if (copy_path.empty()) {
+        return nullptr;
+    }
+
+    auto lib = std::make_shared<LibraryWrapper>(copy_path.string());
+#ifndef _WIN32
+    // The mapping outlives the directory entry
+    std::error_code ec;
+    std::filesystem::remove(copy_path, ec);
+#endif
+    if (!lib->IsLoaded()) {
+        return nullptr;
+    }
+
+    auto create_func = lib->GetSymbol<CreateEngineFunc>("CreateImageProcessingEngine");
+    auto destroy_func = lib->GetSymbol<DestroyEngineFunc>("DestroyImageProcessingEngine");
+    if (!create_func) {
+        return nullptr;
+    }
+
+    IImageProcessingEngine* engine = create_func();
+    if (!engine) {
+        return nullptr;
+    }
+
+    // Destroy with the library's own allocator, then unload it
+    return std::shared_ptr<IImageProcessingEngine>(engine,
+        [lib, destroy_func](IImageProcessingEngine* e) {
+            if (destroy_func) {
+                destroy_func(e);
+            } else {
+                delete e;
+            }
+        });
+}
+
 std::unique_ptr<IImageProcessingEngine> EngineFactory::CreateDefault() {
     return std::make_unique<DefaultImageProcessingEngine>();
 }
@@ -0,0 +1,199 @@
+/**
+ * @file HotSwapEngine.cpp
+ * @brief Image processing engine that can be reloaded between frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Engine plugin lifecycle
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/HotSwapEngine.h"
+#include "hnvue/infra/Clock.h"
+
+#include <chrono>
+
+namespace hnvue::imaging {
+
+// =============================================================================
+// Construction / Lifecycle
+// =============================================================================
+
+HotSwapEngine::HotSwapEngine(std::shared_ptr<IImageProcessingEngine> engine)
+    : engine_(std::move(engine)) {
+}
+
+HotSwapEngine::~HotSwapEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    reload_cv_.notify_all();
+    if (stage_thread_.joinable()) {
+        stage_thread_.join();
+    }
+}
+
+bool HotSwapEngine::StageReload(const std::string& plugin_path) {
+    return StageReload([plugin_path]() {
+        return EngineFactory::CreateSharedFromPlugin(plugin_path);
+    });
+}
+
+bool HotSwapEngine::StageReload(EngineCreator creator) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_ || reload_pending_) {
+        return false;
+    }
+    if (stage_thread_.joinable()) {
+        // Previous staging thread has finished (reload_pending_ cleared)
+        stage_thread_.join();
+    }
+    reload_pending_ = true;
+    stage_thread_ = std::thread(&HotSwapEngine::StageLoop, this, std::move(creator), config_);
+    return true;
+}
+
+bool HotSwapEngine::CommitReload() {
+    if (!staged_ready_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const int64_t start_ns = infra::MonotonicClock::NowNs();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_ = std::move(engine_);
+        engine_ = std::move(staged_);
+        staged_ready_.store(false, std::memory_order_relaxed);
+    }
+    reload_cv_.notify_all();
+    last_swap_ns_.store(infra::MonotonicClock::NowNs() - start_ns, std::memory_order_relaxed);
+    return true;
+}
+
+bool HotSwapEngine::WaitForReload(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return reload_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                               [this] { return !reload_pending_; });
+}
+
+EngineSwapStats HotSwapEngine::GetSwapStats() const {
+    EngineSwapStats stats;
+    stats.reloads_completed = reloads_completed_.load(std::memory_order_relaxed);
+    stats.reloads_failed = reloads_failed_.load(std::memory_order_relaxed);
+    stats.last_stage_us = last_stage_us_.load(std::memory_order_relaxed);
+    stats.last_swap_ns = last_swap_ns_.load(std::memory_order_relaxed);
+    stats.last_drain_us = last_drain_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void HotSwapEngine::StageLoop(EngineCreator creator, EngineConfig config) {
+    const int64_t stage_start_us = infra::MonotonicClock::NowUs();
+    std::shared_ptr<IImageProcessingEngine> engine = creator ? creator() : nullptr;
+    if (!engine || !engine->Initialize(config)) {
+        reloads_failed_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reload_pending_ = false;
+        }
+        reload_cv_.notify_all();
+        return;
+    }
+
+    std::shared_ptr<IImageProcessingEngine> retired;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        staged_ = std::move(engine);
+        staged_ready_.store(true, std::memory_order_release);
+        last_stage_us_.store(infra::MonotonicClock::NowUs() - stage_start_us,
+                             std::memory_order_relaxed);
+        reload_cv_.wait(lock, [this] { return retired_ != nullptr || stopping_; });
+        if (!retired_) {
+            // Destroyed before the swap
+            staged_ready_.store(false, std::memory_order_relaxed);
+            staged_->Shutdown();
+            staged_.reset();
+            reload_pending_ = false;
+            return;
+        }
+        retired = std::move(retired_);
+    }
+
+    // Drain off the processing thread
+    const int64_t drain_start_us = infra::MonotonicClock::NowUs();
+    retired->Shutdown();
+    retired.reset();
+    last_drain_us_.store(infra::MonotonicClock::NowUs() - drain_start_us,
+                         std::memory_order_relaxed);
+    reloads_completed_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reload_pending_ = false;
+    }
+    reload_cv_.notify_all();
+}
+
+// =============================================================================
+// IImageProcessingEngine Implementation
+// =============================================================================
+
+bool HotSwapEngine::Initialize(const EngineConfig& config) {
+    bool ok = engine_->Initialize(config);
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    initialized_ = ok;
+    return ok;
+}
+
+void HotSwapEngine::Shutdown() {
+    engine_->Shutdown();
+    std::lock_guard<std::mutex> lock(mutex_);
+    initialized_ = false;
+}
+
+bool HotSwapEngine::ApplyOffsetCorrection(ImageBuffer& frame, const CalibrationData& dark) {
+    return engine_->ApplyOffsetCorrection(frame, dark);
+}
+
+bool HotSwapEngine::ApplyGainCorrection(ImageBuffer& frame, const CalibrationData& gain) {
+    return engine_->ApplyGainCorrection(frame, gain);
+}
+
+bool HotSwapEngine::ApplyDefectPixelMap(ImageBuffer& frame, const DefectMap& map) {
+    return engine_->ApplyDefectPixelMap(frame, map);
+}
+
+bool HotSwapEngine::ApplyScatterCorrection(ImageBuffer& frame, const ScatterParams& params) {
+    return engine_->ApplyScatterCorrection(frame, params);
+}
+
+bool HotSwapEngine::ApplyWindowLevel(ImageBuffer& frame, float window, float level) {
+    return engine_->ApplyWindowLevel(frame, window, level);
+}
+
+bool HotSwapEngine::ApplyNoiseReduction(ImageBuffer& frame, const NoiseReductionConfig& config) {
+    return engine_->ApplyNoiseReduction(frame, config);
+}
+
+bool HotSwapEngine::ApplyFlattening(ImageBuffer& frame, const FlatteningConfig& config) {
+    return engine_->ApplyFlattening(frame, config);
+}
+
+bool HotSwapEngine::ProcessFrame(ImageBuffer& frame, const ProcessingConfig& config) {
+    CommitReload();
+    return engine_->ProcessFrame(frame, config);
+}
+
+EngineInfo HotSwapEngine::GetEngineInfo() const {
+    return engine_->GetEngineInfo();
+}
+
+EngineError HotSwapEngine::GetLastError() const {
+    return engine_->GetLastError();
+}
+
+StageTiming HotSwapEngine::GetLastTiming() const {
+    return engine_->GetLastTiming();
+}
+
+} // namespace hnvue::imaging
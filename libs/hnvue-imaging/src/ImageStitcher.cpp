@@ -0,0 +1,571 @@
+/**
+ * @file ImageStitcher.cpp
+ * @brief Long-length (full-spine, long-leg) stitching of overlapping frames
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Long-length image composition
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/ImageStitcher.h"
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <thread>
+
+namespace hnvue::imaging {
+
+namespace {
+
+using Complex = std::complex<float>;
+
+/// Largest coarse strip edge (downsampled pixels) fed to the FFT
+constexpr uint32_t kMaxStrip = 1024;
+
+/// Full-resolution refinement patch edge
+constexpr uint32_t kFinePatch = 256;
+
+/// Smallest strip or patch edge worth correlating
+constexpr uint32_t kMinCorrelation = 16;
+
+/// Composite rows per Compose() task
+constexpr uint32_t kComposeRowBlock = 64;
+
+/// Weight of a covering frame whose blend weight is 0, so that pixels only
+/// it covers are not left empty
+constexpr float kCoverageWeight = 1e-6f;
+
+constexpr double kPi = 3.14159265358979323846;
+
+uint32_t NextPowerOfTwo(uint32_t value) {
+    uint32_t n = 1;
+    while (n < value) {
+        n <<= 1;
+    }
+    return n;
+}
+
+/**
+ * @brief In-place radix-2 FFT (unnormalised in both directions)
+ */
+void Fft(Complex* v, uint32_t n, bool inverse) {
+    for (uint32_t i = 1, j = 0; i < n; ++i) {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(v[i], v[j]);
+        }
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        const double angle = (inverse ? 2.0 : -2.0) * kPi / static_cast<double>(len);
+        const std::complex<double> step(std::cos(angle), std::sin(angle));
+        const uint32_t half = len / 2;
+        for (uint32_t i = 0; i < n; i += len) {
+            std::complex<double> w(1.0, 0.0);
+            for (uint32_t j = 0; j < half; ++j) {
+                const Complex u = v[i + j];
+                const Complex t = v[i + j + half] * Complex(static_cast<float>(w.real()),
+                                                            static_cast<float>(w.imag()));
+                v[i + j] = u + t;
+                v[i + j + half] = u - t;
+                w *= step;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 2-D FFT of a row-major width x height grid (powers of two)
+ */
+void Fft2(std::vector<Complex>& grid, uint32_t width, uint32_t height, bool inverse) {
+    for (uint32_t y = 0; y < height; ++y) {
+        Fft(grid.data() + static_cast<size_t>(y) * width, width, inverse);
+    }
+    std::vector<Complex> column(height);
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t y = 0; y < height; ++y) {
+            column[y] = grid[static_cast<size_t>(y) * width + x];
+        }
+        Fft(column.data(), height, inverse);
+        for (uint32_t y = 0; y < height; ++y) {
+            grid[static_cast<size_t>(y) * width + x] = column[y];
+        }
+    }
+}
+
+/**
+ * @brief Box-average a frame region by factor into width x height samples
+ * @param x0 First frame column
+ * @param y0 First frame row
+ */
+void Downsample(const StitchFrame& frame, uint32_t x0, uint32_t y0,
+                uint32_t width, uint32_t height, uint32_t factor, std::vector<float>& out) {
+    out.assign(static_cast<size_t>(width) * height, 0.0f);
+    const float scale = 1.0f / static_cast<float>(factor * factor);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(frame.data);
+    for (uint32_t y = 0; y < height * factor; ++y) {
+        const auto* src = reinterpret_cast<const uint16_t*>(
+            bytes + static_cast<size_t>(y0 + y) * frame.stride) + x0;
+        float* dst = out.data() + static_cast<size_t>(y / factor) * width;
+        for (uint32_t x = 0; x < width * factor; ++x) {
+            dst[x / factor] += static_cast<float>(src[x]) * scale;
+        }
+    }
+}
+
+/**
+ * @brief Translation between two equally sized images
+ * @param a Reference samples
+ * @param b Samples of the same region from the other frame
+ * @param max_x Largest |shift| searched along x
+ * @param max_y Largest |shift| searched along y
+ * @param[out] shift_x Shift e with b(p) ~ a(p + e), sub-sample
+ * @param[out] shift_y
+ * @return Correlation peak (1 for a pure cyclic shift)
+ */
+float PhaseCorrelate(const std::vector<float>& a, const std::vector<float>& b,
+                     uint32_t width, uint32_t height, int32_t max_x, int32_t max_y,
+                     float& shift_x, float& shift_y) {
+    const uint32_t fw = NextPowerOfTwo(width);
+    const uint32_t fh = NextPowerOfTwo(height);
+
+    // Mean-free and Hann-windowed, so frame edges do not dominate
+    auto load = [&](const std::vector<float>& src, std::vector<Complex>& grid) {
+        double mean = 0.0;
+        for (float v : src) {
+            mean += v;
+        }
+        mean /= static_cast<double>(src.size());
+        grid.assign(static_cast<size_t>(fw) * fh, Complex(0.0f, 0.0f));
+        for (uint32_t y = 0; y < height; ++y) {
+            const float wy = 0.5f - 0.5f * static_cast<float>(
+                std::cos(2.0 * kPi * (y + 0.5) / height));
+            for (uint32_t x = 0; x < width; ++x) {
+                const float wx = 0.5f - 0.5f * static_cast<float>(
+                    std::cos(2.0 * kPi * (x + 0.5) / width));
+                const float v = src[static_cast<size_t>(y) * width + x] -
+                                static_cast<float>(mean);
+                grid[static_cast<size_t>(y) * fw + x] = Complex(v * wx * wy, 0.0f);
+            }
+        }
+        Fft2(grid, fw, fh, false);
+    };
+
+    std::vector<Complex> fa;
+    std::vector<Complex> fb;
+    load(a, fa);
+    load(b, fb);
+
+    // Normalised cross-power spectrum; its inverse peaks at e
+    for (size_t i = 0; i < fa.size(); ++i) {
+        const Complex r = fa[i] * std::conj(fb[i]);
+        const float magnitude = std::abs(r);
+        fa[i] = magnitude > 1e-12f ? r / magnitude : Complex(0.0f, 0.0f);
+    }
+    Fft2(fa, fw, fh, true);
+
+    const float norm = 1.0f / static_cast<float>(static_cast<size_t>(fw) * fh);
+    auto at = [&](int32_t x, int32_t y) {
+        const uint32_t ux = static_cast<uint32_t>((x % static_cast<int32_t>(fw) + fw) % fw);
+        const uint32_t uy = static_cast<uint32_t>((y % static_cast<int32_t>(fh) + fh) % fh);
+        return fa[static_cast<size_t>(uy) * fw + ux].real() * norm;
+    };
+
+    max_x = std::min(max_x, static_cast<int32_t>(fw / 2) - 1);
+    max_y = std::min(max_y, static_cast<int32_t>(fh / 2) - 1);
+    float peak = -1.0f;
+    int32_t px = 0;
+    int32_t py = 0;
+    for (int32_t y = -max_y; y <= max_y; ++y) {
+        for (int32_t x = -max_x; x <= max_x; ++x) {
+            const float v = at(x, y);
+            if (v > peak) {
+                peak = v;
+                px = x;
+                py = y;
+            }
+        }
+    }
+
+    // Parabola through the peak and its neighbours
+    auto refine = [](float left, float centre, float right) {
+        const float denominator = left - 2.0f * centre + right;
+        return std::fabs(denominator) > 1e-12f
+                   ? std::max(-0.5f, std::min(0.5f, 0.5f * (left - right) / denominator))
+                   : 0.0f;
+    };
+    shift_x = static_cast<float>(px) + refine(at(px - 1, py), peak, at(px + 1, py));
+    shift_y = static_cast<float>(py) + refine(at(px, py - 1), peak, at(px, py + 1));
+    return peak;
+}
+
+/**
+ * @brief Position along a blend ramp of length centred on seam (0..1)
+ */
+float Ramp(int64_t y, int64_t seam, int64_t length) {
+    if (length <= 0) {
+        return y >= seam ? 1.0f : 0.0f;
+    }
+    const float t = (static_cast<float>(y - seam) + 0.5f) / static_cast<float>(length) + 0.5f;
+    return std::max(0.0f, std::min(1.0f, t));
+}
+
+/**
+ * @brief Collimated field edges of a placement in composite coordinates
+ */
+int64_t FieldLeft(const StitchPlacement& p) { return p.x + static_cast<int64_t>(p.first_column); }
+int64_t FieldRight(const StitchPlacement& p) { return p.x + static_cast<int64_t>(p.end_column); }
+int64_t FieldTop(const StitchPlacement& p) { return p.y + static_cast<int64_t>(p.first_row); }
+int64_t FieldBottom(const StitchPlacement& p) { return p.y + static_cast<int64_t>(p.end_row); }
+
+} // anonymous namespace
+
+// =============================================================================
+// Planning
+// =============================================================================
+
+bool ImageStitcher::Plan(const std::vector<StitchFrame>& frames, const StitchConfig& config) {
+    frames_.clear();
+    placements_.clear();
+    seams_.clear();
+    seam_length_.clear();
+    width_ = 0;
+    height_ = 0;
+
+    if (frames.empty() || !std::isfinite(config.pixel_pitch_mm) ||
+        config.pixel_pitch_mm <= 0.0f || config.downsample == 0 ||
+        config.downsample > kStitchMaxDownsample ||
+        !std::isfinite(config.min_peak) || config.min_peak < 0.0f) {
+        return false;
+    }
+
+    const float pitch = config.pixel_pitch_mm;
+    std::vector<StitchPlacement> placements(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const StitchFrame& frame = frames[i];
+        if (frame.data == nullptr || frame.width == 0 || frame.height == 0 ||
+            frame.stride < static_cast<size_t>(frame.width) * sizeof(uint16_t)) {
+            return false;
+        }
+
+        // Collimated field, measured from the frame centre
+        auto edge = [pitch](float centre, float mm, float sign, uint32_t limit, uint32_t open) {
+            if (!(mm > 0.0f)) {
+                return open;
+            }
+            const double position = centre + sign * mm / pitch;
+            return static_cast<uint32_t>(std::max(0.0, std::min<double>(limit, std::round(position))));
+        };
+        StitchPlacement& p = placements[i];
+        const float cx = frame.width / 2.0f;
+        const float cy = frame.height / 2.0f;
+        p.first_column = edge(cx, frame.collimator_left_mm, -1.0f, frame.width, 0);
+        p.end_column = edge(cx, frame.collimator_right_mm, 1.0f, frame.width, frame.width);
+        p.first_row = edge(cy, frame.collimator_top_mm, -1.0f, frame.height, 0);
+        p.end_row = edge(cy, frame.collimator_bottom_mm, 1.0f, frame.height, frame.height);
+        if (p.first_column >= p.end_column || p.first_row >= p.end_row) {
+            return false;
+        }
+
+        // Geometric placement relative to the first frame
+        p.x = static_cast<int32_t>(std::lround(
+            (frame.table_lateral_mm - frames[0].table_lateral_mm) / pitch));
+        p.y = static_cast<int32_t>(std::lround(
+            (frame.table_longitudinal_mm - frames[0].table_longitudinal_mm) / pitch));
+        if (i > 0 && p.y <= placements[i - 1].y) {
+            return false;
+        }
+    }
+
+    frames_ = frames;
+    placements_ = placements;
+    config_ = config;
+    threads_ = config.threads != 0 ? config.threads
+                                   : std::max(1u, std::thread::hardware_concurrency());
+
+    // Pairs are registered at their geometric placements, independently
+    const size_t pairs = frames_.size() - 1;
+    std::vector<int32_t> dx(pairs, 0);
+    std::vector<int32_t> dy(pairs, 0);
+    std::vector<float> peak(pairs, 0.0f);
+    Run(pairs, [&](size_t i) { RegisterPair(i, dx[i], dy[i], peak[i]); });
+
+    // Chain the corrections: frame i + 1 keeps its geometric offset from
+    // frame i plus the registered change
+    for (size_t i = 1; i < placements_.size(); ++i) {
+        StitchPlacement& p = placements_[i];
+        const StitchPlacement& previous = placements_[i - 1];
+        p.peak = peak[i - 1];
+        p.registered = p.peak >= config.min_peak;
+        const int32_t step_x = placements[i].x - placements[i - 1].x;
+        const int32_t step_y = placements[i].y - placements[i - 1].y;
+        if (p.registered && step_y + dy[i - 1] > 0) {
+            p.correction_x = dx[i - 1];
+            p.correction_y = dy[i - 1];
+        } else {
+            p.registered = false;
+        }
+        p.x = previous.x + step_x + p.correction_x;
+        p.y = previous.y + step_y + p.correction_y;
+    }
+
+    // Composite bounds from the collimated fields
+    int64_t min_x = INT64_MAX;
+    int64_t min_y = INT64_MAX;
+    int64_t max_x = INT64_MIN;
+    int64_t max_y = INT64_MIN;
+    for (const StitchPlacement& p : placements_) {
+        min_x = std::min<int64_t>(min_x, FieldLeft(p));
+        min_y = std::min<int64_t>(min_y, FieldTop(p));
+        max_x = std::max<int64_t>(max_x, FieldRight(p));
+        max_y = std::max<int64_t>(max_y, FieldBottom(p));
+    }
+    for (StitchPlacement& p : placements_) {
+        p.x = static_cast<int32_t>(p.x - min_x);
+        p.y = static_cast<int32_t>(p.y - min_y);
+    }
+    width_ = static_cast<uint32_t>(max_x - min_x);
+    height_ = static_cast<uint32_t>(max_y - min_y);
+
+    // Seams in the middle of each overlap
+    for (size_t i = 0; i + 1 < placements_.size(); ++i) {
+        const StitchPlacement& upper = placements_[i];
+        const StitchPlacement& lower = placements_[i + 1];
+        const int64_t top = FieldTop(lower);
+        const int64_t bottom = FieldBottom(upper);
+        if (bottom > top) {
+            seams_.push_back((top + bottom) / 2);
+            seam_length_.push_back(std::min<int64_t>(config.feather, bottom - top));
+        } else {
+            seams_.push_back(top);
+            seam_length_.push_back(0);
+        }
+    }
+    return true;
+}
+
+void ImageStitcher::RegisterPair(size_t index, int32_t& dx, int32_t& dy, float& peak) const {
+    dx = 0;
+    dy = 0;
+    peak = 0.0f;
+
+    const StitchFrame& a = frames_[index];
+    const StitchFrame& b = frames_[index + 1];
+    const StitchPlacement& pa = placements_[index];
+    const StitchPlacement& pb = placements_[index + 1];
+
+    // Overlap of the collimated fields at the geometric placements
+    const int64_t x0 = std::max<int64_t>(FieldLeft(pa), FieldLeft(pb));
+    const int64_t x1 = std::min<int64_t>(FieldRight(pa), FieldRight(pb));
+    const int64_t y0 = std::max<int64_t>(FieldTop(pa), FieldTop(pb));
+    const int64_t y1 = std::min<int64_t>(FieldBottom(pa), FieldBottom(pb));
+    const uint32_t factor = config_.downsample;
+    if (x1 - x0 < static_cast<int64_t>(kMinCorrelation * factor) ||
+        y1 - y0 < static_cast<int64_t>(kMinCorrelation * factor)) {
+        return;
+    }
+
+    // Coarse: downsampled strips of the whole overlap (centred, capped)
+    const uint32_t sw = std::min<uint32_t>(static_cast<uint32_t>((x1 - x0) / factor), kMaxStrip);
+    const uint32_t sh = std::min<uint32_t>(static_cast<uint32_t>((y1 - y0) / factor), kMaxStrip);
+    const int64_t sx = x0 + ((x1 - x0) - static_cast<int64_t>(sw) * factor) / 2;
+    const int64_t sy = y0 + ((y1 - y0) - static_cast<int64_t>(sh) * factor) / 2;
+    std::vector<float> strip_a;
+    std::vector<float> strip_b;
+    Downsample(a, static_cast<uint32_t>(sx - pa.x), static_cast<uint32_t>(sy - pa.y),
+               sw, sh, factor, strip_a);
+    Downsample(b, static_cast<uint32_t>(sx - pb.x), static_cast<uint32_t>(sy - pb.y),
+               sw, sh, factor, strip_b);
+
+    const int32_t coarse_radius =
+        static_cast<int32_t>((config_.search_radius + factor - 1) / factor);
+    float cx = 0.0f;
+    float cy = 0.0f;
+    peak = PhaseCorrelate(strip_a, strip_b, sw, sh, coarse_radius, coarse_radius, cx, cy);
+    if (peak < config_.min_peak) {
+        return;
+    }
+    dx = static_cast<int32_t>(std::lround(cx * static_cast<float>(factor)));
+    dy = static_cast<int32_t>(std::lround(cy * static_cast<float>(factor)));
+    if (factor == 1) {
+        return;
+    }
+
+    // Fine: full-resolution patch R of b against R + e of a
+    const int64_t fx0 = std::max<int64_t>(x0, FieldLeft(pa) - dx);
+    const int64_t fx1 = std::min<int64_t>(x1, FieldRight(pa) - dx);
+    const int64_t fy0 = std::max<int64_t>(y0, FieldTop(pa) - dy);
+    const int64_t fy1 = std::min<int64_t>(y1, FieldBottom(pa) - dy);
+    if (fx1 - fx0 < kMinCorrelation || fy1 - fy0 < kMinCorrelation) {
+        return;
+    }
+    const uint32_t pw = std::min<uint32_t>(static_cast<uint32_t>(fx1 - fx0), kFinePatch);
+    const uint32_t ph = std::min<uint32_t>(static_cast<uint32_t>(fy1 - fy0), kFinePatch);
+    const int64_t px = fx0 + ((fx1 - fx0) - pw) / 2;
+    const int64_t py = fy0 + ((fy1 - fy0) - ph) / 2;
+    Downsample(a, static_cast<uint32_t>(px + dx - pa.x), static_cast<uint32_t>(py + dy - pa.y),
+               pw, ph, 1, strip_a);
+    Downsample(b, static_cast<uint32_t>(px - pb.x), static_cast<uint32_t>(py - pb.y),
+               pw, ph, 1, strip_b);
+
+    const int32_t fine_radius = static_cast<int32_t>(factor) + 1;
+    float rx = 0.0f;
+    float ry = 0.0f;
+    const float fine_peak = PhaseCorrelate(strip_a, strip_b, pw, ph, fine_radius, fine_radius,
+                                           rx, ry);
+    if (fine_peak >= config_.min_peak) {
+        dx += static_cast<int32_t>(std::lround(rx));
+        dy += static_cast<int32_t>(std::lround(ry));
+        peak = fine_peak;
+    }
+}
+
+// =============================================================================
+// Composition
+// =============================================================================
+
+float ImageStitcher::RowWeight(size_t index, int64_t y) const {
+    const StitchPlacement& p = placements_[index];
+    if (y < FieldTop(p) || y >= FieldBottom(p)) {
+        return 0.0f;
+    }
+    float weight = 1.0f;
+    if (index > 0) {
+        weight *= Ramp(y, seams_[index - 1], seam_length_[index - 1]);
+    }
+    if (index < seams_.size()) {
+        weight *= 1.0f - Ramp(y, seams_[index], seam_length_[index]);
+    }
+    return weight;
+}
+
+void ImageStitcher::ComposeRow(uint32_t y, uint16_t* row, std::vector<float>& sum,
+                               std::vector<float>& weight) const {
+    // Frame row of composite row y, or nullptr outside the collimated rows
+    auto source = [&](size_t i) -> const uint16_t* {
+        const StitchPlacement& p = placements_[i];
+        const int64_t fy = static_cast<int64_t>(y) - p.y;
+        if (fy < p.first_row || fy >= p.end_row) {
+            return nullptr;
+        }
+        const StitchFrame& frame = frames_[i];
+        return reinterpret_cast<const uint16_t*>(reinterpret_cast<const uint8_t*>(frame.data) +
+                                                 static_cast<size_t>(fy) * frame.stride) +
+               p.first_column;
+    };
+
+    size_t covering = 0;
+    size_t last = 0;
+    uint32_t lo = width_;
+    uint32_t hi = 0;
+    for (size_t i = 0; i < placements_.size(); ++i) {
+        if (source(i) != nullptr) {
+            const StitchPlacement& p = placements_[i];
+            lo = std::min(lo, static_cast<uint32_t>(FieldLeft(p)));
+            hi = std::max(hi, static_cast<uint32_t>(FieldRight(p)));
+            ++covering;
+            last = i;
+        }
+    }
+
+    std::memset(row, 0, static_cast<size_t>(width_) * sizeof(uint16_t));
+    if (covering == 0) {
+        return;
+    }
+    if (covering == 1) {
+        const StitchPlacement& p = placements_[last];
+        std::memcpy(row + FieldLeft(p), source(last),
+                    static_cast<size_t>(p.end_column - p.first_column) * sizeof(uint16_t));
+        return;
+    }
+
+    // Seam rows: weighted mean of every frame covering the pixel
+    std::fill(sum.begin() + lo, sum.begin() + hi, 0.0f);
+    std::fill(weight.begin() + lo, weight.begin() + hi, 0.0f);
+    for (size_t i = 0; i < placements_.size(); ++i) {
+        const uint16_t* pixels = source(i);
+        if (pixels == nullptr) {
+            continue;
+        }
+        const StitchPlacement& p = placements_[i];
+        const float w = std::max(RowWeight(i, y), kCoverageWeight);
+        float* acc = sum.data() + FieldLeft(p);
+        float* acc_weight = weight.data() + FieldLeft(p);
+        for (uint32_t x = 0; x < p.end_column - p.first_column; ++x) {
+            acc[x] += w * static_cast<float>(pixels[x]);
+            acc_weight[x] += w;
+        }
+    }
+    for (uint32_t x = lo; x < hi; ++x) {
+        if (weight[x] > 0.0f) {
+            row[x] = static_cast<uint16_t>(std::min(65535.0f, sum[x] / weight[x] + 0.5f));
+        }
+    }
+}
+
+bool ImageStitcher::Compose(uint16_t* dst, size_t stride) const {
+    if (placements_.empty() || dst == nullptr ||
+        stride < static_cast<size_t>(width_) * sizeof(uint16_t)) {
+        return false;
+    }
+    const size_t blocks = (height_ + kComposeRowBlock - 1) / kComposeRowBlock;
+    Run(blocks, [&](size_t block) {
+        std::vector<float> sum(width_);
+        std::vector<float> weight(width_);
+        const uint32_t first = static_cast<uint32_t>(block) * kComposeRowBlock;
+        const uint32_t end = std::min(height_, first + kComposeRowBlock);
+        for (uint32_t y = first; y < end; ++y) {
+            auto* row = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) +
+                                                    static_cast<size_t>(y) * stride);
+            ComposeRow(y, row, sum, weight);
+        }
+    });
+    return true;
+}
+
+bool ImageStitcher::Compose(const RowSink& sink) const {
+    if (placements_.empty() || !sink) {
+        return false;
+    }
+    std::vector<uint16_t> row(width_);
+    std::vector<float> sum(width_);
+    std::vector<float> weight(width_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        ComposeRow(y, row.data(), sum, weight);
+        sink(y, row.data());
+    }
+    return true;
+}
+
+void ImageStitcher::Run(size_t count, const std::function<void(size_t)>& task) const {
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+
+    const size_t workers = std::min<size_t>(threads_, count);
+    std::vector<std::thread> threads;
+    threads.reserve(workers > 0 ? workers - 1 : 0);
+    for (size_t i = 1; i < workers; ++i) {
+        threads.emplace_back([&work]() {
+            infra::ApplyNamedThreadPolicy(kThreadStitchWorker);
+            work();
+        });
+    }
+    work();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace hnvue::imaging
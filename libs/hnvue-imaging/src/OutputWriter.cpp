@@ -0,0 +1,261 @@
+/**
+ * @file OutputWriter.cpp
+ * @brief Window/Level pass fused with the display output transform
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Display frame output implementation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/OutputWriter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hnvue::imaging {
+
+namespace {
+
+bool Transposes(OutputRotation rotation) {
+    return rotation == OutputRotation::ROTATE_90 || rotation == OutputRotation::ROTATE_270;
+}
+
+/**
+ * @brief Detector pixels inside the shutter on one row or column
+ * @param transform Transform holding the shutter
+ * @param along_x true: range of x on row fixed; false: range of y on column fixed
+ * @param fixed Row (along_x) or column index
+ * @param[out] first First pixel inside
+ * @param[out] end One past the last pixel inside (first >= end: none)
+ */
+void ShutterRange(const OutputTransform& transform, bool along_x, int64_t fixed,
+                  int64_t& first, int64_t& end) {
+    first = 0;
+    end = 0;
+    if (transform.shutter == ShutterShape::RECTANGULAR) {
+        const int64_t fixed_lo = along_x ? transform.shutter_top : transform.shutter_left;
+        const int64_t fixed_hi = along_x ? transform.shutter_bottom : transform.shutter_right;
+        if (fixed >= fixed_lo && fixed < fixed_hi) {
+            first = along_x ? transform.shutter_left : transform.shutter_top;
+            end = along_x ? transform.shutter_right : transform.shutter_bottom;
+        }
+        return;
+    }
+
+    // CIRCULAR: pixel centres within the radius
+    const double center_fixed = along_x ? transform.shutter_center_y : transform.shutter_center_x;
+    const double center = along_x ? transform.shutter_center_x : transform.shutter_center_y;
+    const double r2 = static_cast<double>(transform.shutter_radius) * transform.shutter_radius;
+    const double d = static_cast<double>(fixed) + 0.5 - center_fixed;
+    if (d * d > r2) {
+        return;
+    }
+    const double half = std::sqrt(r2 - d * d);
+    first = static_cast<int64_t>(std::ceil(center - half - 0.5));
+    end = static_cast<int64_t>(std::floor(center + half - 0.5)) + 1;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Geometry
+// =============================================================================
+
+bool ComputeOutputGeometry(const OutputTransform& transform,
+                           uint32_t width, uint32_t height,
+                           uint32_t& out_width, uint32_t& out_height) {
+    if (width == 0 || height == 0 ||
+        transform.crop_x >= width || transform.crop_y >= height) {
+        return false;
+    }
+    const uint32_t crop_width = transform.crop_width != 0
+        ? transform.crop_width : width - transform.crop_x;
+    const uint32_t crop_height = transform.crop_height != 0
+        ? transform.crop_height : height - transform.crop_y;
+    if (static_cast<uint64_t>(transform.crop_x) + crop_width > width ||
+        static_cast<uint64_t>(transform.crop_y) + crop_height > height) {
+        return false;
+    }
+
+    switch (transform.rotation) {
+        case OutputRotation::ROTATE_0:
+        case OutputRotation::ROTATE_90:
+        case OutputRotation::ROTATE_180:
+        case OutputRotation::ROTATE_270:
+            break;
+        default:
+            return false;
+    }
+
+    switch (transform.shutter) {
+        case ShutterShape::SHUTTER_NONE:
+            break;
+        case ShutterShape::RECTANGULAR:
+            if (transform.shutter_right < transform.shutter_left ||
+                transform.shutter_bottom < transform.shutter_top) {
+                return false;
+            }
+            break;
+        case ShutterShape::CIRCULAR:
+            if (!(transform.shutter_radius >= 0.0f) ||
+                !std::isfinite(transform.shutter_center_x) ||
+                !std::isfinite(transform.shutter_center_y) ||
+                !std::isfinite(transform.shutter_radius)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    out_width = Transposes(transform.rotation) ? crop_height : crop_width;
+    out_height = Transposes(transform.rotation) ? crop_width : crop_height;
+    return true;
+}
+
+// =============================================================================
+// OutputWriter
+// =============================================================================
+
+bool OutputWriter::Prepare(const OutputTransform& transform, uint32_t width, uint32_t height) {
+    uint32_t out_width = 0;
+    uint32_t out_height = 0;
+    if (!ComputeOutputGeometry(transform, width, height, out_width, out_height)) {
+        return false;
+    }
+    const bool transposed = Transposes(transform.rotation);
+    const int64_t crop_width = transposed ? out_height : out_width;
+    const int64_t crop_height = transposed ? out_width : out_height;
+
+    // Rotation (clockwise): crop-relative (u, v) of output (ox, oy)
+    switch (transform.rotation) {
+        case OutputRotation::ROTATE_90:
+            origin_u_ = 0;               du_dx_ = 0;  du_dy_ = 1;
+            origin_v_ = crop_height - 1; dv_dx_ = -1; dv_dy_ = 0;
+            break;
+        case OutputRotation::ROTATE_180:
+            origin_u_ = crop_width - 1;  du_dx_ = -1; du_dy_ = 0;
+            origin_v_ = crop_height - 1; dv_dx_ = 0;  dv_dy_ = -1;
+            break;
+        case OutputRotation::ROTATE_270:
+            origin_u_ = crop_width - 1;  du_dx_ = 0;  du_dy_ = -1;
+            origin_v_ = 0;               dv_dx_ = 1;  dv_dy_ = 0;
+            break;
+        default:
+            origin_u_ = 0;               du_dx_ = 1;  du_dy_ = 0;
+            origin_v_ = 0;               dv_dx_ = 0;  dv_dy_ = 1;
+            break;
+    }
+
+    // Flips act on the source before rotation
+    if (transform.flip_horizontal) {
+        origin_u_ = crop_width - 1 - origin_u_;
+        du_dx_ = -du_dx_;
+        du_dy_ = -du_dy_;
+    }
+    if (transform.flip_vertical) {
+        origin_v_ = crop_height - 1 - origin_v_;
+        dv_dx_ = -dv_dx_;
+        dv_dy_ = -dv_dy_;
+    }
+
+    out_width_ = out_width;
+    out_height_ = out_height;
+    transposed_ = transposed;
+    fill_ = transform.shutter_value;
+
+    // Along an output row the source moves along one detector axis, and
+    // both shutter shapes cut any axis-aligned line in one interval
+    spans_.resize(static_cast<size_t>(out_height) * 2);
+    for (uint32_t oy = 0; oy < out_height; ++oy) {
+        int64_t first = 0;
+        int64_t end = out_width;
+        if (transform.shutter != ShutterShape::SHUTTER_NONE) {
+            const bool along_x = du_dx_ != 0;
+            const int64_t fixed = along_x
+                ? transform.crop_y + origin_v_ + static_cast<int64_t>(dv_dy_) * oy
+                : transform.crop_x + origin_u_ + static_cast<int64_t>(du_dy_) * oy;
+            const int64_t base = along_x
+                ? transform.crop_x + origin_u_ + static_cast<int64_t>(du_dy_) * oy
+                : transform.crop_y + origin_v_ + static_cast<int64_t>(dv_dy_) * oy;
+            const int32_t step = along_x ? du_dx_ : dv_dx_;
+
+            int64_t inside_first = 0;
+            int64_t inside_end = 0;
+            ShutterRange(transform, along_x, fixed, inside_first, inside_end);
+            if (step > 0) {
+                first = inside_first - base;
+                end = inside_end - base;
+            } else {
+                first = base - inside_end + 1;
+                end = base - inside_first + 1;
+            }
+            first = std::clamp<int64_t>(first, 0, out_width);
+            end = std::clamp<int64_t>(end, first, out_width);
+        }
+        spans_[2 * oy] = static_cast<uint32_t>(first);
+        spans_[2 * oy + 1] = static_cast<uint32_t>(end);
+    }
+    return true;
+}
+
+template <typename T, typename Map>
+void OutputWriter::Write(const T* src, size_t src_stride, uint16_t* dst, size_t dst_stride,
+                         Map map) const {
+    const uint8_t* source = reinterpret_cast<const uint8_t*>(src);
+    const ptrdiff_t pixel = static_cast<ptrdiff_t>(sizeof(T));
+    const ptrdiff_t pitch = static_cast<ptrdiff_t>(src_stride);
+    const ptrdiff_t origin = origin_u_ * pixel + origin_v_ * pitch;
+    const ptrdiff_t column_step = du_dx_ * pixel + dv_dx_ * pitch;
+    const ptrdiff_t row_step = du_dy_ * pixel + dv_dy_ * pitch;
+
+    // Row-major walks stream whole rows; transposing walks go tile by tile
+    const uint32_t tile_width = transposed_ ? kOutputTile : out_width_;
+    const uint32_t tile_height = transposed_ ? kOutputTile : 1;
+
+    for (uint32_t tile_y = 0; tile_y < out_height_; tile_y += tile_height) {
+        const uint32_t y_end = std::min(tile_y + tile_height, out_height_);
+        for (uint32_t tile_x = 0; tile_x < out_width_; tile_x += tile_width) {
+            const uint32_t x_end = std::min(tile_x + tile_width, out_width_);
+
+            for (uint32_t oy = tile_y; oy < y_end; ++oy) {
+                uint16_t* out = reinterpret_cast<uint16_t*>(
+                    reinterpret_cast<uint8_t*>(dst) + oy * dst_stride);
+                const uint32_t first = std::clamp(spans_[2 * oy], tile_x, x_end);
+                const uint32_t end = std::clamp(spans_[2 * oy + 1], first, x_end);
+
+                std::fill(out + tile_x, out + first, fill_);
+                ptrdiff_t offset = origin + static_cast<ptrdiff_t>(oy) * row_step +
+                                   static_cast<ptrdiff_t>(first) * column_step;
+                for (uint32_t ox = first; ox < end; ++ox, offset += column_step) {
+                    out[ox] = map(*reinterpret_cast<const T*>(source + offset));
+                }
+                std::fill(out + end, out + x_end, fill_);
+            }
+        }
+    }
+}
+
+void OutputWriter::WriteU16(const uint16_t* src, size_t src_stride, const uint16_t* lut,
+                            uint16_t* dst, size_t dst_stride) const {
+    Write(src, src_stride, dst, dst_stride,
+          [lut](uint16_t value) { return lut[value]; });
+}
+
+void OutputWriter::WriteF32(const float* src, size_t src_stride, float scale, float offset,
+                            uint16_t* dst, size_t dst_stride) const {
+    Write(src, src_stride, dst, dst_stride,
+          [scale, offset](float value) -> uint16_t {
+              const float mapped = value * scale + offset;
+              if (!(mapped > 0.0f)) {
+                  return 0;  // Also NaN
+              }
+              if (mapped >= 65535.0f) {
+                  return 65535;
+              }
+              return static_cast<uint16_t>(mapped + 0.5f);
+          });
+}
+
+} // namespace hnvue::imaging
@@ -0,0 +1,70 @@
+/**
+ * @file PooledImageBuffer.cpp
+ * @brief ImageBuffer backed by the shared infra frame pool
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Image processing frame memory
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/imaging/PooledImageBuffer.h"
+
+#include <cstring>
+#include <utility>
+
+namespace hnvue::imaging {
+
+bool AcquirePooledImageBuffer(uint32_t width, uint32_t height,
+                              PooledImageBuffer& out,
+                              infra::FramePool& pool) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    size_t row_bytes = static_cast<size_t>(width) * sizeof(uint16_t);
+    size_t stride = (row_bytes + infra::kCacheLineSize - 1) /
+                    infra::kCacheLineSize * infra::kCacheLineSize;
+
+    infra::FrameHandle storage = pool.Acquire(stride * height);
+    if (!storage) {
+        return false;
+    }
+
+    out.storage = std::move(storage);
+    out.view = ImageBuffer{};
+    out.view.width = width;
+    out.view.height = height;
+    out.view.pixel_depth = 16;
+    out.view.stride = static_cast<uint32_t>(stride);
+    out.view.data = reinterpret_cast<uint16_t*>(out.storage.Data());
+    return true;
+}
+
+bool ClonePooledImageBuffer(const ImageBuffer& source,
+                            PooledImageBuffer& out,
+                            infra::FramePool& pool) {
+    if (source.data == nullptr) {
+        return false;
+    }
+    if (!AcquirePooledImageBuffer(source.width, source.height, out, pool)) {
+        return false;
+    }
+
+    size_t row_bytes = static_cast<size_t>(source.width) * sizeof(uint16_t);
+    size_t source_stride = source.stride != 0 ? source.stride : row_bytes;
+    const auto* src = reinterpret_cast<const uint8_t*>(source.data);
+    auto* dst = reinterpret_cast<uint8_t*>(out.view.data);
+
+    for (uint32_t y = 0; y < source.height; ++y) {
+        std::memcpy(dst + static_cast<size_t>(y) * out.view.stride,
+                    src + static_cast<size_t>(y) * source_stride,
+                    row_bytes);
+    }
+
+    out.view.timestamp_us = source.timestamp_us;
+    out.view.frame_id = source.frame_id;
+    return true;
+}
+
+} // namespace hnvue::imaging
@@ -0,0 +1,125 @@
+/**
+ * @file Clock.h
+ * @brief Process-wide monotonic timestamp service
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: timestamp time base
+ * SPDX-License-Identifier: MIT
+ *
+ * Every timestamp_us field in HAL, imaging and IPC is microseconds since a
+ * single process epoch taken from MonotonicClock, so a frame's DMA, processing
+ * and transmit stamps can be subtracted directly to obtain per-hop latency.
+ *
+ * On x86-64 CPUs with an invariant TSC the clock reads the TSC directly
+ * (~20 ns per read) using a frequency calibrated against the OS monotonic
+ * clock at first use. Otherwise it falls back to std::chrono::steady_clock.
+ * Wall-clock time (DICOM Acquisition DateTime, persisted records) is derived
+ * from the monotonic value via ToWallClockUs(), so it never runs backwards
+ * when NTP steps the system clock.
+ */
+
+#ifndef HNUE_INFRA_CLOCK_H
+#define HNUE_INFRA_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+namespace hnvue::infra {
+
+/**
+ * @brief Monotonic clock with a single process epoch
+ *
+ * Satisfies the C++ TrivialClock requirements, so it can replace
+ * std::chrono::steady_clock / high_resolution_clock in duration code:
+ * @code
+ *   auto start = infra::MonotonicClock::now();
+ *   ...
+ *   auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+ *       infra::MonotonicClock::now() - start).count();
+ * @endcode
+ *
+ * Thread Safety: All methods are thread-safe. Calibration happens once,
+ * on the first call (or on Initialize()).
+ */
+class MonotonicClock {
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<MonotonicClock>;
+    static constexpr bool is_steady = true;
+
+    /**
+     * @brief Calibrate the clock and fix the process epoch
+     *
+     * Optional: called implicitly on first use. Call early in main() so the
+     * ~10 ms TSC calibration does not land on a latency-critical path.
+     */
+    static void Initialize();
+
+    /**
+     * @brief Current time since the process epoch
+     * @return Time point with nanosecond resolution
+     */
+    static time_point now() noexcept;
+
+    /**
+     * @brief Current time in nanoseconds since the process epoch
+     * @return Nanoseconds (>= 0)
+     */
+    static int64_t NowNs() noexcept;
+
+    /**
+     * @brief Current time in microseconds since the process epoch
+     * @return Microseconds (>= 0); value used for all timestamp_us fields
+     */
+    static int64_t NowUs() noexcept;
+
+    /**
+     * @brief Convert a since-epoch timestamp to wall-clock time
+     * @param since_start_us Microseconds since the process epoch
+     * @return Microseconds since the Unix epoch (UTC)
+     */
+    static int64_t ToWallClockUs(int64_t since_start_us) noexcept;
+
+    /**
+     * @brief Convert a wall-clock time to a since-epoch timestamp
+     * @param unix_us Microseconds since the Unix epoch (UTC)
+     * @return Microseconds since the process epoch (negative if before it)
+     */
+    static int64_t FromWallClockUs(int64_t unix_us) noexcept;
+
+    /**
+     * @brief Check whether reads use the CPU timestamp counter
+     * @return true if TSC-based, false if steady_clock fallback
+     */
+    static bool IsTscBased() noexcept;
+
+    /**
+     * @brief Get the calibrated TSC frequency
+     * @return Ticks per second, or 0 when not TSC-based
+     */
+    static double TscFrequencyHz() noexcept;
+};
+
+/**
+ * @brief Shorthand for MonotonicClock::NowUs()
+ * @return Microseconds since the process epoch
+ */
+inline int64_t SinceStartUs() noexcept {
+    return MonotonicClock::NowUs();
+}
+
+/**
+ * @brief Current wall-clock time on the monotonic time base
+ * @return Microseconds since the Unix epoch (UTC)
+ */
+inline int64_t WallClockNowUs() noexcept {
+    return MonotonicClock::ToWallClockUs(MonotonicClock::NowUs());
+}
+
+} // namespace hnvue::infra
+
+#endif // HNUE_INFRA_CLOCK_H
@@ -0,0 +1,422 @@
+/**
+ * @file FramePool.h
+ * @brief Aligned size-class frame pool with ref-counted handles
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: frame memory management
+ * SPDX-License-Identifier: MIT
+ *
+ * Detector frames (up to ~18 MB at 3k x 3k x 16-bit) pass through the HAL
+ * DMA ring, RawFrame, the imaging pipeline and the IPC image queue. Without
+ * reuse each stage hits the system allocator (and the kernel, for mmap-sized
+ * blocks) once per frame. FramePool keeps released blocks on per-size-class
+ * free lists so steady-state acquisition performs no large allocations.
+ *
+ * Layout of every pooled block:
+ * @code
+ *   | FrameBlockHeader (padded to alignment) | data (capacity bytes) |
+ *   ^ block base                             ^ returned pointer, aligned
+ * @endcode
+ * The header carries the owning pool and the reference count (and the last
+ * pointer-sized slot before the data points back to it), so a block can
+ * be released from any thread or module without knowing which pool it came
+ * from.
+ */
+
+#ifndef HNUE_INFRA_FRAME_POOL_H
+#define HNUE_INFRA_FRAME_POOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace hnvue::infra {
+
+// =============================================================================
+// Constants
+// =============================================================================
+
+/// Cache line size; minimum alignment of every pooled buffer
+constexpr size_t kCacheLineSize = 64;
+
+/// Page size; alignment used for DMA and O_DIRECT buffers
+constexpr size_t kPageSize = 4096;
+
+/// Huge page size used when FramePoolConfig::use_huge_pages is set
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+/// Smallest size class in bytes (smaller requests are rounded up)
+constexpr size_t kMinSizeClassBytes = 4096;
+
+/// Number of size classes per power of two (25% spacing)
+constexpr uint32_t kSizeClassSteps = 4;
+
+/// Number of size classes (4 KiB .. 1 GiB)
+constexpr uint32_t kNumSizeClasses = 18 * kSizeClassSteps + 1;
+
+/// Size class index for blocks larger than the largest class (not cached)
+constexpr uint32_t kUnpooledClass = std::numeric_limits<uint32_t>::max();
+
+// =============================================================================
+// Configuration and Statistics
+// =============================================================================
+
+/**
+ * @brief FramePool construction parameters
+ */
+struct FramePoolConfig {
+    size_t alignment = kCacheLineSize;      ///< kCacheLineSize or kPageSize (power of two)
+    bool use_huge_pages = false;            ///< Back blocks >= kHugePageSize with huge pages
+    size_t max_cached_bytes = 512ull << 20; ///< Free-list limit; excess blocks are freed
+};
+
+/**
+ * @brief FramePool usage counters
+ */
+struct FramePoolStats {
+    size_t bytes_in_use = 0;         ///< Capacity of blocks currently handed out
+    size_t high_water_bytes = 0;     ///< Maximum of bytes_in_use since last reset
+    size_t blocks_in_use = 0;        ///< Blocks currently handed out
+    size_t high_water_blocks = 0;    ///< Maximum of blocks_in_use since last reset
+    size_t bytes_cached = 0;         ///< Capacity of blocks on free lists
+    uint64_t acquisitions = 0;       ///< Total successful acquisitions
+    uint64_t pool_hits = 0;          ///< Acquisitions served from a free list
+    uint64_t system_allocations = 0; ///< Acquisitions that allocated from the OS
+    uint64_t huge_page_blocks = 0;   ///< System allocations backed by huge pages
+};
+
+class FramePool;
+
+/**
+ * @brief Header stored immediately before each pooled buffer
+ *
+ * Internal to FramePool/FrameHandle; exposed only so that FrameHandle's
+ * reference counting can be inlined.
+ */
+struct FrameBlockHeader {
+    FramePool* pool;                ///< Owning pool
+    std::atomic<uint32_t> refcount; ///< Outstanding references
+    uint32_t size_class;            ///< Size class index or kUnpooledClass
+    size_t capacity;                ///< Usable bytes after the header
+    size_t mapping_bytes;           ///< Total mapped bytes (mmap-backed) or 0 (heap)
+    size_t header_bytes;            ///< Offset from block base to data
+    uint32_t flags;                 ///< Backing flags (internal)
+    uint32_t magic;                 ///< kFrameBlockMagic while live
+};
+
+/// Marker used to detect foreign or double-released pointers
+constexpr uint32_t kFrameBlockMagic = 0x46504F4Cu; // "FPOL"
+
+// =============================================================================
+// FrameHandle
+// =============================================================================
+
+/**
+ * @brief Ref-counted reference to a pooled buffer
+ *
+ * Copying a handle adds a reference; the buffer returns to its pool when
+ * the last handle is destroyed or reset. Handles are cheap (one pointer plus
+ * the requested size) and safe to pass between threads.
+ */
+class FrameHandle {
+public:
+    FrameHandle() = default;
+    ~FrameHandle() { Reset(); }
+
+    FrameHandle(const FrameHandle& other) noexcept
+        : header_(other.header_), size_(other.size_) {
+        if (header_ != nullptr) {
+            header_->refcount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    FrameHandle& operator=(const FrameHandle& other) noexcept {
+        if (this != &other) {
+            FrameHandle copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    FrameHandle(FrameHandle&& other) noexcept
+        : header_(other.header_), size_(other.size_) {
+        other.header_ = nullptr;
+        other.size_ = 0;
+    }
+
+    FrameHandle& operator=(FrameHandle&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Drop this reference (returns the block to its pool if last)
+     */
+    void Reset() noexcept;
+
+    /// Pointer to the aligned buffer (nullptr if empty)
+    uint8_t* Data() const noexcept {
+        return header_ == nullptr
+                   ? nullptr
+                   : reinterpret_cast<uint8_t*>(header_) + header_->header_bytes;
+    }
+
+    /// Requested size in bytes
+    size_t Size() const noexcept { return size_; }
+
+    /// Usable capacity in bytes (size class, >= Size())
+    size_t Capacity() const noexcept { return header_ == nullptr ? 0 : header_->capacity; }
+
+    /// Number of handles sharing this buffer (0 if empty)
+    uint32_t UseCount() const noexcept {
+        return header_ == nullptr ? 0 : header_->refcount.load(std::memory_order_relaxed);
+    }
+
+    /// true if the handle refers to a buffer
+    explicit operator bool() const noexcept { return header_ != nullptr; }
+
+    void Swap(FrameHandle& other) noexcept {
+        std::swap(header_, other.header_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    friend class FramePool;
+
+    FrameHandle(FrameBlockHeader* header, size_t size) noexcept
+        : header_(header), size_(size) {}
+
+    FrameBlockHeader* header_ = nullptr;
+    size_t size_ = 0;
+};
+
+// =============================================================================
+// FramePool
+// =============================================================================
+
+/**
+ * @brief Size-class pool of aligned frame buffers
+ *
+ * Size classes are spaced 25% apart from 4 KiB to 1 GiB, so the worst-case
+ * internal waste is below 25% and a fixed detector geometry always maps to
+ * the same class. Larger requests are served directly and not cached.
+ *
+ * Thread Safety: All methods are thread-safe. Each size class has its own
+ * lock; statistics are atomic.
+ *
+ * Lifetime: A pool must outlive every block it handed out. Default() is
+ * never destroyed, so blocks from it may be released during static
+ * destruction.
+ */
+class FramePool {
+public:
+    /**
+     * @brief Get the process-wide default pool (64-byte aligned, no huge pages)
+     * @return Default pool (never destroyed)
+     */
+    static FramePool& Default();
+
+    /**
+     * @brief Construct a pool
+     * @param config Alignment, huge page and cache limit settings
+     *
+     * An alignment that is not a power of two or is below kCacheLineSize is
+     * raised to kCacheLineSize.
+     */
+    explicit FramePool(const FramePoolConfig& config = FramePoolConfig{});
+
+    /**
+     * @brief Destructor - frees cached blocks
+     */
+    ~FramePool();
+
+    // Non-copyable, non-movable (blocks hold a pointer to the pool)
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+    FramePool(FramePool&&) = delete;
+    FramePool& operator=(FramePool&&) = delete;
+
+    /**
+     * @brief Acquire a buffer of at least bytes
+     * @param bytes Requested size (0 yields an empty handle)
+     * @return Handle with refcount 1, or empty handle on allocation failure
+     *
+     * Contents are uninitialized.
+     */
+    FrameHandle Acquire(size_t bytes);
+
+    /**
+     * @brief Pre-populate the free list for a size
+     * @param bytes Frame size
+     * @param count Number of blocks to have cached
+     * @return true if all blocks were allocated
+     *
+     * Call at session start so the first frames do not allocate.
+     */
+    bool Reserve(size_t bytes, size_t count);
+
+    /**
+     * @brief Free all cached blocks
+     */
+    void Trim();
+
+    /**
+     * @brief Get usage counters
+     * @return Snapshot of statistics
+     */
+    FramePoolStats GetStats() const;
+
+    /**
+     * @brief Reset high-water marks to the current usage
+     */
+    void ResetHighWater();
+
+    /**
+     * @brief Get configured alignment
+     * @return Alignment in bytes
+     */
+    size_t GetAlignment() const { return config_.alignment; }
+
+    // =========================================================================
+    // Raw interface (used by PoolAllocator)
+    // =========================================================================
+
+    /**
+     * @brief Allocate a block and return its data pointer (refcount 1)
+     * @param bytes Requested size
+     * @return Aligned pointer, or nullptr on failure
+     */
+    void* AllocateRaw(size_t bytes);
+
+    /**
+     * @brief Release a pointer obtained from AllocateRaw() or a handle
+     * @param data Data pointer (nullptr is ignored)
+     *
+     * Releases one reference; the owning pool is taken from the block
+     * header, so any pool's block may be passed here.
+     */
+    static void ReleaseRaw(void* data) noexcept;
+
+    // =========================================================================
+    // Size classes
+    // =========================================================================
+
+    /**
+     * @brief Map a byte count to its size class
+     * @param bytes Requested size
+     * @return Class index, or kUnpooledClass if larger than the largest class
+     */
+    static uint32_t SizeClassOf(size_t bytes);
+
+    /**
+     * @brief Get the capacity of a size class
+     * @param size_class Class index (< kNumSizeClasses)
+     * @return Capacity in bytes
+     */
+    static size_t SizeClassBytes(uint32_t size_class);
+
+private:
+    friend class FrameHandle;
+
+    FrameBlockHeader* AcquireBlock(size_t bytes);
+    FrameBlockHeader* AllocateBlock(uint32_t size_class, size_t capacity);
+    void FreeBlock(FrameBlockHeader* header);
+    void ReturnBlock(FrameBlockHeader* header);
+    void NoteAcquired(size_t capacity);
+
+    static void ReleaseHeader(FrameBlockHeader* header) noexcept;
+
+    struct SizeClassList {
+        std::mutex mutex;
+        std::vector<FrameBlockHeader*> free_blocks;
+    };
+
+    FramePoolConfig config_;
+    std::array<SizeClassList, kNumSizeClasses> classes_;
+
+    std::atomic<size_t> bytes_in_use_{0};
+    std::atomic<size_t> high_water_bytes_{0};
+    std::atomic<size_t> blocks_in_use_{0};
+    std::atomic<size_t> high_water_blocks_{0};
+    std::atomic<size_t> bytes_cached_{0};
+    std::atomic<uint64_t> acquisitions_{0};
+    std::atomic<uint64_t> pool_hits_{0};
+    std::atomic<uint64_t> system_allocations_{0};
+    std::atomic<uint64_t> huge_page_blocks_{0};
+};
+
+inline void FrameHandle::Reset() noexcept {
+    if (header_ != nullptr) {
+        FramePool::ReleaseHeader(header_);
+        header_ = nullptr;
+        size_ = 0;
+    }
+}
+
+// =============================================================================
+// PoolAllocator
+// =============================================================================
+
+/**
+ * @brief Standard allocator drawing from a FramePool
+ *
+ * Lets layers that store pixels in std::vector (hal::RawFrame,
+ * ipc::ImageBuffer) reuse pooled, aligned memory without changing how the
+ * vector is used. Deallocation always returns to the block's own pool, so
+ * vectors may be moved between modules.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept : pool_(&FramePool::Default()) {}
+    explicit PoolAllocator(FramePool& pool) noexcept : pool_(&pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        void* data = pool_->AllocateRaw(n * sizeof(T));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* data, size_t /*n*/) noexcept {
+        FramePool::ReleaseRaw(data);
+    }
+
+    FramePool* pool() const noexcept { return pool_; }
+
+    // Any pool can release any block, so all instances are interchangeable
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+
+private:
+    FramePool* pool_;
+};
+
+/// std::vector backed by the frame pool
+template <typename T>
+using PooledVector = std::vector<T, PoolAllocator<T>>;
+
+} // namespace hnvue::infra
+
+#endif // HNUE_INFRA_FRAME_POOL_H
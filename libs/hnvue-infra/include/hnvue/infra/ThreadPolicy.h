@@ -0,0 +1,222 @@
+/**
+ * @file ThreadPolicy.h
+ * @brief Real-time thread policy (scheduling, CPU pinning, memory locking)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: thread scheduling configuration
+ * SPDX-License-Identifier: MIT
+ *
+ * Latency-critical threads (AEC termination, exposure abort, detector frame
+ * ingestion) must not compete with logging, gRPC and image processing at
+ * default priority. This header provides a named policy registry so that
+ * deployment configuration decides how a thread is scheduled, while the code
+ * that owns the thread only states which role it plays.
+ */
+
+#ifndef HNUE_INFRA_THREAD_POLICY_H
+#define HNUE_INFRA_THREAD_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hnvue::infra {
+
+// =============================================================================
+// Enumerations
+// =============================================================================
+
+/**
+ * @brief Scheduling class applied to a thread
+ *
+ * SCHED_CLASS_FIFO and SCHED_CLASS_RR map to the POSIX real-time classes on
+ * Linux. On Windows they map to THREAD_PRIORITY_TIME_CRITICAL /
+ * THREAD_PRIORITY_HIGHEST respectively.
+ */
+enum class SchedulingClass : int32_t {
+    SCHED_CLASS_DEFAULT = 0,  ///< Leave the OS default (SCHED_OTHER)
+    SCHED_CLASS_FIFO = 1,     ///< Real-time, run until block or preempted
+    SCHED_CLASS_RR = 2        ///< Real-time, round-robin among equal priority
+};
+
+/**
+ * @brief Result of applying one aspect of a thread policy
+ */
+enum class ThreadPolicyResult : int32_t {
+    POLICY_OK = 0,                ///< Applied (or nothing to apply)
+    POLICY_ERR_PERMISSION = 1,    ///< Missing CAP_SYS_NICE / RLIMIT_RTPRIO / RLIMIT_MEMLOCK
+    POLICY_ERR_PARAM = 2,         ///< Invalid priority or CPU index
+    POLICY_ERR_NOT_SUPPORTED = 3, ///< Not available on this platform
+    POLICY_ERR_SYSTEM = 4         ///< Other OS error
+};
+
+// =============================================================================
+// Policy Description
+// =============================================================================
+
+/// Lowest accepted real-time priority (POSIX sched_get_priority_min)
+constexpr int32_t kMinRealtimePriority = 1;
+
+/// Highest accepted real-time priority (POSIX sched_get_priority_max)
+constexpr int32_t kMaxRealtimePriority = 99;
+
+/**
+ * @brief Scheduling policy for a single thread
+ */
+struct ThreadPolicy {
+    SchedulingClass scheduling = SchedulingClass::SCHED_CLASS_DEFAULT;
+    int32_t priority = 0;              ///< 1-99 for FIFO/RR, ignored for DEFAULT
+    std::vector<int32_t> cpu_affinity; ///< CPU indices; empty = no pinning
+    size_t stack_prefault_bytes = 0;   ///< Stack bytes to touch up front (0 = none)
+};
+
+/**
+ * @brief Outcome of ApplyThreadPolicy(), one result per policy aspect
+ */
+struct ThreadPolicyReport {
+    ThreadPolicyResult scheduling = ThreadPolicyResult::POLICY_OK;
+    ThreadPolicyResult affinity = ThreadPolicyResult::POLICY_OK;
+    ThreadPolicyResult stack_prefault = ThreadPolicyResult::POLICY_OK;
+
+    /**
+     * @brief Check whether every aspect of the policy was applied
+     * @return true if all results are POLICY_OK
+     */
+    inline bool AllApplied() const {
+        return scheduling == ThreadPolicyResult::POLICY_OK &&
+               affinity == ThreadPolicyResult::POLICY_OK &&
+               stack_prefault == ThreadPolicyResult::POLICY_OK;
+    }
+};
+
+// =============================================================================
+// ThreadPolicyRegistry
+// =============================================================================
+
+/**
+ * @brief Process-wide map from thread role name to ThreadPolicy
+ *
+ * Thread owners call ApplyNamedThreadPolicy("hal.aec") at thread start; the
+ * policy itself is configured once at startup (DeviceManager, main). Roles
+ * without a registered policy run with the OS default.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class ThreadPolicyRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     * @return Registry singleton
+     */
+    static ThreadPolicyRegistry& Instance();
+
+    ThreadPolicyRegistry() = default;
+
+    // Non-copyable
+    ThreadPolicyRegistry(const ThreadPolicyRegistry&) = delete;
+    ThreadPolicyRegistry& operator=(const ThreadPolicyRegistry&) = delete;
+
+    /**
+     * @brief Register or replace the policy for a thread role
+     * @param name Thread role name (e.g., "hal.aec")
+     * @param policy Policy to apply when that role starts
+     */
+    void SetPolicy(const std::string& name, const ThreadPolicy& policy);
+
+    /**
+     * @brief Look up the policy for a thread role
+     * @param name Thread role name
+     * @param[out] policy Receives the registered policy
+     * @return true if a policy is registered for name
+     */
+    bool GetPolicy(const std::string& name, ThreadPolicy& policy) const;
+
+    /**
+     * @brief Remove the policy for a thread role
+     * @param name Thread role name
+     */
+    void RemovePolicy(const std::string& name);
+
+    /**
+     * @brief Remove all registered policies
+     */
+    void Clear();
+
+    /**
+     * @brief Get the names of all registered roles
+     * @return Vector of role names (unordered)
+     */
+    std::vector<std::string> GetNames() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ThreadPolicy> policies_;
+};
+
+// =============================================================================
+// Policy Application
+// =============================================================================
+
+/**
+ * @brief Apply a policy to the calling thread
+ * @param policy Policy to apply
+ * @return Per-aspect result
+ *
+ * Each aspect is attempted independently: a missing real-time privilege does
+ * not prevent CPU pinning or stack pre-faulting. Callers are expected to log
+ * a non-OK report and continue; the thread remains functional at default
+ * priority.
+ */
+ThreadPolicyReport ApplyThreadPolicy(const ThreadPolicy& policy);
+
+/**
+ * @brief Name the calling thread and apply its registered policy
+ * @param name Thread role name; also set as the OS thread name (truncated
+ *             to 15 characters on Linux)
+ * @return Per-aspect result (all POLICY_OK if no policy is registered)
+ */
+ThreadPolicyReport ApplyNamedThreadPolicy(const std::string& name);
+
+/**
+ * @brief Read the scheduling class and priority of the calling thread
+ * @param[out] policy Receives scheduling and priority (affinity left empty)
+ * @return POLICY_OK on success
+ */
+ThreadPolicyResult GetCurrentThreadScheduling(ThreadPolicy& policy);
+
+/**
+ * @brief Lock all current and future process pages into RAM (mlockall)
+ * @return POLICY_OK on success, POLICY_ERR_PERMISSION if RLIMIT_MEMLOCK is
+ *         insufficient
+ *
+ * Prevents page faults on the exposure control path after startup.
+ */
+ThreadPolicyResult LockProcessMemory();
+
+/**
+ * @brief Undo LockProcessMemory() (munlockall)
+ * @return POLICY_OK on success
+ */
+ThreadPolicyResult UnlockProcessMemory();
+
+/**
+ * @brief Get CPUs isolated from the general scheduler
+ * @return CPU indices from /sys/devices/system/cpu/isolated (isolcpus=),
+ *         empty if none or not supported
+ */
+std::vector<int32_t> GetIsolatedCpus();
+
+/**
+ * @brief Parse a Linux CPU list string such as "2-3,6"
+ * @param cpu_list CPU list in kernel cpulist format
+ * @return CPU indices in ascending order; empty on malformed input
+ */
+std::vector<int32_t> ParseCpuList(const std::string& cpu_list);
+
+} // namespace hnvue::infra
+
+#endif // HNUE_INFRA_THREAD_POLICY_H
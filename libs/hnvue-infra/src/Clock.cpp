@@ -0,0 +1,186 @@
+/**
+ * @file Clock.cpp
+ * @brief Process-wide monotonic timestamp service implementation
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: timestamp time base
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/infra/Clock.h"
+
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define HNVUE_CLOCK_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+    #include <x86intrin.h>
+    #define HNVUE_CLOCK_HAS_TSC 1
+#else
+    #define HNVUE_CLOCK_HAS_TSC 0
+#endif
+
+namespace hnvue::infra {
+
+namespace {
+
+// =============================================================================
+// Clock State
+// =============================================================================
+
+/// Calibration interval against the OS monotonic clock
+constexpr auto kCalibrationInterval = std::chrono::milliseconds(10);
+
+/// Fixed-point shift for the ticks-to-nanoseconds multiplier
+constexpr uint32_t kMultShift = 32;
+
+struct ClockState {
+    bool use_tsc = false;
+    uint64_t tsc_epoch = 0;           ///< TSC value at the process epoch
+    uint64_t ns_per_tick_fp = 0;      ///< Nanoseconds per tick, 32.32 fixed point
+    double tsc_hz = 0.0;
+    std::chrono::steady_clock::time_point steady_epoch;
+    int64_t wall_epoch_us = 0;        ///< Unix time of the process epoch
+};
+
+#if HNVUE_CLOCK_HAS_TSC
+inline uint64_t ReadTsc() noexcept {
+    return __rdtsc();
+}
+
+/**
+ * @brief Check CPUID for an invariant (constant-rate, non-stop) TSC
+ */
+bool HasInvariantTsc() {
+#if defined(_MSC_VER)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+        return false;
+    }
+    __cpuid(regs, 0x80000007);
+    return (regs[3] & (1 << 8)) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007u) {
+        return false;
+    }
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#endif
+}
+#endif
+
+/**
+ * @brief Multiply ticks by a 32.32 fixed-point factor without overflow
+ */
+inline uint64_t ScaleTicks(uint64_t ticks, uint64_t factor_fp) noexcept {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(ticks) * factor_fp) >> kMultShift);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high = 0;
+    uint64_t low = _umul128(ticks, factor_fp, &high);
+    return (high << (64 - kMultShift)) | (low >> kMultShift);
+#else
+    uint64_t high = (ticks >> 32) * factor_fp;
+    uint64_t low = ((ticks & 0xFFFFFFFFull) * factor_fp) >> kMultShift;
+    return high + low;
+#endif
+}
+
+ClockState Calibrate() {
+    ClockState state;
+
+#if HNVUE_CLOCK_HAS_TSC
+    if (HasInvariantTsc()) {
+        auto steady_start = std::chrono::steady_clock::now();
+        uint64_t tsc_start = ReadTsc();
+        std::this_thread::sleep_for(kCalibrationInterval);
+        auto steady_end = std::chrono::steady_clock::now();
+        uint64_t tsc_end = ReadTsc();
+
+        double elapsed_ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(steady_end - steady_start).count());
+        double ticks = static_cast<double>(tsc_end - tsc_start);
+        if (elapsed_ns > 0.0 && ticks > 0.0) {
+            state.use_tsc = true;
+            state.tsc_hz = ticks * 1e9 / elapsed_ns;
+            state.ns_per_tick_fp = static_cast<uint64_t>(
+                (elapsed_ns / ticks) * static_cast<double>(1ull << kMultShift));
+        }
+    }
+#endif
+
+    // Fix the epoch as close together as possible on all time bases
+    state.steady_epoch = std::chrono::steady_clock::now();
+#if HNVUE_CLOCK_HAS_TSC
+    state.tsc_epoch = ReadTsc();
+#endif
+    state.wall_epoch_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return state;
+}
+
+const ClockState& State() {
+    static const ClockState state = Calibrate();
+    return state;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// MonotonicClock
+// =============================================================================
+
+void MonotonicClock::Initialize() {
+    (void)State();
+}
+
+int64_t MonotonicClock::NowNs() noexcept {
+    const ClockState& state = State();
+#if HNVUE_CLOCK_HAS_TSC
+    if (state.use_tsc) {
+        uint64_t ticks = ReadTsc();
+        // A thread that read the TSC on another socket just before the epoch
+        // could see a slightly smaller value; clamp rather than wrap
+        if (ticks <= state.tsc_epoch) {
+            return 0;
+        }
+        return static_cast<int64_t>(ScaleTicks(ticks - state.tsc_epoch, state.ns_per_tick_fp));
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state.steady_epoch).count();
+}
+
+MonotonicClock::time_point MonotonicClock::now() noexcept {
+    return time_point(duration(NowNs()));
+}
+
+int64_t MonotonicClock::NowUs() noexcept {
+    return NowNs() / 1000;
+}
+
+int64_t MonotonicClock::ToWallClockUs(int64_t since_start_us) noexcept {
+    return State().wall_epoch_us + since_start_us;
+}
+
+int64_t MonotonicClock::FromWallClockUs(int64_t unix_us) noexcept {
+    return unix_us - State().wall_epoch_us;
+}
+
+bool MonotonicClock::IsTscBased() noexcept {
+    return State().use_tsc;
+}
+
+double MonotonicClock::TscFrequencyHz() noexcept {
+    return State().tsc_hz;
+}
+
+} // namespace hnvue::infra
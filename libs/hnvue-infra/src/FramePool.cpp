@@ -0,0 +1,392 @@
+/**
+ * @file FramePool.cpp
+ * @brief Aligned size-class frame pool implementation
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: frame memory management
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/infra/FramePool.h"
+
+#include <cstdlib>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace hnvue::infra {
+
+namespace {
+
+// =============================================================================
+// Backing Memory
+// =============================================================================
+
+/// FrameBlockHeader::flags: block was mmap'd (else heap)
+constexpr uint32_t kFlagMapped = 0x1;
+
+/// FrameBlockHeader::flags: block is backed by explicit huge pages
+constexpr uint32_t kFlagHugePages = 0x2;
+
+size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+bool IsPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+/**
+ * @brief Allocate backing memory for a block
+ * @param total Header plus capacity in bytes
+ * @param alignment Required alignment of the block base
+ * @param huge_pages Try huge-page backing (Linux only)
+ * @param[out] mapping_bytes Mapped length for munmap, 0 for heap
+ * @param[out] flags Backing flags
+ * @return Block base, or nullptr on failure
+ */
+void* AllocateBacking(size_t total, size_t alignment, bool huge_pages,
+                      size_t& mapping_bytes, uint32_t& flags) {
+    mapping_bytes = 0;
+    flags = 0;
+
+#if defined(__linux__)
+    if (huge_pages && total >= kHugePageSize) {
+        size_t length = RoundUp(total, kHugePageSize);
+        void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            mapping_bytes = length;
+            flags = kFlagMapped | kFlagHugePages;
+            return base;
+        }
+
+        // No reserved huge pages: fall back to transparent huge pages
+        base = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED) {
+            madvise(base, length, MADV_HUGEPAGE);
+            mapping_bytes = length;
+            flags = kFlagMapped;
+            return base;
+        }
+    }
+#else
+    (void)huge_pages;
+#endif
+
+#ifdef _WIN32
+    return _aligned_malloc(total, alignment);
+#else
+    void* base = nullptr;
+    if (posix_memalign(&base, alignment, total) != 0) {
+        return nullptr;
+    }
+    return base;
+#endif
+}
+
+void FreeBacking(void* base, size_t mapping_bytes, uint32_t flags) {
+#if !defined(_WIN32)
+    if ((flags & kFlagMapped) != 0) {
+        munmap(base, mapping_bytes);
+        return;
+    }
+#else
+    (void)mapping_bytes;
+    (void)flags;
+#endif
+
+#ifdef _WIN32
+    _aligned_free(base);
+#else
+    std::free(base);
+#endif
+}
+
+FrameBlockHeader* HeaderFromData(void* data) {
+    // AllocateBlock() stores the header address in the pointer-sized slot
+    // immediately before the data
+    auto* back_pointer = reinterpret_cast<FrameBlockHeader**>(
+        static_cast<uint8_t*>(data) - sizeof(FrameBlockHeader*));
+    FrameBlockHeader* header = *back_pointer;
+    if (header == nullptr || header->magic != kFrameBlockMagic) {
+        return nullptr;
+    }
+    return header;
+}
+
+void UpdateMax(std::atomic<size_t>& target, size_t value) {
+    size_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Size Classes
+// =============================================================================
+
+uint32_t FramePool::SizeClassOf(size_t bytes) {
+    if (bytes <= kMinSizeClassBytes) {
+        return 0;
+    }
+
+    // Classes within [base, 2*base] are base * (1 + step/4), step 1..4
+    size_t b = bytes - 1;
+    uint32_t msb = 0;
+    while ((b >> (msb + 1)) != 0) {
+        ++msb;
+    }
+    size_t base = static_cast<size_t>(1) << msb;
+    uint32_t group = msb - 12;  // log2(kMinSizeClassBytes)
+    uint32_t step = static_cast<uint32_t>((b - base) / (base / kSizeClassSteps)) + 1;
+    uint32_t index = group * kSizeClassSteps + step;
+
+    return index < kNumSizeClasses ? index : kUnpooledClass;
+}
+
+size_t FramePool::SizeClassBytes(uint32_t size_class) {
+    uint32_t group = size_class / kSizeClassSteps;
+    uint32_t step = size_class % kSizeClassSteps;
+    size_t base = kMinSizeClassBytes << group;
+    return base + (base / kSizeClassSteps) * step;
+}
+
+// =============================================================================
+// Construction / Destruction
+// =============================================================================
+
+FramePool& FramePool::Default() {
+    // Intentionally leaked: blocks may be released during static destruction
+    static FramePool* pool = new FramePool(FramePoolConfig{});
+    return *pool;
+}
+
+FramePool::FramePool(const FramePoolConfig& config)
+    : config_(config)
+{
+    if (!IsPowerOfTwo(config_.alignment) || config_.alignment < kCacheLineSize) {
+        config_.alignment = kCacheLineSize;
+    }
+    if (config_.alignment > kPageSize) {
+        config_.alignment = kPageSize;
+    }
+}
+
+FramePool::~FramePool() {
+    Trim();
+}
+
+// =============================================================================
+// Acquisition / Release
+// =============================================================================
+
+FrameHandle FramePool::Acquire(size_t bytes) {
+    if (bytes == 0) {
+        return FrameHandle{};
+    }
+    FrameBlockHeader* header = AcquireBlock(bytes);
+    if (header == nullptr) {
+        return FrameHandle{};
+    }
+    return FrameHandle(header, bytes);
+}
+
+void* FramePool::AllocateRaw(size_t bytes) {
+    FrameBlockHeader* header = AcquireBlock(bytes == 0 ? 1 : bytes);
+    if (header == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<uint8_t*>(header) + header->header_bytes;
+}
+
+void FramePool::ReleaseRaw(void* data) noexcept {
+    if (data == nullptr) {
+        return;
+    }
+    FrameBlockHeader* header = HeaderFromData(data);
+    if (header != nullptr) {
+        ReleaseHeader(header);
+    }
+}
+
+void FramePool::ReleaseHeader(FrameBlockHeader* header) noexcept {
+    if (header->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        header->pool->ReturnBlock(header);
+    }
+}
+
+FrameBlockHeader* FramePool::AcquireBlock(size_t bytes) {
+    uint32_t size_class = SizeClassOf(bytes);
+
+    if (size_class != kUnpooledClass) {
+        SizeClassList& list = classes_[size_class];
+        FrameBlockHeader* header = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (!list.free_blocks.empty()) {
+                header = list.free_blocks.back();
+                list.free_blocks.pop_back();
+            }
+        }
+        if (header != nullptr) {
+            bytes_cached_.fetch_sub(header->capacity, std::memory_order_relaxed);
+            header->refcount.store(1, std::memory_order_relaxed);
+            pool_hits_.fetch_add(1, std::memory_order_relaxed);
+            NoteAcquired(header->capacity);
+            return header;
+        }
+    }
+
+    size_t capacity = (size_class == kUnpooledClass)
+                          ? RoundUp(bytes, config_.alignment)
+                          : SizeClassBytes(size_class);
+    FrameBlockHeader* header = AllocateBlock(size_class, capacity);
+    if (header == nullptr) {
+        return nullptr;
+    }
+    NoteAcquired(header->capacity);
+    return header;
+}
+
+FrameBlockHeader* FramePool::AllocateBlock(uint32_t size_class, size_t capacity) {
+    static_assert(sizeof(FrameBlockHeader) + sizeof(FrameBlockHeader*) <= kCacheLineSize,
+                  "FrameBlockHeader and back pointer must fit in one cache line");
+
+    size_t header_bytes = config_.alignment;
+    size_t mapping_bytes = 0;
+    uint32_t flags = 0;
+    void* base = AllocateBacking(header_bytes + capacity, config_.alignment,
+                                 config_.use_huge_pages, mapping_bytes, flags);
+    if (base == nullptr) {
+        return nullptr;
+    }
+
+    auto* header = new (base) FrameBlockHeader;
+    header->pool = this;
+    header->refcount.store(1, std::memory_order_relaxed);
+    header->size_class = size_class;
+    header->capacity = capacity;
+    header->mapping_bytes = mapping_bytes;
+    header->header_bytes = header_bytes;
+    header->flags = flags;
+    header->magic = kFrameBlockMagic;
+
+    auto* data = static_cast<uint8_t*>(base) + header_bytes;
+    *reinterpret_cast<FrameBlockHeader**>(data - sizeof(FrameBlockHeader*)) = header;
+
+    system_allocations_.fetch_add(1, std::memory_order_relaxed);
+    if ((flags & kFlagHugePages) != 0) {
+        huge_page_blocks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return header;
+}
+
+void FramePool::NoteAcquired(size_t capacity) {
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    size_t bytes = bytes_in_use_.fetch_add(capacity, std::memory_order_relaxed) + capacity;
+    size_t blocks = blocks_in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+    UpdateMax(high_water_bytes_, bytes);
+    UpdateMax(high_water_blocks_, blocks);
+}
+
+void FramePool::ReturnBlock(FrameBlockHeader* header) {
+    bytes_in_use_.fetch_sub(header->capacity, std::memory_order_relaxed);
+    blocks_in_use_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (header->size_class != kUnpooledClass) {
+        size_t cached = bytes_cached_.load(std::memory_order_relaxed);
+        if (cached + header->capacity <= config_.max_cached_bytes) {
+            bytes_cached_.fetch_add(header->capacity, std::memory_order_relaxed);
+            SizeClassList& list = classes_[header->size_class];
+            std::lock_guard<std::mutex> lock(list.mutex);
+            list.free_blocks.push_back(header);
+            return;
+        }
+    }
+    FreeBlock(header);
+}
+
+void FramePool::FreeBlock(FrameBlockHeader* header) {
+    size_t mapping_bytes = header->mapping_bytes;
+    uint32_t flags = header->flags;
+    header->magic = 0;
+    header->~FrameBlockHeader();
+    FreeBacking(header, mapping_bytes, flags);
+}
+
+// =============================================================================
+// Maintenance
+// =============================================================================
+
+bool FramePool::Reserve(size_t bytes, size_t count) {
+    uint32_t size_class = SizeClassOf(bytes);
+    if (bytes == 0 || size_class == kUnpooledClass) {
+        return false;
+    }
+
+    SizeClassList& list = classes_[size_class];
+    size_t capacity = SizeClassBytes(size_class);
+
+    size_t existing = 0;
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        existing = list.free_blocks.size();
+    }
+
+    for (size_t i = existing; i < count; ++i) {
+        FrameBlockHeader* header = AllocateBlock(size_class, capacity);
+        if (header == nullptr) {
+            return false;
+        }
+        header->refcount.store(0, std::memory_order_relaxed);
+        bytes_cached_.fetch_add(capacity, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(list.mutex);
+        list.free_blocks.push_back(header);
+    }
+    return true;
+}
+
+void FramePool::Trim() {
+    for (SizeClassList& list : classes_) {
+        std::vector<FrameBlockHeader*> blocks;
+        {
+            std::lock_guard<std::mutex> lock(list.mutex);
+            blocks.swap(list.free_blocks);
+        }
+        for (FrameBlockHeader* header : blocks) {
+            bytes_cached_.fetch_sub(header->capacity, std::memory_order_relaxed);
+            FreeBlock(header);
+        }
+    }
+}
+
+FramePoolStats FramePool::GetStats() const {
+    FramePoolStats stats;
+    stats.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+    stats.high_water_bytes = high_water_bytes_.load(std::memory_order_relaxed);
+    stats.blocks_in_use = blocks_in_use_.load(std::memory_order_relaxed);
+    stats.high_water_blocks = high_water_blocks_.load(std::memory_order_relaxed);
+    stats.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+    stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+    stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+    stats.system_allocations = system_allocations_.load(std::memory_order_relaxed);
+    stats.huge_page_blocks = huge_page_blocks_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FramePool::ResetHighWater() {
+    high_water_bytes_.store(bytes_in_use_.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+    high_water_blocks_.store(blocks_in_use_.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+}
+
+} // namespace hnvue::infra
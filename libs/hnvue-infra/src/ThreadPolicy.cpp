@@ -0,0 +1,348 @@
+/**
+ * @file ThreadPolicy.cpp
+ * @brief Real-time thread policy implementation
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: thread scheduling configuration
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace hnvue::infra {
+
+namespace {
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+/**
+ * @brief Map errno from a scheduling/affinity call to a policy result
+ */
+ThreadPolicyResult FromErrno(int err) {
+    switch (err) {
+        case 0:
+            return ThreadPolicyResult::POLICY_OK;
+        case EPERM:
+        case EACCES:
+        case ENOMEM:  // mlockall: RLIMIT_MEMLOCK exceeded
+            return ThreadPolicyResult::POLICY_ERR_PERMISSION;
+        case EINVAL:
+            return ThreadPolicyResult::POLICY_ERR_PARAM;
+        case ENOSYS:
+            return ThreadPolicyResult::POLICY_ERR_NOT_SUPPORTED;
+        default:
+            return ThreadPolicyResult::POLICY_ERR_SYSTEM;
+    }
+}
+
+ThreadPolicyResult ApplyScheduling(const ThreadPolicy& policy) {
+    if (policy.scheduling == SchedulingClass::SCHED_CLASS_DEFAULT) {
+        return ThreadPolicyResult::POLICY_OK;
+    }
+    if (policy.priority < kMinRealtimePriority ||
+        policy.priority > kMaxRealtimePriority) {
+        return ThreadPolicyResult::POLICY_ERR_PARAM;
+    }
+
+#ifdef _WIN32
+    int win_priority = (policy.scheduling == SchedulingClass::SCHED_CLASS_FIFO)
+                           ? THREAD_PRIORITY_TIME_CRITICAL
+                           : THREAD_PRIORITY_HIGHEST;
+    if (!SetThreadPriority(GetCurrentThread(), win_priority)) {
+        return ThreadPolicyResult::POLICY_ERR_SYSTEM;
+    }
+    return ThreadPolicyResult::POLICY_OK;
+#else
+    int os_policy = (policy.scheduling == SchedulingClass::SCHED_CLASS_FIFO)
+                        ? SCHED_FIFO
+                        : SCHED_RR;
+    int max_priority = sched_get_priority_max(os_policy);
+    if (max_priority >= 0 && policy.priority > max_priority) {
+        return ThreadPolicyResult::POLICY_ERR_PARAM;
+    }
+
+    sched_param param{};
+    param.sched_priority = policy.priority;
+    return FromErrno(pthread_setschedparam(pthread_self(), os_policy, &param));
+#endif
+}
+
+ThreadPolicyResult ApplyAffinity(const std::vector<int32_t>& cpus) {
+    if (cpus.empty()) {
+        return ThreadPolicyResult::POLICY_OK;
+    }
+
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int32_t cpu : cpus) {
+        if (cpu < 0 || cpu >= static_cast<int32_t>(sizeof(DWORD_PTR) * 8)) {
+            return ThreadPolicyResult::POLICY_ERR_PARAM;
+        }
+        mask |= (static_cast<DWORD_PTR>(1) << cpu);
+    }
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        return ThreadPolicyResult::POLICY_ERR_PARAM;
+    }
+    return ThreadPolicyResult::POLICY_OK;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int32_t cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return ThreadPolicyResult::POLICY_ERR_PARAM;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return FromErrno(pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+#else
+    return ThreadPolicyResult::POLICY_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief Touch stack pages so the first deep call on the RT path does not fault
+ *
+ * The buffer is written through a volatile pointer so the compiler cannot
+ * elide it. Combined with LockProcessMemory() the pages stay resident.
+ */
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+ThreadPolicyResult PrefaultStack(size_t bytes) {
+    if (bytes == 0) {
+        return ThreadPolicyResult::POLICY_OK;
+    }
+
+    constexpr size_t kMaxPrefault = 8 * 1024 * 1024;
+    constexpr size_t kChunk = 4096;
+    if (bytes > kMaxPrefault) {
+        return ThreadPolicyResult::POLICY_ERR_PARAM;
+    }
+
+#ifdef _WIN32
+    volatile unsigned char* stack = static_cast<unsigned char*>(_alloca(bytes));
+#else
+    volatile unsigned char* stack = static_cast<unsigned char*>(__builtin_alloca(bytes));
+#endif
+    for (size_t offset = 0; offset < bytes; offset += kChunk) {
+        stack[offset] = 0;
+    }
+    stack[bytes - 1] = 0;
+    return ThreadPolicyResult::POLICY_OK;
+}
+
+void SetCurrentThreadName(const std::string& name) {
+#if defined(__linux__)
+    // Linux limits thread names to 16 bytes including the terminator
+    std::string truncated = name.substr(0, 15);
+    pthread_setname_np(pthread_self(), truncated.c_str());
+#else
+    (void)name;
+#endif
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// ThreadPolicyRegistry
+// =============================================================================
+
+ThreadPolicyRegistry& ThreadPolicyRegistry::Instance() {
+    static ThreadPolicyRegistry registry;
+    return registry;
+}
+
+void ThreadPolicyRegistry::SetPolicy(const std::string& name, const ThreadPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policies_[name] = policy;
+}
+
+bool ThreadPolicyRegistry::GetPolicy(const std::string& name, ThreadPolicy& policy) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = policies_.find(name);
+    if (it == policies_.end()) {
+        return false;
+    }
+    policy = it->second;
+    return true;
+}
+
+void ThreadPolicyRegistry::RemovePolicy(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policies_.erase(name);
+}
+
+void ThreadPolicyRegistry::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policies_.clear();
+}
+
+std::vector<std::string> ThreadPolicyRegistry::GetNames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(policies_.size());
+    for (const auto& [name, policy] : policies_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+// =============================================================================
+// Policy Application
+// =============================================================================
+
+ThreadPolicyReport ApplyThreadPolicy(const ThreadPolicy& policy) {
+    ThreadPolicyReport report;
+    // Pin first so the stack pages are faulted in on the target CPU's node
+    report.affinity = ApplyAffinity(policy.cpu_affinity);
+    report.stack_prefault = PrefaultStack(policy.stack_prefault_bytes);
+    report.scheduling = ApplyScheduling(policy);
+    return report;
+}
+
+ThreadPolicyReport ApplyNamedThreadPolicy(const std::string& name) {
+    SetCurrentThreadName(name);
+
+    ThreadPolicy policy;
+    if (!ThreadPolicyRegistry::Instance().GetPolicy(name, policy)) {
+        return ThreadPolicyReport{};
+    }
+    return ApplyThreadPolicy(policy);
+}
+
+ThreadPolicyResult GetCurrentThreadScheduling(ThreadPolicy& policy) {
+#ifdef _WIN32
+    int priority = GetThreadPriority(GetCurrentThread());
+    if (priority == THREAD_PRIORITY_TIME_CRITICAL) {
+        policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+    } else if (priority == THREAD_PRIORITY_HIGHEST) {
+        policy.scheduling = SchedulingClass::SCHED_CLASS_RR;
+    } else {
+        policy.scheduling = SchedulingClass::SCHED_CLASS_DEFAULT;
+    }
+    policy.priority = priority;
+    return ThreadPolicyResult::POLICY_OK;
+#else
+    int os_policy = 0;
+    sched_param param{};
+    int err = pthread_getschedparam(pthread_self(), &os_policy, &param);
+    if (err != 0) {
+        return FromErrno(err);
+    }
+    switch (os_policy) {
+        case SCHED_FIFO:
+            policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+            break;
+        case SCHED_RR:
+            policy.scheduling = SchedulingClass::SCHED_CLASS_RR;
+            break;
+        default:
+            policy.scheduling = SchedulingClass::SCHED_CLASS_DEFAULT;
+            break;
+    }
+    policy.priority = param.sched_priority;
+    return ThreadPolicyResult::POLICY_OK;
+#endif
+}
+
+ThreadPolicyResult LockProcessMemory() {
+#ifdef _WIN32
+    return ThreadPolicyResult::POLICY_ERR_NOT_SUPPORTED;
+#else
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        return FromErrno(errno);
+    }
+    return ThreadPolicyResult::POLICY_OK;
+#endif
+}
+
+ThreadPolicyResult UnlockProcessMemory() {
+#ifdef _WIN32
+    return ThreadPolicyResult::POLICY_ERR_NOT_SUPPORTED;
+#else
+    if (munlockall() != 0) {
+        return FromErrno(errno);
+    }
+    return ThreadPolicyResult::POLICY_OK;
+#endif
+}
+
+std::vector<int32_t> GetIsolatedCpus() {
+#if defined(__linux__)
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    if (!file.is_open()) {
+        return {};
+    }
+    std::string line;
+    std::getline(file, line);
+    return ParseCpuList(line);
+#else
+    return {};
+#endif
+}
+
+std::vector<int32_t> ParseCpuList(const std::string& cpu_list) {
+    std::vector<int32_t> cpus;
+    std::stringstream stream(cpu_list);
+    std::string token;
+
+    while (std::getline(stream, token, ',')) {
+        // Strip whitespace / trailing newline
+        token.erase(std::remove_if(token.begin(), token.end(),
+                                   [](unsigned char c) { return std::isspace(c); }),
+                    token.end());
+        if (token.empty()) {
+            continue;
+        }
+
+        size_t dash = token.find('-');
+        char* end = nullptr;
+        if (dash == std::string::npos) {
+            long cpu = std::strtol(token.c_str(), &end, 10);
+            if (*end != '\0' || cpu < 0) {
+                return {};
+            }
+            cpus.push_back(static_cast<int32_t>(cpu));
+        } else {
+            std::string first_str = token.substr(0, dash);
+            std::string last_str = token.substr(dash + 1);
+            long first = std::strtol(first_str.c_str(), &end, 10);
+            if (first_str.empty() || *end != '\0') {
+                return {};
+            }
+            long last = std::strtol(last_str.c_str(), &end, 10);
+            if (last_str.empty() || *end != '\0' || first < 0 || last < first) {
+                return {};
+            }
+            for (long cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<int32_t>(cpu));
+            }
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+} // namespace hnvue::infra
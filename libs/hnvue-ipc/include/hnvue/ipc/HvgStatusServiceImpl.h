@@ -0,0 +1,96 @@
+/**
+ * @file HvgStatusServiceImpl.h
+ * @brief HvgControl StreamStatus / StreamAlarms server (Core Engine -> GUI)
+ * SPEC-IPC-001: Generator status streaming (hvg_control.proto)
+ *
+ * The two streaming RPCs are served with the callback API on raw
+ * ByteBuffers so that one serialized message is shared by every client.
+ * The unary HvgControl RPCs are not served here and return UNIMPLEMENTED.
+ */
+
+#ifndef HNVE_IPC_HVG_STATUS_SERVICE_IMPL_H
+#define HNVE_IPC_HVG_STATUS_SERVICE_IMPL_H
+
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <spdlog/spdlog.h>
+
+#include "hnvue/ipc/StatusStreamHub.h"
+
+// Generated protobuf headers
+#include "hvg_control.grpc.pb.h"
+#include "hvg_control.pb.h"
+
+namespace hnvue::ipc {
+
+using hnvue::hal::hvg::HvgControl;
+
+/// Base with StreamStatus and StreamAlarms switched to raw callback handlers
+using HvgStatusServiceBase = HvgControl::WithRawCallbackMethod_StreamStatus<
+    HvgControl::WithRawCallbackMethod_StreamAlarms<HvgControl::Service>>;
+
+/**
+ * @class HvgStatusServiceImpl
+ * @brief gRPC service implementation for generator status and alarm streaming
+ *
+ * Thread safety: PublishStatus/PublishAlarm may be called from any thread
+ * (typically the generator status and alarm callbacks). Neither blocks on
+ * a client: each stream has at most one write outstanding, newer status
+ * replaces an unsent older one, and alarms queue in order.
+ */
+class HvgStatusServiceImpl final : public HvgStatusServiceBase {
+public:
+    /**
+     * @brief Construct HvgStatusService implementation
+     * @param logger Logger instance
+     * @param config Rate adaptation settings
+     */
+    explicit HvgStatusServiceImpl(
+        std::shared_ptr<spdlog::logger> logger = spdlog::default_logger(),
+        const StatusStreamConfig& config = StatusStreamConfig()
+    );
+
+    ~HvgStatusServiceImpl() override = default;
+
+    // Non-copyable, non-movable
+    HvgStatusServiceImpl(const HvgStatusServiceImpl&) = delete;
+    HvgStatusServiceImpl& operator=(const HvgStatusServiceImpl&) = delete;
+
+    /**
+     * @brief Stream generator status until the client cancels
+     *
+     * The stream starts with the last forwarded status, if any.
+     */
+    grpc::ServerWriteReactor<grpc::ByteBuffer>* StreamStatus(
+        grpc::CallbackServerContext* context,
+        const grpc::ByteBuffer* request) override;
+
+    /**
+     * @brief Stream generator alarms until the client cancels
+     */
+    grpc::ServerWriteReactor<grpc::ByteBuffer>* StreamAlarms(
+        grpc::CallbackServerContext* context,
+        const grpc::ByteBuffer* request) override;
+
+    /**
+     * @brief Offer a status update (called by the generator status path)
+     * @return true if forwarded to subscribers
+     */
+    bool PublishStatus(const HvgStatus& status);
+
+    /**
+     * @brief Deliver an alarm to all alarm subscribers
+     */
+    void PublishAlarm(const HvgAlarm& alarm);
+
+    StatusStreamStats GetStats() const;
+
+private:
+    std::shared_ptr<spdlog::logger> logger_;
+    StatusStreamHub hub_;
+    StatusStreamConfig config_;
+};
+
+} // namespace hnvue::ipc
+
+#endif // HNVE_IPC_HVG_STATUS_SERVICE_IMPL_H
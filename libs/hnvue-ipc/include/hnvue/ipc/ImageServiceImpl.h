@@ -21,6 +21,8 @@
 #include <condition_variable>
 #include <spdlog/spdlog.h>
 
+#include "hnvue/infra/FramePool.h"
+
 // Generated protobuf headers
 #include "hnvue_image.grpc.pb.h"
 #include "hnvue_image.pb.h"
@@ -46,13 +48,14 @@ struct ImageBuffer {
     float kv_actual;
     float mas_actual;
     uint32_t detector_id;
-    std::vector<uint8_t> pixel_data;  // Raw 16-bit grayscale pixels
+    int64_t timestamp_us;     // Acquisition time, microseconds since process epoch (infra::MonotonicClock)
+    infra::PooledVector<uint8_t> pixel_data;  // Raw 16-bit grayscale pixels (frame pool)
     ImageTransferMode transfer_mode;
     bool is_valid;
 
     ImageBuffer() : acquisition_id(0), width(0), height(0), bits_per_pixel(16),
                     pixel_pitch_mm(0.0f), kv_actual(0.0f), mas_actual(0.0f),
-                    detector_id(0), transfer_mode(ImageTransferMode::IMAGE_TRANSFER_MODE_UNSPECIFIED),
+                    detector_id(0), timestamp_us(0), transfer_mode(ImageTransferMode::IMAGE_TRANSFER_MODE_UNSPECIFIED),
                     is_valid(false) {}
 };
 
@@ -8,6 +8,7 @@
  * - ImageService: Image streaming to GUI
  * - HealthService: Health monitoring events
  * - ConfigService: Configuration synchronization
+ * - HvgControl (StreamStatus/StreamAlarms): Generator status to GUI
  */
 
 #ifndef HNVE_IPC_IPC_SERVER_H
@@ -25,6 +26,7 @@ class CommandServiceImpl;
 class ImageServiceImpl;
 class HealthServiceImpl;
 class ConfigServiceImpl;
+class HvgStatusServiceImpl;
 
 /**
  * @brief Interface version constants (SPEC-IPC-001 Section 4.5)
@@ -42,7 +44,7 @@ struct IpcInterfaceVersion
  *
  * Responsibilities:
  * - Bind to configured port (default: localhost:50051)
- * - Register all four service implementations
+ * - Register all service implementations
  * - Handle graceful shutdown
  * - Log lifecycle events
  */
@@ -82,7 +84,7 @@ public:
      *
      * SPEC-IPC-001 Section 4.3.1:
      * - Bind to configured port
-     * - Register all four services
+     * - Register all services
      * - Log bound address and InterfaceVersion
      */
     bool Start();
@@ -122,6 +124,12 @@ public:
      */
     std::string GetInterfaceVersion() const;
 
+    /**
+     * @brief Get the generator status streaming service
+     * @return Service to publish status and alarms to, or nullptr before Start()
+     */
+    HvgStatusServiceImpl* GetHvgStatusService() const;
+
 private:
     // Server configuration
     std::string server_address_;
@@ -135,6 +143,7 @@ private:
     std::unique_ptr<ImageServiceImpl> image_service_;
     std::unique_ptr<HealthServiceImpl> health_service_;
     std::unique_ptr<ConfigServiceImpl> config_service_;
+    std::unique_ptr<HvgStatusServiceImpl> hvg_status_service_;
 
     // Server state
     bool is_running_;
@@ -0,0 +1,194 @@
+/**
+ * @file StatusStreamHub.h
+ * @brief Fan-out of generator status and alarms to streaming subscribers
+ * SPEC-IPC-001: HvgControl StreamStatus / StreamAlarms delivery
+ *
+ * Each status or alarm is serialized once into a grpc::ByteBuffer; every
+ * subscriber receives a reference-counted copy of the same slices, so N
+ * clients cost one encode.
+ *
+ * Status rate adapts to the generator state:
+ * - ARMED / EXPOSING: every update is forwarded (full generator rate)
+ * - otherwise: an update is forwarded only when the state or interlock
+ *   changes, kV or mA leave the deadband around the last forwarded value,
+ *   or the keepalive interval has passed
+ *
+ * Alarms are never filtered or coalesced and use their own lock, so alarm
+ * delivery never waits behind a status fan-out.
+ */
+
+#ifndef HNVE_IPC_STATUS_STREAM_HUB_H
+#define HNVE_IPC_STATUS_STREAM_HUB_H
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Generated protobuf headers
+#include "hvg_control.pb.h"
+
+namespace hnvue::ipc {
+
+using hnvue::hal::hvg::HvgStatus;
+using hnvue::hal::hvg::HvgAlarm;
+using hnvue::hal::hvg::GeneratorState;
+
+/**
+ * @struct StatusStreamConfig
+ * @brief Rate adaptation settings
+ */
+struct StatusStreamConfig {
+    float kvp_deadband = 0.5f;          ///< kV change that is forwarded while idle
+    float ma_deadband = 1.0f;           ///< mA change that is forwarded while idle
+    uint32_t idle_keepalive_ms = 1000;  ///< Forward at least this often while idle
+    size_t alarm_queue_depth = 64;      ///< Per-subscriber alarm backlog limit
+};
+
+/**
+ * @struct StatusStreamStats
+ * @brief Hub counters
+ */
+struct StatusStreamStats {
+    uint64_t published = 0;    ///< Status updates offered to the hub
+    uint64_t forwarded = 0;    ///< Updates sent to subscribers
+    uint64_t suppressed = 0;   ///< Updates inside the idle deadband
+    uint64_t encodes = 0;      ///< Serializations (status and alarms)
+    uint64_t alarms = 0;
+    size_t status_subscribers = 0;
+    size_t alarm_subscribers = 0;
+};
+
+/**
+ * @class StreamSink
+ * @brief Receives encoded messages from the hub
+ *
+ * Push is called with the hub lock held and must not block.
+ */
+class StreamSink {
+public:
+    virtual ~StreamSink() = default;
+    virtual void Push(const grpc::ByteBuffer& message) = 0;
+};
+
+/**
+ * @class StreamMailbox
+ * @brief Per-subscriber backlog between the hub and a single outstanding write
+ *
+ * LATEST keeps only the newest message (status: a slow client skips stale
+ * updates). QUEUE keeps every message in order up to a depth limit (alarms;
+ * the oldest is dropped only when a stalled client exceeds the limit).
+ *
+ * Not thread-safe; the owning stream serializes access.
+ */
+class StreamMailbox {
+public:
+    enum class Mode { LATEST, QUEUE };
+
+    explicit StreamMailbox(Mode mode, size_t queue_depth = 64);
+
+    /**
+     * @brief Offer a message
+     * @param[out] start Message to write now if no write is outstanding
+     * @return true if the caller must start a write with *start
+     */
+    bool Offer(const grpc::ByteBuffer& message, grpc::ByteBuffer* start);
+
+    /**
+     * @brief Take the next message after a write completed
+     * @return false if nothing is pending (the stream becomes idle)
+     */
+    bool Next(grpc::ByteBuffer* out);
+
+    /**
+     * @brief Stop accepting messages (stream finishing)
+     */
+    void Close();
+
+    bool IsWriting() const { return writing_; }
+    size_t Pending() const { return pending_.size(); }
+    uint64_t Coalesced() const { return coalesced_; }
+    uint64_t Dropped() const { return dropped_; }
+
+private:
+    Mode mode_;
+    size_t queue_depth_;
+    std::deque<grpc::ByteBuffer> pending_;
+    bool writing_ = false;
+    bool closed_ = false;
+    uint64_t coalesced_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+/**
+ * @class StatusStreamHub
+ * @brief Rate-adaptive status and alarm fan-out
+ *
+ * Thread safety: all methods are thread-safe.
+ */
+class StatusStreamHub {
+public:
+    explicit StatusStreamHub(const StatusStreamConfig& config = StatusStreamConfig());
+
+    // Non-copyable, non-movable
+    StatusStreamHub(const StatusStreamHub&) = delete;
+    StatusStreamHub& operator=(const StatusStreamHub&) = delete;
+
+    /**
+     * @brief Offer a status update
+     *
+     * Keepalive timing uses status.timestamp_us().
+     *
+     * @return true if the update was forwarded to subscribers
+     */
+    bool PublishStatus(const HvgStatus& status);
+
+    /**
+     * @brief Deliver an alarm to every alarm subscriber
+     */
+    void PublishAlarm(const HvgAlarm& alarm);
+
+    /**
+     * @brief Add a status subscriber; it immediately receives the last forwarded status
+     */
+    void AddStatusSink(StreamSink* sink);
+    void RemoveStatusSink(StreamSink* sink);
+
+    void AddAlarmSink(StreamSink* sink);
+    void RemoveAlarmSink(StreamSink* sink);
+
+    StatusStreamStats GetStats() const;
+
+    /**
+     * @brief Serialize a message once for sharing across subscribers
+     */
+    static bool Encode(const google::protobuf::MessageLite& message, grpc::ByteBuffer* out);
+
+private:
+    bool ShouldForward(const HvgStatus& status) const;
+
+    StatusStreamConfig config_;
+
+    mutable std::mutex status_mutex_;
+    std::vector<StreamSink*> status_sinks_;
+    std::optional<HvgStatus> last_forwarded_;
+    grpc::ByteBuffer last_encoded_;
+    uint64_t published_ = 0;
+    uint64_t forwarded_ = 0;
+    uint64_t suppressed_ = 0;
+
+    mutable std::mutex alarm_mutex_;
+    std::vector<StreamSink*> alarm_sinks_;
+    uint64_t alarms_ = 0;
+
+    std::atomic<uint64_t> encodes_{0};
+};
+
+} // namespace hnvue::ipc
+
+#endif // HNVE_IPC_STATUS_STREAM_HUB_H
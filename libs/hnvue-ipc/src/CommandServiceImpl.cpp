@@ -5,6 +5,7 @@
  */
 
 #include "hnvue/ipc/CommandServiceImpl.h"
+#include "hnvue/infra/Clock.h"
 
 namespace hnvue::ipc {
 
@@ -67,7 +68,7 @@ grpc::Status CommandServiceImpl::StartExposure(
     response->set_success(true);
     response->set_acquisition_id(acquisition_id);
     response->mutable_error()->set_code(ErrorCode::ERROR_CODE_OK);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     logger_->info("StartExposure succeeded: acquisition_id={}", acquisition_id);
 
@@ -90,7 +91,7 @@ grpc::Status CommandServiceImpl::AbortExposure(
 
     response->set_success(true);
     response->mutable_error()->set_code(ErrorCode::ERROR_CODE_OK);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     logger_->info("AbortExposure succeeded for acquisition_id={}", acquisition_id);
     return grpc::Status::OK;
@@ -122,7 +123,7 @@ grpc::Status CommandServiceImpl::SetCollimator(
     response->mutable_actual_position()->CopyFrom(requested);
     response->set_success(true);
     response->mutable_error()->set_code(ErrorCode::ERROR_CODE_OK);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     logger_->info("SetCollimator succeeded: L={}/R={}/T={}/B={}",
                   requested.left_mm(), requested.right_mm(),
@@ -151,7 +152,7 @@ grpc::Status CommandServiceImpl::RunCalibration(
 
     response->set_success(true);
     response->mutable_error()->set_code(ErrorCode::ERROR_CODE_OK);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     logger_->info("RunCalibration succeeded");
     return grpc::Status::OK;
@@ -165,7 +166,7 @@ grpc::Status CommandServiceImpl::GetSystemState(
     // Return current state
     SystemState state = GetSystemState();
     response->set_state(state);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     logger_->debug("GetSystemState returned: {}", static_cast<int>(state));
     return grpc::Status::OK;
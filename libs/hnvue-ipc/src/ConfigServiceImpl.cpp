@@ -5,6 +5,7 @@
  */
 
 #include "hnvue/ipc/ConfigServiceImpl.h"
+#include "hnvue/infra/Clock.h"
 #include <thread>
 #include <chrono>
 
@@ -49,7 +50,7 @@ grpc::Status ConfigServiceImpl::GetConfiguration(
     }
 
     response->mutable_error()->set_code(ErrorCode::ERROR_CODE_OK);
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     return grpc::Status::OK;
 }
@@ -109,7 +110,7 @@ grpc::Status ConfigServiceImpl::SetConfiguration(
         response->mutable_error()->set_message("Some parameters failed validation");
     }
 
-    response->mutable_response_timestamp()->set_microseconds_since_start(0);
+    response->mutable_response_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 
     return grpc::Status::OK;
 }
@@ -5,6 +5,7 @@
  */
 
 #include "hnvue/ipc/HealthServiceImpl.h"
+#include "hnvue/infra/Clock.h"
 #include <thread>
 #include <chrono>
 #include <unordered_map>
@@ -130,7 +131,7 @@ void HealthServiceImpl::CreateHeartbeatEvent(HealthEvent* event) const {
     payload->set_cpu_usage_percent(GetCpuUsage());
     payload->set_memory_usage_mb(GetMemoryUsage());
 
-    event->mutable_event_timestamp()->set_microseconds_since_start(0);
+    event->mutable_event_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 }
 
 void HealthServiceImpl::CreateHardwareStatusEvent(
@@ -145,7 +146,7 @@ void HealthServiceImpl::CreateHardwareStatusEvent(
     payload->set_status(component.current_status);
     payload->set_detail(component.detail);
 
-    event->mutable_event_timestamp()->set_microseconds_since_start(0);
+    event->mutable_event_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 }
 
 void HealthServiceImpl::CreateFaultEvent(
@@ -163,7 +164,7 @@ void HealthServiceImpl::CreateFaultEvent(
     payload->set_severity(severity);
     payload->set_requires_operator_action(requires_action);
 
-    event->mutable_event_timestamp()->set_microseconds_since_start(0);
+    event->mutable_event_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 }
 
 void HealthServiceImpl::CreateStateChangeEvent(
@@ -179,7 +180,7 @@ void HealthServiceImpl::CreateStateChangeEvent(
     payload->set_new_state(new_state);
     payload->set_reason(reason);
 
-    event->mutable_event_timestamp()->set_microseconds_since_start(0);
+    event->mutable_event_timestamp()->set_microseconds_since_start(infra::SinceStartUs());
 }
 
 bool HealthServiceImpl::PassesFilter(
@@ -0,0 +1,147 @@
+/**
+ * @file HvgStatusServiceImpl.cpp
+ * @brief HvgControl StreamStatus / StreamAlarms server (Core Engine -> GUI)
+ * SPEC-IPC-001: Generator status streaming (hvg_control.proto)
+ */
+
+#include "hnvue/ipc/HvgStatusServiceImpl.h"
+
+#include <mutex>
+
+namespace hnvue::ipc {
+
+namespace {
+
+/**
+ * @brief One streaming client, fed by the hub
+ *
+ * Lock order: hub lock, then mutex_ (Push is called under the hub lock),
+ * so Stop detaches from the hub before taking mutex_.
+ */
+class HubStreamReactor final : public grpc::ServerWriteReactor<grpc::ByteBuffer>,
+                               public StreamSink {
+public:
+    enum class Kind { STATUS, ALARMS };
+
+    HubStreamReactor(StatusStreamHub& hub, Kind kind, size_t alarm_queue_depth,
+                     std::shared_ptr<spdlog::logger> logger)
+        : hub_(hub)
+        , kind_(kind)
+        , logger_(std::move(logger))
+        , mailbox_(kind == Kind::STATUS ? StreamMailbox::Mode::LATEST : StreamMailbox::Mode::QUEUE,
+                   alarm_queue_depth) {
+        if (kind_ == Kind::STATUS) {
+            hub_.AddStatusSink(this);
+        } else {
+            hub_.AddAlarmSink(this);
+        }
+    }
+
+    void Push(const grpc::ByteBuffer& message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (mailbox_.Offer(message, &current_)) {
+            StartWrite(&current_);
+        }
+    }
+
+    void OnWriteDone(bool ok) override {
+        if (!ok) {
+            Stop(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Stream write failed"));
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (mailbox_.Next(&current_)) {
+            StartWrite(&current_);
+        }
+    }
+
+    void OnCancel() override {
+        Stop(grpc::Status::CANCELLED);
+    }
+
+    void OnDone() override {
+        Detach();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (mailbox_.Coalesced() > 0 || mailbox_.Dropped() > 0) {
+                logger_->debug("{} stream closed: coalesced={}, dropped={}",
+                               kind_ == Kind::STATUS ? "StreamStatus" : "StreamAlarms",
+                               mailbox_.Coalesced(), mailbox_.Dropped());
+            }
+        }
+        delete this;
+    }
+
+private:
+    void Detach() {
+        if (kind_ == Kind::STATUS) {
+            hub_.RemoveStatusSink(this);
+        } else {
+            hub_.RemoveAlarmSink(this);
+        }
+    }
+
+    void Stop(const grpc::Status& status) {
+        Detach();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        mailbox_.Close();
+        Finish(status);
+    }
+
+    StatusStreamHub& hub_;
+    Kind kind_;
+    std::shared_ptr<spdlog::logger> logger_;
+
+    std::mutex mutex_;
+    StreamMailbox mailbox_;
+    grpc::ByteBuffer current_;   // Message of the outstanding write
+    bool finished_ = false;
+};
+
+} // anonymous namespace
+
+HvgStatusServiceImpl::HvgStatusServiceImpl(
+    std::shared_ptr<spdlog::logger> logger,
+    const StatusStreamConfig& config)
+    : logger_(logger)
+    , hub_(config)
+    , config_(config) {
+    logger_->info("HvgStatusServiceImpl initialized (kvp_deadband: {}, ma_deadband: {}, keepalive: {}ms)",
+                  config.kvp_deadband, config.ma_deadband, config.idle_keepalive_ms);
+}
+
+grpc::ServerWriteReactor<grpc::ByteBuffer>* HvgStatusServiceImpl::StreamStatus(
+    grpc::CallbackServerContext* /*context*/,
+    const grpc::ByteBuffer* /*request*/) {
+    logger_->info("StreamStatus: subscriber connected");
+    return new HubStreamReactor(hub_, HubStreamReactor::Kind::STATUS,
+                                config_.alarm_queue_depth, logger_);
+}
+
+grpc::ServerWriteReactor<grpc::ByteBuffer>* HvgStatusServiceImpl::StreamAlarms(
+    grpc::CallbackServerContext* /*context*/,
+    const grpc::ByteBuffer* /*request*/) {
+    logger_->info("StreamAlarms: subscriber connected");
+    return new HubStreamReactor(hub_, HubStreamReactor::Kind::ALARMS,
+                                config_.alarm_queue_depth, logger_);
+}
+
+bool HvgStatusServiceImpl::PublishStatus(const HvgStatus& status) {
+    return hub_.PublishStatus(status);
+}
+
+void HvgStatusServiceImpl::PublishAlarm(const HvgAlarm& alarm) {
+    logger_->warn("HVG alarm: code={}, severity={}", alarm.alarm_code(),
+                  static_cast<int>(alarm.severity()));
+    hub_.PublishAlarm(alarm);
+}
+
+StatusStreamStats HvgStatusServiceImpl::GetStats() const {
+    return hub_.GetStats();
+}
+
+} // namespace hnvue::ipc
@@ -5,6 +5,7 @@
  */
 
 #include "hnvue/ipc/ImageServiceImpl.h"
+#include "hnvue/infra/Clock.h"
 
 namespace hnvue::ipc {
 
@@ -168,7 +169,7 @@ void ImageServiceImpl::CreateMetadataChunk(
     metadata->set_bits_per_pixel(buffer.bits_per_pixel);
     metadata->set_pixel_pitch_mm(buffer.pixel_pitch_mm);
     metadata->set_transfer_mode(buffer.transfer_mode);
-    metadata->mutable_acquisition_timestamp()->set_microseconds_since_start(0);
+    metadata->mutable_acquisition_timestamp()->set_microseconds_since_start(buffer.timestamp_us);
     metadata->set_kv_actual(buffer.kv_actual);
     metadata->set_mas_actual(buffer.mas_actual);
     metadata->set_detector_id(buffer.detector_id);
@@ -9,6 +9,7 @@
 #include "hnvue/ipc/ImageServiceImpl.h"
 #include "hnvue/ipc/HealthServiceImpl.h"
 #include "hnvue/ipc/ConfigServiceImpl.h"
+#include "hnvue/ipc/HvgStatusServiceImpl.h"
 
 namespace hnvue::ipc {
 
@@ -27,6 +28,7 @@ IpcServer::IpcServer(
     , image_service_(nullptr)
     , health_service_(nullptr)
     , config_service_(nullptr)
+    , hvg_status_service_(nullptr)
     , is_running_(false) {
 }
 
@@ -112,20 +114,26 @@ std::string IpcServer::GetInterfaceVersion() const {
            std::to_string(IPC_INTERFACE_VERSION_PATCH);
 }
 
+HvgStatusServiceImpl* IpcServer::GetHvgStatusService() const {
+    return hvg_status_service_.get();
+}
+
 void IpcServer::RegisterServices(grpc::ServerBuilder& builder) {
     // Create service instances
     command_service_ = std::make_unique<CommandServiceImpl>(logger_);
     image_service_ = std::make_unique<ImageServiceImpl>(logger_);
     health_service_ = std::make_unique<HealthServiceImpl>(logger_);
     config_service_ = std::make_unique<ConfigServiceImpl>(logger_);
+    hvg_status_service_ = std::make_unique<HvgStatusServiceImpl>(logger_);
 
     // Register with server
     builder.RegisterService(command_service_.get());
     builder.RegisterService(image_service_.get());
     builder.RegisterService(health_service_.get());
     builder.RegisterService(config_service_.get());
+    builder.RegisterService(hvg_status_service_.get());
 
-    logger_->debug("Registered 4 services: Command, Image, Health, Config");
+    logger_->debug("Registered 5 services: Command, Image, Health, Config, HvgControl");
 }
 
 void IpcServer::LogStartupInfo() {
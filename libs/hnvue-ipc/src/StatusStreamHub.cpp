@@ -0,0 +1,179 @@
+/**
+ * @file StatusStreamHub.cpp
+ * @brief Fan-out of generator status and alarms to streaming subscribers
+ * SPEC-IPC-001: HvgControl StreamStatus / StreamAlarms delivery
+ */
+
+#include "hnvue/ipc/StatusStreamHub.h"
+
+#include <grpcpp/impl/codegen/proto_utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace hnvue::ipc {
+
+// =============================================================================
+// StreamMailbox
+// =============================================================================
+
+StreamMailbox::StreamMailbox(Mode mode, size_t queue_depth)
+    : mode_(mode)
+    , queue_depth_(std::max<size_t>(queue_depth, 1)) {
+}
+
+bool StreamMailbox::Offer(const grpc::ByteBuffer& message, grpc::ByteBuffer* start) {
+    if (closed_) {
+        return false;
+    }
+    if (!writing_) {
+        writing_ = true;
+        *start = message;
+        return true;
+    }
+
+    if (mode_ == Mode::LATEST) {
+        if (!pending_.empty()) {
+            pending_.clear();
+            ++coalesced_;
+        }
+    } else if (pending_.size() >= queue_depth_) {
+        pending_.pop_front();
+        ++dropped_;
+    }
+    pending_.push_back(message);
+    return false;
+}
+
+bool StreamMailbox::Next(grpc::ByteBuffer* out) {
+    if (closed_ || pending_.empty()) {
+        writing_ = false;
+        return false;
+    }
+    *out = std::move(pending_.front());
+    pending_.pop_front();
+    return true;
+}
+
+void StreamMailbox::Close() {
+    closed_ = true;
+    pending_.clear();
+}
+
+// =============================================================================
+// StatusStreamHub
+// =============================================================================
+
+StatusStreamHub::StatusStreamHub(const StatusStreamConfig& config)
+    : config_(config) {
+}
+
+bool StatusStreamHub::Encode(const google::protobuf::MessageLite& message, grpc::ByteBuffer* out) {
+    bool own_buffer = false;
+    return grpc::SerializationTraits<google::protobuf::MessageLite>::Serialize(
+        message, out, &own_buffer).ok();
+}
+
+bool StatusStreamHub::ShouldForward(const HvgStatus& status) const {
+    if (!last_forwarded_) {
+        return true;
+    }
+    const HvgStatus& last = *last_forwarded_;
+
+    // Full rate while the tube may be energized
+    if (status.state() == GeneratorState::GEN_ARMED ||
+        status.state() == GeneratorState::GEN_EXPOSING) {
+        return true;
+    }
+    if (status.state() != last.state() || status.interlock_ok() != last.interlock_ok()) {
+        return true;
+    }
+    if (std::fabs(status.actual_kvp() - last.actual_kvp()) > config_.kvp_deadband ||
+        std::fabs(status.actual_ma() - last.actual_ma()) > config_.ma_deadband) {
+        return true;
+    }
+    return status.timestamp_us() - last.timestamp_us() >=
+           static_cast<int64_t>(config_.idle_keepalive_ms) * 1000;
+}
+
+bool StatusStreamHub::PublishStatus(const HvgStatus& status) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    ++published_;
+    if (!ShouldForward(status)) {
+        ++suppressed_;
+        return false;
+    }
+
+    grpc::ByteBuffer encoded;
+    if (!Encode(status, &encoded)) {
+        return false;
+    }
+    encodes_.fetch_add(1, std::memory_order_relaxed);
+    last_forwarded_ = status;
+    last_encoded_ = encoded;
+    ++forwarded_;
+
+    for (StreamSink* sink : status_sinks_) {
+        sink->Push(encoded);
+    }
+    return true;
+}
+
+void StatusStreamHub::PublishAlarm(const HvgAlarm& alarm) {
+    grpc::ByteBuffer encoded;
+    if (!Encode(alarm, &encoded)) {
+        return;
+    }
+    encodes_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(alarm_mutex_);
+    ++alarms_;
+    for (StreamSink* sink : alarm_sinks_) {
+        sink->Push(encoded);
+    }
+}
+
+void StatusStreamHub::AddStatusSink(StreamSink* sink) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    status_sinks_.push_back(sink);
+    if (last_forwarded_) {
+        sink->Push(last_encoded_);
+    }
+}
+
+void StatusStreamHub::RemoveStatusSink(StreamSink* sink) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    status_sinks_.erase(std::remove(status_sinks_.begin(), status_sinks_.end(), sink),
+                        status_sinks_.end());
+}
+
+void StatusStreamHub::AddAlarmSink(StreamSink* sink) {
+    std::lock_guard<std::mutex> lock(alarm_mutex_);
+    alarm_sinks_.push_back(sink);
+}
+
+void StatusStreamHub::RemoveAlarmSink(StreamSink* sink) {
+    std::lock_guard<std::mutex> lock(alarm_mutex_);
+    alarm_sinks_.erase(std::remove(alarm_sinks_.begin(), alarm_sinks_.end(), sink),
+                       alarm_sinks_.end());
+}
+
+StatusStreamStats StatusStreamHub::GetStats() const {
+    StatusStreamStats stats;
+    {
+        std::lock_guard<std::mutex> lock(status_mutex_);
+        stats.published = published_;
+        stats.forwarded = forwarded_;
+        stats.suppressed = suppressed_;
+        stats.status_subscribers = status_sinks_.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(alarm_mutex_);
+        stats.alarms = alarms_;
+        stats.alarm_subscribers = alarm_sinks_.size();
+    }
+    stats.encodes = encodes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace hnvue::ipc
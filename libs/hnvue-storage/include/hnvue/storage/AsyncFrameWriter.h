@@ -0,0 +1,141 @@
+/**
+ * @file AsyncFrameWriter.h
+ * @brief Asynchronous writer for raw frames and processed images
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ *
+ * The acquisition path hands a frame (pooled buffer, no copy) to Enqueue(),
+ * which only appends to a bounded queue and returns. Writer threads move the
+ * data to disk:
+ *   - io_uring backend: one thread copies chunks into registered, page-aligned
+ *     staging buffers and submits O_DIRECT WRITE_FIXED operations in batches.
+ *   - thread-pool backend: worker threads perform blocking buffered writes.
+ */
+
+#ifndef HNUE_STORAGE_ASYNC_FRAME_WRITER_H
+#define HNUE_STORAGE_ASYNC_FRAME_WRITER_H
+
+#include "hnvue/storage/StorageTypes.h"
+#include "hnvue/infra/FramePool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hnvue::storage {
+
+namespace internal {
+class WriteQueue;
+class IWriteBackend;
+struct StorageCounters;
+} // namespace internal
+
+/**
+ * @brief Bounded asynchronous file writer
+ *
+ * Each Enqueue() call writes one complete file. Files are created or
+ * truncated; parent directories must exist.
+ *
+ * Thread Safety: Enqueue, Flush and GetStats may be called from any thread.
+ * Start and Stop must not race with each other.
+ */
+class AsyncFrameWriter {
+public:
+    /**
+     * @brief Construct a stopped writer
+     * @param config Backend selection and queue sizing
+     */
+    explicit AsyncFrameWriter(const StorageConfig& config = StorageConfig{});
+
+    /**
+     * @brief Destructor; stops the writer, completing queued jobs
+     */
+    ~AsyncFrameWriter();
+
+    AsyncFrameWriter(const AsyncFrameWriter&) = delete;
+    AsyncFrameWriter& operator=(const AsyncFrameWriter&) = delete;
+
+    /**
+     * @brief Create the backend and start writer threads
+     * @return STORAGE_OK, or STORAGE_ERR_NOT_SUPPORTED if io_uring was
+     *         requested explicitly and is unavailable
+     *
+     * With STORAGE_BACKEND_AUTO an io_uring setup failure falls back to the
+     * thread-pool backend.
+     */
+    StorageResult Start();
+
+    /**
+     * @brief Stop accepting jobs, write everything queued, join threads
+     */
+    void Stop();
+
+    /**
+     * @brief Check if the writer accepts jobs
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief Queue a pooled buffer for writing
+     * @param path Destination file
+     * @param data Buffer holding the payload; the writer keeps a reference
+     *             until the write completes
+     * @param callback Optional completion callback
+     * @return STORAGE_OK if queued; STORAGE_ERR_QUEUE_FULL if the queue is at
+     *         capacity (never blocks); STORAGE_ERR_PARAM; STORAGE_ERR_NOT_RUNNING
+     *
+     * Writes data.Size() bytes.
+     */
+    StorageResult Enqueue(const std::string& path, infra::FrameHandle data,
+                          WriteCallback callback = nullptr);
+
+    /**
+     * @brief Queue a pooled vector for writing
+     * @param path Destination file
+     * @param data Payload; moved into the job (e.g. RawFrame::pixel_data)
+     * @param callback Optional completion callback
+     * @return As Enqueue(const std::string&, infra::FrameHandle, WriteCallback)
+     */
+    StorageResult Enqueue(const std::string& path, infra::PooledVector<uint8_t>&& data,
+                          WriteCallback callback = nullptr);
+
+    /**
+     * @brief Wait until every accepted job has completed
+     * @param timeout Maximum wait
+     * @return true if idle, false on timeout
+     */
+    bool Flush(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Snapshot of throughput, queue depth and latency counters
+     */
+    StorageStats GetStats() const;
+
+    /**
+     * @brief Backend in use (AUTO before Start)
+     */
+    StorageBackend GetActiveBackend() const;
+
+    /**
+     * @brief Check whether the kernel supports io_uring
+     */
+    static bool IsIoUringSupported();
+
+private:
+    StorageConfig config_;
+    std::unique_ptr<internal::StorageCounters> counters_;
+    std::unique_ptr<internal::WriteQueue> queue_;
+    std::unique_ptr<internal::IWriteBackend> backend_;
+    mutable std::mutex lifecycle_mutex_;
+    StorageBackend active_backend_ = StorageBackend::STORAGE_BACKEND_AUTO;
+    int64_t start_us_ = 0;
+};
+
+} // namespace hnvue::storage
+
+#endif // HNUE_STORAGE_ASYNC_FRAME_WRITER_H
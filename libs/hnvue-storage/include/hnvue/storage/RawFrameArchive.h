@@ -0,0 +1,217 @@
+/**
+ * @file RawFrameArchive.h
+ * @brief Compressed raw-frame archive with random access
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: raw frame archive
+ * SPDX-License-Identifier: MIT
+ *
+ * Keeps raw 16-bit detector frames for re-processing, calibration audits and
+ * engine regression runs. File layout (all fields little-endian):
+ *
+ *   FileHeader (32 B)
+ *   FrameRecord 0 .. N-1:
+ *       RecordHeader (72 B: dimensions, metadata, checksum)
+ *       strip size table (uint32 per strip)
+ *       strip payloads (lossless, independently decodable)
+ *   Index: IndexEntry per frame (offset, size, metadata)
+ *   Trailer (32 B: index offset, frame count)
+ *
+ * The reader maps the file and locates frame i through the index in O(1);
+ * only the requested frame is decompressed. Archives whose writer did not
+ * close (no trailer) are recovered by scanning the self-describing records.
+ */
+
+#ifndef HNUE_STORAGE_RAW_FRAME_ARCHIVE_H
+#define HNUE_STORAGE_RAW_FRAME_ARCHIVE_H
+
+#include "hnvue/storage/StorageTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace hnvue::storage {
+
+// =============================================================================
+// Types
+// =============================================================================
+
+/**
+ * @brief Per-frame metadata stored in the record header and the index
+ */
+struct RawFrameMetadata {
+    uint64_t acquisition_id = 0;
+    float kv = 0.0f;                ///< Actual tube voltage (kVp)
+    float mas = 0.0f;               ///< Actual tube current-time product (mAs)
+    uint32_t detector_id = 0;
+    int64_t timestamp_us = 0;       ///< Microseconds since process epoch
+    uint32_t width = 0;             ///< Pixels per row
+    uint32_t height = 0;            ///< Rows
+};
+
+/**
+ * @brief Archive codec settings
+ */
+struct ArchiveConfig {
+    uint32_t strip_rows = 64;       ///< Rows per independently coded strip
+    uint32_t threads = 0;           ///< Codec threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Per-frame size information
+ */
+struct ArchiveFrameInfo {
+    RawFrameMetadata metadata;
+    uint64_t offset = 0;            ///< Record offset in the file
+    uint64_t record_bytes = 0;      ///< Record size including header
+    uint64_t raw_bytes = 0;         ///< Uncompressed pixel bytes
+};
+
+// =============================================================================
+// RawFrameArchiveWriter
+// =============================================================================
+
+/**
+ * @brief Appends compressed frames to a new archive
+ *
+ * Thread Safety: Not thread-safe; use from one thread (e.g. a storage
+ * thread fed by the acquisition pipeline).
+ */
+class RawFrameArchiveWriter {
+public:
+    explicit RawFrameArchiveWriter(const ArchiveConfig& config = ArchiveConfig{});
+
+    /**
+     * @brief Destructor; closes the archive (writes the index)
+     */
+    ~RawFrameArchiveWriter();
+
+    RawFrameArchiveWriter(const RawFrameArchiveWriter&) = delete;
+    RawFrameArchiveWriter& operator=(const RawFrameArchiveWriter&) = delete;
+
+    /**
+     * @brief Create (or truncate) an archive file
+     * @return STORAGE_OK or STORAGE_ERR_IO
+     */
+    StorageResult Open(const std::string& path);
+
+    /**
+     * @brief Compress and append one frame
+     * @param pixels First pixel
+     * @param stride_px Row pitch in pixels (>= metadata.width)
+     * @param metadata Frame metadata; width and height must be non-zero
+     * @return STORAGE_OK, STORAGE_ERR_PARAM, STORAGE_ERR_NOT_RUNNING (not open)
+     *         or STORAGE_ERR_IO
+     */
+    StorageResult AppendFrame(const uint16_t* pixels, size_t stride_px,
+                              const RawFrameMetadata& metadata);
+
+    /**
+     * @brief Write the index and trailer and close the file
+     * @return STORAGE_OK or STORAGE_ERR_IO
+     */
+    StorageResult Close();
+
+    bool IsOpen() const { return file_ != nullptr; }
+
+    /// Frames appended since Open
+    size_t FrameCount() const { return index_.size(); }
+
+    /// Uncompressed pixel bytes appended since Open
+    uint64_t RawBytes() const { return raw_bytes_; }
+
+    /// File bytes written since Open (headers included)
+    uint64_t FileBytes() const { return offset_; }
+
+private:
+    bool WriteBytes(const void* data, size_t size);
+
+    ArchiveConfig config_;
+    std::FILE* file_ = nullptr;
+    uint64_t offset_ = 0;
+    uint64_t raw_bytes_ = 0;
+    std::vector<ArchiveFrameInfo> index_;
+};
+
+// =============================================================================
+// RawFrameArchiveReader
+// =============================================================================
+
+/**
+ * @brief Memory-mapped random-access archive reader
+ *
+ * Thread Safety: After Open, GetFrameInfo and ReadFrame may be called
+ * concurrently from multiple threads.
+ */
+class RawFrameArchiveReader {
+public:
+    explicit RawFrameArchiveReader(const ArchiveConfig& config = ArchiveConfig{});
+    ~RawFrameArchiveReader();
+
+    RawFrameArchiveReader(const RawFrameArchiveReader&) = delete;
+    RawFrameArchiveReader& operator=(const RawFrameArchiveReader&) = delete;
+
+    /**
+     * @brief Map an archive and load its index
+     * @return STORAGE_OK, STORAGE_ERR_IO or STORAGE_ERR_FORMAT
+     *
+     * A missing or damaged index is rebuilt by scanning the records;
+     * IsRecovered() then returns true.
+     */
+    StorageResult Open(const std::string& path);
+
+    /**
+     * @brief Unmap the archive
+     */
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+
+    /// true if the index was rebuilt by scanning (writer did not close)
+    bool IsRecovered() const { return recovered_; }
+
+    size_t FrameCount() const { return index_.size(); }
+
+    /**
+     * @brief Get metadata and sizes of a frame without decompressing it
+     * @return STORAGE_OK or STORAGE_ERR_RANGE
+     */
+    StorageResult GetFrameInfo(size_t index, ArchiveFrameInfo& info) const;
+
+    /**
+     * @brief Decompress one frame
+     * @param index Frame index
+     * @param[out] pixels Destination (height rows of stride_px pixels)
+     * @param stride_px Destination row pitch in pixels (>= width)
+     * @return STORAGE_OK, STORAGE_ERR_RANGE, STORAGE_ERR_PARAM or
+     *         STORAGE_ERR_FORMAT (corrupt payload or checksum mismatch)
+     */
+    StorageResult ReadFrame(size_t index, uint16_t* pixels, size_t stride_px) const;
+
+    /**
+     * @brief Decompress one frame into a tightly packed vector
+     * @param index Frame index
+     * @param[out] pixels Resized to width * height
+     */
+    StorageResult ReadFrame(size_t index, std::vector<uint16_t>& pixels) const;
+
+private:
+    bool LoadIndex();
+    bool ScanRecords();
+
+    ArchiveConfig config_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> fallback_buffer_;   ///< Used where mmap is unavailable
+    bool mapped_ = false;
+    bool recovered_ = false;
+    std::vector<ArchiveFrameInfo> index_;
+};
+
+} // namespace hnvue::storage
+
+#endif // HNUE_STORAGE_RAW_FRAME_ARCHIVE_H
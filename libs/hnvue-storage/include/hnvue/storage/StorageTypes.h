@@ -0,0 +1,119 @@
+/**
+ * @file StorageTypes.h
+ * @brief Common types for the asynchronous frame storage subsystem
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_STORAGE_STORAGE_TYPES_H
+#define HNUE_STORAGE_STORAGE_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace hnvue::storage {
+
+// =============================================================================
+// Enumerations
+// =============================================================================
+
+/**
+ * @brief Result codes for storage operations
+ */
+enum class StorageResult : int32_t {
+    STORAGE_OK = 0,
+    STORAGE_ERR_NOT_RUNNING = 1,    ///< Writer not started or already stopped
+    STORAGE_ERR_QUEUE_FULL = 2,     ///< Submission queue at capacity; job rejected
+    STORAGE_ERR_PARAM = 3,          ///< Empty path or empty payload
+    STORAGE_ERR_IO = 4,             ///< open/write/sync failed
+    STORAGE_ERR_NOT_SUPPORTED = 5,  ///< Requested backend unavailable on this system
+    STORAGE_ERR_FORMAT = 6,         ///< Archive malformed or checksum mismatch
+    STORAGE_ERR_RANGE = 7           ///< Frame index out of range
+};
+
+/**
+ * @brief Write backend selection
+ */
+enum class StorageBackend : int32_t {
+    STORAGE_BACKEND_AUTO = 0,        ///< io_uring if available, else thread pool
+    STORAGE_BACKEND_IO_URING = 1,    ///< Linux io_uring with registered buffers
+    STORAGE_BACKEND_THREAD_POOL = 2  ///< Blocking writes on worker threads
+};
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Thread role name for storage writer threads (infra::ThreadPolicyRegistry)
+constexpr const char* kThreadStorageWriter = "storage.writer";
+
+/**
+ * @brief AsyncFrameWriter construction parameters
+ *
+ * Staging buffers are only used by the io_uring backend. Their total size
+ * (staging_buffer_bytes * staging_buffer_count) bounds the write data in
+ * flight; one 9 MP 16-bit frame is ~18 MB.
+ */
+struct StorageConfig {
+    StorageBackend backend = StorageBackend::STORAGE_BACKEND_AUTO;
+    size_t queue_capacity = 64;               ///< Pending write jobs before rejection
+    uint32_t ring_entries = 64;               ///< io_uring submission queue size
+    size_t staging_buffer_bytes = 2u << 20;   ///< Registered buffer size (multiple of 4096)
+    uint32_t staging_buffer_count = 16;       ///< Registered buffers
+    uint32_t max_active_jobs = 8;             ///< Files written concurrently (io_uring)
+    bool use_direct_io = true;                ///< O_DIRECT (io_uring; falls back per file)
+    bool sync_on_close = false;               ///< fdatasync before reporting completion
+    uint32_t worker_threads = 2;              ///< Thread-pool backend workers
+};
+
+// =============================================================================
+// Results and Statistics
+// =============================================================================
+
+/**
+ * @brief Completion report for one write job
+ */
+struct WriteResult {
+    StorageResult result = StorageResult::STORAGE_OK;
+    std::string path;
+    uint64_t bytes_written = 0;
+    int64_t latency_us = 0;       ///< Enqueue to completion (infra::MonotonicClock)
+    bool direct_io = false;       ///< true if the file was written with O_DIRECT
+};
+
+/**
+ * @brief Completion callback; invoked on a storage writer thread
+ *
+ * Must not block: it runs on the thread that drives the write queue.
+ */
+using WriteCallback = std::function<void(const WriteResult&)>;
+
+/**
+ * @brief Storage writer counters
+ */
+struct StorageStats {
+    StorageBackend active_backend = StorageBackend::STORAGE_BACKEND_AUTO;
+    uint64_t jobs_enqueued = 0;        ///< Jobs accepted by Enqueue
+    uint64_t jobs_completed = 0;       ///< Jobs finished successfully
+    uint64_t jobs_failed = 0;          ///< Jobs finished with an error
+    uint64_t jobs_rejected = 0;        ///< Enqueue calls refused (queue full)
+    uint64_t bytes_written = 0;        ///< Payload bytes of completed jobs
+    size_t queue_depth = 0;            ///< Jobs waiting for a writer
+    size_t queue_high_water = 0;       ///< Maximum queue_depth since Start
+    size_t inflight_ios = 0;           ///< Write operations submitted, not completed
+    size_t inflight_high_water = 0;    ///< Maximum inflight_ios since Start
+    uint64_t submit_calls = 0;         ///< io_uring_enter / write system calls
+    uint64_t ios_submitted = 0;        ///< Write operations submitted
+    int64_t avg_latency_us = 0;        ///< Mean enqueue-to-completion latency
+    int64_t max_latency_us = 0;        ///< Maximum enqueue-to-completion latency
+    double throughput_mb_s = 0.0;      ///< bytes_written / time since Start
+};
+
+} // namespace hnvue::storage
+
+#endif // HNUE_STORAGE_STORAGE_TYPES_H
@@ -0,0 +1,157 @@
+/**
+ * @file AsyncFrameWriter.cpp
+ * @brief Asynchronous writer for raw frames and processed images
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/storage/AsyncFrameWriter.h"
+
+#include "IoUringWriteBackend.h"
+#include "ThreadPoolWriteBackend.h"
+#include "WriteQueue.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <utility>
+
+namespace hnvue::storage {
+
+AsyncFrameWriter::AsyncFrameWriter(const StorageConfig& config)
+    : config_(config),
+      counters_(std::make_unique<internal::StorageCounters>()),
+      queue_(std::make_unique<internal::WriteQueue>(config.queue_capacity, *counters_)) {}
+
+AsyncFrameWriter::~AsyncFrameWriter() {
+    Stop();
+}
+
+StorageResult AsyncFrameWriter::Start() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (backend_) {
+        return StorageResult::STORAGE_OK;
+    }
+
+    counters_->Reset();
+    queue_->Open();
+
+    StorageBackend requested = config_.backend;
+    if (requested != StorageBackend::STORAGE_BACKEND_THREAD_POOL) {
+        auto uring = std::make_unique<internal::IoUringWriteBackend>(config_);
+        if (uring->Start(*queue_, *counters_) == StorageResult::STORAGE_OK) {
+            backend_ = std::move(uring);
+        } else if (requested == StorageBackend::STORAGE_BACKEND_IO_URING) {
+            queue_->Close();
+            return StorageResult::STORAGE_ERR_NOT_SUPPORTED;
+        }
+    }
+    if (!backend_) {
+        backend_ = std::make_unique<internal::ThreadPoolWriteBackend>(config_);
+        backend_->Start(*queue_, *counters_);
+    }
+
+    active_backend_ = backend_->Type();
+    start_us_ = infra::SinceStartUs();
+    return StorageResult::STORAGE_OK;
+}
+
+void AsyncFrameWriter::Stop() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (!backend_) {
+        return;
+    }
+    // Writers drain the queue before their threads exit
+    queue_->Close();
+    backend_->Stop();
+    backend_.reset();
+}
+
+bool AsyncFrameWriter::IsRunning() const {
+    return queue_->IsOpen();
+}
+
+StorageResult AsyncFrameWriter::Enqueue(const std::string& path, infra::FrameHandle data,
+                                        WriteCallback callback) {
+    if (path.empty() || !data || data.Size() == 0) {
+        return StorageResult::STORAGE_ERR_PARAM;
+    }
+    internal::WriteJob job;
+    job.path = path;
+    job.data = data.Data();
+    job.length = data.Size();
+    job.handle = std::move(data);
+    job.callback = std::move(callback);
+    job.enqueue_us = infra::SinceStartUs();
+    return queue_->Push(std::move(job));
+}
+
+StorageResult AsyncFrameWriter::Enqueue(const std::string& path,
+                                        infra::PooledVector<uint8_t>&& data,
+                                        WriteCallback callback) {
+    if (path.empty() || data.empty()) {
+        return StorageResult::STORAGE_ERR_PARAM;
+    }
+    internal::WriteJob job;
+    job.path = path;
+    job.vector = std::move(data);
+    job.data = job.vector.data();
+    job.length = job.vector.size();
+    job.callback = std::move(callback);
+    job.enqueue_us = infra::SinceStartUs();
+    return queue_->Push(std::move(job));
+}
+
+bool AsyncFrameWriter::Flush(std::chrono::milliseconds timeout) {
+    return queue_->WaitIdle(timeout);
+}
+
+StorageStats AsyncFrameWriter::GetStats() const {
+    const internal::StorageCounters& c = *counters_;
+    StorageStats stats;
+    stats.active_backend = GetActiveBackend();
+    stats.jobs_enqueued = c.jobs_enqueued.load(std::memory_order_relaxed);
+    stats.jobs_completed = c.jobs_completed.load(std::memory_order_relaxed);
+    stats.jobs_failed = c.jobs_failed.load(std::memory_order_relaxed);
+    stats.jobs_rejected = c.jobs_rejected.load(std::memory_order_relaxed);
+    stats.bytes_written = c.bytes_written.load(std::memory_order_relaxed);
+    stats.queue_depth = queue_->Depth();
+    stats.queue_high_water = c.queue_high_water.load(std::memory_order_relaxed);
+    stats.inflight_ios = c.inflight_ios.load(std::memory_order_relaxed);
+    stats.inflight_high_water = c.inflight_high_water.load(std::memory_order_relaxed);
+    stats.submit_calls = c.submit_calls.load(std::memory_order_relaxed);
+    stats.ios_submitted = c.ios_submitted.load(std::memory_order_relaxed);
+    stats.max_latency_us = c.max_latency_us.load(std::memory_order_relaxed);
+
+    uint64_t finished = stats.jobs_completed + stats.jobs_failed;
+    if (finished > 0) {
+        stats.avg_latency_us = c.total_latency_us.load(std::memory_order_relaxed) /
+                               static_cast<int64_t>(finished);
+    }
+
+    int64_t start_us = 0;
+    {
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+        start_us = start_us_;
+    }
+    int64_t elapsed_us = infra::SinceStartUs() - start_us;
+    if (start_us > 0 && elapsed_us > 0) {
+        // bytes per microsecond == MB/s (10^6)
+        stats.throughput_mb_s = static_cast<double>(stats.bytes_written) /
+                                static_cast<double>(elapsed_us);
+    }
+    return stats;
+}
+
+StorageBackend AsyncFrameWriter::GetActiveBackend() const {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    return active_backend_;
+}
+
+bool AsyncFrameWriter::IsIoUringSupported() {
+    return internal::IoUringWriteBackend::IsSupported();
+}
+
+} // namespace hnvue::storage
@@ -0,0 +1,51 @@
+/**
+ * @file IWriteBackend.h
+ * @brief Internal interface for storage write backends
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_STORAGE_IWRITE_BACKEND_H
+#define HNUE_STORAGE_IWRITE_BACKEND_H
+
+#include "hnvue/storage/StorageTypes.h"
+
+namespace hnvue::storage::internal {
+
+class WriteQueue;
+struct StorageCounters;
+
+/**
+ * @brief Drains a WriteQueue to disk on backend-owned threads
+ *
+ * Start() launches threads that Pop() jobs until the queue is closed and
+ * empty; Stop() joins them. Every popped job is passed to
+ * WriteQueue::Complete().
+ */
+class IWriteBackend {
+public:
+    virtual ~IWriteBackend() = default;
+
+    /**
+     * @brief Allocate resources and launch writer threads
+     * @return STORAGE_OK or STORAGE_ERR_NOT_SUPPORTED / STORAGE_ERR_IO
+     */
+    virtual StorageResult Start(WriteQueue& queue, StorageCounters& counters) = 0;
+
+    /**
+     * @brief Join writer threads (queue must already be closed)
+     */
+    virtual void Stop() = 0;
+
+    /**
+     * @brief Backend identifier
+     */
+    virtual StorageBackend Type() const = 0;
+};
+
+} // namespace hnvue::storage::internal
+
+#endif // HNUE_STORAGE_IWRITE_BACKEND_H
@@ -0,0 +1,541 @@
+/**
+ * @file IoUringWriteBackend.cpp
+ * @brief Linux io_uring storage backend with registered staging buffers
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "IoUringWriteBackend.h"
+#include "WriteQueue.h"
+
+#include "hnvue/infra/ThreadPolicy.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define HNVUE_STORAGE_HAVE_IO_URING 1
+#else
+    #define HNVUE_STORAGE_HAVE_IO_URING 0
+#endif
+
+#if HNVUE_STORAGE_HAVE_IO_URING
+    #include <linux/io_uring.h>
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+
+    #include <algorithm>
+    #include <cerrno>
+    #include <cstring>
+    #include <deque>
+    #include <vector>
+#endif
+
+namespace hnvue::storage::internal {
+
+#if HNVUE_STORAGE_HAVE_IO_URING
+
+namespace {
+
+/// O_DIRECT block alignment for offsets, lengths and buffer addresses
+constexpr size_t kDirectIoAlignment = 4096;
+
+size_t RoundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int SysSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int SysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(
+        syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int SysRegister(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Ring State
+// =============================================================================
+
+struct IoUringWriteBackend::Impl {
+    /// File being written
+    struct ActiveFile {
+        WriteJob job;
+        int fd = -1;
+        bool direct = false;
+        size_t submitted = 0;   ///< Payload bytes handed to staging slots
+        uint64_t written = 0;   ///< Payload bytes confirmed by completions
+        uint32_t inflight = 0;
+        bool failed = false;
+    };
+
+    /// Registered staging buffer
+    struct StagingSlot {
+        uint8_t* base = nullptr;
+        ActiveFile* owner = nullptr;
+        size_t payload = 0;     ///< Payload bytes in this chunk
+        size_t io_length = 0;   ///< Bytes submitted (payload plus padding)
+    };
+
+    int ring_fd = -1;
+
+    void* sq_ring = MAP_FAILED;
+    size_t sq_ring_bytes = 0;
+    void* cq_ring = MAP_FAILED;
+    size_t cq_ring_bytes = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqes_bytes = 0;
+
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_mask = 0;
+    unsigned sq_entries = 0;
+    unsigned sq_local_tail = 0;   ///< Next SQE to fill
+    unsigned sq_published = 0;    ///< SQEs consumed by io_uring_enter
+
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cq_mask = 0;
+
+    void* staging = MAP_FAILED;
+    size_t staging_bytes = 0;
+    size_t slot_bytes = 0;
+    bool fixed_buffers = false;
+    std::vector<StagingSlot> slots;
+    std::vector<uint32_t> free_slots;
+
+    size_t inflight_total = 0;
+
+    ~Impl() { Teardown(); }
+
+    bool Setup(const StorageConfig& config);
+    void Teardown();
+
+    io_uring_sqe* NextSqe();
+    unsigned PendingSubmissions() const;
+    int Enter(unsigned min_complete);
+
+    void Run(WriteQueue& queue, StorageCounters& counters, const StorageConfig& config);
+    bool OpenFile(ActiveFile& file, bool use_direct_io);
+    unsigned PrepareWrites(ActiveFile& file);
+    void ReapCompletions(StorageCounters& counters);
+    void DiscardUnsubmitted(StorageCounters& counters);
+    void FinishFile(ActiveFile& file, WriteQueue& queue, bool sync_on_close);
+};
+
+bool IoUringWriteBackend::Impl::Setup(const StorageConfig& config) {
+    uint32_t slot_count = std::max<uint32_t>(1, config.staging_buffer_count);
+    // Every in-flight operation owns a slot, so the CQ (2x entries) never overflows
+    unsigned entries = std::max<uint32_t>(config.ring_entries, slot_count);
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = SysSetup(entries, &params);
+    if (ring_fd < 0) {
+        return false;
+    }
+
+    sq_ring_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_bytes = cq_ring_bytes = std::max(sq_ring_bytes, cq_ring_bytes);
+    }
+
+    sq_ring = mmap(nullptr, sq_ring_bytes, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        return false;
+    }
+    if (single_mmap) {
+        cq_ring = sq_ring;
+    } else {
+        cq_ring = mmap(nullptr, cq_ring_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            return false;
+        }
+    }
+    sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_bytes, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring_fd,
+                                           IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+
+    auto* sq = static_cast<uint8_t*>(sq_ring);
+    sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sq_entries = params.sq_entries;
+    sq_local_tail = sq_published = *sq_tail;
+
+    auto* cq = static_cast<uint8_t*>(cq_ring);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // Staging buffers: one page-aligned anonymous mapping split into slots
+    slot_bytes = RoundUp(std::max<size_t>(config.staging_buffer_bytes, kDirectIoAlignment),
+                         kDirectIoAlignment);
+    staging_bytes = slot_bytes * slot_count;
+    staging = mmap(nullptr, staging_bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (staging == MAP_FAILED) {
+        return false;
+    }
+
+    std::vector<iovec> iovecs(slot_count);
+    slots.resize(slot_count);
+    free_slots.clear();
+    for (uint32_t i = 0; i < slot_count; ++i) {
+        slots[i].base = static_cast<uint8_t*>(staging) + i * slot_bytes;
+        iovecs[i].iov_base = slots[i].base;
+        iovecs[i].iov_len = slot_bytes;
+        free_slots.push_back(slot_count - 1 - i);
+    }
+
+    // Registration pins the pages; RLIMIT_MEMLOCK may refuse it, in which
+    // case plain IORING_OP_WRITE is used on the same buffers
+    fixed_buffers = SysRegister(ring_fd, IORING_REGISTER_BUFFERS,
+                                iovecs.data(), slot_count) == 0;
+    return true;
+}
+
+void IoUringWriteBackend::Impl::Teardown() {
+    if (staging != MAP_FAILED) {
+        munmap(staging, staging_bytes);
+        staging = MAP_FAILED;
+    }
+    if (sqes != MAP_FAILED) {
+        munmap(sqes, sqes_bytes);
+        sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+    if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+        munmap(cq_ring, cq_ring_bytes);
+    }
+    cq_ring = MAP_FAILED;
+    if (sq_ring != MAP_FAILED) {
+        munmap(sq_ring, sq_ring_bytes);
+        sq_ring = MAP_FAILED;
+    }
+    if (ring_fd >= 0) {
+        close(ring_fd);   // also unregisters buffers
+        ring_fd = -1;
+    }
+    slots.clear();
+    free_slots.clear();
+}
+
+io_uring_sqe* IoUringWriteBackend::Impl::NextSqe() {
+    unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (sq_local_tail - head >= sq_entries) {
+        return nullptr;
+    }
+    unsigned index = sq_local_tail & sq_mask;
+    sq_array[index] = index;
+    ++sq_local_tail;
+    io_uring_sqe* sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+unsigned IoUringWriteBackend::Impl::PendingSubmissions() const {
+    return sq_local_tail - sq_published;
+}
+
+int IoUringWriteBackend::Impl::Enter(unsigned min_complete) {
+    unsigned to_submit = PendingSubmissions();
+    __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+    unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    for (;;) {
+        int ret = SysEnter(ring_fd, to_submit, min_complete, flags);
+        if (ret >= 0) {
+            sq_published += static_cast<unsigned>(ret);
+            return ret;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return -errno;
+        }
+        if (errno == EBUSY) {
+            // CQ backlog: drain completions before submitting more
+            return 0;
+        }
+    }
+}
+
+// =============================================================================
+// Submitter Loop
+// =============================================================================
+
+bool IoUringWriteBackend::Impl::OpenFile(ActiveFile& file, bool use_direct_io) {
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    if (use_direct_io) {
+        file.fd = open(file.job.path.c_str(), flags | O_DIRECT, 0644);
+        if (file.fd >= 0) {
+            file.direct = true;
+        } else if (errno != EINVAL) {
+            return false;
+        }
+    }
+    if (file.fd < 0) {
+        file.fd = open(file.job.path.c_str(), flags, 0644);
+        if (file.fd < 0) {
+            return false;
+        }
+    }
+
+    // Reserve the extent up front; failure only costs fragmentation
+    (void)fallocate(file.fd, FALLOC_FL_KEEP_SIZE, 0,
+                    static_cast<off_t>(RoundUp(file.job.length, kDirectIoAlignment)));
+    return true;
+}
+
+unsigned IoUringWriteBackend::Impl::PrepareWrites(ActiveFile& file) {
+    unsigned prepared = 0;
+    while (!file.failed && file.submitted < file.job.length && !free_slots.empty()) {
+        io_uring_sqe* sqe = NextSqe();
+        if (sqe == nullptr) {
+            break;
+        }
+        uint32_t slot_index = free_slots.back();
+        free_slots.pop_back();
+        StagingSlot& slot = slots[slot_index];
+
+        size_t payload = std::min(slot_bytes, file.job.length - file.submitted);
+        std::memcpy(slot.base, file.job.data + file.submitted, payload);
+        size_t io_length = payload;
+        if (file.direct) {
+            io_length = RoundUp(payload, kDirectIoAlignment);
+            std::memset(slot.base + payload, 0, io_length - payload);
+        }
+        slot.owner = &file;
+        slot.payload = payload;
+        slot.io_length = io_length;
+
+        sqe->opcode = fixed_buffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd = file.fd;
+        sqe->off = file.submitted;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.base);
+        sqe->len = static_cast<uint32_t>(io_length);
+        sqe->buf_index = fixed_buffers ? static_cast<uint16_t>(slot_index) : 0;
+        sqe->user_data = slot_index;
+
+        file.submitted += payload;
+        ++file.inflight;
+        ++prepared;
+    }
+    return prepared;
+}
+
+void IoUringWriteBackend::Impl::ReapCompletions(StorageCounters& counters) {
+    unsigned head = *cq_head;
+    unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    size_t reaped = 0;
+
+    while (head != tail) {
+        const io_uring_cqe& cqe = cqes[head & cq_mask];
+        StagingSlot& slot = slots[static_cast<size_t>(cqe.user_data)];
+        ActiveFile* file = slot.owner;
+
+        // Short writes to regular files only happen on ENOSPC-like
+        // conditions; treat them as failures rather than resubmitting
+        if (cqe.res < 0 || static_cast<size_t>(cqe.res) != slot.io_length) {
+            file->failed = true;
+        } else {
+            file->written += slot.payload;
+        }
+        --file->inflight;
+        slot.owner = nullptr;
+        free_slots.push_back(static_cast<uint32_t>(cqe.user_data));
+        ++head;
+        ++reaped;
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+
+    inflight_total -= reaped;
+    counters.RemoveInflight(reaped);
+}
+
+void IoUringWriteBackend::Impl::DiscardUnsubmitted(StorageCounters& counters) {
+    // Entries past sq_published were never seen by the kernel; release
+    // their slots as failed writes and rewind the tail
+    size_t discarded = 0;
+    for (unsigned i = sq_published; i != sq_local_tail; ++i) {
+        const io_uring_sqe& sqe = sqes[sq_array[i & sq_mask]];
+        StagingSlot& slot = slots[static_cast<size_t>(sqe.user_data)];
+        slot.owner->failed = true;
+        --slot.owner->inflight;
+        slot.owner = nullptr;
+        free_slots.push_back(static_cast<uint32_t>(sqe.user_data));
+        ++discarded;
+    }
+    sq_local_tail = sq_published;
+    __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+
+    inflight_total -= discarded;
+    counters.RemoveInflight(discarded);
+}
+
+void IoUringWriteBackend::Impl::FinishFile(ActiveFile& file, WriteQueue& queue,
+                                           bool sync_on_close) {
+    bool ok = !file.failed;
+    if (ok && file.direct && file.job.length % kDirectIoAlignment != 0) {
+        ok = ftruncate(file.fd, static_cast<off_t>(file.job.length)) == 0;
+    }
+    if (ok && sync_on_close) {
+        ok = fdatasync(file.fd) == 0;
+    }
+    if (close(file.fd) != 0) {
+        ok = false;
+    }
+    file.fd = -1;
+    queue.Complete(file.job, ok ? StorageResult::STORAGE_OK : StorageResult::STORAGE_ERR_IO,
+                   file.written, file.direct);
+}
+
+void IoUringWriteBackend::Impl::Run(WriteQueue& queue, StorageCounters& counters,
+                                    const StorageConfig& config) {
+    infra::ApplyNamedThreadPolicy(kThreadStorageWriter);
+
+    std::deque<std::unique_ptr<ActiveFile>> active;
+    size_t max_active = std::max<uint32_t>(1, config.max_active_jobs);
+    bool drained = false;
+
+    while (!drained || !active.empty()) {
+        // Admit new files; block only when there is nothing else to do
+        while (!drained && active.size() < max_active) {
+            auto file = std::make_unique<ActiveFile>();
+            bool idle = active.empty() && inflight_total == 0;
+            if (idle) {
+                if (!queue.Pop(file->job)) {
+                    drained = true;
+                    break;
+                }
+            } else if (!queue.TryPop(file->job)) {
+                break;
+            }
+            if (!OpenFile(*file, config.use_direct_io)) {
+                queue.Complete(file->job, StorageResult::STORAGE_ERR_IO, 0, false);
+                continue;
+            }
+            active.push_back(std::move(file));
+        }
+
+        // Oldest file first, so its chunks are not interleaved behind newer ones
+        unsigned prepared = 0;
+        for (auto& file : active) {
+            prepared += PrepareWrites(*file);
+        }
+        inflight_total += prepared;
+        counters.AddInflight(prepared);
+
+        if (PendingSubmissions() > 0 || inflight_total > 0) {
+            // Wait for a completion only if nothing more could be queued
+            unsigned min_complete = (prepared == 0 && inflight_total > 0) ? 1 : 0;
+            int ret = Enter(min_complete);
+            counters.submit_calls.fetch_add(1, std::memory_order_relaxed);
+            if (ret < 0) {
+                // Submission refused: fail the affected files; operations
+                // already in the kernel still complete normally
+                DiscardUnsubmitted(counters);
+            }
+        }
+        ReapCompletions(counters);
+
+        for (auto it = active.begin(); it != active.end();) {
+            ActiveFile& file = **it;
+            bool done = file.inflight == 0 &&
+                        (file.failed || file.submitted == file.job.length);
+            if (done) {
+                FinishFile(file, queue, config.sync_on_close);
+                it = active.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// IoUringWriteBackend
+// =============================================================================
+
+IoUringWriteBackend::IoUringWriteBackend(const StorageConfig& config)
+    : config_(config) {}
+
+IoUringWriteBackend::~IoUringWriteBackend() {
+    Stop();
+}
+
+bool IoUringWriteBackend::IsSupported() {
+    static const bool supported = [] {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = SysSetup(2, &params);
+        if (fd < 0) {
+            return false;
+        }
+        close(fd);
+        return true;
+    }();
+    return supported;
+}
+
+StorageResult IoUringWriteBackend::Start(WriteQueue& queue, StorageCounters& counters) {
+    impl_ = std::make_unique<Impl>();
+    if (!impl_->Setup(config_)) {
+        impl_.reset();
+        return StorageResult::STORAGE_ERR_NOT_SUPPORTED;
+    }
+    thread_ = std::thread([this, &queue, &counters] {
+        impl_->Run(queue, counters, config_);
+    });
+    return StorageResult::STORAGE_OK;
+}
+
+void IoUringWriteBackend::Stop() {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    impl_.reset();
+}
+
+#else // !HNVUE_STORAGE_HAVE_IO_URING
+
+struct IoUringWriteBackend::Impl {};
+
+IoUringWriteBackend::IoUringWriteBackend(const StorageConfig& config)
+    : config_(config) {}
+
+IoUringWriteBackend::~IoUringWriteBackend() = default;
+
+bool IoUringWriteBackend::IsSupported() {
+    return false;
+}
+
+StorageResult IoUringWriteBackend::Start(WriteQueue&, StorageCounters&) {
+    return StorageResult::STORAGE_ERR_NOT_SUPPORTED;
+}
+
+void IoUringWriteBackend::Stop() {}
+
+#endif // HNVUE_STORAGE_HAVE_IO_URING
+
+} // namespace hnvue::storage::internal
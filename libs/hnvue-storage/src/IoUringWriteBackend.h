@@ -0,0 +1,60 @@
+/**
+ * @file IoUringWriteBackend.h
+ * @brief Linux io_uring storage backend with registered staging buffers
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_STORAGE_IO_URING_WRITE_BACKEND_H
+#define HNUE_STORAGE_IO_URING_WRITE_BACKEND_H
+
+#include "IWriteBackend.h"
+
+#include <memory>
+#include <thread>
+
+namespace hnvue::storage::internal {
+
+/**
+ * @brief io_uring backend
+ *
+ * A single submitter thread keeps up to max_active_jobs files open. Payloads
+ * are copied in staging_buffer_bytes chunks into page-aligned buffers that
+ * are registered with the ring (IORING_REGISTER_BUFFERS), and written with
+ * IORING_OP_WRITE_FIXED. All chunks prepared in one pass are submitted with
+ * a single io_uring_enter call, which also reaps completions.
+ *
+ * With O_DIRECT the final chunk is zero-padded to the 4 KiB block size and
+ * the file is truncated to the payload length before completion. Files on
+ * filesystems that reject O_DIRECT are written through the page cache.
+ *
+ * The ring is driven with raw system calls (no liburing dependency).
+ */
+class IoUringWriteBackend : public IWriteBackend {
+public:
+    explicit IoUringWriteBackend(const StorageConfig& config);
+    ~IoUringWriteBackend() override;
+
+    /**
+     * @brief Check whether io_uring_setup succeeds on this system
+     */
+    static bool IsSupported();
+
+    StorageResult Start(WriteQueue& queue, StorageCounters& counters) override;
+    void Stop() override;
+    StorageBackend Type() const override { return StorageBackend::STORAGE_BACKEND_IO_URING; }
+
+private:
+    struct Impl;
+
+    StorageConfig config_;
+    std::unique_ptr<Impl> impl_;
+    std::thread thread_;
+};
+
+} // namespace hnvue::storage::internal
+
+#endif // HNUE_STORAGE_IO_URING_WRITE_BACKEND_H
@@ -0,0 +1,528 @@
+/**
+ * @file RawFrameArchive.cpp
+ * @brief Compressed raw-frame archive with random access
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: raw frame archive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hnvue/storage/RawFrameArchive.h"
+
+#include "RawFrameCodec.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace hnvue::storage {
+
+namespace {
+
+// =============================================================================
+// On-Disk Format (little-endian hosts; fields copied with memcpy)
+// =============================================================================
+
+constexpr uint64_t kFileMagic = 0x31305741524E5648ull;     // "HVNRAW01"
+constexpr uint64_t kTrailerMagic = 0x58494157524E5648ull;  // "HVNRWAIX"
+constexpr uint32_t kRecordMagic = 0x52464E48u;             // "HNFR"
+constexpr uint32_t kFormatVersion = 1;
+
+/// Records start on this boundary so header fields are naturally aligned
+constexpr size_t kRecordAlignment = 8;
+
+struct FileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_bytes;
+    int64_t created_unix_us;
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout");
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t header_bytes;
+    uint32_t width;
+    uint32_t height;
+    uint32_t strip_rows;
+    uint32_t strip_count;
+    uint64_t acquisition_id;
+    int64_t timestamp_us;
+    float kv;
+    float mas;
+    uint32_t detector_id;
+    uint32_t reserved;
+    uint64_t payload_bytes;     ///< Strip table plus strip payloads
+    uint64_t checksum;          ///< PixelChecksum of the uncompressed frame
+};
+static_assert(sizeof(RecordHeader) == 72, "RecordHeader layout");
+
+struct IndexEntry {
+    uint64_t offset;
+    uint64_t record_bytes;
+    uint64_t acquisition_id;
+    int64_t timestamp_us;
+    float kv;
+    float mas;
+    uint32_t detector_id;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+};
+static_assert(sizeof(IndexEntry) == 56, "IndexEntry layout");
+
+struct Trailer {
+    uint64_t magic;
+    uint64_t index_offset;
+    uint32_t frame_count;
+    uint32_t entry_bytes;
+    uint64_t reserved;
+};
+static_assert(sizeof(Trailer) == 32, "Trailer layout");
+
+template <typename T>
+T LoadStruct(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// =============================================================================
+// Parallel Strip Processing
+// =============================================================================
+
+uint32_t ResolveThreads(uint32_t configured) {
+    if (configured != 0) {
+        return configured;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+/**
+ * @brief Run fn(0..count-1) on up to `threads` threads (caller included)
+ */
+void ParallelFor(size_t count, uint32_t threads, const std::function<void(size_t)>& fn) {
+    size_t workers = std::min<size_t>(threads, count);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto drain = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) {
+        pool.emplace_back(drain);
+    }
+    drain();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+uint32_t StripRowsFor(uint32_t strip, uint32_t strip_rows, uint32_t height) {
+    uint32_t first = strip * strip_rows;
+    return std::min(strip_rows, height - first);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// RawFrameArchiveWriter
+// =============================================================================
+
+RawFrameArchiveWriter::RawFrameArchiveWriter(const ArchiveConfig& config)
+    : config_(config) {
+    config_.strip_rows = std::max<uint32_t>(1, config_.strip_rows);
+    config_.threads = ResolveThreads(config_.threads);
+}
+
+RawFrameArchiveWriter::~RawFrameArchiveWriter() {
+    Close();
+}
+
+StorageResult RawFrameArchiveWriter::Open(const std::string& path) {
+    Close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    offset_ = 0;
+    raw_bytes_ = 0;
+    index_.clear();
+
+    FileHeader header{};
+    header.magic = kFileMagic;
+    header.version = kFormatVersion;
+    header.header_bytes = sizeof(FileHeader);
+    header.created_unix_us = infra::WallClockNowUs();
+    if (!WriteBytes(&header, sizeof(header))) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    return StorageResult::STORAGE_OK;
+}
+
+bool RawFrameArchiveWriter::WriteBytes(const void* data, size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    if (std::fwrite(data, 1, size, file_) != size) {
+        return false;
+    }
+    offset_ += size;
+    return true;
+}
+
+StorageResult RawFrameArchiveWriter::AppendFrame(const uint16_t* pixels, size_t stride_px,
+                                                 const RawFrameMetadata& metadata) {
+    if (file_ == nullptr) {
+        return StorageResult::STORAGE_ERR_NOT_RUNNING;
+    }
+    if (pixels == nullptr || metadata.width == 0 || metadata.height == 0 ||
+        stride_px < metadata.width) {
+        return StorageResult::STORAGE_ERR_PARAM;
+    }
+
+    const uint32_t width = metadata.width;
+    const uint32_t height = metadata.height;
+    const uint32_t strip_rows = config_.strip_rows;
+    const uint32_t strip_count = (height + strip_rows - 1) / strip_rows;
+
+    std::vector<std::vector<uint8_t>> strips(strip_count);
+    ParallelFor(strip_count, config_.threads, [&](size_t s) {
+        auto strip = static_cast<uint32_t>(s);
+        internal::EncodeStrip(pixels + static_cast<size_t>(strip) * strip_rows * stride_px,
+                              stride_px, width, StripRowsFor(strip, strip_rows, height),
+                              strips[s]);
+    });
+
+    std::vector<uint32_t> strip_sizes(strip_count);
+    uint64_t payload_bytes = strip_count * sizeof(uint32_t);
+    for (uint32_t s = 0; s < strip_count; ++s) {
+        strip_sizes[s] = static_cast<uint32_t>(strips[s].size());
+        payload_bytes += strips[s].size();
+    }
+
+    RecordHeader header{};
+    header.magic = kRecordMagic;
+    header.header_bytes = sizeof(RecordHeader);
+    header.width = width;
+    header.height = height;
+    header.strip_rows = strip_rows;
+    header.strip_count = strip_count;
+    header.acquisition_id = metadata.acquisition_id;
+    header.timestamp_us = metadata.timestamp_us;
+    header.kv = metadata.kv;
+    header.mas = metadata.mas;
+    header.detector_id = metadata.detector_id;
+    header.payload_bytes = payload_bytes;
+    header.checksum = internal::PixelChecksum(pixels, stride_px, width, height);
+
+    ArchiveFrameInfo info;
+    info.metadata = metadata;
+    info.offset = offset_;
+    info.raw_bytes = static_cast<uint64_t>(width) * height * sizeof(uint16_t);
+
+    bool ok = WriteBytes(&header, sizeof(header)) &&
+              WriteBytes(strip_sizes.data(), strip_sizes.size() * sizeof(uint32_t));
+    for (uint32_t s = 0; ok && s < strip_count; ++s) {
+        ok = WriteBytes(strips[s].data(), strips[s].size());
+    }
+    static const uint8_t kPadding[kRecordAlignment] = {};
+    size_t padding = (kRecordAlignment - offset_ % kRecordAlignment) % kRecordAlignment;
+    ok = ok && WriteBytes(kPadding, padding);
+    if (!ok) {
+        return StorageResult::STORAGE_ERR_IO;
+    }
+
+    info.record_bytes = offset_ - info.offset;
+    index_.push_back(info);
+    raw_bytes_ += info.raw_bytes;
+    return StorageResult::STORAGE_OK;
+}
+
+StorageResult RawFrameArchiveWriter::Close() {
+    if (file_ == nullptr) {
+        return StorageResult::STORAGE_OK;
+    }
+
+    Trailer trailer{};
+    trailer.magic = kTrailerMagic;
+    trailer.index_offset = offset_;
+    trailer.frame_count = static_cast<uint32_t>(index_.size());
+    trailer.entry_bytes = sizeof(IndexEntry);
+
+    bool ok = true;
+    for (const ArchiveFrameInfo& info : index_) {
+        IndexEntry entry{};
+        entry.offset = info.offset;
+        entry.record_bytes = info.record_bytes;
+        entry.acquisition_id = info.metadata.acquisition_id;
+        entry.timestamp_us = info.metadata.timestamp_us;
+        entry.kv = info.metadata.kv;
+        entry.mas = info.metadata.mas;
+        entry.detector_id = info.metadata.detector_id;
+        entry.width = info.metadata.width;
+        entry.height = info.metadata.height;
+        ok = ok && WriteBytes(&entry, sizeof(entry));
+    }
+    ok = ok && WriteBytes(&trailer, sizeof(trailer));
+    if (std::fclose(file_) != 0) {
+        ok = false;
+    }
+    file_ = nullptr;
+    return ok ? StorageResult::STORAGE_OK : StorageResult::STORAGE_ERR_IO;
+}
+
+// =============================================================================
+// RawFrameArchiveReader
+// =============================================================================
+
+RawFrameArchiveReader::RawFrameArchiveReader(const ArchiveConfig& config)
+    : config_(config) {
+    config_.threads = ResolveThreads(config_.threads);
+}
+
+RawFrameArchiveReader::~RawFrameArchiveReader() {
+    Close();
+}
+
+StorageResult RawFrameArchiveReader::Open(const std::string& path) {
+    Close();
+
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    fallback_buffer_.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(fallback_buffer_.data()),
+                 static_cast<std::streamsize>(fallback_buffer_.size()))) {
+        fallback_buffer_.clear();
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    data_ = fallback_buffer_.data();
+    size_ = fallback_buffer_.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        return st.st_size < static_cast<off_t>(sizeof(FileHeader))
+                   ? StorageResult::STORAGE_ERR_FORMAT
+                   : StorageResult::STORAGE_ERR_IO;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return StorageResult::STORAGE_ERR_IO;
+    }
+    // Replay tools stream frames front to back
+    madvise(mapping, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(mapping);
+    size_ = static_cast<size_t>(st.st_size);
+    mapped_ = true;
+#endif
+
+    if (size_ < sizeof(FileHeader)) {
+        Close();
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+    auto header = LoadStruct<FileHeader>(data_);
+    if (header.magic != kFileMagic || header.version != kFormatVersion ||
+        header.header_bytes != sizeof(FileHeader)) {
+        Close();
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+
+    if (!LoadIndex()) {
+        recovered_ = true;
+        if (!ScanRecords()) {
+            Close();
+            return StorageResult::STORAGE_ERR_FORMAT;
+        }
+    }
+    return StorageResult::STORAGE_OK;
+}
+
+void RawFrameArchiveReader::Close() {
+#ifndef _WIN32
+    if (mapped_ && data_ != nullptr) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    fallback_buffer_.clear();
+    index_.clear();
+    recovered_ = false;
+}
+
+bool RawFrameArchiveReader::LoadIndex() {
+    if (size_ < sizeof(FileHeader) + sizeof(Trailer)) {
+        return false;
+    }
+    auto trailer = LoadStruct<Trailer>(data_ + size_ - sizeof(Trailer));
+    if (trailer.magic != kTrailerMagic || trailer.entry_bytes != sizeof(IndexEntry)) {
+        return false;
+    }
+    uint64_t index_bytes = static_cast<uint64_t>(trailer.frame_count) * sizeof(IndexEntry);
+    if (trailer.index_offset < sizeof(FileHeader) ||
+        trailer.index_offset + index_bytes + sizeof(Trailer) != size_) {
+        return false;
+    }
+
+    std::vector<ArchiveFrameInfo> index(trailer.frame_count);
+    for (uint32_t i = 0; i < trailer.frame_count; ++i) {
+        auto entry = LoadStruct<IndexEntry>(data_ + trailer.index_offset + i * sizeof(IndexEntry));
+        if (entry.offset < sizeof(FileHeader) || entry.record_bytes < sizeof(RecordHeader) ||
+            entry.offset + entry.record_bytes > trailer.index_offset) {
+            return false;
+        }
+        ArchiveFrameInfo& info = index[i];
+        info.offset = entry.offset;
+        info.record_bytes = entry.record_bytes;
+        info.metadata.acquisition_id = entry.acquisition_id;
+        info.metadata.timestamp_us = entry.timestamp_us;
+        info.metadata.kv = entry.kv;
+        info.metadata.mas = entry.mas;
+        info.metadata.detector_id = entry.detector_id;
+        info.metadata.width = entry.width;
+        info.metadata.height = entry.height;
+        info.raw_bytes = static_cast<uint64_t>(entry.width) * entry.height * sizeof(uint16_t);
+    }
+    index_ = std::move(index);
+    return true;
+}
+
+bool RawFrameArchiveReader::ScanRecords() {
+    index_.clear();
+    uint64_t offset = sizeof(FileHeader);
+    while (offset + sizeof(RecordHeader) <= size_) {
+        auto header = LoadStruct<RecordHeader>(data_ + offset);
+        if (header.magic != kRecordMagic || header.header_bytes != sizeof(RecordHeader)) {
+            break;   // Index, trailer or a torn record: stop at the last good frame
+        }
+        uint64_t end = offset + sizeof(RecordHeader) + header.payload_bytes;
+        if (end > size_) {
+            break;
+        }
+        uint64_t record_bytes = end - offset;
+        record_bytes += (kRecordAlignment - end % kRecordAlignment) % kRecordAlignment;
+
+        ArchiveFrameInfo info;
+        info.offset = offset;
+        info.record_bytes = record_bytes;
+        info.metadata.acquisition_id = header.acquisition_id;
+        info.metadata.timestamp_us = header.timestamp_us;
+        info.metadata.kv = header.kv;
+        info.metadata.mas = header.mas;
+        info.metadata.detector_id = header.detector_id;
+        info.metadata.width = header.width;
+        info.metadata.height = header.height;
+        info.raw_bytes = static_cast<uint64_t>(header.width) * header.height * sizeof(uint16_t);
+        index_.push_back(info);
+        offset += record_bytes;
+    }
+    return true;
+}
+
+StorageResult RawFrameArchiveReader::GetFrameInfo(size_t index, ArchiveFrameInfo& info) const {
+    if (index >= index_.size()) {
+        return StorageResult::STORAGE_ERR_RANGE;
+    }
+    info = index_[index];
+    return StorageResult::STORAGE_OK;
+}
+
+StorageResult RawFrameArchiveReader::ReadFrame(size_t index, uint16_t* pixels,
+                                               size_t stride_px) const {
+    if (index >= index_.size()) {
+        return StorageResult::STORAGE_ERR_RANGE;
+    }
+    const ArchiveFrameInfo& info = index_[index];
+    if (pixels == nullptr || stride_px < info.metadata.width) {
+        return StorageResult::STORAGE_ERR_PARAM;
+    }
+
+    const uint8_t* record = data_ + info.offset;
+    auto header = LoadStruct<RecordHeader>(record);
+    if (header.magic != kRecordMagic || header.width != info.metadata.width ||
+        header.height != info.metadata.height || header.strip_rows == 0 ||
+        header.strip_count != (header.height + header.strip_rows - 1) / header.strip_rows ||
+        sizeof(RecordHeader) + header.payload_bytes > info.record_bytes) {
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+
+    const uint8_t* table = record + sizeof(RecordHeader);
+    uint64_t table_bytes = static_cast<uint64_t>(header.strip_count) * sizeof(uint32_t);
+    if (table_bytes > header.payload_bytes) {
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+    std::vector<uint64_t> strip_offsets(header.strip_count + 1);
+    strip_offsets[0] = table_bytes;
+    for (uint32_t s = 0; s < header.strip_count; ++s) {
+        strip_offsets[s + 1] = strip_offsets[s] + LoadStruct<uint32_t>(table + s * sizeof(uint32_t));
+    }
+    if (strip_offsets[header.strip_count] != header.payload_bytes) {
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+
+    std::atomic<bool> ok{true};
+    ParallelFor(header.strip_count, config_.threads, [&](size_t s) {
+        auto strip = static_cast<uint32_t>(s);
+        bool decoded = internal::DecodeStrip(
+            table + strip_offsets[s], strip_offsets[s + 1] - strip_offsets[s],
+            pixels + static_cast<size_t>(strip) * header.strip_rows * stride_px, stride_px,
+            header.width, StripRowsFor(strip, header.strip_rows, header.height));
+        if (!decoded) {
+            ok.store(false, std::memory_order_relaxed);
+        }
+    });
+    if (!ok.load() ||
+        internal::PixelChecksum(pixels, stride_px, header.width, header.height) != header.checksum) {
+        return StorageResult::STORAGE_ERR_FORMAT;
+    }
+    return StorageResult::STORAGE_OK;
+}
+
+StorageResult RawFrameArchiveReader::ReadFrame(size_t index, std::vector<uint16_t>& pixels) const {
+    if (index >= index_.size()) {
+        return StorageResult::STORAGE_ERR_RANGE;
+    }
+    const RawFrameMetadata& metadata = index_[index].metadata;
+    pixels.resize(static_cast<size_t>(metadata.width) * metadata.height);
+    return ReadFrame(index, pixels.data(), metadata.width);
+}
+
+} // namespace hnvue::storage
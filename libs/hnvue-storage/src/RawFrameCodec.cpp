@@ -0,0 +1,430 @@
+/**
+ * @file RawFrameCodec.cpp
+ * @brief Lossless 16-bit strip codec for the raw frame archive
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: raw frame archive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "RawFrameCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HNVUE_CODEC_HAS_SSE2 1
+#else
+    #define HNVUE_CODEC_HAS_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace hnvue::storage::internal {
+
+namespace {
+
+// =============================================================================
+// Constants
+// =============================================================================
+
+/// Residuals per Rice parameter
+constexpr size_t kRiceBlock = 32;
+
+/// Bits encoding the Rice parameter of a block
+constexpr unsigned kParamBits = 5;
+
+/// Parameter value marking a block of zero residuals (no further bits)
+constexpr uint32_t kZeroBlock = 31;
+
+/// Unary quotient at which the value is escaped as 16 raw bits
+constexpr uint32_t kEscapeQuotient = 20;
+
+inline unsigned CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+// =============================================================================
+// Prediction
+// =============================================================================
+
+inline uint16_t ZigZag(uint16_t residual) {
+    auto r = static_cast<int16_t>(residual);
+    return static_cast<uint16_t>((static_cast<uint16_t>(r) << 1) ^ static_cast<uint16_t>(r >> 15));
+}
+
+inline uint16_t UnZigZag(uint16_t zz) {
+    return static_cast<uint16_t>((zz >> 1) ^ static_cast<uint16_t>(-(zz & 1)));
+}
+
+inline uint16_t MedPredict(uint16_t a, uint16_t b, uint16_t c) {
+    uint16_t mn = std::min(a, b);
+    uint16_t mx = std::max(a, b);
+    if (c >= mx) {
+        return mn;
+    }
+    if (c <= mn) {
+        return mx;
+    }
+    return static_cast<uint16_t>(a + b - c);
+}
+
+/**
+ * @brief Zigzag residuals of one row against its MED prediction
+ * @param cur Row to code
+ * @param up Previous row of the strip, or nullptr for the first row
+ */
+void PredictRow(const uint16_t* cur, const uint16_t* up, uint32_t width, uint16_t* zz) {
+    if (up == nullptr) {
+        zz[0] = ZigZag(cur[0]);
+        for (uint32_t x = 1; x < width; ++x) {
+            zz[x] = ZigZag(static_cast<uint16_t>(cur[x] - cur[x - 1]));
+        }
+        return;
+    }
+
+    zz[0] = ZigZag(static_cast<uint16_t>(cur[0] - up[0]));
+    uint32_t x = 1;
+
+#if HNVUE_CODEC_HAS_SSE2
+    // Signed 16-bit min/max on values biased by 0x8000 give unsigned order
+    const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    for (; x + 8 <= width; x += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + x - 1));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + x));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + x - 1));
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + x));
+
+        __m128i as = _mm_xor_si128(a, bias);
+        __m128i bs = _mm_xor_si128(b, bias);
+        __m128i cs = _mm_xor_si128(c, bias);
+        __m128i mn = _mm_min_epi16(as, bs);
+        __m128i mx = _mm_max_epi16(as, bs);
+        __m128i grad = _mm_sub_epi16(_mm_add_epi16(a, b), c);
+
+        __m128i c_ge_mx = _mm_xor_si128(_mm_cmplt_epi16(cs, mx), _mm_set1_epi32(-1));
+        __m128i c_le_mn = _mm_xor_si128(_mm_cmpgt_epi16(cs, mn), _mm_set1_epi32(-1));
+        __m128i inner = _mm_or_si128(_mm_and_si128(c_le_mn, _mm_xor_si128(mx, bias)),
+                                     _mm_andnot_si128(c_le_mn, grad));
+        __m128i pred = _mm_or_si128(_mm_and_si128(c_ge_mx, _mm_xor_si128(mn, bias)),
+                                    _mm_andnot_si128(c_ge_mx, inner));
+
+        __m128i r = _mm_sub_epi16(v, pred);
+        __m128i z = _mm_xor_si128(_mm_slli_epi16(r, 1), _mm_srai_epi16(r, 15));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(zz + x), z);
+    }
+#endif
+
+    for (; x < width; ++x) {
+        uint16_t pred = MedPredict(cur[x - 1], up[x], up[x - 1]);
+        zz[x] = ZigZag(static_cast<uint16_t>(cur[x] - pred));
+    }
+}
+
+// =============================================================================
+// Bit I/O (LSB first)
+// =============================================================================
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void Put(uint64_t bits, unsigned count) {
+        acc_ |= bits << fill_;
+        fill_ += count;
+        if (fill_ >= 32) {
+            uint8_t bytes[4];
+            for (int i = 0; i < 4; ++i) {
+                bytes[i] = static_cast<uint8_t>(acc_ >> (8 * i));
+            }
+            out_.insert(out_.end(), bytes, bytes + 4);
+            acc_ >>= 32;
+            fill_ -= 32;
+        }
+    }
+
+    void Finish() {
+        while (fill_ > 0) {
+            out_.push_back(static_cast<uint8_t>(acc_));
+            acc_ >>= 8;
+            fill_ = fill_ > 8 ? fill_ - 8 : 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t acc_ = 0;
+    unsigned fill_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    /// Ensure at least 57 bits are buffered (fewer only at end of data)
+    void Refill() {
+        if (pos_ + 8 <= size_) {
+            uint64_t word = 0;
+            for (int i = 0; i < 8; ++i) {
+                word |= static_cast<uint64_t>(data_[pos_ + i]) << (8 * i);
+            }
+            buf_ |= word << count_;
+            size_t advance = (63 - count_) >> 3;
+            pos_ += advance;
+            count_ += static_cast<unsigned>(advance * 8);
+        } else {
+            while (count_ <= 56 && pos_ < size_) {
+                buf_ |= static_cast<uint64_t>(data_[pos_++]) << count_;
+                count_ += 8;
+            }
+        }
+    }
+
+    bool Get(unsigned bits, uint32_t& value) {
+        if (count_ < bits) {
+            Refill();
+            if (count_ < bits) {
+                return false;
+            }
+        }
+        value = static_cast<uint32_t>(buf_ & ((1ull << bits) - 1));
+        Consume(bits);
+        return true;
+    }
+
+    /// Read a unary quotient (ones terminated by a zero), capped at kEscapeQuotient
+    bool GetQuotient(uint32_t& quotient) {
+        if (count_ <= kEscapeQuotient) {
+            Refill();
+        }
+        uint64_t inverted = ~buf_;
+        unsigned ones = inverted == 0 ? 64 : CountTrailingZeros(inverted);
+        if (ones >= kEscapeQuotient) {
+            if (count_ < kEscapeQuotient) {
+                return false;
+            }
+            Consume(kEscapeQuotient);
+            quotient = kEscapeQuotient;
+            return true;
+        }
+        if (count_ < ones + 1) {
+            return false;
+        }
+        Consume(ones + 1);
+        quotient = ones;
+        return true;
+    }
+
+private:
+    void Consume(unsigned bits) {
+        buf_ = bits >= 64 ? 0 : buf_ >> bits;
+        count_ -= bits;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    uint64_t buf_ = 0;
+    unsigned count_ = 0;
+};
+
+// =============================================================================
+// Rice Coding
+// =============================================================================
+
+uint32_t ChooseRiceParameter(const uint16_t* values, size_t count) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    if (sum == 0) {
+        return kZeroBlock;
+    }
+    // Largest k with count * 2^k <= sum, i.e. 2^k close to the mean
+    uint32_t k = 0;
+    while (k < 16 && (static_cast<uint64_t>(count) << (k + 1)) <= sum) {
+        ++k;
+    }
+    return k;
+}
+
+void RiceEncode(const uint16_t* values, size_t count, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    for (size_t start = 0; start < count; start += kRiceBlock) {
+        size_t n = std::min(kRiceBlock, count - start);
+        uint32_t k = ChooseRiceParameter(values + start, n);
+        writer.Put(k, kParamBits);
+        if (k == kZeroBlock) {
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t v = values[start + i];
+            uint32_t q = v >> k;
+            if (q < kEscapeQuotient) {
+                writer.Put((1ull << q) - 1, q + 1);   // q ones, then a zero
+                if (k > 0) {
+                    writer.Put(v & ((1u << k) - 1), k);
+                }
+            } else {
+                writer.Put((1ull << kEscapeQuotient) - 1, kEscapeQuotient);
+                writer.Put(v, 16);
+            }
+        }
+    }
+    writer.Finish();
+}
+
+bool RiceDecode(const uint8_t* data, size_t size, uint16_t* values, size_t count) {
+    BitReader reader(data, size);
+    for (size_t start = 0; start < count; start += kRiceBlock) {
+        size_t n = std::min(kRiceBlock, count - start);
+        uint32_t k = 0;
+        if (!reader.Get(kParamBits, k)) {
+            return false;
+        }
+        if (k == kZeroBlock) {
+            std::fill(values + start, values + start + n, uint16_t{0});
+            continue;
+        }
+        if (k > 16) {
+            return false;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t q = 0;
+            if (!reader.GetQuotient(q)) {
+                return false;
+            }
+            uint32_t v = 0;
+            if (q == kEscapeQuotient) {
+                if (!reader.Get(16, v)) {
+                    return false;
+                }
+            } else {
+                uint32_t low = 0;
+                if (k > 0 && !reader.Get(k, low)) {
+                    return false;
+                }
+                v = (q << k) | low;
+                if (v > 0xFFFF) {
+                    return false;
+                }
+            }
+            values[start + i] = static_cast<uint16_t>(v);
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Strip Codec
+// =============================================================================
+
+void EncodeStrip(const uint16_t* pixels, size_t stride_px, uint32_t width, uint32_t rows,
+                 std::vector<uint8_t>& out) {
+    out.clear();
+    size_t count = static_cast<size_t>(width) * rows;
+    std::vector<uint16_t> residuals(count);
+    for (uint32_t y = 0; y < rows; ++y) {
+        const uint16_t* cur = pixels + y * stride_px;
+        const uint16_t* up = y == 0 ? nullptr : cur - stride_px;
+        PredictRow(cur, up, width, residuals.data() + static_cast<size_t>(y) * width);
+    }
+
+    out.reserve(count * sizeof(uint16_t) / 2);
+    out.push_back(static_cast<uint8_t>(StripMode::STRIP_RICE));
+    RiceEncode(residuals.data(), count, out);
+
+    // Noise-dominated data: store verbatim rather than expand
+    size_t stored_bytes = 1 + count * sizeof(uint16_t);
+    if (out.size() >= stored_bytes) {
+        out.clear();
+        out.reserve(stored_bytes);
+        out.push_back(static_cast<uint8_t>(StripMode::STRIP_STORED));
+        for (uint32_t y = 0; y < rows; ++y) {
+            const uint16_t* row = pixels + y * stride_px;
+            for (uint32_t x = 0; x < width; ++x) {
+                out.push_back(static_cast<uint8_t>(row[x]));
+                out.push_back(static_cast<uint8_t>(row[x] >> 8));
+            }
+        }
+    }
+}
+
+bool DecodeStrip(const uint8_t* data, size_t size, uint16_t* pixels, size_t stride_px,
+                 uint32_t width, uint32_t rows) {
+    if (size < 1 || width == 0) {
+        return false;
+    }
+    size_t count = static_cast<size_t>(width) * rows;
+    auto mode = static_cast<StripMode>(data[0]);
+
+    if (mode == StripMode::STRIP_STORED) {
+        if (size != 1 + count * sizeof(uint16_t)) {
+            return false;
+        }
+        const uint8_t* src = data + 1;
+        for (uint32_t y = 0; y < rows; ++y) {
+            uint16_t* row = pixels + y * stride_px;
+            for (uint32_t x = 0; x < width; ++x, src += 2) {
+                row[x] = static_cast<uint16_t>(src[0] | (src[1] << 8));
+            }
+        }
+        return true;
+    }
+    if (mode != StripMode::STRIP_RICE) {
+        return false;
+    }
+
+    std::vector<uint16_t> residuals(count);
+    if (!RiceDecode(data + 1, size - 1, residuals.data(), count)) {
+        return false;
+    }
+
+    // Reconstruction depends on the left neighbour, so it runs scalar
+    const uint16_t* zz = residuals.data();
+    for (uint32_t y = 0; y < rows; ++y, zz += width) {
+        uint16_t* cur = pixels + y * stride_px;
+        if (y == 0) {
+            cur[0] = UnZigZag(zz[0]);
+            for (uint32_t x = 1; x < width; ++x) {
+                cur[x] = static_cast<uint16_t>(cur[x - 1] + UnZigZag(zz[x]));
+            }
+            continue;
+        }
+        const uint16_t* up = cur - stride_px;
+        cur[0] = static_cast<uint16_t>(up[0] + UnZigZag(zz[0]));
+        for (uint32_t x = 1; x < width; ++x) {
+            uint16_t pred = MedPredict(cur[x - 1], up[x], up[x - 1]);
+            cur[x] = static_cast<uint16_t>(pred + UnZigZag(zz[x]));
+        }
+    }
+    return true;
+}
+
+uint64_t PixelChecksum(const uint16_t* pixels, size_t stride_px, uint32_t width, uint32_t height) {
+    // Fletcher-style: two running sums modulo 2^32
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint16_t* row = pixels + y * stride_px;
+        for (uint32_t x = 0; x < width; ++x) {
+            sum1 += row[x];
+            sum2 += sum1;
+        }
+    }
+    return (static_cast<uint64_t>(sum2) << 32) | sum1;
+}
+
+} // namespace hnvue::storage::internal
@@ -0,0 +1,68 @@
+/**
+ * @file RawFrameCodec.h
+ * @brief Lossless 16-bit strip codec for the raw frame archive
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: raw frame archive
+ * SPDX-License-Identifier: MIT
+ *
+ * Each strip (a band of rows) is coded independently so strips can be
+ * compressed and decompressed in parallel:
+ *   1. MED (LOCO-I median edge detector) prediction from left, up and
+ *      up-left neighbours; the first strip row uses the left neighbour only.
+ *      Residuals are taken modulo 2^16 and zigzag-mapped. The encoder
+ *      computes eight residuals per SSE2 step.
+ *   2. Adaptive Rice coding in blocks of 32 residuals, with a 5-bit
+ *      parameter per block, an all-zero block code and a 16-bit escape for
+ *      outliers.
+ * A strip that does not shrink is stored verbatim.
+ */
+
+#ifndef HNUE_STORAGE_RAW_FRAME_CODEC_H
+#define HNUE_STORAGE_RAW_FRAME_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hnvue::storage::internal {
+
+/// Strip payload mode byte
+enum class StripMode : uint8_t {
+    STRIP_RICE = 0,     ///< MED residuals, Rice coded
+    STRIP_STORED = 1    ///< Raw little-endian pixels
+};
+
+/**
+ * @brief Compress one strip
+ * @param pixels First pixel of the strip
+ * @param stride_px Row pitch in pixels
+ * @param width Pixels per row
+ * @param rows Rows in the strip
+ * @param[out] out Receives the strip payload (mode byte + data); cleared first
+ */
+void EncodeStrip(const uint16_t* pixels, size_t stride_px, uint32_t width, uint32_t rows,
+                 std::vector<uint8_t>& out);
+
+/**
+ * @brief Decompress one strip
+ * @param data Strip payload produced by EncodeStrip
+ * @param size Payload bytes
+ * @param[out] pixels First destination pixel
+ * @param stride_px Destination row pitch in pixels
+ * @param width Pixels per row
+ * @param rows Rows in the strip
+ * @return false if the payload is truncated or malformed
+ */
+bool DecodeStrip(const uint8_t* data, size_t size, uint16_t* pixels, size_t stride_px,
+                 uint32_t width, uint32_t rows);
+
+/**
+ * @brief Fletcher-64 checksum of a pixel buffer (row by row)
+ */
+uint64_t PixelChecksum(const uint16_t* pixels, size_t stride_px, uint32_t width, uint32_t height);
+
+} // namespace hnvue::storage::internal
+
+#endif // HNUE_STORAGE_RAW_FRAME_CODEC_H
@@ -0,0 +1,110 @@
+/**
+ * @file ThreadPoolWriteBackend.cpp
+ * @brief Portable storage backend using blocking writes on worker threads
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "ThreadPoolWriteBackend.h"
+#include "WriteQueue.h"
+
+#include "hnvue/infra/ThreadPolicy.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace hnvue::storage::internal {
+
+namespace {
+
+/// Largest single fwrite; keeps each call's latency bounded
+constexpr size_t kMaxWriteChunk = 4u << 20;
+
+bool SyncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fdatasync(fileno(file)) == 0;
+#endif
+}
+
+} // anonymous namespace
+
+ThreadPoolWriteBackend::ThreadPoolWriteBackend(const StorageConfig& config)
+    : config_(config) {}
+
+ThreadPoolWriteBackend::~ThreadPoolWriteBackend() {
+    Stop();
+}
+
+StorageResult ThreadPoolWriteBackend::Start(WriteQueue& queue, StorageCounters& counters) {
+    uint32_t count = std::max<uint32_t>(1, config_.worker_threads);
+    workers_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPoolWriteBackend::WorkerLoop, this,
+                              std::ref(queue), std::ref(counters));
+    }
+    return StorageResult::STORAGE_OK;
+}
+
+void ThreadPoolWriteBackend::Stop() {
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void ThreadPoolWriteBackend::WorkerLoop(WriteQueue& queue, StorageCounters& counters) {
+    infra::ApplyNamedThreadPolicy(kThreadStorageWriter);
+
+    WriteJob job;
+    while (queue.Pop(job)) {
+        std::FILE* file = std::fopen(job.path.c_str(), "wb");
+        if (file == nullptr) {
+            queue.Complete(job, StorageResult::STORAGE_ERR_IO, 0, false);
+            continue;
+        }
+        // Payloads are large and written once; stdio buffering only adds a copy
+        std::setvbuf(file, nullptr, _IONBF, 0);
+
+        size_t written = 0;
+        bool ok = true;
+        while (written < job.length) {
+            size_t chunk = std::min(kMaxWriteChunk, job.length - written);
+            counters.AddInflight(1);
+            counters.submit_calls.fetch_add(1, std::memory_order_relaxed);
+            size_t n = std::fwrite(job.data + written, 1, chunk, file);
+            counters.RemoveInflight(1);
+            written += n;
+            if (n != chunk) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok && config_.sync_on_close) {
+            ok = SyncFile(file);
+        }
+        if (std::fclose(file) != 0) {
+            ok = false;
+        }
+
+        queue.Complete(job, ok ? StorageResult::STORAGE_OK : StorageResult::STORAGE_ERR_IO,
+                       written, false);
+    }
+}
+
+} // namespace hnvue::storage::internal
@@ -0,0 +1,46 @@
+/**
+ * @file ThreadPoolWriteBackend.h
+ * @brief Portable storage backend using blocking writes on worker threads
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_STORAGE_THREAD_POOL_WRITE_BACKEND_H
+#define HNUE_STORAGE_THREAD_POOL_WRITE_BACKEND_H
+
+#include "IWriteBackend.h"
+
+#include <thread>
+#include <vector>
+
+namespace hnvue::storage::internal {
+
+/**
+ * @brief Fallback backend: each worker writes one file at a time
+ *
+ * Used where io_uring is unavailable (non-Linux, old kernels, seccomp
+ * profiles that block io_uring_setup). Writes are buffered; the acquisition
+ * thread is still decoupled from disk latency by the queue.
+ */
+class ThreadPoolWriteBackend : public IWriteBackend {
+public:
+    explicit ThreadPoolWriteBackend(const StorageConfig& config);
+    ~ThreadPoolWriteBackend() override;
+
+    StorageResult Start(WriteQueue& queue, StorageCounters& counters) override;
+    void Stop() override;
+    StorageBackend Type() const override { return StorageBackend::STORAGE_BACKEND_THREAD_POOL; }
+
+private:
+    void WorkerLoop(WriteQueue& queue, StorageCounters& counters);
+
+    StorageConfig config_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace hnvue::storage::internal
+
+#endif // HNUE_STORAGE_THREAD_POOL_WRITE_BACKEND_H
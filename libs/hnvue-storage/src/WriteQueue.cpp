@@ -0,0 +1,168 @@
+/**
+ * @file WriteQueue.cpp
+ * @brief Bounded job queue shared by AsyncFrameWriter and its backends
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "WriteQueue.h"
+
+#include "hnvue/infra/Clock.h"
+
+#include <utility>
+
+namespace hnvue::storage::internal {
+
+namespace {
+
+template <typename T>
+void UpdateMax(std::atomic<T>& target, T value) {
+    T current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// StorageCounters
+// =============================================================================
+
+void StorageCounters::AddInflight(size_t n) {
+    size_t now = inflight_ios.fetch_add(n, std::memory_order_relaxed) + n;
+    UpdateMax(inflight_high_water, now);
+    ios_submitted.fetch_add(n, std::memory_order_relaxed);
+}
+
+void StorageCounters::Reset() {
+    jobs_enqueued = 0;
+    jobs_completed = 0;
+    jobs_failed = 0;
+    jobs_rejected = 0;
+    bytes_written = 0;
+    queue_high_water = 0;
+    inflight_ios = 0;
+    inflight_high_water = 0;
+    submit_calls = 0;
+    ios_submitted = 0;
+    total_latency_us = 0;
+    max_latency_us = 0;
+}
+
+// =============================================================================
+// WriteQueue
+// =============================================================================
+
+WriteQueue::WriteQueue(size_t capacity, StorageCounters& counters)
+    : capacity_(capacity), counters_(counters) {}
+
+void WriteQueue::Open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = true;
+}
+
+void WriteQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = false;
+    }
+    not_empty_.notify_all();
+}
+
+bool WriteQueue::IsOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+StorageResult WriteQueue::Push(WriteJob&& job) {
+    size_t depth = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return StorageResult::STORAGE_ERR_NOT_RUNNING;
+        }
+        if (jobs_.size() >= capacity_) {
+            counters_.jobs_rejected.fetch_add(1, std::memory_order_relaxed);
+            return StorageResult::STORAGE_ERR_QUEUE_FULL;
+        }
+        jobs_.push_back(std::move(job));
+        ++outstanding_;
+        depth = jobs_.size();
+    }
+    counters_.jobs_enqueued.fetch_add(1, std::memory_order_relaxed);
+    UpdateMax(counters_.queue_high_water, depth);
+    not_empty_.notify_one();
+    return StorageResult::STORAGE_OK;
+}
+
+bool WriteQueue::Pop(WriteJob& out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return !jobs_.empty() || !open_; });
+    if (jobs_.empty()) {
+        return false;
+    }
+    out = std::move(jobs_.front());
+    jobs_.pop_front();
+    return true;
+}
+
+bool WriteQueue::TryPop(WriteJob& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.empty()) {
+        return false;
+    }
+    out = std::move(jobs_.front());
+    jobs_.pop_front();
+    return true;
+}
+
+size_t WriteQueue::Depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+void WriteQueue::Complete(WriteJob& job, StorageResult result, uint64_t bytes_written,
+                          bool direct_io) {
+    WriteResult report;
+    report.result = result;
+    report.path = std::move(job.path);
+    report.bytes_written = bytes_written;
+    report.latency_us = infra::SinceStartUs() - job.enqueue_us;
+    report.direct_io = direct_io;
+
+    if (result == StorageResult::STORAGE_OK) {
+        counters_.jobs_completed.fetch_add(1, std::memory_order_relaxed);
+        counters_.bytes_written.fetch_add(bytes_written, std::memory_order_relaxed);
+    } else {
+        counters_.jobs_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    counters_.total_latency_us.fetch_add(report.latency_us, std::memory_order_relaxed);
+    UpdateMax(counters_.max_latency_us, report.latency_us);
+
+    // Release the payload before the callback so the frame returns to its pool
+    job.handle.Reset();
+    infra::PooledVector<uint8_t>().swap(job.vector);
+    job.data = nullptr;
+
+    if (job.callback) {
+        job.callback(report);
+        job.callback = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --outstanding_;
+    }
+    idle_.notify_all();
+}
+
+bool WriteQueue::WaitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_.wait_for(lock, timeout, [this] { return outstanding_ == 0; });
+}
+
+} // namespace hnvue::storage::internal
@@ -0,0 +1,138 @@
+/**
+ * @file WriteQueue.h
+ * @brief Bounded job queue shared by AsyncFrameWriter and its backends
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HNUE_STORAGE_WRITE_QUEUE_H
+#define HNUE_STORAGE_WRITE_QUEUE_H
+
+#include "hnvue/storage/StorageTypes.h"
+#include "hnvue/infra/FramePool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace hnvue::storage::internal {
+
+/**
+ * @brief One file to write
+ *
+ * data points into handle or vector, whichever owns the payload.
+ */
+struct WriteJob {
+    std::string path;
+    infra::FrameHandle handle;
+    infra::PooledVector<uint8_t> vector;
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    WriteCallback callback;
+    int64_t enqueue_us = 0;
+};
+
+/**
+ * @brief Counters updated by the queue and the backends
+ */
+struct StorageCounters {
+    std::atomic<uint64_t> jobs_enqueued{0};
+    std::atomic<uint64_t> jobs_completed{0};
+    std::atomic<uint64_t> jobs_failed{0};
+    std::atomic<uint64_t> jobs_rejected{0};
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<size_t> queue_high_water{0};
+    std::atomic<size_t> inflight_ios{0};
+    std::atomic<size_t> inflight_high_water{0};
+    std::atomic<uint64_t> submit_calls{0};
+    std::atomic<uint64_t> ios_submitted{0};
+    std::atomic<int64_t> total_latency_us{0};
+    std::atomic<int64_t> max_latency_us{0};
+
+    /// Record n newly submitted operations and update the in-flight peak
+    void AddInflight(size_t n);
+
+    /// Record n completed operations
+    void RemoveInflight(size_t n) { inflight_ios.fetch_sub(n, std::memory_order_relaxed); }
+
+    /// Zero all counters
+    void Reset();
+};
+
+/**
+ * @brief Bounded MPMC queue of write jobs with completion tracking
+ *
+ * Push never blocks. Pop blocks until a job is available or the queue is
+ * closed and drained. Every accepted job must be passed to Complete()
+ * exactly once; WaitIdle() waits for that.
+ */
+class WriteQueue {
+public:
+    WriteQueue(size_t capacity, StorageCounters& counters);
+
+    /// Accept jobs (after Start)
+    void Open();
+
+    /// Refuse new jobs and wake blocked Pop() callers once drained
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * @brief Append a job
+     * @return STORAGE_OK, STORAGE_ERR_QUEUE_FULL or STORAGE_ERR_NOT_RUNNING
+     */
+    StorageResult Push(WriteJob&& job);
+
+    /**
+     * @brief Remove the oldest job, waiting if the queue is empty
+     * @return false once the queue is closed and empty
+     */
+    bool Pop(WriteJob& out);
+
+    /**
+     * @brief Remove the oldest job without waiting
+     * @return false if the queue is empty
+     */
+    bool TryPop(WriteJob& out);
+
+    /// Jobs waiting for a writer
+    size_t Depth() const;
+
+    /**
+     * @brief Report a job as finished and invoke its callback
+     * @param job Job to complete; its payload reference is released
+     * @param result Outcome
+     * @param bytes_written Payload bytes written
+     * @param direct_io true if written with O_DIRECT
+     */
+    void Complete(WriteJob& job, StorageResult result, uint64_t bytes_written, bool direct_io);
+
+    /**
+     * @brief Wait until all accepted jobs are completed
+     * @return false on timeout
+     */
+    bool WaitIdle(std::chrono::milliseconds timeout);
+
+private:
+    const size_t capacity_;
+    StorageCounters& counters_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable idle_;
+    std::deque<WriteJob> jobs_;
+    uint64_t outstanding_ = 0;
+    bool open_ = false;
+};
+
+} // namespace hnvue::storage::internal
+
+#endif // HNUE_STORAGE_WRITE_QUEUE_H
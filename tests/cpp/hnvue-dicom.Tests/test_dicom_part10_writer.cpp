@@ -0,0 +1,452 @@
+/**
+ * @file test_dicom_part10_writer.cpp
+ * @brief GTest unit tests for the native Part-10 writer (DicomPart10Writer.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * Written files are parsed back with a minimal Explicit VR Little Endian
+ * reader and an RLE decoder defined in this file.
+ *
+ * Decisions exercised:
+ *   Dataset:  padding / replacement / reserved tags / odd word length
+ *   Writer:   native pixels from a strided buffer / For Processing SOP class /
+ *             fragment precedence and tag order / RLE Lossless round trip /
+ *             RLE independent of thread count / invalid requests
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hnvue/dicom/DicomPart10Writer.h"
+#include "hnvue/infra/Clock.h"
+
+using namespace hnvue::dicom;
+using hnvue::imaging::ImageBuffer;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kUid = "1.2.410.200001.1.1.42";
+
+std::vector<uint8_t> ReadFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+}
+
+uint16_t Load16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t Load32(const uint8_t* p) { return Load16(p) | (static_cast<uint32_t>(Load16(p + 2)) << 16); }
+
+/**
+ * @brief Part-10 file parsed into element values
+ */
+struct ParsedFile {
+    bool ok = false;
+    std::map<uint32_t, std::vector<uint8_t>> values;
+    std::vector<uint32_t> order;                   ///< Dataset tags in file order
+    std::vector<std::vector<uint8_t>> fragments;   ///< Encapsulated items (offset table first)
+
+    std::string String(uint32_t tag) const {
+        auto it = values.find(tag);
+        if (it == values.end()) {
+            return "<absent>";
+        }
+        std::string value(it->second.begin(), it->second.end());
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\0')) {
+            value.pop_back();
+        }
+        return value;
+    }
+
+    uint16_t UShort(uint32_t tag) const {
+        auto it = values.find(tag);
+        return it == values.end() || it->second.size() != 2 ? 0xFFFF : Load16(it->second.data());
+    }
+};
+
+ParsedFile Parse(const std::vector<uint8_t>& file) {
+    ParsedFile parsed;
+    if (file.size() < 132 || std::memcmp(file.data() + 128, "DICM", 4) != 0) {
+        return parsed;
+    }
+    size_t pos = 132;
+    while (pos + 8 <= file.size()) {
+        uint32_t tag = MakeTag(Load16(&file[pos]), Load16(&file[pos + 2]));
+        std::string vr(reinterpret_cast<const char*>(&file[pos + 4]), 2);
+        uint32_t length = 0;
+        if (vr == "OB" || vr == "OW" || vr == "UN" || vr == "UT" || vr == "SQ") {
+            length = Load32(&file[pos + 8]);
+            pos += 12;
+        } else {
+            length = Load16(&file[pos + 6]);
+            pos += 8;
+        }
+        if (TagGroup(tag) != 0x0002) {
+            parsed.order.push_back(tag);
+        }
+
+        if (tag == tags::kPixelData && length == 0xFFFFFFFFu) {
+            while (pos + 8 <= file.size()) {
+                uint32_t item = MakeTag(Load16(&file[pos]), Load16(&file[pos + 2]));
+                uint32_t item_length = Load32(&file[pos + 4]);
+                pos += 8;
+                if (item == MakeTag(0xFFFE, 0xE0DD)) {
+                    parsed.ok = pos == file.size();
+                    return parsed;
+                }
+                if (item != MakeTag(0xFFFE, 0xE000) || pos + item_length > file.size()) {
+                    return parsed;
+                }
+                parsed.fragments.emplace_back(file.begin() + pos, file.begin() + pos + item_length);
+                pos += item_length;
+            }
+            return parsed;
+        }
+
+        if (pos + length > file.size()) {
+            return parsed;
+        }
+        parsed.values[tag].assign(file.begin() + pos, file.begin() + pos + length);
+        pos += length;
+    }
+    parsed.ok = pos == file.size();
+    return parsed;
+}
+
+/// Decode one RLE Lossless frame of 16-bit samples
+bool DecodeRle(const std::vector<uint8_t>& fragment, size_t samples, std::vector<uint16_t>& out) {
+    if (fragment.size() < 64 || Load32(fragment.data()) != 2) {
+        return false;
+    }
+    std::vector<uint8_t> planes[2];
+    for (int s = 0; s < 2; ++s) {
+        size_t pos = Load32(fragment.data() + 4 + 4 * s);
+        size_t end = s == 0 ? Load32(fragment.data() + 8) : fragment.size();
+        while (planes[s].size() < samples && pos < end) {
+            auto header = static_cast<int8_t>(fragment[pos++]);
+            if (header >= 0) {
+                for (int i = 0; i <= header && pos < end; ++i) {
+                    planes[s].push_back(fragment[pos++]);
+                }
+            } else if (header != -128) {
+                planes[s].insert(planes[s].end(), static_cast<size_t>(1 - header), fragment[pos++]);
+            }
+        }
+        if (planes[s].size() != samples) {
+            return false;
+        }
+    }
+    out.resize(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        out[i] = static_cast<uint16_t>((planes[0][i] << 8) | planes[1][i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Frame with a configurable row pitch
+ */
+struct TestImage {
+    std::vector<uint16_t> storage;
+    ImageBuffer view;
+
+    TestImage(uint32_t width, uint32_t height, uint32_t stride_px, bool noisy) {
+        storage.assign(static_cast<size_t>(stride_px) * height, 0xDEAD);
+        std::mt19937 rng(width * 31 + height);
+        std::uniform_int_distribution<int> noise(-3, 3);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                int base = 2000 + static_cast<int>(x / 8) * 4 + static_cast<int>(y / 16) * 9;
+                storage[static_cast<size_t>(y) * stride_px + x] =
+                    static_cast<uint16_t>(base + (noisy ? noise(rng) : 0));
+            }
+        }
+        view.width = width;
+        view.height = height;
+        view.stride = stride_px * 2;
+        view.data = storage.data();
+    }
+
+    std::vector<uint16_t> Packed() const {
+        std::vector<uint16_t> packed;
+        for (uint32_t y = 0; y < view.height; ++y) {
+            const uint16_t* row = storage.data() + static_cast<size_t>(y) * view.stride / 2;
+            packed.insert(packed.end(), row, row + view.width);
+        }
+        return packed;
+    }
+};
+
+std::vector<uint16_t> ToWords(const std::vector<uint8_t>& bytes) {
+    std::vector<uint16_t> words(bytes.size() / 2);
+    std::memcpy(words.data(), bytes.data(), words.size() * 2);
+    return words;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Fixture with a private output directory
+ */
+class DicomPart10WriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() /
+               ("hnvue_dicom_" + std::to_string(hnvue::infra::WallClockNowUs()));
+        fs::create_directories(dir_);
+        request_.sop_instance_uid = kUid;
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    std::string PathFor(const std::string& name) const {
+        return (dir_ / name).string();
+    }
+
+    fs::path dir_;
+    DicomImageRequest request_;
+};
+
+// =============================================================================
+// DicomDataset
+// =============================================================================
+
+TEST(DicomDatasetTest, PadsAndReplacesElements) {
+    DicomDataset dataset;
+    ASSERT_EQ(dataset.SetString(MakeTag(0x0020, 0x000D), DicomVR::VR_UI, "1.2.3"),
+              DicomResult::DICOM_OK);
+    ASSERT_EQ(dataset.SetString(MakeTag(0x0010, 0x0010), DicomVR::VR_PN, "DOE^JANE"),
+              DicomResult::DICOM_OK);
+
+    // Kept in tag order; UI padded with NUL to even length
+    ASSERT_EQ(dataset.Size(), 2u);
+    EXPECT_EQ(dataset.Elements()[0].tag, MakeTag(0x0010, 0x0010));
+    const DicomDataset::Element* uid = dataset.Find(MakeTag(0x0020, 0x000D));
+    ASSERT_NE(uid, nullptr);
+    ASSERT_EQ(uid->bytes.size(), 8u + 6u);
+    EXPECT_EQ(Load16(&uid->bytes[6]), 6u);
+    EXPECT_EQ(uid->bytes.back(), '\0');
+
+    uint64_t before = dataset.EncodedBytes();
+    ASSERT_EQ(dataset.SetString(MakeTag(0x0010, 0x0010), DicomVR::VR_PN, "DOE^JOHNNY"),
+              DicomResult::DICOM_OK);
+    EXPECT_EQ(dataset.Size(), 2u);
+    EXPECT_EQ(dataset.EncodedBytes(), before + 2);
+
+    dataset.Remove(MakeTag(0x0010, 0x0010));
+    EXPECT_FALSE(dataset.Contains(MakeTag(0x0010, 0x0010)));
+    EXPECT_EQ(dataset.EncodedBytes(), 14u);
+}
+
+TEST(DicomDatasetTest, RejectsReservedTagsAndBadValues) {
+    DicomDataset dataset;
+    EXPECT_EQ(dataset.SetString(MakeTag(0x0002, 0x0010), DicomVR::VR_UI, "1.2"),
+              DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.SetBytes(tags::kPixelData, DicomVR::VR_OW, "ab", 2),
+              DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.SetUInt32(MakeTag(0x0008, 0x0000), 4), DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.SetBytes(MakeTag(0x0009, 0x1010), DicomVR::VR_OW, "abc", 3),
+              DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.SetString(MakeTag(0x0010, 0x0010), DicomVR::VR_US, "x"),
+              DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.SetString(MakeTag(0x0010, 0x4000), DicomVR::VR_LT,
+                                std::string(70000, 'a')),
+              DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(dataset.Size(), 0u);
+}
+
+// =============================================================================
+// Native Pixel Data
+// =============================================================================
+
+TEST_F(DicomPart10WriterTest, WritesNativePixelsFromStridedBuffer) {
+    TestImage image(257, 130, 320, true);
+    DicomPart10Writer writer;
+    DicomWriteStats stats;
+    ASSERT_EQ(writer.Write(PathFor("a.dcm"), image.view, request_, &stats),
+              DicomResult::DICOM_OK);
+
+    std::vector<uint8_t> file = ReadFile(PathFor("a.dcm"));
+    EXPECT_EQ(stats.file_bytes, file.size());
+    EXPECT_EQ(stats.pixel_bytes, 257u * 130u * 2u);
+    EXPECT_GE(stats.write_calls, 1u);
+
+    ParsedFile parsed = Parse(file);
+    ASSERT_TRUE(parsed.ok);
+    EXPECT_EQ(parsed.String(MakeTag(0x0002, 0x0002)), uids::kDxForPresentation);
+    EXPECT_EQ(parsed.String(MakeTag(0x0002, 0x0003)), kUid);
+    EXPECT_EQ(parsed.String(MakeTag(0x0002, 0x0010)), uids::kExplicitVrLittleEndian);
+    EXPECT_EQ(parsed.String(tags::kSopInstanceUid), kUid);
+    EXPECT_EQ(parsed.String(tags::kPresentationIntentType), "FOR PRESENTATION");
+    EXPECT_EQ(parsed.UShort(tags::kRows), 130u);
+    EXPECT_EQ(parsed.UShort(tags::kColumns), 257u);
+    EXPECT_EQ(parsed.UShort(tags::kHighBit), 15u);
+
+    // Group length covers exactly the remaining meta elements
+    uint32_t meta_length = Load32(parsed.values[MakeTag(0x0002, 0x0000)].data());
+    EXPECT_EQ(file[132 + 12 + meta_length], 0x08);   // First dataset group
+
+    EXPECT_EQ(ToWords(parsed.values[tags::kPixelData]), image.Packed());
+}
+
+TEST_F(DicomPart10WriterTest, ForProcessingUsesProcessingSopClass) {
+    TestImage image(64, 32, 64, false);
+    request_.image_type = DicomImageType::DX_FOR_PROCESSING;
+    request_.bits_stored = 14;
+
+    DicomPart10Writer writer;
+    ASSERT_EQ(writer.Write(PathFor("a.dcm"), image.view, request_), DicomResult::DICOM_OK);
+
+    ParsedFile parsed = Parse(ReadFile(PathFor("a.dcm")));
+    ASSERT_TRUE(parsed.ok);
+    EXPECT_EQ(parsed.String(MakeTag(0x0002, 0x0002)), uids::kDxForProcessing);
+    EXPECT_EQ(parsed.String(tags::kSopClassUid), uids::kDxForProcessing);
+    EXPECT_EQ(parsed.String(tags::kPresentationIntentType), "FOR PROCESSING");
+    EXPECT_EQ(parsed.UShort(tags::kBitsStored), 14u);
+    EXPECT_EQ(parsed.UShort(tags::kHighBit), 13u);
+}
+
+TEST_F(DicomPart10WriterTest, SplicesFragmentsInTagOrderWithPrecedence) {
+    auto patient = std::make_shared<DicomDataset>();
+    patient->SetString(MakeTag(0x0010, 0x0010), DicomVR::VR_PN, "DOE^JANE");
+    patient->SetString(MakeTag(0x0010, 0x0020), DicomVR::VR_LO, "P-001");
+
+    auto protocol = std::make_shared<DicomDataset>();
+    protocol->SetString(tags::kModality, DicomVR::VR_CS, "CR");   // Overridden by the writer
+    protocol->SetString(MakeTag(0x0018, 0x0060), DicomVR::VR_DS, "70");
+    protocol->SetString(MakeTag(0x0020, 0x000D), DicomVR::VR_UI, "1.2.3.4");
+
+    DicomDataset instance;
+    instance.SetString(MakeTag(0x0018, 0x0060), DicomVR::VR_DS, "81");
+    instance.SetString(MakeTag(0x0020, 0x0013), DicomVR::VR_IS, "7");
+
+    request_.patient = patient;
+    request_.protocol = protocol;
+    request_.instance = &instance;
+
+    TestImage image(32, 16, 32, false);
+    DicomPart10Writer writer;
+    // Same cached fragments for two images
+    ASSERT_EQ(writer.Write(PathFor("a.dcm"), image.view, request_), DicomResult::DICOM_OK);
+    request_.sop_instance_uid = std::string(kUid) + ".2";
+    ASSERT_EQ(writer.Write(PathFor("b.dcm"), image.view, request_), DicomResult::DICOM_OK);
+
+    ParsedFile parsed = Parse(ReadFile(PathFor("b.dcm")));
+    ASSERT_TRUE(parsed.ok);
+    EXPECT_EQ(parsed.String(MakeTag(0x0010, 0x0010)), "DOE^JANE");
+    EXPECT_EQ(parsed.String(MakeTag(0x0010, 0x0020)), "P-001");
+    EXPECT_EQ(parsed.String(tags::kModality), "DX");
+    EXPECT_EQ(parsed.String(MakeTag(0x0018, 0x0060)), "81");
+    EXPECT_EQ(parsed.String(MakeTag(0x0020, 0x000D)), "1.2.3.4");
+    EXPECT_EQ(parsed.String(MakeTag(0x0020, 0x0013)), "7");
+    EXPECT_EQ(parsed.String(tags::kSopInstanceUid), std::string(kUid) + ".2");
+
+    ASSERT_FALSE(parsed.order.empty());
+    for (size_t i = 1; i < parsed.order.size(); ++i) {
+        EXPECT_LT(parsed.order[i - 1], parsed.order[i]) << "position " << i;
+    }
+    EXPECT_EQ(parsed.order.back(), tags::kPixelData);
+}
+
+// =============================================================================
+// RLE Lossless
+// =============================================================================
+
+TEST_F(DicomPart10WriterTest, RleLosslessRoundTrip) {
+    TestImage image(301, 203, 320, false);
+    DicomWriterConfig config;
+    config.transfer_syntax = DicomTransferSyntax::TS_RLE_LOSSLESS;
+    config.encoder_threads = 4;
+    DicomPart10Writer writer(config);
+    DicomWriteStats stats;
+    ASSERT_EQ(writer.Write(PathFor("a.dcm"), image.view, request_, &stats),
+              DicomResult::DICOM_OK);
+
+    std::vector<uint8_t> file = ReadFile(PathFor("a.dcm"));
+    EXPECT_EQ(stats.file_bytes, file.size());
+    ParsedFile parsed = Parse(file);
+    ASSERT_TRUE(parsed.ok);
+    EXPECT_EQ(parsed.String(MakeTag(0x0002, 0x0010)), uids::kRleLossless);
+    EXPECT_EQ(parsed.String(tags::kLossyImageCompression), "00");
+
+    ASSERT_EQ(parsed.fragments.size(), 2u);
+    EXPECT_TRUE(parsed.fragments[0].empty());   // Basic offset table
+    EXPECT_EQ(parsed.fragments[1].size() % 2, 0u);
+    EXPECT_LT(parsed.fragments[1].size(), 301u * 203u * 2u / 4);
+
+    std::vector<uint16_t> decoded;
+    ASSERT_TRUE(DecodeRle(parsed.fragments[1], 301u * 203u, decoded));
+    EXPECT_EQ(decoded, image.Packed());
+}
+
+TEST_F(DicomPart10WriterTest, RleOutputIndependentOfThreadCount) {
+    TestImage image(128, 97, 128, true);
+    DicomWriterConfig config;
+    config.transfer_syntax = DicomTransferSyntax::TS_RLE_LOSSLESS;
+
+    config.encoder_threads = 1;
+    DicomPart10Writer single(config);
+    ASSERT_EQ(single.Write(PathFor("a.dcm"), image.view, request_), DicomResult::DICOM_OK);
+
+    config.encoder_threads = 3;
+    DicomPart10Writer multi(config);
+    ASSERT_EQ(multi.Write(PathFor("b.dcm"), image.view, request_), DicomResult::DICOM_OK);
+
+    EXPECT_EQ(ReadFile(PathFor("a.dcm")), ReadFile(PathFor("b.dcm")));
+
+    ParsedFile parsed = Parse(ReadFile(PathFor("b.dcm")));
+    ASSERT_TRUE(parsed.ok);
+    ASSERT_EQ(parsed.fragments.size(), 2u);
+    std::vector<uint16_t> decoded;
+    ASSERT_TRUE(DecodeRle(parsed.fragments[1], 128u * 97u, decoded));
+    EXPECT_EQ(decoded, image.Packed());
+}
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST_F(DicomPart10WriterTest, RejectsInvalidRequests) {
+    TestImage image(16, 16, 16, false);
+    DicomPart10Writer writer;
+
+    DicomImageRequest no_uid;
+    EXPECT_EQ(writer.Write(PathFor("a.dcm"), image.view, no_uid), DicomResult::DICOM_ERR_PARAM);
+
+    DicomImageRequest bad_bits = request_;
+    bad_bits.bits_stored = 17;
+    EXPECT_EQ(writer.Write(PathFor("a.dcm"), image.view, bad_bits), DicomResult::DICOM_ERR_PARAM);
+
+    ImageBuffer empty;
+    EXPECT_EQ(writer.Write(PathFor("a.dcm"), empty, request_), DicomResult::DICOM_ERR_PARAM);
+
+    ImageBuffer narrow_stride = image.view;
+    narrow_stride.stride = 16;
+    EXPECT_EQ(writer.Write(PathFor("a.dcm"), narrow_stride, request_),
+              DicomResult::DICOM_ERR_PARAM);
+
+    ImageBuffer eight_bit = image.view;
+    eight_bit.pixel_depth = 8;
+    EXPECT_EQ(writer.Write(PathFor("a.dcm"), eight_bit, request_),
+              DicomResult::DICOM_ERR_NOT_SUPPORTED);
+
+    EXPECT_FALSE(fs::exists(PathFor("a.dcm")));
+    EXPECT_EQ(writer.Write(PathFor("missing/a.dcm"), image.view, request_),
+              DicomResult::DICOM_ERR_IO);
+}
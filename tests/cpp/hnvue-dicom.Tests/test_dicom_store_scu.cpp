@@ -0,0 +1,679 @@
+/**
+ * @file test_dicom_store_scu.cpp
+ * @brief GTest unit tests for the C-STORE SCU (DicomStoreScu.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - DICOM: image export
+ * SPDX-License-Identifier: MIT
+ *
+ * A stand-in Storage SCP on 127.0.0.1 (defined in this file with its own
+ * PDU code) accepts every proposed context, announces a small maximum PDU
+ * length to force fragmentation and holds responses until a configurable
+ * number of requests is outstanding.
+ *
+ * Decisions exercised:
+ *   Pipelining:  window honoured and filled / datasets byte-identical /
+ *                responses batched in one P-DATA-TF all read
+ *   Retry:       transient status retried with backoff / unreadable file fails
+ *   Queue:       journaled jobs resume in a new SCU instance
+ *   Config:      destination and enqueue validation
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hnvue/dicom/DicomPart10Writer.h"
+#include "hnvue/dicom/DicomStoreScu.h"
+#include "hnvue/infra/Clock.h"
+
+using namespace hnvue::dicom;
+using hnvue::imaging::ImageBuffer;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kScpMaxPdu = 16384;
+
+uint16_t Be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t Be32(const uint8_t* p) { return (static_cast<uint32_t>(Be16(p)) << 16) | Be16(p + 2); }
+uint16_t Le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t Le32(const uint8_t* p) { return Le16(p) | (static_cast<uint32_t>(Le16(p + 2)) << 16); }
+
+void PutBe16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void PutBe32(std::vector<uint8_t>& out, uint32_t v) {
+    PutBe16(out, v >> 16);
+    PutBe16(out, v & 0xFFFF);
+}
+
+void PutItem(std::vector<uint8_t>& out, uint8_t type, const std::vector<uint8_t>& body) {
+    out.push_back(type);
+    out.push_back(0);
+    PutBe16(out, static_cast<uint32_t>(body.size()));
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+void PutCommandElement(std::vector<uint8_t>& out, uint16_t element, const std::string& value) {
+    std::string padded = value;
+    if (padded.size() % 2 != 0) {
+        padded.push_back('\0');
+    }
+    uint8_t header[8] = {0, 0, static_cast<uint8_t>(element), static_cast<uint8_t>(element >> 8)};
+    uint32_t length = static_cast<uint32_t>(padded.size());
+    for (int i = 0; i < 4; ++i) {
+        header[4 + i] = static_cast<uint8_t>(length >> (8 * i));
+    }
+    out.insert(out.end(), header, header + 8);
+    out.insert(out.end(), padded.begin(), padded.end());
+}
+
+void PutCommandUs(std::vector<uint8_t>& out, uint16_t element, uint16_t value) {
+    std::string bytes{static_cast<char>(value & 0xFF), static_cast<char>(value >> 8)};
+    PutCommandElement(out, element, bytes);
+}
+
+std::string TrimUid(const uint8_t* data, size_t size) {
+    std::string value(reinterpret_cast<const char*>(data), size);
+    while (!value.empty() && (value.back() == '\0' || value.back() == ' ')) {
+        value.pop_back();
+    }
+    return value;
+}
+
+/**
+ * @brief Minimal Storage SCP for one association at a time
+ */
+class StandInScp {
+public:
+    /// Responses are held until this many requests are outstanding (or 200 ms pass)
+    uint32_t hold_until = 1;
+    /// The first fail_first requests are answered 0xA700 (out of resources)
+    uint32_t fail_first = 0;
+    /// Held responses are sent as PDVs of a single P-DATA-TF
+    bool batch_responses = false;
+
+    bool Listen() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t length = sizeof(addr);
+        if (listen_fd_ < 0 || bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            listen(listen_fd_, 4) != 0 ||
+            getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &length) != 0) {
+            return false;
+        }
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { Run(); });
+        return true;
+    }
+
+    ~StandInScp() {
+        stop_ = true;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+        }
+    }
+
+    uint16_t Port() const { return port_; }
+    uint32_t MaxOutstanding() const { return max_outstanding_; }
+    uint32_t Associations() const { return associations_; }
+    uint32_t Requests() const { return requests_; }
+
+    std::map<std::string, std::vector<uint8_t>> Datasets() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return datasets_;
+    }
+
+private:
+    struct Pending {
+        uint16_t message_id;
+        std::string sop_class;
+        std::string sop_instance;
+    };
+
+    void Run() {
+        while (!stop_) {
+            pollfd pfd{listen_fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) {
+                continue;
+            }
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd >= 0) {
+                ++associations_;
+                Serve(fd);
+                close(fd);
+            }
+        }
+    }
+
+    bool ReadExact(int fd, uint8_t* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = recv(fd, data, size, 0);
+            if (n <= 0) {
+                return false;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool ReadPdu(int fd, uint8_t& type, std::vector<uint8_t>& body) {
+        uint8_t header[6];
+        if (!ReadExact(fd, header, 6)) {
+            return false;
+        }
+        type = header[0];
+        body.resize(Be32(header + 2));
+        return ReadExact(fd, body.data(), body.size());
+    }
+
+    void SendAll(int fd, const std::vector<uint8_t>& data) {
+        send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    }
+
+    bool Associate(int fd) {
+        uint8_t type = 0;
+        std::vector<uint8_t> rq;
+        if (!ReadPdu(fd, type, rq) || type != 0x01 || rq.size() < 68) {
+            return false;
+        }
+        std::vector<uint8_t> body(rq.begin(), rq.begin() + 68);   // Echo AE titles
+        std::vector<uint8_t> app_context;
+        std::vector<uint8_t> contexts;
+        uint16_t async_invoked = 1;
+        size_t pos = 68;
+        while (pos + 4 <= rq.size()) {
+            uint8_t item = rq[pos];
+            size_t length = Be16(&rq[pos + 2]);
+            const uint8_t* value = &rq[pos + 4];
+            if (item == 0x10) {
+                app_context.assign(value, value + length);
+            } else if (item == 0x20) {
+                // Accept with the (single) proposed transfer syntax
+                std::vector<uint8_t> accepted = {value[0], 0, 0, 0};
+                size_t sub = 4;
+                while (sub + 4 <= length) {
+                    size_t sub_length = Be16(value + sub + 2);
+                    if (value[sub] == 0x40) {
+                        PutItem(accepted, 0x40,
+                                std::vector<uint8_t>(value + sub + 4, value + sub + 4 + sub_length));
+                    }
+                    sub += 4 + sub_length;
+                }
+                PutItem(contexts, 0x21, accepted);
+            } else if (item == 0x50) {
+                size_t sub = 0;
+                while (sub + 4 <= length) {
+                    size_t sub_length = Be16(value + sub + 2);
+                    if (value[sub] == 0x53 && sub_length == 4) {
+                        async_invoked = Be16(value + sub + 4);
+                    }
+                    sub += 4 + sub_length;
+                }
+            }
+            pos += 4 + length;
+        }
+        PutItem(body, 0x10, app_context);
+        body.insert(body.end(), contexts.begin(), contexts.end());
+
+        std::vector<uint8_t> max_length;
+        PutBe32(max_length, kScpMaxPdu);
+        std::vector<uint8_t> async;
+        PutBe16(async, async_invoked);
+        PutBe16(async, 1);
+        std::vector<uint8_t> info;
+        PutItem(info, 0x51, max_length);
+        PutItem(info, 0x53, async);
+        PutItem(body, 0x50, info);
+
+        std::vector<uint8_t> ac = {0x02, 0};
+        PutBe32(ac, static_cast<uint32_t>(body.size()));
+        ac.insert(ac.end(), body.begin(), body.end());
+        SendAll(fd, ac);
+        return true;
+    }
+
+    void Respond(int fd, std::vector<Pending>& pending) {
+        std::vector<uint8_t> pdvs;
+        for (const Pending& request : pending) {
+            uint16_t status = 0x0000;
+            if (fail_first > 0) {
+                --fail_first;
+                status = 0xA700;
+            }
+            std::vector<uint8_t> elements;
+            PutCommandElement(elements, 0x0002, request.sop_class);
+            PutCommandUs(elements, 0x0100, 0x8001);
+            PutCommandUs(elements, 0x0120, request.message_id);
+            PutCommandUs(elements, 0x0800, 0x0101);
+            PutCommandUs(elements, 0x0900, status);
+            PutCommandElement(elements, 0x1000, request.sop_instance);
+            std::vector<uint8_t> command;
+            std::string group_length(4, '\0');
+            for (int i = 0; i < 4; ++i) {
+                group_length[i] = static_cast<char>(elements.size() >> (8 * i));
+            }
+            PutCommandElement(command, 0x0000, group_length);
+            command.insert(command.end(), elements.begin(), elements.end());
+
+            PutBe32(pdvs, static_cast<uint32_t>(command.size() + 2));
+            pdvs.push_back(1);      // Context id (unchecked by the SCU)
+            pdvs.push_back(0x03);   // Command, last
+            pdvs.insert(pdvs.end(), command.begin(), command.end());
+            if (!batch_responses) {
+                SendPData(fd, pdvs);
+            }
+        }
+        if (batch_responses && !pdvs.empty()) {
+            SendPData(fd, pdvs);
+        }
+        pending.clear();
+    }
+
+    /// Sends pdvs as one P-DATA-TF and clears them
+    void SendPData(int fd, std::vector<uint8_t>& pdvs) {
+        std::vector<uint8_t> pdu = {0x04, 0};
+        PutBe32(pdu, static_cast<uint32_t>(pdvs.size()));
+        pdu.insert(pdu.end(), pdvs.begin(), pdvs.end());
+        SendAll(fd, pdu);
+        pdvs.clear();
+    }
+
+    void Serve(int fd) {
+        if (!Associate(fd)) {
+            return;
+        }
+        std::vector<Pending> pending;
+        std::vector<uint8_t> command;
+        std::vector<uint8_t> dataset;
+        Pending current{};
+        for (;;) {
+            pollfd pfd{fd, POLLIN, 0};
+            if (poll(&pfd, 1, 200) == 0) {
+                Respond(fd, pending);   // Hold timeout
+                if (stop_) {
+                    return;
+                }
+                continue;
+            }
+            uint8_t type = 0;
+            std::vector<uint8_t> body;
+            if (!ReadPdu(fd, type, body)) {
+                return;
+            }
+            if (type == 0x05) {
+                Respond(fd, pending);
+                SendAll(fd, {0x06, 0, 0, 0, 0, 4, 0, 0, 0, 0});
+                return;
+            }
+            if (type != 0x04) {
+                return;
+            }
+            size_t pos = 0;
+            while (pos + 6 <= body.size()) {
+                uint32_t length = Be32(&body[pos]);
+                uint8_t control = body[pos + 5];
+                const uint8_t* data = &body[pos + 6];
+                size_t data_bytes = length - 2;
+                pos += 4 + length;
+                if (control & 0x01) {
+                    command.insert(command.end(), data, data + data_bytes);
+                    if (control & 0x02) {
+                        // Implicit VR LE command set
+                        for (size_t c = 0; c + 8 <= command.size();) {
+                            uint16_t element = Le16(&command[c + 2]);
+                            uint32_t value_length = Le32(&command[c + 4]);
+                            const uint8_t* value = &command[c + 8];
+                            if (element == 0x0002) current.sop_class = TrimUid(value, value_length);
+                            if (element == 0x0110) current.message_id = Le16(value);
+                            if (element == 0x1000) current.sop_instance = TrimUid(value, value_length);
+                            c += 8 + value_length;
+                        }
+                        command.clear();
+                    }
+                } else {
+                    dataset.insert(dataset.end(), data, data + data_bytes);
+                    if (control & 0x02) {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            datasets_[current.sop_instance] = std::move(dataset);
+                        }
+                        dataset.clear();
+                        pending.push_back(current);
+                        ++requests_;
+                        max_outstanding_ = std::max<uint32_t>(max_outstanding_,
+                                                              static_cast<uint32_t>(pending.size()));
+                        if (pending.size() >= hold_until) {
+                            Respond(fd, pending);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint32_t> max_outstanding_{0};
+    std::atomic<uint32_t> associations_{0};
+    std::atomic<uint32_t> requests_{0};
+    mutable std::mutex mutex_;
+    std::map<std::string, std::vector<uint8_t>> datasets_;
+};
+
+/// A loopback port with nothing listening
+uint16_t UnusedPort() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(addr);
+    bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+}
+
+/// Dataset bytes of a Part-10 file (after the file meta group)
+std::vector<uint8_t> DatasetOf(const std::vector<uint8_t>& file) {
+    size_t offset = 132 + 12 + Le32(&file[132 + 8]);
+    return std::vector<uint8_t>(file.begin() + static_cast<std::ptrdiff_t>(offset), file.end());
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Fixture with a private queue directory and test images
+ */
+class DicomStoreScuTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() /
+               ("hnvue_store_" + std::to_string(hnvue::infra::WallClockNowUs()));
+        fs::create_directories(dir_ / "images");
+        config_.queue_directory = (dir_ / "queue").string();
+        config_.initial_backoff_ms = 20;
+        config_.max_backoff_ms = 100;
+        config_.connect_timeout_ms = 1000;
+        config_.response_timeout_ms = 2000;
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    /// Writes a 200x100 DX image (40 KB of pixels: several PDUs at kScpMaxPdu)
+    std::string MakeImage(int index) {
+        std::vector<uint16_t> pixels(200 * 100);
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint16_t>(i * 7 + index);
+        }
+        ImageBuffer image;
+        image.width = 200;
+        image.height = 100;
+        image.stride = 400;
+        image.data = pixels.data();
+        DicomImageRequest request;
+        request.sop_instance_uid = "1.2.410.200001.7." + std::to_string(index);
+        std::string path = (dir_ / "images" / (std::to_string(index) + ".dcm")).string();
+        DicomPart10Writer writer;
+        EXPECT_EQ(writer.Write(path, image, request), DicomResult::DICOM_OK);
+        return path;
+    }
+
+    DicomDestination Destination(uint16_t port, uint32_t window) const {
+        DicomDestination destination;
+        destination.name = "pacs";
+        destination.host = "127.0.0.1";
+        destination.port = port;
+        destination.called_ae = "STANDIN";
+        destination.async_window = window;
+        return destination;
+    }
+
+    fs::path dir_;
+    StoreScuConfig config_;
+};
+
+// =============================================================================
+// Pipelining
+// =============================================================================
+
+TEST_F(DicomStoreScuTest, FillsAsyncWindowAndStreamsDatasets) {
+    StandInScp scp;
+    scp.hold_until = 4;
+    ASSERT_TRUE(scp.Listen());
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        paths.push_back(MakeImage(i));
+    }
+
+    DicomStoreScu scu(config_);
+    std::mutex results_mutex;
+    std::vector<StoreJobResult> results;
+    scu.SetCallback([&](const StoreJobResult& result) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.push_back(result);
+    });
+    ASSERT_EQ(scu.AddDestination(Destination(scp.Port(), 4)), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    for (const std::string& path : paths) {
+        ASSERT_EQ(scu.Enqueue("pacs", path), DicomResult::DICOM_OK);
+    }
+    ASSERT_TRUE(scu.Flush(std::chrono::seconds(10)));
+
+    // Four requests outstanding before the SCP answered: the window was used
+    EXPECT_EQ(scp.MaxOutstanding(), 4u);
+    EXPECT_EQ(scp.Associations(), 1u);   // Association reused
+
+    auto datasets = scp.Datasets();
+    ASSERT_EQ(datasets.size(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        auto it = datasets.find("1.2.410.200001.7." + std::to_string(i));
+        ASSERT_NE(it, datasets.end());
+        EXPECT_EQ(it->second, DatasetOf(ReadFile(paths[static_cast<size_t>(i)])));
+    }
+
+    std::lock_guard<std::mutex> lock(results_mutex);
+    ASSERT_EQ(results.size(), 8u);
+    for (const StoreJobResult& result : results) {
+        EXPECT_EQ(result.result, DicomResult::DICOM_OK);
+        EXPECT_EQ(result.attempts, 1u);
+        EXPECT_EQ(result.destination, "pacs");
+    }
+
+    std::vector<StoreDestinationStats> stats = scu.GetStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].images_sent, 8u);
+    EXPECT_EQ(stats[0].pending, 0u);
+    EXPECT_EQ(stats[0].associations_opened, 1u);
+    EXPECT_GT(stats[0].images_per_s, 0.0);
+    EXPECT_GT(stats[0].avg_latency_us, 0);
+    EXPECT_GE(stats[0].max_latency_us, stats[0].avg_latency_us);
+}
+
+TEST_F(DicomStoreScuTest, ReadsEveryResponseOfABatchedPdu) {
+    StandInScp scp;
+    scp.hold_until = 2;
+    scp.batch_responses = true;
+    ASSERT_TRUE(scp.Listen());
+
+    DicomStoreScu scu(config_);
+    std::mutex results_mutex;
+    std::vector<StoreJobResult> results;
+    scu.SetCallback([&](const StoreJobResult& result) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.push_back(result);
+    });
+    ASSERT_EQ(scu.AddDestination(Destination(scp.Port(), 2)), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(scu.Enqueue("pacs", MakeImage(i)), DicomResult::DICOM_OK);
+    }
+    ASSERT_TRUE(scu.Flush(std::chrono::seconds(10)));
+
+    // Two responses per PDU, none lost: no timeout, no retransmission
+    EXPECT_EQ(scp.MaxOutstanding(), 2u);
+    EXPECT_EQ(scp.Requests(), 4u);
+    EXPECT_EQ(scp.Associations(), 1u);
+
+    std::lock_guard<std::mutex> lock(results_mutex);
+    ASSERT_EQ(results.size(), 4u);
+    for (const StoreJobResult& result : results) {
+        EXPECT_EQ(result.result, DicomResult::DICOM_OK);
+        EXPECT_EQ(result.attempts, 1u);
+    }
+}
+
+// =============================================================================
+// Retry
+// =============================================================================
+
+TEST_F(DicomStoreScuTest, RetriesTransientStatusWithBackoff) {
+    StandInScp scp;
+    scp.fail_first = 1;
+    ASSERT_TRUE(scp.Listen());
+
+    DicomStoreScu scu(config_);
+    std::vector<StoreJobResult> results;
+    std::mutex results_mutex;
+    scu.SetCallback([&](const StoreJobResult& result) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.push_back(result);
+    });
+    ASSERT_EQ(scu.AddDestination(Destination(scp.Port(), 2)), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Enqueue("pacs", MakeImage(1)), DicomResult::DICOM_OK);
+    ASSERT_TRUE(scu.Flush(std::chrono::seconds(10)));
+
+    std::lock_guard<std::mutex> lock(results_mutex);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].result, DicomResult::DICOM_OK);
+    EXPECT_EQ(results[0].attempts, 2u);
+    EXPECT_EQ(scp.Requests(), 2u);
+    EXPECT_EQ(scu.GetStats()[0].retries, 1u);
+}
+
+TEST_F(DicomStoreScuTest, FailsUnreadableFileWithoutRetry) {
+    StandInScp scp;
+    ASSERT_TRUE(scp.Listen());
+
+    std::string bogus = (dir_ / "images" / "not-dicom.bin").string();
+    std::ofstream(bogus) << "plain text";
+
+    DicomStoreScu scu(config_);
+    StoreJobResult last;
+    scu.SetCallback([&](const StoreJobResult& result) { last = result; });
+    ASSERT_EQ(scu.AddDestination(Destination(scp.Port(), 2)), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Enqueue("pacs", bogus), DicomResult::DICOM_OK);
+    ASSERT_TRUE(scu.Flush(std::chrono::seconds(10)));
+    scu.Stop();
+
+    EXPECT_EQ(last.result, DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(last.attempts, 1u);
+    EXPECT_EQ(scp.Requests(), 0u);
+    EXPECT_EQ(scu.GetStats()[0].images_failed, 1u);
+}
+
+// =============================================================================
+// Crash-Safe Queue
+// =============================================================================
+
+TEST_F(DicomStoreScuTest, JournaledJobsResumeAfterRestart) {
+    std::vector<std::string> paths = {MakeImage(10), MakeImage(11), MakeImage(12)};
+    config_.max_attempts = 100;
+    {
+        // Destination down: jobs stay queued when the SCU stops
+        DicomStoreScu scu(config_);
+        ASSERT_EQ(scu.AddDestination(Destination(UnusedPort(), 4)), DicomResult::DICOM_OK);
+        ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+        for (const std::string& path : paths) {
+            ASSERT_EQ(scu.Enqueue("pacs", path), DicomResult::DICOM_OK);
+        }
+        EXPECT_FALSE(scu.Flush(std::chrono::milliseconds(200)));
+        EXPECT_EQ(scu.GetStats()[0].images_sent, 0u);
+    }
+
+    StandInScp scp;
+    ASSERT_TRUE(scp.Listen());
+    DicomStoreScu scu(config_);
+    ASSERT_EQ(scu.AddDestination(Destination(scp.Port(), 4)), DicomResult::DICOM_OK);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    ASSERT_TRUE(scu.Flush(std::chrono::seconds(10)));
+    EXPECT_EQ(scu.GetStats()[0].images_sent, 3u);
+    EXPECT_EQ(scp.Datasets().size(), 3u);
+    scu.Stop();
+
+    // Completed jobs are not sent again
+    DicomStoreScu again(config_);
+    ASSERT_EQ(again.AddDestination(Destination(scp.Port(), 4)), DicomResult::DICOM_OK);
+    ASSERT_EQ(again.Start(), DicomResult::DICOM_OK);
+    EXPECT_EQ(again.GetStats()[0].pending, 0u);
+}
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST_F(DicomStoreScuTest, ValidatesDestinationsAndJobs) {
+    DicomStoreScu scu(config_);
+    DicomDestination destination = Destination(104, 4);
+    EXPECT_EQ(scu.Enqueue("pacs", "x.dcm"), DicomResult::DICOM_ERR_NOT_RUNNING);
+
+    DicomDestination bad = destination;
+    bad.called_ae = "THIS_AE_TITLE_IS_TOO_LONG";
+    EXPECT_EQ(scu.AddDestination(bad), DicomResult::DICOM_ERR_PARAM);
+    bad = destination;
+    bad.name = "two words";
+    EXPECT_EQ(scu.AddDestination(bad), DicomResult::DICOM_ERR_PARAM);
+    bad = destination;
+    bad.async_window = 0;
+    EXPECT_EQ(scu.AddDestination(bad), DicomResult::DICOM_ERR_PARAM);
+
+    ASSERT_EQ(scu.AddDestination(destination), DicomResult::DICOM_OK);
+    EXPECT_EQ(scu.AddDestination(destination), DicomResult::DICOM_ERR_PARAM);
+    ASSERT_EQ(scu.Start(), DicomResult::DICOM_OK);
+    EXPECT_EQ(scu.AddDestination(Destination(105, 1)), DicomResult::DICOM_ERR_NOT_SUPPORTED);
+    EXPECT_EQ(scu.Enqueue("unknown", "x.dcm"), DicomResult::DICOM_ERR_PARAM);
+    EXPECT_EQ(scu.Enqueue("pacs", ""), DicomResult::DICOM_ERR_PARAM);
+}
+
+#endif // _WIN32
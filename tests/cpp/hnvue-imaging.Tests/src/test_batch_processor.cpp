@@ -0,0 +1,305 @@
+/**
+ * @file test_batch_processor.cpp
+ * @brief Unit tests for parallel batch re-processing (BatchProcessor)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Batch image re-processing tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Every frame x config job is delivered exactly once with its own output
+ * - Each stored frame is loaded once, whatever the number of configs
+ * - Load and engine failures are reported per job
+ * - Cancel() stops starting new jobs
+ * - Throughput scales with the worker count
+ * - Initialisation failures and empty batches
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/BatchProcessor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+constexpr uint32_t kWidth = 32;
+constexpr uint32_t kHeight = 16;
+constexpr size_t kScratchFloats = 64 * 1024;   ///< 256 KiB: stays in per-core cache
+
+/**
+ * @brief Engine adding config.level to every pixel
+ *
+ * Each frame first costs work_passes CPU-bound sweeps over a private
+ * scratch plane, so workers scale only with the cores that run them.
+ */
+class FakeEngine : public IImageProcessingEngine {
+public:
+    FakeEngine(uint32_t work_passes, std::atomic<uint32_t>& init_threads)
+        : work_passes_(work_passes), init_threads_(init_threads), scratch_(kScratchFloats, 1.0f) {}
+
+    bool Initialize(const EngineConfig& config) override {
+        init_threads_ = config.num_threads;
+        return true;
+    }
+    void Shutdown() override {}
+
+    bool ApplyOffsetCorrection(ImageBuffer&, const CalibrationData&) override { return true; }
+    bool ApplyGainCorrection(ImageBuffer&, const CalibrationData&) override { return true; }
+    bool ApplyDefectPixelMap(ImageBuffer&, const DefectMap&) override { return true; }
+    bool ApplyScatterCorrection(ImageBuffer&, const ScatterParams&) override { return true; }
+    bool ApplyWindowLevel(ImageBuffer&, float, float) override { return true; }
+    bool ApplyNoiseReduction(ImageBuffer&, const NoiseReductionConfig&) override { return true; }
+    bool ApplyFlattening(ImageBuffer&, const FlatteningConfig&) override { return true; }
+
+    bool ProcessFrame(ImageBuffer& frame, const ProcessingConfig& config) override {
+        float accumulator = 0.0f;
+        for (uint32_t pass = 0; pass < work_passes_; ++pass) {
+            for (float& value : scratch_) {
+                accumulator = accumulator * 0.999f + value;
+                value = accumulator * 0.001f;
+            }
+        }
+        sink_ = accumulator;
+        if (config.window <= 0.0f) {
+            error_.error_code = ImagingError::IMAGING_ERR_PARAM;
+            error_.failed_stage = "WindowLevel";
+            return false;
+        }
+        for (uint32_t y = 0; y < frame.height; ++y) {
+            uint16_t* row = reinterpret_cast<uint16_t*>(
+                reinterpret_cast<uint8_t*>(frame.data) + y * frame.stride);
+            for (uint32_t x = 0; x < frame.width; ++x) {
+                row[x] = static_cast<uint16_t>(row[x] + config.level);
+            }
+        }
+        error_ = EngineError{};
+        return true;
+    }
+
+    EngineInfo GetEngineInfo() const override { return EngineInfo{}; }
+    EngineError GetLastError() const override { return error_; }
+    StageTiming GetLastTiming() const override { return StageTiming{}; }
+
+private:
+    uint32_t work_passes_;
+    std::atomic<uint32_t>& init_threads_;
+    std::vector<float> scratch_;
+    volatile float sink_ = 0.0f;    ///< Keeps the sweeps from being optimised out
+    EngineError error_;
+};
+
+class BatchProcessorTest : public ::testing::Test {
+protected:
+    BatchProcessor::EngineCreator Engines(uint32_t work_passes = 0) {
+        return [this, work_passes]() {
+            return std::make_shared<FakeEngine>(work_passes, init_threads_);
+        };
+    }
+
+    /// Stored frame f has every pixel set to f * 100
+    BatchFrameLoader Loader(size_t failing_frame = SIZE_MAX) {
+        return [this, failing_frame](size_t index, PooledImageBuffer& out) {
+            ++loads_[index];
+            if (index == failing_frame || !AcquirePooledImageBuffer(kWidth, kHeight, out)) {
+                return false;
+            }
+            for (uint32_t y = 0; y < kHeight; ++y) {
+                uint16_t* row = reinterpret_cast<uint16_t*>(
+                    reinterpret_cast<uint8_t*>(out.view.data) + y * out.view.stride);
+                std::fill(row, row + kWidth, static_cast<uint16_t>(index * 100));
+            }
+            out.view.frame_id = index;
+            return true;
+        };
+    }
+
+    static std::vector<ProcessingConfig> Configs(size_t count) {
+        std::vector<ProcessingConfig> configs(count);
+        for (size_t c = 0; c < count; ++c) {
+            configs[c].window = 1000.0f;
+            configs[c].level = static_cast<float>(c + 1);
+        }
+        return configs;
+    }
+
+    std::atomic<uint32_t> init_threads_{0};      ///< num_threads seen by Initialize()
+    std::vector<std::atomic<int>> loads_ = std::vector<std::atomic<int>>(64);  ///< Loads per frame
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// Job Delivery
+// =============================================================================
+
+TEST_F(BatchProcessorTest, DeliversEveryJobOnceWithItsOwnOutput) {
+    BatchProcessor processor(Engines());
+    EngineConfig config;
+    ASSERT_TRUE(processor.Initialize(config, 4));
+    EXPECT_EQ(processor.WorkerCount(), 4u);
+    EXPECT_EQ(init_threads_.load(), 1u);
+
+    constexpr size_t kFrames = 6;
+    constexpr size_t kConfigs = 3;
+
+    std::set<std::pair<size_t, size_t>> seen;
+    BatchStats stats = processor.ProcessBatch(
+        kFrames, Loader(), Configs(kConfigs), [&](BatchResult&& result) {
+            EXPECT_TRUE(result.success);
+            EXPECT_TRUE(seen.emplace(result.frame_index, result.config_index).second);
+            ASSERT_TRUE(result.frame);
+            EXPECT_EQ(result.frame.view.frame_id, result.frame_index);
+            const uint16_t expected =
+                static_cast<uint16_t>(result.frame_index * 100 + result.config_index + 1);
+            EXPECT_EQ(result.frame.view.data[0], expected);
+            EXPECT_EQ(result.frame.view.data[kWidth - 1], expected);
+        });
+
+    EXPECT_EQ(seen.size(), kFrames * kConfigs);
+    EXPECT_EQ(stats.jobs_total, kFrames * kConfigs);
+    EXPECT_EQ(stats.jobs_succeeded, kFrames * kConfigs);
+    EXPECT_EQ(stats.jobs_failed, 0u);
+    EXPECT_EQ(stats.jobs_cancelled, 0u);
+    EXPECT_EQ(stats.frames_loaded, kFrames);
+    EXPECT_EQ(stats.workers, 4u);
+    for (size_t f = 0; f < kFrames; ++f) {
+        EXPECT_EQ(loads_[f].load(), 1) << "frame " << f;
+    }
+}
+
+TEST_F(BatchProcessorTest, LoadFailureFailsEveryConfigOfThatFrame) {
+    BatchProcessor processor(Engines());
+    ASSERT_TRUE(processor.Initialize(EngineConfig{}, 2));
+
+    size_t failed = 0;
+    BatchStats stats = processor.ProcessBatch(
+        4, Loader(2), Configs(2), [&](BatchResult&& result) {
+            if (result.frame_index == 2) {
+                EXPECT_FALSE(result.success);
+                EXPECT_FALSE(result.frame);
+                EXPECT_EQ(result.error.error_code, ImagingError::IMAGING_ERR_PARAM);
+                ++failed;
+            } else {
+                EXPECT_TRUE(result.success);
+            }
+        });
+
+    EXPECT_EQ(failed, 2u);
+    EXPECT_EQ(stats.jobs_failed, 2u);
+    EXPECT_EQ(stats.jobs_succeeded, 6u);
+    EXPECT_EQ(stats.frames_loaded, 3u);
+}
+
+TEST_F(BatchProcessorTest, EngineFailureCarriesEngineError) {
+    BatchProcessor processor(Engines());
+    ASSERT_TRUE(processor.Initialize(EngineConfig{}, 2));
+
+    std::vector<ProcessingConfig> configs = Configs(2);
+    configs[1].window = 0.0f;
+
+    BatchStats stats = processor.ProcessBatch(
+        3, Loader(), configs, [&](BatchResult&& result) {
+            EXPECT_EQ(result.success, result.config_index == 0);
+            if (result.config_index == 1) {
+                EXPECT_EQ(result.error.failed_stage, "WindowLevel");
+                EXPECT_FALSE(result.frame);
+            }
+        });
+
+    EXPECT_EQ(stats.jobs_succeeded, 3u);
+    EXPECT_EQ(stats.jobs_failed, 3u);
+}
+
+TEST_F(BatchProcessorTest, CancelStopsStartingJobs) {
+    BatchProcessor processor(Engines(50));
+    ASSERT_TRUE(processor.Initialize(EngineConfig{}, 2));
+
+    size_t delivered = 0;
+    BatchStats stats = processor.ProcessBatch(
+        20, Loader(), Configs(2), [&](BatchResult&&) {
+            if (++delivered == 1) {
+                processor.Cancel();
+            }
+        });
+
+    EXPECT_GT(stats.jobs_cancelled, 0u);
+    EXPECT_EQ(stats.jobs_succeeded + stats.jobs_failed, delivered);
+    EXPECT_EQ(stats.jobs_succeeded + stats.jobs_failed + stats.jobs_cancelled,
+              stats.jobs_total);
+
+    // The next batch runs normally
+    delivered = 0;
+    stats = processor.ProcessBatch(2, Loader(), Configs(1), [&](BatchResult&&) { ++delivered; });
+    EXPECT_EQ(delivered, 2u);
+    EXPECT_EQ(stats.jobs_cancelled, 0u);
+}
+
+// =============================================================================
+// Throughput
+// =============================================================================
+
+TEST_F(BatchProcessorTest, ThroughputScalesWithWorkers) {
+    if (std::thread::hardware_concurrency() < 4) {
+        GTEST_SKIP() << "Needs 4 hardware threads, have "
+                     << std::thread::hardware_concurrency();
+    }
+    constexpr size_t kFrames = 16;
+    constexpr uint32_t kWorkPasses = 100;
+
+    BatchProcessor serial(Engines(kWorkPasses));
+    ASSERT_TRUE(serial.Initialize(EngineConfig{}, 1));
+    BatchStats one = serial.ProcessBatch(kFrames, Loader(), Configs(1), [](BatchResult&&) {});
+
+    BatchProcessor parallel(Engines(kWorkPasses));
+    ASSERT_TRUE(parallel.Initialize(EngineConfig{}, 4));
+    BatchStats four = parallel.ProcessBatch(kFrames, Loader(), Configs(1), [](BatchResult&&) {});
+
+    ASSERT_EQ(one.jobs_succeeded, kFrames);
+    ASSERT_EQ(four.jobs_succeeded, kFrames);
+    const double speedup = four.ImagesPerSecond() / one.ImagesPerSecond();
+    EXPECT_GT(speedup, 2.5);
+
+    RecordProperty("images_per_second_1_worker", static_cast<int>(one.ImagesPerSecond()));
+    RecordProperty("images_per_second_4_workers", static_cast<int>(four.ImagesPerSecond()));
+    RecordProperty("speedup_4_workers", std::to_string(speedup));
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+TEST_F(BatchProcessorTest, InitializeFailsWhenEngineCannotBeCreated) {
+    BatchProcessor processor([]() { return std::shared_ptr<IImageProcessingEngine>(); });
+    EXPECT_FALSE(processor.Initialize(EngineConfig{}, 2));
+    EXPECT_FALSE(processor.IsInitialized());
+}
+
+TEST_F(BatchProcessorTest, InitializeTwiceFails) {
+    BatchProcessor processor(Engines());
+    ASSERT_TRUE(processor.Initialize(EngineConfig{}, 1));
+    EXPECT_FALSE(processor.Initialize(EngineConfig{}, 1));
+}
+
+TEST_F(BatchProcessorTest, EmptyOrUninitialisedBatchDoesNothing) {
+    BatchProcessor processor(Engines());
+    size_t delivered = 0;
+    auto sink = [&](BatchResult&&) { ++delivered; };
+
+    EXPECT_EQ(processor.ProcessBatch(3, Loader(), Configs(1), sink).jobs_total, 0u);
+
+    ASSERT_TRUE(processor.Initialize(EngineConfig{}, 1));
+    EXPECT_EQ(processor.ProcessBatch(0, Loader(), Configs(1), sink).jobs_total, 0u);
+    EXPECT_EQ(processor.ProcessBatch(3, Loader(), {}, sink).jobs_total, 0u);
+    EXPECT_EQ(delivered, 0u);
+}
@@ -0,0 +1,340 @@
+/**
+ * @file test_calibration_set.cpp
+ * @brief Unit tests for immutable calibration handles
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Calibration data handle tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - CalibrationMap: size/type checks at creation, binned block means
+ * - DefectPlan: compilation (bounds, default interpolation, order,
+ *   duplicates) and binned plans; merging additions into a plan
+ * - CalibrationSet: binding to full and binned geometries, rejection of
+ *   missing, mistyped or mismatched calibration
+ * - CalibrationManager: a held set survives reloads unchanged
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/CalibrationManager.h>
+#include <hnvue/imaging/CalibrationSet.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+std::shared_ptr<const CalibrationMap> MakeMap(CalibrationDataType type,
+                                              uint32_t width, uint32_t height,
+                                              float value) {
+    return CalibrationMap::Create(type, width, height,
+                                  std::vector<float>(static_cast<size_t>(width) * height, value));
+}
+
+DefectPixelEntry Defect(uint32_t x, uint32_t y,
+                        InterpolationMethod method = InterpolationMethod::MEDIAN_3X3) {
+    return {x, y, DefectPixelType::DEAD_PIXEL, method};
+}
+
+/**
+ * @brief Write a dark frame or gain map file filled with value
+ */
+void WriteMapFile(const std::string& path, CalibrationDataType type,
+                  uint32_t width, uint32_t height, float value) {
+    std::vector<float> data(static_cast<size_t>(width) * height, value);
+
+    CalibrationFileHeader header{};
+    const uint8_t magic[] = {'H', 'N', 'C', 0x01};
+    std::memcpy(header.magic, magic, 4);
+    header.format_version = 1;
+    header.data_type = static_cast<uint16_t>(type);
+    header.width = width;
+    header.height = height;
+    header.payload_length = data.size() * sizeof(float);
+
+    // Same checksum as CalibrationManager's placeholder SHA-256
+    uint32_t sum = 0;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    for (size_t i = 0; i < header.payload_length; ++i) {
+        sum = sum * 31 + bytes[i];
+    }
+    std::memcpy(header.checksum, &sum, sizeof(sum));
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()), header.payload_length);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// CalibrationMap
+// =============================================================================
+
+TEST(CalibrationMapTest, CreateRejectsWrongSizeOrType) {
+    EXPECT_EQ(CalibrationMap::Create(CalibrationDataType::DARK_FRAME, 4, 4,
+                                     std::vector<float>(15)), nullptr);
+    EXPECT_EQ(CalibrationMap::Create(CalibrationDataType::DEFECT_MAP, 4, 4,
+                                     std::vector<float>(16)), nullptr);
+    EXPECT_EQ(CalibrationMap::Create(CalibrationDataType::GAIN_MAP, 0, 4,
+                                     std::vector<float>()), nullptr);
+}
+
+TEST(CalibrationMapTest, FullResolutionViewOwnsData) {
+    auto map = CalibrationMap::Create(CalibrationDataType::DARK_FRAME, 4, 2,
+                                      std::vector<float>(8, 7.0f), 0xAB, 42);
+    ASSERT_NE(map, nullptr);
+
+    const CalibrationData& data = map->Data();
+    EXPECT_TRUE(data.valid);
+    EXPECT_EQ(data.type, CalibrationDataType::DARK_FRAME);
+    EXPECT_EQ(data.width, 4u);
+    EXPECT_EQ(data.height, 2u);
+    EXPECT_EQ(data.checksum, 0xABu);
+    EXPECT_EQ(data.acquisition_time_us, 42u);
+    ASSERT_NE(data.data_f32, nullptr);
+    EXPECT_FLOAT_EQ(data.data_f32[7], 7.0f);
+    EXPECT_EQ(map->ForGeometry(4, 2), &data);
+}
+
+TEST(CalibrationMapTest, BinnedVariantsAreBlockMeans) {
+    // 4x4 map: value = column index
+    std::vector<float> coeffs(16);
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+        coeffs[i] = static_cast<float>(i % 4);
+    }
+    auto map = CalibrationMap::Create(CalibrationDataType::GAIN_MAP, 4, 4, std::move(coeffs));
+    ASSERT_NE(map, nullptr);
+
+    const CalibrationData* bin2 = map->ForGeometry(2, 2);
+    ASSERT_NE(bin2, nullptr);
+    EXPECT_EQ(bin2->type, CalibrationDataType::GAIN_MAP);
+    EXPECT_FLOAT_EQ(bin2->data_f32[0], 0.5f);
+    EXPECT_FLOAT_EQ(bin2->data_f32[1], 2.5f);
+    EXPECT_FLOAT_EQ(bin2->data_f32[3], 2.5f);
+
+    const CalibrationData* bin4 = map->ForGeometry(1, 1);
+    ASSERT_NE(bin4, nullptr);
+    EXPECT_FLOAT_EQ(bin4->data_f32[0], 1.5f);
+
+    EXPECT_EQ(map->ForGeometry(3, 3), nullptr);
+}
+
+TEST(CalibrationMapTest, OddSizeBinsDropTrailingPixels) {
+    auto map = MakeMap(CalibrationDataType::DARK_FRAME, 5, 3, 2.0f);
+    ASSERT_NE(map, nullptr);
+    const CalibrationData* bin2 = map->ForGeometry(2, 1);
+    ASSERT_NE(bin2, nullptr);
+    EXPECT_FLOAT_EQ(bin2->data_f32[1], 2.0f);
+    EXPECT_EQ(map->ForGeometry(1, 0), nullptr);  // 4x4 bin of 5x3 is empty
+}
+
+// =============================================================================
+// DefectPlan
+// =============================================================================
+
+TEST(DefectPlanTest, CompilationDropsOutOfBoundsSortsAndDedupes) {
+    auto plan = DefectPlan::Create(8, 8, {
+        Defect(5, 6), Defect(9, 1), Defect(1, 2),
+        Defect(5, 6, InterpolationMethod::NEAREST_NEIGHBOR), Defect(0, 8), Defect(3, 2)});
+    ASSERT_NE(plan, nullptr);
+
+    const DefectMap& map = plan->Map();
+    EXPECT_TRUE(map.valid);
+    ASSERT_EQ(map.count, 3u);
+    EXPECT_EQ(map.pixels[0].x, 1u);
+    EXPECT_EQ(map.pixels[0].y, 2u);
+    EXPECT_EQ(map.pixels[1].x, 3u);
+    EXPECT_EQ(map.pixels[2].y, 6u);
+    // First entry for a pixel wins
+    EXPECT_EQ(map.pixels[2].interpolation, InterpolationMethod::MEDIAN_3X3);
+}
+
+TEST(DefectPlanTest, UnspecifiedInterpolationBecomesBilinear) {
+    auto plan = DefectPlan::Create(4, 4, {Defect(1, 1, InterpolationMethod::INTERP_UNSPECIFIED)});
+    ASSERT_NE(plan, nullptr);
+    ASSERT_EQ(plan->Map().count, 1u);
+    EXPECT_EQ(plan->Map().pixels[0].interpolation, InterpolationMethod::BILINEAR);
+}
+
+TEST(DefectPlanTest, BinnedPlanMarksCoveringPixels) {
+    auto plan = DefectPlan::Create(8, 8, {Defect(0, 0), Defect(1, 1), Defect(6, 3)});
+    ASSERT_NE(plan, nullptr);
+
+    const DefectMap* bin2 = plan->ForGeometry(4, 4);
+    ASSERT_NE(bin2, nullptr);
+    ASSERT_EQ(bin2->count, 2u);
+    EXPECT_EQ(bin2->pixels[0].x, 0u);
+    EXPECT_EQ(bin2->pixels[0].y, 0u);
+    EXPECT_EQ(bin2->pixels[1].x, 3u);
+    EXPECT_EQ(bin2->pixels[1].y, 1u);
+
+    const DefectMap* bin4 = plan->ForGeometry(2, 2);
+    ASSERT_NE(bin4, nullptr);
+    EXPECT_EQ(bin4->count, 2u);
+}
+
+TEST(DefectPlanTest, EmptyPlanIsValid) {
+    auto plan = DefectPlan::Create(4, 4, {});
+    ASSERT_NE(plan, nullptr);
+    EXPECT_TRUE(plan->Map().valid);
+    EXPECT_EQ(plan->Map().count, 0u);
+    EXPECT_EQ(DefectPlan::Create(0, 4, {}), nullptr);
+}
+
+TEST(DefectPlanTest, MergeMatchesRecompilationAndKeepsBase) {
+    const std::vector<DefectPixelEntry> base_pixels = {Defect(5, 6), Defect(1, 2), Defect(6, 3)};
+    const std::vector<DefectPixelEntry> additions = {
+        Defect(7, 7), Defect(5, 6, InterpolationMethod::NEAREST_NEIGHBOR), Defect(0, 0),
+        Defect(9, 1), Defect(2, 2, InterpolationMethod::INTERP_UNSPECIFIED)};
+    auto base = DefectPlan::Create(8, 8, base_pixels, 42);
+    ASSERT_NE(base, nullptr);
+
+    auto merged = DefectPlan::Merge(base, additions);
+    ASSERT_NE(merged, nullptr);
+    EXPECT_EQ(merged->Width(), 8u);
+    EXPECT_EQ(merged->Height(), 8u);
+    EXPECT_EQ(merged->Map().checksum, 42u);
+
+    // Same entries as compiling everything at once, base first
+    std::vector<DefectPixelEntry> all = base_pixels;
+    all.insert(all.end(), additions.begin(), additions.end());
+    auto rebuilt = DefectPlan::Create(8, 8, all);
+    for (uint32_t size : {8u, 4u, 2u}) {
+        const DefectMap* m = merged->ForGeometry(size, size);
+        const DefectMap* r = rebuilt->ForGeometry(size, size);
+        ASSERT_NE(m, nullptr);
+        ASSERT_NE(r, nullptr);
+        ASSERT_EQ(m->count, r->count) << size;
+        for (uint32_t i = 0; i < m->count; ++i) {
+            EXPECT_EQ(m->pixels[i].x, r->pixels[i].x);
+            EXPECT_EQ(m->pixels[i].y, r->pixels[i].y);
+            EXPECT_EQ(m->pixels[i].interpolation, r->pixels[i].interpolation);
+        }
+    }
+    ASSERT_EQ(merged->Map().count, 6u);
+    EXPECT_EQ(merged->Map().pixels[4].interpolation, InterpolationMethod::MEDIAN_3X3);  // (5, 6)
+
+    // The base plan is unchanged
+    EXPECT_EQ(base->Map().count, 3u);
+    EXPECT_EQ(DefectPlan::Merge(nullptr, additions), nullptr);
+}
+
+// =============================================================================
+// CalibrationSet
+// =============================================================================
+
+TEST(CalibrationSetTest, BindResolvesFullAndBinnedViews) {
+    CalibrationSet set(MakeMap(CalibrationDataType::DARK_FRAME, 16, 16, 1.0f),
+                       MakeMap(CalibrationDataType::GAIN_MAP, 16, 16, 1.0f),
+                       DefectPlan::Create(16, 16, {Defect(4, 4)}));
+
+    CalibrationBinding full;
+    ASSERT_TRUE(set.Bind(16, 16, full));
+    EXPECT_EQ(full.dark, &set.Dark()->Data());
+    EXPECT_EQ(full.gain, &set.Gain()->Data());
+    EXPECT_EQ(full.defect_map, &set.Defects()->Map());
+
+    CalibrationBinding binned;
+    ASSERT_TRUE(set.Bind(4, 4, binned));
+    EXPECT_EQ(binned.dark->width, 4u);
+    EXPECT_EQ(binned.gain->height, 4u);
+    EXPECT_EQ(binned.defect_map->pixels[0].x, 1u);
+}
+
+TEST(CalibrationSetTest, BindRejectsMissingOrMistypedCalibration) {
+    auto dark = MakeMap(CalibrationDataType::DARK_FRAME, 8, 8, 0.0f);
+    auto gain = MakeMap(CalibrationDataType::GAIN_MAP, 8, 8, 1.0f);
+    CalibrationBinding binding;
+
+    EXPECT_FALSE(CalibrationSet().Bind(8, 8, binding));
+    EXPECT_FALSE(CalibrationSet(dark, nullptr, nullptr).Bind(8, 8, binding));
+    EXPECT_FALSE(CalibrationSet(gain, dark, nullptr).Bind(8, 8, binding));
+    EXPECT_EQ(binding.dark, nullptr);
+
+    // Defects are optional
+    ASSERT_TRUE(CalibrationSet(dark, gain, nullptr).Bind(8, 8, binding));
+    EXPECT_EQ(binding.defect_map, nullptr);
+}
+
+TEST(CalibrationSetTest, BindRejectsMismatchedGeometry) {
+    CalibrationBinding binding;
+    CalibrationSet set(MakeMap(CalibrationDataType::DARK_FRAME, 8, 8, 0.0f),
+                       MakeMap(CalibrationDataType::GAIN_MAP, 16, 16, 1.0f),
+                       nullptr);
+    EXPECT_FALSE(set.Bind(8, 8, binding));
+    EXPECT_FALSE(set.Bind(16, 16, binding));
+    EXPECT_FALSE(set.Bind(7, 8, binding));
+
+    CalibrationSet defects_off(MakeMap(CalibrationDataType::DARK_FRAME, 8, 8, 0.0f),
+                               MakeMap(CalibrationDataType::GAIN_MAP, 8, 8, 1.0f),
+                               DefectPlan::Create(16, 16, {}));
+    EXPECT_FALSE(defects_off.Bind(8, 8, binding));
+}
+
+// =============================================================================
+// CalibrationManager
+// =============================================================================
+
+class CalibrationSetManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::string Path(const std::string& name) const { return dir_ + "/" + name; }
+
+    std::string dir_ = "test_calib_set_data";
+    CalibrationManager manager_{0};  // No age limit
+};
+
+TEST_F(CalibrationSetManagerTest, HeldSetSurvivesReload) {
+    WriteMapFile(Path("dark1.calib"), CalibrationDataType::DARK_FRAME, 8, 8, 10.0f);
+    WriteMapFile(Path("gain.calib"), CalibrationDataType::GAIN_MAP, 8, 8, 1.0f);
+    ASSERT_TRUE(manager_.HotReload(CalibrationDataType::DARK_FRAME, Path("dark1.calib")));
+    ASSERT_TRUE(manager_.HotReload(CalibrationDataType::GAIN_MAP, Path("gain.calib")));
+
+    CalibrationSetHandle in_flight = manager_.GetCalibrationSet();
+    CalibrationBinding binding;
+    ASSERT_TRUE(in_flight->Bind(8, 8, binding));
+
+    WriteMapFile(Path("dark2.calib"), CalibrationDataType::DARK_FRAME, 8, 8, 20.0f);
+    ASSERT_TRUE(manager_.HotReload(CalibrationDataType::DARK_FRAME, Path("dark2.calib")));
+
+    // The held set and its bound views are untouched
+    EXPECT_FLOAT_EQ(binding.dark->data_f32[0], 10.0f);
+    EXPECT_FLOAT_EQ(in_flight->Dark()->Data().data_f32[63], 10.0f);
+
+    // New sets see the reload and share the unchanged gain map
+    CalibrationSetHandle next = manager_.GetCalibrationSet();
+    EXPECT_NE(next, in_flight);
+    EXPECT_FLOAT_EQ(next->Dark()->Data().data_f32[0], 20.0f);
+    EXPECT_EQ(next->Gain(), in_flight->Gain());
+    EXPECT_EQ(manager_.GetCalibration(CalibrationDataType::DARK_FRAME), &next->Dark()->Data());
+}
+
+TEST_F(CalibrationSetManagerTest, FailedReloadKeepsActiveSet) {
+    WriteMapFile(Path("dark.calib"), CalibrationDataType::DARK_FRAME, 8, 8, 10.0f);
+    ASSERT_TRUE(manager_.HotReload(CalibrationDataType::DARK_FRAME, Path("dark.calib")));
+    CalibrationSetHandle before = manager_.GetCalibrationSet();
+
+    EXPECT_FALSE(manager_.HotReload(CalibrationDataType::DARK_FRAME, Path("missing.calib")));
+    EXPECT_EQ(manager_.GetCalibrationSet(), before);
+}
+
+TEST_F(CalibrationSetManagerTest, EmptyManagerReturnsEmptySet) {
+    CalibrationSetHandle set = manager_.GetCalibrationSet();
+    ASSERT_NE(set, nullptr);
+    EXPECT_EQ(set->Dark(), nullptr);
+    EXPECT_EQ(set->Gain(), nullptr);
+    EXPECT_EQ(set->Defects(), nullptr);
+}
@@ -0,0 +1,266 @@
+/**
+ * @file test_clahe_processor.cpp
+ * @brief Unit tests for tile-parallel CLAHE (ClaheProcessor)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Local contrast equalisation tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Configuration validation
+ * - A single unclipped tile is global histogram equalisation
+ * - Output stays within the input value range; uniform frames stay uniform
+ * - The clip limit bounds the contrast gain
+ * - Results do not depend on the thread count or row stride
+ * - A post LUT composes with the equalisation in the same pass
+ * - 9 MP throughput (recorded as test properties)
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/ClaheProcessor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+/**
+ * @brief Low-contrast frame: slow gradient plus noise in 1000..3000
+ */
+std::vector<uint16_t> MakeFrame(uint32_t width, uint32_t height, uint32_t stride_pixels,
+                                uint32_t seed = 7) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(-40, 40);
+    std::vector<uint16_t> frame(static_cast<size_t>(stride_pixels) * height, 0);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const int value = 1000 + static_cast<int>(1800.0 * (x + y) / (width + height)) +
+                              noise(rng);
+            frame[y * stride_pixels + x] = static_cast<uint16_t>(value);
+        }
+    }
+    return frame;
+}
+
+ClaheConfig Config(uint32_t tiles, float clip_limit) {
+    ClaheConfig config;
+    config.enabled = true;
+    config.tiles_x = tiles;
+    config.tiles_y = tiles;
+    config.clip_limit = clip_limit;
+    return config;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST(ClaheProcessorTest, RejectsInvalidConfigurations) {
+    ClaheConfig config = Config(8, 2.0f);
+    EXPECT_TRUE(ValidateClaheConfig(config, 64, 64));
+    EXPECT_FALSE(ValidateClaheConfig(config, 7, 64));
+    EXPECT_FALSE(ValidateClaheConfig(config, 64, 0));
+
+    config.tiles_x = 0;
+    EXPECT_FALSE(ValidateClaheConfig(config, 64, 64));
+    config.tiles_x = kClaheMaxTiles + 1;
+    EXPECT_FALSE(ValidateClaheConfig(config, 1024, 1024));
+
+    config = Config(8, 2.0f);
+    config.histogram_bits = 7;
+    EXPECT_FALSE(ValidateClaheConfig(config, 64, 64));
+    config.histogram_bits = 17;
+    EXPECT_FALSE(ValidateClaheConfig(config, 64, 64));
+
+    config = Config(8, std::numeric_limits<float>::infinity());
+    EXPECT_FALSE(ValidateClaheConfig(config, 64, 64));
+
+    ClaheProcessor clahe(1);
+    std::vector<uint16_t> frame(64 * 64);
+    EXPECT_FALSE(clahe.Apply(frame.data(), 64, 64, 64, Config(8, 2.0f)));   // stride < width * 2
+    EXPECT_FALSE(clahe.Apply(nullptr, 64, 64, 128, Config(8, 2.0f)));
+}
+
+// =============================================================================
+// Mapping
+// =============================================================================
+
+TEST(ClaheProcessorTest, SingleUnclippedTileIsHistogramEqualisation) {
+    constexpr uint32_t kW = 97;
+    constexpr uint32_t kH = 61;
+    std::vector<uint16_t> frame = MakeFrame(kW, kH, kW);
+    const std::vector<uint16_t> original = frame;
+
+    ClaheConfig config = Config(1, 0.0f);
+    config.histogram_bits = 16;
+    ClaheProcessor clahe(1);
+    ASSERT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, config));
+
+    std::vector<uint64_t> cdf(65536, 0);
+    for (uint16_t v : original) {
+        ++cdf[v];
+    }
+    for (size_t v = 1; v < cdf.size(); ++v) {
+        cdf[v] += cdf[v - 1];
+    }
+    const float lo = *std::min_element(original.begin(), original.end());
+    const float hi = *std::max_element(original.begin(), original.end());
+    const float scale = (hi - lo) / static_cast<float>(original.size());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        const float expected = lo + static_cast<float>(cdf[original[i]]) * scale;
+        ASSERT_EQ(frame[i], static_cast<uint16_t>(expected + 0.5f)) << "pixel " << i;
+    }
+}
+
+TEST(ClaheProcessorTest, OutputStaysInInputRange) {
+    constexpr uint32_t kW = 200;
+    constexpr uint32_t kH = 150;
+    std::vector<uint16_t> frame = MakeFrame(kW, kH, kW);
+    const auto [min_it, max_it] = std::minmax_element(frame.begin(), frame.end());
+    const uint16_t lo = *min_it;
+    const uint16_t hi = *max_it;
+
+    ClaheProcessor clahe(2);
+    ASSERT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, Config(8, 3.0f)));
+    const auto [out_min, out_max] = std::minmax_element(frame.begin(), frame.end());
+    EXPECT_GE(*out_min, lo);
+    EXPECT_LE(*out_max, hi);
+    EXPECT_LT(*out_min, lo + 200);       // Equalisation spreads to the range ends
+    EXPECT_GT(*out_max, hi - 200);
+
+    std::vector<uint16_t> uniform(kW * kH, 1234);
+    ASSERT_TRUE(clahe.Apply(uniform.data(), kW, kH, kW * 2, Config(4, 2.0f)));
+    EXPECT_EQ(uniform, std::vector<uint16_t>(kW * kH, 1234));
+}
+
+TEST(ClaheProcessorTest, ClipLimitBoundsContrastGain) {
+    constexpr uint32_t kW = 128;
+    constexpr uint32_t kH = 128;
+    const std::vector<uint16_t> original = MakeFrame(kW, kH, kW);
+
+    // Mean absolute horizontal difference as a local contrast measure
+    auto contrast = [&](float clip_limit) {
+        std::vector<uint16_t> frame = original;
+        ClaheProcessor clahe(1);
+        EXPECT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, Config(4, clip_limit)));
+        double sum = 0.0;
+        for (uint32_t y = 0; y < kH; ++y) {
+            for (uint32_t x = 1; x < kW; ++x) {
+                sum += std::abs(frame[y * kW + x] - frame[y * kW + x - 1]);
+            }
+        }
+        return sum / (kH * (kW - 1));
+    };
+
+    const double clipped = contrast(1.5f);
+    const double loose = contrast(8.0f);
+    const double unclipped = contrast(0.0f);
+    EXPECT_LT(clipped, loose);
+    EXPECT_LE(loose, unclipped);
+}
+
+// =============================================================================
+// Determinism and Composition
+// =============================================================================
+
+TEST(ClaheProcessorTest, ResultIndependentOfThreadsAndStride) {
+    constexpr uint32_t kW = 333;
+    constexpr uint32_t kH = 211;
+    constexpr uint32_t kStride = 340;
+    const std::vector<uint16_t> packed = MakeFrame(kW, kH, kW);
+    const std::vector<uint16_t> padded = MakeFrame(kW, kH, kStride);
+    const ClaheConfig config = Config(7, 2.5f);
+
+    std::vector<uint16_t> reference = packed;
+    ClaheProcessor single(1);
+    ASSERT_TRUE(single.Apply(reference.data(), kW, kH, kW * 2, config));
+
+    for (uint32_t threads : {2u, 4u, 8u}) {
+        ClaheProcessor clahe(threads);
+        EXPECT_EQ(clahe.ThreadCount(), threads);
+
+        std::vector<uint16_t> frame = packed;
+        ASSERT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, config));
+        EXPECT_EQ(frame, reference) << threads << " threads";
+
+        // Reused scratch and padded rows
+        std::vector<uint16_t> strided = padded;
+        ASSERT_TRUE(clahe.Apply(strided.data(), kW, kH, kStride * 2, config));
+        for (uint32_t y = 0; y < kH; ++y) {
+            ASSERT_TRUE(std::equal(reference.begin() + y * kW, reference.begin() + (y + 1) * kW,
+                                   strided.begin() + y * kStride)) << "row " << y;
+            ASSERT_EQ(strided[y * kStride + kW], 0u);    // Padding untouched
+        }
+    }
+}
+
+TEST(ClaheProcessorTest, PostLutComposesInOnePass) {
+    constexpr uint32_t kW = 120;
+    constexpr uint32_t kH = 90;
+    const ClaheConfig config = Config(6, 2.0f);
+
+    // Window/Level-like LUT: 1000..3000 -> 0..65535
+    std::vector<uint16_t> lut(65536);
+    for (size_t v = 0; v < lut.size(); ++v) {
+        const float value = (static_cast<float>(v) - 1000.0f) * (65535.0f / 2000.0f);
+        lut[v] = static_cast<uint16_t>(std::max(0.0f, std::min(65535.0f, value)));
+    }
+
+    std::vector<uint16_t> separate = MakeFrame(kW, kH, kW);
+    std::vector<uint16_t> fused = separate;
+    ClaheProcessor clahe(3);
+    ASSERT_TRUE(clahe.Apply(separate.data(), kW, kH, kW * 2, config));
+    for (uint16_t& v : separate) {
+        v = lut[v];
+    }
+    ASSERT_TRUE(clahe.Apply(fused.data(), kW, kH, kW * 2, config, lut.data()));
+    EXPECT_EQ(fused, separate);
+}
+
+// =============================================================================
+// Throughput
+// =============================================================================
+
+TEST(ClaheProcessorTest, Throughput9MP) {
+    constexpr uint32_t kW = 3072;
+    constexpr uint32_t kH = 3072;
+    const std::vector<uint16_t> original = MakeFrame(kW, kH, kW);
+    const ClaheConfig config = Config(8, 2.0f);
+    const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+    auto run_ms = [&](uint32_t threads) {
+        ClaheProcessor clahe(threads);
+        std::vector<uint16_t> frame = original;
+        EXPECT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, config));   // Warm-up
+        double best = 1e9;
+        for (int i = 0; i < 3; ++i) {
+            frame = original;
+            const auto start = std::chrono::steady_clock::now();
+            EXPECT_TRUE(clahe.Apply(frame.data(), kW, kH, kW * 2, config));
+            best = std::min(best, std::chrono::duration<double, std::milli>(
+                                      std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    const double one = run_ms(1);
+    const double all = run_ms(cores);
+    RecordProperty("clahe_9mp_ms_1_thread", static_cast<int>(one));
+    RecordProperty("clahe_9mp_ms_all_threads", static_cast<int>(all));
+    RecordProperty("threads", static_cast<int>(cores));
+
+    if (cores >= 4) {
+        EXPECT_LT(all, one / 2.0);
+    }
+}
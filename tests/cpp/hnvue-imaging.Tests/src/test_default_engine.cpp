@@ -11,14 +11,22 @@
  * - Initialization and shutdown
  * - Individual pipeline stage execution
  * - Full pipeline execution (FULL_PIPELINE and PREVIEW modes)
+ * - Calibration handles (CalibrationSet) bound once per geometry
+ * - f32 working plane vs. per-stage u16 round trips (quality, memory traffic)
+ * - Output transform (crop/rotate/shutter) fused into Window/Level
+ * - CLAHE stage with Window/Level folded into its last pass
+ * - Dynamic defect detection: promotion from dark frames, later correction
  * - Error handling and validation
  */
 
 #include <gtest/gtest.h>
+#include <hnvue/imaging/CalibrationSet.h>
 #include <hnvue/imaging/DefaultImageProcessingEngine.h>
 #include <hnvue/imaging/ImagingTypes.h>
 #include <vector>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 
 using namespace hnvue::imaging;
 
@@ -37,6 +45,10 @@ protected:
     std::vector<float> dark_data_;
     std::vector<float> gain_data_;
     std::vector<DefectPixelEntry> defect_entries_;
+    // Descriptors returned by reference: configs keep pointers to them
+    CalibrationData dark_calibration_;
+    CalibrationData gain_calibration_;
+    DefectMap defect_map_;
 
     void SetUp() override {
         engine_ = std::make_unique<DefaultImageProcessingEngine>();
@@ -90,8 +102,9 @@ protected:
         return frame;
     }
 
-    CalibrationData CreateDarkCalibration() {
-        CalibrationData dark;
+    CalibrationData& CreateDarkCalibration() {
+        CalibrationData& dark = dark_calibration_;
+        dark = CalibrationData{};
         dark.type = CalibrationDataType::DARK_FRAME;
         dark.width = TEST_WIDTH;
         dark.height = TEST_HEIGHT;
@@ -101,8 +114,9 @@ protected:
         return dark;
     }
 
-    CalibrationData CreateGainCalibration() {
-        CalibrationData gain;
+    CalibrationData& CreateGainCalibration() {
+        CalibrationData& gain = gain_calibration_;
+        gain = CalibrationData{};
         gain.type = CalibrationDataType::GAIN_MAP;
         gain.width = TEST_WIDTH;
         gain.height = TEST_HEIGHT;
@@ -112,15 +126,25 @@ protected:
         return gain;
     }
 
-    DefectMap CreateDefectMap() {
-        DefectMap map;
+    DefectMap& CreateDefectMap() {
+        DefectMap& map = defect_map_;
+        map = DefectMap{};
         map.count = static_cast<uint32_t>(defect_entries_.size());
         map.pixels = defect_entries_.data();
         map.valid = true;
-        map.checksum = 0DEFECT01;
+        map.checksum = 0xDEFEC701;
         return map;
     }
 
+    CalibrationSetHandle CreateCalibrationSet(uint32_t width, uint32_t height) {
+        std::vector<float> dark(static_cast<size_t>(width) * height, 100.0f);
+        std::vector<float> gain(static_cast<size_t>(width) * height, 1.0f);
+        return std::make_shared<const CalibrationSet>(
+            CalibrationMap::Create(CalibrationDataType::DARK_FRAME, width, height, std::move(dark)),
+            CalibrationMap::Create(CalibrationDataType::GAIN_MAP, width, height, std::move(gain)),
+            DefectPlan::Create(width, height, defect_entries_));
+    }
+
     bool InitializeEngine() {
         EngineConfig config;
         config.max_frame_width = TEST_WIDTH;
@@ -190,6 +214,10 @@ TEST_F(DefaultImageProcessingEngineTest, EngineCapabilities) {
     EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_NOISE_REDUCTION));
     EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_FLATTENING));
     EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_PREVIEW_MODE));
+    EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_FLOAT_WORKING_PLANE));
+    EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_OUTPUT_TRANSFORM));
+    EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_CLAHE));
+    EXPECT_TRUE(info.HasCapability(EngineCapabilityFlags::CAP_DYNAMIC_DEFECTS));
 }
 
 // =============================================================================
@@ -577,6 +605,360 @@ TEST_F(DefaultImageProcessingEngineTest, ProcessFrameWithoutInitializeFails) {
     EXPECT_FALSE(engine_->ProcessFrame(frame, config));
 }
 
+// =============================================================================
+// Calibration Handle Tests
+// =============================================================================
+
+TEST_F(DefaultImageProcessingEngineTest, ProcessFrameWithCalibrationSetSucceeds) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.calibration = CreateCalibrationSet(TEST_WIDTH, TEST_HEIGHT);
+
+    for (int i = 0; i < 3; ++i) {
+        ImageBuffer frame = CreateTestFrame();
+        EXPECT_TRUE(engine_->ProcessFrame(frame, config));
+    }
+
+    StageTiming timing = engine_->GetLastTiming();
+    EXPECT_GT(timing.offset_correction_us, 0);
+    EXPECT_GT(timing.defect_pixel_map_us, 0);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, ProcessFrameWithMismatchedCalibrationSetFails) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ImageBuffer frame = CreateTestFrame();
+    ProcessingConfig config;
+    config.calibration = CreateCalibrationSet(TEST_WIDTH + 16, TEST_HEIGHT);
+
+    EXPECT_FALSE(engine_->ProcessFrame(frame, config));
+    EXPECT_EQ(engine_->GetLastError().error_code, ImagingError::IMAGING_ERR_CALIBRATION);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, ProcessFrameWithBinnedFrameUsesBinnedCalibration) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ImageBuffer frame = CreateTestFrame();
+    frame.width = TEST_WIDTH / 2;
+    frame.height = TEST_HEIGHT / 2;
+    frame.stride = frame.width * 2;
+    ProcessingConfig config;
+    config.calibration = CreateCalibrationSet(TEST_WIDTH, TEST_HEIGHT);
+
+    EXPECT_TRUE(engine_->ProcessFrame(frame, config));
+
+    // Calibration replaced between frames: the next frame rebinds
+    config.calibration = CreateCalibrationSet(TEST_WIDTH, TEST_HEIGHT);
+    EXPECT_TRUE(engine_->ProcessFrame(frame, config));
+}
+
+// =============================================================================
+// Float Working Plane Tests
+// =============================================================================
+
+TEST_F(DefaultImageProcessingEngineTest, ProcessFrameWithFloatPlaneSucceeds) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.calibration = CreateCalibrationSet(TEST_WIDTH, TEST_HEIGHT);
+    config.mode = ProcessingMode::FULL_PIPELINE;
+    config.window = 4000.0f;
+    config.level = 2000.0f;
+
+    const std::vector<uint16_t> original = frame_data_;
+    config.precision = WorkingPrecision::UINT16_STAGES;
+    ImageBuffer frame = CreateTestFrame();
+    ASSERT_TRUE(engine_->ProcessFrame(frame, config));
+    StageTiming u16_timing = engine_->GetLastTiming();
+
+    frame_data_ = original;
+    config.precision = WorkingPrecision::FLOAT32_PLANE;
+    frame = CreateTestFrame();
+    ASSERT_TRUE(engine_->ProcessFrame(frame, config));
+    StageTiming plane_timing = engine_->GetLastTiming();
+
+    EXPECT_GT(plane_timing.offset_correction_bytes, 0u);
+    EXPECT_GT(plane_timing.defect_pixel_map_bytes, 0u);
+    EXPECT_GT(plane_timing.window_level_bytes, 0u);
+    EXPECT_LT(plane_timing.TotalBytes(), u16_timing.TotalBytes());
+
+    RecordProperty("u16_total_bytes", static_cast<int>(u16_timing.TotalBytes()));
+    RecordProperty("f32_total_bytes", static_cast<int>(plane_timing.TotalBytes()));
+}
+
+TEST_F(DefaultImageProcessingEngineTest, FloatPlaneMatchesDoubleReference) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::PREVIEW;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.window = 4000.0f;
+    config.level = 2000.0f;
+
+    // Reference: offset, gain and Window/Level in double, rounded once
+    const double win_min = config.level - config.window / 2.0;
+    const double scale = 65535.0 / config.window;
+    std::vector<double> reference(TEST_SIZE);
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        double value = (frame_data_[i] - static_cast<double>(dark_data_[i])) * gain_data_[i];
+        value = std::round((value - win_min) * scale);
+        reference[i] = std::clamp(value, 0.0, 65535.0);
+    }
+    const std::vector<uint16_t> original = frame_data_;
+
+    auto max_error = [&](WorkingPrecision precision) {
+        frame_data_ = original;
+        config.precision = precision;
+        ImageBuffer frame = CreateTestFrame();
+        EXPECT_TRUE(engine_->ProcessFrame(frame, config));
+        double error = 0.0;
+        for (size_t i = 0; i < TEST_SIZE; ++i) {
+            error = std::max(error, std::abs(frame_data_[i] - reference[i]));
+        }
+        return error;
+    };
+
+    const double u16_error = max_error(WorkingPrecision::UINT16_STAGES);
+    const double plane_error = max_error(WorkingPrecision::FLOAT32_PLANE);
+
+    EXPECT_LE(plane_error, 1.0);
+    EXPECT_LE(plane_error, u16_error);
+
+    RecordProperty("u16_max_error_lsb", static_cast<int>(u16_error));
+    RecordProperty("f32_max_error_lsb", static_cast<int>(plane_error));
+}
+
+TEST_F(DefaultImageProcessingEngineTest, OutputTransformMatchesTransformedFullFrame) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::PREVIEW;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.window = 4000.0f;
+    config.level = 2000.0f;
+    const std::vector<uint16_t> original = frame_data_;
+
+    OutputTransform output;
+    output.crop_x = 16;
+    output.crop_y = 8;
+    output.crop_width = 200;
+    output.crop_height = 120;
+    output.rotation = OutputRotation::ROTATE_90;
+    output.flip_horizontal = true;
+    output.shutter = ShutterShape::RECTANGULAR;
+    output.shutter_left = 30;
+    output.shutter_top = 8;
+    output.shutter_right = 216;
+    output.shutter_bottom = 100;
+    output.shutter_value = 7;
+
+    for (WorkingPrecision precision :
+         {WorkingPrecision::UINT16_STAGES, WorkingPrecision::FLOAT32_PLANE}) {
+        config.precision = precision;
+
+        // Reference: full frame, then crop, flip, rotate and shutter here
+        frame_data_ = original;
+        config.output = OutputTransform{};
+        ImageBuffer full = CreateTestFrame();
+        ASSERT_TRUE(engine_->ProcessFrame(full, config));
+        const std::vector<uint16_t> full_out = frame_data_;
+
+        frame_data_ = original;
+        config.output = output;
+        ImageBuffer frame = CreateTestFrame();
+        ASSERT_TRUE(engine_->ProcessFrame(frame, config));
+        ASSERT_EQ(frame.width, 120u);
+        ASSERT_EQ(frame.height, 200u);
+        ASSERT_EQ(frame.stride, 120u * 2);
+        EXPECT_GT(engine_->GetLastTiming().window_level_bytes, 0u);
+
+        int max_error = 0;
+        for (uint32_t oy = 0; oy < frame.height; ++oy) {
+            for (uint32_t ox = 0; ox < frame.width; ++ox) {
+                const uint32_t u = output.crop_width - 1 - oy;     // rotate, then flip
+                const uint32_t v = output.crop_height - 1 - ox;
+                const uint32_t x = output.crop_x + u;
+                const uint32_t y = output.crop_y + v;
+                const bool inside = x >= output.shutter_left && x < output.shutter_right &&
+                                    y >= output.shutter_top && y < output.shutter_bottom;
+                const int expected = inside ? full_out[y * TEST_WIDTH + x] : 7;
+                max_error = std::max(max_error,
+                                     std::abs(frame.data[oy * frame.width + ox] - expected));
+            }
+        }
+        // Identical LUT for u16; f32 rounds in float instead of double
+        EXPECT_LE(max_error, precision == WorkingPrecision::UINT16_STAGES ? 0 : 1);
+        RecordProperty(precision == WorkingPrecision::UINT16_STAGES
+                           ? "u16_max_error_lsb" : "f32_max_error_lsb",
+                       max_error);
+    }
+}
+
+TEST_F(DefaultImageProcessingEngineTest, InvalidOutputTransformLeavesFrameUntouched) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::PREVIEW;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.output.crop_x = TEST_WIDTH;
+    const std::vector<uint16_t> original = frame_data_;
+
+    ImageBuffer frame = CreateTestFrame();
+    EXPECT_FALSE(engine_->ProcessFrame(frame, config));
+    EXPECT_EQ(engine_->GetLastError().error_code, ImagingError::IMAGING_ERR_PARAM);
+    EXPECT_EQ(engine_->GetLastError().failed_stage, "OutputTransform");
+    EXPECT_EQ(frame.width, TEST_WIDTH);
+    EXPECT_EQ(frame_data_, original);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, ClaheFoldsWindowLevelIntoItsPass) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::FULL_PIPELINE;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    DefectMap defects = CreateDefectMap();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.defect_map = &defects;
+    config.window = 4000.0f;
+    config.level = 2000.0f;
+    config.clahe.enabled = true;
+    config.clahe.tiles_x = 4;
+    config.clahe.tiles_y = 4;
+    const std::vector<uint16_t> original = frame_data_;
+
+    std::vector<std::vector<uint16_t>> outputs;
+    for (WorkingPrecision precision :
+         {WorkingPrecision::UINT16_STAGES, WorkingPrecision::FLOAT32_PLANE}) {
+        frame_data_ = original;
+        config.precision = precision;
+        ImageBuffer frame = CreateTestFrame();
+        ASSERT_TRUE(engine_->ProcessFrame(frame, config));
+        outputs.push_back(frame_data_);
+
+        StageTiming timing = engine_->GetLastTiming();
+        EXPECT_GT(timing.clahe_bytes, 0u);
+        EXPECT_EQ(timing.window_level_bytes, 0u);
+    }
+
+    // Both modes equalise the same image; they differ only by rounding
+    int max_difference = 0;
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        max_difference = std::max(max_difference, std::abs(outputs[0][i] - outputs[1][i]));
+    }
+    EXPECT_LE(max_difference, 1);
+    RecordProperty("max_mode_difference_lsb", max_difference);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, InvalidClaheConfigLeavesFrameUntouched) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::FULL_PIPELINE;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    DefectMap defects = CreateDefectMap();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.defect_map = &defects;
+    config.clahe.enabled = true;
+    config.clahe.tiles_x = 0;
+    const std::vector<uint16_t> original = frame_data_;
+
+    ImageBuffer frame = CreateTestFrame();
+    EXPECT_FALSE(engine_->ProcessFrame(frame, config));
+    EXPECT_EQ(engine_->GetLastError().failed_stage, "CLAHE");
+    EXPECT_EQ(frame_data_, original);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, PromotedDefectsAreCorrectedInLaterFrames) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::FULL_PIPELINE;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    DefectMap defects = CreateDefectMap();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.defect_map = &defects;
+    config.window = 4000.0f;
+    config.level = 2000.0f;
+    config.defect_detection.enabled = true;
+
+    // A new hot pixel and a calibrated one in dark frames
+    std::vector<uint16_t> dark_frame(TEST_SIZE, 300);
+    dark_frame[100 * TEST_WIDTH + 100] = 4000;
+    dark_frame[64 * TEST_WIDTH + 64] = 4000;
+    ImageBuffer dark_buffer = CreateTestFrame();
+    dark_buffer.data = dark_frame.data();
+    for (int i = 0; i < 12; ++i) {
+        ASSERT_TRUE(engine_->ObserveDarkFrame(dark_buffer, config));
+    }
+
+    auto promoted = engine_->DynamicDefects();
+    ASSERT_NE(promoted, nullptr);
+    ASSERT_EQ(promoted->Map().count, 1u);
+    EXPECT_EQ(promoted->Map().pixels[0].x, 100u);
+    EXPECT_EQ(promoted->Map().pixels[0].y, 100u);
+    EXPECT_EQ(promoted->Map().pixels[0].type, DefectPixelType::HOT_PIXEL);
+
+    const std::vector<uint16_t> flat(TEST_SIZE, 2000);
+    for (WorkingPrecision precision :
+         {WorkingPrecision::UINT16_STAGES, WorkingPrecision::FLOAT32_PLANE}) {
+        frame_data_ = flat;
+        frame_data_[100 * TEST_WIDTH + 100] = 9000;
+        config.precision = precision;
+        ImageBuffer frame = CreateTestFrame();
+        ASSERT_TRUE(engine_->ProcessFrame(frame, config));
+
+        const int corrected = frame_data_[100 * TEST_WIDTH + 100];
+        const int neighbour = frame_data_[100 * TEST_WIDTH + 101];
+        EXPECT_LT(std::abs(corrected - neighbour), 400);
+        RecordProperty(precision == WorkingPrecision::UINT16_STAGES
+                           ? "u16_residual_lsb" : "f32_residual_lsb",
+                       std::abs(corrected - neighbour));
+        EXPECT_GT(engine_->GetLastTiming().defect_detection_bytes, 0u);
+    }
+
+    engine_->ClearDynamicDefects();
+    EXPECT_EQ(engine_->DynamicDefects(), nullptr);
+}
+
+TEST_F(DefaultImageProcessingEngineTest, InvalidDefectDetectionConfigLeavesFrameUntouched) {
+    ASSERT_TRUE(InitializeEngine());
+
+    ProcessingConfig config;
+    config.mode = ProcessingMode::FULL_PIPELINE;
+    CalibrationData dark = CreateDarkCalibration();
+    CalibrationData gain = CreateGainCalibration();
+    DefectMap defects = CreateDefectMap();
+    config.calibration_dark = &dark;
+    config.calibration_gain = &gain;
+    config.defect_map = &defects;
+    config.defect_detection.enabled = true;
+    config.defect_detection.row_interleave = 0;
+    const std::vector<uint16_t> original = frame_data_;
+
+    ImageBuffer frame = CreateTestFrame();
+    EXPECT_FALSE(engine_->ProcessFrame(frame, config));
+    EXPECT_EQ(engine_->GetLastError().failed_stage, "DefectDetection");
+    EXPECT_EQ(frame_data_, original);
+    EXPECT_FALSE(engine_->ObserveDarkFrame(frame, config));
+}
+
 // =============================================================================
 // Error Handling Tests
 // =============================================================================
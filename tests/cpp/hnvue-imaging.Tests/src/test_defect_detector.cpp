@@ -0,0 +1,333 @@
+/**
+ * @file test_defect_detector.cpp
+ * @brief Unit tests for online defect pixel detection (DefectDetector)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Dynamic defect pixel detection tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Configuration validation
+ * - Persistent hot and dead pixels are promoted and classified
+ * - Edges, gradients, thin wires and intermittent spikes are not promoted
+ * - Dark frames observe every row
+ * - Excluded pixels are never reported; a geometry change resets
+ * - Scores match a per-pixel reference model (vector and tail paths)
+ * - 9 MP per-frame overhead (recorded as test properties)
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/DefectDetector.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+DefectDetectionConfig Config() {
+    DefectDetectionConfig config;
+    config.enabled = true;
+    return config;
+}
+
+/**
+ * @brief Uniform frame at level with +/- noise counts of noise
+ */
+std::vector<uint16_t> MakeFlat(uint32_t width, uint32_t height, uint16_t level,
+                               int noise, std::mt19937& rng) {
+    std::uniform_int_distribution<int> dist(-noise, noise);
+    std::vector<uint16_t> frame(static_cast<size_t>(width) * height);
+    for (uint16_t& v : frame) {
+        v = static_cast<uint16_t>(level + dist(rng));
+    }
+    return frame;
+}
+
+uint32_t Observe(DefectDetector& detector, const std::vector<uint16_t>& frame,
+                 uint32_t width, uint32_t height, bool dark,
+                 const DefectDetectionConfig& config = Config()) {
+    return detector.Observe(frame.data(), width, height, width * 2, dark, config);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST(DefectDetectorTest, RejectsInvalidConfigurations) {
+    DefectDetectionConfig config = Config();
+    EXPECT_TRUE(ValidateDefectDetectionConfig(config));
+
+    config.relative_threshold = 1.0f;
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+    config.relative_threshold = -0.1f;
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+    config = Config();
+    config.flat_threshold = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+    config = Config();
+    config.promote_score = 1;
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+    config.promote_score = kDefectMaxPromoteScore + 1;
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+    config = Config();
+    config.row_interleave = 0;
+    EXPECT_FALSE(ValidateDefectDetectionConfig(config));
+
+    // Invalid frames and configurations are ignored
+    DefectDetector detector;
+    std::vector<uint16_t> frame(16 * 16, 1000);
+    EXPECT_EQ(detector.Observe(frame.data(), 16, 16, 16, false, Config()), 0u);
+    EXPECT_EQ(detector.Observe(nullptr, 16, 16, 32, false, Config()), 0u);
+    EXPECT_EQ(detector.Observe(frame.data(), 16, 16, 32, false, config), 0u);
+    EXPECT_EQ(detector.FramesObserved(), 0u);
+}
+
+// =============================================================================
+// Promotion
+// =============================================================================
+
+TEST(DefectDetectorTest, PromotesPersistentHotAndDeadPixels) {
+    constexpr uint32_t kW = 64;
+    constexpr uint32_t kH = 48;
+    std::mt19937 rng(3);
+    DefectDetector detector;
+
+    // Row 10 is observed on frames 1, 5, 9 ..., row 20 on frames 3, 7, 11 ...;
+    // 12 outliers (score 24) take 45 and 47 frames respectively
+    uint32_t promoted = 0;
+    for (uint32_t frame = 0; frame < 48; ++frame) {
+        std::vector<uint16_t> image = MakeFlat(kW, kH, 2000, 20, rng);
+        image[10 * kW + 10] = 3000;
+        image[20 * kW + 30] = 200;
+        promoted += Observe(detector, image, kW, kH, false);
+        if (frame == 44) {
+            EXPECT_EQ(promoted, 0u);
+        }
+    }
+    EXPECT_EQ(promoted, 2u);
+    EXPECT_EQ(detector.FramesObserved(), 48u);
+
+    const std::vector<DefectPixelEntry> found = detector.TakePromoted();
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].x, 10u);
+    EXPECT_EQ(found[0].y, 10u);
+    EXPECT_EQ(found[0].type, DefectPixelType::HOT_PIXEL);
+    EXPECT_EQ(found[0].interpolation, InterpolationMethod::MEDIAN_3X3);
+    EXPECT_EQ(found[1].x, 30u);
+    EXPECT_EQ(found[1].y, 20u);
+    EXPECT_EQ(found[1].type, DefectPixelType::DEAD_PIXEL);
+    EXPECT_EQ(detector.Score(10, 10), kDefectScoreLocked);
+
+    // Promoted once; taken once
+    EXPECT_TRUE(detector.TakePromoted().empty());
+    std::vector<uint16_t> image = MakeFlat(kW, kH, 2000, 20, rng);
+    image[10 * kW + 10] = 3000;
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(Observe(detector, image, kW, kH, false), 0u);
+    }
+}
+
+TEST(DefectDetectorTest, AnatomyAndSpikesAreNotPromoted) {
+    constexpr uint32_t kW = 96;
+    constexpr uint32_t kH = 64;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> noise(-30, 30);
+    DefectDetector detector;
+
+    uint32_t promoted = 0;
+    for (uint32_t frame = 0; frame < 300; ++frame) {
+        std::vector<uint16_t> image(kW * kH);
+        for (uint32_t y = 0; y < kH; ++y) {
+            for (uint32_t x = 0; x < kW; ++x) {
+                int value = 500 + 60 * static_cast<int>(x) / 2;     // Steep gradient
+                if (x >= 48) {
+                    value += 8000;                                  // Step edge
+                }
+                if (x == 20) {
+                    value += 3000;                                  // One-pixel wire
+                }
+                image[y * kW + x] = static_cast<uint16_t>(value + noise(rng));
+            }
+        }
+        if (frame % 3 == 0) {
+            image[30 * kW + 70] += 5000;                            // Intermittent spike
+        }
+        promoted += Observe(detector, image, kW, kH, false);
+    }
+    EXPECT_EQ(promoted, 0u);
+    EXPECT_TRUE(detector.TakePromoted().empty());
+}
+
+TEST(DefectDetectorTest, DarkFramesObserveEveryRow) {
+    constexpr uint32_t kW = 40;
+    constexpr uint32_t kH = 30;
+    std::mt19937 rng(5);
+    DefectDetector detector;
+
+    for (int frame = 0; frame < 11; ++frame) {
+        std::vector<uint16_t> image = MakeFlat(kW, kH, 100, 10, rng);
+        image[7 * kW + 33] = 900;
+        EXPECT_EQ(Observe(detector, image, kW, kH, true), 0u);
+    }
+    EXPECT_EQ(detector.Score(33, 7), 22u);
+
+    std::vector<uint16_t> image = MakeFlat(kW, kH, 100, 10, rng);
+    image[7 * kW + 33] = 900;
+    EXPECT_EQ(Observe(detector, image, kW, kH, true), 1u);
+
+    // Border pixels have no complete neighbourhood
+    image[0 * kW + 5] = 900;
+    image[12 * kW + (kW - 1)] = 900;
+    for (int frame = 0; frame < 30; ++frame) {
+        EXPECT_EQ(Observe(detector, image, kW, kH, true), 0u);
+    }
+}
+
+TEST(DefectDetectorTest, ExcludedPixelsAreNotReported) {
+    constexpr uint32_t kW = 32;
+    constexpr uint32_t kH = 32;
+    std::mt19937 rng(9);
+    std::vector<DefectPixelEntry> known = {{5, 5, DefectPixelType::HOT_PIXEL,
+                                            InterpolationMethod::BILINEAR}};
+    DefectMap map;
+    map.count = 1;
+    map.pixels = known.data();
+    map.valid = true;
+
+    DefectDetector detector;
+    detector.Exclude(map, kW, kH);
+    std::vector<uint16_t> image = MakeFlat(kW, kH, 1000, 10, rng);
+    image[5 * kW + 5] = 4000;
+    image[9 * kW + 9] = 4000;
+    uint32_t promoted = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        promoted += Observe(detector, image, kW, kH, true);
+    }
+    ASSERT_EQ(promoted, 1u);
+    EXPECT_EQ(detector.TakePromoted()[0].x, 9u);
+
+    // A geometry change discards statistics and exclusions
+    std::vector<uint16_t> other = MakeFlat(kW, kH / 2, 1000, 10, rng);
+    other[5 * kW + 5] = 4000;
+    Observe(detector, other, kW, kH / 2, true);
+    EXPECT_EQ(detector.Height(), kH / 2);
+    EXPECT_EQ(detector.FramesObserved(), 1u);
+    EXPECT_EQ(detector.Score(5, 5), 2u);
+}
+
+// =============================================================================
+// Reference Model
+// =============================================================================
+
+TEST(DefectDetectorTest, ScoresMatchReferenceModel) {
+    // Odd width: most pixels take the vector path, the last columns the tail
+    constexpr uint32_t kW = 75;
+    constexpr uint32_t kH = 41;
+    DefectDetectionConfig config = Config();
+    config.relative_threshold = 0.1f;
+    config.absolute_threshold = 60;
+    config.flat_threshold = 0.08f;
+    config.promote_score = 9;
+    config.row_interleave = 3;
+
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> level(0, 65535);
+    std::uniform_int_distribution<int> pick(0, kW * kH - 1);
+    std::vector<int> reference(kW * kH, 0);
+    std::vector<bool> locked(kW * kH, false);
+    DefectDetector detector;
+    uint32_t clinical_frames = 0;
+
+    for (uint32_t frame = 0; frame < 40; ++frame) {
+        const bool dark = frame % 5 == 4;
+        std::vector<uint16_t> image = MakeFlat(kW, kH, 30000, 1000, rng);
+        for (int i = 0; i < 60; ++i) {
+            image[pick(rng)] = static_cast<uint16_t>(level(rng));
+        }
+        image[20 * kW + 30] = 60000;                        // Vector path
+        image[10 * kW + 73] = 1000;                         // Tail
+        for (int i = 0; i < 4; ++i) {                       // Saturated neighbourhoods
+            image[pick(rng)] = 65535;
+        }
+
+        // Rows observed by this frame
+        const uint32_t step = dark ? 1 : config.row_interleave;
+        const uint32_t phase = dark ? 0 : clinical_frames++ % config.row_interleave;
+        for (uint32_t y = 1 + phase; y + 1 < kH; y += step) {
+            for (uint32_t x = 1; x + 1 < kW; ++x) {
+                const size_t i = y * kW + x;
+                if (locked[i]) {
+                    continue;
+                }
+                const int l = image[i - 1], r = image[i + 1];
+                const int u = image[i - kW], d = image[i + kW];
+                const int a = std::max(std::min(l, r), std::min(u, d));
+                const int b = std::min(std::max(l, r), std::max(u, d));
+                const int median = (a + b + 1) / 2;
+                const int tolerance = std::min(
+                    65535, ((median * 6554) >> 16) + config.absolute_threshold);
+                const int flat_tolerance = std::min(
+                    65535, ((median * 5243) >> 16) + config.absolute_threshold / 2);
+                if (!dark && std::abs(a - b) > flat_tolerance) {
+                    continue;
+                }
+                if (std::abs(image[i] - median) > tolerance) {
+                    reference[i] = std::min(255, reference[i] + 2);
+                } else {
+                    reference[i] = std::max(0, reference[i] - 1);
+                }
+                if (reference[i] >= config.promote_score) {
+                    locked[i] = true;
+                    reference[i] = kDefectScoreLocked;
+                }
+            }
+        }
+
+        Observe(detector, image, kW, kH, dark, config);
+        for (uint32_t y = 0; y < kH; ++y) {
+            for (uint32_t x = 0; x < kW; ++x) {
+                ASSERT_EQ(detector.Score(x, y), reference[y * kW + x])
+                    << "frame " << frame << " pixel " << x << "," << y;
+            }
+        }
+    }
+    EXPECT_FALSE(detector.TakePromoted().empty());
+}
+
+// =============================================================================
+// Throughput
+// =============================================================================
+
+TEST(DefectDetectorTest, Overhead9MP) {
+    constexpr uint32_t kW = 3072;
+    constexpr uint32_t kH = 3072;
+    std::mt19937 rng(1);
+    const std::vector<uint16_t> image = MakeFlat(kW, kH, 20000, 200, rng);
+    DefectDetector detector;
+
+    auto best_us = [&](bool dark) {
+        Observe(detector, image, kW, kH, dark);                    // Warm-up
+        double best = 1e12;
+        for (int i = 0; i < 4; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            Observe(detector, image, kW, kH, dark);
+            best = std::min(best, std::chrono::duration<double, std::micro>(
+                                      std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    RecordProperty("defect_detection_9mp_us_clinical", static_cast<int>(best_us(false)));
+    RecordProperty("defect_detection_9mp_us_dark", static_cast<int>(best_us(true)));
+    EXPECT_TRUE(detector.TakePromoted().empty());
+}
@@ -0,0 +1,217 @@
+/**
+ * @file test_hot_swap_engine.cpp
+ * @brief Unit tests for staged engine reload (HotSwapEngine)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Engine plugin lifecycle tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Staging: frames keep being processed by the old engine while the new
+ *   one initialises; the swap costs the next frame well under a millisecond
+ * - Swap: only at a frame boundary; the new engine gets the last config
+ * - Drain: the old engine is shut down and destroyed off the frame thread
+ * - Failure: failed create or Initialize keeps the current engine;
+ *   a second reload is refused while one is pending
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/HotSwapEngine.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+/**
+ * @brief Minimal engine recording which instance processed a frame
+ */
+class FakeEngine : public IImageProcessingEngine {
+public:
+    struct Counters {
+        std::atomic<int> frames{0};
+        std::atomic<int> shutdowns{0};
+        std::atomic<int> destroyed{0};
+        std::atomic<uint32_t> init_width{0};
+    };
+
+    FakeEngine(std::string version, Counters& counters,
+               std::chrono::milliseconds init_delay = std::chrono::milliseconds(0),
+               bool init_ok = true)
+        : version_(std::move(version)), counters_(counters),
+          init_delay_(init_delay), init_ok_(init_ok) {}
+
+    ~FakeEngine() override { ++counters_.destroyed; }
+
+    bool Initialize(const EngineConfig& config) override {
+        std::this_thread::sleep_for(init_delay_);
+        counters_.init_width = config.max_frame_width;
+        return init_ok_;
+    }
+    void Shutdown() override { ++counters_.shutdowns; }
+
+    bool ApplyOffsetCorrection(ImageBuffer&, const CalibrationData&) override { return true; }
+    bool ApplyGainCorrection(ImageBuffer&, const CalibrationData&) override { return true; }
+    bool ApplyDefectPixelMap(ImageBuffer&, const DefectMap&) override { return true; }
+    bool ApplyScatterCorrection(ImageBuffer&, const ScatterParams&) override { return true; }
+    bool ApplyWindowLevel(ImageBuffer&, float, float) override { return true; }
+    bool ApplyNoiseReduction(ImageBuffer&, const NoiseReductionConfig&) override { return true; }
+    bool ApplyFlattening(ImageBuffer&, const FlatteningConfig&) override { return true; }
+    bool ProcessFrame(ImageBuffer&, const ProcessingConfig&) override {
+        ++counters_.frames;
+        return true;
+    }
+
+    EngineInfo GetEngineInfo() const override {
+        EngineInfo info;
+        info.engine_name = "FakeEngine";
+        info.engine_version = version_;
+        return info;
+    }
+    EngineError GetLastError() const override { return EngineError{}; }
+    StageTiming GetLastTiming() const override { return StageTiming{}; }
+
+private:
+    std::string version_;
+    Counters& counters_;
+    std::chrono::milliseconds init_delay_;
+    bool init_ok_;
+};
+
+class HotSwapEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        engine_ = std::make_unique<HotSwapEngine>(
+            std::make_shared<FakeEngine>("1.0.0", old_counters_));
+        EngineConfig config;
+        config.max_frame_width = 512;
+        config.max_frame_height = 512;
+        ASSERT_TRUE(engine_->Initialize(config));
+    }
+
+    HotSwapEngine::EngineCreator NewEngine(std::chrono::milliseconds init_delay,
+                                           bool init_ok = true) {
+        return [this, init_delay, init_ok]() {
+            return std::make_shared<FakeEngine>("2.0.0", new_counters_, init_delay, init_ok);
+        };
+    }
+
+    FakeEngine::Counters old_counters_;
+    FakeEngine::Counters new_counters_;
+    std::unique_ptr<HotSwapEngine> engine_;
+    ImageBuffer frame_;
+    ProcessingConfig processing_;
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// Staging and Swap
+// =============================================================================
+
+TEST_F(HotSwapEngineTest, OldEngineProcessesWhileNewOneInitialises) {
+    ASSERT_TRUE(engine_->StageReload(NewEngine(std::chrono::milliseconds(200))));
+
+    // Frames keep flowing through the old engine during Initialize()
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(engine_->ProcessFrame(frame_, processing_));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(old_counters_.frames, 10);
+    EXPECT_EQ(new_counters_.frames, 0);
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "1.0.0");
+
+    // Next frame after staging completes runs on the new engine
+    while (engine_->GetSwapStats().last_stage_us == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(engine_->ProcessFrame(frame_, processing_));
+    EXPECT_EQ(new_counters_.frames, 1);
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "2.0.0");
+    EXPECT_EQ(new_counters_.init_width, 512u);
+
+    ASSERT_TRUE(engine_->WaitForReload(5000));
+    EXPECT_EQ(old_counters_.shutdowns, 1);
+    EXPECT_EQ(old_counters_.destroyed, 1);
+
+    EngineSwapStats stats = engine_->GetSwapStats();
+    EXPECT_EQ(stats.reloads_completed, 1u);
+    EXPECT_GE(stats.last_stage_us, 200000);
+    EXPECT_LT(stats.last_swap_ns, 1000000);
+    RecordProperty("stage_us", std::to_string(stats.last_stage_us));
+    RecordProperty("swap_ns", std::to_string(stats.last_swap_ns));
+}
+
+TEST_F(HotSwapEngineTest, IndividualStagesSwapOnlyOnCommit) {
+    ASSERT_TRUE(engine_->StageReload(NewEngine(std::chrono::milliseconds(0))));
+    while (engine_->GetSwapStats().last_stage_us == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Apply*() never switch engines mid-frame
+    EXPECT_TRUE(engine_->ApplyOffsetCorrection(frame_, CalibrationData{}));
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "1.0.0");
+
+    EXPECT_TRUE(engine_->CommitReload());
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "2.0.0");
+    EXPECT_FALSE(engine_->CommitReload());
+    ASSERT_TRUE(engine_->WaitForReload(5000));
+}
+
+// =============================================================================
+// Failure
+// =============================================================================
+
+TEST_F(HotSwapEngineTest, FailedInitializeKeepsCurrentEngine) {
+    ASSERT_TRUE(engine_->StageReload(NewEngine(std::chrono::milliseconds(0), false)));
+    ASSERT_TRUE(engine_->WaitForReload(5000));
+
+    EXPECT_TRUE(engine_->ProcessFrame(frame_, processing_));
+    EXPECT_EQ(old_counters_.frames, 1);
+    EXPECT_EQ(engine_->GetSwapStats().reloads_failed, 1u);
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "1.0.0");
+}
+
+TEST_F(HotSwapEngineTest, MissingPluginKeepsCurrentEngine) {
+    ASSERT_TRUE(engine_->StageReload("/nonexistent/engine_plugin.so"));
+    ASSERT_TRUE(engine_->WaitForReload(5000));
+
+    EXPECT_EQ(engine_->GetSwapStats().reloads_failed, 1u);
+    EXPECT_EQ(engine_->GetEngineInfo().engine_version, "1.0.0");
+}
+
+TEST_F(HotSwapEngineTest, SecondReloadRefusedWhilePending) {
+    ASSERT_TRUE(engine_->StageReload(NewEngine(std::chrono::milliseconds(100))));
+    EXPECT_FALSE(engine_->StageReload(NewEngine(std::chrono::milliseconds(0))));
+    EXPECT_FALSE(engine_->WaitForReload(20));
+
+    EXPECT_TRUE(engine_->ProcessFrame(frame_, processing_));
+    while (!engine_->CommitReload()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(engine_->WaitForReload(5000));
+    EXPECT_TRUE(engine_->StageReload(NewEngine(std::chrono::milliseconds(0))));
+}
+
+TEST_F(HotSwapEngineTest, ReloadRequiresInitializedEngine) {
+    engine_->Shutdown();
+    EXPECT_FALSE(engine_->StageReload(NewEngine(std::chrono::milliseconds(0))));
+}
+
+// =============================================================================
+// Plugin Loading
+// =============================================================================
+
+TEST(EngineFactoryTest, CreateSharedFromNonExistentPluginReturnsNull) {
+    EXPECT_EQ(EngineFactory::CreateSharedFromPlugin("/nonexistent/plugin.so"), nullptr);
+}
+
+TEST(EngineFactoryTest, CreateSharedFromInvalidPluginReturnsNull) {
+    EXPECT_EQ(EngineFactory::CreateSharedFromPlugin("/etc/passwd"), nullptr);
+}
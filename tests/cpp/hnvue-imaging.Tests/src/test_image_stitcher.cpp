@@ -0,0 +1,358 @@
+/**
+ * @file test_image_stitcher.cpp
+ * @brief Unit tests for long-length stitching (ImageStitcher)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Long-length image composition tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Input and configuration validation
+ * - Registration recovers table position errors; the composite reproduces
+ *   the scene
+ * - Featureless overlaps keep the geometric placement
+ * - Collimation limits the composed rows and columns
+ * - Seams are feathered between the overlapping frames
+ * - Streaming and buffer composition agree for any thread count
+ * - 3 x 9 MP stitch time (recorded as test properties)
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/ImageStitcher.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+constexpr float kPitch = 0.15f;
+
+/**
+ * @brief Smooth random structure plus fine texture
+ */
+std::vector<uint16_t> MakeScene(uint32_t width, uint32_t height, uint32_t seed = 17) {
+    constexpr uint32_t kCell = 24;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coarse(8000.0f, 40000.0f);
+    std::uniform_int_distribution<int> fine(-300, 300);
+
+    const uint32_t gw = width / kCell + 2;
+    const uint32_t gh = height / kCell + 2;
+    std::vector<float> grid(static_cast<size_t>(gw) * gh);
+    for (float& v : grid) {
+        v = coarse(rng);
+    }
+    std::vector<uint16_t> scene(static_cast<size_t>(width) * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint32_t gy = y / kCell;
+        const float ty = static_cast<float>(y % kCell) / kCell;
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t gx = x / kCell;
+            const float tx = static_cast<float>(x % kCell) / kCell;
+            const float top = grid[gy * gw + gx] * (1 - tx) + grid[gy * gw + gx + 1] * tx;
+            const float bottom =
+                grid[(gy + 1) * gw + gx] * (1 - tx) + grid[(gy + 1) * gw + gx + 1] * tx;
+            scene[static_cast<size_t>(y) * width + x] =
+                static_cast<uint16_t>(top * (1 - ty) + bottom * ty + fine(rng));
+        }
+    }
+    return scene;
+}
+
+/**
+ * @brief Frame cut from a scene at (x, y) with a padded stride
+ */
+struct Cut {
+    std::vector<uint16_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride_pixels = 0;
+
+    Cut(const std::vector<uint16_t>& scene, uint32_t scene_width,
+        uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+        : pixels(static_cast<size_t>(w + 5) * h), width(w), height(h), stride_pixels(w + 5) {
+        for (uint32_t r = 0; r < h; ++r) {
+            std::copy_n(scene.begin() + static_cast<size_t>(y + r) * scene_width + x, w,
+                        pixels.begin() + static_cast<size_t>(r) * stride_pixels);
+        }
+    }
+
+    StitchFrame Frame(float longitudinal_mm, float lateral_mm) const {
+        StitchFrame frame;
+        frame.data = pixels.data();
+        frame.width = width;
+        frame.height = height;
+        frame.stride = stride_pixels * sizeof(uint16_t);
+        frame.table_longitudinal_mm = longitudinal_mm;
+        frame.table_lateral_mm = lateral_mm;
+        return frame;
+    }
+};
+
+StitchConfig Config(uint32_t threads = 0) {
+    StitchConfig config;
+    config.pixel_pitch_mm = kPitch;
+    config.threads = threads;
+    return config;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+TEST(ImageStitcherTest, RejectsInvalidInput) {
+    const std::vector<uint16_t> scene = MakeScene(128, 256);
+    const Cut top(scene, 128, 0, 0, 128, 160);
+    const Cut bottom(scene, 128, 0, 96, 128, 160);
+    ImageStitcher stitcher;
+
+    EXPECT_FALSE(stitcher.Plan({}, Config()));
+
+    StitchConfig config = Config();
+    config.pixel_pitch_mm = 0.0f;
+    EXPECT_FALSE(stitcher.Plan({top.Frame(0, 0)}, config));
+    config = Config();
+    config.downsample = kStitchMaxDownsample + 1;
+    EXPECT_FALSE(stitcher.Plan({top.Frame(0, 0)}, config));
+
+    StitchFrame bad = top.Frame(0, 0);
+    bad.stride = 10;
+    EXPECT_FALSE(stitcher.Plan({bad}, Config()));
+
+    // Not in table order
+    EXPECT_FALSE(stitcher.Plan({top.Frame(20, 0), bottom.Frame(10, 0)}, Config()));
+
+    // Collimated to nothing
+    StitchFrame closed = top.Frame(0, 0);
+    closed.collimator_left_mm = 0.01f;
+    closed.collimator_right_mm = 0.01f;
+    EXPECT_FALSE(stitcher.Plan({closed}, Config()));
+
+    EXPECT_EQ(stitcher.Width(), 0u);
+    std::vector<uint16_t> out(16);
+    EXPECT_FALSE(stitcher.Compose(out.data(), 32));
+}
+
+// =============================================================================
+// Registration
+// =============================================================================
+
+TEST(ImageStitcherTest, RegistrationRecoversTablePositionErrors) {
+    constexpr uint32_t kSceneW = 420;
+    constexpr uint32_t kSceneH = 1000;
+    constexpr uint32_t kFrameW = 400;
+    constexpr uint32_t kFrameH = 400;
+    const std::vector<uint16_t> scene = MakeScene(kSceneW, kSceneH);
+
+    // True positions, and table readings off by up to 11 pixels
+    const uint32_t xs[] = {10, 4, 17};
+    const uint32_t ys[] = {0, 290, 600};
+    const int errors_x[] = {0, 5, -3};
+    const int errors_y[] = {0, -11, 7};
+    std::vector<Cut> cuts;
+    std::vector<StitchFrame> frames;
+    for (int i = 0; i < 3; ++i) {
+        cuts.emplace_back(scene, kSceneW, xs[i], ys[i], kFrameW, kFrameH);
+    }
+    for (int i = 0; i < 3; ++i) {
+        frames.push_back(cuts[i].Frame((ys[i] + errors_y[i]) * kPitch,
+                                       (xs[i] + errors_x[i]) * kPitch));
+    }
+
+    for (uint32_t threads : {1u, 3u}) {
+        ImageStitcher stitcher;
+        ASSERT_TRUE(stitcher.Plan(frames, Config(threads)));
+        const auto& placements = stitcher.Placements();
+        ASSERT_EQ(placements.size(), 3u);
+
+        const int32_t x0 = placements[0].x - static_cast<int32_t>(xs[0]);
+        const int32_t y0 = placements[0].y - static_cast<int32_t>(ys[0]);
+        for (int i = 1; i < 3; ++i) {
+            EXPECT_TRUE(placements[i].registered) << i;
+            EXPECT_GT(placements[i].peak, 0.2f);
+            EXPECT_EQ(placements[i].x - x0, static_cast<int32_t>(xs[i])) << i;
+            EXPECT_EQ(placements[i].y - y0, static_cast<int32_t>(ys[i])) << i;
+        }
+        EXPECT_EQ(stitcher.Height(), ys[2] + kFrameH);
+        EXPECT_EQ(stitcher.Width(), 17u + kFrameW - 4u);
+
+        // Every covered composite pixel is the scene pixel, seams included
+        std::vector<uint16_t> composite(static_cast<size_t>(stitcher.Width()) * stitcher.Height());
+        ASSERT_TRUE(stitcher.Compose(composite.data(), stitcher.Width() * 2));
+        const uint32_t scene_x0 = 4;
+        for (uint32_t y = 0; y < stitcher.Height(); ++y) {
+            for (uint32_t x = 0; x < stitcher.Width(); ++x) {
+                bool covered = false;
+                for (int i = 0; i < 3; ++i) {
+                    const uint32_t sx = x + scene_x0;
+                    covered |= sx >= xs[i] && sx < xs[i] + kFrameW &&
+                               y >= ys[i] && y < ys[i] + kFrameH;
+                }
+                const uint16_t expected =
+                    covered ? scene[static_cast<size_t>(y) * kSceneW + x + scene_x0] : 0;
+                ASSERT_EQ(composite[static_cast<size_t>(y) * stitcher.Width() + x], expected)
+                    << "pixel " << x << "," << y;
+            }
+        }
+    }
+}
+
+TEST(ImageStitcherTest, FeaturelessOverlapKeepsGeometricPlacement) {
+    constexpr uint32_t kW = 200;
+    std::vector<uint16_t> flat(static_cast<size_t>(kW) * 600, 5000);
+    const Cut top(flat, kW, 0, 0, kW, 300);
+    const Cut bottom(flat, kW, 0, 200, kW, 300);
+
+    ImageStitcher stitcher;
+    ASSERT_TRUE(stitcher.Plan({top.Frame(0, 0), bottom.Frame(203 * kPitch, 0)}, Config()));
+    EXPECT_FALSE(stitcher.Placements()[1].registered);
+    EXPECT_EQ(stitcher.Placements()[1].y, 203);
+    EXPECT_EQ(stitcher.Placements()[1].correction_y, 0);
+    EXPECT_EQ(stitcher.Height(), 503u);
+}
+
+// =============================================================================
+// Composition
+// =============================================================================
+
+TEST(ImageStitcherTest, CollimationLimitsComposedField) {
+    constexpr uint32_t kW = 160;
+    constexpr uint32_t kH = 200;
+    std::vector<uint16_t> scene(kW * kH, 1000);
+    const Cut cut(scene, kW, 0, 0, kW, kH);
+    StitchFrame frame = cut.Frame(0, 0);
+    frame.collimator_left_mm = 40 * kPitch;     // Columns 40 .. 110
+    frame.collimator_right_mm = 30 * kPitch;
+    frame.collimator_top_mm = 50 * kPitch;      // Rows 50 .. 160
+    frame.collimator_bottom_mm = 60 * kPitch;
+
+    ImageStitcher stitcher;
+    ASSERT_TRUE(stitcher.Plan({frame}, Config()));
+    EXPECT_EQ(stitcher.Width(), 70u);
+    EXPECT_EQ(stitcher.Height(), 110u);
+    EXPECT_EQ(stitcher.Placements()[0].first_column, 40u);
+    EXPECT_EQ(stitcher.Placements()[0].end_row, 160u);
+}
+
+TEST(ImageStitcherTest, SeamIsFeathered) {
+    constexpr uint32_t kW = 64;
+    std::vector<uint16_t> dark(static_cast<size_t>(kW) * 200, 1000);
+    std::vector<uint16_t> bright(static_cast<size_t>(kW) * 200, 3000);
+    const Cut top(dark, kW, 0, 0, kW, 200);
+    const Cut bottom(bright, kW, 0, 0, kW, 200);
+
+    StitchConfig config = Config();
+    config.feather = 40;
+    ImageStitcher stitcher;
+    // Overlap rows 100 .. 200, seam at 150, blended over 130 .. 170
+    ASSERT_TRUE(stitcher.Plan({top.Frame(0, 0), bottom.Frame(100 * kPitch, 0)}, config));
+    ASSERT_EQ(stitcher.Height(), 300u);
+
+    std::vector<uint16_t> column;
+    ASSERT_TRUE(stitcher.Compose([&](uint32_t, const uint16_t* row) {
+        column.push_back(row[kW / 2]);
+    }));
+    ASSERT_EQ(column.size(), 300u);
+    EXPECT_EQ(column[129], 1000u);
+    EXPECT_EQ(column[170], 3000u);
+    EXPECT_NEAR(column[150], 2000, 60);
+    for (uint32_t y = 130; y < 170; ++y) {
+        EXPECT_GE(column[y], column[y - 1]);
+    }
+
+    config.feather = 0;
+    ASSERT_TRUE(stitcher.Plan({top.Frame(0, 0), bottom.Frame(100 * kPitch, 0)}, config));
+    column.clear();
+    ASSERT_TRUE(stitcher.Compose([&](uint32_t, const uint16_t* row) {
+        column.push_back(row[0]);
+    }));
+    EXPECT_EQ(column[149], 1000u);
+    EXPECT_EQ(column[150], 3000u);
+}
+
+TEST(ImageStitcherTest, StreamingMatchesBufferForAnyThreadCount) {
+    constexpr uint32_t kSceneW = 300;
+    const std::vector<uint16_t> scene = MakeScene(kSceneW, 700, 5);
+    const Cut a(scene, kSceneW, 0, 0, 280, 300);
+    const Cut b(scene, kSceneW, 20, 250, 280, 300);
+    const Cut c(scene, kSceneW, 6, 400, 280, 300);
+    const std::vector<StitchFrame> frames = {
+        a.Frame(0, 0), b.Frame(253 * kPitch, 18 * kPitch), c.Frame(398 * kPitch, 6 * kPitch)};
+
+    ImageStitcher reference;
+    ASSERT_TRUE(reference.Plan(frames, Config(1)));
+    const uint32_t w = reference.Width();
+    const uint32_t h = reference.Height();
+    std::vector<uint16_t> streamed(static_cast<size_t>(w) * h);
+    uint32_t next_row = 0;
+    ASSERT_TRUE(reference.Compose([&](uint32_t y, const uint16_t* row) {
+        EXPECT_EQ(y, next_row++);
+        std::copy_n(row, w, streamed.begin() + static_cast<size_t>(y) * w);
+    }));
+    EXPECT_EQ(next_row, h);
+
+    for (uint32_t threads : {1u, 2u, 7u}) {
+        ImageStitcher stitcher;
+        ASSERT_TRUE(stitcher.Plan(frames, Config(threads)));
+        ASSERT_EQ(stitcher.Width(), w);
+        ASSERT_EQ(stitcher.Height(), h);
+
+        // Padded destination rows
+        const uint32_t stride = w + 3;
+        std::vector<uint16_t> buffer(static_cast<size_t>(stride) * h, 0xBEEF);
+        ASSERT_TRUE(stitcher.Compose(buffer.data(), stride * 2));
+        for (uint32_t y = 0; y < h; ++y) {
+            ASSERT_TRUE(std::equal(streamed.begin() + static_cast<size_t>(y) * w,
+                                   streamed.begin() + static_cast<size_t>(y + 1) * w,
+                                   buffer.begin() + static_cast<size_t>(y) * stride))
+                << threads << " threads, row " << y;
+            ASSERT_EQ(buffer[static_cast<size_t>(y) * stride + w], 0xBEEF);
+        }
+    }
+}
+
+// =============================================================================
+// Throughput
+// =============================================================================
+
+TEST(ImageStitcherTest, ThreeFrames9MP) {
+    constexpr uint32_t kFrame = 3072;
+    constexpr uint32_t kStep = 2600;
+    const std::vector<uint16_t> scene = MakeScene(kFrame, kFrame + 2 * kStep, 3);
+    std::vector<Cut> cuts;
+    std::vector<StitchFrame> frames;
+    for (uint32_t i = 0; i < 3; ++i) {
+        cuts.emplace_back(scene, kFrame, 0, i * kStep, kFrame, kFrame);
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        frames.push_back(cuts[i].Frame((i * kStep + (i == 1 ? 9 : 0)) * kPitch, 0));
+    }
+
+    ImageStitcher stitcher;
+    std::vector<uint16_t> composite;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(stitcher.Plan(frames, Config()));
+    const auto planned = std::chrono::steady_clock::now();
+    composite.resize(static_cast<size_t>(stitcher.Width()) * stitcher.Height());
+    ASSERT_TRUE(stitcher.Compose(composite.data(), stitcher.Width() * 2));
+    const auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(stitcher.Height(), kFrame + 2 * kStep);
+    EXPECT_TRUE(stitcher.Placements()[1].registered);
+    EXPECT_EQ(stitcher.Placements()[1].y, static_cast<int32_t>(kStep));
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    RecordProperty("stitch_3x9mp_register_ms", static_cast<int>(Ms(planned - start).count()));
+    RecordProperty("stitch_3x9mp_compose_ms", static_cast<int>(Ms(end - planned).count()));
+    RecordProperty("threads", static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+}
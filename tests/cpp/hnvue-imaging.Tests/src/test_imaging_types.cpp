@@ -326,6 +326,7 @@ TEST(ProcessingConfigTest, DefaultInitialization) {
     EXPECT_FALSE(config.noise_reduction.enabled);
     EXPECT_FALSE(config.flattening.enabled);
     EXPECT_EQ(config.mode, ProcessingMode::FULL_PIPELINE);
+    EXPECT_EQ(config.precision, WorkingPrecision::UINT16_STAGES);
     EXPECT_TRUE(config.preserve_raw);  // FR-IMG-11: Must be true by default
 }
 
@@ -430,6 +431,16 @@ TEST(StageTimingTest, TotalMethod) {
 TEST(StageTimingTest, TotalWithZeroValues) {
     StageTiming timing;
     EXPECT_EQ(timing.Total(), 0);
+    EXPECT_EQ(timing.TotalBytes(), 0);
+}
+
+TEST(StageTimingTest, TotalBytesMethod) {
+    StageTiming timing;
+    timing.offset_correction_bytes = 1000;
+    timing.flattening_bytes = 500;
+    timing.window_level_bytes = 24;
+
+    EXPECT_EQ(timing.TotalBytes(), 1524);
 }
 
 // =============================================================================
@@ -43,6 +43,10 @@ protected:
     std::vector<float> dark_data_;
     std::vector<float> gain_data_;
     std::vector<DefectPixelEntry> defect_entries_;
+    // Descriptors returned by reference: configs keep pointers to them
+    CalibrationData dark_calibration_;
+    CalibrationData gain_calibration_;
+    DefectMap defect_map_;
 
     void SetUp() override {
         engine_ = std::make_unique<DefaultImageProcessingEngine>();
@@ -119,8 +123,9 @@ protected:
         return buffer;
     }
 
-    CalibrationData CreateDarkCalibration() {
-        CalibrationData dark;
+    CalibrationData& CreateDarkCalibration() {
+        CalibrationData& dark = dark_calibration_;
+        dark = CalibrationData{};
         dark.type = CalibrationDataType::DARK_FRAME;
         dark.width = TEST_WIDTH;
         dark.height = TEST_HEIGHT;
@@ -131,8 +136,9 @@ protected:
         return dark;
     }
 
-    CalibrationData CreateGainCalibration() {
-        CalibrationData gain;
+    CalibrationData& CreateGainCalibration() {
+        CalibrationData& gain = gain_calibration_;
+        gain = CalibrationData{};
         gain.type = CalibrationDataType::GAIN_MAP;
         gain.width = TEST_WIDTH;
         gain.height = TEST_HEIGHT;
@@ -143,12 +149,13 @@ protected:
         return gain;
     }
 
-    DefectMap CreateDefectMap() {
-        DefectMap map;
+    DefectMap& CreateDefectMap() {
+        DefectMap& map = defect_map_;
+        map = DefectMap{};
         map.count = static_cast<uint32_t>(defect_entries_.size());
         map.pixels = defect_entries_.data();
         map.valid = true;
-        map.checksum = 0DEFECT01;
+        map.checksum = 0xDEFEC701;
         return map;
     }
 
@@ -0,0 +1,389 @@
+/**
+ * @file test_output_writer.cpp
+ * @brief Unit tests for the fused display output transform (OutputWriter)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Display frame output tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Output geometry and rejection of invalid crops and shutters
+ * - Every rotation / flip combination against a naive reference
+ * - Rectangular and circular shutter fill
+ * - Unflipped, unrotated u16 crop written in place
+ * - f32 source rounding, saturation and NaN handling
+ * - Tiled transposition of a frame larger than one tile
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/OutputWriter.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+namespace {
+
+constexpr uint16_t kFill = 0xABCD;
+
+/**
+ * @brief Source frame where pixel (x, y) holds y * 256 + x
+ */
+std::vector<uint16_t> MakeFrame(uint32_t width, uint32_t height, uint32_t stride_pixels) {
+    std::vector<uint16_t> frame(static_cast<size_t>(stride_pixels) * height, 0xFFFF);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            frame[y * stride_pixels + x] = static_cast<uint16_t>(y * 256 + x);
+        }
+    }
+    return frame;
+}
+
+std::vector<uint16_t> IdentityLut() {
+    std::vector<uint16_t> lut(65536);
+    std::iota(lut.begin(), lut.end(), 0);
+    return lut;
+}
+
+bool InsideShutter(const OutputTransform& t, uint32_t x, uint32_t y) {
+    switch (t.shutter) {
+        case ShutterShape::RECTANGULAR:
+            return x >= t.shutter_left && x < t.shutter_right &&
+                   y >= t.shutter_top && y < t.shutter_bottom;
+        case ShutterShape::CIRCULAR: {
+            const double dx = x + 0.5 - t.shutter_center_x;
+            const double dy = y + 0.5 - t.shutter_center_y;
+            return dx * dx + dy * dy <= static_cast<double>(t.shutter_radius) * t.shutter_radius;
+        }
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Crop, flip, rotate clockwise and mask, one pixel at a time
+ */
+std::vector<uint16_t> Reference(const std::vector<uint16_t>& frame, uint32_t width,
+                                uint32_t height, uint32_t stride_pixels,
+                                const OutputTransform& t, uint32_t& out_width,
+                                uint32_t& out_height) {
+    const uint32_t cw = t.crop_width ? t.crop_width : width - t.crop_x;
+    const uint32_t ch = t.crop_height ? t.crop_height : height - t.crop_y;
+    const bool transposed = t.rotation == OutputRotation::ROTATE_90 ||
+                            t.rotation == OutputRotation::ROTATE_270;
+    out_width = transposed ? ch : cw;
+    out_height = transposed ? cw : ch;
+
+    std::vector<uint16_t> out(static_cast<size_t>(out_width) * out_height);
+    for (uint32_t oy = 0; oy < out_height; ++oy) {
+        for (uint32_t ox = 0; ox < out_width; ++ox) {
+            uint32_t u = ox;
+            uint32_t v = oy;
+            switch (t.rotation) {
+                case OutputRotation::ROTATE_90:  u = oy;          v = ch - 1 - ox; break;
+                case OutputRotation::ROTATE_180: u = cw - 1 - ox; v = ch - 1 - oy; break;
+                case OutputRotation::ROTATE_270: u = cw - 1 - oy; v = ox;          break;
+                default: break;
+            }
+            if (t.flip_horizontal) u = cw - 1 - u;
+            if (t.flip_vertical) v = ch - 1 - v;
+            const uint32_t x = t.crop_x + u;
+            const uint32_t y = t.crop_y + v;
+            out[oy * out_width + ox] = InsideShutter(t, x, y)
+                ? frame[y * stride_pixels + x] : t.shutter_value;
+        }
+    }
+    return out;
+}
+
+std::vector<uint16_t> Write(const std::vector<uint16_t>& frame, uint32_t width,
+                            uint32_t height, uint32_t stride_pixels,
+                            const OutputTransform& t, OutputWriter& writer) {
+    static const std::vector<uint16_t> lut = IdentityLut();
+    EXPECT_TRUE(writer.Prepare(t, width, height));
+    std::vector<uint16_t> out(static_cast<size_t>(writer.OutputWidth()) * writer.OutputHeight());
+    writer.WriteU16(frame.data() + t.crop_y * stride_pixels + t.crop_x,
+                    stride_pixels * sizeof(uint16_t), lut.data(),
+                    out.data(), writer.OutputWidth() * sizeof(uint16_t));
+    return out;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Geometry
+// =============================================================================
+
+TEST(OutputGeometryTest, CropAndRotationDetermineOutputSize) {
+    OutputTransform t;
+    uint32_t w = 0;
+    uint32_t h = 0;
+
+    ASSERT_TRUE(ComputeOutputGeometry(t, 100, 60, w, h));
+    EXPECT_EQ(w, 100u);
+    EXPECT_EQ(h, 60u);
+
+    t.crop_x = 10;
+    t.crop_y = 5;
+    ASSERT_TRUE(ComputeOutputGeometry(t, 100, 60, w, h));
+    EXPECT_EQ(w, 90u);
+    EXPECT_EQ(h, 55u);
+
+    t.crop_width = 30;
+    t.crop_height = 20;
+    t.rotation = OutputRotation::ROTATE_90;
+    ASSERT_TRUE(ComputeOutputGeometry(t, 100, 60, w, h));
+    EXPECT_EQ(w, 20u);
+    EXPECT_EQ(h, 30u);
+}
+
+TEST(OutputGeometryTest, RejectsInvalidTransforms) {
+    uint32_t w = 0;
+    uint32_t h = 0;
+
+    OutputTransform t;
+    EXPECT_FALSE(ComputeOutputGeometry(t, 0, 10, w, h));
+
+    t.crop_x = 100;
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+
+    t = OutputTransform{};
+    t.crop_x = 50;
+    t.crop_width = 51;
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+
+    t = OutputTransform{};
+    t.rotation = static_cast<OutputRotation>(7);
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+
+    t = OutputTransform{};
+    t.shutter = ShutterShape::RECTANGULAR;
+    t.shutter_left = 20;
+    t.shutter_right = 10;
+    t.shutter_bottom = 5;
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+
+    t = OutputTransform{};
+    t.shutter = ShutterShape::CIRCULAR;
+    t.shutter_radius = -1.0f;
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+    t.shutter_radius = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_FALSE(ComputeOutputGeometry(t, 100, 60, w, h));
+}
+
+TEST(OutputGeometryTest, IdentityDefaults) {
+    OutputTransform t;
+    EXPECT_TRUE(t.IsIdentity());
+    t.flip_vertical = true;
+    EXPECT_FALSE(t.IsIdentity());
+}
+
+// =============================================================================
+// Orientation
+// =============================================================================
+
+TEST(OutputWriterTest, EveryRotationAndFlipMatchesReference) {
+    constexpr uint32_t kW = 23;
+    constexpr uint32_t kH = 17;
+    constexpr uint32_t kStride = 29;
+    const std::vector<uint16_t> frame = MakeFrame(kW, kH, kStride);
+    OutputWriter writer;
+
+    for (int r = 0; r < 4; ++r) {
+        for (int flips = 0; flips < 4; ++flips) {
+            OutputTransform t;
+            t.crop_x = 3;
+            t.crop_y = 2;
+            t.crop_width = 15;
+            t.crop_height = 11;
+            t.rotation = static_cast<OutputRotation>(r);
+            t.flip_horizontal = (flips & 1) != 0;
+            t.flip_vertical = (flips & 2) != 0;
+
+            uint32_t rw = 0;
+            uint32_t rh = 0;
+            const auto expected = Reference(frame, kW, kH, kStride, t, rw, rh);
+            const auto actual = Write(frame, kW, kH, kStride, t, writer);
+            EXPECT_EQ(writer.OutputWidth(), rw);
+            EXPECT_EQ(writer.OutputHeight(), rh);
+            EXPECT_EQ(actual, expected) << "rotation " << r << " flips " << flips;
+        }
+    }
+}
+
+TEST(OutputWriterTest, Rotate90IsClockwise) {
+    // 2x1 source [a b] becomes a 1x2 column [a; b] rotated clockwise
+    const std::vector<uint16_t> frame = {1, 2};
+    OutputTransform t;
+    t.rotation = OutputRotation::ROTATE_90;
+    OutputWriter writer;
+    const auto out = Write(frame, 2, 1, 2, t, writer);
+    ASSERT_EQ(writer.OutputWidth(), 1u);
+    ASSERT_EQ(writer.OutputHeight(), 2u);
+    EXPECT_EQ(out, (std::vector<uint16_t>{1, 2}));
+
+    // 2x2: [1 2; 3 4] -> [3 1; 4 2]
+    const std::vector<uint16_t> square = {1, 2, 3, 4};
+    EXPECT_EQ(Write(square, 2, 2, 2, t, writer), (std::vector<uint16_t>{3, 1, 4, 2}));
+}
+
+TEST(OutputWriterTest, TransposesFramesLargerThanOneTile) {
+    constexpr uint32_t kW = kOutputTile * 3 + 5;
+    constexpr uint32_t kH = kOutputTile * 2 + 9;
+    const std::vector<uint16_t> frame = MakeFrame(kW, kH, kW);
+    OutputWriter writer;
+
+    for (OutputRotation rotation : {OutputRotation::ROTATE_90, OutputRotation::ROTATE_270}) {
+        OutputTransform t;
+        t.rotation = rotation;
+        t.crop_x = 1;
+        uint32_t rw = 0;
+        uint32_t rh = 0;
+        const auto expected = Reference(frame, kW, kH, kW, t, rw, rh);
+        EXPECT_EQ(Write(frame, kW, kH, kW, t, writer), expected);
+    }
+}
+
+// =============================================================================
+// Shutter
+// =============================================================================
+
+TEST(OutputWriterTest, RectangularShutterFillsOutside) {
+    constexpr uint32_t kW = 40;
+    constexpr uint32_t kH = 30;
+    const std::vector<uint16_t> frame = MakeFrame(kW, kH, kW);
+    OutputWriter writer;
+
+    for (int r = 0; r < 4; ++r) {
+        OutputTransform t;
+        t.crop_x = 2;
+        t.crop_y = 4;
+        t.crop_width = 33;
+        t.crop_height = 21;
+        t.rotation = static_cast<OutputRotation>(r);
+        t.flip_horizontal = r == 1;
+        t.shutter = ShutterShape::RECTANGULAR;
+        t.shutter_left = 0;          // Left edge outside the crop
+        t.shutter_top = 9;
+        t.shutter_right = 20;
+        t.shutter_bottom = 100;      // Bottom edge outside the frame
+        t.shutter_value = kFill;
+
+        uint32_t rw = 0;
+        uint32_t rh = 0;
+        const auto expected = Reference(frame, kW, kH, kW, t, rw, rh);
+        EXPECT_EQ(Write(frame, kW, kH, kW, t, writer), expected) << "rotation " << r;
+    }
+}
+
+TEST(OutputWriterTest, CircularShutterFillsOutside) {
+    constexpr uint32_t kW = 48;
+    constexpr uint32_t kH = 40;
+    const std::vector<uint16_t> frame = MakeFrame(kW, kH, kW);
+    OutputWriter writer;
+
+    for (int r = 0; r < 4; ++r) {
+        for (bool flip : {false, true}) {
+            OutputTransform t;
+            t.crop_x = 5;
+            t.crop_y = 3;
+            t.rotation = static_cast<OutputRotation>(r);
+            t.flip_vertical = flip;
+            t.shutter = ShutterShape::CIRCULAR;
+            t.shutter_center_x = 21.3f;
+            t.shutter_center_y = 18.8f;
+            t.shutter_radius = 13.7f;
+            t.shutter_value = kFill;
+
+            uint32_t rw = 0;
+            uint32_t rh = 0;
+            const auto expected = Reference(frame, kW, kH, kW, t, rw, rh);
+            const auto actual = Write(frame, kW, kH, kW, t, writer);
+            EXPECT_EQ(actual, expected) << "rotation " << r << " flip " << flip;
+        }
+    }
+}
+
+TEST(OutputWriterTest, ShutterOutsideFrameFillsEverything) {
+    const std::vector<uint16_t> frame = MakeFrame(8, 8, 8);
+    OutputTransform t;
+    t.shutter = ShutterShape::CIRCULAR;
+    t.shutter_center_x = 100.0f;
+    t.shutter_center_y = 100.0f;
+    t.shutter_radius = 3.0f;
+    t.shutter_value = kFill;
+    OutputWriter writer;
+    EXPECT_EQ(Write(frame, 8, 8, 8, t, writer), std::vector<uint16_t>(64, kFill));
+}
+
+// =============================================================================
+// In-place u16 and f32 Sources
+// =============================================================================
+
+TEST(OutputWriterTest, CropWrittenInPlaceThroughLut) {
+    constexpr uint32_t kW = 20;
+    constexpr uint32_t kH = 12;
+    constexpr uint32_t kStride = 24;
+    std::vector<uint16_t> frame = MakeFrame(kW, kH, kStride);
+    const std::vector<uint16_t> original = frame;
+
+    std::vector<uint16_t> lut(65536);
+    for (size_t v = 0; v < lut.size(); ++v) {
+        lut[v] = static_cast<uint16_t>(65535 - v);
+    }
+
+    OutputTransform t;
+    t.crop_x = 4;
+    t.crop_y = 3;
+    t.crop_width = 10;
+    t.crop_height = 7;
+    t.shutter = ShutterShape::RECTANGULAR;
+    t.shutter_left = 6;
+    t.shutter_top = 3;
+    t.shutter_right = 14;
+    t.shutter_bottom = 9;
+    t.shutter_value = kFill;
+
+    OutputWriter writer;
+    ASSERT_TRUE(writer.Prepare(t, kW, kH));
+    ASSERT_TRUE(writer.CanWriteInPlace());
+    writer.WriteU16(frame.data() + t.crop_y * kStride + t.crop_x, kStride * 2, lut.data(),
+                    frame.data(), writer.OutputWidth() * 2);
+
+    uint32_t rw = 0;
+    uint32_t rh = 0;
+    auto expected = Reference(original, kW, kH, kStride, t, rw, rh);
+    for (uint16_t& v : expected) {
+        v = v == kFill ? kFill : lut[v];
+    }
+    EXPECT_EQ(std::vector<uint16_t>(frame.begin(), frame.begin() + rw * rh), expected);
+
+    t.flip_horizontal = true;
+    ASSERT_TRUE(writer.Prepare(t, kW, kH));
+    EXPECT_FALSE(writer.CanWriteInPlace());
+}
+
+TEST(OutputWriterTest, FloatSourceRoundsAndSaturates) {
+    const std::vector<float> plane = {
+        -5.0f, 0.4f, 0.5f, 1.49f,
+        100.5f, 65534.6f, 70000.0f, std::numeric_limits<float>::quiet_NaN()};
+
+    OutputTransform t;
+    t.rotation = OutputRotation::ROTATE_180;
+    OutputWriter writer;
+    ASSERT_TRUE(writer.Prepare(t, 4, 2));
+
+    std::vector<uint16_t> out(8, 0x1234);
+    writer.WriteF32(plane.data(), 4 * sizeof(float), 1.0f, 0.0f, out.data(), 4 * 2);
+    EXPECT_EQ(out, (std::vector<uint16_t>{0, 65535, 65535, 101, 1, 1, 0, 0}));
+
+    // Scale and offset are applied before rounding
+    writer.WriteF32(plane.data(), 4 * sizeof(float), 2.0f, 10.0f, out.data(), 4 * 2);
+    EXPECT_EQ(out[3], 211u);
+    EXPECT_EQ(out[7], 0u);
+}
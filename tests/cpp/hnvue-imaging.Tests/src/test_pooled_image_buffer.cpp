@@ -0,0 +1,98 @@
+/**
+ * @file test_pooled_image_buffer.cpp
+ * @brief Unit tests for pool-backed ImageBuffer (PooledImageBuffer.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Image processing frame memory tests
+ * SPDX-License-Identifier: MIT
+ *
+ * Tests:
+ * - Acquire: zero dimensions rejected, row stride cache-line aligned
+ * - Clone: pixels, timestamp and frame id copied across differing strides
+ * - Reuse: released frames are served again without system allocation
+ */
+
+#include <gtest/gtest.h>
+#include <hnvue/imaging/PooledImageBuffer.h>
+#include <vector>
+
+using namespace hnvue::imaging;
+
+/**
+ * @brief Fixture with a private frame pool so statistics are isolated
+ */
+class PooledImageBufferTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t TEST_WIDTH = 1001;  // odd width: stride padding
+    static constexpr uint32_t TEST_HEIGHT = 64;
+
+    hnvue::infra::FramePool pool_;
+};
+
+TEST_F(PooledImageBufferTest, RejectsZeroDimensions) {
+    PooledImageBuffer frame;
+    EXPECT_FALSE(AcquirePooledImageBuffer(0, TEST_HEIGHT, frame, pool_));
+    EXPECT_FALSE(AcquirePooledImageBuffer(TEST_WIDTH, 0, frame, pool_));
+    EXPECT_FALSE(frame);
+}
+
+TEST_F(PooledImageBufferTest, RowsAreCacheLineAligned) {
+    PooledImageBuffer frame;
+    ASSERT_TRUE(AcquirePooledImageBuffer(TEST_WIDTH, TEST_HEIGHT, frame, pool_));
+
+    EXPECT_EQ(frame.view.width, TEST_WIDTH);
+    EXPECT_EQ(frame.view.height, TEST_HEIGHT);
+    EXPECT_EQ(frame.view.pixel_depth, 16);
+    EXPECT_GE(frame.view.stride, TEST_WIDTH * 2);
+    EXPECT_EQ(frame.view.stride % hnvue::infra::kCacheLineSize, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame.view.data) % hnvue::infra::kCacheLineSize, 0u);
+}
+
+TEST_F(PooledImageBufferTest, CloneCopiesPixelsAndMetadata) {
+    std::vector<uint16_t> source_pixels(TEST_WIDTH * TEST_HEIGHT);
+    for (size_t i = 0; i < source_pixels.size(); ++i) {
+        source_pixels[i] = static_cast<uint16_t>(i * 7);
+    }
+    ImageBuffer source;
+    source.width = TEST_WIDTH;
+    source.height = TEST_HEIGHT;
+    source.stride = TEST_WIDTH * 2;
+    source.data = source_pixels.data();
+    source.timestamp_us = 123456;
+    source.frame_id = 42;
+
+    PooledImageBuffer copy;
+    ASSERT_TRUE(ClonePooledImageBuffer(source, copy, pool_));
+    EXPECT_EQ(copy.view.timestamp_us, 123456u);
+    EXPECT_EQ(copy.view.frame_id, 42u);
+
+    for (uint32_t y = 0; y < TEST_HEIGHT; y += 13) {
+        const auto* row = reinterpret_cast<const uint16_t*>(
+            reinterpret_cast<const uint8_t*>(copy.view.data) + y * copy.view.stride);
+        for (uint32_t x = 0; x < TEST_WIDTH; x += 97) {
+            EXPECT_EQ(row[x], source_pixels[y * TEST_WIDTH + x]);
+        }
+    }
+
+    ImageBuffer empty;
+    PooledImageBuffer unused;
+    EXPECT_FALSE(ClonePooledImageBuffer(empty, unused, pool_));
+}
+
+TEST_F(PooledImageBufferTest, ReleasedFramesAreReused) {
+    {
+        PooledImageBuffer frame;
+        ASSERT_TRUE(AcquirePooledImageBuffer(TEST_WIDTH, TEST_HEIGHT, frame, pool_));
+        PooledImageBuffer shared = frame;
+        EXPECT_EQ(frame.storage.UseCount(), 2u);
+    }
+    uint64_t allocations = pool_.GetStats().system_allocations;
+
+    for (int i = 0; i < 20; ++i) {
+        PooledImageBuffer frame;
+        ASSERT_TRUE(AcquirePooledImageBuffer(TEST_WIDTH, TEST_HEIGHT, frame, pool_));
+    }
+    EXPECT_EQ(pool_.GetStats().system_allocations, allocations);
+    EXPECT_EQ(pool_.GetStats().blocks_in_use, 0u);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_clock.cpp
+ * @brief GTest unit tests for the monotonic timestamp service (Clock.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: timestamp time base
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   now():          monotonic across threads / agrees with steady_clock
+ *   NowUs():        consistent with NowNs()
+ *   Wall mapping:   ToWallClockUs / FromWallClockUs round trip and match
+ *                   system_clock at the time of the call
+ *   Read cost:      average read time reported (bounded loosely)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hnvue/infra/Clock.h"
+
+using namespace hnvue::infra;
+
+// =============================================================================
+// Monotonicity
+// =============================================================================
+
+TEST(MonotonicClockTest, NeverRunsBackwards) {
+    int64_t previous = MonotonicClock::NowNs();
+    for (int i = 0; i < 100000; ++i) {
+        int64_t current = MonotonicClock::NowNs();
+        ASSERT_GE(current, previous);
+        previous = current;
+    }
+}
+
+TEST(MonotonicClockTest, MonotonicAcrossThreads) {
+    // Each thread publishes its latest read; any later read on any thread
+    // must not be earlier than a value already published
+    std::atomic<int64_t> published{0};
+    std::atomic<bool> backwards{false};
+
+    auto worker = [&]() {
+        for (int i = 0; i < 20000; ++i) {
+            int64_t seen = published.load(std::memory_order_acquire);
+            int64_t now = MonotonicClock::NowNs();
+            if (now < seen) {
+                backwards.store(true);
+            }
+            int64_t expected = seen;
+            while (now > expected &&
+                   !published.compare_exchange_weak(expected, now, std::memory_order_acq_rel)) {
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(backwards.load());
+}
+
+TEST(MonotonicClockTest, AgreesWithSteadyClock) {
+    // Calibrate first: its ~10 ms sleep would otherwise count only on the steady side
+    MonotonicClock::Initialize();
+    auto steady_start = std::chrono::steady_clock::now();
+    auto start = MonotonicClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto elapsed = MonotonicClock::now() - start;
+    auto steady_elapsed = std::chrono::steady_clock::now() - steady_start;
+
+    auto diff_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        elapsed - steady_elapsed).count();
+    // Calibration error well under 0.5% over 50 ms, plus scheduling noise
+    EXPECT_LT(std::llabs(diff_us), 1000);
+    EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 49);
+}
+
+TEST(MonotonicClockTest, MicrosecondsMatchNanoseconds) {
+    int64_t ns = MonotonicClock::NowNs();
+    int64_t us = MonotonicClock::NowUs();
+    EXPECT_GE(us, ns / 1000);
+    EXPECT_LT(us - ns / 1000, 10000);
+    EXPECT_GE(SinceStartUs(), us);
+}
+
+// =============================================================================
+// Wall-Clock Mapping
+// =============================================================================
+
+TEST(MonotonicClockTest, WallClockMatchesSystemClock) {
+    int64_t system_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    int64_t mapped_us = WallClockNowUs();
+    // Only an NTP step during the test run could exceed this
+    EXPECT_LT(std::llabs(mapped_us - system_us), 100000);
+}
+
+TEST(MonotonicClockTest, WallClockRoundTrip) {
+    int64_t since_start = SinceStartUs();
+    int64_t wall = MonotonicClock::ToWallClockUs(since_start);
+    EXPECT_EQ(MonotonicClock::FromWallClockUs(wall), since_start);
+    EXPECT_EQ(MonotonicClock::ToWallClockUs(0) + 1000, MonotonicClock::ToWallClockUs(1000));
+}
+
+// =============================================================================
+// Read Cost
+// =============================================================================
+
+TEST(MonotonicClockTest, ReadCostIsLow) {
+    MonotonicClock::Initialize();
+    constexpr int kReads = 1000000;
+
+    auto start = std::chrono::steady_clock::now();
+    int64_t sink = 0;
+    for (int i = 0; i < kReads; ++i) {
+        sink ^= MonotonicClock::NowNs();
+    }
+    auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    double per_read_ns = static_cast<double>(elapsed_ns) / kReads;
+
+    volatile int64_t keep = sink;  // Reads are not optimised away
+    (void)keep;
+
+    RecordProperty("source", MonotonicClock::IsTscBased() ? "TSC" : "steady_clock");
+    RecordProperty("ns_per_read", std::to_string(per_read_ns));
+    RecordProperty("tsc_ghz", std::to_string(MonotonicClock::TscFrequencyHz() / 1e9));
+
+    if (MonotonicClock::IsTscBased()) {
+        EXPECT_GT(MonotonicClock::TscFrequencyHz(), 1e8);
+    } else {
+        EXPECT_EQ(MonotonicClock::TscFrequencyHz(), 0.0);
+    }
+    // Loose bound so sanitizer and virtualized builds pass
+    EXPECT_LT(per_read_ns, 1000.0);
+}
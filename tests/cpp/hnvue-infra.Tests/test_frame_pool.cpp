@@ -0,0 +1,325 @@
+/**
+ * @file test_frame_pool.cpp
+ * @brief GTest unit tests for FramePool, FrameHandle and PoolAllocator
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: frame memory management
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   SizeClassOf:      minimum class / exact class boundary / between classes / unpooled
+ *   Acquire:          zero bytes / pooled size / unpooled size / cache-line and page alignment
+ *   Release:          last handle returns block / copies keep block alive / cache limit exceeded
+ *   Reserve:          pre-populated blocks served without system allocation
+ *   Statistics:       high-water bytes and blocks / ResetHighWater
+ *   PoolAllocator:    vector growth / release through a different pool instance
+ *   Huge pages:       requested (served with or without explicit huge pages)
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "hnvue/infra/FramePool.h"
+
+using namespace hnvue::infra;
+
+namespace {
+
+constexpr size_t kFrameBytes = 3072 * 3072 * 2;  // 18 MiB detector frame
+
+bool IsAligned(const void* ptr, size_t alignment) {
+    return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Size Classes
+// =============================================================================
+
+/**
+ * @test Size classes are 25% apart and always cover the request
+ */
+TEST(FramePoolSizeClassTest, ClassesCoverRequest) {
+    EXPECT_EQ(FramePool::SizeClassOf(1), 0u);
+    EXPECT_EQ(FramePool::SizeClassOf(kMinSizeClassBytes), 0u);
+    EXPECT_EQ(FramePool::SizeClassBytes(0), kMinSizeClassBytes);
+    EXPECT_EQ(FramePool::SizeClassBytes(FramePool::SizeClassOf(4097)), 5120u);
+    EXPECT_EQ(FramePool::SizeClassBytes(FramePool::SizeClassOf(8192)), 8192u);
+
+    for (size_t bytes : {size_t{4097}, size_t{100000}, kFrameBytes, size_t{1} << 29}) {
+        uint32_t size_class = FramePool::SizeClassOf(bytes);
+        ASSERT_NE(size_class, kUnpooledClass);
+        size_t capacity = FramePool::SizeClassBytes(size_class);
+        EXPECT_GE(capacity, bytes);
+        EXPECT_LT(capacity, bytes + bytes / 4 + 1);
+    }
+}
+
+/**
+ * @test Requests above the largest class are not pooled
+ */
+TEST(FramePoolSizeClassTest, OversizeIsUnpooled) {
+    size_t largest = FramePool::SizeClassBytes(kNumSizeClasses - 1);
+    EXPECT_NE(FramePool::SizeClassOf(largest), kUnpooledClass);
+    EXPECT_EQ(FramePool::SizeClassOf(largest + 1), kUnpooledClass);
+}
+
+// =============================================================================
+// Acquire / Release
+// =============================================================================
+
+/**
+ * @test Zero-byte request yields an empty handle
+ */
+TEST(FramePoolTest, ZeroBytesIsEmpty) {
+    FramePool pool;
+    FrameHandle handle = pool.Acquire(0);
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(handle.Data(), nullptr);
+    EXPECT_EQ(handle.UseCount(), 0u);
+}
+
+/**
+ * @test Buffers honour cache-line and page alignment
+ */
+TEST(FramePoolTest, Alignment) {
+    FramePool line_pool;
+    FramePoolConfig page_config;
+    page_config.alignment = kPageSize;
+    FramePool page_pool(page_config);
+
+    for (size_t bytes : {size_t{100}, size_t{5000}, kFrameBytes}) {
+        FrameHandle a = line_pool.Acquire(bytes);
+        FrameHandle b = page_pool.Acquire(bytes);
+        ASSERT_TRUE(a);
+        ASSERT_TRUE(b);
+        EXPECT_TRUE(IsAligned(a.Data(), kCacheLineSize));
+        EXPECT_TRUE(IsAligned(b.Data(), kPageSize));
+        EXPECT_EQ(a.Size(), bytes);
+        EXPECT_GE(a.Capacity(), bytes);
+        std::memset(a.Data(), 0xA5, a.Capacity());
+        std::memset(b.Data(), 0x5A, b.Capacity());
+    }
+}
+
+/**
+ * @test Invalid alignment is raised to cache-line alignment
+ */
+TEST(FramePoolTest, InvalidAlignmentCorrected) {
+    FramePoolConfig config;
+    config.alignment = 48;
+    FramePool pool(config);
+    EXPECT_EQ(pool.GetAlignment(), kCacheLineSize);
+}
+
+/**
+ * @test Released block is reused: steady state performs no system allocation
+ */
+TEST(FramePoolTest, SteadyStateReusesBlocks) {
+    FramePool pool;
+
+    for (int i = 0; i < 3; ++i) {
+        FrameHandle warmup = pool.Acquire(kFrameBytes);
+        ASSERT_TRUE(warmup);
+    }
+    uint64_t allocations = pool.GetStats().system_allocations;
+    EXPECT_EQ(allocations, 1u);
+
+    for (int i = 0; i < 100; ++i) {
+        FrameHandle frame = pool.Acquire(kFrameBytes - static_cast<size_t>(i));
+        ASSERT_TRUE(frame);
+        frame.Data()[0] = static_cast<uint8_t>(i);
+    }
+
+    FramePoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.system_allocations, allocations);
+    EXPECT_EQ(stats.pool_hits, 102u);
+    EXPECT_EQ(stats.blocks_in_use, 0u);
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+    EXPECT_GT(stats.bytes_cached, 0u);
+}
+
+/**
+ * @test Copies share the block; it returns to the pool after the last reset
+ */
+TEST(FramePoolTest, RefCountedHandles) {
+    FramePool pool;
+    FrameHandle first = pool.Acquire(8192);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.UseCount(), 1u);
+
+    FrameHandle second = first;
+    EXPECT_EQ(first.UseCount(), 2u);
+    EXPECT_EQ(second.Data(), first.Data());
+
+    FrameHandle moved = std::move(second);
+    EXPECT_FALSE(second);
+    EXPECT_EQ(moved.UseCount(), 2u);
+
+    first.Reset();
+    EXPECT_EQ(moved.UseCount(), 1u);
+    EXPECT_EQ(pool.GetStats().blocks_in_use, 1u);
+
+    moved.Reset();
+    EXPECT_EQ(pool.GetStats().blocks_in_use, 0u);
+    EXPECT_EQ(pool.GetStats().bytes_cached, 8192u);
+}
+
+/**
+ * @test Blocks beyond the cache limit are freed instead of cached
+ */
+TEST(FramePoolTest, CacheLimitRespected) {
+    FramePoolConfig config;
+    config.max_cached_bytes = 16384;
+    FramePool pool(config);
+
+    {
+        FrameHandle a = pool.Acquire(16384);
+        FrameHandle b = pool.Acquire(16384);
+    }
+    EXPECT_EQ(pool.GetStats().bytes_cached, 16384u);
+
+    pool.Trim();
+    EXPECT_EQ(pool.GetStats().bytes_cached, 0u);
+}
+
+/**
+ * @test Oversize blocks are freed on release
+ */
+TEST(FramePoolTest, UnpooledNotCached) {
+    FramePool pool;
+    size_t bytes = FramePool::SizeClassBytes(kNumSizeClasses - 1) + 1;
+    // Do not touch the pages: only the bookkeeping is under test
+    {
+        FrameHandle big = pool.Acquire(bytes);
+        if (!big) {
+            GTEST_SKIP() << "Cannot reserve address space for oversize block";
+        }
+        EXPECT_EQ(pool.GetStats().blocks_in_use, 1u);
+    }
+    EXPECT_EQ(pool.GetStats().blocks_in_use, 0u);
+    EXPECT_EQ(pool.GetStats().bytes_cached, 0u);
+}
+
+/**
+ * @test Reserve() pre-populates the free list
+ */
+TEST(FramePoolTest, ReserveAvoidsFirstFrameAllocation) {
+    FramePool pool;
+    ASSERT_TRUE(pool.Reserve(kFrameBytes, 4));
+    uint64_t allocations = pool.GetStats().system_allocations;
+    EXPECT_EQ(allocations, 4u);
+
+    std::vector<FrameHandle> frames;
+    for (int i = 0; i < 4; ++i) {
+        frames.push_back(pool.Acquire(kFrameBytes));
+    }
+    EXPECT_EQ(pool.GetStats().system_allocations, allocations);
+    EXPECT_EQ(pool.GetStats().pool_hits, 4u);
+
+    EXPECT_FALSE(pool.Reserve(0, 1));
+}
+
+/**
+ * @test High-water marks track peak usage and can be reset
+ */
+TEST(FramePoolTest, HighWaterTracking) {
+    FramePool pool;
+    size_t capacity = FramePool::SizeClassBytes(FramePool::SizeClassOf(kFrameBytes));
+    {
+        FrameHandle a = pool.Acquire(kFrameBytes);
+        FrameHandle b = pool.Acquire(kFrameBytes);
+        FrameHandle c = pool.Acquire(kFrameBytes);
+    }
+    FramePoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.high_water_blocks, 3u);
+    EXPECT_EQ(stats.high_water_bytes, 3 * capacity);
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+
+    pool.ResetHighWater();
+    EXPECT_EQ(pool.GetStats().high_water_blocks, 0u);
+    EXPECT_EQ(pool.GetStats().high_water_bytes, 0u);
+}
+
+/**
+ * @test Concurrent acquire/release from several threads keeps counters consistent
+ */
+TEST(FramePoolTest, ConcurrentAcquireRelease) {
+    FramePool pool;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            for (int i = 0; i < 500; ++i) {
+                FrameHandle handle = pool.Acquire(65536 + static_cast<size_t>(t) * 4096);
+                ASSERT_TRUE(handle);
+                handle.Data()[0] = static_cast<uint8_t>(i);
+                FrameHandle copy = handle;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    FramePoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.blocks_in_use, 0u);
+    EXPECT_EQ(stats.acquisitions, 2000u);
+    EXPECT_LE(stats.system_allocations, 4u * 4u);
+}
+
+/**
+ * @test Huge-page request is served (explicit huge pages or THP fallback)
+ */
+TEST(FramePoolTest, HugePageBacking) {
+    FramePoolConfig config;
+    config.use_huge_pages = true;
+    FramePool pool(config);
+
+    FrameHandle frame = pool.Acquire(kFrameBytes);
+    ASSERT_TRUE(frame);
+    EXPECT_TRUE(IsAligned(frame.Data(), kCacheLineSize));
+    std::memset(frame.Data(), 0, frame.Size());
+    EXPECT_LE(pool.GetStats().huge_page_blocks, 1u);
+}
+
+// =============================================================================
+// PoolAllocator
+// =============================================================================
+
+/**
+ * @test Vector storage comes from the pool and is reused after destruction
+ */
+TEST(PoolAllocatorTest, VectorUsesPool) {
+    FramePool pool;
+    {
+        PooledVector<uint8_t> pixels{PoolAllocator<uint8_t>(pool)};
+        pixels.resize(kFrameBytes);
+        EXPECT_TRUE(IsAligned(pixels.data(), kCacheLineSize));
+        EXPECT_EQ(pool.GetStats().blocks_in_use, 1u);
+    }
+    EXPECT_EQ(pool.GetStats().blocks_in_use, 0u);
+
+    uint64_t allocations = pool.GetStats().system_allocations;
+    for (int i = 0; i < 10; ++i) {
+        PooledVector<uint8_t> pixels{PoolAllocator<uint8_t>(pool)};
+        pixels.resize(kFrameBytes);
+    }
+    EXPECT_EQ(pool.GetStats().system_allocations, allocations);
+}
+
+/**
+ * @test Default-constructed vectors draw from the default pool and support copy
+ */
+TEST(PoolAllocatorTest, DefaultPoolVector) {
+    PooledVector<uint16_t> a(1024, 7);
+    PooledVector<uint16_t> b = a;
+    EXPECT_EQ(b.size(), 1024u);
+    EXPECT_EQ(b[1023], 7);
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_TRUE(a.get_allocator() == b.get_allocator());
+}
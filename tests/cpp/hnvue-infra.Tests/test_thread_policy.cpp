@@ -0,0 +1,346 @@
+/**
+ * @file test_thread_policy.cpp
+ * @brief GTest unit tests for real-time thread policy (ThreadPolicy.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Infrastructure: thread scheduling configuration
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   ThreadPolicyRegistry: set / get / replace / remove / clear
+ *   ApplyThreadPolicy:    default class (no-op) / invalid priority / invalid CPU /
+ *                         valid affinity / stack prefault / FIFO (privilege dependent)
+ *   ApplyNamedThreadPolicy: unregistered name / registered name
+ *   ParseCpuList:         single / range / mixed / malformed
+ *
+ * The jitter probe is a cyclictest-style measurement: a periodic thread
+ * sleeps to absolute deadlines while memcpy load threads run on every CPU,
+ * and the wake-up latency distribution is recorded. Real-time assertions
+ * only apply when SCHED_FIFO could be obtained; otherwise the run is
+ * reported and skipped.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "hnvue/infra/ThreadPolicy.h"
+
+using namespace hnvue::infra;
+
+// =============================================================================
+// Registry
+// =============================================================================
+
+class ThreadPolicyRegistryTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        ThreadPolicyRegistry::Instance().Clear();
+    }
+};
+
+/**
+ * @test Registered policy is returned unchanged
+ */
+TEST_F(ThreadPolicyRegistryTest, SetAndGetPolicy) {
+    ThreadPolicy policy;
+    policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+    policy.priority = 80;
+    policy.cpu_affinity = {2, 3};
+    policy.stack_prefault_bytes = 32 * 1024;
+
+    ThreadPolicyRegistry::Instance().SetPolicy("hal.aec", policy);
+
+    ThreadPolicy out;
+    ASSERT_TRUE(ThreadPolicyRegistry::Instance().GetPolicy("hal.aec", out));
+    EXPECT_EQ(out.scheduling, SchedulingClass::SCHED_CLASS_FIFO);
+    EXPECT_EQ(out.priority, 80);
+    EXPECT_EQ(out.cpu_affinity, (std::vector<int32_t>{2, 3}));
+    EXPECT_EQ(out.stack_prefault_bytes, 32u * 1024u);
+}
+
+/**
+ * @test Unknown name, replacement and removal
+ */
+TEST_F(ThreadPolicyRegistryTest, ReplaceRemoveAndClear) {
+    auto& registry = ThreadPolicyRegistry::Instance();
+    ThreadPolicy out;
+    EXPECT_FALSE(registry.GetPolicy("missing", out));
+
+    ThreadPolicy policy;
+    policy.priority = 10;
+    registry.SetPolicy("a", policy);
+    policy.priority = 20;
+    registry.SetPolicy("a", policy);
+    registry.SetPolicy("b", policy);
+
+    ASSERT_TRUE(registry.GetPolicy("a", out));
+    EXPECT_EQ(out.priority, 20);
+    EXPECT_EQ(registry.GetNames().size(), 2u);
+
+    registry.RemovePolicy("a");
+    EXPECT_FALSE(registry.GetPolicy("a", out));
+
+    registry.Clear();
+    EXPECT_TRUE(registry.GetNames().empty());
+}
+
+// =============================================================================
+// Policy Application
+// =============================================================================
+
+/**
+ * @test Default policy applies without privileges
+ */
+TEST(ThreadPolicyTest, DefaultPolicyIsNoOp) {
+    std::thread worker([] {
+        ThreadPolicyReport report = ApplyThreadPolicy(ThreadPolicy{});
+        EXPECT_TRUE(report.AllApplied());
+    });
+    worker.join();
+}
+
+/**
+ * @test Out-of-range real-time priority is rejected before any syscall
+ */
+TEST(ThreadPolicyTest, InvalidPriorityRejected) {
+    std::thread worker([] {
+        ThreadPolicy policy;
+        policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+        policy.priority = 0;
+        EXPECT_EQ(ApplyThreadPolicy(policy).scheduling, ThreadPolicyResult::POLICY_ERR_PARAM);
+
+        policy.priority = kMaxRealtimePriority + 1;
+        EXPECT_EQ(ApplyThreadPolicy(policy).scheduling, ThreadPolicyResult::POLICY_ERR_PARAM);
+    });
+    worker.join();
+}
+
+/**
+ * @test Negative CPU index is rejected
+ */
+TEST(ThreadPolicyTest, InvalidCpuRejected) {
+    std::thread worker([] {
+        ThreadPolicy policy;
+        policy.cpu_affinity = {-1};
+        EXPECT_EQ(ApplyThreadPolicy(policy).affinity, ThreadPolicyResult::POLICY_ERR_PARAM);
+    });
+    worker.join();
+}
+
+/**
+ * @test Pinning to CPU 0 succeeds (always present)
+ */
+TEST(ThreadPolicyTest, AffinityToCpuZero) {
+    std::thread worker([] {
+        ThreadPolicy policy;
+        policy.cpu_affinity = {0};
+        ThreadPolicyResult result = ApplyThreadPolicy(policy).affinity;
+        if (result == ThreadPolicyResult::POLICY_ERR_NOT_SUPPORTED) {
+            GTEST_SKIP() << "CPU affinity not supported on this platform";
+        }
+        EXPECT_EQ(result, ThreadPolicyResult::POLICY_OK);
+    });
+    worker.join();
+}
+
+/**
+ * @test Stack prefault within limit succeeds, oversize request rejected
+ */
+TEST(ThreadPolicyTest, StackPrefault) {
+    std::thread worker([] {
+        ThreadPolicy policy;
+        policy.stack_prefault_bytes = 64 * 1024;
+        EXPECT_EQ(ApplyThreadPolicy(policy).stack_prefault, ThreadPolicyResult::POLICY_OK);
+
+        policy.stack_prefault_bytes = 64 * 1024 * 1024;
+        EXPECT_EQ(ApplyThreadPolicy(policy).stack_prefault, ThreadPolicyResult::POLICY_ERR_PARAM);
+    });
+    worker.join();
+}
+
+/**
+ * @test SCHED_FIFO is applied and visible, or refused with a permission error
+ */
+TEST(ThreadPolicyTest, FifoAppliedOrPermissionDenied) {
+    std::thread worker([] {
+        ThreadPolicy policy;
+        policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+        policy.priority = 10;
+        ThreadPolicyResult result = ApplyThreadPolicy(policy).scheduling;
+        if (result == ThreadPolicyResult::POLICY_ERR_PERMISSION) {
+            GTEST_SKIP() << "No real-time privilege (CAP_SYS_NICE / RLIMIT_RTPRIO)";
+        }
+        ASSERT_EQ(result, ThreadPolicyResult::POLICY_OK);
+
+        ThreadPolicy current;
+        ASSERT_EQ(GetCurrentThreadScheduling(current), ThreadPolicyResult::POLICY_OK);
+        EXPECT_EQ(current.scheduling, SchedulingClass::SCHED_CLASS_FIFO);
+        EXPECT_EQ(current.priority, 10);
+    });
+    worker.join();
+}
+
+/**
+ * @test Unregistered role name applies nothing and reports OK
+ */
+TEST(ThreadPolicyTest, NamedPolicyUnregistered) {
+    std::thread worker([] {
+        EXPECT_TRUE(ApplyNamedThreadPolicy("test.unregistered").AllApplied());
+    });
+    worker.join();
+}
+
+/**
+ * @test Registered role name applies its policy
+ */
+TEST(ThreadPolicyTest, NamedPolicyRegistered) {
+    ThreadPolicy policy;
+    policy.stack_prefault_bytes = 16 * 1024;
+    policy.cpu_affinity = {-5};
+    ThreadPolicyRegistry::Instance().SetPolicy("test.named", policy);
+
+    std::thread worker([] {
+        ThreadPolicyReport report = ApplyNamedThreadPolicy("test.named");
+        EXPECT_EQ(report.stack_prefault, ThreadPolicyResult::POLICY_OK);
+        EXPECT_EQ(report.affinity, ThreadPolicyResult::POLICY_ERR_PARAM);
+    });
+    worker.join();
+
+    ThreadPolicyRegistry::Instance().RemovePolicy("test.named");
+}
+
+// =============================================================================
+// CPU List Parsing
+// =============================================================================
+
+/**
+ * @test Kernel cpulist format is parsed, sorted and de-duplicated
+ */
+TEST(ParseCpuListTest, ValidLists) {
+    EXPECT_TRUE(ParseCpuList("").empty());
+    EXPECT_TRUE(ParseCpuList("\n").empty());
+    EXPECT_EQ(ParseCpuList("3"), (std::vector<int32_t>{3}));
+    EXPECT_EQ(ParseCpuList("2-4"), (std::vector<int32_t>{2, 3, 4}));
+    EXPECT_EQ(ParseCpuList("6,2-3\n"), (std::vector<int32_t>{2, 3, 6}));
+    EXPECT_EQ(ParseCpuList("1,1-2"), (std::vector<int32_t>{1, 2}));
+}
+
+/**
+ * @test Malformed lists yield an empty result
+ */
+TEST(ParseCpuListTest, MalformedLists) {
+    EXPECT_TRUE(ParseCpuList("a").empty());
+    EXPECT_TRUE(ParseCpuList("3-1").empty());
+    EXPECT_TRUE(ParseCpuList("-2").empty());
+    EXPECT_TRUE(ParseCpuList("1-").empty());
+}
+
+// =============================================================================
+// Jitter Probe (cyclictest-style)
+// =============================================================================
+
+namespace {
+
+struct JitterStats {
+    int64_t min_us = 0;
+    int64_t p50_us = 0;
+    int64_t p99_us = 0;
+    int64_t max_us = 0;
+};
+
+/**
+ * @brief Run a periodic wake-up loop and record latency past each deadline
+ */
+JitterStats MeasureWakeupLatency(std::chrono::microseconds period, int cycles) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<int64_t> latencies;
+    latencies.reserve(static_cast<size_t>(cycles));
+
+    auto deadline = Clock::now() + period;
+    for (int i = 0; i < cycles; ++i) {
+        std::this_thread::sleep_until(deadline);
+        auto woke = Clock::now();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(woke - deadline).count());
+        deadline += period;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    JitterStats stats;
+    stats.min_us = latencies.front();
+    stats.p50_us = latencies[latencies.size() / 2];
+    stats.p99_us = latencies[(latencies.size() * 99) / 100];
+    stats.max_us = latencies.back();
+    return stats;
+}
+
+/**
+ * @brief Memory-bandwidth load: repeated large memcpy until stopped
+ */
+void MemcpyLoad(const std::atomic<bool>& stop) {
+    constexpr size_t kBytes = 8 * 1024 * 1024;
+    std::vector<char> src(kBytes, 1);
+    std::vector<char> dst(kBytes);
+    while (!stop.load(std::memory_order_relaxed)) {
+        std::memcpy(dst.data(), src.data(), kBytes);
+        src[0] = dst[kBytes - 1];
+    }
+}
+
+} // anonymous namespace
+
+/**
+ * @test Wake-up latency of a SCHED_FIFO thread under memcpy load
+ *
+ * The percentiles are reported. The AEC budget (p99 within 500 us while
+ * every CPU is saturated by SCHED_OTHER load) is asserted only with
+ * real-time privilege and HNVUE_ISOLATED_CPU_TESTS set, i.e. on a CI host
+ * with isolated cores; elsewhere the wake-up latency is not bounded.
+ */
+TEST(ThreadPolicyJitterTest, FifoWakeupLatencyUnderLoad) {
+    std::atomic<bool> stop{false};
+    unsigned int load_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> loaders;
+    for (unsigned int i = 0; i < load_threads; ++i) {
+        loaders.emplace_back(MemcpyLoad, std::cref(stop));
+    }
+
+    bool realtime = false;
+    JitterStats stats;
+    std::thread probe([&] {
+        ThreadPolicy policy;
+        policy.scheduling = SchedulingClass::SCHED_CLASS_FIFO;
+        policy.priority = 80;
+        policy.stack_prefault_bytes = 64 * 1024;
+        realtime = ApplyThreadPolicy(policy).scheduling == ThreadPolicyResult::POLICY_OK;
+        stats = MeasureWakeupLatency(std::chrono::microseconds(1000), 1000);
+    });
+    probe.join();
+
+    stop = true;
+    for (auto& t : loaders) {
+        t.join();
+    }
+
+    RecordProperty("realtime", realtime ? 1 : 0);
+    RecordProperty("loaders", static_cast<int>(load_threads));
+    RecordProperty("min_us", static_cast<int>(stats.min_us));
+    RecordProperty("p50_us", static_cast<int>(stats.p50_us));
+    RecordProperty("p99_us", static_cast<int>(stats.p99_us));
+    RecordProperty("max_us", static_cast<int>(stats.max_us));
+
+    EXPECT_GE(stats.min_us, 0);
+    if (!realtime || std::getenv("HNVUE_ISOLATED_CPU_TESTS") == nullptr) {
+        GTEST_SKIP() << "Needs real-time privilege and HNVUE_ISOLATED_CPU_TESTS; "
+                        "latency reported but not asserted";
+    }
+    EXPECT_LT(stats.p99_us, 500);
+}
@@ -0,0 +1,381 @@
+/**
+ * @file test_hvg_status_service.cpp
+ * @brief Unit tests for HvgStatusServiceImpl and StatusStreamHub
+ * SPEC-IPC-001: Generator status streaming (hvg_control.proto)
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+// Include generated protobuf headers
+#include "hvg_control.grpc.pb.h"
+#include "hvg_control.pb.h"
+
+// Include service implementation
+#include "hnvue/ipc/HvgStatusServiceImpl.h"
+#include "hnvue/ipc/StatusStreamHub.h"
+
+using namespace hnvue::ipc;
+using hnvue::hal::hvg::AlarmRequest;
+using hnvue::hal::hvg::AlarmSeverity;
+using hnvue::hal::hvg::StatusRequest;
+
+namespace hnvue::test {
+
+/**
+ * @class RecordingSink
+ * @brief Sink that decodes and keeps every pushed message
+ */
+class RecordingSink : public StreamSink {
+public:
+    void Push(const grpc::ByteBuffer& message) override {
+        buffers.push_back(message);
+    }
+
+    template<typename T>
+    T Decode(size_t index) const {
+        T msg;
+        grpc::ByteBuffer copy = buffers.at(index);
+        EXPECT_TRUE(grpc::SerializationTraits<T>::Deserialize(&copy, &msg).ok());
+        return msg;
+    }
+
+    std::vector<grpc::ByteBuffer> buffers;
+};
+
+static HvgStatus MakeStatus(GeneratorState state, float kvp, float ma, int64_t timestamp_us,
+                            bool interlock_ok = true) {
+    HvgStatus status;
+    status.set_state(state);
+    status.set_actual_kvp(kvp);
+    status.set_actual_ma(ma);
+    status.set_interlock_ok(interlock_ok);
+    status.set_timestamp_us(timestamp_us);
+    return status;
+}
+
+static grpc::ByteBuffer MakeBuffer(int64_t timestamp_us) {
+    grpc::ByteBuffer buffer;
+    StatusStreamHub::Encode(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, timestamp_us), &buffer);
+    return buffer;
+}
+
+static int64_t TimestampOf(const grpc::ByteBuffer& buffer) {
+    HvgStatus status;
+    grpc::ByteBuffer copy = buffer;
+    grpc::SerializationTraits<HvgStatus>::Deserialize(&copy, &status);
+    return status.timestamp_us();
+}
+
+// =============================================================================
+// StreamMailbox
+// =============================================================================
+
+TEST(StreamMailboxTest, FirstOfferStartsWrite) {
+    StreamMailbox mailbox(StreamMailbox::Mode::LATEST);
+    grpc::ByteBuffer start;
+
+    EXPECT_TRUE(mailbox.Offer(MakeBuffer(1), &start));
+    EXPECT_TRUE(mailbox.IsWriting());
+    EXPECT_EQ(TimestampOf(start), 1);
+
+    // Write outstanding: nothing new is started
+    EXPECT_FALSE(mailbox.Offer(MakeBuffer(2), &start));
+    EXPECT_EQ(mailbox.Pending(), 1u);
+}
+
+TEST(StreamMailboxTest, LatestModeKeepsOnlyNewest) {
+    StreamMailbox mailbox(StreamMailbox::Mode::LATEST);
+    grpc::ByteBuffer current;
+
+    ASSERT_TRUE(mailbox.Offer(MakeBuffer(1), &current));
+    mailbox.Offer(MakeBuffer(2), &current);
+    mailbox.Offer(MakeBuffer(3), &current);
+    mailbox.Offer(MakeBuffer(4), &current);
+
+    EXPECT_EQ(mailbox.Pending(), 1u);
+    EXPECT_EQ(mailbox.Coalesced(), 2u);
+
+    ASSERT_TRUE(mailbox.Next(&current));
+    EXPECT_EQ(TimestampOf(current), 4);
+
+    // Drained: stream goes idle and the next offer starts a write again
+    EXPECT_FALSE(mailbox.Next(&current));
+    EXPECT_FALSE(mailbox.IsWriting());
+    EXPECT_TRUE(mailbox.Offer(MakeBuffer(5), &current));
+}
+
+TEST(StreamMailboxTest, QueueModeKeepsOrderAndDropsOldestBeyondDepth) {
+    StreamMailbox mailbox(StreamMailbox::Mode::QUEUE, 2);
+    grpc::ByteBuffer current;
+
+    ASSERT_TRUE(mailbox.Offer(MakeBuffer(1), &current));
+    mailbox.Offer(MakeBuffer(2), &current);
+    mailbox.Offer(MakeBuffer(3), &current);
+    mailbox.Offer(MakeBuffer(4), &current);
+
+    EXPECT_EQ(mailbox.Pending(), 2u);
+    EXPECT_EQ(mailbox.Dropped(), 1u);
+
+    ASSERT_TRUE(mailbox.Next(&current));
+    EXPECT_EQ(TimestampOf(current), 3);
+    ASSERT_TRUE(mailbox.Next(&current));
+    EXPECT_EQ(TimestampOf(current), 4);
+    EXPECT_FALSE(mailbox.Next(&current));
+}
+
+TEST(StreamMailboxTest, ClosedMailboxRejectsOffers) {
+    StreamMailbox mailbox(StreamMailbox::Mode::QUEUE);
+    grpc::ByteBuffer current;
+
+    ASSERT_TRUE(mailbox.Offer(MakeBuffer(1), &current));
+    mailbox.Offer(MakeBuffer(2), &current);
+    mailbox.Close();
+
+    EXPECT_EQ(mailbox.Pending(), 0u);
+    EXPECT_FALSE(mailbox.Offer(MakeBuffer(3), &current));
+    EXPECT_FALSE(mailbox.Next(&current));
+}
+
+// =============================================================================
+// StatusStreamHub
+// =============================================================================
+
+class StatusStreamHubTest : public ::testing::Test {
+protected:
+    StatusStreamHubTest() {
+        config_.kvp_deadband = 0.5f;
+        config_.ma_deadband = 1.0f;
+        config_.idle_keepalive_ms = 1000;
+    }
+
+    StatusStreamConfig config_;
+};
+
+TEST_F(StatusStreamHubTest, IdleUpdatesInsideDeadbandAreSuppressed) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.0f, 10.0f, 0)));
+    EXPECT_FALSE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.2f, 10.5f, 10000)));
+    EXPECT_FALSE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 79.8f, 9.5f, 20000)));
+
+    auto stats = hub.GetStats();
+    EXPECT_EQ(stats.published, 3u);
+    EXPECT_EQ(stats.forwarded, 1u);
+    EXPECT_EQ(stats.suppressed, 2u);
+    EXPECT_EQ(sink.buffers.size(), 1u);
+}
+
+TEST_F(StatusStreamHubTest, DeadbandIsMeasuredFromLastForwardedValue) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.0f, 10.0f, 0));
+    // Slow drift: each step is small but the total leaves the deadband
+    EXPECT_FALSE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.3f, 10.0f, 1000)));
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.6f, 10.0f, 2000)));
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 80.6f, 11.5f, 3000)));
+
+    ASSERT_EQ(sink.buffers.size(), 3u);
+    EXPECT_FLOAT_EQ(sink.Decode<HvgStatus>(2).actual_ma(), 11.5f);
+}
+
+TEST_F(StatusStreamHubTest, ExposureForwardsEveryUpdate) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_ARMED, 80.0f, 10.0f, 0));
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_EXPOSING, 80.0f, 10.0f, i * 100)));
+    }
+    EXPECT_EQ(sink.buffers.size(), 11u);
+    EXPECT_EQ(hub.GetStats().suppressed, 0u);
+}
+
+TEST_F(StatusStreamHubTest, StateAndInterlockChangesAreForwarded) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, 0));
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_READY, 0.0f, 0.0f, 10)));
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_READY, 0.0f, 0.0f, 20, false)));
+    EXPECT_FALSE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_READY, 0.0f, 0.0f, 30, false)));
+}
+
+TEST_F(StatusStreamHubTest, KeepaliveForwardsUnchangedStatus) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, 0));
+    EXPECT_FALSE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, 999999)));
+    EXPECT_TRUE(hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, 1000000)));
+}
+
+TEST_F(StatusStreamHubTest, OneEncodeServesAllSubscribers) {
+    StatusStreamHub hub(config_);
+    std::vector<RecordingSink> sinks(8);
+    for (auto& sink : sinks) {
+        hub.AddStatusSink(&sink);
+    }
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_EXPOSING, 100.0f, 200.0f, 42));
+
+    EXPECT_EQ(hub.GetStats().encodes, 1u);
+    EXPECT_EQ(hub.GetStats().status_subscribers, 8u);
+    for (const auto& sink : sinks) {
+        ASSERT_EQ(sink.buffers.size(), 1u);
+        EXPECT_EQ(sink.Decode<HvgStatus>(0).timestamp_us(), 42);
+    }
+}
+
+TEST_F(StatusStreamHubTest, LateSubscriberReceivesLastForwardedStatus) {
+    StatusStreamHub hub(config_);
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_READY, 70.0f, 5.0f, 7));
+
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+
+    ASSERT_EQ(sink.buffers.size(), 1u);
+    EXPECT_EQ(sink.Decode<HvgStatus>(0).state(), GeneratorState::GEN_READY);
+    EXPECT_EQ(hub.GetStats().encodes, 1u);
+}
+
+TEST_F(StatusStreamHubTest, RemovedSinkReceivesNothing) {
+    StatusStreamHub hub(config_);
+    RecordingSink sink;
+    hub.AddStatusSink(&sink);
+    hub.RemoveStatusSink(&sink);
+
+    hub.PublishStatus(MakeStatus(GeneratorState::GEN_IDLE, 0.0f, 0.0f, 0));
+    EXPECT_TRUE(sink.buffers.empty());
+    EXPECT_EQ(hub.GetStats().status_subscribers, 0u);
+}
+
+TEST_F(StatusStreamHubTest, AlarmsAreNeverFiltered) {
+    StatusStreamHub hub(config_);
+    RecordingSink status_sink;
+    RecordingSink alarm_sink;
+    hub.AddStatusSink(&status_sink);
+    hub.AddAlarmSink(&alarm_sink);
+
+    HvgAlarm alarm;
+    alarm.set_alarm_code(17);
+    alarm.set_severity(AlarmSeverity::ALARM_CRITICAL);
+    hub.PublishAlarm(alarm);
+    hub.PublishAlarm(alarm);
+
+    EXPECT_TRUE(status_sink.buffers.empty());
+    ASSERT_EQ(alarm_sink.buffers.size(), 2u);
+    EXPECT_EQ(alarm_sink.Decode<HvgAlarm>(1).alarm_code(), 17);
+    EXPECT_EQ(hub.GetStats().alarms, 2u);
+}
+
+// =============================================================================
+// HvgStatusServiceImpl over an in-process channel
+// =============================================================================
+
+class HvgStatusServiceTestFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger_ = spdlog::stdout_color_mt("test_hvg_status");
+        logger_->set_level(spdlog::level::debug);
+
+        service_ = std::make_unique<HvgStatusServiceImpl>(logger_);
+        grpc::ServerBuilder builder;
+        builder.RegisterService(service_.get());
+        server_ = builder.BuildAndStart();
+        ASSERT_NE(server_, nullptr);
+        stub_ = HvgControl::NewStub(server_->InProcessChannel(grpc::ChannelArguments()));
+    }
+
+    void TearDown() override {
+        server_->Shutdown();
+        server_.reset();
+        service_.reset();
+        spdlog::drop("test_hvg_status");
+    }
+
+    // Wait until the service has the expected number of subscribers
+    bool WaitForSubscribers(size_t status, size_t alarms) {
+        for (int i = 0; i < 200; ++i) {
+            auto stats = service_->GetStats();
+            if (stats.status_subscribers == status && stats.alarm_subscribers == alarms) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    std::shared_ptr<spdlog::logger> logger_;
+    std::unique_ptr<HvgStatusServiceImpl> service_;
+    std::unique_ptr<grpc::Server> server_;
+    std::unique_ptr<HvgControl::Stub> stub_;
+};
+
+TEST_F(HvgStatusServiceTestFixture, StreamStatusDeliversPublishedStatus) {
+    grpc::ClientContext context;
+    StatusRequest request;
+    auto reader = stub_->StreamStatus(&context, request);
+    ASSERT_TRUE(WaitForSubscribers(1, 0));
+
+    service_->PublishStatus(MakeStatus(GeneratorState::GEN_READY, 90.0f, 20.0f, 1));
+
+    HvgStatus status;
+    ASSERT_TRUE(reader->Read(&status));
+    EXPECT_EQ(status.state(), GeneratorState::GEN_READY);
+    EXPECT_FLOAT_EQ(status.actual_kvp(), 90.0f);
+
+    context.TryCancel();
+    while (reader->Read(&status)) {
+    }
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::CANCELLED);
+    EXPECT_TRUE(WaitForSubscribers(0, 0));
+}
+
+TEST_F(HvgStatusServiceTestFixture, StreamAlarmsDeliversAlarmsInOrder) {
+    grpc::ClientContext context;
+    AlarmRequest request;
+    auto reader = stub_->StreamAlarms(&context, request);
+    ASSERT_TRUE(WaitForSubscribers(0, 1));
+
+    for (int code = 1; code <= 5; ++code) {
+        HvgAlarm alarm;
+        alarm.set_alarm_code(code);
+        service_->PublishAlarm(alarm);
+    }
+
+    for (int code = 1; code <= 5; ++code) {
+        HvgAlarm alarm;
+        ASSERT_TRUE(reader->Read(&alarm));
+        EXPECT_EQ(alarm.alarm_code(), code);
+    }
+    context.TryCancel();
+}
+
+TEST_F(HvgStatusServiceTestFixture, ServerShutdownEndsOpenStreams) {
+    grpc::ClientContext context;
+    StatusRequest request;
+    auto reader = stub_->StreamStatus(&context, request);
+    ASSERT_TRUE(WaitForSubscribers(1, 0));
+
+    server_->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(100));
+
+    HvgStatus status;
+    while (reader->Read(&status)) {
+    }
+    EXPECT_FALSE(reader->Finish().ok());
+    EXPECT_EQ(service_->GetStats().status_subscribers, 0u);
+}
+
+} // namespace hnvue::test
@@ -0,0 +1,286 @@
+/**
+ * @file test_async_frame_writer.cpp
+ * @brief GTest unit tests for the asynchronous frame writer (AsyncFrameWriter.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: persistence of acquired frames
+ * SPDX-License-Identifier: MIT
+ *
+ * Every test runs against both backends (io_uring skipped where the kernel
+ * refuses io_uring_setup).
+ *
+ * Decisions exercised:
+ *   Enqueue:  not running / empty payload / queue full (never blocks)
+ *   Write:    content round trip with non block-multiple length /
+ *             9 MP raw + processed pair / unopenable path
+ *   Stop:     drains queued jobs
+ *   Stats:    bytes, queue depth high water, throughput, latency
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "hnvue/infra/Clock.h"
+#include "hnvue/storage/AsyncFrameWriter.h"
+
+using namespace hnvue::storage;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr auto kFlushTimeout = std::chrono::seconds(30);
+
+std::vector<uint8_t> ReadFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+}
+
+hnvue::infra::FrameHandle MakeFrame(size_t bytes, uint8_t seed) {
+    hnvue::infra::FrameHandle frame = hnvue::infra::FramePool::Default().Acquire(bytes);
+    uint8_t* data = frame.Data();
+    if (data == nullptr) {
+        return frame;
+    }
+    for (size_t i = 0; i < bytes; ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return frame;
+}
+
+int64_t ThreadCpuTimeUs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+const char* BackendName(StorageBackend backend) {
+    return backend == StorageBackend::STORAGE_BACKEND_IO_URING ? "IoUring" : "ThreadPool";
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Fixture parameterized by backend, with a private output directory
+ */
+class AsyncFrameWriterTest : public ::testing::TestWithParam<StorageBackend> {
+protected:
+    void SetUp() override {
+        if (GetParam() == StorageBackend::STORAGE_BACKEND_IO_URING &&
+            !AsyncFrameWriter::IsIoUringSupported()) {
+            GTEST_SKIP() << "io_uring not available";
+        }
+        dir_ = fs::temp_directory_path() /
+               ("hnvue_storage_" + std::to_string(hnvue::infra::WallClockNowUs()));
+        fs::create_directories(dir_);
+        config_.backend = GetParam();
+        config_.worker_threads = 1;
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    std::string PathFor(const std::string& name) const {
+        return (dir_ / name).string();
+    }
+
+    fs::path dir_;
+    StorageConfig config_;
+};
+
+// =============================================================================
+// Enqueue Validation
+// =============================================================================
+
+TEST_P(AsyncFrameWriterTest, RejectsWhenNotRunning) {
+    AsyncFrameWriter writer(config_);
+    EXPECT_EQ(writer.Enqueue(PathFor("a.raw"), MakeFrame(4096, 1)),
+              StorageResult::STORAGE_ERR_NOT_RUNNING);
+}
+
+TEST_P(AsyncFrameWriterTest, RejectsEmptyPayload) {
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+    EXPECT_EQ(writer.GetActiveBackend(), GetParam());
+
+    EXPECT_EQ(writer.Enqueue(PathFor("a.raw"), hnvue::infra::FrameHandle()),
+              StorageResult::STORAGE_ERR_PARAM);
+    EXPECT_EQ(writer.Enqueue("", MakeFrame(16, 1)), StorageResult::STORAGE_ERR_PARAM);
+    EXPECT_EQ(writer.Enqueue(PathFor("b.raw"), hnvue::infra::PooledVector<uint8_t>()),
+              StorageResult::STORAGE_ERR_PARAM);
+}
+
+TEST_P(AsyncFrameWriterTest, QueueFullRejectsWithoutBlocking) {
+    config_.queue_capacity = 2;
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+
+    // Hold the writer thread inside the first completion callback
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> release_future = release.get_future().share();
+    ASSERT_EQ(writer.Enqueue(PathFor("0.raw"), MakeFrame(4096, 0),
+                             [&](const WriteResult&) {
+                                 entered.set_value();
+                                 release_future.wait();
+                             }),
+              StorageResult::STORAGE_OK);
+    entered.get_future().wait();
+
+    EXPECT_EQ(writer.Enqueue(PathFor("1.raw"), MakeFrame(4096, 1)), StorageResult::STORAGE_OK);
+    EXPECT_EQ(writer.Enqueue(PathFor("2.raw"), MakeFrame(4096, 2)), StorageResult::STORAGE_OK);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(writer.Enqueue(PathFor("3.raw"), MakeFrame(4096, 3)),
+              StorageResult::STORAGE_ERR_QUEUE_FULL);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+    StorageStats stats = writer.GetStats();
+    EXPECT_EQ(stats.queue_depth, 2u);
+    EXPECT_EQ(stats.jobs_rejected, 1u);
+
+    release.set_value();
+    ASSERT_TRUE(writer.Flush(kFlushTimeout));
+    EXPECT_EQ(writer.GetStats().jobs_completed, 3u);
+    EXPECT_FALSE(fs::exists(PathFor("3.raw")));
+}
+
+// =============================================================================
+// Writes
+// =============================================================================
+
+TEST_P(AsyncFrameWriterTest, WritesExactContent) {
+    // Deliberately not a multiple of the O_DIRECT block or staging buffer size
+    config_.staging_buffer_bytes = 64 * 1024;
+    config_.staging_buffer_count = 4;
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+
+    constexpr size_t kBytes = 300 * 1024 + 123;
+    hnvue::infra::FrameHandle frame = MakeFrame(kBytes, 7);
+    std::vector<uint8_t> expected(frame.Data(), frame.Data() + kBytes);
+
+    std::promise<WriteResult> done;
+    ASSERT_EQ(writer.Enqueue(PathFor("frame.raw"), frame,
+                             [&](const WriteResult& result) { done.set_value(result); }),
+              StorageResult::STORAGE_OK);
+    WriteResult result = done.get_future().get();
+
+    EXPECT_EQ(result.result, StorageResult::STORAGE_OK);
+    EXPECT_EQ(result.bytes_written, kBytes);
+    EXPECT_EQ(result.path, PathFor("frame.raw"));
+    EXPECT_GE(result.latency_us, 0);
+    EXPECT_EQ(ReadFile(PathFor("frame.raw")), expected);
+}
+
+TEST_P(AsyncFrameWriterTest, NineMegapixelPairCostsOnlyAnEnqueue) {
+    constexpr size_t kWidth = 3000;
+    constexpr size_t kHeight = 3000;
+    constexpr size_t kBytes = kWidth * kHeight * sizeof(uint16_t);
+
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+
+    hnvue::infra::FrameHandle raw = MakeFrame(kBytes, 3);
+    hnvue::infra::PooledVector<uint8_t> processed(kBytes);
+    for (size_t i = 0; i < kBytes; i += 4096) {
+        processed[i] = static_cast<uint8_t>(i >> 12);
+    }
+
+    // CPU time of this thread: wall time would include preemption by the
+    // writer threads on small machines, which is not a cost of Enqueue
+    int64_t start_us = ThreadCpuTimeUs();
+    ASSERT_EQ(writer.Enqueue(PathFor("0001.raw"), raw), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.Enqueue(PathFor("0001.img"), std::move(processed)), StorageResult::STORAGE_OK);
+    int64_t enqueue_us = ThreadCpuTimeUs() - start_us;
+
+    ASSERT_TRUE(writer.Flush(kFlushTimeout));
+    StorageStats stats = writer.GetStats();
+
+    RecordProperty("backend", BackendName(GetParam()));
+    RecordProperty("pair_enqueue_cpu_us", static_cast<int>(enqueue_us));
+    RecordProperty("avg_write_latency_us", static_cast<int>(stats.avg_latency_us));
+    RecordProperty("throughput_mb_s", std::to_string(stats.throughput_mb_s));
+    RecordProperty("ios_submitted", static_cast<int>(stats.ios_submitted));
+    RecordProperty("submit_calls", static_cast<int>(stats.submit_calls));
+
+    // Enqueue is a queue append; no payload copy or I/O on this thread
+    EXPECT_LT(enqueue_us, 2000);
+    EXPECT_EQ(stats.jobs_completed, 2u);
+    EXPECT_EQ(stats.jobs_failed, 0u);
+    EXPECT_EQ(stats.bytes_written, 2 * kBytes);
+    EXPECT_EQ(stats.queue_depth, 0u);
+    EXPECT_EQ(stats.inflight_ios, 0u);
+    EXPECT_GE(stats.queue_high_water, 1u);
+    EXPECT_GT(stats.throughput_mb_s, 0.0);
+    EXPECT_GT(stats.submit_calls, 0u);
+    EXPECT_EQ(fs::file_size(PathFor("0001.raw")), kBytes);
+    EXPECT_EQ(fs::file_size(PathFor("0001.img")), kBytes);
+
+    // The writer released its reference; only ours remains
+    EXPECT_EQ(raw.UseCount(), 1u);
+}
+
+TEST_P(AsyncFrameWriterTest, UnopenablePathReportsIoError) {
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+
+    std::promise<WriteResult> done;
+    ASSERT_EQ(writer.Enqueue(PathFor("missing/dir/frame.raw"), MakeFrame(8192, 1),
+                             [&](const WriteResult& result) { done.set_value(result); }),
+              StorageResult::STORAGE_OK);
+    EXPECT_EQ(done.get_future().get().result, StorageResult::STORAGE_ERR_IO);
+    ASSERT_TRUE(writer.Flush(kFlushTimeout));
+    EXPECT_EQ(writer.GetStats().jobs_failed, 1u);
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+TEST_P(AsyncFrameWriterTest, StopDrainsQueuedJobs) {
+    config_.sync_on_close = true;
+    AsyncFrameWriter writer(config_);
+    ASSERT_EQ(writer.Start(), StorageResult::STORAGE_OK);
+
+    constexpr int kFiles = 8;
+    std::atomic<int> completed{0};
+    for (int i = 0; i < kFiles; ++i) {
+        ASSERT_EQ(writer.Enqueue(PathFor(std::to_string(i) + ".raw"), MakeFrame(100000, 0),
+                                 [&](const WriteResult& r) {
+                                     if (r.result == StorageResult::STORAGE_OK) {
+                                         completed.fetch_add(1);
+                                     }
+                                 }),
+                  StorageResult::STORAGE_OK);
+    }
+    writer.Stop();
+
+    EXPECT_FALSE(writer.IsRunning());
+    EXPECT_EQ(completed.load(), kFiles);
+    for (int i = 0; i < kFiles; ++i) {
+        EXPECT_EQ(fs::file_size(PathFor(std::to_string(i) + ".raw")), 100000u);
+    }
+    EXPECT_EQ(writer.Enqueue(PathFor("late.raw"), MakeFrame(16, 0)),
+              StorageResult::STORAGE_ERR_NOT_RUNNING);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Backends, AsyncFrameWriterTest,
+    ::testing::Values(StorageBackend::STORAGE_BACKEND_THREAD_POOL,
+                      StorageBackend::STORAGE_BACKEND_IO_URING),
+    [](const ::testing::TestParamInfo<StorageBackend>& info) {
+        return std::string(BackendName(info.param));
+    });
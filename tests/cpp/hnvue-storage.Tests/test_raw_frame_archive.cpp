@@ -0,0 +1,339 @@
+/**
+ * @file test_raw_frame_archive.cpp
+ * @brief GTest unit tests for the raw frame archive (RawFrameArchive.h)
+ * @date 2026-10-18
+ * @author abyz-lab
+ *
+ * IEC 62304 Class B - Storage: raw frame archive
+ * SPDX-License-Identifier: MIT
+ *
+ * Decisions exercised:
+ *   Codec:    lossless round trip (odd sizes, partial last strip, extremes) /
+ *             compression ratio on detector-like data / stored fallback
+ *   Index:    random access by index, metadata without decompression,
+ *             out-of-range index
+ *   Reader:   strided destination / missing index recovered by scanning /
+ *             payload corruption detected / non-archive rejected
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hnvue/infra/Clock.h"
+#include "hnvue/storage/RawFrameArchive.h"
+
+using namespace hnvue::storage;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Smooth gradient plus Poisson-like noise, similar to an open-field exposure
+std::vector<uint16_t> MakeDetectorFrame(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 12.0f);
+    std::vector<uint16_t> pixels(static_cast<size_t>(width) * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            float base = 8000.0f + 3000.0f * std::sin(x * 0.01f) + 2000.0f * std::cos(y * 0.013f);
+            float value = std::max(0.0f, std::min(65535.0f, base + noise(rng)));
+            pixels[static_cast<size_t>(y) * width + x] = static_cast<uint16_t>(value);
+        }
+    }
+    return pixels;
+}
+
+std::vector<uint16_t> MakeRandomFrame(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint16_t> pixels(static_cast<size_t>(width) * height);
+    for (auto& pixel : pixels) {
+        pixel = static_cast<uint16_t>(rng());
+    }
+    return pixels;
+}
+
+RawFrameMetadata MakeMetadata(uint32_t width, uint32_t height, uint64_t id) {
+    RawFrameMetadata metadata;
+    metadata.acquisition_id = id;
+    metadata.kv = 70.0f + static_cast<float>(id);
+    metadata.mas = 2.5f * static_cast<float>(id + 1);
+    metadata.detector_id = 7;
+    metadata.timestamp_us = 1000000 + static_cast<int64_t>(id) * 33333;
+    metadata.width = width;
+    metadata.height = height;
+    return metadata;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Fixture with a private archive directory
+ */
+class RawFrameArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() /
+               ("hnvue_archive_" + std::to_string(hnvue::infra::WallClockNowUs()));
+        fs::create_directories(dir_);
+        config_.strip_rows = 16;
+        config_.threads = 2;
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    std::string PathFor(const std::string& name) const {
+        return (dir_ / name).string();
+    }
+
+    fs::path dir_;
+    ArchiveConfig config_;
+};
+
+// =============================================================================
+// Codec
+// =============================================================================
+
+TEST_F(RawFrameArchiveTest, RoundTripIsLossless) {
+    // 37 rows with 16-row strips leaves a partial last strip; odd width
+    // exercises the SIMD tail
+    const uint32_t width = 1001;
+    const uint32_t height = 37;
+    std::vector<uint16_t> frame = MakeDetectorFrame(width, height, 1);
+    frame[0] = 0;
+    frame[1] = 65535;
+    frame[width] = 65535;
+    frame[width + 1] = 0;
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, 0)),
+              StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.Close(), StorageResult::STORAGE_OK);
+
+    RawFrameArchiveReader reader(config_);
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    EXPECT_FALSE(reader.IsRecovered());
+    ASSERT_EQ(reader.FrameCount(), 1u);
+
+    std::vector<uint16_t> decoded;
+    ASSERT_EQ(reader.ReadFrame(0, decoded), StorageResult::STORAGE_OK);
+    EXPECT_EQ(decoded, frame);
+}
+
+TEST_F(RawFrameArchiveTest, CompressesDetectorData) {
+    const uint32_t width = 512;
+    const uint32_t height = 512;
+    std::vector<uint16_t> frame = MakeDetectorFrame(width, height, 2);
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, 0)),
+              StorageResult::STORAGE_OK);
+
+    double ratio = static_cast<double>(writer.RawBytes()) / writer.FileBytes();
+    EXPECT_GT(ratio, 1.5) << "raw " << writer.RawBytes() << " file " << writer.FileBytes();
+}
+
+TEST_F(RawFrameArchiveTest, IncompressibleDataStoredVerbatim) {
+    const uint32_t width = 256;
+    const uint32_t height = 64;
+    std::vector<uint16_t> frame = MakeRandomFrame(width, height, 3);
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, 0)),
+              StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.Close(), StorageResult::STORAGE_OK);
+
+    // Stored strips cost one mode byte each plus record framing
+    RawFrameArchiveReader reader(config_);
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ArchiveFrameInfo info;
+    ASSERT_EQ(reader.GetFrameInfo(0, info), StorageResult::STORAGE_OK);
+    EXPECT_LT(info.record_bytes, info.raw_bytes + 256);
+
+    std::vector<uint16_t> decoded;
+    ASSERT_EQ(reader.ReadFrame(0, decoded), StorageResult::STORAGE_OK);
+    EXPECT_EQ(decoded, frame);
+}
+
+// =============================================================================
+// Index and Random Access
+// =============================================================================
+
+TEST_F(RawFrameArchiveTest, RandomAccessByIndex) {
+    const uint32_t width = 128;
+    const uint32_t height = 40;
+    std::vector<std::vector<uint16_t>> frames;
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    for (uint32_t i = 0; i < 5; ++i) {
+        frames.push_back(MakeDetectorFrame(width, height, 10 + i));
+        ASSERT_EQ(writer.AppendFrame(frames.back().data(), width, MakeMetadata(width, height, i)),
+                  StorageResult::STORAGE_OK);
+    }
+    EXPECT_EQ(writer.FrameCount(), 5u);
+    ASSERT_EQ(writer.Close(), StorageResult::STORAGE_OK);
+
+    RawFrameArchiveReader reader(config_);
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(reader.FrameCount(), 5u);
+
+    ArchiveFrameInfo info;
+    ASSERT_EQ(reader.GetFrameInfo(3, info), StorageResult::STORAGE_OK);
+    EXPECT_EQ(info.metadata.acquisition_id, 3u);
+    EXPECT_FLOAT_EQ(info.metadata.kv, 73.0f);
+    EXPECT_FLOAT_EQ(info.metadata.mas, 10.0f);
+    EXPECT_EQ(info.metadata.detector_id, 7u);
+    EXPECT_EQ(info.metadata.timestamp_us, 1000000 + 3 * 33333);
+    EXPECT_EQ(info.raw_bytes, width * height * sizeof(uint16_t));
+
+    // Out of order reads
+    std::vector<uint16_t> decoded;
+    for (size_t i : {4u, 0u, 2u}) {
+        ASSERT_EQ(reader.ReadFrame(i, decoded), StorageResult::STORAGE_OK);
+        EXPECT_EQ(decoded, frames[i]) << "frame " << i;
+    }
+
+    EXPECT_EQ(reader.GetFrameInfo(5, info), StorageResult::STORAGE_ERR_RANGE);
+    EXPECT_EQ(reader.ReadFrame(5, decoded), StorageResult::STORAGE_ERR_RANGE);
+}
+
+TEST_F(RawFrameArchiveTest, ReadsIntoStridedDestination) {
+    const uint32_t width = 100;
+    const uint32_t height = 20;
+    const size_t stride = 128;
+    std::vector<uint16_t> frame = MakeDetectorFrame(width, height, 4);
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, 0)),
+              StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.Close(), StorageResult::STORAGE_OK);
+
+    RawFrameArchiveReader reader(config_);
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+
+    std::vector<uint16_t> destination(stride * height, 0xABCD);
+    EXPECT_EQ(reader.ReadFrame(0, destination.data(), width - 1),
+              StorageResult::STORAGE_ERR_PARAM);
+    ASSERT_EQ(reader.ReadFrame(0, destination.data(), stride), StorageResult::STORAGE_OK);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            ASSERT_EQ(destination[y * stride + x], frame[y * width + x]);
+        }
+        // Row padding untouched
+        EXPECT_EQ(destination[y * stride + width], 0xABCD);
+    }
+}
+
+// =============================================================================
+// Damaged Archives
+// =============================================================================
+
+TEST_F(RawFrameArchiveTest, RecoversFramesWithoutIndex) {
+    const uint32_t width = 64;
+    const uint32_t height = 33;
+    std::vector<uint16_t> frame = MakeDetectorFrame(width, height, 5);
+
+    uint64_t records_end = 0;
+    {
+        RawFrameArchiveWriter writer(config_);
+        ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+        for (uint32_t i = 0; i < 3; ++i) {
+            ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, i)),
+                      StorageResult::STORAGE_OK);
+        }
+        records_end = writer.FileBytes();
+    }
+
+    // Simulate a crash before Close: drop the index and trailer
+    fs::resize_file(PathFor("a.hnraw"), records_end);
+
+    RawFrameArchiveReader reader(config_);
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    EXPECT_TRUE(reader.IsRecovered());
+    ASSERT_EQ(reader.FrameCount(), 3u);
+
+    ArchiveFrameInfo info;
+    ASSERT_EQ(reader.GetFrameInfo(2, info), StorageResult::STORAGE_OK);
+    EXPECT_EQ(info.metadata.acquisition_id, 2u);
+
+    std::vector<uint16_t> decoded;
+    ASSERT_EQ(reader.ReadFrame(2, decoded), StorageResult::STORAGE_OK);
+    EXPECT_EQ(decoded, frame);
+}
+
+TEST_F(RawFrameArchiveTest, DetectsPayloadCorruption) {
+    const uint32_t width = 64;
+    const uint32_t height = 32;
+    std::vector<uint16_t> frame = MakeRandomFrame(width, height, 6);
+
+    RawFrameArchiveWriter writer(config_);
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.AppendFrame(frame.data(), width, MakeMetadata(width, height, 0)),
+              StorageResult::STORAGE_OK);
+    ASSERT_EQ(writer.Close(), StorageResult::STORAGE_OK);
+
+    RawFrameArchiveReader reader(config_);
+    ArchiveFrameInfo info;
+    {
+        ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+        ASSERT_EQ(reader.GetFrameInfo(0, info), StorageResult::STORAGE_OK);
+        reader.Close();
+    }
+
+    // Flip one bit in the middle of the (stored) pixel payload
+    {
+        std::fstream file(PathFor("a.hnraw"), std::ios::binary | std::ios::in | std::ios::out);
+        auto position = static_cast<std::streamoff>(info.offset + info.record_bytes / 2);
+        file.seekg(position);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte = static_cast<char>(byte ^ 0x10);
+        file.seekp(position);
+        file.write(&byte, 1);
+    }
+
+    ASSERT_EQ(reader.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    std::vector<uint16_t> decoded;
+    EXPECT_EQ(reader.ReadFrame(0, decoded), StorageResult::STORAGE_ERR_FORMAT);
+}
+
+TEST_F(RawFrameArchiveTest, RejectsNonArchive) {
+    {
+        std::ofstream file(PathFor("not_an_archive.raw"), std::ios::binary);
+        std::vector<char> junk(4096, 'x');
+        file.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+    }
+    RawFrameArchiveReader reader(config_);
+    EXPECT_EQ(reader.Open(PathFor("not_an_archive.raw")), StorageResult::STORAGE_ERR_FORMAT);
+    EXPECT_FALSE(reader.IsOpen());
+    EXPECT_EQ(reader.Open(PathFor("missing.hnraw")), StorageResult::STORAGE_ERR_IO);
+}
+
+TEST_F(RawFrameArchiveTest, AppendValidatesState) {
+    std::vector<uint16_t> frame(16 * 16, 100);
+    RawFrameArchiveWriter writer(config_);
+    EXPECT_EQ(writer.AppendFrame(frame.data(), 16, MakeMetadata(16, 16, 0)),
+              StorageResult::STORAGE_ERR_NOT_RUNNING);
+
+    ASSERT_EQ(writer.Open(PathFor("a.hnraw")), StorageResult::STORAGE_OK);
+    EXPECT_EQ(writer.AppendFrame(nullptr, 16, MakeMetadata(16, 16, 0)),
+              StorageResult::STORAGE_ERR_PARAM);
+    EXPECT_EQ(writer.AppendFrame(frame.data(), 8, MakeMetadata(16, 16, 0)),
+              StorageResult::STORAGE_ERR_PARAM);
+    EXPECT_EQ(writer.AppendFrame(frame.data(), 16, MakeMetadata(0, 16, 0)),
+              StorageResult::STORAGE_ERR_PARAM);
+    EXPECT_EQ(writer.FrameCount(), 0u);
+}